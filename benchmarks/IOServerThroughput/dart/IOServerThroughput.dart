@@ -0,0 +1,360 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+/// Throughput and latency of dart:io servers over loopback.
+///
+/// The server runs in the main isolate, so its throughput is the throughput
+/// of one core. The load is generated by [clientIsolates] isolates, each
+/// keeping [connectionsPerIsolate] requests in flight. The number of clients
+/// does not depend on the machine, so results are comparable across runs.
+///
+/// Usage: IOServerThroughput.dart [<seconds per scenario>] [<scenario>...]
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'certificates.dart';
+
+const clientIsolates = 4;
+const connectionsPerIsolate = 8;
+const warmup = Duration(seconds: 1);
+const uploadChunkSize = 64 * 1024;
+const uploadSize = 16 * 1024 * 1024;
+const datagramSize = 64;
+
+abstract class Scenario {
+  final String name;
+
+  Scenario(this.name);
+
+  /// Starts the server in the current isolate and returns its port.
+  Future<int> start();
+  Future<void> stop();
+
+  /// Performs one operation against the server on [port] in a client
+  /// isolate. [connection] is the per-connection state returned by [connect].
+  Future<void> operation(Object? connection, int port);
+  Future<Object?> connect(int port) async => null;
+  Future<void> disconnect(Object? connection) async {}
+
+  /// Bytes transferred by one operation, or zero.
+  int get bytesPerOperation => 0;
+}
+
+class HttpKeepAlive extends Scenario {
+  HttpServer? _server;
+
+  HttpKeepAlive() : super('HttpKeepAlive');
+
+  @override
+  Future<int> start() async {
+    final server = _server = await HttpServer.bind(
+      InternetAddress.loopbackIPv4,
+      0,
+    );
+    server.listen((request) {
+      request.response
+        ..headers.contentType = ContentType.text
+        ..write('Hello, world!')
+        ..close();
+    });
+    return server.port;
+  }
+
+  @override
+  Future<void> stop() => _server!.close(force: true);
+
+  @override
+  Future<Object?> connect(int port) async =>
+      HttpClient()..maxConnectionsPerHost = 1;
+
+  @override
+  Future<void> operation(Object? connection, int port) async {
+    final client = connection as HttpClient;
+    final request = await client.get('127.0.0.1', port, '/');
+    final response = await request.close();
+    await response.drain<void>();
+  }
+
+  @override
+  Future<void> disconnect(Object? connection) async {
+    (connection as HttpClient).close(force: true);
+  }
+}
+
+class TlsHandshake extends Scenario {
+  SecureServerSocket? _server;
+
+  TlsHandshake() : super('TlsHandshake');
+
+  @override
+  Future<int> start() async {
+    final context =
+        SecurityContext()
+          ..useCertificateChainBytes(serverChainPem.codeUnits)
+          ..usePrivateKeyBytes(serverKeyPem.codeUnits, password: 'dartdart');
+    final server = _server = await SecureServerSocket.bind(
+      InternetAddress.loopbackIPv4,
+      0,
+      context,
+    );
+    server.listen((socket) {
+      socket.listen(null, onDone: socket.destroy, onError: (_) {});
+    }, onError: (_) {});
+    return server.port;
+  }
+
+  @override
+  Future<void> stop() => _server!.close();
+
+  @override
+  Future<Object?> connect(int port) async =>
+      SecurityContext(withTrustedRoots: false)
+        ..setTrustedCertificatesBytes(trustedCertsPem.codeUnits);
+
+  @override
+  Future<void> operation(Object? connection, int port) async {
+    final socket = await SecureSocket.connect(
+      InternetAddress.loopbackIPv4,
+      port,
+      context: connection as SecurityContext,
+    );
+    socket.destroy();
+  }
+}
+
+class UdpEcho extends Scenario {
+  RawDatagramSocket? _server;
+
+  UdpEcho() : super('UdpEcho');
+
+  @override
+  Future<int> start() async {
+    final server = _server = await RawDatagramSocket.bind(
+      InternetAddress.loopbackIPv4,
+      0,
+    );
+    server.listen((event) {
+      if (event == RawSocketEvent.read) {
+        final datagram = server.receive();
+        if (datagram != null) {
+          server.send(datagram.data, datagram.address, datagram.port);
+        }
+      }
+    });
+    return server.port;
+  }
+
+  @override
+  Future<void> stop() async => _server!.close();
+
+  @override
+  Future<Object?> connect(int port) async => _UdpClient(
+    await RawDatagramSocket.bind(InternetAddress.loopbackIPv4, 0),
+  );
+
+  @override
+  Future<void> operation(Object? connection, int port) =>
+      (connection as _UdpClient).echo(port);
+
+  @override
+  Future<void> disconnect(Object? connection) async {
+    (connection as _UdpClient).socket.close();
+  }
+
+  @override
+  int get bytesPerOperation => datagramSize;
+}
+
+class _UdpClient {
+  static const timeout = Duration(milliseconds: 200);
+
+  final RawDatagramSocket socket;
+  final Uint8List _data = Uint8List(datagramSize);
+  Completer<void>? _reply;
+
+  _UdpClient(this.socket) {
+    socket.listen((event) {
+      if (event == RawSocketEvent.read) {
+        while (socket.receive() != null) {
+          _reply?.complete();
+          _reply = null;
+        }
+      }
+    });
+  }
+
+  /// Sends a datagram and waits for the reply, sending it again if either
+  /// was dropped.
+  Future<void> echo(int port) async {
+    while (true) {
+      final reply = _reply = Completer<void>();
+      socket.send(_data, InternetAddress.loopbackIPv4, port);
+      try {
+        await reply.future.timeout(timeout);
+        return;
+      } on TimeoutException {
+        _reply = null;
+      }
+    }
+  }
+}
+
+class LargeUpload extends Scenario {
+  HttpServer? _server;
+
+  LargeUpload() : super('LargeUpload');
+
+  @override
+  Future<int> start() async {
+    final server = _server = await HttpServer.bind(
+      InternetAddress.loopbackIPv4,
+      0,
+    );
+    server.listen((request) async {
+      var length = 0;
+      await for (final chunk in request) {
+        length += chunk.length;
+      }
+      request.response
+        ..statusCode =
+            length == uploadSize ? HttpStatus.ok : HttpStatus.badRequest
+        ..close();
+    });
+    return server.port;
+  }
+
+  @override
+  Future<void> stop() => _server!.close(force: true);
+
+  @override
+  Future<Object?> connect(int port) async => HttpClient();
+
+  @override
+  Future<void> operation(Object? connection, int port) async {
+    final client = connection as HttpClient;
+    final request = await client.post('127.0.0.1', port, '/');
+    request.contentLength = uploadSize;
+    final chunk = Uint8List(uploadChunkSize);
+    for (var i = 0; i < uploadSize; i += uploadChunkSize) {
+      request.add(chunk);
+      await request.flush();
+    }
+    final response = await request.close();
+    await response.drain<void>();
+    if (response.statusCode != HttpStatus.ok) {
+      throw 'Upload failed with status ${response.statusCode}';
+    }
+  }
+
+  @override
+  Future<void> disconnect(Object? connection) async {
+    (connection as HttpClient).close(force: true);
+  }
+
+  @override
+  int get bytesPerOperation => uploadSize;
+}
+
+final scenarios = <String, Scenario Function()>{
+  'HttpKeepAlive': HttpKeepAlive.new,
+  'TlsHandshake': TlsHandshake.new,
+  'UdpEcho': UdpEcho.new,
+  'LargeUpload': LargeUpload.new,
+};
+
+class _ClientArguments {
+  final String scenario;
+  final int port;
+  final Duration duration;
+  final SendPort results;
+
+  _ClientArguments(this.scenario, this.port, this.duration, this.results);
+}
+
+/// Runs [connectionsPerIsolate] connections which perform operations back to
+/// back, and sends the latencies in microseconds of the operations completed
+/// after the warmup.
+Future<void> _client(_ClientArguments arguments) async {
+  final scenario = scenarios[arguments.scenario]!();
+  final stopwatch = Stopwatch()..start();
+  final warmupEnd = warmup.inMicroseconds;
+  final end = warmupEnd + arguments.duration.inMicroseconds;
+  final latencies = <int>[];
+
+  Future<void> runConnection() async {
+    final connection = await scenario.connect(arguments.port);
+    while (stopwatch.elapsedMicroseconds < end) {
+      final start = stopwatch.elapsedMicroseconds;
+      await scenario.operation(connection, arguments.port);
+      if (start >= warmupEnd) {
+        latencies.add(stopwatch.elapsedMicroseconds - start);
+      }
+    }
+    await scenario.disconnect(connection);
+  }
+
+  await Future.wait([
+    for (var i = 0; i < connectionsPerIsolate; i++) runConnection(),
+  ]);
+  arguments.results.send(Int64List.fromList(latencies));
+}
+
+Future<void> runScenario(String name, Duration duration) async {
+  final scenario = scenarios[name]!();
+  final port = await scenario.start();
+
+  final results = ReceivePort();
+  for (var i = 0; i < clientIsolates; i++) {
+    await Isolate.spawn(
+      _client,
+      _ClientArguments(name, port, duration, results.sendPort),
+    );
+  }
+  final latencies = <int>[];
+  await for (final Int64List clientLatencies in results.take(clientIsolates)) {
+    latencies.addAll(clientLatencies);
+  }
+  results.close();
+  await scenario.stop();
+
+  if (latencies.isEmpty) {
+    throw '$name: no operation completed after the warmup';
+  }
+  latencies.sort();
+  int percentile(int p) =>
+      latencies[math.min(latencies.length - 1, p * latencies.length ~/ 100)];
+  final seconds = duration.inMicroseconds / Duration.microsecondsPerSecond;
+  final rate = latencies.length / seconds;
+
+  final prefix = 'IOServerThroughput.$name';
+  print('$prefix.Percentile50(RunTimeRaw): ${percentile(50) / 1000} ms.');
+  print('$prefix.Percentile99(RunTimeRaw): ${percentile(99) / 1000} ms.');
+  // The server runs on a single isolate, so this is the rate per core.
+  print('$prefix.OperationsPerSecond(Throughput): ${rate.round()}');
+  if (scenario.bytesPerOperation > 0) {
+    final megabytes = rate * scenario.bytesPerOperation / (1024 * 1024);
+    print('$prefix.MegabytesPerSecond(Throughput): ${megabytes.round()}');
+  }
+}
+
+Future<void> main(List<String> args) async {
+  var duration = const Duration(seconds: 5);
+  var selected = scenarios.keys.toList();
+  if (args.isNotEmpty) {
+    duration = Duration(seconds: int.parse(args.first));
+    if (args.length > 1) {
+      selected = args.sublist(1);
+    }
+  }
+  for (final name in selected) {
+    if (!scenarios.containsKey(name)) {
+      throw 'Unknown scenario $name, expected one of ${scenarios.keys}';
+    }
+    await runScenario(name, duration);
+  }
+}
@@ -177,6 +177,65 @@ class SendPortBenchmark {
   }
 }
 
+// Measures the throughput of many isolates sending to the same receiver at
+// the same time, which contends on the VM's lookup of the destination port.
+class SendPortContentionBenchmark {
+  static const int messagesPerSender = 20000;
+
+  final int senders;
+
+  SendPortContentionBenchmark(this.senders);
+
+  Future report() async {
+    // Warmup.
+    await measure(messagesPerSender ~/ 10);
+
+    final us = await measure(messagesPerSender);
+    final usPerMessage = us / (senders * messagesPerSender);
+    print('SendPort.Contention.Senders$senders(RunTimeRaw): '
+        '$usPerMessage us.');
+  }
+
+  // Returns the time it takes all senders to deliver [messages] each.
+  Future<int> measure(int messages) async {
+    final port = ReceivePort();
+    final goPorts = <SendPort>[];
+    final done = Completer<int>();
+    final sw = Stopwatch();
+    int remaining = senders * messages;
+    port.listen((message) {
+      if (message is SendPort) {
+        goPorts.add(message);
+        if (goPorts.length == senders) {
+          sw.start();
+          for (final goPort in goPorts) {
+            goPort.send(null);
+          }
+        }
+      } else if (--remaining == 0) {
+        done.complete(sw.elapsedMicroseconds);
+      }
+    });
+    for (int i = 0; i < senders; i++) {
+      await Isolate.spawn(sendMessages, <Object>[port.sendPort, messages]);
+    }
+    final us = await done.future;
+    port.close();
+    return us;
+  }
+}
+
+Future<void> sendMessages(List<Object> args) async {
+  final sendPort = args[0] as SendPort;
+  final messages = args[1] as int;
+  final go = ReceivePort();
+  sendPort.send(go.sendPort);
+  await go.first;
+  for (int i = 0; i < messages; i++) {
+    sendPort.send(i);
+  }
+}
+
 class TreeNode {
   @pragma('vm:entry-point') // Prevent tree shaking of this field.
   final TreeNode left;
@@ -259,4 +318,8 @@ Future<void> main(args) async {
   for (final config in configs) {
     await SendPortBenchmark(config).report();
   }
+
+  for (final senders in [1, 4, 16]) {
+    await SendPortContentionBenchmark(senders).report();
+  }
 }
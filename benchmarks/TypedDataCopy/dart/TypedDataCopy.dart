@@ -11,6 +11,8 @@ void main() {
     Int8ToUint8Clamped.new,
     Int8ViewToInt8.new,
     ByteSwap.new,
+    Uint8Fill.new,
+    Uint8IndexOf.new,
   ];
 
   // Run all the code to ensure consistent polymorphism in shared code.
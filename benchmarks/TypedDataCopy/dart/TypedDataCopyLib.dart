@@ -172,3 +172,44 @@ class ByteSwap extends BenchmarkBase {
     check(0, 1, 2, 3); // Back to normal for the next run().
   }
 }
+
+class Uint8Fill extends BenchmarkBase {
+  Uint8Fill() : super('TypedDataCopy.Uint8Fill');
+
+  var a1;
+
+  @override
+  void setup() {
+    a1 = Uint8List(size);
+  }
+
+  @override
+  void run() {
+    a1.fillRange(8, a1.length, 0x5a);
+    final check = a1[a1.length - 1];
+    if (check != 0x5a) {
+      throw 'Bad $check';
+    }
+    a1.fillRange(0, a1.length - 8, 0);
+  }
+}
+
+class Uint8IndexOf extends BenchmarkBase {
+  Uint8IndexOf() : super('TypedDataCopy.Uint8IndexOf');
+
+  var a1;
+
+  @override
+  void setup() {
+    a1 = Uint8List(size);
+    a1[a1.length - 1] = 10;
+  }
+
+  @override
+  void run() {
+    final index = a1.indexOf(10);
+    if (index != a1.length - 1) {
+      throw 'Bad $index';
+    }
+  }
+}
@@ -13,6 +13,8 @@ void main() {
     () => Int8ToUint8Clamped(),
     () => Int8ViewToInt8(),
     () => ByteSwap(),
+    () => Uint8Fill(),
+    () => Uint8IndexOf(),
   ];
 
   // Run all the code to ensure consistent polymorphism in shared code.
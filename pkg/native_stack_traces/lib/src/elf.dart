@@ -4,6 +4,7 @@
 
 // ignore_for_file: constant_identifier_names
 
+import 'dart:io' show zlib;
 import 'dart:typed_data';
 
 import 'constants.dart' as constants;
@@ -529,10 +530,12 @@ class SectionHeaderEntry {
   static const _SHF_WRITE = 0x1;
   static const _SHF_ALLOC = 0x2;
   static const _SHF_EXECINSTR = 0x4;
+  static const _SHF_COMPRESSED = 0x800;
 
   bool get isWritable => flags & _SHF_WRITE != 0;
   bool get isAllocated => flags & _SHF_ALLOC != 0;
   bool get isExecutable => flags & _SHF_EXECINSTR != 0;
+  bool get isCompressed => flags & _SHF_COMPRESSED != 0;
 
   bool get hasBits => type != _SHT_NOBITS;
 
@@ -666,10 +669,36 @@ class Section {
   int get virtualAddress => headerEntry.addr;
   int get length => headerEntry.size;
 
+  static const _ELFCOMPRESS_ZLIB = 1;
+
   // Convenience function for preparing a reader to read a particular section.
   // Requires a reader for the entire ELF data where the reader's start is
   // the start of the ELF data.
-  Reader shrink(Reader reader) => reader.shrink(offset, length);
+  //
+  // The contents of compressed sections are inflated, so the returned reader
+  // always reads the uncompressed contents.
+  Reader shrink(Reader reader) {
+    final sectionReader = reader.shrink(offset, length);
+    if (!headerEntry.isCompressed) return sectionReader;
+    final type = sectionReader.readBytes(4);
+    if (sectionReader.wordSize == 8) {
+      sectionReader.readBytes(4); // Reserved.
+    }
+    final size = sectionReader.readWord();
+    sectionReader.readWord(); // Alignment.
+    if (type != _ELFCOMPRESS_ZLIB) {
+      throw FormatException('Unexpected compression type $type for section '
+          '"${headerEntry.name}"');
+    }
+    final bytes = zlib.decode(Uint8List.sublistView(
+        sectionReader.bdata, sectionReader.offset, sectionReader.length));
+    if (bytes.length != size) {
+      throw FormatException('Expected $size bytes after decompressing section '
+          '"${headerEntry.name}", got ${bytes.length}');
+    }
+    return Reader.fromTypedData(Uint8List.fromList(bytes),
+        wordSize: reader.wordSize, endian: reader.endian);
+  }
 
   void writeToStringBuffer(StringBuffer buffer) {
     buffer
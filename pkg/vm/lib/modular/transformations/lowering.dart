@@ -12,6 +12,7 @@ import '../specializer/factory_specializer.dart';
 import 'for_in_lowering.dart' show ForInLowering;
 import 'late_var_init_transformer.dart' show LateVarInitTransformer;
 import 'list_literals_lowering.dart' show ListLiteralsLowering;
+import 'object_hash_lowering.dart' show ObjectHashLowering;
 import 'type_casts_optimizer.dart'
     as typeCastsOptimizer
     show transformAsExpression;
@@ -46,6 +47,7 @@ class _Lowering extends Transformer {
   final LateVarInitTransformer lateVarInitTransformer;
   final FactorySpecializer factorySpecializer;
   final ListLiteralsLowering listLiteralsLowering;
+  final ObjectHashLowering objectHashLowering;
   final ForInLowering forInLowering;
 
   Member? _currentMember;
@@ -60,6 +62,7 @@ class _Lowering extends Transformer {
        lateVarInitTransformer = LateVarInitTransformer(),
        factorySpecializer = FactorySpecializer(coreTypes),
        listLiteralsLowering = ListLiteralsLowering(coreTypes),
+       objectHashLowering = ObjectHashLowering(coreTypes),
        forInLowering = ForInLowering(coreTypes, productMode: productMode);
 
   StaticTypeContext get _staticTypeContext =>
@@ -97,7 +100,11 @@ class _Lowering extends Transformer {
   @override
   visitStaticInvocation(StaticInvocation node) {
     node.transformChildren(this);
-    return factorySpecializer.transformStaticInvocation(node);
+    final result = factorySpecializer.transformStaticInvocation(node);
+    if (result is StaticInvocation) {
+      return objectHashLowering.transformStaticInvocation(result);
+    }
+    return result;
   }
 
   @override
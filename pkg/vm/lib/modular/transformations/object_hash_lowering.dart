@@ -0,0 +1,113 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+import 'package:kernel/ast.dart';
+import 'package:kernel/core_types.dart' show CoreTypes;
+
+/// VM-specific lowering of Object.hash calls.
+///
+/// Object.hash takes optional positional parameters and selects the
+/// SystemHash.hashN function to call by comparing each of them against a
+/// sentinel value. The number of arguments is known at the call site, so
+///
+///   Object.hash(e1, ..., eN)
+///
+/// is transformed into
+///
+///   let v1 = e1 in ... let vN = eN in
+///       SystemHash.hashN(v1.hashCode, ..., vN.hashCode, _hashSeed)
+///
+/// Arguments which can be read without side effects are not bound to
+/// temporaries.
+class ObjectHashLowering {
+  static const minArguments = 2;
+  static const maxArguments = 20;
+
+  final CoreTypes coreTypes;
+  final Procedure _objectHash;
+  final Procedure _objectHashCode;
+  final Field _hashSeed;
+
+  // Specialized SystemHash.hashN(h1, ..., hN, seed) functions.
+  final List<Procedure?> _systemHashFunctions = List<Procedure?>.filled(
+    maxArguments + 1,
+    null,
+  );
+
+  ObjectHashLowering(this.coreTypes)
+    : _objectHash = coreTypes.index.getProcedure('dart:core', 'Object', 'hash'),
+      _objectHashCode = coreTypes.index.getProcedure(
+        'dart:core',
+        'Object',
+        'get:hashCode',
+      ),
+      _hashSeed = coreTypes.index.getTopLevelField('dart:core', '_hashSeed');
+
+  Procedure _getSystemHashFunction(int length) =>
+      (_systemHashFunctions[length] ??= coreTypes.index.getProcedure(
+        'dart:_internal',
+        'SystemHash',
+        'hash$length',
+      ));
+
+  static bool _isSideEffectFree(Expression expr) =>
+      expr is BasicLiteral ||
+      expr is ConstantExpression ||
+      expr is ThisExpression ||
+      (expr is VariableGet &&
+          expr.variable.isFinal &&
+          !expr.variable.isLate);
+
+  Expression transformStaticInvocation(StaticInvocation node) {
+    if (node.target != _objectHash) {
+      return node;
+    }
+    final positional = node.arguments.positional;
+    final int length = positional.length;
+    if (length < minArguments ||
+        length > maxArguments ||
+        node.arguments.named.isNotEmpty) {
+      return node;
+    }
+    final objectType = coreTypes.objectNullableRawType;
+    final variables = <VariableDeclaration>[];
+    final hashCodes = <Expression>[];
+    for (final arg in positional) {
+      Expression receiver;
+      if (_isSideEffectFree(arg)) {
+        receiver = arg;
+      } else {
+        final variable = VariableDeclaration(
+          null,
+          initializer: arg,
+          type: objectType,
+          isFinal: true,
+          isSynthesized: true,
+        )..fileOffset = arg.fileOffset;
+        variables.add(variable);
+        receiver = VariableGet(variable)..fileOffset = arg.fileOffset;
+      }
+      hashCodes.add(
+        InstanceGet(
+          InstanceAccessKind.Object,
+          receiver,
+          Name('hashCode'),
+          interfaceTarget: _objectHashCode,
+          resultType: coreTypes.intNonNullableRawType,
+        )..fileOffset = arg.fileOffset,
+      );
+    }
+    Expression result = StaticInvocation(
+      _getSystemHashFunction(length),
+      Arguments([
+        ...hashCodes,
+        StaticGet(_hashSeed)..fileOffset = node.fileOffset,
+      ]),
+    )..fileOffset = node.fileOffset;
+    for (final variable in variables.reversed) {
+      result = Let(variable, result)..fileOffset = node.fileOffset;
+    }
+    return result;
+  }
+}
@@ -1476,6 +1476,8 @@ var tests = <IsolateTest>[
     expect(json['_usageCounter'], isPositive);
     expect(json['_optimizedCallSiteCount'], isZero);
     expect(json['_deoptimizations'], isZero);
+    expect(json['_deoptReasons'], isEmpty);
+    expect(json['_prohibitedSpeculations'], isEmpty);
   },
 
   // generic function.
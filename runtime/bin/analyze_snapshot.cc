@@ -50,7 +50,10 @@ static void PrintUsage() {
 "--sdk_version                                                               \n"
 "  Print the SDK version.                                                    \n"
 "--out                                                                       \n"
-"  Path to generate the analysis results JSON.                               \n"
+"  Path to generate the analysis results JSON. Besides the objects of the    \n"
+"  snapshot, it contains the size and read time of each cluster, the code    \n"
+"  and data size of each library and the largest canonical constants. Two    \n"
+"  results can be compared with runtime/tools/diff_snapshot_analysis.dart.   \n"
 "If omitting [<vm-flags>] the VM parsing the snapshot is created with the    \n"
 "following default flags:                                                    \n"
 "--enable_mirrors=false                                                      \n"
@@ -158,6 +161,8 @@ int RunAnalyzer(int argc, char** argv) {
     vm_options.AddArgument("--background_compilation");
     vm_options.AddArgument("--precompilation");
   }
+  // Measure the clusters while the snapshot is loaded below.
+  vm_options.AddArgument("--record_snapshot_statistics");
 
   char* error = Dart_SetVMFlags(vm_options.count(), vm_options.arguments());
   if (error != nullptr) {
@@ -6,9 +6,11 @@
 
 #include "bin/dartutils.h"
 #include "bin/eventhandler.h"
+#include "bin/filter.h"
 #include "bin/isolate_data.h"
 #include "bin/process.h"
 #include "bin/secure_socket_filter.h"
+#include "bin/socket.h"
 #include "bin/thread.h"
 #include "bin/utils.h"
 #include "bin/vmservice_impl.h"
@@ -39,6 +41,8 @@ bool InitOnce(char** error) {
   }
   bin::TimerUtils::InitOnce();
   bin::Process::Init();
+  bin::ZLibStreamPool::Init();
+  bin::HostLookupCache::Init();
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   bin::SSLFilter::Init();
 #endif
@@ -53,6 +57,8 @@ void Cleanup() {
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   bin::SSLFilter::Cleanup();
 #endif
+  bin::HostLookupCache::Cleanup();
+  bin::ZLibStreamPool::Cleanup();
   bin::Process::Cleanup();
 }
 
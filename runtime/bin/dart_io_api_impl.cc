@@ -7,12 +7,19 @@
 #include "bin/crypto.h"
 #include "bin/directory.h"
 #include "bin/eventhandler.h"
+#include "bin/filter.h"
 #include "bin/io_natives.h"
+#if defined(DART_IO_SECURE_SOCKET_DISABLED)
+#include "bin/io_service_no_ssl.h"
+#else  // defined(DART_IO_SECURE_SOCKET_DISABLED)
+#include "bin/io_service.h"
+#endif  // defined(DART_IO_SECURE_SOCKET_DISABLED)
 #include "bin/platform.h"
 #include "bin/process.h"
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
 #include "bin/secure_socket_filter.h"
 #endif
+#include "bin/socket.h"
 #include "bin/thread.h"
 #include "bin/utils.h"
 
@@ -23,6 +30,8 @@ void BootstrapDartIo() {
   // Bootstrap 'dart:io' event handler.
   TimerUtils::InitOnce();
   Process::Init();
+  ZLibStreamPool::Init();
+  HostLookupCache::Init();
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLFilter::Init();
 #endif
@@ -35,6 +44,8 @@ void CleanupDartIo() {
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLFilter::Cleanup();
 #endif
+  HostLookupCache::Cleanup();
+  ZLibStreamPool::Cleanup();
   Process::Cleanup();
 }
 
@@ -50,6 +61,12 @@ void SetExecutableArguments(int script_index, char** argv) {
   Platform::SetExecutableArguments(script_index, argv);
 }
 
+void SetIOServiceConcurrency(IOServiceLane lane, intptr_t max_concurrency) {
+  ASSERT((lane >= 0) && (lane < kIOServiceNumLanes));
+  ASSERT(max_concurrency > 0);
+  IOService::set_max_concurrency(lane, max_concurrency);
+}
+
 void GetIOEmbedderInformation(Dart_EmbedderInformation* info) {
   ASSERT(info != nullptr);
   ASSERT(info->version == DART_EMBEDDER_INFORMATION_CURRENT_VERSION);
@@ -13,6 +13,7 @@
 #include "bin/snapshot_utils.h"
 #include "bin/utils.h"
 #include "include/dart_tools_api.h"
+#include "platform/text_buffer.h"
 #include "platform/utils.h"
 
 extern "C" {
@@ -74,6 +75,9 @@ DFE::~DFE() {
   }
   frontend_filename_ = nullptr;
 
+  free(kernel_cache_dir_);
+  free(kernel_cache_options_);
+
   free(application_kernel_buffer_);
   application_kernel_buffer_ = nullptr;
   application_kernel_buffer_size_ = 0;
@@ -202,12 +206,30 @@ void DFE::CompileAndReadScript(const char* script_uri,
                                int* exit_code,
                                const char* package_config,
                                bool for_snapshot,
-                               bool embed_sources) {
+                               bool embed_sources,
+                               bool use_kernel_cache) {
+  // The incremental compiler has to see the whole program to be able to
+  // recompile it later (e.g. on hot reload), so it never uses the cache.
+  char* cache_key = nullptr;
+  if (use_kernel_cache && kernel_cache_dir_ != nullptr &&
+      !use_incremental_compiler()) {
+    cache_key =
+        KernelCacheKey(script_uri, package_config, for_snapshot, embed_sources);
+    if (TryReadCachedKernel(cache_key, kernel_buffer, kernel_buffer_size)) {
+      free(cache_key);
+      *error = nullptr;
+      *exit_code = 0;
+      return;
+    }
+  }
   Dart_KernelCompilationResult result =
       CompileScript(script_uri, use_incremental_compiler(), package_config,
                     for_snapshot, embed_sources);
   switch (result.status) {
     case Dart_KernelCompilationStatus_Ok:
+      if (cache_key != nullptr) {
+        WriteCachedKernel(cache_key, result.kernel, result.kernel_size);
+      }
       *kernel_buffer = result.kernel;
       *kernel_buffer_size = result.kernel_size;
       *error = nullptr;
@@ -230,6 +252,7 @@ void DFE::CompileAndReadScript(const char* script_uri,
       *exit_code = kErrorExitCode;
       break;
   }
+  free(cache_key);
 }
 
 void DFE::ReadScript(const char* script_uri,
@@ -458,5 +481,193 @@ bool DFE::TryReadKernelFile(const char* script_uri,
   return false;
 }
 
+// A kernel cache entry consists of two files named after a hash of the cache
+// key: '<hash>.dill' holds the kernel and '<hash>.deps' holds the key, the
+// size of the kernel and the modification time and size of every file the
+// kernel was compiled from, one per line.
+static const char kKernelCacheDillSuffix[] = ".dill";
+static const char kKernelCacheDepsSuffix[] = ".deps";
+static const char kKernelCacheTempSuffix[] = ".tmp";
+
+// Files modified this shortly before the kernel was written might have been
+// modified while it was compiled, so the kernel is not cached.
+static constexpr int64_t kKernelCacheMinDependencyAgeMillis = 2000;
+
+static char* KernelCachePath(const char* dir,
+                             const char* key,
+                             const char* suffix) {
+  return Utils::SCreate("%s%s%08" Px32 "%s", dir, File::PathSeparator(),
+                        Utils::StringHash(key, strlen(key)), suffix);
+}
+
+static bool WriteKernelCacheFile(const char* path,
+                                 const void* buffer,
+                                 intptr_t size) {
+  StringPointer temp_path(Utils::SCreate("%s%s", path, kKernelCacheTempSuffix));
+  File* file = File::Open(nullptr, temp_path.c_str(), File::kWriteTruncate);
+  if (file == nullptr) {
+    return false;
+  }
+  bool success = file->WriteFully(buffer, size);
+  file->Release();
+  // Renaming makes sure concurrent readers never see a partial file.
+  success = success && File::Rename(nullptr, temp_path.c_str(), path);
+  if (!success) {
+    File::Delete(nullptr, temp_path.c_str());
+  }
+  return success;
+}
+
+void DFE::set_kernel_cache(const char* dir,
+                           const CommandLineOptions& vm_options) {
+  free(kernel_cache_dir_);
+  free(kernel_cache_options_);
+  kernel_cache_dir_ = Utils::StrDup(dir);
+  TextBuffer options(64);
+  for (intptr_t i = 0; i < vm_options.count(); i++) {
+    options.Printf(" %s", vm_options.GetArgument(i));
+  }
+  kernel_cache_options_ = options.Steal();
+}
+
+char* DFE::KernelCacheKey(const char* script_uri,
+                          const char* package_config,
+                          bool for_snapshot,
+                          bool embed_sources) const {
+  TextBuffer key(256);
+  key.Printf("version %s\n", Dart_VersionString());
+  key.Printf("platform %" Pd "\n", platform_strong_dill_size);
+  key.Printf("options%s\n", kernel_cache_options_);
+  key.Printf("script %s\n", script_uri);
+  key.Printf("packages %s\n", package_config != nullptr ? package_config : "");
+  key.Printf("snapshot %d sources %d verbosity %d\n", for_snapshot,
+             embed_sources, verbosity());
+  return key.Steal();
+}
+
+bool DFE::TryReadCachedKernel(const char* key,
+                              uint8_t** kernel_buffer,
+                              intptr_t* kernel_buffer_size) const {
+  StringPointer deps_path(
+      KernelCachePath(kernel_cache_dir_, key, kKernelCacheDepsSuffix));
+  uint8_t* buffer;
+  intptr_t size;
+  if (!TryReadFile(deps_path.c_str(), &buffer, &size, /*decode_uri=*/false)) {
+    return false;
+  }
+  StringPointer deps(reinterpret_cast<char*>(realloc(buffer, size + 1)));
+  const_cast<char*>(deps.c_str())[size] = '\0';
+
+  // Different keys might hash to the same entry.
+  const intptr_t key_length = strlen(key);
+  if (size < key_length || strncmp(deps.c_str(), key, key_length) != 0) {
+    return false;
+  }
+  char* line = const_cast<char*>(deps.c_str()) + key_length;
+  char* end;
+  const int64_t expected_kernel_size = strtoll(line, &end, 10);
+  if (*end != '\n') {
+    return false;
+  }
+  for (line = end + 1; *line != '\0'; line = end + 1) {
+    const int64_t modified = strtoll(line, &end, 10);
+    const int64_t file_size = strtoll(end, &end, 10);
+    if (*end != ' ') {
+      return false;
+    }
+    const char* path = end + 1;
+    end = strchr(end, '\n');
+    if (end == nullptr) {
+      return false;
+    }
+    *end = '\0';
+    int64_t stat[File::kStatSize];
+    File::Stat(nullptr, path, stat);
+    if (stat[File::kType] != File::kIsFile ||
+        stat[File::kModifiedTime] != modified ||
+        stat[File::kSize] != file_size) {
+      return false;
+    }
+  }
+
+  StringPointer dill_path(
+      KernelCachePath(kernel_cache_dir_, key, kKernelCacheDillSuffix));
+  if (!TryReadFile(dill_path.c_str(), kernel_buffer, kernel_buffer_size,
+                   /*decode_uri=*/false)) {
+    return false;
+  }
+  if (*kernel_buffer_size != expected_kernel_size ||
+      DartUtils::SniffForMagicNumber(*kernel_buffer, *kernel_buffer_size) !=
+          DartUtils::kKernelMagicNumber) {
+    free(*kernel_buffer);
+    *kernel_buffer = nullptr;
+    *kernel_buffer_size = -1;
+    return false;
+  }
+  return true;
+}
+
+void DFE::WriteCachedKernel(const char* key,
+                            const uint8_t* kernel_buffer,
+                            intptr_t kernel_buffer_size) const {
+  Dart_KernelCompilationResult result = Dart_KernelListDependencies();
+  if (result.status != Dart_KernelCompilationStatus_Ok) {
+    free(result.error);
+    return;
+  }
+  if (Directory::Exists(nullptr, kernel_cache_dir_) != Directory::EXISTS &&
+      !Directory::Create(nullptr, kernel_cache_dir_)) {
+    free(result.kernel);
+    return;
+  }
+  // Invalidate a previous entry before replacing its kernel.
+  StringPointer deps_path(
+      KernelCachePath(kernel_cache_dir_, key, kKernelCacheDepsSuffix));
+  File::Delete(nullptr, deps_path.c_str());
+  StringPointer dill_path(
+      KernelCachePath(kernel_cache_dir_, key, kKernelCacheDillSuffix));
+  if (!WriteKernelCacheFile(dill_path.c_str(), kernel_buffer,
+                            kernel_buffer_size)) {
+    free(result.kernel);
+    return;
+  }
+  // The just written kernel tells the current time of the file system.
+  int64_t stat[File::kStatSize];
+  File::Stat(nullptr, dill_path.c_str(), stat);
+  const int64_t now = stat[File::kModifiedTime];
+
+  // The dependencies are file paths separated by spaces, where spaces and
+  // backslashes in paths are escaped with a backslash.
+  TextBuffer deps(1024);
+  deps.AddString(key);
+  deps.Printf("%" Pd "\n", kernel_buffer_size);
+  TextBuffer path(256);
+  const char* dependencies = reinterpret_cast<const char*>(result.kernel);
+  bool success = true;
+  for (intptr_t i = 0; success && i <= result.kernel_size; i++) {
+    if (i < result.kernel_size && dependencies[i] != ' ') {
+      if (dependencies[i] == '\\' && i + 1 < result.kernel_size) {
+        i++;
+      }
+      path.AddChar(dependencies[i]);
+      continue;
+    }
+    if (path.length() == 0) {
+      continue;
+    }
+    File::Stat(nullptr, path.buffer(), stat);
+    success = stat[File::kType] == File::kIsFile &&
+              stat[File::kModifiedTime] <
+                  now - kKernelCacheMinDependencyAgeMillis;
+    deps.Printf("%" Pd64 " %" Pd64 " %s\n", stat[File::kModifiedTime],
+                stat[File::kSize], path.buffer());
+    path.Clear();
+  }
+  free(result.kernel);
+  if (success) {
+    WriteKernelCacheFile(deps_path.c_str(), deps.buffer(), deps.length());
+  }
+}
+
 }  // namespace bin
 }  // namespace dart
@@ -16,7 +16,8 @@
 namespace dart {
 namespace bin {
 
-class AppSnapshot;  // Forward declaration.
+class AppSnapshot;         // Forward declaration.
+class CommandLineOptions;  // Forward declaration.
 
 class DFE {
  public:
@@ -49,6 +50,13 @@ class DFE {
   }
   Dart_KernelCompilationVerbosityLevel verbosity() const { return verbosity_; }
 
+  // Enables caching of kernel compiled from sources in |dir| across runs.
+  // A cached kernel is reused as long as none of the files it was compiled
+  // from changed. |vm_options| are made part of the cache key since they
+  // may affect compilation (e.g. --enable-experiment).
+  void set_kernel_cache(const char* dir, const CommandLineOptions& vm_options);
+  const char* kernel_cache_dir() const { return kernel_cache_dir_; }
+
   // Returns the platform binary file name if the path to
   // kernel binaries was set using SetKernelBinaries.
   const char* GetPlatformBinaryFilename();
@@ -82,6 +90,10 @@ class DFE {
   //
   // `snapshot` is used by the frontend to determine if compilation
   // related information should be printed to console (e.g., null safety mode).
+  //
+  // If `use_kernel_cache` is true and a kernel cache directory was set, the
+  // kernel is looked up in and added to that cache. This must only be used
+  // for compilation of a whole program, e.g. when starting an isolate group.
   void CompileAndReadScript(const char* script_uri,
                             uint8_t** kernel_buffer,
                             intptr_t* kernel_buffer_size,
@@ -89,7 +101,8 @@ class DFE {
                             int* exit_code,
                             const char* package_config,
                             bool for_snapshot,
-                            bool embed_sources);
+                            bool embed_sources,
+                            bool use_kernel_cache = false);
 
   // Reads the script kernel file if specified 'script_uri' is a kernel file.
   // Returns an in memory kernel representation of the specified script is a
@@ -131,6 +144,8 @@ class DFE {
   bool use_dfe_;
   bool use_incremental_compiler_;
   char* frontend_filename_;
+  char* kernel_cache_dir_ = nullptr;
+  char* kernel_cache_options_ = nullptr;
   Dart_KernelCompilationVerbosityLevel verbosity_ =
       Dart_KernelCompilationVerbosityLevel_All;
 
@@ -140,6 +155,26 @@ class DFE {
 
   void InitKernelServiceAndPlatformDills();
 
+  // Returns the malloc()ed key identifying the result of compiling
+  // `script_uri` with the given settings in the kernel cache.
+  char* KernelCacheKey(const char* script_uri,
+                       const char* package_config,
+                       bool for_snapshot,
+                       bool embed_sources) const;
+
+  // Reads the kernel cached for `key` if none of the files it was compiled
+  // from changed since. The caller is responsible for free()ing
+  // 'kernel_buffer' if `true` was returned.
+  bool TryReadCachedKernel(const char* key,
+                           uint8_t** kernel_buffer,
+                           intptr_t* kernel_buffer_size) const;
+
+  // Caches the kernel just compiled for `key` along with the list of files
+  // it was compiled from. Failing to write the cache is not an error.
+  void WriteCachedKernel(const char* key,
+                         const uint8_t* kernel_buffer,
+                         intptr_t kernel_buffer_size) const;
+
   DISALLOW_COPY_AND_ASSIGN(DFE);
 };
 
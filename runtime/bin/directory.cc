@@ -328,7 +328,9 @@ CObject* Directory::ListNextRequest(const CObjectArray& request) {
   if (dir_listing->IsEmpty()) {
     return new CObjectArray(CObject::NewArray(0));
   }
-  const int kArraySize = 128;
+  // Each entry takes two elements. Large batches save round trips between
+  // the IO service and the isolate for large directories.
+  const int kArraySize = 4096;
   CObjectArray* response = new CObjectArray(CObject::NewArray(kArraySize));
   dir_listing->SetArray(response, kArraySize);
   Directory::List(dir_listing);
@@ -380,14 +382,10 @@ bool AsyncDirectoryListing::AddFileSystemEntityToResponse(Response type,
                                                           const char* arg) {
   array_->SetAt(index_++, new CObjectInt32(CObject::NewInt32(type)));
   if (arg != nullptr) {
-    size_t len = strlen(arg);
-    Dart_CObject* io_buffer = CObject::NewIOBuffer(len);
-    uint8_t* data = io_buffer->value.as_external_typed_data.data;
-    memmove(reinterpret_cast<char*>(data), arg, len);
-
-    CObjectExternalUint8Array* external_array =
-        new CObjectExternalUint8Array(io_buffer);
-    array_->SetAt(index_++, external_array);
+    // Paths are short, so copying them into the message is cheaper than
+    // allocating and finalizing an external buffer for each of them.
+    Dart_CObject* path = CObject::NewUint8Array(arg, strlen(arg));
+    array_->SetAt(index_++, new CObjectUint8Array(path));
   } else {
     array_->SetAt(index_++, CObject::Null());
   }
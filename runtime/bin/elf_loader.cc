@@ -5,10 +5,12 @@
 #include "bin/elf_loader.h"
 
 #include "platform/globals.h"
-#if defined(DART_HOST_OS_FUCHSIA)
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_FUCHSIA) ||          \
+    defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_MACOS)
 #include <sys/mman.h>
 #endif
 
+#include <stdlib.h>
 #include <memory>
 #include <utility>
 
@@ -207,6 +209,9 @@ class LoadedElf {
 
   static uword PageSize() { return VirtualMemory::PageSize(); }
 
+  // The transparent huge page size on the architectures we support.
+  static constexpr uword kHugePageSize = 2 * MB;
+
   // Unlike File::Map, allows non-aligned 'start' and 'length'.
   MappedMemory* MapFilePiece(uword start,
                              uword length,
@@ -459,11 +464,38 @@ bool LoadedElf::LoadSegments() {
                 "Could not unmap reservation.");
 #endif
 
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+    // Large AOT instruction segments thrash the TLB when backed by base
+    // pages. If requested, copy the text into the anonymous reservation
+    // instead of mapping the file so the kernel can back it with transparent
+    // huge pages. This gives up sharing the text with the page cache.
+    if ((map_type == File::kReadExecute) && (length >= kHugePageSize) &&
+        (getenv("DART_AOT_HUGE_PAGES") != nullptr) &&
+        VirtualMemory::AdviseHugePages(memory_start, length)) {
+      CHECK_ERROR(mappable_->SetPosition(file_start),
+                  "Could not advance file position.");
+      CHECK_ERROR(mappable_->ReadFully(memory_start, length),
+                  "Could not read file.");
+      VirtualMemory::Protect(memory_start, length,
+                             VirtualMemory::kReadExecute);
+      continue;
+    }
+#endif
+
     std::unique_ptr<MappedMemory> memory(
         mappable_->Map(map_type, file_start, length, memory_start));
     CHECK_ERROR(memory != nullptr, "Could not map segment.");
     CHECK_ERROR(memory->address() == memory_start,
                 "Mapping not at requested address.");
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX) ||            \
+    defined(DART_HOST_OS_MACOS)
+    // The read-only segment holds the snapshot data, which is deserialized in
+    // full right after loading. Have the kernel read it in ahead instead of
+    // faulting it in a few pages at a time. This is only a hint.
+    if (map_type == File::kReadOnly) {
+      madvise(memory_start, length, MADV_WILLNEED);
+    }
+#endif
 #if defined(DART_HOST_OS_WINDOWS) && defined(ARCH_IS_64_BIT)
     // For executable pages register unwinding information that should be
     // present on the page.
@@ -26,6 +26,10 @@ typedef struct {
 /// Dart_LoadELF_Fd takes ownership of the file descriptor. Dart_LoadELF_Memory
 /// does not take ownership of the memory, but borrows it for the duration of
 /// the call. The memory can be release as soon as Dart_LoadELF_Memory returns.
+///
+/// On Linux and Android, setting the environment variable DART_AOT_HUGE_PAGES
+/// copies large executable segments into anonymous memory advised for
+/// transparent huge pages instead of mapping them from the file.
 #if defined(__Fuchsia__) || defined(__linux__) || defined(__FreeBSD__)
 DART_EXPORT Dart_LoadedElf* Dart_LoadELF_Fd(int fd,
                                             uint64_t file_offset,
@@ -12,8 +12,10 @@
 #include <fcntl.h>        // NOLINT
 #include <pthread.h>      // NOLINT
 #include <stdio.h>        // NOLINT
+#include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/epoll.h>    // NOLINT
+#include <sys/eventfd.h>  // NOLINT
 #include <sys/stat.h>     // NOLINT
 #include <sys/timerfd.h>  // NOLINT
 #include <unistd.h>       // NOLINT
@@ -24,6 +26,7 @@
 #include "bin/process.h"
 #include "bin/socket.h"
 #include "bin/thread.h"
+#include "include/dart_tools_api.h"
 #include "platform/syslog.h"
 #include "platform/utils.h"
 
@@ -70,21 +73,13 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   }
 }
 
-EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
-  intptr_t result;
-  result = NO_RETRY_EXPECTED(pipe(interrupt_fds_));
-  if (result != 0) {
-    FATAL("Pipe creation failed");
-  }
-  if (!FDUtils::SetNonBlocking(interrupt_fds_[0])) {
-    FATAL("Failed to set pipe fd non blocking\n");
-  }
-  if (!FDUtils::SetCloseOnExec(interrupt_fds_[0])) {
-    FATAL("Failed to set pipe fd close on exec\n");
-  }
-  if (!FDUtils::SetCloseOnExec(interrupt_fds_[1])) {
-    FATAL("Failed to set pipe fd close on exec\n");
+EventHandlerShard::EventHandlerShard(EventHandlerImplementation* owner)
+    : socket_map_(&SimpleHashMap::SamePointerValue, 16),
+      commands_(nullptr),
+      owner_(owner) {
+  interrupt_fd_ = NO_RETRY_EXPECTED(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+  if (interrupt_fd_ == -1) {
+    FATAL("Failed creating eventfd file descriptor: %i", errno);
   }
   shutdown_ = false;
   // The initial size passed to epoll_create is ignore on newer (>=
@@ -102,7 +97,7 @@ EventHandlerImplementation::EventHandlerImplementation()
   event.events = EPOLLIN;
   event.data.ptr = nullptr;
   int status = NO_RETRY_EXPECTED(
-      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, interrupt_fds_[0], &event));
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, interrupt_fd_, &event));
   if (status == -1) {
     FATAL("Failed adding interrupt fd to epoll instance");
   }
@@ -127,16 +122,22 @@ static void DeleteDescriptorInfo(void* info) {
   delete di;
 }
 
-EventHandlerImplementation::~EventHandlerImplementation() {
+EventHandlerShard::~EventHandlerShard() {
   socket_map_.Clear(DeleteDescriptorInfo);
   close(epoll_fd_);
   close(timer_fd_);
-  close(interrupt_fds_[0]);
-  close(interrupt_fds_[1]);
+  close(interrupt_fd_);
+  // Commands sent after shutdown are dropped.
+  InterruptCommand* command = commands_.exchange(nullptr);
+  while (command != nullptr) {
+    InterruptCommand* next = command->next;
+    delete command;
+    command = next;
+  }
 }
 
-void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
-                                                     DescriptorInfo* di) {
+void EventHandlerShard::UpdateEpollInstance(intptr_t old_mask,
+                                            DescriptorInfo* di) {
   intptr_t new_mask = di->Mask();
   if ((old_mask != 0) && (new_mask == 0)) {
     RemoveFromEpollInstance(epoll_fd_, di);
@@ -149,7 +150,7 @@ void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
   }
 }
 
-DescriptorInfo* EventHandlerImplementation::GetDescriptorInfo(
+DescriptorInfo* EventHandlerShard::GetDescriptorInfo(
     intptr_t fd,
     bool is_listening) {
   ASSERT(fd >= 0);
@@ -171,120 +172,139 @@ DescriptorInfo* EventHandlerImplementation::GetDescriptorInfo(
   return di;
 }
 
-void EventHandlerImplementation::WakeupHandler(intptr_t id,
-                                               Dart_Port dart_port,
-                                               int64_t data) {
-  InterruptMessage msg;
-  msg.id = id;
-  msg.dart_port = dart_port;
-  msg.data = data;
-  // WriteToBlocking will write up to 512 bytes atomically, and since our msg
-  // is smaller than 512, we don't need a thread lock.
-  // See: http://linux.die.net/man/7/pipe, section 'Pipe_buf'.
-  ASSERT(kInterruptMessageSize < PIPE_BUF);
-  intptr_t result =
-      FDUtils::WriteToBlocking(interrupt_fds_[1], &msg, kInterruptMessageSize);
-  if (result != kInterruptMessageSize) {
-    if (result == -1) {
+void EventHandlerShard::WakeupHandler(intptr_t id,
+                                      Dart_Port dart_port,
+                                      int64_t data) {
+  InterruptCommand* command = new InterruptCommand();
+  command->message.id = id;
+  command->message.dart_port = dart_port;
+  command->message.data = data;
+  InterruptCommand* head = commands_.load(std::memory_order_relaxed);
+  do {
+    command->next = head;
+  } while (!commands_.compare_exchange_weak(head, command,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed));
+  // Only the command making the queue non-empty needs to wake up the handler,
+  // which drains the whole queue.
+  if (head == nullptr) {
+    const uint64_t kOne = 1;
+    intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+        write(interrupt_fd_, &kOne, sizeof(kOne)));
+    if (result != sizeof(kOne)) {
       FATAL("Interrupt message failure: %s", strerror(errno));
-    } else {
-      FATAL("Interrupt message failure: expected to write %" Pd
-            " bytes, but wrote %" Pd ".",
-            kInterruptMessageSize, result);
     }
   }
 }
 
-void EventHandlerImplementation::HandleInterruptFd() {
-  const intptr_t MAX_MESSAGES = kInterruptMessageSize;
-  InterruptMessage msg[MAX_MESSAGES];
-  ssize_t bytes = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
-      read(interrupt_fds_[0], msg, MAX_MESSAGES * kInterruptMessageSize));
-  for (ssize_t i = 0; i < bytes / kInterruptMessageSize; i++) {
-    if (msg[i].id == kTimerId) {
-      timeout_queue_.UpdateTimeout(msg[i].dart_port, msg[i].data);
-      UpdateTimerFd();
-    } else if (msg[i].id == kShutdownId) {
-      shutdown_ = true;
-    } else {
-      ASSERT((msg[i].data & COMMAND_MASK) != 0);
-      Socket* socket = reinterpret_cast<Socket*>(msg[i].id);
-      RefCntReleaseScope<Socket> rs(socket);
-      if (socket->fd() == -1) {
-        continue;
+void EventHandlerShard::HandleInterruptFd() {
+  uint64_t count;
+  VOID_TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
+      read(interrupt_fd_, &count, sizeof(count)));
+  InterruptCommand* command =
+      commands_.exchange(nullptr, std::memory_order_acquire);
+  // Commands were pushed in reverse order.
+  InterruptCommand* previous = nullptr;
+  while (command != nullptr) {
+    InterruptCommand* next = command->next;
+    command->next = previous;
+    previous = command;
+    command = next;
+  }
+  command = previous;
+  while (command != nullptr) {
+    stats_.RecordCommand();
+    HandleInterruptMessage(command->message);
+    InterruptCommand* next = command->next;
+    delete command;
+    command = next;
+  }
+}
+
+void EventHandlerShard::HandleInterruptMessage(const InterruptMessage& msg) {
+  if (msg.id == kTimerId) {
+    timeout_queue_.UpdateTimeout(msg.dart_port, msg.data);
+    UpdateTimerFd();
+  } else if (msg.id == kShutdownId) {
+    shutdown_ = true;
+  } else {
+    ASSERT((msg.data & COMMAND_MASK) != 0);
+    Socket* socket = reinterpret_cast<Socket*>(msg.id);
+    RefCntReleaseScope<Socket> rs(socket);
+    if (socket->fd() == -1) {
+      return;
+    }
+    DescriptorInfo* di =
+        GetDescriptorInfo(socket->fd(), IS_LISTENING_SOCKET(msg.data));
+    if (IS_COMMAND(msg.data, kShutdownReadCommand)) {
+      ASSERT(!di->IsListeningSocket());
+      // Close the socket for reading.
+      VOID_NO_RETRY_EXPECTED(shutdown(di->fd(), SHUT_RD));
+    } else if (IS_COMMAND(msg.data, kShutdownWriteCommand)) {
+      ASSERT(!di->IsListeningSocket());
+      // Close the socket for writing.
+      VOID_NO_RETRY_EXPECTED(shutdown(di->fd(), SHUT_WR));
+    } else if (IS_COMMAND(msg.data, kCloseCommand)) {
+      // Close the socket and free system resources and move on to next
+      // message.
+      if (IS_SIGNAL_SOCKET(msg.data)) {
+        Process::ClearSignalHandlerByFd(di->fd(), socket->isolate_port());
       }
-      DescriptorInfo* di =
-          GetDescriptorInfo(socket->fd(), IS_LISTENING_SOCKET(msg[i].data));
-      if (IS_COMMAND(msg[i].data, kShutdownReadCommand)) {
-        ASSERT(!di->IsListeningSocket());
-        // Close the socket for reading.
-        VOID_NO_RETRY_EXPECTED(shutdown(di->fd(), SHUT_RD));
-      } else if (IS_COMMAND(msg[i].data, kShutdownWriteCommand)) {
-        ASSERT(!di->IsListeningSocket());
-        // Close the socket for writing.
-        VOID_NO_RETRY_EXPECTED(shutdown(di->fd(), SHUT_WR));
-      } else if (IS_COMMAND(msg[i].data, kCloseCommand)) {
-        // Close the socket and free system resources and move on to next
-        // message.
-        if (IS_SIGNAL_SOCKET(msg[i].data)) {
-          Process::ClearSignalHandlerByFd(di->fd(), socket->isolate_port());
-        }
-        intptr_t old_mask = di->Mask();
-        Dart_Port port = msg[i].dart_port;
-        if (port != ILLEGAL_PORT) {
-          di->RemovePort(port);
-        }
-        intptr_t new_mask = di->Mask();
-        UpdateEpollInstance(old_mask, di);
+      intptr_t old_mask = di->Mask();
+      Dart_Port port = msg.dart_port;
+      if (port != ILLEGAL_PORT) {
+        di->RemovePort(port);
+      }
+      intptr_t new_mask = di->Mask();
+      UpdateEpollInstance(old_mask, di);
+
+      intptr_t fd = di->fd();
+      ASSERT(fd == socket->fd());
+      if (di->IsListeningSocket()) {
+        // We only close the socket file descriptor from the operating
+        // system if there are no other dart socket objects which
+        // are listening on the same (address, port) combination.
+        ListeningSocketRegistry* registry =
+            ListeningSocketRegistry::Instance();
+
+        MutexLocker locker(registry->mutex());
 
-        intptr_t fd = di->fd();
-        ASSERT(fd == socket->fd());
-        if (di->IsListeningSocket()) {
-          // We only close the socket file descriptor from the operating
-          // system if there are no other dart socket objects which
-          // are listening on the same (address, port) combination.
-          ListeningSocketRegistry* registry =
-              ListeningSocketRegistry::Instance();
-
-          MutexLocker locker(registry->mutex());
-
-          if (registry->CloseSafe(socket)) {
-            ASSERT(new_mask == 0);
-            socket_map_.Remove(GetHashmapKeyFromFd(fd),
-                               GetHashmapHashFromFd(fd));
-            di->Close();
-            delete di;
-          }
-          socket->CloseFd();
-        } else {
+        if (registry->CloseSafe(socket)) {
           ASSERT(new_mask == 0);
-          socket_map_.Remove(GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd));
+          socket_map_.Remove(GetHashmapKeyFromFd(fd),
+                             GetHashmapHashFromFd(fd));
           di->Close();
           delete di;
-          socket->CloseFd();
         }
-        DartUtils::PostInt32(port, 1 << kDestroyedEvent);
-      } else if (IS_COMMAND(msg[i].data, kReturnTokenCommand)) {
-        int count = TOKEN_COUNT(msg[i].data);
-        intptr_t old_mask = di->Mask();
-        di->ReturnTokens(msg[i].dart_port, count);
-        UpdateEpollInstance(old_mask, di);
-      } else if (IS_COMMAND(msg[i].data, kSetEventMaskCommand)) {
-        // `events` can only have kInEvent/kOutEvent flags set.
-        intptr_t events = msg[i].data & EVENT_MASK;
-        ASSERT(0 == (events & ~(1 << kInEvent | 1 << kOutEvent)));
-
-        intptr_t old_mask = di->Mask();
-        di->SetPortAndMask(msg[i].dart_port, msg[i].data & EVENT_MASK);
-        UpdateEpollInstance(old_mask, di);
+        socket->CloseFd();
       } else {
-        UNREACHABLE();
+        ASSERT(new_mask == 0);
+        socket_map_.Remove(GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd));
+        di->Close();
+        delete di;
+        socket->CloseFd();
       }
+      DartUtils::PostInt32(port, 1 << kDestroyedEvent);
+    } else if (IS_COMMAND(msg.data, kReturnTokenCommand)) {
+      int count = TOKEN_COUNT(msg.data);
+      intptr_t old_mask = di->Mask();
+      di->ReturnTokens(msg.dart_port, count);
+      UpdateEpollInstance(old_mask, di);
+    } else if (IS_COMMAND(msg.data, kSetEventMaskCommand)) {
+      // `events` can only have kInEvent/kOutEvent flags set.
+      intptr_t events = msg.data & EVENT_MASK;
+      ASSERT(0 == (events & ~(1 << kInEvent | 1 << kOutEvent)));
+
+      intptr_t old_mask = di->Mask();
+      di->SetPortAndMask(msg.dart_port, msg.data & EVENT_MASK);
+      UpdateEpollInstance(old_mask, di);
+    } else {
+      UNREACHABLE();
     }
   }
 }
 
-void EventHandlerImplementation::UpdateTimerFd() {
+void EventHandlerShard::UpdateTimerFd() {
   struct itimerspec it;
   memset(&it, 0, sizeof(it));
   if (timeout_queue_.HasTimeout()) {
@@ -328,8 +348,7 @@ static void PrintEventMask(intptr_t fd, intptr_t events) {
 }
 #endif
 
-intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
-                                                   DescriptorInfo* di) {
+intptr_t EventHandlerShard::GetPollEvents(intptr_t events, DescriptorInfo* di) {
 #ifdef DEBUG_POLL
   PrintEventMask(di->fd(), events);
 #endif
@@ -350,8 +369,8 @@ intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
   return event_mask;
 }
 
-void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
-                                              int size) {
+void EventHandlerShard::HandleEvents(struct epoll_event* events, int size) {
+  const int64_t start = Dart_TimelineGetMicros();
   bool interrupt_seen = false;
   for (int i = 0; i < size; i++) {
     if (events[i].data.ptr == nullptr) {
@@ -381,24 +400,29 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
       }
     }
   }
+  const int64_t delivered = Dart_TimelineGetMicros();
   if (interrupt_seen) {
     // Handle after socket events, so we avoid closing a socket before we handle
     // the current events.
     HandleInterruptFd();
   }
+  stats_.RecordWakeup(size, start, delivered, Dart_TimelineGetMicros());
 }
 
-void EventHandlerImplementation::Poll(uword args) {
+void EventHandlerShard::Poll(uword args) {
   ThreadSignalBlocker signal_blocker(SIGPROF);
-  const intptr_t kMaxEvents = 16;
-  struct epoll_event events[kMaxEvents];
-  EventHandler* handler = reinterpret_cast<EventHandler*>(args);
-  EventHandlerImplementation* handler_impl = &handler->delegate_;
+  // The batch grows whenever a wakeup fills it, so busy servers with many
+  // ready descriptors need fewer epoll_wait calls.
+  const intptr_t kMinEvents = 16;
+  const intptr_t kMaxEvents = 1024;
+  intptr_t max_events = kMinEvents;
+  struct epoll_event* events = new struct epoll_event[max_events];
+  EventHandlerShard* handler_impl = reinterpret_cast<EventHandlerShard*>(args);
   ASSERT(handler_impl != nullptr);
 
   while (!handler_impl->shutdown_) {
     intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
-        epoll_wait(handler_impl->epoll_fd_, events, kMaxEvents, -1));
+        epoll_wait(handler_impl->epoll_fd_, events, max_events, -1));
     ASSERT(EAGAIN == EWOULDBLOCK);
     if (result <= 0) {
       if (errno != EWOULDBLOCK) {
@@ -406,37 +430,146 @@ void EventHandlerImplementation::Poll(uword args) {
       }
     } else {
       handler_impl->HandleEvents(events, result);
+      if ((result == max_events) && (max_events < kMaxEvents)) {
+        delete[] events;
+        max_events *= 2;
+        events = new struct epoll_event[max_events];
+      }
     }
   }
-  DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
-  handler->NotifyShutdownDone();
+  delete[] events;
+  handler_impl->owner_->NotifyShardShutdownDone();
 }
 
-void EventHandlerImplementation::Start(EventHandler* handler) {
-  Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
-                reinterpret_cast<uword>(handler));
+void EventHandlerShard::Start() {
+  Thread::Start("dart:io EventHandler", &EventHandlerShard::Poll,
+                reinterpret_cast<uword>(this));
 }
 
-void EventHandlerImplementation::Shutdown() {
+void EventHandlerShard::Shutdown() {
   SendData(kShutdownId, 0, 0);
 }
 
-void EventHandlerImplementation::SendData(intptr_t id,
-                                          Dart_Port dart_port,
-                                          int64_t data) {
+void EventHandlerShard::SendData(intptr_t id,
+                                 Dart_Port dart_port,
+                                 int64_t data) {
   WakeupHandler(id, dart_port, data);
 }
 
-void* EventHandlerImplementation::GetHashmapKeyFromFd(intptr_t fd) {
+void* EventHandlerShard::GetHashmapKeyFromFd(intptr_t fd) {
   // The hashmap does not support keys with value 0.
   return reinterpret_cast<void*>(fd + 1);
 }
 
-uint32_t EventHandlerImplementation::GetHashmapHashFromFd(intptr_t fd) {
+uint32_t EventHandlerShard::GetHashmapHashFromFd(intptr_t fd) {
   // The hashmap does not support keys with value 0.
   return dart::Utils::WordHash(fd + 1);
 }
 
+void EventHandlerStats::RecordWakeup(intptr_t events,
+                                     int64_t start,
+                                     int64_t delivered,
+                                     int64_t end) {
+  wakeups_++;
+  events_ += events;
+  handle_micros_ += end - start;
+  max_delivery_micros_ =
+      dart::Utils::Maximum(max_delivery_micros_, delivered - start);
+  if (interval_start_ == 0) {
+    interval_start_ = start;
+  } else if (end - interval_start_ >= kReportIntervalMicros) {
+    Report(end);
+  }
+}
+
+void EventHandlerStats::Report(int64_t now) {
+  const intptr_t kNumCounters = 5;
+  const char* names[kNumCounters] = {"wakeups", "events", "commands",
+                                     "handle_micros", "max_delivery_micros"};
+  const int64_t counters[kNumCounters] = {wakeups_, events_, commands_,
+                                          handle_micros_, max_delivery_micros_};
+  char values[kNumCounters][kMaxCounterLength];
+  const char* value_pointers[kNumCounters];
+  for (intptr_t i = 0; i < kNumCounters; i++) {
+    dart::Utils::SNPrint(values[i], kMaxCounterLength, "%" Pd64, counters[i]);
+    value_pointers[i] = values[i];
+  }
+  Dart_RecordTimelineEvent("EventHandler", now, 0, /*flow_id_count=*/0,
+                           nullptr, Dart_Timeline_Event_Counter, kNumCounters,
+                           names, value_pointers);
+  wakeups_ = 0;
+  events_ = 0;
+  commands_ = 0;
+  handle_micros_ = 0;
+  max_delivery_micros_ = 0;
+  interval_start_ = now;
+}
+
+static intptr_t NumberOfShards() {
+  const char* threads = getenv("DART_IO_EVENT_HANDLER_THREADS");
+  if (threads == nullptr) {
+    return 1;
+  }
+  const intptr_t kMaxShards = 64;
+  intptr_t value = strtol(threads, nullptr, 10);
+  return (value < 1) ? 1 : ((value > kMaxShards) ? kMaxShards : value);
+}
+
+EventHandlerImplementation::EventHandlerImplementation()
+    : shards_(nullptr),
+      num_shards_(NumberOfShards()),
+      running_shards_(0),
+      handler_(nullptr) {
+  shards_ = new EventHandlerShard*[num_shards_];
+  for (intptr_t i = 0; i < num_shards_; i++) {
+    shards_[i] = new EventHandlerShard(this);
+  }
+}
+
+EventHandlerImplementation::~EventHandlerImplementation() {
+  for (intptr_t i = 0; i < num_shards_; i++) {
+    delete shards_[i];
+  }
+  delete[] shards_;
+}
+
+EventHandlerShard* EventHandlerImplementation::ShardFor(intptr_t id) {
+  if ((num_shards_ == 1) || (id == kTimerId)) {
+    return shards_[0];
+  }
+  ASSERT(id != kShutdownId);
+  // Commands for already closed sockets are dropped by any shard.
+  const intptr_t fd = reinterpret_cast<Socket*>(id)->fd();
+  return shards_[(fd < 0) ? 0 : (fd % num_shards_)];
+}
+
+void EventHandlerImplementation::SendData(intptr_t id,
+                                          Dart_Port dart_port,
+                                          int64_t data) {
+  ShardFor(id)->SendData(id, dart_port, data);
+}
+
+void EventHandlerImplementation::Start(EventHandler* handler) {
+  handler_ = handler;
+  running_shards_ = num_shards_;
+  for (intptr_t i = 0; i < num_shards_; i++) {
+    shards_[i]->Start();
+  }
+}
+
+void EventHandlerImplementation::Shutdown() {
+  for (intptr_t i = 0; i < num_shards_; i++) {
+    shards_[i]->Shutdown();
+  }
+}
+
+void EventHandlerImplementation::NotifyShardShutdownDone() {
+  if (running_shards_.fetch_sub(1) == 1) {
+    DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
+    handler_->NotifyShutdownDone();
+  }
+}
+
 }  // namespace bin
 }  // namespace dart
 
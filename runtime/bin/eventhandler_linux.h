@@ -14,6 +14,8 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <atomic>
+
 #include "platform/hashmap.h"
 #include "platform/signal_blocker.h"
 
@@ -57,10 +59,53 @@ class DescriptorInfoMultiple
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfoMultiple);
 };
 
-class EventHandlerImplementation {
+class EventHandlerImplementation;
+
+// Counts the work of an event handler thread and periodically reports it as
+// a counter event on the embedder timeline stream:
+//  - wakeups: number of epoll_wait calls returning events,
+//  - events: number of descriptor events they returned,
+//  - commands: number of commands sent to the event handler,
+//  - handle_micros: time spent handling events and commands,
+//  - max_delivery_micros: longest time from epoll_wait returning until the
+//    last of its events was posted to its Dart port.
+class EventHandlerStats {
  public:
-  EventHandlerImplementation();
-  ~EventHandlerImplementation();
+  EventHandlerStats() {}
+
+  void RecordCommand() { commands_++; }
+  void RecordWakeup(intptr_t events,
+                    int64_t start,
+                    int64_t delivered,
+                    int64_t end);
+
+ private:
+  static constexpr int64_t kReportIntervalMicros = 1000000;
+  static constexpr intptr_t kMaxCounterLength = 24;
+
+  void Report(int64_t now);
+
+  int64_t interval_start_ = 0;
+  int64_t wakeups_ = 0;
+  int64_t events_ = 0;
+  int64_t commands_ = 0;
+  int64_t handle_micros_ = 0;
+  int64_t max_delivery_micros_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(EventHandlerStats);
+};
+
+struct InterruptCommand {
+  InterruptMessage message;
+  InterruptCommand* next;
+};
+
+// An epoll instance with its own thread, serving the descriptors assigned
+// to it by the EventHandlerImplementation.
+class EventHandlerShard {
+ public:
+  explicit EventHandlerShard(EventHandlerImplementation* owner);
+  ~EventHandlerShard();
 
   void UpdateEpollInstance(intptr_t old_mask, DescriptorInfo* di);
 
@@ -68,7 +113,7 @@ class EventHandlerImplementation {
   // descriptor. Creates a new one if one is not found.
   DescriptorInfo* GetDescriptorInfo(intptr_t fd, bool is_listening);
   void SendData(intptr_t id, Dart_Port dart_port, int64_t data);
-  void Start(EventHandler* handler);
+  void Start();
   void Shutdown();
 
  private:
@@ -76,6 +121,7 @@ class EventHandlerImplementation {
   static void Poll(uword args);
   void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
   void HandleInterruptFd();
+  void HandleInterruptMessage(const InterruptMessage& msg);
   void UpdateTimerFd();
   void SetPort(intptr_t fd, Dart_Port dart_port, intptr_t mask);
   intptr_t GetPollEvents(intptr_t events, DescriptorInfo* di);
@@ -84,10 +130,48 @@ class EventHandlerImplementation {
 
   SimpleHashMap socket_map_;
   TimeoutQueue timeout_queue_;
+  EventHandlerStats stats_;
   bool shutdown_;
-  int interrupt_fds_[2];
+  // Commands are pushed by any thread and drained by the handler thread,
+  // which is woken up through the interrupt eventfd.
+  std::atomic<InterruptCommand*> commands_;
+  int interrupt_fd_;
   int epoll_fd_;
   int timer_fd_;
+  EventHandlerImplementation* const owner_;
+
+  DISALLOW_COPY_AND_ASSIGN(EventHandlerShard);
+};
+
+// Dispatches I/O readiness on one or more EventHandlerShards. Descriptors are
+// assigned to shards by their number, so all sockets sharing a descriptor
+// (e.g. listening sockets shared between isolates) are served by the same
+// shard. Timers are handled by the first shard.
+//
+// The number of shards is read from the DART_IO_EVENT_HANDLER_THREADS
+// environment variable and defaults to one.
+class EventHandlerImplementation {
+ public:
+  EventHandlerImplementation();
+  ~EventHandlerImplementation();
+
+  void SendData(intptr_t id, Dart_Port dart_port, int64_t data);
+  void Start(EventHandler* handler);
+  void Shutdown();
+
+ private:
+  friend class EventHandlerShard;
+
+  EventHandlerShard* ShardFor(intptr_t id);
+
+  // Called by each shard once its thread is done. The last one notifies the
+  // EventHandler.
+  void NotifyShardShutdownDone();
+
+  EventHandlerShard** shards_;
+  intptr_t num_shards_;
+  std::atomic<intptr_t> running_shards_;
+  EventHandler* handler_;
 
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
@@ -211,17 +211,21 @@ void FUNCTION_NAME(File_Read)(Dart_NativeArguments args) {
   }
 }
 
-void FUNCTION_NAME(File_ReadInto)(Dart_NativeArguments args) {
+// Reads into the list at argument [buffer_index] from [position] in the file,
+// or from the current position if [position] is negative.
+static void ReadIntoList(Dart_NativeArguments args,
+                         intptr_t buffer_index,
+                         int64_t position) {
   File* file = GetFile(args);
   ASSERT(file != nullptr);
-  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, buffer_index);
   ASSERT(Dart_IsList(buffer_obj));
   // start and end arguments are checked in Dart code to be
   // integers and have the property that end <=
   // list.length. Therefore, it is safe to extract their value as
   // intptr_t.
-  intptr_t start = DartUtils::GetNativeIntptrArgument(args, 2);
-  intptr_t end = DartUtils::GetNativeIntptrArgument(args, 3);
+  intptr_t start = DartUtils::GetNativeIntptrArgument(args, buffer_index + 1);
+  intptr_t end = DartUtils::GetNativeIntptrArgument(args, buffer_index + 2);
   intptr_t length = end - start;
   intptr_t array_len = 0;
   Dart_Handle result = Dart_ListLength(buffer_obj, &array_len);
@@ -251,7 +255,10 @@ void FUNCTION_NAME(File_ReadInto)(Dart_NativeArguments args) {
     buffer = Dart_ScopeAllocate(length);
   }
 
-  int64_t bytes_read = file->Read(reinterpret_cast<void*>(buffer), length);
+  int64_t bytes_read =
+      (position < 0)
+          ? file->Read(reinterpret_cast<void*>(buffer), length)
+          : file->ReadAt(reinterpret_cast<void*>(buffer), length, position);
   OSError* os_error = new OSError();  // capture error if any
   if (is_byte_data) {
     Dart_Handle handle = Dart_TypedDataReleaseData(buffer_obj);
@@ -276,18 +283,31 @@ void FUNCTION_NAME(File_ReadInto)(Dart_NativeArguments args) {
   delete os_error;
 }
 
-void FUNCTION_NAME(File_WriteFrom)(Dart_NativeArguments args) {
+void FUNCTION_NAME(File_ReadInto)(Dart_NativeArguments args) {
+  ReadIntoList(args, 1, /*position=*/-1);
+}
+
+void FUNCTION_NAME(File_ReadIntoAt)(Dart_NativeArguments args) {
+  // The position is checked in Dart code to be non-negative.
+  ReadIntoList(args, 2, DartUtils::GetNativeIntegerArgument(args, 1));
+}
+
+// Writes the list at argument [buffer_index] at [position] in the file, or at
+// the current position if [position] is negative.
+static void WriteFromList(Dart_NativeArguments args,
+                          intptr_t buffer_index,
+                          int64_t position) {
   File* file = GetFile(args);
   ASSERT(file != nullptr);
 
-  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, buffer_index);
 
   // Offset and length arguments are checked in Dart code to be
   // integers and have the property that (offset + length) <=
   // list.length. Therefore, it is safe to extract their value as
   // intptr_t.
-  intptr_t start = DartUtils::GetNativeIntptrArgument(args, 2);
-  intptr_t end = DartUtils::GetNativeIntptrArgument(args, 3);
+  intptr_t start = DartUtils::GetNativeIntptrArgument(args, buffer_index + 1);
+  intptr_t end = DartUtils::GetNativeIntptrArgument(args, buffer_index + 2);
 
   // The buffer object passed in has to be an Int8List or Uint8List object.
   // Acquire a direct pointer to the data area of the buffer object.
@@ -305,7 +325,10 @@ void FUNCTION_NAME(File_WriteFrom)(Dart_NativeArguments args) {
 
   // Write all the data out into the file.
   char* byte_buffer = reinterpret_cast<char*>(buffer);
-  bool success = file->WriteFully(byte_buffer + start, length);
+  bool success =
+      (position < 0)
+          ? file->WriteFully(byte_buffer + start, length)
+          : file->WriteFullyAt(byte_buffer + start, length, position);
   OSError* os_error = new OSError();  // capture error if any
 
   // Release the direct pointer acquired above.
@@ -322,6 +345,15 @@ void FUNCTION_NAME(File_WriteFrom)(Dart_NativeArguments args) {
   delete os_error;
 }
 
+void FUNCTION_NAME(File_WriteFrom)(Dart_NativeArguments args) {
+  WriteFromList(args, 1, /*position=*/-1);
+}
+
+void FUNCTION_NAME(File_WriteFromAt)(Dart_NativeArguments args) {
+  // The position is checked in Dart code to be non-negative.
+  WriteFromList(args, 2, DartUtils::GetNativeIntegerArgument(args, 1));
+}
+
 void FUNCTION_NAME(File_Position)(Dart_NativeArguments args) {
   File* file = GetFile(args);
   ASSERT(file != nullptr);
@@ -470,6 +502,67 @@ void FUNCTION_NAME(File_Lock)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
 }
 
+static void UnmapFile(void* isolate_data, void* peer) {
+  delete reinterpret_cast<MappedMemory*>(peer);
+}
+
+void FUNCTION_NAME(File_Map)(Dart_NativeArguments args) {
+  // Mapped offsets are aligned to the largest page size of all platforms.
+  static constexpr int64_t kMapAlignment = 64 * KB;
+  File* file = GetFile(args);
+  ASSERT(file != nullptr);
+  int64_t start;
+  int64_t end;
+  int64_t advice;
+  if (DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &start) &&
+      DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 2), &end) &&
+      DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 3), &advice) &&
+      (start >= 0) && (end >= start) && (advice >= MappedMemory::kNormal) &&
+      (advice <= MappedMemory::kWillNeed)) {
+    // Accessing pages past the end of the file faults.
+    const int64_t file_length = file->Length();
+    if (file_length < 0) {
+      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+      return;
+    }
+    const int64_t offset = start % kMapAlignment;
+    const int64_t length = end - start;
+    if ((end <= file_length) && (offset + length <= kIntptrMax)) {
+      if (length == 0) {
+        Dart_SetReturnValue(args, Dart_NewTypedData(Dart_TypedData_kUint8, 0));
+        return;
+      }
+#if defined(DART_HOST_OS_WINDOWS)
+      // Mapping copies the file by reading from it.
+      const int64_t position = file->Position();
+#endif
+      MappedMemory* mapping =
+          file->Map(File::kReadOnly, start - offset, offset + length);
+#if defined(DART_HOST_OS_WINDOWS)
+      file->SetPosition(position);
+#endif
+      if (mapping == nullptr) {
+        Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+        return;
+      }
+      // The advice only affects performance.
+      mapping->Advise(static_cast<MappedMemory::Advice>(advice));
+      Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+          Dart_TypedData_kUint8,
+          reinterpret_cast<uint8_t*>(mapping->address()) + offset, length,
+          mapping, mapping->size(), UnmapFile);
+      if (Dart_IsError(result)) {
+        delete mapping;
+        Dart_PropagateError(result);
+      }
+      Dart_SetReturnValue(args, result);
+      return;
+    }
+  }
+  OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+  Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+}
+
 void FUNCTION_NAME(File_Create)(Dart_NativeArguments args) {
   Namespace* namespc = Namespace::GetNamespace(args, 0);
   Dart_Handle exclusive_handle = Dart_GetNativeArgument(args, 2);
@@ -1176,25 +1269,17 @@ CObject* File::ReadRequest(const CObjectArray& request) {
   return result;
 }
 
-CObject* File::ReadIntoRequest(const CObjectArray& request) {
-  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
-    return CObject::IllegalArgumentError();
-  }
-  File* file = CObjectToFilePointer(request[0]);
-  RefCntReleaseScope<File> rs(file);
-  if ((request.Length() != 2) || !request[1]->IsInt32OrInt64()) {
-    return CObject::IllegalArgumentError();
-  }
-  if (file->IsClosed()) {
-    return CObject::FileClosedError();
-  }
-  const int64_t length = CObjectInt32OrInt64ToInt64(request[1]);
+// Reads [length] bytes from [position] in [file], or from the current position
+// if [position] is negative.
+static CObject* ReadIntoResponse(File* file, int64_t length, int64_t position) {
   Dart_CObject* io_buffer = CObject::NewIOBuffer(length);
   if (io_buffer == nullptr) {
     return CObject::NewOSError();
   }
   uint8_t* data = io_buffer->value.as_external_typed_data.data;
-  const int64_t bytes_read = file->Read(data, length);
+  const int64_t bytes_read = (position < 0)
+                                 ? file->Read(data, length)
+                                 : file->ReadAt(data, length, position);
   if (bytes_read < 0) {
     CObject* error = CObject::NewOSError();
     CObject::FreeIOBufferData(io_buffer);
@@ -1213,6 +1298,43 @@ CObject* File::ReadIntoRequest(const CObjectArray& request) {
   return result;
 }
 
+CObject* File::ReadIntoRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  File* file = CObjectToFilePointer(request[0]);
+  RefCntReleaseScope<File> rs(file);
+  if ((request.Length() != 2) || !request[1]->IsInt32OrInt64()) {
+    return CObject::IllegalArgumentError();
+  }
+  if (file->IsClosed()) {
+    return CObject::FileClosedError();
+  }
+  const int64_t length = CObjectInt32OrInt64ToInt64(request[1]);
+  return ReadIntoResponse(file, length, /*position=*/-1);
+}
+
+CObject* File::ReadIntoAtRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  File* file = CObjectToFilePointer(request[0]);
+  RefCntReleaseScope<File> rs(file);
+  if ((request.Length() != 3) || !request[1]->IsInt32OrInt64() ||
+      !request[2]->IsInt32OrInt64()) {
+    return CObject::IllegalArgumentError();
+  }
+  if (file->IsClosed()) {
+    return CObject::FileClosedError();
+  }
+  const int64_t position = CObjectInt32OrInt64ToInt64(request[1]);
+  const int64_t length = CObjectInt32OrInt64ToInt64(request[2]);
+  if (position < 0) {
+    return CObject::IllegalArgumentError();
+  }
+  return ReadIntoResponse(file, length, position);
+}
+
 static int SizeInBytes(Dart_TypedData_Type type) {
   switch (type) {
     case Dart_TypedData_kInt8:
@@ -1241,31 +1363,33 @@ static int SizeInBytes(Dart_TypedData_Type type) {
   return -1;
 }
 
-CObject* File::WriteFromRequest(const CObjectArray& request) {
-  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
-    return CObject::IllegalArgumentError();
-  }
-  File* file = CObjectToFilePointer(request[0]);
-  RefCntReleaseScope<File> rs(file);
-  if ((request.Length() != 4) ||
-      (!request[1]->IsTypedData() && !request[1]->IsArray()) ||
-      !request[2]->IsInt32OrInt64() || !request[3]->IsInt32OrInt64()) {
+// Writes the buffer, start and end at [buffer_index] in [request] at
+// [position] in [file], or at the current position if [position] is negative.
+static CObject* WriteFromResponse(File* file,
+                                  const CObjectArray& request,
+                                  intptr_t buffer_index,
+                                  int64_t position) {
+  if ((request.Length() != buffer_index + 3) ||
+      (!request[buffer_index]->IsTypedData() &&
+       !request[buffer_index]->IsArray()) ||
+      !request[buffer_index + 1]->IsInt32OrInt64() ||
+      !request[buffer_index + 2]->IsInt32OrInt64()) {
     return CObject::IllegalArgumentError();
   }
   if (file->IsClosed()) {
     return CObject::FileClosedError();
   }
-  int64_t start = CObjectInt32OrInt64ToInt64(request[2]);
-  int64_t end = CObjectInt32OrInt64ToInt64(request[3]);
+  int64_t start = CObjectInt32OrInt64ToInt64(request[buffer_index + 1]);
+  int64_t end = CObjectInt32OrInt64ToInt64(request[buffer_index + 2]);
   int64_t length = end - start;
   const uint8_t* buffer_start;
-  if (request[1]->IsTypedData()) {
-    CObjectTypedData typed_data(request[1]);
+  if (request[buffer_index]->IsTypedData()) {
+    CObjectTypedData typed_data(request[buffer_index]);
     start = start * SizeInBytes(typed_data.Type());
     length = length * SizeInBytes(typed_data.Type());
     buffer_start = typed_data.Buffer() + start;
   } else {
-    CObjectArray array(request[1]);
+    CObjectArray array(request[buffer_index]);
     uint8_t* allocated_buffer = Dart_ScopeAllocate(length);
     buffer_start = allocated_buffer;
     for (int i = 0; i < length; i++) {
@@ -1279,9 +1403,37 @@ CObject* File::WriteFromRequest(const CObjectArray& request) {
     }
     start = 0;
   }
-  return file->WriteFully(reinterpret_cast<const void*>(buffer_start), length)
-             ? new CObjectInt64(CObject::NewInt64(length))
-             : CObject::NewOSError();
+  const bool success =
+      (position < 0)
+          ? file->WriteFully(buffer_start, length)
+          : file->WriteFullyAt(buffer_start, length, position);
+  return success ? new CObjectInt64(CObject::NewInt64(length))
+                 : CObject::NewOSError();
+}
+
+CObject* File::WriteFromRequest(const CObjectArray& request) {
+  if ((request.Length() < 1) || !request[0]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  File* file = CObjectToFilePointer(request[0]);
+  RefCntReleaseScope<File> rs(file);
+  return WriteFromResponse(file, request, 1, /*position=*/-1);
+}
+
+CObject* File::WriteFromAtRequest(const CObjectArray& request) {
+  if ((request.Length() < 2) || !request[0]->IsIntptr()) {
+    return CObject::IllegalArgumentError();
+  }
+  File* file = CObjectToFilePointer(request[0]);
+  RefCntReleaseScope<File> rs(file);
+  if (!request[1]->IsInt32OrInt64()) {
+    return CObject::IllegalArgumentError();
+  }
+  const int64_t position = CObjectInt32OrInt64ToInt64(request[1]);
+  if (position < 0) {
+    return CObject::IllegalArgumentError();
+  }
+  return WriteFromResponse(file, request, 2, position);
 }
 
 CObject* File::CreateLinkRequest(const CObjectArray& request) {
@@ -37,6 +37,18 @@ class MappedMemory {
 
   void Leak() { should_unmap_ = false; }
 
+  // Expected access to the pages of a mapping.
+  enum Advice {
+    kNormal = 0,
+    kSequential = 1,
+    kRandom = 2,
+    kWillNeed = 3,
+  };
+
+  // Passes [advice] on to the OS, which may read ahead, prefetch or evict
+  // pages based on it. Returns false if the advice was rejected.
+  bool Advise(Advice advice);
+
  private:
   void Unmap();
 
@@ -156,12 +168,19 @@ class File : public ReferenceCounted<File> {
   // of bytes written.
   int64_t Write(const void* buffer, int64_t num_bytes);
 
+  // Like Read and Write, but at 'position' in the file instead of the current
+  // position, which is left unchanged on all platforms but Windows. Calls from
+  // different threads may overlap.
+  int64_t ReadAt(void* buffer, int64_t num_bytes, int64_t position);
+  int64_t WriteAt(const void* buffer, int64_t num_bytes, int64_t position);
+
   // ReadFully and WriteFully do attempt to transfer num_bytes to/from
   // the buffer. In the event of short accesses they will loop internally until
   // the whole buffer has been transferred or an error occurs. If an error
   // occurred the result will be set to false.
   bool ReadFully(void* buffer, int64_t num_bytes);
   bool WriteFully(const void* buffer, int64_t num_bytes);
+  bool WriteFullyAt(const void* buffer, int64_t num_bytes, int64_t position);
   bool WriteByte(uint8_t byte) { return WriteFully(&byte, 1); }
 
   bool Print(const char* format, ...) PRINTF_ATTRIBUTE(2, 3) {
@@ -334,6 +353,8 @@ class File : public ReferenceCounted<File> {
   static CObject* ReadRequest(const CObjectArray& request);
   static CObject* ReadIntoRequest(const CObjectArray& request);
   static CObject* WriteFromRequest(const CObjectArray& request);
+  static CObject* ReadIntoAtRequest(const CObjectArray& request);
+  static CObject* WriteFromAtRequest(const CObjectArray& request);
   static CObject* CreateLinkRequest(const CObjectArray& request);
   static CObject* DeleteLinkRequest(const CObjectArray& request);
   static CObject* RenameLinkRequest(const CObjectArray& request);
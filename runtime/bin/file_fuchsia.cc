@@ -120,6 +120,10 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+bool MappedMemory::Advise(Advice advice) {
+  return true;
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return NO_RETRY_EXPECTED(read(handle_->fd(), buffer, num_bytes));
@@ -130,6 +134,16 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
   return NO_RETRY_EXPECTED(write(handle_->fd(), buffer, num_bytes));
 }
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return NO_RETRY_EXPECTED(pread(handle_->fd(), buffer, num_bytes, position));
+}
+
+int64_t File::WriteAt(const void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return NO_RETRY_EXPECTED(pwrite(handle_->fd(), buffer, num_bytes, position));
+}
+
 bool File::VPrint(const char* format, va_list args) {
   // Measure.
   va_list measure_args;
@@ -129,6 +129,25 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+bool MappedMemory::Advise(Advice advice) {
+  int native_advice = MADV_NORMAL;
+  switch (advice) {
+    case kNormal:
+      native_advice = MADV_NORMAL;
+      break;
+    case kSequential:
+      native_advice = MADV_SEQUENTIAL;
+      break;
+    case kRandom:
+      native_advice = MADV_RANDOM;
+      break;
+    case kWillNeed:
+      native_advice = MADV_WILLNEED;
+      break;
+  }
+  return madvise(address_, size_, native_advice) == 0;
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
@@ -139,6 +158,18 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
   return TEMP_FAILURE_RETRY(write(handle_->fd(), buffer, num_bytes));
 }
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(
+      pread64(handle_->fd(), buffer, num_bytes, position));
+}
+
+int64_t File::WriteAt(const void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(
+      pwrite64(handle_->fd(), buffer, num_bytes, position));
+}
+
 bool File::VPrint(const char* format, va_list args) {
   // Measure.
   va_list measure_args;
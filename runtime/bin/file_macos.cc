@@ -167,6 +167,25 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+bool MappedMemory::Advise(Advice advice) {
+  int native_advice = MADV_NORMAL;
+  switch (advice) {
+    case kNormal:
+      native_advice = MADV_NORMAL;
+      break;
+    case kSequential:
+      native_advice = MADV_SEQUENTIAL;
+      break;
+    case kRandom:
+      native_advice = MADV_RANDOM;
+      break;
+    case kWillNeed:
+      native_advice = MADV_WILLNEED;
+      break;
+  }
+  return madvise(address_, size_, native_advice) == 0;
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return TEMP_FAILURE_RETRY(read(handle_->fd(), buffer, num_bytes));
@@ -178,6 +197,17 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
   return TEMP_FAILURE_RETRY(write(handle_->fd(), buffer, num_bytes));
 }
 
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  ASSERT(handle_->fd() >= 0);
+  return TEMP_FAILURE_RETRY(pread(handle_->fd(), buffer, num_bytes, position));
+}
+
+int64_t File::WriteAt(const void* buffer, int64_t num_bytes, int64_t position) {
+  // Invalid argument error will pop if num_bytes exceeds the limit.
+  ASSERT(handle_->fd() >= 0 && num_bytes <= kMaxInt32);
+  return TEMP_FAILURE_RETRY(pwrite(handle_->fd(), buffer, num_bytes, position));
+}
+
 bool File::VPrint(const char* format, va_list args) {
   // Measure.
   va_list measure_args;
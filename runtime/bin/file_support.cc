@@ -52,6 +52,25 @@ bool File::ReadFully(void* buffer, int64_t num_bytes) {
   return true;
 }
 
+bool File::WriteFullyAt(const void* buffer,
+                        int64_t num_bytes,
+                        int64_t position) {
+  int64_t remaining = num_bytes;
+  const char* current_buffer = reinterpret_cast<const char*>(buffer);
+  while (remaining > 0) {
+    // See WriteFully.
+    int64_t byte_to_write = remaining > kMaxInt32 ? kMaxInt32 : remaining;
+    int64_t bytes_written = WriteAt(current_buffer, byte_to_write, position);
+    if (bytes_written < 0) {
+      return false;
+    }
+    remaining -= bytes_written;
+    current_buffer += bytes_written;
+    position += bytes_written;
+  }
+  return true;
+}
+
 bool File::WriteFully(const void* buffer, int64_t num_bytes) {
   int64_t remaining = num_bytes;
   const char* current_buffer = reinterpret_cast<const char*>(buffer);
@@ -103,7 +103,11 @@ static int InotifyEventToMask(struct inotify_event* e) {
 Dart_Handle FileSystemWatcher::ReadEvents(intptr_t id, intptr_t path_id) {
   USE(path_id);
   const intptr_t kEventSize = sizeof(struct inotify_event);
-  const intptr_t kBufferSize = kEventSize + NAME_MAX + 1;
+  // Read a batch of events at a time instead of one, so that bursts of
+  // changes (e.g. a checkout) need fewer reads and fewer calls from Dart.
+  // The buffer must fit at least one event with the longest name.
+  const intptr_t kMaxEventsPerRead = 16;
+  const intptr_t kBufferSize = kMaxEventsPerRead * (kEventSize + NAME_MAX + 1);
   uint8_t buffer[kBufferSize];
   intptr_t bytes =
       SocketBase::Read(id, buffer, kBufferSize, SocketBase::kAsync);
@@ -148,6 +148,11 @@ void MappedMemory::Unmap() {
   size_ = 0;
 }
 
+bool MappedMemory::Advise(Advice advice) {
+  // Mappings are copies of the file, which are already in memory.
+  return true;
+}
+
 int64_t File::Read(void* buffer, int64_t num_bytes) {
   ASSERT(handle_->fd() >= 0);
   return Utils::Read(handle_->fd(), buffer, num_bytes);
@@ -186,6 +191,42 @@ int64_t File::Write(const void* buffer, int64_t num_bytes) {
   return bytes_written;
 }
 
+// Passing an offset to ReadFile and WriteFile also moves the position of
+// synchronous handles.
+static OVERLAPPED OverlappedAt(int64_t position) {
+  OVERLAPPED overlapped;
+  ZeroMemory(&overlapped, sizeof(OVERLAPPED));
+  overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+  overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+  return overlapped;
+}
+
+int64_t File::ReadAt(void* buffer, int64_t num_bytes, int64_t position) {
+  int fd = handle_->fd();
+  // Avoid narrowing conversion
+  ASSERT(fd >= 0 && num_bytes <= MAXDWORD && num_bytes >= 0);
+  HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+  OVERLAPPED overlapped = OverlappedAt(position);
+  DWORD read = 0;
+  if (!ReadFile(handle, buffer, num_bytes, &read, &overlapped)) {
+    return (GetLastError() == ERROR_HANDLE_EOF) ? 0 : -1;
+  }
+  return read;
+}
+
+int64_t File::WriteAt(const void* buffer, int64_t num_bytes, int64_t position) {
+  int fd = handle_->fd();
+  // Avoid narrowing conversion
+  ASSERT(fd >= 0 && num_bytes <= MAXDWORD && num_bytes >= 0);
+  HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+  OVERLAPPED overlapped = OverlappedAt(position);
+  DWORD written = 0;
+  if (!WriteFile(handle, buffer, num_bytes, &written, &overlapped)) {
+    return -1;
+  }
+  return written;
+}
+
 bool File::VPrint(const char* format, va_list args) {
   // Measure.
   va_list measure_args;
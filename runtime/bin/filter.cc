@@ -6,6 +6,7 @@
 
 #include "bin/dartutils.h"
 #include "bin/io_buffer.h"
+#include "bin/lockers.h"
 
 #include "include/dart_api.h"
 
@@ -277,11 +278,93 @@ Dart_Handle Filter::GetFilterNativeField(Dart_Handle filter,
       reinterpret_cast<intptr_t*>(filter_pointer));
 }
 
+Mutex* ZLibStreamPool::mutex_ = nullptr;
+intptr_t ZLibStreamPool::num_pooled_ = 0;
+ZLibStreamPool::Key ZLibStreamPool::keys_[kMaxPooledStreams];
+z_stream* ZLibStreamPool::streams_[kMaxPooledStreams];
+
+void ZLibStreamPool::Init() {
+  ASSERT(mutex_ == nullptr);
+  mutex_ = new Mutex();
+}
+
+void ZLibStreamPool::Cleanup() {
+  ASSERT(mutex_ != nullptr);
+  for (intptr_t i = 0; i < num_pooled_; i++) {
+    Delete(keys_[i], streams_[i]);
+  }
+  num_pooled_ = 0;
+  delete mutex_;
+  mutex_ = nullptr;
+}
+
+z_stream* ZLibStreamPool::New(const Key& key) {
+  z_stream* stream = new z_stream();
+  stream->next_in = Z_NULL;
+  stream->avail_in = 0;
+  stream->zalloc = Z_NULL;
+  stream->zfree = Z_NULL;
+  stream->opaque = Z_NULL;
+  int result = key.deflate
+                   ? deflateInit2(stream, key.level, Z_DEFLATED,
+                                  key.window_bits, key.mem_level, key.strategy)
+                   : inflateInit2(stream, key.window_bits);
+  if (result != Z_OK) {
+    delete stream;
+    return nullptr;
+  }
+  return stream;
+}
+
+void ZLibStreamPool::Delete(const Key& key, z_stream* stream) {
+  if (key.deflate) {
+    deflateEnd(stream);
+  } else {
+    inflateEnd(stream);
+  }
+  delete stream;
+}
+
+z_stream* ZLibStreamPool::Acquire(const Key& key) {
+  if (mutex_ != nullptr) {
+    MutexLocker ml(mutex_);
+    for (intptr_t i = num_pooled_ - 1; i >= 0; i--) {
+      if (keys_[i].Equals(key)) {
+        z_stream* stream = streams_[i];
+        num_pooled_--;
+        keys_[i] = keys_[num_pooled_];
+        streams_[i] = streams_[num_pooled_];
+        return stream;
+      }
+    }
+  }
+  return New(key);
+}
+
+void ZLibStreamPool::Release(const Key& key, z_stream* stream) {
+  // Resetting keeps the windows allocated, but drops the input and output
+  // pointers which refer to buffers of the filter.
+  int result = key.deflate ? deflateReset(stream) : inflateReset(stream);
+  stream->next_in = Z_NULL;
+  stream->avail_in = 0;
+  stream->next_out = Z_NULL;
+  stream->avail_out = 0;
+  if ((result == Z_OK) && (mutex_ != nullptr)) {
+    MutexLocker ml(mutex_);
+    if (num_pooled_ < kMaxPooledStreams) {
+      keys_[num_pooled_] = key;
+      streams_[num_pooled_] = stream;
+      num_pooled_++;
+      return;
+    }
+  }
+  Delete(key, stream);
+}
+
 ZLibDeflateFilter::~ZLibDeflateFilter() {
   delete[] dictionary_;
-  delete[] current_buffer_;
   if (initialized()) {
-    deflateEnd(&stream_);
+    ZLibStreamPool::Release(key_, stream_);
   }
 }
 
@@ -302,50 +385,43 @@ bool ZLibDeflateFilter::Init() {
   } else if (gzip_) {
     window_bits += kZLibFlagUseGZipHeader;
   }
-  stream_.next_in = Z_NULL;
-  stream_.zalloc = Z_NULL;
-  stream_.zfree = Z_NULL;
-  stream_.opaque = Z_NULL;
-  int result = deflateInit2(&stream_, level_, Z_DEFLATED, window_bits,
-                            mem_level_, strategy_);
-  if (result != Z_OK) {
+  key_ = {/*deflate=*/true, level_, window_bits, mem_level_, strategy_};
+  stream_ = ZLibStreamPool::Acquire(key_);
+  if (stream_ == nullptr) {
     return false;
   }
+  // Mark initialized first so that the stream is released on failure.
+  set_initialized(true);
   if ((dictionary_ != nullptr) && !gzip_ && !raw_) {
-    result = deflateSetDictionary(&stream_, dictionary_, dictionary_length_);
+    int result = deflateSetDictionary(stream_, dictionary_, dictionary_length_);
     delete[] dictionary_;
     dictionary_ = nullptr;
     if (result != Z_OK) {
       return false;
     }
   }
-  set_initialized(true);
   return true;
 }
 
-bool ZLibDeflateFilter::Process(uint8_t* data, intptr_t length) {
-  if (current_buffer_ != nullptr) {
-    return false;
-  }
-  stream_.avail_in = length;
-  stream_.next_in = current_buffer_ = data;
-  return true;
+void ZLibDeflateFilter::SetInput(uint8_t* data, intptr_t length) {
+  stream_->avail_in = length;
+  stream_->next_in = data;
 }
 
 intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
                                       intptr_t length,
                                       bool flush,
                                       bool end) {
-  stream_.avail_out = length;
-  stream_.next_out = buffer;
+  stream_->avail_out = length;
+  stream_->next_out = buffer;
   bool error = false;
-  switch (deflate(&stream_, end     ? Z_FINISH
-                            : flush ? Z_SYNC_FLUSH
-                                    : Z_NO_FLUSH)) {
+  switch (deflate(stream_, end     ? Z_FINISH
+                           : flush ? Z_SYNC_FLUSH
+                                   : Z_NO_FLUSH)) {
     case Z_OK:
     case Z_STREAM_END:
     case Z_BUF_ERROR: {
-      intptr_t processed = length - stream_.avail_out;
+      intptr_t processed = length - stream_->avail_out;
       if (processed == 0) {
         break;
       }
@@ -357,61 +433,50 @@ intptr_t ZLibDeflateFilter::Processed(uint8_t* buffer,
       error = true;
   }
 
-  delete[] current_buffer_;
-  current_buffer_ = nullptr;
+  ReleaseInput();
   // Either 0 Byte processed or error
   return error ? -1 : 0;
 }
 
 ZLibInflateFilter::~ZLibInflateFilter() {
   delete[] dictionary_;
-  delete[] current_buffer_;
   if (initialized()) {
-    inflateEnd(&stream_);
+    ZLibStreamPool::Release(key_, stream_);
   }
 }
 
 bool ZLibInflateFilter::Init() {
   int window_bits =
       raw_ ? -window_bits_ : window_bits_ | kZLibFlagAcceptAnyHeader;
-
-  stream_.next_in = Z_NULL;
-  stream_.avail_in = 0;
-  stream_.zalloc = Z_NULL;
-  stream_.zfree = Z_NULL;
-  stream_.opaque = Z_NULL;
-  int result = inflateInit2(&stream_, window_bits);
-  if (result != Z_OK) {
+  key_ = {/*deflate=*/false, 0, window_bits, 0, 0};
+  stream_ = ZLibStreamPool::Acquire(key_);
+  if (stream_ == nullptr) {
     return false;
   }
   set_initialized(true);
   return true;
 }
 
-bool ZLibInflateFilter::Process(uint8_t* data, intptr_t length) {
-  if (current_buffer_ != nullptr) {
-    return false;
-  }
-  stream_.avail_in = length;
-  stream_.next_in = current_buffer_ = data;
-  return true;
+void ZLibInflateFilter::SetInput(uint8_t* data, intptr_t length) {
+  stream_->avail_in = length;
+  stream_->next_in = data;
 }
 
 intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
                                       intptr_t length,
                                       bool flush,
                                       bool end) {
-  stream_.avail_out = length;
-  stream_.next_out = buffer;
+  stream_->avail_out = length;
+  stream_->next_out = buffer;
   bool error = false;
   int v;
-  switch (v = inflate(&stream_, end     ? Z_FINISH
-                                : flush ? Z_SYNC_FLUSH
-                                        : Z_NO_FLUSH)) {
+  switch (v = inflate(stream_, end     ? Z_FINISH
+                               : flush ? Z_SYNC_FLUSH
+                                       : Z_NO_FLUSH)) {
     case Z_OK:
     case Z_STREAM_END:
     case Z_BUF_ERROR: {
-      intptr_t processed = length - stream_.avail_out;
+      intptr_t processed = length - stream_->avail_out;
       if (v == Z_STREAM_END && gzip_) {
         // Allow for concatenated compressed data sets. For example:
         // final data = [
@@ -431,7 +496,7 @@ intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
         // The return code for `inflateReset` can be ignored because, if the
         // result is an error, the same error will be returned in the next
         // call to `inflate`.
-        inflateReset(&stream_);
+        inflateReset(stream_);
       }
       if (processed == 0) {
         break;
@@ -444,7 +509,7 @@ intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
         error = true;
       } else {
         int result =
-            inflateSetDictionary(&stream_, dictionary_, dictionary_length_);
+            inflateSetDictionary(stream_, dictionary_, dictionary_length_);
         delete[] dictionary_;
         dictionary_ = nullptr;
         error = result != Z_OK;
@@ -462,8 +527,7 @@ intptr_t ZLibInflateFilter::Processed(uint8_t* buffer,
       error = true;
   }
 
-  delete[] current_buffer_;
-  current_buffer_ = nullptr;
+  ReleaseInput();
   // Either 0 Byte processed or error
   return error ? -1 : 0;
 }
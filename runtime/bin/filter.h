@@ -6,6 +6,7 @@
 #define RUNTIME_BIN_FILTER_H_
 
 #include "bin/builtin.h"
+#include "bin/lockers.h"
 #include "bin/utils.h"
 
 #include "zlib/zlib.h"
@@ -13,9 +14,12 @@
 namespace dart {
 namespace bin {
 
+// Base class of the native codecs behind RawZLibFilter. It owns the chunk
+// of input being processed and the output buffer, so that a codec only needs
+// to implement Init, SetInput and Processed.
 class Filter {
  public:
-  virtual ~Filter() {}
+  virtual ~Filter() { delete[] current_buffer_; }
 
   virtual bool Init() = 0;
 
@@ -24,7 +28,14 @@ class Filter {
    * successive calls to either Processed or ~Filter, data will be freed with
    * a delete[] call.
    */
-  virtual bool Process(uint8_t* data, intptr_t length) = 0;
+  bool Process(uint8_t* data, intptr_t length) {
+    if (current_buffer_ != nullptr) {
+      return false;
+    }
+    current_buffer_ = data;
+    SetInput(data, length);
+    return true;
+  }
   virtual intptr_t Processed(uint8_t* buffer,
                              intptr_t length,
                              bool finish,
@@ -42,16 +53,69 @@ class Filter {
   intptr_t processed_buffer_size() const { return kFilterBufferSize; }
 
  protected:
-  Filter() : initialized_(false) {}
+  Filter() : current_buffer_(nullptr), initialized_(false) {}
+
+  // Makes the codec consume [data], which stays valid until the next call to
+  // ReleaseInput.
+  virtual void SetInput(uint8_t* data, intptr_t length) = 0;
+
+  // Frees the input once Processed has consumed all of it or failed.
+  void ReleaseInput() {
+    delete[] current_buffer_;
+    current_buffer_ = nullptr;
+  }
 
  private:
   static constexpr intptr_t kFilterBufferSize = 64 * KB;
   uint8_t processed_buffer_[kFilterBufferSize];
+  uint8_t* current_buffer_;
   bool initialized_;
 
   DISALLOW_COPY_AND_ASSIGN(Filter);
 };
 
+// Keeps the z_streams of finished filters, which own the large compression
+// windows, so that filters created with the same parameters can reset and
+// reuse them instead of allocating new ones. Streams are heap allocated
+// because zlib does not allow moving them once initialized.
+class ZLibStreamPool : public AllStatic {
+ public:
+  struct Key {
+    bool deflate;
+    int level;
+    int window_bits;
+    int mem_level;
+    int strategy;
+
+    bool Equals(const Key& other) const {
+      return (deflate == other.deflate) && (level == other.level) &&
+             (window_bits == other.window_bits) &&
+             (mem_level == other.mem_level) && (strategy == other.strategy);
+    }
+  };
+
+  static void Init();
+  static void Cleanup();
+
+  // Returns a stream initialized with the parameters of [key], which is reset
+  // if it was used before, or nullptr if no stream could be initialized.
+  static z_stream* Acquire(const Key& key);
+
+  // Resets [stream] for reuse, or ends and frees it if the pool is full.
+  static void Release(const Key& key, z_stream* stream);
+
+ private:
+  static constexpr intptr_t kMaxPooledStreams = 16;
+
+  static z_stream* New(const Key& key);
+  static void Delete(const Key& key, z_stream* stream);
+
+  static Mutex* mutex_;
+  static intptr_t num_pooled_;
+  static Key keys_[kMaxPooledStreams];
+  static z_stream* streams_[kMaxPooledStreams];
+};
+
 class ZLibDeflateFilter : public Filter {
  public:
   ZLibDeflateFilter(bool gzip,
@@ -70,16 +134,18 @@ class ZLibDeflateFilter : public Filter {
         dictionary_(dictionary),
         dictionary_length_(dictionary_length),
         raw_(raw),
-        current_buffer_(nullptr) {}
+        stream_(nullptr) {}
   virtual ~ZLibDeflateFilter();
 
   virtual bool Init();
-  virtual bool Process(uint8_t* data, intptr_t length);
   virtual intptr_t Processed(uint8_t* buffer,
                              intptr_t length,
                              bool finish,
                              bool end);
 
+ protected:
+  virtual void SetInput(uint8_t* data, intptr_t length);
+
  private:
   const bool gzip_;
   const int32_t level_;
@@ -89,8 +155,8 @@ class ZLibDeflateFilter : public Filter {
   uint8_t* dictionary_;
   const intptr_t dictionary_length_;
   const bool raw_;
-  uint8_t* current_buffer_;
-  z_stream stream_;
+  ZLibStreamPool::Key key_;
+  z_stream* stream_;
 
   DISALLOW_COPY_AND_ASSIGN(ZLibDeflateFilter);
 };
@@ -107,24 +173,26 @@ class ZLibInflateFilter : public Filter {
         dictionary_(dictionary),
         dictionary_length_(dictionary_length),
         raw_(raw),
-        current_buffer_(nullptr) {}
+        stream_(nullptr) {}
   virtual ~ZLibInflateFilter();
 
   virtual bool Init();
-  virtual bool Process(uint8_t* data, intptr_t length);
   virtual intptr_t Processed(uint8_t* buffer,
                              intptr_t length,
                              bool finish,
                              bool end);
 
+ protected:
+  virtual void SetInput(uint8_t* data, intptr_t length);
+
  private:
   const bool gzip_;
   const int32_t window_bits_;
   uint8_t* dictionary_;
   const intptr_t dictionary_length_;
   const bool raw_;
-  uint8_t* current_buffer_;
-  z_stream stream_;
+  ZLibStreamPool::Key key_;
+  z_stream* stream_;
 
   DISALLOW_COPY_AND_ASSIGN(ZLibInflateFilter);
 };
@@ -22,6 +22,8 @@
 #include "bin/loader.h"
 #include "bin/options.h"
 #include "bin/platform.h"
+#include "bin/process.h"
+#include "bin/sha256.h"
 #include "bin/snapshot_utils.h"
 #include "bin/thread.h"
 #include "bin/utils.h"
@@ -110,7 +112,8 @@ static const char* const kSnapshotKindNames[] = {
   V(elf, elf_filename)                                                         \
   V(loading_unit_manifest, loading_unit_manifest_filename)                     \
   V(save_debugging_info, debugging_info_filename)                              \
-  V(save_obfuscation_map, obfuscation_map_filename)
+  V(save_obfuscation_map, obfuscation_map_filename)                           \
+  V(snapshot_cache_dir, snapshot_cache_dirname)
 
 #define BOOL_OPTIONS_LIST(V)                                                   \
   V(compile_all, compile_all)                                                  \
@@ -182,6 +185,13 @@ static void PrintUsage() {
 "using --save-obfuscation-map=<filename> option. See dartbug.com/30524       \n"
 "for implementation details and limitations of the obfuscation pass.         \n"
 "                                                                            \n"
+"AOT snapshots can be cached between builds with                             \n"
+"--snapshot-cache-dir=<directory>. When the kernel inputs, the options and   \n"
+"the gen_snapshot binary match those of an earlier build, the outputs of     \n"
+"that build are copied from the cache instead of compiling the program       \n"
+"again. Files named by VM flags other than --aot_profile are identified by   \n"
+"their paths only.                                                           \n"
+"                                                                            \n"
 "\n");
   if (verbose) {
     Syslog::PrintErr(
@@ -286,6 +296,21 @@ static int ParseArguments(int argc,
     return -1;
   }
 
+  if (snapshot_cache_dirname != nullptr) {
+    if ((snapshot_kind != kAppAOTAssembly) && (snapshot_kind != kAppAOTElf)) {
+      Syslog::PrintErr(
+          "--snapshot-cache-dir=<...> can only be used when building an AOT "
+          "application snapshot.\n\n");
+      return -1;
+    }
+    if (loading_unit_manifest_filename != nullptr) {
+      Syslog::PrintErr(
+          "--snapshot-cache-dir=<...> can not be combined with "
+          "--loading-unit-manifest=<...>.\n\n");
+      return -1;
+    }
+  }
+
   if (!IsSnapshottingForPrecompilation()) {
     if (obfuscate) {
       Syslog::PrintErr(
@@ -355,6 +380,193 @@ static void ReadFile(const char* filename, uint8_t** buffer, intptr_t* size) {
   }
 }
 
+// Cache of AOT snapshots keyed by everything that determines their contents:
+// the gen_snapshot binary itself, the command line options and the contents
+// of the kernel inputs. The key is their SHA-256 digest.
+//
+// Reusing the code of individual functions across builds is not possible
+// because the object pool, class ids and the results of the global type flow
+// analysis all depend on the whole program, so only complete outputs are
+// cached.
+class SnapshotCacheKey {
+ public:
+  SnapshotCacheKey() {}
+
+  void Add(const uint8_t* data, intptr_t length) {
+    // The length separates consecutive parts, so that "ab" + "c" and
+    // "a" + "bc" differ.
+    uint8_t length_bytes[8];
+    for (intptr_t i = 0; i < 8; i++) {
+      length_bytes[i] = static_cast<uint64_t>(length) >> (i * 8);
+    }
+    sha256_.Update(length_bytes, sizeof(length_bytes));
+    sha256_.Update(data, length);
+  }
+
+  void Add(const char* str) {
+    Add(reinterpret_cast<const uint8_t*>(str), strlen(str));
+  }
+
+  void AddFile(const char* filename) {
+    uint8_t* buffer = nullptr;
+    intptr_t size = 0;
+    ReadFile(filename, &buffer, &size);
+    Add(buffer, size);
+    free(buffer);
+  }
+
+  // Completes the key. Nothing can be added afterwards.
+  void Finish() {
+    uint8_t digest[Sha256::kDigestSize];
+    sha256_.Finish(digest);
+    for (intptr_t i = 0; i < Sha256::kDigestSize; i++) {
+      snprintf(&hex_digest_[i * 2], 3, "%02x", digest[i]);
+    }
+  }
+
+  // Returns a malloc'ed string naming the cache entry for [suffix].
+  char* EntryPath(const char* suffix) const {
+    ASSERT(hex_digest_[0] != '\0');
+    return Utils::SCreate("%s%s%s.%s", snapshot_cache_dirname,
+                          File::PathSeparator(), hex_digest_, suffix);
+  }
+
+ private:
+  Sha256 sha256_;
+  char hex_digest_[Sha256::kDigestSize * 2 + 1] = {};
+
+  DISALLOW_COPY_AND_ASSIGN(SnapshotCacheKey);
+};
+
+static bool IsOptionNamed(const char* option, const char* name) {
+  const char* value = OptionProcessor::ProcessOption(option, name);
+  return (value != nullptr) && (*value == '=');
+}
+
+static void ComputeSnapshotCacheKey(int argc,
+                                    char** argv,
+                                    const CommandLineOptions& inputs,
+                                    SnapshotCacheKey* key) {
+  char executable_path[PATH_MAX];
+  if (Platform::ResolveExecutablePathInto(executable_path, PATH_MAX) <= 0) {
+    PrintErrAndExit("Error: Unable to find the gen_snapshot executable\n");
+  }
+  key->AddFile(executable_path);
+
+  // Options naming output files only affect which outputs are produced, not
+  // their contents. Options naming input files are keyed by their contents.
+  const char* kOutputOptions[] = {
+      "--elf",
+      "--assembly",
+      "--save_debugging_info",
+      "--save_obfuscation_map",
+      "--snapshot_cache_dir",
+  };
+  const char* kInputOptions[] = {
+      "--load_vm_snapshot_data",
+      "--load_vm_snapshot_instructions",
+      "--load_isolate_snapshot_data",
+      "--load_isolate_snapshot_instructions",
+      "--aot_profile",
+  };
+  for (int i = 1; (i < argc) && OptionProcessor::IsValidShortFlag(argv[i]);
+       i++) {
+    const char* option = argv[i];
+    bool handled = false;
+    for (const char* name : kOutputOptions) {
+      if (IsOptionNamed(option, name)) {
+        key->Add(name);
+        handled = true;
+        break;
+      }
+    }
+    for (const char* name : kInputOptions) {
+      if (!handled && IsOptionNamed(option, name)) {
+        key->Add(name);
+        key->AddFile(option + strlen(name) + 1);
+        handled = true;
+      }
+    }
+    if (!handled) {
+      key->Add(option);
+    }
+  }
+
+  for (intptr_t i = 0; i < inputs.count(); i++) {
+    key->AddFile(inputs.GetArgument(i));
+  }
+  key->Finish();
+}
+
+struct SnapshotCacheEntry {
+  const char* filename;
+  const char* suffix;
+};
+
+static intptr_t GetSnapshotCacheEntries(SnapshotCacheEntry* entries) {
+  intptr_t count = 0;
+  entries[count++] = {
+      snapshot_kind == kAppAOTElf ? elf_filename : assembly_filename,
+      "snapshot"};
+  if (debugging_info_filename != nullptr) {
+    entries[count++] = {debugging_info_filename, "debug"};
+  }
+  if (obfuscation_map_filename != nullptr) {
+    entries[count++] = {obfuscation_map_filename, "obfuscation_map"};
+  }
+  return count;
+}
+
+static constexpr intptr_t kMaxSnapshotCacheEntries = 3;
+
+// Copies the outputs for [key] out of the cache. Returns false if any of them
+// is missing, in which case the snapshot has to be built.
+static bool TryCopyFromSnapshotCache(const SnapshotCacheKey& key) {
+  SnapshotCacheEntry entries[kMaxSnapshotCacheEntries];
+  const intptr_t count = GetSnapshotCacheEntries(entries);
+  for (intptr_t i = 0; i < count; i++) {
+    char* path = key.EntryPath(entries[i].suffix);
+    const bool exists = File::Exists(nullptr, path);
+    free(path);
+    if (!exists) {
+      return false;
+    }
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    char* path = key.EntryPath(entries[i].suffix);
+    const bool copied = File::Copy(nullptr, path, entries[i].filename);
+    free(path);
+    if (!copied) {
+      return false;
+    }
+  }
+  if (verbose) {
+    Syslog::PrintErr("Copied AOT snapshot from %s\n", snapshot_cache_dirname);
+  }
+  return true;
+}
+
+// Stores the outputs for [key] in the cache. Each entry is written to a
+// temporary file first and then renamed, so concurrent builds sharing the
+// cache never observe partially written entries.
+static void CopyToSnapshotCache(const SnapshotCacheKey& key) {
+  SnapshotCacheEntry entries[kMaxSnapshotCacheEntries];
+  const intptr_t count = GetSnapshotCacheEntries(entries);
+  for (intptr_t i = 0; i < count; i++) {
+    char* path = key.EntryPath(entries[i].suffix);
+    char* temp_path =
+        Utils::SCreate("%s.%" Pd, path, Process::CurrentProcessId());
+    if (!File::Copy(nullptr, entries[i].filename, temp_path) ||
+        !File::Rename(nullptr, temp_path, path)) {
+      Syslog::PrintErr("Warning: Unable to write snapshot cache entry %s\n",
+                       path);
+      File::Delete(nullptr, temp_path);
+    }
+    free(temp_path);
+    free(path);
+  }
+}
+
 static void MallocFinalizer(void* isolate_callback_data, void* peer) {
   free(peer);
 }
@@ -822,6 +1034,15 @@ int main(int argc, char** argv) {
     return kErrorExitCode;
   }
   Console::SaveConfig();
+
+  SnapshotCacheKey snapshot_cache_key;
+  if (snapshot_cache_dirname != nullptr) {
+    ComputeSnapshotCacheKey(argc, argv, inputs, &snapshot_cache_key);
+    if (TryCopyFromSnapshotCache(snapshot_cache_key)) {
+      return 0;
+    }
+  }
+
   Loader::InitOnce();
   DartUtils::SetOriginalWorkingDirectory();
   // Start event handler.
@@ -901,6 +1122,10 @@ int main(int argc, char** argv) {
     return result;
   }
 
+  if (snapshot_cache_dirname != nullptr) {
+    CopyToSnapshotCache(snapshot_cache_key);
+  }
+
   error = Dart_Cleanup();
   if (error != nullptr) {
     Syslog::PrintErr("VM cleanup failed: %s\n", error);
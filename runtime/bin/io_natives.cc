@@ -54,12 +54,14 @@ namespace bin {
   V(File_LengthFromPath, 2)                                                    \
   V(File_LinkTarget, 2)                                                        \
   V(File_Lock, 4)                                                              \
+  V(File_Map, 4)                                                               \
   V(File_Open, 3)                                                              \
   V(File_OpenStdio, 1)                                                         \
   V(File_Position, 1)                                                          \
   V(File_Read, 2)                                                              \
   V(File_ReadByte, 1)                                                          \
   V(File_ReadInto, 4)                                                          \
+  V(File_ReadIntoAt, 5)                                                        \
   V(File_Rename, 3)                                                            \
   V(File_RenameLink, 3)                                                        \
   V(File_ResolveSymbolicLinks, 2)                                              \
@@ -71,6 +73,7 @@ namespace bin {
   V(File_Truncate, 2)                                                          \
   V(File_WriteByte, 2)                                                         \
   V(File_WriteFrom, 4)                                                         \
+  V(File_WriteFromAt, 5)                                                       \
   V(FileSystemWatcher_CloseWatcher, 1)                                         \
   V(FileSystemWatcher_GetSocketId, 2)                                          \
   V(FileSystemWatcher_InitWatcher, 0)                                          \
@@ -89,7 +92,7 @@ namespace bin {
   V(InternetAddress_Parse, 1)                                                  \
   V(InternetAddress_ParseScopedLinkLocalAddress, 1)                            \
   V(InternetAddress_RawAddrToString, 1)                                        \
-  V(IOService_NewServicePort, 0)                                               \
+  V(IOService_NewServicePort, 1)                                               \
   V(Namespace_Create, 2)                                                       \
   V(Namespace_GetDefault, 0)                                                   \
   V(Namespace_GetPointer, 1)                                                   \
@@ -127,6 +130,7 @@ namespace bin {
   V(SecureSocket_NewX509CertificateWrapper, 1)                                 \
   V(SecureSocket_Init, 1)                                                      \
   V(SecureSocket_PeerCertificate, 1)                                           \
+  V(SecureSocket_ProcessAllBuffers, 2)                                         \
   V(SecureSocket_RegisterBadCertificateCallback, 2)                            \
   V(SecureSocket_RegisterKeyLogPort, 2)                                        \
   V(SecureSocket_RegisterHandshakeCompleteCallback, 2)                         \
@@ -166,12 +170,14 @@ namespace bin {
   V(Socket_Read, 2)                                                            \
   V(Socket_RecvFrom, 1)                                                        \
   V(Socket_ReceiveMessage, 2)                                                  \
+  V(Socket_SendFile, 4)                                                        \
   V(Socket_SendMessage, 5)                                                     \
   V(Socket_SendTo, 6)                                                          \
   V(Socket_SetOption, 4)                                                       \
   V(Socket_SetRawOption, 4)                                                    \
   V(Socket_SetSocketId, 3)                                                     \
   V(Socket_WriteList, 4)                                                       \
+  V(Socket_WriteVector, 3)                                                     \
   V(Socket_HasPendingWrite, 1)                                                 \
   V(SocketControlMessage_fromHandles, 2)                                       \
   V(SocketControlMessageImpl_extractHandles, 1)                                \
@@ -54,15 +54,29 @@ void IOServiceCallback(Dart_Port dest_port_id, Dart_CObject* message) {
   Dart_PostCObject(reply_port_id, result.AsApiCObject());
 }
 
-intptr_t IOService::max_concurrency_ = 32;
+intptr_t IOService::max_concurrency_[kIOServiceNumLanes] = {32, 32, 32, 32};
 
-Dart_Port IOService::GetServicePort() {
-  return Dart_NewConcurrentNativePort("IOService", IOServiceCallback,
-                                      max_concurrency_);
+void IOService::set_max_concurrency(intptr_t value) {
+  for (intptr_t i = 0; i < kIOServiceNumLanes; i++) {
+    max_concurrency_[i] = value;
+  }
+}
+
+Dart_Port IOService::GetServicePort(IOServiceLane lane) {
+  static const char* kLaneNames[kIOServiceNumLanes] = {
+      "IOService File", "IOService Lookup", "IOService SecureSocket",
+      "IOService File Data"};
+  return Dart_NewConcurrentNativePort(kLaneNames[lane], IOServiceCallback,
+                                      max_concurrency_[lane]);
 }
 
 void FUNCTION_NAME(IOService_NewServicePort)(Dart_NativeArguments args) {
-  Dart_Port service_port = IOService::GetServicePort();
+  const intptr_t lane = DartUtils::GetNativeIntptrArgument(args, 0);
+  if ((lane < 0) || (lane >= kIOServiceNumLanes)) {
+    Dart_PropagateError(DartUtils::NewError("Invalid IOService lane"));
+  }
+  Dart_Port service_port =
+      IOService::GetServicePort(static_cast<IOServiceLane>(lane));
   if (service_port != ILLEGAL_PORT) {
     // Return a send port for the service port.
     Dart_Handle send_port = Dart_NewSendPort(service_port);
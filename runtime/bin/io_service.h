@@ -11,6 +11,7 @@
 
 #include "bin/builtin.h"
 #include "bin/utils.h"
+#include "include/bin/dart_io_api.h"
 
 namespace dart {
 namespace bin {
@@ -60,7 +61,9 @@ namespace bin {
   V(Directory, ListNext, 40)                                                   \
   V(Directory, ListStop, 41)                                                   \
   V(Directory, Rename, 42)                                                     \
-  V(SSLFilter, ProcessFilter, 43)
+  V(SSLFilter, ProcessFilter, 43)                                              \
+  V(File, ReadIntoAt, 44)                                                      \
+  V(File, WriteFromAt, 45)
 
 #define DECLARE_REQUEST(type, method, id) k##type##method##Request = id,
 
@@ -68,13 +71,19 @@ class IOService {
  public:
   enum { IO_SERVICE_REQUEST_LIST(DECLARE_REQUEST) };
 
-  static Dart_Port GetServicePort();
+  static Dart_Port GetServicePort(IOServiceLane lane);
 
-  static intptr_t max_concurrency() { return max_concurrency_; }
-  static void set_max_concurrency(intptr_t value) { max_concurrency_ = value; }
+  static intptr_t max_concurrency(IOServiceLane lane) {
+    return max_concurrency_[lane];
+  }
+  static void set_max_concurrency(IOServiceLane lane, intptr_t value) {
+    max_concurrency_[lane] = value;
+  }
+  // Sets the concurrency of all lanes.
+  static void set_max_concurrency(intptr_t value);
 
  private:
-  static intptr_t max_concurrency_;
+  static intptr_t max_concurrency_[kIOServiceNumLanes];
 
   DISALLOW_ALLOCATION();
   DISALLOW_IMPLICIT_CONSTRUCTORS(IOService);
@@ -66,6 +66,9 @@ const uint8_t* core_isolate_snapshot_instructions =
  *   dart <app_snapshot_filename> [<script_options>]
  */
 static bool vm_run_app_snapshot = false;
+// Whether the app snapshot is mapped from its file by the embedder, in which
+// case the VM may drop its pages after deserialization even on Linux.
+static bool vm_app_snapshot_is_file_backed = false;
 static char* app_script_uri = nullptr;
 static const uint8_t* app_isolate_snapshot_data = nullptr;
 static const uint8_t* app_isolate_snapshot_instructions = nullptr;
@@ -311,7 +314,7 @@ static Dart_Isolate IsolateSetupHelper(Dart_Isolate isolate,
     dfe.CompileAndReadScript(script_uri, &application_kernel_buffer,
                              &application_kernel_buffer_size, error, exit_code,
                              resolved_packages_config, for_snapshot,
-                             embed_sources);
+                             embed_sources, /*use_kernel_cache=*/true);
     if (application_kernel_buffer == nullptr) {
       Dart_ExitScope();
       Dart_ShutdownIsolate();
@@ -1000,7 +1003,8 @@ void RunMainIsolate(const char* script_name,
 #if defined(DART_HOST_OS_LINUX)
   // This would also be true in Linux, except that Google3 overrides the default
   // ELF interpreter to one that apparently doesn't create proper mappings.
-  dontneed_safe = false;
+  // Snapshots we mapped from the file ourselves are not affected by that.
+  dontneed_safe = vm_app_snapshot_is_file_backed;
 #elif defined(DEBUG)
   // If the snapshot isn't file-backed, madvise(DONT_NEED) is destructive.
   if (Options::force_load_elf_from_memory()) {
@@ -1286,6 +1290,7 @@ void main(int argc, char** argv) {
         Platform::Exit(kErrorExitCode);
       }
       vm_run_app_snapshot = true;
+      vm_app_snapshot_is_file_backed = app_snapshot->IsFileBacked();
       app_snapshot->SetBuffers(&vm_snapshot_data, &vm_snapshot_instructions,
                                &app_isolate_snapshot_data,
                                &app_isolate_snapshot_instructions);
@@ -1348,6 +1353,10 @@ void main(int argc, char** argv) {
   // Load vm_platform_strong.dill for dart:* source support.
   dfe.Init();
   dfe.set_verbosity(Options::verbosity_level());
+  // A kernel read from the cache does not tell its dependencies.
+  if (Options::kernel_cache_dir() != nullptr && Options::depfile() == nullptr) {
+    dfe.set_kernel_cache(Options::kernel_cache_dir(), vm_options);
+  }
   if (script_name != nullptr) {
     uint8_t* application_kernel_buffer = nullptr;
     intptr_t application_kernel_buffer_size = 0;
@@ -1451,6 +1460,23 @@ void main(int argc, char** argv) {
   // Terminate process exit-code handler.
   Process::TerminateExitCodeHandler();
 
+  if (Options::fast_exit()) {
+    // The main isolate has shut down, which ran its finalizers and flushed its
+    // output. Shutting down the remaining isolates and the VM would mostly free
+    // memory the OS reclaims anyway, so only write out what the VM would on
+    // shutdown.
+    error = Dart_PrepareToExit();
+    if (error != nullptr) {
+      Syslog::PrintErr("VM cleanup failed: %s\n", error);
+      free(error);
+    }
+    fflush(stdout);
+    fflush(stderr);
+    // Other VM threads may still be running, so skip global destructors as in
+    // Process_Exit.
+    Platform::_Exit(Process::GlobalExitCode());
+  }
+
   error = Dart_Cleanup();
   if (error != nullptr) {
     Syslog::PrintErr("VM cleanup failed: %s\n", error);
@@ -220,6 +220,20 @@ void Options::PrintUsage() {
 "--trace-loading\n"
 "  enables tracing of library and script loading\n"
 "\n"
+"--dns-cache-millis=<milliseconds>\n"
+"  Reuses the results of successful host name lookups for the specified\n"
+"  time instead of resolving the host again on every connection.\n"
+"\n"
+"--kernel-cache=<path>\n"
+"  Caches the kernel compiled from the Dart sources of the script in the\n"
+"  specified directory and reuses it on later runs as long as none of the\n"
+"  sources changed.\n"
+"\n"
+"--fast-exit\n"
+"  Once the main isolate has finished, exits the process without shutting\n"
+"  down the remaining isolates and freeing their memory. Only the output the\n"
+"  VM writes on shutdown, such as a recorded timeline, is flushed first.\n"
+"\n"
 #if !defined(PRODUCT)
 "--enable-vm-service[=<port>[/<bind-address>]]\n"
 "  Enables the VM service and listens on specified port for connections\n"
@@ -599,6 +613,10 @@ bool Options::ParseArguments(int argc,
 
   Socket::set_short_socket_read(Options::short_socket_read());
   Socket::set_short_socket_write(Options::short_socket_write());
+  if (Options::dns_cache_millis() != nullptr) {
+    Socket::set_lookup_cache_millis(
+        Utils::Maximum<int64_t>(0, atoll(Options::dns_cache_millis())));
+  }
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLCertContext::set_root_certs_file(Options::root_certs_file());
   SSLCertContext::set_root_certs_cache(Options::root_certs_cache());
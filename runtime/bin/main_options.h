@@ -26,6 +26,8 @@ namespace bin {
   V(root_certs_file, root_certs_file)                                          \
   V(root_certs_cache, root_certs_cache)                                        \
   V(namespace, namespc)                                                        \
+  V(dns_cache_millis, dns_cache_millis)                                        \
+  V(kernel_cache, kernel_cache_dir)                                            \
   V(write_service_info, vm_write_service_info_filename)                        \
   /* The purpose of these flags is documented in */                            \
   /* pkg/dartdev/lib/src/commands/compilation_server.dart. */                  \
@@ -58,6 +60,7 @@ namespace bin {
   V(no_serve_observatory, disable_observatory)                                 \
   V(serve_observatory, enable_observatory)                                     \
   V(print_dtd, print_dtd)                                                      \
+  V(fast_exit, fast_exit)                                                      \
   /* The purpose of this flag is documented in */                              \
   /* pkg/dartdev/lib/src/commands/run.dart. */                                 \
   V(resident, resident)
@@ -10,6 +10,7 @@
 #include <errno.h>         // NOLINT
 #include <fcntl.h>         // NOLINT
 #include <poll.h>          // NOLINT
+#include <spawn.h>         // NOLINT
 #include <stdio.h>         // NOLINT
 #include <stdlib.h>        // NOLINT
 #include <string.h>        // NOLINT
@@ -73,6 +74,15 @@ class ProcessInfoList {
 
   static void AddProcess(pid_t pid, intptr_t fd) {
     MutexLocker locker(mutex_);
+    AddProcessLocked(pid, fd);
+  }
+
+  // Processes that are started without waiting for them to be added must be
+  // added while holding the mutex. Otherwise their exit could be missed by
+  // the exit code handler.
+  static Mutex* mutex() { return mutex_; }
+
+  static void AddProcessLocked(pid_t pid, intptr_t fd) {
     ProcessInfo* info = new ProcessInfo(pid, fd);
     info->set_next(active_processes_);
     active_processes_ = info;
@@ -282,6 +292,25 @@ static bool PathInNamespace(char* realpath,
   return true;
 }
 
+// The size of the pipes connected to the stdio of started processes, or 0
+// for the default size. Set with DART_PROCESS_PIPE_SIZE.
+static int process_pipe_size = 0;
+
+// Large pipes let processes that produce output quickly run ahead of the
+// reads, and allow reading more of their output per event.
+static void ResizePipe(int fd) {
+  // Pipes of unprivileged users are limited to /proc/sys/fs/pipe-max-size,
+  // and to 2 pages once their pipes exceed /proc/sys/fs/pipe-user-pages-soft,
+  // so smaller sizes are tried until one is accepted.
+  const int kDefaultPipeSize = 64 * KB;
+  for (int size = process_pipe_size; size > kDefaultPipeSize; size /= 2) {
+    if (NO_RETRY_EXPECTED(fcntl(fd, F_SETPIPE_SZ, size)) >= 0 ||
+        errno != EPERM) {
+      return;
+    }
+  }
+}
+
 class ProcessStarter {
  public:
   ProcessStarter(Namespace* namespc,
@@ -343,6 +372,158 @@ class ProcessStarter {
       return err;
     }
 
+    pid_t pid;
+    if (CanSpawnProcess()) {
+      err = SpawnProcess(&pid);
+      if (err == ENOEXEC) {
+        // Unlike execvp, posix_spawn does not run executables without a #!
+        // line with /bin/sh.
+        err = ForkProcess(&pid);
+      }
+    } else {
+      err = ForkProcess(&pid);
+    }
+    if (err != 0) {
+      return err;
+    }
+
+    if (Process::ModeHasStdio(mode_)) {
+      // Connect stdio, stdout and stderr.
+      FDUtils::SetNonBlocking(read_in_[0]);
+      *in_ = read_in_[0];
+      close(read_in_[1]);
+      FDUtils::SetNonBlocking(write_out_[1]);
+      *out_ = write_out_[1];
+      close(write_out_[0]);
+      FDUtils::SetNonBlocking(read_err_[0]);
+      *err_ = read_err_[0];
+      close(read_err_[1]);
+    } else {
+      // Close all fds.
+      close(read_in_[0]);
+      close(read_in_[1]);
+      ASSERT(write_out_[0] == -1);
+      ASSERT(write_out_[1] == -1);
+      ASSERT(read_err_[0] == -1);
+      ASSERT(read_err_[1] == -1);
+    }
+    ASSERT(exec_control_[0] == -1);
+    ASSERT(exec_control_[1] == -1);
+
+    *id_ = pid;
+    return 0;
+  }
+
+ private:
+  static constexpr int kErrorBufferSize = 1024;
+
+  // Forking copies the page tables of this process, which takes tens of
+  // milliseconds for large heaps. posix_spawn starts the child in the address
+  // space of this process instead, but it cannot do everything the child
+  // does after a fork.
+  bool CanSpawnProcess() {
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 29)
+    // Detached processes need their own sessions, and other namespaces
+    // resolve paths in the child.
+    if (!Process::ModeIsAttached(mode_) || !Namespace::IsDefault(namespc_)) {
+      return false;
+    }
+    // The executable is searched for in the PATH of this process rather than
+    // in the one of the new environment.
+    if (program_environment_ != nullptr && strchr(path_, '/') == nullptr) {
+      const char* path = getenv("PATH");
+      const char* new_path = nullptr;
+      for (char** env = program_environment_; *env != nullptr; env++) {
+        if (strncmp(*env, "PATH=", 5) == 0) {
+          new_path = *env + 5;
+        }
+      }
+      if (path == nullptr || new_path == nullptr) {
+        return path == new_path;
+      }
+      return strcmp(path, new_path) == 0;
+    }
+    return true;
+#else
+    // posix_spawn only supports working directories since glibc 2.29.
+    return false;
+#endif
+  }
+
+#if defined(__GLIBC__) && __GLIBC_PREREQ(2, 29)
+  // Returns ENOEXEC, leaving the pipes open, if the executable has to be
+  // started with ForkProcess instead.
+  int SpawnProcess(pid_t* pid) {
+    posix_spawn_file_actions_t actions;
+    int result = posix_spawn_file_actions_init(&actions);
+    if (result != 0) {
+      errno = result;
+      return CleanupAndReturnError();
+    }
+    if (mode_ == kNormal) {
+      result = posix_spawn_file_actions_adddup2(&actions, write_out_[0],
+                                                STDIN_FILENO);
+      if (result == 0) {
+        result = posix_spawn_file_actions_adddup2(&actions, read_in_[1],
+                                                  STDOUT_FILENO);
+      }
+      if (result == 0) {
+        result = posix_spawn_file_actions_adddup2(&actions, read_err_[1],
+                                                  STDERR_FILENO);
+      }
+    } else {
+      ASSERT(mode_ == kInheritStdio);
+    }
+    if (result == 0 && working_directory_ != nullptr) {
+      result =
+          posix_spawn_file_actions_addchdir_np(&actions, working_directory_);
+    }
+    int event_fds[2] = {-1, -1};
+    if (result == 0 && TEMP_FAILURE_RETRY(pipe2(event_fds, O_CLOEXEC)) < 0) {
+      result = errno;
+    }
+    if (result == 0) {
+      char* const* argv = const_cast<char* const*>(program_arguments_);
+      char* const* envp =
+          program_environment_ != nullptr ? program_environment_ : environ;
+      MutexLocker locker(ProcessInfoList::mutex());
+      if (strchr(path_, '/') == nullptr) {
+        result = posix_spawnp(pid, path_, &actions, nullptr, argv, envp);
+      } else {
+        result = posix_spawn(pid, path_, &actions, nullptr, argv, envp);
+      }
+      if (result == 0) {
+        // The exit code handler cannot count the exit of the process before
+        // its start while the mutex is held.
+        ExitCodeHandler::ProcessStarted();
+        ProcessInfoList::AddProcessLocked(*pid, event_fds[1]);
+      }
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    if (result == ENOEXEC) {
+      ClosePipe(event_fds);
+      return ENOEXEC;
+    }
+    if (result != 0) {
+      ClosePipe(event_fds);
+      errno = result;
+      return CleanupAndReturnError();
+    }
+    // The exec result is returned by posix_spawn.
+    ClosePipe(exec_control_);
+
+    *exit_event_ = event_fds[0];
+    FDUtils::SetNonBlocking(event_fds[0]);
+    return 0;
+  }
+#else
+  int SpawnProcess(pid_t* pid) {
+    UNREACHABLE();
+    return 0;
+  }
+#endif
+
+  int ForkProcess(pid_t* pid_result) {
     // Fork to create the new process.
     pid_t pid = TEMP_FAILURE_RETRY(fork());
     if (pid < 0) {
@@ -358,6 +539,7 @@ class ProcessStarter {
     // If the child process is not started in detached mode, be sure to
     // listen for exit-codes, now that we have a non detached child process
     // and also Register this child process.
+    int err;
     if (Process::ModeIsAttached(mode_)) {
       ExitCodeHandler::ProcessStarted();
       err = RegisterProcess(pid);
@@ -402,36 +584,10 @@ class ProcessStarter {
       return err;
     }
 
-    if (Process::ModeHasStdio(mode_)) {
-      // Connect stdio, stdout and stderr.
-      FDUtils::SetNonBlocking(read_in_[0]);
-      *in_ = read_in_[0];
-      close(read_in_[1]);
-      FDUtils::SetNonBlocking(write_out_[1]);
-      *out_ = write_out_[1];
-      close(write_out_[0]);
-      FDUtils::SetNonBlocking(read_err_[0]);
-      *err_ = read_err_[0];
-      close(read_err_[1]);
-    } else {
-      // Close all fds.
-      close(read_in_[0]);
-      close(read_in_[1]);
-      ASSERT(write_out_[0] == -1);
-      ASSERT(write_out_[1] == -1);
-      ASSERT(read_err_[0] == -1);
-      ASSERT(read_err_[1] == -1);
-    }
-    ASSERT(exec_control_[0] == -1);
-    ASSERT(exec_control_[1] == -1);
-
-    *id_ = pid;
+    *pid_result = pid;
     return 0;
   }
 
- private:
-  static constexpr int kErrorBufferSize = 1024;
-
   int CreatePipes() {
     int result;
     result = TEMP_FAILURE_RETRY(pipe2(exec_control_, O_CLOEXEC));
@@ -457,6 +613,12 @@ class ProcessStarter {
       if (result < 0) {
         return CleanupAndReturnError();
       }
+
+      if (process_pipe_size > 0) {
+        ResizePipe(read_in_[0]);
+        ResizePipe(read_err_[0]);
+        ResizePipe(write_out_[1]);
+      }
     }
 
     return 0;
@@ -1175,6 +1337,14 @@ void Process::Init() {
 
   ASSERT(Process::global_exit_code_mutex_ == nullptr);
   Process::global_exit_code_mutex_ = new Mutex();
+
+  const char* pipe_size = getenv("DART_PROCESS_PIPE_SIZE");
+  if (pipe_size != nullptr) {
+    const intptr_t kMaxPipeSize = 256 * MB;
+    const intptr_t value = strtol(pipe_size, nullptr, 10);
+    process_pipe_size =
+        (value < 0) ? 0 : ((value > kMaxPipeSize) ? kMaxPipeSize : value);
+  }
 }
 
 void Process::Cleanup() {
@@ -73,9 +73,9 @@ void TestCaseBase::RunTest() {
 void Benchmark::RunBenchmark() {
   if ((run_filter == kAllBenchmarks) ||
       (strcmp(run_filter, this->name()) == 0)) {
-    this->Run();
+    const int64_t score = this->RunRepeated();
     Syslog::Print("%s(%s): %" Pd64 "\n", this->name(), this->score_kind(),
-                  this->score());
+                  score);
     run_matches++;
   } else if (run_filter == kList) {
     Syslog::Print("%s Pass\n", this->name());
@@ -87,7 +87,8 @@ static void PrintUsage() {
   Syslog::PrintErr(
       "Usage: one of the following\n"
       "  run_vm_tests --list\n"
-      "  run_vm_tests [--dfe=<snapshot file name>] --benchmarks\n"
+      "  run_vm_tests [--dfe=<snapshot file name>] [vm-flags ...] "
+      "--benchmarks\n"
       "  run_vm_tests [--dfe=<snapshot file name>] [vm-flags ...] <test name>\n"
       "  run_vm_tests [--dfe=<snapshot file name>] [vm-flags ...] <benchmark "
       "name>\n");
@@ -362,9 +363,11 @@ static int Main(int argc, const char** argv) {
     ShiftArgs(&argc, argv);
   }
 
-  if (arg_pos == argc - 1 && strcmp(argv[arg_pos], "--benchmarks") == 0) {
-    // "--benchmarks" is the last argument.
+  if (strcmp(argv[argc - 1], "--benchmarks") == 0) {
+    // "--benchmarks" is the last argument, the rest are vm flags.
     run_filter = kAllBenchmarks;
+    dart_argc = argc - 2;
+    dart_argv = &argv[1];
   } else {
     // Last argument is the test name, the rest are vm flags.
     run_filter = argv[argc - 1];
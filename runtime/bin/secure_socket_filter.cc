@@ -38,12 +38,16 @@ int SSLFilter::ssl_cert_context_index;
 void SSLFilter::Init() {
   ASSERT(SSLFilter::mutex_ == nullptr);
   SSLFilter::mutex_ = new Mutex();
+  SessionTicketKeys::Init();
+  SharedRootCerts::Init();
 }
 
 void SSLFilter::Cleanup() {
   ASSERT(SSLFilter::mutex_ != nullptr);
   delete SSLFilter::mutex_;
   SSLFilter::mutex_ = nullptr;
+  SessionTicketKeys::Cleanup();
+  SharedRootCerts::Cleanup();
 }
 
 const intptr_t SSLFilter::kInternalBIOSize = 10 * KB;
@@ -219,6 +223,42 @@ void FUNCTION_NAME(SecureSocket_FilterPointer)(Dart_NativeArguments args) {
   Dart_SetReturnValue(args, Dart_NewInteger(filter_pointer));
 }
 
+// Synchronous variant of ProcessFilterRequest, which runs on the isolate's
+// thread. The only argument is a list of the start and end positions of the
+// four buffers.
+void FUNCTION_NAME(SecureSocket_ProcessAllBuffers)(Dart_NativeArguments args) {
+  SSLFilter* filter = GetFilter(args);
+  Dart_Handle positions = ThrowIfError(Dart_GetNativeArgument(args, 1));
+  ASSERT(Dart_IsList(positions));
+  int starts[SSLFilter::kNumBuffers];
+  int ends[SSLFilter::kNumBuffers];
+  for (int i = 0; i < SSLFilter::kNumBuffers; ++i) {
+    starts[i] = DartUtils::GetIntegerValue(
+        ThrowIfError(Dart_ListGetAt(positions, 2 * i)));
+    ends[i] = DartUtils::GetIntegerValue(
+        ThrowIfError(Dart_ListGetAt(positions, 2 * i + 1)));
+  }
+
+  Dart_Handle result;
+  if (filter->ProcessAllBuffers(starts, ends, /*in_handshake=*/false)) {
+    result = ThrowIfError(Dart_NewList(SSLFilter::kNumBuffers * 2));
+    for (int i = 0; i < SSLFilter::kNumBuffers; ++i) {
+      ThrowIfError(Dart_ListSetAt(result, 2 * i, Dart_NewInteger(starts[i])));
+      ThrowIfError(
+          Dart_ListSetAt(result, 2 * i + 1, Dart_NewInteger(ends[i])));
+    }
+  } else {
+    int32_t error_code = static_cast<int32_t>(ERR_peek_error());
+    TextBuffer error_string(SecureSocketUtils::SSL_ERROR_MESSAGE_BUFFER_SIZE);
+    SecureSocketUtils::FetchErrorString(filter->ssl(), &error_string);
+    result = ThrowIfError(Dart_NewList(2));
+    ThrowIfError(Dart_ListSetAt(result, 0, Dart_NewInteger(error_code)));
+    ThrowIfError(Dart_ListSetAt(
+        result, 1, DartUtils::NewString(error_string.buffer())));
+  }
+  Dart_SetReturnValue(args, result);
+}
+
 /**
  * Pushes data through the SSL filter, reading and writing from circular
  * buffers shared with Dart.
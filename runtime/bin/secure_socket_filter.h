@@ -70,6 +70,7 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   ~SSLFilter();
 
   char* hostname() const { return hostname_; }
+  SSL* ssl() const { return ssl_; }
   bool is_server() const { return is_server_; }
   bool is_client() const { return !is_server_; }
 
@@ -8,7 +8,10 @@
 
 #include <openssl/bio.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
 #include <openssl/pkcs12.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 
@@ -18,6 +21,7 @@
 #include "bin/file.h"
 #include "bin/secure_socket_filter.h"
 #include "bin/secure_socket_utils.h"
+#include "bin/utils.h"
 #include "platform/syslog.h"
 
 // Return the error from the containing function if handle is an error handle.
@@ -326,9 +330,12 @@ void SSLCertContext::LoadRootCertFile(const char* file) {
     SecureSocketUtils::ThrowIOException(
         -1, "TlsException", "Failed to find root cert file", nullptr);
   }
-  int status = SSL_CTX_load_verify_locations(context(), file, nullptr);
-  SecureSocketUtils::CheckStatus(status, "TlsException",
-                                 "Failure trusting builtin roots");
+  if (!SharedRootCerts::AddFileToStore(SSL_CTX_get_cert_store(context()),
+                                       file)) {
+    int status = SSL_CTX_load_verify_locations(context(), file, nullptr);
+    SecureSocketUtils::CheckStatus(status, "TlsException",
+                                   "Failure trusting builtin roots");
+  }
   if (SSL_LOG_STATUS) {
     Syslog::Print("Trusting roots from: %s\n", file);
   }
@@ -342,6 +349,9 @@ void SSLCertContext::AddCompiledInCerts() {
     return;
   }
   X509_STORE* store = SSL_CTX_get_cert_store(context());
+  if (SharedRootCerts::AddCompiledInToStore(store)) {
+    return;
+  }
   BIO* roots_bio =
       BIO_new_mem_buf(const_cast<unsigned char*>(root_certificates_pem),
                       root_certificates_pem_length);
@@ -822,6 +832,239 @@ void FUNCTION_NAME(SecurityContext_UsePrivateKeyBytes)(
                                  "Failure in usePrivateKeyBytes");
 }
 
+Mutex* SessionTicketKeys::mutex_ = nullptr;
+int64_t SessionTicketKeys::rotation_interval_millis_ = 0;
+int64_t SessionTicketKeys::next_rotation_millis_ = 0;
+bool SessionTicketKeys::has_previous_key_ = false;
+SessionTicketKeys::Key SessionTicketKeys::current_key_;
+SessionTicketKeys::Key SessionTicketKeys::previous_key_;
+
+void SessionTicketKeys::Init() {
+  ASSERT(mutex_ == nullptr);
+  mutex_ = new Mutex();
+  const char* interval = getenv("DART_TLS_SHARED_SESSION_TICKETS");
+  if (interval != nullptr) {
+    const int64_t seconds = strtoll(interval, nullptr, 10);
+    rotation_interval_millis_ = (seconds > 0) ? seconds * kMillisecondsPerSecond
+                                              : 0;
+  }
+}
+
+void SessionTicketKeys::Cleanup() {
+  ASSERT(mutex_ != nullptr);
+  delete mutex_;
+  mutex_ = nullptr;
+}
+
+void SessionTicketKeys::Attach(SSL_CTX* context) {
+  if (rotation_interval_millis_ == 0) {
+    return;
+  }
+  // Sessions are only resumed by contexts with the same id context, which
+  // otherwise differs per SSL_CTX.
+  static const uint8_t kSessionIdContext[] = "dart:io";
+  SSL_CTX_set_session_id_context(context, kSessionIdContext,
+                                 sizeof(kSessionIdContext) - 1);
+  SSL_CTX_set_tlsext_ticket_key_cb(context, TicketKeyCallback);
+}
+
+bool SessionTicketKeys::GenerateKey(Key* key) {
+  return RAND_bytes(reinterpret_cast<uint8_t*>(key), sizeof(*key)) == 1;
+}
+
+void SessionTicketKeys::RotateLocked(int64_t now) {
+  if (next_rotation_millis_ == 0) {
+    if (!GenerateKey(&current_key_)) {
+      return;
+    }
+  } else {
+    Key key;
+    if (!GenerateKey(&key)) {
+      return;
+    }
+    previous_key_ = current_key_;
+    current_key_ = key;
+    has_previous_key_ = true;
+  }
+  next_rotation_millis_ = now + rotation_interval_millis_;
+}
+
+int SessionTicketKeys::TicketKeyCallback(SSL* ssl,
+                                         uint8_t* key_name,
+                                         uint8_t* iv,
+                                         EVP_CIPHER_CTX* cipher_ctx,
+                                         HMAC_CTX* hmac_ctx,
+                                         int encrypt) {
+  Key key;
+  bool renew = false;
+  {
+    MutexLocker locker(mutex_);
+    const int64_t now = TimerUtils::GetCurrentMonotonicMillis();
+    if (now >= next_rotation_millis_) {
+      RotateLocked(now);
+    }
+    if (next_rotation_millis_ == 0) {
+      // No key could be generated.
+      return encrypt ? -1 : 0;
+    }
+    if (encrypt) {
+      key = current_key_;
+    } else if (memcmp(key_name, current_key_.name, sizeof(key.name)) == 0) {
+      key = current_key_;
+    } else if (has_previous_key_ &&
+               memcmp(key_name, previous_key_.name, sizeof(key.name)) == 0) {
+      key = previous_key_;
+      renew = true;
+    } else {
+      // Fall back to a full handshake.
+      return 0;
+    }
+  }
+  if (encrypt) {
+    if (RAND_bytes(iv, EVP_MAX_IV_LENGTH) != 1) {
+      return -1;
+    }
+    memmove(key_name, key.name, sizeof(key.name));
+    if (EVP_EncryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), nullptr, key.aes_key,
+                           iv) != 1) {
+      return -1;
+    }
+  } else if (EVP_DecryptInit_ex(cipher_ctx, EVP_aes_128_cbc(), nullptr,
+                                key.aes_key, iv) != 1) {
+    return -1;
+  }
+  if (HMAC_Init_ex(hmac_ctx, key.hmac_key, sizeof(key.hmac_key), EVP_sha256(),
+                   nullptr) != 1) {
+    return -1;
+  }
+  // Tickets encrypted with the previous key are replaced by new ones.
+  return renew ? 2 : 1;
+}
+
+Mutex* SharedRootCerts::mutex_ = nullptr;
+SharedRootCerts::Bundle* SharedRootCerts::bundles_ = nullptr;
+STACK_OF(X509)* SharedRootCerts::compiled_in_certs_ = nullptr;
+
+void SharedRootCerts::Init() {
+  ASSERT(mutex_ == nullptr);
+  mutex_ = new Mutex();
+}
+
+void SharedRootCerts::Cleanup() {
+  ASSERT(mutex_ != nullptr);
+  while (bundles_ != nullptr) {
+    Bundle* next = bundles_->next;
+    free(bundles_->file);
+    sk_X509_pop_free(bundles_->certs, X509_free);
+    delete bundles_;
+    bundles_ = next;
+  }
+  sk_X509_pop_free(compiled_in_certs_, X509_free);
+  compiled_in_certs_ = nullptr;
+  delete mutex_;
+  mutex_ = nullptr;
+}
+
+STACK_OF(X509)* SharedRootCerts::ReadCertificates(BIO* bio) {
+  STACK_OF(X509_INFO)* infos =
+      PEM_X509_INFO_read_bio(bio, nullptr, nullptr, nullptr);
+  ERR_clear_error();
+  if (infos == nullptr) {
+    return nullptr;
+  }
+  STACK_OF(X509)* certs = sk_X509_new_null();
+  bool success = certs != nullptr;
+  for (size_t i = 0; success && i < sk_X509_INFO_num(infos); i++) {
+    X509_INFO* info = sk_X509_INFO_value(infos, i);
+    if (info->crl != nullptr) {
+      // Only X509_STORE_load_locations loads CRLs along with certificates.
+      success = false;
+    } else if (info->x509 != nullptr) {
+      success = sk_X509_push(certs, info->x509) != 0;
+      if (success) {
+        info->x509 = nullptr;  // Now owned by [certs].
+      }
+    }
+  }
+  sk_X509_INFO_pop_free(infos, X509_INFO_free);
+  if (!success || sk_X509_num(certs) == 0) {
+    sk_X509_pop_free(certs, X509_free);
+    return nullptr;
+  }
+  return certs;
+}
+
+bool SharedRootCerts::AddToStore(X509_STORE* store, STACK_OF(X509)* certs) {
+  for (size_t i = 0; i < sk_X509_num(certs); i++) {
+    // X509_STORE_add_cert increments the reference count of cert on success.
+    if (X509_STORE_add_cert(store, sk_X509_value(certs, i)) == 0) {
+      ERR_clear_error();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SharedRootCerts::AddFileToStore(X509_STORE* store, const char* file) {
+  if (mutex_ == nullptr) {
+    return false;
+  }
+  int64_t stat[File::kStatSize];
+  File::Stat(nullptr, file, stat);
+  if (stat[File::kType] != File::kIsFile) {
+    return false;
+  }
+  MutexLocker ml(mutex_);
+  Bundle* bundle = bundles_;
+  while (bundle != nullptr && strcmp(bundle->file, file) != 0) {
+    bundle = bundle->next;
+  }
+  if (bundle == nullptr || bundle->modified != stat[File::kModifiedTime] ||
+      bundle->size != stat[File::kSize]) {
+    BIO* bio = BIO_new_file(file, "r");
+    if (bio == nullptr) {
+      ERR_clear_error();
+      return false;
+    }
+    STACK_OF(X509)* certs = ReadCertificates(bio);
+    BIO_free(bio);
+    if (certs == nullptr) {
+      return false;
+    }
+    if (bundle == nullptr) {
+      bundle = new Bundle();
+      bundle->file = Utils::StrDup(file);
+      bundle->next = bundles_;
+      bundles_ = bundle;
+    } else {
+      // Stores which trust the old certificates keep them alive.
+      sk_X509_pop_free(bundle->certs, X509_free);
+    }
+    bundle->modified = stat[File::kModifiedTime];
+    bundle->size = stat[File::kSize];
+    bundle->certs = certs;
+  }
+  return AddToStore(store, bundle->certs);
+}
+
+bool SharedRootCerts::AddCompiledInToStore(X509_STORE* store) {
+  if (mutex_ == nullptr || root_certificates_pem == nullptr) {
+    return false;
+  }
+  MutexLocker ml(mutex_);
+  if (compiled_in_certs_ == nullptr) {
+    BIO* roots_bio =
+        BIO_new_mem_buf(const_cast<unsigned char*>(root_certificates_pem),
+                        root_certificates_pem_length);
+    compiled_in_certs_ = ReadCertificates(roots_bio);
+    BIO_free(roots_bio);
+    if (compiled_in_certs_ == nullptr) {
+      return false;
+    }
+  }
+  return AddToStore(store, compiled_in_certs_);
+}
+
 void FUNCTION_NAME(SecurityContext_Allocate)(Dart_NativeArguments args) {
   SSLFilter::InitializeLibrary();
   SSL_CTX* ctx = SSL_CTX_new(TLS_method());
@@ -831,6 +1074,7 @@ void FUNCTION_NAME(SecurityContext_Allocate)(Dart_NativeArguments args) {
   // for `SecurityContext.minimumTlsProtocolVersion` must also be changed.
   SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
   SSL_CTX_set_cipher_list(ctx, "HIGH:MEDIUM");
+  SessionTicketKeys::Attach(ctx);
   SSLCertContext* context = new SSLCertContext(ctx);
   Dart_Handle err = SetSecurityContext(args, context);
   if (Dart_IsError(err)) {
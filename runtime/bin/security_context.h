@@ -5,6 +5,7 @@
 #ifndef RUNTIME_BIN_SECURITY_CONTEXT_H_
 #define RUNTIME_BIN_SECURITY_CONTEXT_H_
 
+#include <openssl/hmac.h>
 #include <openssl/ssl.h>
 #include <openssl/x509.h>
 
@@ -125,6 +126,79 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
   DISALLOW_COPY_AND_ASSIGN(SSLCertContext);
 };
 
+// Session ticket keys shared by all server SecurityContexts in the process,
+// so that a ticket issued by one context resumes the session on another.
+// Enabled by setting DART_TLS_SHARED_SESSION_TICKETS to the number of seconds
+// after which the key used for new tickets is rotated. Tickets encrypted with
+// the previous key are still accepted and renewed.
+class SessionTicketKeys : public AllStatic {
+ public:
+  static void Init();
+  static void Cleanup();
+
+  // Makes [context] use the shared keys if they are enabled.
+  static void Attach(SSL_CTX* context);
+
+ private:
+  struct Key {
+    uint8_t name[16];
+    uint8_t hmac_key[16];
+    uint8_t aes_key[16];
+  };
+
+  static int TicketKeyCallback(SSL* ssl,
+                               uint8_t* key_name,
+                               uint8_t* iv,
+                               EVP_CIPHER_CTX* cipher_ctx,
+                               HMAC_CTX* hmac_ctx,
+                               int encrypt);
+  static bool GenerateKey(Key* key);
+  static void RotateLocked(int64_t now);
+
+  static Mutex* mutex_;
+  static int64_t rotation_interval_millis_;
+  static int64_t next_rotation_millis_;
+  static bool has_previous_key_;
+  static Key current_key_;
+  static Key previous_key_;
+};
+
+// Root certificates parsed once and shared by all SecurityContexts in the
+// process. X509_STORE_add_cert only takes a reference to a certificate, so
+// adding the shared certificates to a store does not parse them again and
+// contexts trusting the same roots share their memory. Directories of roots
+// need no sharing, since the store looks certificates up in them by subject
+// hash on demand.
+class SharedRootCerts : public AllStatic {
+ public:
+  static void Init();
+  static void Cleanup();
+
+  // Adds the certificates of the PEM bundle [file] to [store], parsing the
+  // file again only if it changed. Returns false if the file cannot be
+  // shared this way, e.g. because it also contains CRLs.
+  static bool AddFileToStore(X509_STORE* store, const char* file);
+
+  // Adds the compiled-in root certificates to [store].
+  static bool AddCompiledInToStore(X509_STORE* store);
+
+ private:
+  struct Bundle {
+    char* file;
+    int64_t modified;
+    int64_t size;
+    STACK_OF(X509)* certs;
+    Bundle* next;
+  };
+
+  static STACK_OF(X509)* ReadCertificates(BIO* bio);
+  static bool AddToStore(X509_STORE* store, STACK_OF(X509)* certs);
+
+  static Mutex* mutex_;
+  static Bundle* bundles_;
+  static STACK_OF(X509)* compiled_in_certs_;
+};
+
 class X509Helper : public AllStatic {
  public:
   static Dart_Handle GetDer(Dart_NativeArguments args);
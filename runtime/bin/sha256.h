@@ -0,0 +1,42 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_SHA256_H_
+#define RUNTIME_BIN_SHA256_H_
+
+#include "platform/globals.h"
+
+namespace dart {
+namespace bin {
+
+// Computes SHA-256 digests (FIPS 180-4) of data added in any number of parts.
+class Sha256 {
+ public:
+  static constexpr intptr_t kDigestSize = 32;
+
+  Sha256();
+
+  void Update(const uint8_t* data, intptr_t length);
+
+  // Writes the digest of the data added so far. No data can be added
+  // afterwards.
+  void Finish(uint8_t digest[kDigestSize]);
+
+ private:
+  static constexpr intptr_t kBlockSize = 64;
+
+  void ProcessBlock(const uint8_t* block);
+
+  uint32_t state_[8];
+  uint8_t buffer_[kBlockSize];
+  intptr_t buffer_length_ = 0;
+  uint64_t total_length_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(Sha256);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // RUNTIME_BIN_SHA256_H_
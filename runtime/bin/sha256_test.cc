@@ -0,0 +1,60 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/sha256.h"
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+namespace bin {
+
+// Digests [length] bytes of [data], added in parts of at most [part_size].
+static void ExpectDigest(const char* expected,
+                         const uint8_t* data,
+                         intptr_t length,
+                         intptr_t part_size) {
+  Sha256 sha256;
+  for (intptr_t i = 0; i < length; i += part_size) {
+    sha256.Update(data + i, Utils::Minimum(part_size, length - i));
+  }
+  uint8_t digest[Sha256::kDigestSize];
+  sha256.Finish(digest);
+  char hex_digest[Sha256::kDigestSize * 2 + 1];
+  for (intptr_t i = 0; i < Sha256::kDigestSize; i++) {
+    snprintf(&hex_digest[i * 2], 3, "%02x", digest[i]);
+  }
+  EXPECT_STREQ(expected, hex_digest);
+}
+
+static void ExpectDigest(const char* expected, const char* data) {
+  const intptr_t length = strlen(data);
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  ExpectDigest(expected, bytes, length, Utils::Maximum<intptr_t>(length, 1));
+  ExpectDigest(expected, bytes, length, 1);
+  ExpectDigest(expected, bytes, length, 7);
+}
+
+TEST_CASE(Sha256) {
+  ExpectDigest(
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", "");
+  ExpectDigest(
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+      "abc");
+  // Padding that needs a second block.
+  ExpectDigest(
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+      "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+
+  const intptr_t kLength = 1000000;
+  uint8_t* data = reinterpret_cast<uint8_t*>(malloc(kLength));
+  memset(data, 'a', kLength);
+  ExpectDigest(
+      "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", data,
+      kLength, 1000);
+  free(data);
+}
+
+}  // namespace bin
+}  // namespace dart
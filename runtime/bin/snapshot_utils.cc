@@ -68,6 +68,8 @@ class MappedAppSnapshot : public AppSnapshot {
     delete isolate_instructions_mapping_;
   }
 
+  bool IsFileBacked() const { return true; }
+
   void SetBuffers(const uint8_t** vm_data_buffer,
                   const uint8_t** vm_instructions_buffer,
                   const uint8_t** isolate_data_buffer,
@@ -151,16 +153,20 @@ class ElfAppSnapshot : public AppSnapshot {
                  const uint8_t* vm_snapshot_data,
                  const uint8_t* vm_snapshot_instructions,
                  const uint8_t* isolate_snapshot_data,
-                 const uint8_t* isolate_snapshot_instructions)
+                 const uint8_t* isolate_snapshot_instructions,
+                 bool file_backed)
       : AppSnapshot{DartUtils::kAotELFMagicNumber},
         elf_(elf),
         vm_snapshot_data_(vm_snapshot_data),
         vm_snapshot_instructions_(vm_snapshot_instructions),
         isolate_snapshot_data_(isolate_snapshot_data),
-        isolate_snapshot_instructions_(isolate_snapshot_instructions) {}
+        isolate_snapshot_instructions_(isolate_snapshot_instructions),
+        file_backed_(file_backed) {}
 
   virtual ~ElfAppSnapshot() { Dart_UnloadELF(elf_); }
 
+  bool IsFileBacked() const { return file_backed_; }
+
   void SetBuffers(const uint8_t** vm_data_buffer,
                   const uint8_t** vm_instructions_buffer,
                   const uint8_t** isolate_data_buffer,
@@ -177,6 +183,9 @@ class ElfAppSnapshot : public AppSnapshot {
   const uint8_t* vm_snapshot_instructions_;
   const uint8_t* isolate_snapshot_data_;
   const uint8_t* isolate_snapshot_instructions_;
+  // Whether the segments were mapped from the file by Dart_LoadELF rather than
+  // copied out of a memory buffer.
+  const bool file_backed_;
 };
 
 static AppSnapshot* TryReadAppSnapshotElf(
@@ -213,7 +222,8 @@ static AppSnapshot* TryReadAppSnapshotElf(
     return nullptr;
   }
   return new ElfAppSnapshot(handle, vm_data_buffer, vm_instructions_buffer,
-                            isolate_data_buffer, isolate_instructions_buffer);
+                            isolate_data_buffer, isolate_instructions_buffer,
+                            /*file_backed=*/!force_load_elf_from_memory);
 }
 
 #if defined(DART_TARGET_OS_MACOS)
@@ -354,7 +364,8 @@ AppSnapshot* Snapshot::TryReadAppendedAppSnapshotElfFromPE(
 
       return new ElfAppSnapshot(handle, vm_data_buffer, vm_instructions_buffer,
                                 isolate_data_buffer,
-                                isolate_instructions_buffer);
+                                isolate_instructions_buffer,
+                                /*file_backed=*/false);
     }
   }
 
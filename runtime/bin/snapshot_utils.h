@@ -30,6 +30,11 @@ class AppSnapshot {
     return magic_number_ == DartUtils::kKernelListMagicNumber;
   }
 
+  // Whether the snapshot buffers are read-only mappings of the snapshot file
+  // made by the embedder itself, whose pages can be dropped with
+  // madvise(DONTNEED) after loading and faulted back in from the file.
+  virtual bool IsFileBacked() const { return false; }
+
  protected:
   explicit AppSnapshot(DartUtils::MagicNumber num) : magic_number_(num) {}
 
@@ -29,6 +29,97 @@ ListeningSocketRegistry* globalTcpListeningSocketRegistry = nullptr;
 
 bool Socket::short_socket_read_ = false;
 bool Socket::short_socket_write_ = false;
+int64_t Socket::lookup_cache_millis_ = 0;
+
+Mutex* HostLookupCache::mutex_ = nullptr;
+HostLookupCache::Entry HostLookupCache::entries_[kMaxEntries];
+
+void HostLookupCache::Init() {
+  ASSERT(mutex_ == nullptr);
+  mutex_ = new Mutex();
+}
+
+void HostLookupCache::Cleanup() {
+  ASSERT(mutex_ != nullptr);
+  for (intptr_t i = 0; i < kMaxEntries; i++) {
+    Clear(&entries_[i]);
+  }
+  delete mutex_;
+  mutex_ = nullptr;
+}
+
+AddressList<SocketAddress>* HostLookupCache::Copy(
+    const AddressList<SocketAddress>& addresses) {
+  auto copy = new AddressList<SocketAddress>(addresses.count());
+  for (intptr_t i = 0; i < addresses.count(); i++) {
+    RawAddr addr = addresses.GetAt(i)->addr();
+    copy->SetAt(i, new SocketAddress(&addr.addr));
+  }
+  return copy;
+}
+
+void HostLookupCache::Clear(Entry* entry) {
+  free(entry->host);
+  delete entry->addresses;
+  entry->host = nullptr;
+  entry->addresses = nullptr;
+}
+
+AddressList<SocketAddress>* HostLookupCache::Lookup(const char* host,
+                                                    int type) {
+  if (mutex_ == nullptr) {
+    return nullptr;
+  }
+  const int64_t now = TimerUtils::GetCurrentMonotonicMillis();
+  MutexLocker ml(mutex_);
+  for (intptr_t i = 0; i < kMaxEntries; i++) {
+    Entry* entry = &entries_[i];
+    if (entry->host == nullptr || entry->type != type ||
+        strcmp(entry->host, host) != 0) {
+      continue;
+    }
+    if (entry->expiry_millis <= now) {
+      Clear(entry);
+      return nullptr;
+    }
+    return Copy(*entry->addresses);
+  }
+  return nullptr;
+}
+
+void HostLookupCache::Insert(const char* host,
+                             int type,
+                             const AddressList<SocketAddress>& addresses) {
+  if (mutex_ == nullptr) {
+    return;
+  }
+  const int64_t expiry =
+      TimerUtils::GetCurrentMonotonicMillis() + Socket::lookup_cache_millis();
+  MutexLocker ml(mutex_);
+  // Prefer the entry of the same host (another lookup of it may have
+  // finished first), then a free entry, then the one expiring first.
+  Entry* victim = nullptr;
+  for (intptr_t i = 0; i < kMaxEntries; i++) {
+    Entry* entry = &entries_[i];
+    if (entry->host == nullptr) {
+      if (victim == nullptr || victim->host != nullptr) {
+        victim = entry;
+      }
+    } else if (entry->type == type && strcmp(entry->host, host) == 0) {
+      victim = entry;
+      break;
+    } else if (victim == nullptr || (victim->host != nullptr &&
+                                     entry->expiry_millis <
+                                         victim->expiry_millis)) {
+      victim = entry;
+    }
+  }
+  Clear(victim);
+  victim->host = Utils::StrDup(host);
+  victim->type = type;
+  victim->expiry_millis = expiry;
+  victim->addresses = Copy(addresses);
+}
 
 void ListeningSocketRegistry::Initialize() {
   ASSERT(globalTcpListeningSocketRegistry == nullptr);
@@ -529,6 +620,32 @@ void FUNCTION_NAME(Socket_Available)(Dart_NativeArguments args) {
   }
 }
 
+// Reads of up to this many bytes go through scope allocated memory into a
+// Uint8List on the Dart heap. Unlike external IO buffers these need neither
+// malloc and free nor a finalizer, which matters for many small reads.
+static constexpr intptr_t kMaxScratchReadLength = 64 * KB;
+
+static void ReadIntoTypedData(Dart_NativeArguments args,
+                              Socket* socket,
+                              intptr_t length) {
+  uint8_t* buffer = reinterpret_cast<uint8_t*>(Dart_ScopeAllocate(length));
+  intptr_t bytes_read =
+      SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
+  if (bytes_read > 0) {
+    Dart_Handle result =
+        ThrowIfError(Dart_NewTypedData(Dart_TypedData_kUint8, bytes_read));
+    ThrowIfError(Dart_ListSetAsBytes(result, 0, buffer, bytes_read));
+    Dart_SetReturnValue(args, result);
+  } else if (bytes_read == 0) {
+    // On MacOS when reading from a tty Ctrl-D will result in reading one
+    // less byte then reported as available.
+    Dart_SetReturnValue(args, Dart_Null());
+  } else {
+    ASSERT(bytes_read == -1);
+    Dart_ThrowException(DartUtils::NewDartOSError());
+  }
+}
+
 void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -538,6 +655,10 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
+    if (length <= kMaxScratchReadLength) {
+      ReadIntoTypedData(args, socket, length);
+      return;
+    }
     uint8_t* buffer = nullptr;
     Dart_Handle result = IOBuffer::Allocate(length, &buffer);
     if (Dart_IsNull(result)) {
@@ -582,36 +703,62 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
   }
 }
 
+intptr_t DatagramReceiveBuffer::Fill(intptr_t fd) {
+  ASSERT(IsEmpty());
+  next_ = 0;
+  count_ = 0;
+  const intptr_t received =
+      SocketBase::RecvFromMultiple(fd, data_, kDatagramLength, kMaxDatagrams,
+                                   lengths_, addrs_, SocketBase::kAsync);
+  if (received > 0) {
+    count_ = received;
+  }
+  return received;
+}
+
+const uint8_t* DatagramReceiveBuffer::Next(intptr_t* length, RawAddr* addr) {
+  ASSERT(!IsEmpty());
+  const intptr_t i = next_++;
+  *length = lengths_[i];
+  *addr = addrs_[i];
+  return data_ + i * kDatagramLength;
+}
+
 void FUNCTION_NAME(Socket_RecvFrom)(Dart_NativeArguments args) {
-  // TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
-  // handle 64k datagrams.
-  const int kReceiveBufferLen = 65536;
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
 
   // Ensure that a receive buffer for the UDP socket exists.
   ASSERT(socket != nullptr);
-  uint8_t* recv_buffer = socket->udp_receive_buffer();
-  if (recv_buffer == nullptr) {
-    recv_buffer = reinterpret_cast<uint8_t*>(malloc(kReceiveBufferLen));
-    socket->set_udp_receive_buffer(recv_buffer);
+  DatagramReceiveBuffer* receive_buffer = socket->udp_receive_buffer();
+  if (receive_buffer == nullptr) {
+    receive_buffer = new DatagramReceiveBuffer();
+    socket->set_udp_receive_buffer(receive_buffer);
   }
 
-  // Read data into the buffer.
+  // Read data into the buffer unless datagrams of a previous call are left.
+  if (receive_buffer->IsEmpty()) {
+    const intptr_t received = receive_buffer->Fill(socket->fd());
+    if (received == 0) {
+      Dart_SetReturnValue(args, Dart_Null());
+      return;
+    }
+    if (received < 0) {
+      ASSERT(received == -1);
+      Dart_ThrowException(DartUtils::NewDartOSError());
+    }
+  }
   RawAddr addr;
-  const intptr_t bytes_read = SocketBase::RecvFrom(
-      socket->fd(), recv_buffer, kReceiveBufferLen, &addr, SocketBase::kAsync);
+  intptr_t bytes_read;
+  const uint8_t* recv_buffer = receive_buffer->Next(&bytes_read, &addr);
   if (bytes_read == 0) {
+    // Empty datagrams are dropped as they are by SocketBase::RecvFrom.
     Dart_SetReturnValue(args, Dart_Null());
     return;
   }
-  if (bytes_read < 0) {
-    ASSERT(bytes_read == -1);
-    Dart_ThrowException(DartUtils::NewDartOSError());
-  }
 
   // Datagram data read. Copy into buffer of the exact size,
-  ASSERT(bytes_read >= 0);
+  ASSERT(bytes_read > 0);
   uint8_t* data_buffer = nullptr;
   Dart_Handle data = IOBuffer::Allocate(bytes_read, &data_buffer);
   if (Dart_IsNull(data)) {
@@ -782,6 +929,102 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   }
 }
 
+void FUNCTION_NAME(Socket_SendFile)(Dart_NativeArguments args) {
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  const intptr_t file_fd = DartUtils::GetNativeIntptrArgument(args, 1);
+  const int64_t offset = DartUtils::GetNativeIntegerArgument(args, 2);
+  const intptr_t length = DartUtils::GetNativeIntptrArgument(args, 3);
+  const intptr_t bytes_sent = SocketBase::SendFile(
+      socket->fd(), file_fd, offset, length, SocketBase::kAsync);
+  if (bytes_sent == SocketBase::kSendFileUnsupported) {
+    Dart_SetReturnValue(args, Dart_Null());
+  } else if (bytes_sent < 0) {
+    Dart_ThrowException(DartUtils::NewDartOSError());
+  } else {
+    Dart_SetIntegerReturnValue(args, bytes_sent);
+  }
+#else
+  // The caller falls back to reading and writing the file.
+  Dart_SetReturnValue(args, Dart_Null());
+#endif
+}
+
+static void ReleaseBuffers(Dart_Handle* buffer_objs, intptr_t count) {
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_TypedDataReleaseData(buffer_objs[i]);
+  }
+}
+
+void FUNCTION_NAME(Socket_WriteVector)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffers_obj = Dart_GetNativeArgument(args, 1);
+  ASSERT(Dart_IsList(buffers_obj));
+  intptr_t offset = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 2));
+  intptr_t num_buffers;
+  ThrowIfError(Dart_ListLength(buffers_obj, &num_buffers));
+  ASSERT(num_buffers > 0);
+  // Get all elements before acquiring the first buffer, which must not be
+  // interleaved with other API calls.
+  Dart_Handle* buffer_objs = reinterpret_cast<Dart_Handle*>(
+      Dart_ScopeAllocate(sizeof(Dart_Handle) * num_buffers));
+  ThrowIfError(Dart_ListGetRange(buffers_obj, 0, num_buffers, buffer_objs));
+  const void** buffers = reinterpret_cast<const void**>(
+      Dart_ScopeAllocate(sizeof(void*) * num_buffers));
+  intptr_t* lengths = reinterpret_cast<intptr_t*>(
+      Dart_ScopeAllocate(sizeof(intptr_t) * num_buffers));
+  for (intptr_t i = 0; i < num_buffers; i++) {
+    Dart_TypedData_Type type;
+    void* buffer = nullptr;
+    intptr_t len;
+    Dart_Handle result =
+        Dart_TypedDataAcquireData(buffer_objs[i], &type, &buffer, &len);
+    if (Dart_IsError(result)) {
+      ReleaseBuffers(buffer_objs, i);
+      Dart_PropagateError(result);
+    }
+    buffers[i] = buffer;
+    lengths[i] = len;
+  }
+  ASSERT(offset <= lengths[0]);
+  buffers[0] = static_cast<const uint8_t*>(buffers[0]) + offset;
+  lengths[0] -= offset;
+  intptr_t num_written_buffers = num_buffers;
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    // Write half of the first buffer, like Socket_WriteList does.
+    num_written_buffers = 1;
+    if (lengths[0] > 1) {
+      short_write = true;
+    }
+    lengths[0] = (lengths[0] + 1) / 2;
+  }
+  intptr_t bytes_written =
+      SocketBase::WriteVector(socket->fd(), buffers, lengths,
+                              num_written_buffers, SocketBase::kAsync);
+  if (bytes_written >= 0) {
+    ReleaseBuffers(buffer_objs, num_buffers);
+    if (short_write) {
+      // If the write was forced 'short', indicate by returning the negative
+      // number of bytes. A forced short write may not trigger a write event.
+      Dart_SetIntegerReturnValue(args, -bytes_written);
+    } else {
+      Dart_SetIntegerReturnValue(args, bytes_written);
+    }
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    Dart_Handle error;
+    {
+      OSError os_error;
+      ReleaseBuffers(buffer_objs, num_buffers);
+      error = DartUtils::NewDartOSError(&os_error);
+    }
+    Dart_ThrowException(error);
+  }
+}
+
 void FUNCTION_NAME(Socket_SendMessage)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -1061,8 +1304,17 @@ CObject* Socket::LookupRequest(const CObjectArray& request) {
     CObjectInt32 type(request[1]);
     CObject* result = nullptr;
     OSError* os_error = nullptr;
+    const bool use_cache = Socket::lookup_cache_millis() > 0;
     AddressList<SocketAddress>* addresses =
-        SocketBase::LookupAddress(host.CString(), type.Value(), &os_error);
+        use_cache ? HostLookupCache::Lookup(host.CString(), type.Value())
+                  : nullptr;
+    if (addresses == nullptr) {
+      addresses =
+          SocketBase::LookupAddress(host.CString(), type.Value(), &os_error);
+      if (use_cache && addresses != nullptr) {
+        HostLookupCache::Insert(host.CString(), type.Value(), *addresses);
+      }
+    }
     if (addresses != nullptr) {
       CObjectArray* array =
           new CObjectArray(CObject::NewArray(addresses->count() + 1));
@@ -1411,6 +1663,11 @@ void FUNCTION_NAME(Socket_AvailableDatagram)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
   ASSERT(socket != nullptr);
+  DatagramReceiveBuffer* receive_buffer = socket->udp_receive_buffer();
+  if ((receive_buffer != nullptr) && !receive_buffer->IsEmpty()) {
+    Dart_SetBooleanReturnValue(args, true);
+    return;
+  }
   // Ensure that a receive buffer for peeking the UDP socket exists.
   uint8_t recv_buffer[kReceiveBufferLen];
   bool available = SocketBase::AvailableDatagram(socket->fd(), recv_buffer,
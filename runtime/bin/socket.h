@@ -20,6 +20,42 @@ namespace bin {
 // TODO(bkonyi): Socket should also inherit from SocketBase once it is
 // refactored to use instance methods when possible.
 
+// Datagrams received from a UDP socket but not yet returned to Dart. Where
+// the platform supports it, several datagrams are received by a single
+// system call.
+class DatagramReceiveBuffer {
+ public:
+  // TODO(sgjesse): Use a MTU value here. Only the loopback adapter can
+  // handle 64k datagrams.
+  static constexpr intptr_t kDatagramLength = 65536;
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  static constexpr intptr_t kMaxDatagrams = 4;
+#else
+  static constexpr intptr_t kMaxDatagrams = 1;
+#endif
+
+  DatagramReceiveBuffer() : count_(0), next_(0) {}
+
+  bool IsEmpty() const { return next_ == count_; }
+
+  // Receives datagrams into the empty buffer. Returns the number of datagrams
+  // received as SocketBase::RecvFromMultiple does.
+  intptr_t Fill(intptr_t fd);
+
+  // Removes the next datagram from the non-empty buffer. The returned data
+  // stays valid until the next call to Fill.
+  const uint8_t* Next(intptr_t* length, RawAddr* addr);
+
+ private:
+  uint8_t data_[kMaxDatagrams * kDatagramLength];
+  intptr_t lengths_[kMaxDatagrams];
+  RawAddr addrs_[kMaxDatagrams];
+  intptr_t count_;
+  intptr_t next_;
+
+  DISALLOW_COPY_AND_ASSIGN(DatagramReceiveBuffer);
+};
+
 // We write Sockets into the native field of the _NativeSocket object
 // on the Dart side. They are allocated in SetSocketIdNativeField(), and are
 // deallocated either from the finalizer attached to _NativeSockets there, or
@@ -63,8 +99,12 @@ class Socket : public ReferenceCounted<Socket> {
   Dart_Port port() const { return port_; }
   void set_port(Dart_Port port) { port_ = port; }
 
-  uint8_t* udp_receive_buffer() const { return udp_receive_buffer_; }
-  void set_udp_receive_buffer(uint8_t* buffer) { udp_receive_buffer_ = buffer; }
+  DatagramReceiveBuffer* udp_receive_buffer() const {
+    return udp_receive_buffer_;
+  }
+  void set_udp_receive_buffer(DatagramReceiveBuffer* buffer) {
+    udp_receive_buffer_ = buffer;
+  }
 
   static bool Initialize();
 
@@ -107,6 +147,12 @@ class Socket : public ReferenceCounted<Socket> {
   static void set_short_socket_write(bool short_socket_write) {
     short_socket_write_ = short_socket_write;
   }
+  // How long the results of successful host name lookups are reused, in
+  // milliseconds. Lookups are not cached if this is 0.
+  static int64_t lookup_cache_millis() { return lookup_cache_millis_; }
+  static void set_lookup_cache_millis(int64_t lookup_cache_millis) {
+    lookup_cache_millis_ = lookup_cache_millis;
+  }
 
   static bool IsSignalSocketFlag(intptr_t flag) {
     return ((flag & (0x1 << kInternalSignalSocket)) != 0);
@@ -115,7 +161,7 @@ class Socket : public ReferenceCounted<Socket> {
  private:
   ~Socket() {
     ASSERT(fd_ == kClosedFd);
-    free(udp_receive_buffer_);
+    delete udp_receive_buffer_;
     udp_receive_buffer_ = nullptr;
   }
 
@@ -123,11 +169,12 @@ class Socket : public ReferenceCounted<Socket> {
 
   static bool short_socket_read_;
   static bool short_socket_write_;
+  static int64_t lookup_cache_millis_;
 
   intptr_t fd_;
   Dart_Port isolate_port_;
   Dart_Port port_;
-  uint8_t* udp_receive_buffer_;
+  DatagramReceiveBuffer* udp_receive_buffer_;
 
   friend class ReferenceCounted<Socket>;
   DISALLOW_COPY_AND_ASSIGN(Socket);
@@ -162,6 +209,44 @@ class ServerSocket {
   DISALLOW_IMPLICIT_CONSTRUCTORS(ServerSocket);
 };
 
+// Keeps the results of successful host name lookups for
+// Socket::lookup_cache_millis(), so that connecting to the same host over and
+// over (e.g. from an HttpClient) does not block an IO service thread in
+// getaddrinfo every time. getaddrinfo does not report the time to live of the
+// records it returns, which is why the embedder chooses how long to cache.
+class HostLookupCache : public AllStatic {
+ public:
+  static void Init();
+  static void Cleanup();
+
+  // Returns a copy of the unexpired addresses cached for [host] and [type],
+  // or nullptr. The caller owns the result.
+  static AddressList<SocketAddress>* Lookup(const char* host, int type);
+
+  // Caches a copy of [addresses] as the result of looking up [host] and
+  // [type], replacing the entry expiring first if the cache is full.
+  static void Insert(const char* host,
+                     int type,
+                     const AddressList<SocketAddress>& addresses);
+
+ private:
+  struct Entry {
+    char* host;
+    int type;
+    int64_t expiry_millis;
+    AddressList<SocketAddress>* addresses;
+  };
+
+  static constexpr intptr_t kMaxEntries = 64;
+
+  static AddressList<SocketAddress>* Copy(
+      const AddressList<SocketAddress>& addresses);
+  static void Clear(Entry* entry);
+
+  static Mutex* mutex_;
+  static Entry entries_[kMaxEntries];
+};
+
 class ListeningSocketRegistry {
  public:
   ListeningSocketRegistry()
@@ -347,5 +347,45 @@ intptr_t SocketBase::Write(intptr_t fd,
 }
 #endif
 
+#if !defined(DART_HOST_OS_LINUX) && !defined(DART_HOST_OS_ANDROID)
+intptr_t SocketBase::RecvFromMultiple(intptr_t fd,
+                                      uint8_t* buffers,
+                                      intptr_t buffer_length,
+                                      intptr_t num_buffers,
+                                      intptr_t* lengths,
+                                      RawAddr* addrs,
+                                      SocketOpKind sync) {
+  ASSERT(num_buffers >= 1);
+  const intptr_t bytes_read =
+      RecvFrom(fd, buffers, buffer_length, &addrs[0], sync);
+  if (bytes_read <= 0) {
+    return bytes_read;
+  }
+  lengths[0] = bytes_read;
+  return 1;
+}
+#endif
+
+#if defined(DART_HOST_OS_WINDOWS) || defined(DART_HOST_OS_FUCHSIA)
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const void* const* buffers,
+                                 const intptr_t* num_bytes,
+                                 intptr_t num_buffers,
+                                 SocketOpKind sync) {
+  intptr_t total_written = 0;
+  for (intptr_t i = 0; i < num_buffers; i++) {
+    intptr_t written_bytes = Write(fd, buffers[i], num_bytes[i], sync);
+    if (written_bytes < 0) {
+      return -1;  // Error occurred.
+    }
+    total_written += written_bytes;
+    if (written_bytes < num_bytes[i]) {
+      break;
+    }
+  }
+  return total_written;
+}
+#endif
+
 }  // namespace bin
 }  // namespace dart
@@ -196,6 +196,14 @@ class SocketBase : public AllStatic {
                         const void* buffer,
                         intptr_t num_bytes,
                         SocketOpKind sync);
+  // Writes the [num_buffers] buffers in order, as consecutive calls to Write
+  // would, but using a single system call for several buffers where
+  // supported. Returns the total number of bytes written.
+  static intptr_t WriteVector(intptr_t fd,
+                              const void* const* buffers,
+                              const intptr_t* num_bytes,
+                              intptr_t num_buffers,
+                              SocketOpKind sync);
 
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
@@ -217,6 +225,18 @@ class SocketBase : public AllStatic {
                            intptr_t num_bytes,
                            RawAddr* addr,
                            SocketOpKind sync);
+  // Receives up to [num_buffers] datagrams, the i-th one into the
+  // [buffer_length] bytes at [buffers] + i * [buffer_length], with a single
+  // system call where supported. Stores their lengths and senders into
+  // [lengths] and [addrs]. Returns the number of datagrams received, 0 if
+  // none was available or -1 on errors.
+  static intptr_t RecvFromMultiple(intptr_t fd,
+                                   uint8_t* buffers,
+                                   intptr_t buffer_length,
+                                   intptr_t num_buffers,
+                                   intptr_t* lengths,
+                                   RawAddr* addrs,
+                                   SocketOpKind sync);
   static intptr_t ReceiveMessage(intptr_t fd,
                                  void* buffer,
                                  int64_t* p_buffer_num_bytes,
@@ -261,6 +281,18 @@ class SocketBase : public AllStatic {
                              const RawAddr& interface,
                              int interfaceIndex);
 
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  static constexpr intptr_t kSendFileUnsupported = -2;
+  // Sends [num_bytes] of the file [file_fd] starting at [offset] without
+  // copying them through user space. Returns the number of bytes sent, -1 on
+  // errors or kSendFileUnsupported if the file cannot be sent this way.
+  static intptr_t SendFile(intptr_t fd,
+                           intptr_t file_fd,
+                           int64_t offset,
+                           intptr_t num_bytes,
+                           SocketOpKind sync);
+#endif
+
 #if defined(DART_HOST_OS_WINDOWS)
   static bool HasPendingWrite(intptr_t fd);
 #endif
@@ -7,15 +7,16 @@
 
 #include "bin/socket_base.h"
 
-#include <errno.h>        // NOLINT
-#include <ifaddrs.h>      // NOLINT
-#include <net/if.h>       // NOLINT
-#include <netinet/tcp.h>  // NOLINT
-#include <stdio.h>        // NOLINT
-#include <stdlib.h>       // NOLINT
-#include <string.h>       // NOLINT
-#include <sys/stat.h>     // NOLINT
-#include <unistd.h>       // NOLINT
+#include <errno.h>         // NOLINT
+#include <ifaddrs.h>       // NOLINT
+#include <net/if.h>        // NOLINT
+#include <netinet/tcp.h>   // NOLINT
+#include <stdio.h>         // NOLINT
+#include <stdlib.h>        // NOLINT
+#include <string.h>        // NOLINT
+#include <sys/sendfile.h>  // NOLINT
+#include <sys/stat.h>      // NOLINT
+#include <unistd.h>        // NOLINT
 
 #include "bin/fdutils.h"
 #include "bin/file.h"
@@ -95,6 +96,75 @@ AddressList<SocketAddress>* SocketBase::LookupAddress(const char* host,
   return addresses;
 }
 
+intptr_t SocketBase::RecvFromMultiple(intptr_t fd,
+                                      uint8_t* buffers,
+                                      intptr_t buffer_length,
+                                      intptr_t num_buffers,
+                                      intptr_t* lengths,
+                                      RawAddr* addrs,
+                                      SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  const intptr_t kMaxMessages = 16;
+  ASSERT((num_buffers >= 1) && (num_buffers <= kMaxMessages));
+  struct mmsghdr messages[kMaxMessages];
+  struct iovec iov[kMaxMessages];
+  memset(messages, 0, sizeof(messages[0]) * num_buffers);
+  for (intptr_t i = 0; i < num_buffers; i++) {
+    iov[i].iov_base = buffers + i * buffer_length;
+    iov[i].iov_len = buffer_length;
+    messages[i].msg_hdr.msg_iov = &iov[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    messages[i].msg_hdr.msg_name = &addrs[i].addr;
+    messages[i].msg_hdr.msg_namelen = sizeof(addrs[i].ss);
+  }
+  // Only wait for the first datagram of synchronous reads.
+  const int flags = (sync == kAsync) ? MSG_DONTWAIT : MSG_WAITFORONE;
+  const int received = TEMP_FAILURE_RETRY(
+      recvmmsg(fd, messages, num_buffers, flags, nullptr));
+  if (received == -1) {
+    // If the read would block we need to retry and therefore return 0.
+    return ((sync == kAsync) && (errno == EWOULDBLOCK)) ? 0 : -1;
+  }
+  for (intptr_t i = 0; i < received; i++) {
+    lengths[i] = messages[i].msg_len;
+  }
+  return received;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  // As in Write, keep on sending until the socket would block to be
+  // guaranteed an edge-triggered write event.
+  intptr_t num_bytes_left = num_bytes;
+  while (num_bytes_left > 0) {
+    ssize_t sent_bytes = TEMP_FAILURE_RETRY(
+        sendfile64(fd, file_fd, &offset, num_bytes_left));
+    static_assert(EAGAIN == EWOULDBLOCK);
+    if (sent_bytes == -1) {
+      if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+        break;
+      }
+      // From sendfile man pages:
+      //   Applications may wish to fall back to read(2)/write(2) in the case
+      //   where sendfile() fails with EINVAL or ENOSYS.
+      if ((num_bytes_left == num_bytes) &&
+          ((errno == EINVAL) || (errno == ENOSYS))) {
+        return kSendFileUnsupported;
+      }
+      return -1;  // Error occurred.
+    }
+    if (sent_bytes == 0) {
+      break;  // End of file.
+    }
+    num_bytes_left -= sent_bytes;
+  }
+  return num_bytes - num_bytes_left;
+}
+
 bool SocketBase::SetMulticastLoop(intptr_t fd,
                                   intptr_t protocol,
                                   bool enabled) {
@@ -14,6 +14,7 @@
 #include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/uio.h>      // NOLINT
 #include <unistd.h>       // NOLINT
 
 #include "bin/fdutils.h"
@@ -200,6 +201,49 @@ intptr_t SocketBase::WriteImpl(intptr_t fd,
   return TEMP_FAILURE_RETRY(write(fd, buffer, num_bytes));
 }
 
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const void* const* buffers,
+                                 const intptr_t* num_bytes,
+                                 intptr_t num_buffers,
+                                 SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  const intptr_t kMaxIOVecs = 64;
+  struct iovec iov[kMaxIOVecs];
+  intptr_t total_written = 0;
+  intptr_t next = 0;
+  // Bytes of buffers[next] written by a previous writev.
+  intptr_t next_offset = 0;
+  // As in Write, keep on writing until the socket would block to be
+  // guaranteed an edge-triggered write event.
+  while (next < num_buffers) {
+    intptr_t count = 0;
+    for (intptr_t i = next; (i < num_buffers) && (count < kMaxIOVecs); i++) {
+      const intptr_t offset = (i == next) ? next_offset : 0;
+      iov[count].iov_base =
+          const_cast<uint8_t*>(static_cast<const uint8_t*>(buffers[i])) +
+          offset;
+      iov[count].iov_len = num_bytes[i] - offset;
+      count++;
+    }
+    ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, iov, count));
+    static_assert(EAGAIN == EWOULDBLOCK);
+    if (written_bytes == -1) {
+      if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+        break;
+      }
+      return -1;  // Error occurred.
+    }
+    total_written += written_bytes;
+    written_bytes += next_offset;
+    while ((next < num_buffers) && (written_bytes >= num_bytes[next])) {
+      written_bytes -= num_bytes[next];
+      next++;
+    }
+    next_offset = written_bytes;
+  }
+  return total_written;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -38,6 +38,10 @@ class VirtualMemory {
   static void Protect(void* address, intptr_t size, Protection mode);
   void Protect(Protection mode) { return Protect(address(), size(), mode); }
 
+  // Asks the OS to back the memory later faulted into this range with
+  // transparent huge pages. Returns false where this is unsupported.
+  static bool AdviseHugePages(void* address, intptr_t size);
+
   // Reserves and commits a virtual memory segment with size. If a segment of
   // the requested size cannot be allocated, nullptr is returned.
   static VirtualMemory* Allocate(intptr_t size,
@@ -104,6 +104,10 @@ void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
   }
 }
 
+bool VirtualMemory::AdviseHugePages(void* address, intptr_t size) {
+  return false;
+}
+
 }  // namespace bin
 }  // namespace dart
 
@@ -68,10 +68,30 @@ DART_EXPORT void DartEngine_SetMessageScheduler(
   Engine::instance()->SetMessageScheduler(scheduler, isolate);
 }
 
+DART_EXPORT DartEngine_MessageScheduler
+DartEngine_StartScheduler(int32_t thread_count, int64_t time_slice_micros) {
+  return Engine::instance()->StartScheduler(thread_count, time_slice_micros);
+}
+
 DART_EXPORT void DartEngine_HandleMessage(Dart_Isolate isolate) {
   Engine::instance()->HandleMessage(isolate);
 }
 
+DART_EXPORT bool DartEngine_HandleMessages(Dart_Isolate isolate,
+                                          intptr_t max_messages,
+                                          int64_t deadline) {
+  return Engine::instance()->HandleMessages(isolate, max_messages, deadline);
+}
+
+DART_EXPORT void DartEngine_SetIdleScheduler(
+    DartEngine_IdleScheduler scheduler) {
+  Engine::instance()->SetIdleScheduler(scheduler);
+}
+
+DART_EXPORT bool DartEngine_HandleIdle(Dart_Isolate isolate, int64_t deadline) {
+  return Engine::instance()->HandleIdle(isolate, deadline);
+}
+
 DART_EXPORT Dart_Handle DartEngine_DrainMicrotasksQueue() {
   return Engine::instance()->DrainMicrotasksQueue();
 }
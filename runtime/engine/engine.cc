@@ -8,6 +8,7 @@
 #include "include/dart_api.h"
 #include "include/dart_embedder_api.h"
 #include "include/dart_engine.h"
+#include "include/dart_tools_api.h"
 #include "platform/lockers.h"
 #include "platform/syslog.h"
 #include "platform/utils.h"
@@ -24,8 +25,21 @@ Engine* Engine::instance() {
   return instance;
 }
 
+bool Engine::LookupSnapshot(const char* path, DartEngine_SnapshotData* result) {
+  MutexLocker ml(&engine_state_);
+  auto it = snapshots_by_path_.find(path);
+  if (it == snapshots_by_path_.end()) {
+    return false;
+  }
+  *result = it->second;
+  return true;
+}
+
 DartEngine_SnapshotData Engine::KernelFromFile(const char* path, char** error) {
   DartEngine_SnapshotData result;
+  if (LookupSnapshot(path, &result)) {
+    return result;
+  }
   result.kind = DartEngine_SnapshotKind_Kernel;
   result.script_uri = Utils::SCreate("file://%s", path);
   FILE* file = fopen(path, "rb");
@@ -54,6 +68,13 @@ DartEngine_SnapshotData Engine::KernelFromFile(const char* path, char** error) {
 
   {
     MutexLocker ml(&engine_state_);
+    auto inserted = snapshots_by_path_.emplace(path, result);
+    if (!inserted.second) {
+      // Another thread loaded the same file concurrently.
+      free(buffer);
+      free(const_cast<char*>(result.script_uri));
+      return inserted.first->second;
+    }
     owned_snapshots_.emplace_back(result);
   }
 
@@ -62,6 +83,9 @@ DartEngine_SnapshotData Engine::KernelFromFile(const char* path, char** error) {
 
 DartEngine_SnapshotData Engine::AotFromFile(const char* path, char** error) {
   DartEngine_SnapshotData result;
+  if (LookupSnapshot(path, &result)) {
+    return result;
+  }
   result.kind = DartEngine_SnapshotKind_AOT;
   result.script_uri = Utils::SCreate("file://%s", path);
 
@@ -87,6 +111,13 @@ DartEngine_SnapshotData Engine::AotFromFile(const char* path, char** error) {
   {
     MutexLocker ml(&engine_state_);
     loaded_libraries_.emplace_back(library);
+    auto inserted = snapshots_by_path_.emplace(path, result);
+    if (!inserted.second) {
+      // Another thread loaded the same file concurrently. The library stays
+      // loaded until shutdown, as dlopen reference counts it anyway.
+      free(const_cast<char*>(result.script_uri));
+      return inserted.first->second;
+    }
     owned_snapshots_.emplace_back(result);
   }
 
@@ -121,6 +152,9 @@ bool Engine::Initialize(char** error) {
   if (Dart_IsPrecompiledRuntime()) {
     flags.push_back("--precompilation");
   }
+  // Idle notifications only come from DartEngine_HandleIdle, so let them do
+  // incremental marking work too.
+  flags.push_back("--mark_when_idle");
   *error = Dart_SetVMFlags(flags.size(), flags.data());
 
   if (*error != nullptr) {
@@ -170,8 +204,27 @@ Dart_Isolate Engine::StartIsolate(DartEngine_SnapshotData snapshot,
   Dart_IsolateFlags isolate_flags;
   Dart_IsolateFlagsInitialize(&isolate_flags);
 
+  const void* program = snapshot.kind == DartEngine_SnapshotKind_AOT
+                            ? static_cast<const void*>(snapshot.vm_isolate_data)
+                            : static_cast<const void*>(snapshot.kernel_buffer);
+  Dart_Isolate group_member = nullptr;
+  {
+    MutexLocker ml(&engine_state_);
+    auto it = group_members_.find(program);
+    if (it != group_members_.end()) {
+      group_member = it->second;
+    }
+  }
+
   Dart_Isolate isolate;
-  if (Dart_IsPrecompiledRuntime()) {
+  if (group_member != nullptr) {
+    // The member must not be entered while the new isolate is created.
+    LockIsolate(group_member);
+    isolate =
+        Dart_CreateIsolateInGroup(group_member, snapshot.script_uri, nullptr,
+                                  nullptr, nullptr, error);
+    UnlockIsolate(group_member);
+  } else if (Dart_IsPrecompiledRuntime()) {
     // Automatically sets the root library for the isolate.
     isolate = Dart_CreateIsolateGroup(
         snapshot.script_uri, strrchr(snapshot.script_uri, '/'),
@@ -201,7 +254,9 @@ Dart_Isolate Engine::StartIsolate(DartEngine_SnapshotData snapshot,
     return nullptr;
   }
 
-  if (!Dart_IsPrecompiledRuntime()) {
+  if (group_member == nullptr && !Dart_IsPrecompiledRuntime()) {
+    // The group already has a root library if it has members.
+    //
     // In kernel mode, also call LoadScriptFromKernel to set the root library.
     // Technically, the library is already loaded after
     // Dart_CreateIsolateGroupFromKernel, the problem is we don't know its URI
@@ -236,6 +291,10 @@ Dart_Isolate Engine::StartIsolate(DartEngine_SnapshotData snapshot,
   Dart_ExitIsolate();
   is_running_ = true;
   isolates_.emplace_back(isolate);
+  if (group_member == nullptr) {
+    MutexLocker ml(&engine_state_);
+    group_members_.emplace(program, isolate);
+  }
   return isolate;
 }
 
@@ -247,6 +306,11 @@ void Engine::Shutdown() {
   MutexLocker shutdown_locker(&engine_lifecycle_);
 
   is_running_ = false;
+  if (scheduler_ != nullptr) {
+    // Workers may be handling messages, so they have to stop before the
+    // isolates are shut down.
+    scheduler_->Stop();
+  }
   for (auto isolate : isolates_) {
     std::shared_ptr<Engine::IsolateData> isolate_data = DataForIsolate(isolate);
     LockIsolate(isolate);
@@ -275,9 +339,54 @@ void Engine::Shutdown() {
   }
 }
 
+namespace {
+// Counts one notified message as handled, if there are any.
+bool TakePendingMessage(std::atomic<intptr_t>* pending_messages) {
+  intptr_t pending = pending_messages->load(std::memory_order_relaxed);
+  while (pending > 0) {
+    if (pending_messages->compare_exchange_weak(pending, pending - 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
 void Engine::HandleMessage(Dart_Isolate isolate) {
-  LockIsolate(isolate);
+  std::shared_ptr<Engine::IsolateData> isolate_data = DataForIsolate(isolate);
+  isolate_data->mutex.Lock();
+  TakePendingMessage(&isolate_data->pending_messages);
   Dart_EnterIsolate(isolate);
+  HandleNextMessage(isolate);
+  Dart_ExitIsolate();
+  FinishHandlingMessages(isolate, isolate_data.get());
+}
+
+bool Engine::HandleMessages(Dart_Isolate isolate,
+                            intptr_t max_messages,
+                            int64_t deadline) {
+  std::shared_ptr<Engine::IsolateData> isolate_data = DataForIsolate(isolate);
+  if (isolate_data->pending_messages == 0) {
+    // The messages were already handled by an earlier batch.
+    return false;
+  }
+  isolate_data->mutex.Lock();
+  Dart_EnterIsolate(isolate);
+  for (intptr_t i = 0; i < max_messages; i++) {
+    if (!TakePendingMessage(&isolate_data->pending_messages)) {
+      break;
+    }
+    HandleNextMessage(isolate);
+    if (deadline > 0 && Dart_TimelineGetMicros() >= deadline) {
+      break;
+    }
+  }
+  Dart_ExitIsolate();
+  FinishHandlingMessages(isolate, isolate_data.get());
+  return isolate_data->pending_messages > 0;
+}
+
+void Engine::HandleNextMessage(Dart_Isolate isolate) {
   Dart_EnterScope();
 
   Dart_Handle handle_result = Dart_HandleMessage();
@@ -292,8 +401,33 @@ void Engine::HandleMessage(Dart_Isolate isolate) {
   }
 
   Dart_ExitScope();
+}
+
+void Engine::FinishHandlingMessages(Dart_Isolate isolate,
+                                    IsolateData* isolate_data) {
+  DartEngine_IdleScheduler scheduler = idle_scheduler_;
+  bool request_idle =
+      scheduler.schedule_callback != nullptr && !isolate_data->idle_requested;
+  isolate_data->idle_requested |= request_idle;
+  isolate_data->mutex.Unlock();
+
+  // Outside of the isolate lock, so the scheduler may run HandleIdle directly.
+  if (request_idle) {
+    scheduler.schedule_callback(isolate, scheduler.context);
+  }
+}
+
+bool Engine::HandleIdle(Dart_Isolate isolate, int64_t deadline) {
+  std::shared_ptr<Engine::IsolateData> isolate_data = DataForIsolate(isolate);
+  if (!isolate_data->mutex.TryLock()) {
+    return false;
+  }
+  isolate_data->idle_requested = false;
+  Dart_EnterIsolate(isolate);
+  Dart_NotifyIdle(deadline);
   Dart_ExitIsolate();
-  UnlockIsolate(isolate);
+  isolate_data->mutex.Unlock();
+  return true;
 }
 
 Dart_Handle Engine::DrainMicrotasksQueue() {
@@ -332,11 +466,11 @@ void Engine::NotifyMessage(Dart_Isolate isolate) {
     // completion (which happens in samples/embedder/run_timer_async), and
     // another thread calls Engine::Shutdown, the deadlock may occur:
     //
-    // 1. MessageNotifyCallback thread owns PortMap::mutex_ (through
+    // 1. MessageNotifyCallback thread owns a PortMap shard lock (through
     // PortMap::PostMessage) and wants to lock an isolate (via
     // Engine::LockIsolate).
-    // 2. Shutdown thread owns an isolate lock and wants to lock PortMap::mutex_
-    // (inside Dart_ShutdownIsolate call).
+    // 2. Shutdown thread owns an isolate lock and wants to lock the PortMap
+    // shard lock (inside Dart_ShutdownIsolate call).
     //
     // This mutex is used to prevent it:
     // - Engine::Shutdown locks it.
@@ -345,7 +479,8 @@ void Engine::NotifyMessage(Dart_Isolate isolate) {
     return;
   }
 
-  DartEngine_MessageScheduler scheduler = DataForIsolate(isolate)->scheduler;
+  std::shared_ptr<Engine::IsolateData> isolate_data = DataForIsolate(isolate);
+  DartEngine_MessageScheduler scheduler = isolate_data->scheduler;
 
   if (scheduler.schedule_callback == nullptr) {
     scheduler = default_scheduler_;
@@ -354,6 +489,8 @@ void Engine::NotifyMessage(Dart_Isolate isolate) {
     engine_lifecycle_.Unlock();
     return;
   }
+  // Counted before scheduling, so that the scheduled HandleMessages sees it.
+  isolate_data->pending_messages++;
   scheduler.schedule_callback(isolate, scheduler.context);
   engine_lifecycle_.Unlock();
 }
@@ -363,10 +500,23 @@ void Engine::SetHandleMessageErrorCallback(
   handle_message_error_callback_ = callback;
 }
 
+void Engine::SetIdleScheduler(DartEngine_IdleScheduler scheduler) {
+  idle_scheduler_ = scheduler;
+}
+
 void Engine::SetDefaultMessageScheduler(DartEngine_MessageScheduler scheduler) {
   default_scheduler_ = scheduler;
 }
 
+DartEngine_MessageScheduler Engine::StartScheduler(intptr_t thread_count,
+                                                   int64_t time_slice_micros) {
+  MutexLocker ml(&engine_lifecycle_);
+  if (scheduler_ == nullptr) {
+    scheduler_ = std::make_unique<Scheduler>(thread_count, time_slice_micros);
+  }
+  return scheduler_->message_scheduler();
+}
+
 void Engine::SetMessageScheduler(DartEngine_MessageScheduler scheduler,
                                  Dart_Isolate isolate) {
   DataForIsolate(isolate)->scheduler = scheduler;
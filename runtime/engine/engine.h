@@ -5,9 +5,12 @@
 #ifndef RUNTIME_ENGINE_ENGINE_H_
 #define RUNTIME_ENGINE_ENGINE_H_
 
+#include <atomic>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
+#include "engine/scheduler.h"
 #include "include/dart_engine.h"
 #include "platform/synchronization.h"
 
@@ -23,18 +26,22 @@ class Engine {
  public:
   // Loads Kernel snapshot from given file path.
   //
-  // Just reads all bytes into a single buffer, owned by this class.
+  // Just reads all bytes into a single buffer, owned by this class. Loading
+  // the same path again returns the same buffer.
   DartEngine_SnapshotData KernelFromFile(const char* path, char** error);
 
   // Loads AOT snapshot from given file path.
   //
   // Opens given AOT snapshot as a shared library and loads buffer symbols from
-  // it.
+  // it. Loading the same path again returns the same buffers.
   DartEngine_SnapshotData AotFromFile(const char* path, char** error);
 
   // Starts an isolate from a snapshot.
   //
   // Starting an isolate also routes message notify callback to NotifyMessage.
+  //
+  // Isolates started from the same snapshot buffers share an isolate group,
+  // so all but the first one reuse its program and heap.
   Dart_Isolate StartIsolate(const DartEngine_SnapshotData snapshot,
                             char** error);
 
@@ -51,8 +58,24 @@ class Engine {
   void NotifyMessage(Dart_Isolate isolate);
 
   // Calls Dart_HandleMessage, managing an isolate lock and Dart scope.
+  //
+  // Afterwards asks the idle scheduler (if any) to schedule idle work.
   void HandleMessage(Dart_Isolate isolate);
 
+  // Handles up to |max_messages| of the messages the isolate was notified
+  // about, stopping early once |deadline| (if positive) has passed. Enters the
+  // isolate only once for all of them.
+  //
+  // Returns whether the isolate has more messages to handle.
+  bool HandleMessages(Dart_Isolate isolate,
+                      intptr_t max_messages,
+                      int64_t deadline);
+
+  // Calls Dart_NotifyIdle with the deadline if the isolate lock is free.
+  //
+  // Returns false without waiting if another thread holds the isolate.
+  bool HandleIdle(Dart_Isolate isolate, int64_t deadline);
+
   // Drains the microtasks queue, requires an active isolate.
   Dart_Handle DrainMicrotasksQueue();
 
@@ -60,6 +83,9 @@ class Engine {
   void SetHandleMessageErrorCallback(
       DartEngine_HandleMessageErrorCallback callback);
 
+  // Sets the scheduler asked to run HandleIdle after messages are handled.
+  void SetIdleScheduler(DartEngine_IdleScheduler scheduler);
+
   // Sets a message scheduler for a given isolate.
   void SetDefaultMessageScheduler(DartEngine_MessageScheduler scheduler);
 
@@ -68,6 +94,10 @@ class Engine {
   void SetMessageScheduler(DartEngine_MessageScheduler scheduler,
                            Dart_Isolate isolate);
 
+  // Starts the built-in scheduler, if it is not started yet, and returns it.
+  DartEngine_MessageScheduler StartScheduler(intptr_t thread_count,
+                                             int64_t time_slice_micros);
+
   // Initializes embedder and partially initializes Dart VM.
   //
   // Full initialization happens only when the user starts the first isolate, as
@@ -93,8 +123,20 @@ class Engine {
     Mutex mutex;
     Dart_PersistentHandle isolate_library;
     Dart_PersistentHandle drain_microtasks_function_name;
+    // Whether idle work was requested from the idle scheduler and has not run
+    // yet. Guarded by mutex.
+    bool idle_requested = false;
+    // Number of message notifications not followed by HandleMessage(s) yet.
+    std::atomic<intptr_t> pending_messages = 0;
   };
 
+  // Calls Dart_HandleMessage in a new scope, requires an active isolate.
+  void HandleNextMessage(Dart_Isolate isolate);
+
+  // Asks the idle scheduler (if any) for idle work and releases the isolate
+  // lock held for handling messages.
+  void FinishHandlingMessages(Dart_Isolate isolate, IsolateData* isolate_data);
+
   // Set to false once shutdown starts.
   bool is_running_ = false;
 
@@ -117,6 +159,13 @@ class Engine {
   // and are freed on Shutdown.
   std::vector<DartEngine_SnapshotData> owned_snapshots_;
 
+  // Snapshots loaded by KernelFromFile and AotFromFile, by path.
+  std::unordered_map<std::string, DartEngine_SnapshotData> snapshots_by_path_;
+
+  // The first isolate started from a snapshot, by its kernel buffer or
+  // isolate snapshot data. Later isolates are created in its group.
+  std::unordered_map<const void*, Dart_Isolate> group_members_;
+
   // Loaded dynamic libraries. Dynamic libraries are loaded
   // when reading AOT snapshots.
   std::vector<void*> loaded_libraries_;
@@ -130,9 +179,18 @@ class Engine {
   // Default scheduler.
   DartEngine_MessageScheduler default_scheduler_;
 
+  // Idle work scheduler.
+  DartEngine_IdleScheduler idle_scheduler_;
+
+  // Built-in scheduler, stopped on Shutdown. Guarded by engine_lifecycle_.
+  std::unique_ptr<Scheduler> scheduler_;
+
   // Callback to notify about Dart_HandleMessage errors.
   DartEngine_HandleMessageErrorCallback handle_message_error_callback_;
 
+  // Returns the snapshot already loaded from |path|, if any.
+  bool LookupSnapshot(const char* path, DartEngine_SnapshotData* result);
+
   // Helper function to get an element from isolate_data_.
   std::shared_ptr<IsolateData> DataForIsolate(Dart_Isolate isolate);
 };
@@ -125,6 +125,25 @@ DART_EXPORT Dart_Handle DartEngine_DrainMicrotasksQueue();
  */
 DART_EXPORT void DartEngine_HandleMessage(Dart_Isolate isolate);
 
+/**
+ * Handles up to |max_messages| messages for an isolate, entering it only
+ * once.
+ *
+ * Only messages the scheduler was notified about are handled, so a batch may
+ * handle messages whose notifications are still to be delivered; handling
+ * those notifications returns immediately.
+ *
+ * \param max_messages Maximum number of messages to handle.
+ * \param deadline Stop after the message during which this time passes.
+ *    Measured in microseconds against Dart_TimelineGetMicros(). No deadline
+ *    if 0.
+ *
+ * \return true if the isolate has more messages to handle.
+ */
+DART_EXPORT bool DartEngine_HandleMessages(Dart_Isolate isolate,
+                                          intptr_t max_messages,
+                                          int64_t deadline);
+
 /**
  * Message scheduling callback.
  *
@@ -162,6 +181,73 @@ DART_EXPORT void DartEngine_SetMessageScheduler(
     DartEngine_MessageScheduler scheduler,
     Dart_Isolate isolate);
 
+/**
+ * Starts the built-in message scheduler, which handles the messages of all
+ * isolates using it on a pool of worker threads.
+ *
+ * Each worker has its own queue of isolates with pending messages and keeps
+ * running the isolates it ran before. Idle workers take isolates from the
+ * queues of busy workers. An isolate runs for at most |time_slice_micros| (but
+ * at least one message) before the worker moves on to the next isolate.
+ *
+ * Only the first call starts the scheduler; later calls return the same one.
+ * The scheduler is stopped by \ref DartEngine_Shutdown.
+ *
+ * \param thread_count Number of worker threads, or 0 for one per processor.
+ * \param time_slice_micros Length of a turn of an isolate, or 0 for the
+ *    default of 1ms.
+ *
+ * \return The scheduler, to be passed to
+ *    \ref DartEngine_SetDefaultMessageScheduler or
+ *    \ref DartEngine_SetMessageScheduler.
+ */
+DART_EXPORT DartEngine_MessageScheduler
+DartEngine_StartScheduler(int32_t thread_count, int64_t time_slice_micros);
+
+/**
+ * Idle work scheduling callback.
+ *
+ * Dart Engine calls this callback after DartEngine_HandleMessage, so that
+ * garbage collection work can be done while the embedder is idle. The
+ * callback should schedule an execution of DartEngine_HandleIdle with the
+ * given isolate once the embedder's event loop has nothing else to do. It is
+ * called at most once until DartEngine_HandleIdle runs for the isolate.
+ *
+ * \param isolate The isolate with pending idle work.
+ * \param context Context from \ref DartEngine_IdleScheduler.
+ */
+typedef void (*DartEngine_ScheduleIdleCallback)(Dart_Isolate isolate,
+                                                void* context);
+
+/**
+ * Scheduler for idle work.
+ */
+typedef struct DartEngine_IdleScheduler {
+  DartEngine_ScheduleIdleCallback schedule_callback;
+  void* context;
+} DartEngine_IdleScheduler;
+
+/**
+ * Sets the idle work scheduler for all isolates.
+ */
+DART_EXPORT void DartEngine_SetIdleScheduler(
+    DartEngine_IdleScheduler scheduler);
+
+/**
+ * Performs idle work for an isolate until |deadline|: scavenging, incremental
+ * marking slices, finalizing concurrent marking and compaction, as time
+ * permits.
+ *
+ * |deadline| is measured in microseconds against the system's monotonic time.
+ * This clock can be accessed via Dart_TimelineGetMicros().
+ *
+ * Never waits for the isolate: if another thread has it acquired (e.g., it is
+ * handling a message), nothing is done.
+ *
+ * \return true if idle work was performed, false if the isolate was busy.
+ */
+DART_EXPORT bool DartEngine_HandleIdle(Dart_Isolate isolate, int64_t deadline);
+
 /**
  * Loads \ref DartEngine_SnapshotData from file
  *
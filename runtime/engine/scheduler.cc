@@ -0,0 +1,134 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "engine/scheduler.h"
+#include "bin/platform.h"
+#include "engine/engine.h"
+#include "include/dart_api.h"
+#include "include/dart_tools_api.h"
+#include "platform/lockers.h"
+
+namespace dart {
+namespace engine {
+
+using platform::MonitorLocker;
+
+Scheduler::Scheduler(intptr_t thread_count, int64_t time_slice_micros)
+    : time_slice_micros_(time_slice_micros > 0 ? time_slice_micros
+                                               : kDefaultTimeSliceMicros) {
+  if (thread_count <= 0) {
+    thread_count = bin::Platform::NumberOfProcessors();
+    if (thread_count <= 0) {
+      thread_count = 1;
+    }
+  }
+  MonitorLocker ml(&monitor_);
+  for (intptr_t i = 0; i < thread_count; i++) {
+    workers_.emplace_back(std::make_unique<Worker>());
+  }
+  for (intptr_t i = 0; i < thread_count; i++) {
+    workers_[i]->thread = std::thread(&Scheduler::Run, this, i);
+  }
+}
+
+Scheduler::~Scheduler() {
+  Stop();
+}
+
+void Scheduler::Stop() {
+  {
+    MonitorLocker ml(&monitor_);
+    if (stopping_) {
+      return;
+    }
+    stopping_ = true;
+    ml.NotifyAll();
+  }
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void Scheduler::ScheduleCallback(Dart_Isolate isolate, void* context) {
+  reinterpret_cast<Scheduler*>(context)->Notify(isolate);
+}
+
+void Scheduler::Notify(Dart_Isolate isolate) {
+  // Called with a port map lock held, so this must not wait for the isolate.
+  MonitorLocker ml(&monitor_);
+  if (stopping_) {
+    return;
+  }
+  Task& task = tasks_[isolate];
+  task.notified = true;
+  if (task.scheduled) {
+    // The worker running or about to run the isolate will handle it.
+    return;
+  }
+  task.scheduled = true;
+  if (task.worker < 0) {
+    task.worker = next_worker_;
+    next_worker_ = (next_worker_ + 1) % workers_.size();
+  }
+  workers_[task.worker]->queue.push_back(isolate);
+  if (idle_workers_ > 0) {
+    // Wakes some idle worker, which steals the isolate if it is not on its
+    // own queue.
+    ml.Notify();
+  }
+}
+
+Dart_Isolate Scheduler::TakeLocked(intptr_t index) {
+  std::deque<Dart_Isolate>& own = workers_[index]->queue;
+  if (!own.empty()) {
+    Dart_Isolate isolate = own.front();
+    own.pop_front();
+    return isolate;
+  }
+  const intptr_t count = workers_.size();
+  for (intptr_t i = 1; i < count; i++) {
+    std::deque<Dart_Isolate>& other = workers_[(index + i) % count]->queue;
+    if (!other.empty()) {
+      Dart_Isolate isolate = other.back();
+      other.pop_back();
+      return isolate;
+    }
+  }
+  return nullptr;
+}
+
+void Scheduler::Run(intptr_t index) {
+  monitor_.Enter();
+  while (!stopping_) {
+    Dart_Isolate isolate = TakeLocked(index);
+    if (isolate == nullptr) {
+      idle_workers_++;
+      monitor_.Wait(Monitor::kNoTimeout);
+      idle_workers_--;
+      continue;
+    }
+
+    // References to elements of tasks_ stay valid when it grows.
+    Task& task = tasks_[isolate];
+    task.worker = index;
+    task.notified = false;
+    monitor_.Exit();
+    const bool has_more_messages = Engine::instance()->HandleMessages(
+        isolate, kIntptrMax, Dart_TimelineGetMicros() + time_slice_micros_);
+    monitor_.Enter();
+
+    if (has_more_messages || task.notified) {
+      workers_[index]->queue.push_back(isolate);
+      if (idle_workers_ > 0) {
+        monitor_.Notify();
+      }
+    } else {
+      task.scheduled = false;
+    }
+  }
+  monitor_.Exit();
+}
+
+}  // namespace engine
+}  // namespace dart
@@ -0,0 +1,87 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_ENGINE_SCHEDULER_H_
+#define RUNTIME_ENGINE_SCHEDULER_H_
+
+#include <deque>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "include/dart_engine.h"
+#include "platform/synchronization.h"
+
+namespace dart {
+namespace engine {
+
+// Built-in message scheduler, which handles the messages of many isolates on
+// a fixed number of worker threads.
+//
+// Each worker has its own run queue of isolates with pending messages. An
+// isolate is queued at most once, on the worker which last ran it, so that
+// its messages keep being handled on the same thread. Idle workers steal
+// isolates from the back of the other workers' queues.
+//
+// A worker handles the pending messages of an isolate in one batch until the
+// time slice runs out, and then moves the isolate to the back of its queue,
+// so that busy isolates can't starve the others.
+class Scheduler {
+ public:
+  static constexpr int64_t kDefaultTimeSliceMicros = 1000;
+
+  // Starts |thread_count| workers, or one per processor if it is 0.
+  Scheduler(intptr_t thread_count, int64_t time_slice_micros);
+
+  // Stops the workers, dropping the messages which have not been handled.
+  ~Scheduler();
+
+  // Scheduler to pass to DartEngine_Set(Default)MessageScheduler.
+  DartEngine_MessageScheduler message_scheduler() {
+    return {&Scheduler::ScheduleCallback, this};
+  }
+
+  // Waits for the running turns to finish and stops the workers.
+  void Stop();
+
+ private:
+  // Scheduler's state of an isolate. Guarded by monitor_.
+  struct Task {
+    // Whether a message was posted since the isolate was last taken to run.
+    bool notified = false;
+    // Index of the worker which last ran the isolate, or -1.
+    intptr_t worker = -1;
+    // Whether the isolate is in a run queue or being run by a worker.
+    bool scheduled = false;
+  };
+
+  struct Worker {
+    std::deque<Dart_Isolate> queue;
+    std::thread thread;
+  };
+
+  static void ScheduleCallback(Dart_Isolate isolate, void* context);
+
+  void Notify(Dart_Isolate isolate);
+  void Run(intptr_t index);
+
+  // Takes the next isolate for worker |index|, or returns nullptr.
+  Dart_Isolate TakeLocked(intptr_t index);
+
+  const int64_t time_slice_micros_;
+
+  Monitor monitor_;
+  bool stopping_ = false;
+  intptr_t idle_workers_ = 0;
+  // Where isolates which did not run yet are queued, to spread them.
+  intptr_t next_worker_ = 0;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::unordered_map<Dart_Isolate, Task> tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(Scheduler);
+};
+
+}  // namespace engine
+}  // namespace dart
+#endif  // RUNTIME_ENGINE_SCHEDULER_H_
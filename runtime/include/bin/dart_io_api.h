@@ -38,6 +38,20 @@ void SetExecutableName(const char* executable_name);
 // Set the arguments used by Platform.executableArguments.
 void SetExecutableArguments(int script_index, char** argv);
 
+// Kinds of requests served by separate thread pools of the IO service, so
+// that slow requests of one kind do not delay the others.
+enum IOServiceLane {
+  kIOServiceFileLane = 0,          // File and directory metadata operations.
+  kIOServiceLookupLane = 1,        // Host lookups and interface listing.
+  kIOServiceSecureSocketLane = 2,  // TLS processing of secure sockets.
+  kIOServiceFileDataLane = 3,      // Reading, writing and copying files.
+  kIOServiceNumLanes = 4,
+};
+
+// Sets the maximum number of threads serving the requests of 'lane'. This
+// only affects isolates which have not yet used the lane. The default is 32.
+void SetIOServiceConcurrency(IOServiceLane lane, intptr_t max_concurrency);
+
 // Set dart:io implementation specific fields of Dart_EmbedderInformation.
 void GetIOEmbedderInformation(Dart_EmbedderInformation* info);
 
@@ -974,6 +974,23 @@ DART_EXPORT DART_API_WARN_UNUSED_RESULT char* Dart_Initialize(
  */
 DART_EXPORT DART_API_WARN_UNUSED_RESULT char* Dart_Cleanup(void);
 
+/**
+ * Prepares the VM for process termination without Dart_Cleanup.
+ *
+ * Writes out the output the VM would produce during Dart_Cleanup, such as a
+ * recorded timeline, and prevents the creation of new isolates. Running
+ * isolates are not shut down and no memory is freed. Afterwards the embedder
+ * is expected to terminate the process without running the destructors of
+ * globals, e.g. with _exit, and must not call Dart_Cleanup.
+ *
+ * \return NULL if successful. Returns an error message otherwise.
+ *   The caller is responsible for freeing the error message.
+ *
+ * NOTE: This function must not be called on a thread that was created by the VM
+ * itself.
+ */
+DART_EXPORT DART_API_WARN_UNUSED_RESULT char* Dart_PrepareToExit(void);
+
 /**
  * Sets command line flags. Should be called before Dart_Initialize.
  *
@@ -2702,7 +2719,10 @@ DART_EXPORT Dart_Handle Dart_NewByteBuffer(Dart_Handle typed_data);
  * Notes:
  *   When the internal address of the object is acquired any calls to a
  *   Dart API function that could potentially allocate an object or run
- *   any Dart code will return an error.
+ *   any Dart code will return an error. This does not apply to external
+ *   typed data and views on it, whose data is not in the Dart heap: acquiring
+ *   them does not prevent garbage collection, so natives can use their data
+ *   for long operations.
  *
  *   Any Dart API functions for accessing the data should not be called
  *   before the corresponding release. In particular, the object should
@@ -2839,6 +2859,29 @@ Dart_InvokeClosure(Dart_Handle closure,
                    int number_of_arguments,
                    Dart_Handle* arguments);
 
+/**
+ * Resolves a function or method once, for callers which invoke it many
+ * times.
+ *
+ * Looks up |name| in |target| like \ref Dart_Invoke and returns a closure
+ * which calls it, e.g. a tear-off of a method bound to the receiver. Passing
+ * the closure to \ref Dart_InvokeClosure skips the lookup by name on each
+ * call. The closure can be kept in a persistent handle.
+ *
+ * This function ignores visibility (leading underscores in names).
+ *
+ * \param target An object, type, or library.
+ * \param name The name of the function or method.
+ * \param number_of_arguments The number of arguments it will be invoked with.
+ *
+ * \return A closure accepting |number_of_arguments| positional arguments, or
+ *   an error handle if there is no such function or method.
+ */
+DART_EXPORT DART_API_WARN_UNUSED_RESULT Dart_Handle
+Dart_PrepareInvoke(Dart_Handle target,
+                   Dart_Handle name,
+                   int number_of_arguments);
+
 /**
  * Invokes a Generative Constructor on an object that was previously
  * allocated using Dart_Allocate/Dart_AllocateWithNativeFields.
@@ -136,6 +136,26 @@ DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message);
  */
 DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message);
 
+/**
+ * Sets how messages posted to some port are queued by its receiver.
+ *
+ * Messages to a control port are handled before the other messages queued
+ * for the receiving isolate or native port, in the order they were posted.
+ * A message posted to a coalescing port replaces any messages to that port
+ * which have not been handled yet, so only the latest state is delivered.
+ *
+ * Out-of-band messages are not affected.
+ *
+ * \param port_id The port, e.g. of a ReceivePort or native port.
+ * \param control Whether messages to the port are handled first.
+ * \param coalescing Whether messages to the port replace pending ones.
+ *
+ * \return True if the port exists.
+ */
+DART_EXPORT bool Dart_SetPortLane(Dart_Port port_id,
+                                  bool control,
+                                  bool coalescing);
+
 /**
  * A native message handler.
  *
@@ -505,6 +505,82 @@ typedef void (*Dart_TimelineRecorderCallback)(
 DART_EXPORT void Dart_SetTimelineRecorderCallback(
     Dart_TimelineRecorderCallback callback);
 
+/*
+ * ==================
+ * CPU Profile Export
+ * ==================
+ */
+
+/**
+ * Callback provided by the embedder to receive aggregated CPU profiles.
+ *
+ * \param context The context passed to `Dart_SetCpuProfileExportCallback`.
+ *
+ * \param buffer A profile in the pprof format (an uncompressed `Profile`
+ *   message of profile.proto), covering the samples of all isolates since the
+ *   previous export. The VM keeps ownership of the buffer, which is only valid
+ *   for the duration of the callback.
+ *
+ * \param size Number of bytes in the `buffer`.
+ */
+typedef void (*Dart_CpuProfileExportCallback)(void* context,
+                                              const uint8_t* buffer,
+                                              intptr_t size);
+
+/**
+ * Register a `Dart_CpuProfileExportCallback` to be called every
+ * `period_micros` with the CPU samples taken since the previous call. The
+ * samples are aggregated into a call tree in the background, so memory usage
+ * is bounded by the VM flag `profile_export_max_nodes` rather than by the
+ * export period. Exporting does not require the service isolate.
+ *
+ * The callback will be invoked without a current isolate on a thread owned by
+ * the VM, and a last time from `Dart_Cleanup`.
+ *
+ * Samples are consumed by the export, so they are no longer available through
+ * the VM service. The VM flag `profiler` must be set for samples to be taken.
+ *
+ * Must be called after `Dart_Initialize`. Providing a NULL callback will clear
+ * the registration and discard the samples that were not yet exported.
+ */
+DART_EXPORT void Dart_SetCpuProfileExportCallback(
+    Dart_CpuProfileExportCallback callback,
+    void* context,
+    int64_t period_micros);
+
+/*
+ * =============
+ * Code Coverage
+ * =============
+ */
+
+/**
+ * Writes the code coverage recorded by the current isolate group.
+ *
+ * Coverage is only recorded by precompiled code which was compiled with the
+ * gen_snapshot flag `--aot_coverage`. Such code records the entry of each
+ * function and each block of code outside of the `dart:` libraries.
+ *
+ * The coverage is encoded as JSON in the following format, where positions
+ * are source offsets in the script:
+ *
+ *   {"type":"CodeCoverage","scripts":[
+ *     {"uri":"package:a/a.dart","hits":[12,40],"misses":[77]}, ...]}
+ *
+ * Functions which were removed by the compiler are not listed.
+ *
+ * \param reset Whether to clear the coverage after writing it, so the next
+ *   call only reports what was executed since this call.
+ * \param buffer Receives the JSON, which is valid until the current API scope
+ *   is exited.
+ * \param buffer_length Receives the length of the JSON.
+ *
+ * \return Returns an error handle if the code of the isolate group does not
+ *   record coverage.
+ */
+DART_EXPORT DART_API_WARN_UNUSED_RESULT Dart_Handle
+Dart_WriteCodeCoverage(bool reset, uint8_t** buffer, intptr_t* buffer_length);
+
 /*
  * =======
  * Metrics
@@ -526,6 +602,24 @@ DART_EXPORT int64_t
 Dart_IsolateGroupHeapNewCapacityMetric(Dart_IsolateGroup group);  // Byte
 DART_EXPORT int64_t
 Dart_IsolateGroupHeapNewExternalMetric(Dart_IsolateGroup group);  // Byte
+DART_EXPORT int64_t
+Dart_IsolateGroupHeapNewAllocatedMetric(Dart_IsolateGroup group);  // Byte
+DART_EXPORT int64_t
+Dart_IsolateGroupHeapOldAllocatedMetric(Dart_IsolateGroup group);  // Byte
+DART_EXPORT int64_t
+Dart_IsolateGroupHeapCodeCapacityMetric(Dart_IsolateGroup group);  // Byte
+DART_EXPORT int64_t
+Dart_IsolateGroupGCNewTimeMetric(Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t
+Dart_IsolateGroupGCOldTimeMetric(Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t Dart_IsolateGroupSafepointTimeP99Metric(
+    Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t
+Dart_IsolateGroupMessageQueueLengthMetric(Dart_IsolateGroup group);  // Counter
+DART_EXPORT int64_t
+Dart_IsolateGroupMessageQueueAgeMetric(Dart_IsolateGroup group);  // Microsecond
+DART_EXPORT int64_t
+Dart_IsolateGroupCompilerQueueLengthMetric(Dart_IsolateGroup group);  // Counter
 
 /*
  * ========
@@ -624,4 +718,35 @@ DART_EXPORT char* Dart_WriteHeapSnapshot(
     Dart_HeapSnapshotWriteChunkCallback write,
     void* context);
 
+/**
+ * Like `Dart_WriteHeapSnapshot`, but the snapshot is generated by a forked
+ * copy-on-write child process. The isolate group is only paused while the
+ * process is forked, so this is suitable for taking snapshots of large heaps
+ * in production.
+ *
+ * The `write` callback is invoked in the child process only, which exits
+ * after the last chunk has been written. The callback should therefore write
+ * to a file descriptor or socket, and may compress the chunks. The embedder
+ * is responsible for reaping the child process (e.g. with `waitpid`).
+ *
+ * Pages written by the parent while the child is running are copied, so in
+ * the worst case memory usage doubles for the duration of the snapshot.
+ *
+ * Only supported on Linux, Android and macOS.
+ *
+ * \param write Callback used to write chunks of the heap snapshot.
+ *
+ * \param context Opaque context which would be passed on each invocation of
+ *   `write` callback.
+ *
+ * \param child_pid Set to the process id of the child process on success.
+ *
+ * \returns `nullptr` if the child process was created otherwise error
+ *   message. Caller owns error message string and needs to `free` it.
+ */
+DART_EXPORT char* Dart_WriteHeapSnapshotInChildProcess(
+    Dart_HeapSnapshotWriteChunkCallback write,
+    void* context,
+    int64_t* child_pid);
+
 #endif  // RUNTIME_INCLUDE_DART_TOOLS_API_H_
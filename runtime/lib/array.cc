@@ -54,6 +54,30 @@ DEFINE_NATIVE_ENTRY(List_slice, 0, 4) {
   return src.Slice(istart, icount, needs_type_arg.value());
 }
 
+static ArrayPtr BackingArray(const Instance& list) {
+  if (list.IsGrowableObjectArray()) {
+    return GrowableObjectArray::Cast(list).data();
+  }
+  return Array::Cast(list).ptr();
+}
+
+// Private, expects correct arguments: |src| and |dst| are VM lists holding
+// the given ranges and |dst| is not immutable.
+DEFINE_NATIVE_ENTRY(List_copyRange, 0, 5) {
+  const Instance& src =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(0));
+  const Smi& src_start = Smi::CheckedHandle(zone, arguments->NativeArgAt(1));
+  const Instance& dst =
+      Instance::CheckedHandle(zone, arguments->NativeArgAt(2));
+  const Smi& dst_start = Smi::CheckedHandle(zone, arguments->NativeArgAt(3));
+  const Smi& count = Smi::CheckedHandle(zone, arguments->NativeArgAt(4));
+  const Array& src_array = Array::Handle(zone, BackingArray(src));
+  const Array& dst_array = Array::Handle(zone, BackingArray(dst));
+  dst_array.CopyFrom(dst_start.Value(), src_array, src_start.Value(),
+                     count.Value());
+  return Object::null();
+}
+
 // Private factory, expects correct arguments.
 DEFINE_NATIVE_ENTRY(ImmutableList_from, 0, 4) {
   // Ignore first argument of this factory (type argument).
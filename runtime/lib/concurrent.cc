@@ -2,6 +2,8 @@
 // for details. All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 
+#include <atomic>
+
 #include "include/dart_api.h"
 #include "vm/bootstrap_natives.h"
 #include "vm/os_thread.h"
@@ -25,23 +27,20 @@ DEFINE_FFI_NATIVE_ENTRY(Mutex_Initialize, void, (Dart_Handle mutex_handle)) {
   Dart_NewFinalizableHandle(mutex_handle, mutex, sizeof(Mutex), DeleteMutex);
 };
 
-DEFINE_FFI_NATIVE_ENTRY(Mutex_RunLocked,
-                        Dart_Handle,
-                        (Dart_Handle mutex_handle,
-                         Dart_Handle closure_handle)) {
-  Mutex* mutex;
-  Dart_Handle result = Dart_GetNativeInstanceField(
-      mutex_handle, kMutexNativeField, reinterpret_cast<intptr_t*>(&mutex));
-  if (Dart_IsError(result)) {
-    Dart_PropagateError(result);
-  }
-  mutex->Lock();
-  result = Dart_InvokeClosure(closure_handle, 0, nullptr);
-  mutex->Unlock();
-  if (Dart_IsError(result)) {
-    Dart_PropagateError(result);
-  }
-  return result;
+// The natives below receive the native field of the Dart mutex. TryLock and
+// Unlock are leaf calls which never block. Lock may wait for another thread
+// and is therefore called with a transition out of the VM, so that the waiting
+// thread does not hold up safepoint operations.
+DEFINE_FFI_NATIVE_ENTRY(Mutex_TryLock, bool, (void* mutex)) {
+  return reinterpret_cast<Mutex*>(mutex)->TryLock();
+}
+
+DEFINE_FFI_NATIVE_ENTRY(Mutex_Lock, void, (void* mutex)) {
+  reinterpret_cast<Mutex*>(mutex)->Lock();
+}
+
+DEFINE_FFI_NATIVE_ENTRY(Mutex_Unlock, void, (void* mutex)) {
+  reinterpret_cast<Mutex*>(mutex)->Unlock();
 }
 
 static void DeleteConditionVariable(void* isolate_data, void* condvar_pointer) {
@@ -110,4 +109,39 @@ DEFINE_FFI_NATIVE_ENTRY(ConditionVariable_NotifyAll,
   condvar->NotifyAll();
 }
 
+static std::atomic<int64_t>* Int64ElementAt(int64_t* data, intptr_t index) {
+  static_assert(sizeof(std::atomic<int64_t>) == sizeof(int64_t));
+  return reinterpret_cast<std::atomic<int64_t>*>(&data[index]);
+}
+
+// The Int64ListAtomics natives are leaf calls which receive the data of the
+// list, with the index already checked by the caller.
+DEFINE_FFI_NATIVE_ENTRY(Int64ListAtomics_CompareExchange,
+                        int64_t,
+                        (int64_t* data,
+                         intptr_t index,
+                         int64_t expected,
+                         int64_t desired)) {
+  Int64ElementAt(data, index)->compare_exchange_strong(expected, desired);
+  return expected;
+}
+
+DEFINE_FFI_NATIVE_ENTRY(Int64ListAtomics_FetchAdd,
+                        int64_t,
+                        (int64_t* data, intptr_t index, int64_t delta)) {
+  return Int64ElementAt(data, index)->fetch_add(delta);
+}
+
+DEFINE_FFI_NATIVE_ENTRY(Int64ListAtomics_LoadAcquire,
+                        int64_t,
+                        (int64_t* data, intptr_t index)) {
+  return Int64ElementAt(data, index)->load(std::memory_order_acquire);
+}
+
+DEFINE_FFI_NATIVE_ENTRY(Int64ListAtomics_StoreRelease,
+                        void,
+                        (int64_t* data, intptr_t index, int64_t value)) {
+  Int64ElementAt(data, index)->store(value, std::memory_order_release);
+}
+
 }  // namespace dart
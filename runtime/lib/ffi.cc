@@ -36,6 +36,12 @@ DEFINE_NATIVE_ENTRY(Ffi_createNativeCallableListener, 1, 2) {
       isolate->CreateAsyncFfiCallback(zone, send_function, port.Id()));
 }
 
+DEFINE_NATIVE_ENTRY(Ffi_takeNativeCallableListenerBatch, 0, 1) {
+  const auto& port =
+      ReceivePort::CheckedHandle(zone, arguments->NativeArgAt(0));
+  return isolate->group()->TakeFfiAsyncCallbackBatch(port.Id());
+}
+
 DEFINE_NATIVE_ENTRY(Ffi_createNativeCallableIsolateLocal, 1, 3) {
   const auto& trampoline =
       Function::CheckedHandle(zone, arguments->NativeArg0());
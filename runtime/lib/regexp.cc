@@ -4,14 +4,13 @@
 
 #include "platform/assert.h"
 #include "vm/bootstrap_natives.h"
-#include "vm/canonical_tables.h"
+#include "vm/dart_entry.h"
 #include "vm/exceptions.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
-#include "vm/object_store.h"
+#include "vm/regexp/regexp.h"
 #include "vm/regexp/regexp_assembler_bytecode.h"
 #include "vm/regexp/regexp_parser.h"
-#include "vm/reusable_handles.h"
 #include "vm/symbols.h"
 #include "vm/thread.h"
 
@@ -38,22 +37,10 @@ DEFINE_NATIVE_ENTRY(RegExp_factory, 0, 6) {
   if (unicode) flags.SetUnicode();
   if (dot_all) flags.SetDotAll();
 
-  RegExpKey lookup_key(pattern, flags);
-  RegExp& regexp = RegExp::Handle(thread->zone());
-  {
-    REUSABLE_OBJECT_HANDLESCOPE(thread);
-    REUSABLE_SMI_HANDLESCOPE(thread);
-    REUSABLE_WEAK_ARRAY_HANDLESCOPE(thread);
-    Object& key = thread->ObjectHandle();
-    Smi& value = thread->SmiHandle();
-    WeakArray& data = thread->WeakArrayHandle();
-    data = thread->isolate_group()->object_store()->regexp_table();
-    CanonicalRegExpSet table(&key, &value, &data);
-    regexp ^= table.GetOrNull(lookup_key);
-    table.Release();
-    if (!regexp.IsNull()) {
-      return regexp.ptr();
-    }
+  RegExp& regexp = RegExp::Handle(
+      thread->zone(), RegExpEngine::LookupCanonical(thread, pattern, flags));
+  if (!regexp.IsNull()) {
+    return regexp.ptr();
   }
 
   // Parse the pattern once in order to throw any format exceptions within
@@ -62,17 +49,7 @@ DEFINE_NATIVE_ENTRY(RegExp_factory, 0, 6) {
   // Throws an exception on parsing failure.
   RegExpParser::ParseRegExp(pattern, flags, &compileData);
 
-  {
-    RegExpKey lookup_symbol_key(String::Handle(Symbols::New(thread, pattern)),
-                                flags);
-    SafepointMutexLocker ml(thread->isolate_group()->symbols_mutex());
-    CanonicalRegExpSet table(
-        thread->zone(),
-        thread->isolate_group()->object_store()->regexp_table());
-    regexp ^= table.InsertNewOrGet(lookup_symbol_key);
-    thread->isolate_group()->object_store()->set_regexp_table(table.Release());
-  }
-
+  regexp = RegExpEngine::InsertCanonical(thread, pattern, flags);
   ASSERT(regexp.flags() == flags);
   return regexp.ptr();
 }
@@ -165,6 +142,25 @@ static ObjectPtr ExecuteMatch(Zone* zone,
     return IRRegExpMacroAssembler::Execute(regexp, subject, start_index,
                                            /*sticky=*/sticky, zone);
   }
+#else
+  // Regexps created from constant patterns may have been compiled to native
+  // code by the precompiler (see --precompile_regexps), the others are
+  // interpreted.
+  const Object& specialization =
+      Object::Handle(zone, regexp.function(subject.GetClassId(), sticky));
+  if (specialization.IsFunction()) {
+    const Array& args =
+        Array::Handle(zone, Array::New(RegExpMacroAssembler::kParamCount));
+    args.SetAt(RegExpMacroAssembler::kParamRegExpIndex, regexp);
+    args.SetAt(RegExpMacroAssembler::kParamStringIndex, subject);
+    args.SetAt(RegExpMacroAssembler::kParamStartOffsetIndex, start_index);
+    const Object& result = Object::Handle(
+        zone, DartEntry::InvokeFunction(Function::Cast(specialization), args));
+    if (result.IsError()) {
+      Exceptions::PropagateError(Error::Cast(result));
+    }
+    return result.ptr();
+  }
 #endif
   return BytecodeRegExpMacroAssembler::Interpret(regexp, subject, start_index,
                                                  /*sticky=*/sticky, zone);
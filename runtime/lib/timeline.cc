@@ -49,6 +49,14 @@ DEFINE_NATIVE_ENTRY(Timeline_reportTaskEvent, 0, 5) {
     return Object::null();
   }
 
+  // Begin and end events have the id of their task and are sampled together.
+  // Instant events have no id of their own.
+  const int64_t sample_id =
+      (id.Value() != 0) ? id.Value() : thread->GetNextTaskId();
+  if (!Timeline::GetDartStream()->Sample(sample_id)) {
+    return Object::null();
+  }
+
   TimelineEvent* event = Timeline::GetDartStream()->StartEvent();
   if (event == nullptr) {
     // Stream was turned off.
@@ -34,11 +34,15 @@ DEFINE_NATIVE_ENTRY(TypedDataView_typedData, 0, 1) {
   return TypedDataView::Cast(instance).typed_data();
 }
 
+static intptr_t InternalTypedDataClassId(intptr_t cid) {
+  ASSERT(IsTypedDataBaseClassId(cid));
+  return cid - ((cid - kFirstTypedDataCid) % kNumTypedDataCidRemainders) +
+         kTypedDataCidRemainderInternal;
+}
+
 static bool IsTypedDataUint8ArrayClassId(intptr_t cid) {
   if (!IsTypedDataBaseClassId(cid)) return false;
-  const intptr_t internal_cid =
-      cid - ((cid - kFirstTypedDataCid) % kNumTypedDataCidRemainders) +
-      kTypedDataCidRemainderInternal;
+  const intptr_t internal_cid = InternalTypedDataClassId(cid);
   return internal_cid == kTypedDataUint8ArrayCid ||
          internal_cid == kTypedDataUint8ClampedArrayCid;
 }
@@ -107,6 +111,66 @@ DEFINE_NATIVE_ENTRY(TypedDataBase_setClampedRange, 0, 5) {
   return Object::null();
 }
 
+DEFINE_NATIVE_ENTRY(TypedDataBase_fillBytes, 0, 4) {
+  // This is called after bounds checking with a non-empty range of a list
+  // with one byte elements. Returns false if the list is unmodifiable, so
+  // the caller throws.
+  const TypedDataBase& dst =
+      TypedDataBase::CheckedHandle(zone, arguments->NativeArgAt(0));
+  const Smi& start = Smi::CheckedHandle(zone, arguments->NativeArgAt(1));
+  const Smi& count = Smi::CheckedHandle(zone, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, value, arguments->NativeArgAt(3));
+
+  const intptr_t cid = dst.ptr()->GetClassId();
+  ASSERT_EQUAL(dst.ElementSizeInBytes(), 1);
+  ASSERT(start.Value() >= 0);
+  ASSERT(count.Value() > 0);
+  ASSERT(count.Value() <= dst.Length() - start.Value());
+  if (IsUnmodifiableTypedDataViewClassId(cid)) {
+    return Bool::False().ptr();
+  }
+
+  int64_t byte = value.Value();
+  if (IsClampedTypedDataBaseClassId(cid)) {
+    byte = Utils::Minimum<int64_t>(Utils::Maximum<int64_t>(byte, 0), 0xFF);
+  }
+  NoSafepointScope no_safepoint;
+  memset(dst.DataAddr(start.Value()), static_cast<uint8_t>(byte),
+         count.Value());
+  return Bool::True().ptr();
+}
+
+DEFINE_NATIVE_ENTRY(TypedDataBase_indexOfByte, 0, 3) {
+  // This is called with a start within the bounds of a list with one byte
+  // elements.
+  const TypedDataBase& list =
+      TypedDataBase::CheckedHandle(zone, arguments->NativeArgAt(0));
+  GET_NON_NULL_NATIVE_ARGUMENT(Integer, element, arguments->NativeArgAt(1));
+  const Smi& start = Smi::CheckedHandle(zone, arguments->NativeArgAt(2));
+
+  ASSERT_EQUAL(list.ElementSizeInBytes(), 1);
+  ASSERT((start.Value() >= 0) && (start.Value() < list.Length()));
+  const int64_t value = element.Value();
+  const bool is_signed = InternalTypedDataClassId(list.ptr()->GetClassId()) ==
+                         kTypedDataInt8ArrayCid;
+  const int64_t min = is_signed ? kMinInt8 : 0;
+  const int64_t max = is_signed ? kMaxInt8 : kMaxUint8;
+  if ((value < min) || (value > max)) {
+    return Smi::New(-1);
+  }
+
+  NoSafepointScope no_safepoint;
+  const uint8_t* data =
+      reinterpret_cast<const uint8_t*>(list.DataAddr(start.Value()));
+  const void* found =
+      memchr(data, static_cast<uint8_t>(value), list.Length() - start.Value());
+  if (found == nullptr) {
+    return Smi::New(-1);
+  }
+  return Smi::New(start.Value() +
+                  (reinterpret_cast<const uint8_t*>(found) - data));
+}
+
 // The native getter and setter functions defined here are only called if
 // unboxing doubles or SIMD values is not supported by the flow graph compiler,
 // and the provided offsets have already been range checked by the calling code.
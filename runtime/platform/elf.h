@@ -186,6 +186,9 @@ static constexpr intptr_t PF_R = 4;
 static constexpr intptr_t SHF_WRITE = 0x1;
 static constexpr intptr_t SHF_ALLOC = 0x2;
 static constexpr intptr_t SHF_EXECINSTR = 0x4;
+static constexpr intptr_t SHF_COMPRESSED = 0x800;
+
+static constexpr intptr_t ELFCOMPRESS_ZLIB = 1;
 
 static constexpr intptr_t SHN_UNDEF = 0;
 
@@ -7,9 +7,28 @@
 #include "platform/allocation.h"
 #include "platform/globals.h"
 #include "platform/syslog.h"
+#include "platform/unaligned.h"
+#include "platform/utils.h"
 
 namespace dart {
 
+// Returns the number of ASCII bytes at the start of 'utf8_array', checking a
+// word at a time. Most text handled by the VM is ASCII.
+static intptr_t AsciiPrefixLength(const uint8_t* utf8_array,
+                                  intptr_t array_len) {
+  constexpr uword kHighBits = static_cast<uword>(0x8080808080808080ULL);
+  intptr_t i = 0;
+  for (; i + kWordSize <= array_len; i += kWordSize) {
+    const uword word = LoadUnaligned(reinterpret_cast<const uword*>(
+        utf8_array + i));
+    if ((word & kHighBits) != 0) break;
+  }
+  while ((i < array_len) && (utf8_array[i] <= Utf8::kMaxOneByteChar)) {
+    i++;
+  }
+  return i;
+}
+
 // clang-format off
 const int8_t Utf8::kTrailBytes[256] = {
   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
@@ -46,9 +65,9 @@ const uint32_t Utf8::kOverlongMinimum[7] = {0,  // Padding.
 intptr_t Utf8::CodeUnitCount(const uint8_t* utf8_array,
                              intptr_t array_len,
                              Type* type) {
-  intptr_t len = 0;
+  intptr_t len = AsciiPrefixLength(utf8_array, array_len);
   Type char_type = kLatin1;
-  for (intptr_t i = 0; i < array_len; i++) {
+  for (intptr_t i = len; i < array_len; i++) {
     uint8_t code_unit = utf8_array[i];
     if (!IsTrailByte(code_unit)) {
       ++len;
@@ -68,7 +87,7 @@ intptr_t Utf8::CodeUnitCount(const uint8_t* utf8_array,
 
 // Returns true if str is a valid NUL-terminated UTF-8 string.
 bool Utf8::IsValid(const uint8_t* utf8_array, intptr_t array_len) {
-  intptr_t i = 0;
+  intptr_t i = AsciiPrefixLength(utf8_array, array_len);
   while (i < array_len) {
     uint32_t ch = utf8_array[i] & 0xFF;
     intptr_t j = 1;
@@ -195,8 +214,9 @@ bool Utf8::DecodeToLatin1(const uint8_t* utf8_array,
                           intptr_t array_len,
                           uint8_t* dst,
                           intptr_t len) {
-  intptr_t i = 0;
-  intptr_t j = 0;
+  intptr_t i = Utils::Minimum(AsciiPrefixLength(utf8_array, array_len), len);
+  memmove(dst, utf8_array, i);
+  intptr_t j = i;
   intptr_t num_bytes;
   for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
     int32_t ch;
@@ -218,8 +238,11 @@ bool Utf8::DecodeToUTF16(const uint8_t* utf8_array,
                          intptr_t array_len,
                          uint16_t* dst,
                          intptr_t len) {
-  intptr_t i = 0;
-  intptr_t j = 0;
+  intptr_t i = Utils::Minimum(AsciiPrefixLength(utf8_array, array_len), len);
+  for (intptr_t k = 0; k < i; k++) {
+    dst[k] = utf8_array[k];
+  }
+  intptr_t j = i;
   intptr_t num_bytes;
   for (; (i < array_len) && (j < len); i += num_bytes, ++j) {
     int32_t ch;
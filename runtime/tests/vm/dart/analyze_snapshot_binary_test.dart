@@ -172,9 +172,24 @@ Future<void> testAOT(String dillPath,
 
     Expect.isTrue(analyzerJson['metadata'].containsKey('analyzer_version'),
         'snapshot analyzer version must be reported');
-    Expect.isTrue(analyzerJson['metadata']['analyzer_version'] == 2,
+    Expect.isTrue(analyzerJson['metadata']['analyzer_version'] == 3,
         'invalid snapshot analyzer version');
 
+    // Test size attribution.
+    final clusters = analyzerJson['deserialization']['clusters'] as List;
+    Expect.isNotEmpty(clusters);
+    for (final cluster in clusters) {
+      Expect.isTrue(cluster['alloc_size'] + cluster['fill_size'] > 0);
+    }
+    final librarySizes = analyzerJson['library_sizes'] as List;
+    Expect.isTrue(
+        librarySizes.any((l) => l['url'] == 'dart:core' && l['data_size'] > 0));
+    final topConstants = analyzerJson['top_constants'] as List;
+    Expect.isNotEmpty(topConstants);
+    for (var i = 1; i < topConstants.length; i++) {
+      Expect.isTrue(topConstants[i - 1]['size'] >= topConstants[i]['size']);
+    }
+
   });
 }
 
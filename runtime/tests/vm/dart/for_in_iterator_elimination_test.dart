@@ -0,0 +1,114 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies that for-in loops over lists, sets and maps, whose iterators are
+// inlined and eliminated by the optimizer, still detect concurrent
+// modification and visit all elements.
+
+// VMOptions=--optimization-counter-threshold=100 --no-background-compilation
+
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+@pragma('vm:never-inline')
+int sumGrowable(List<int> list) {
+  int sum = 0;
+  for (final e in list) {
+    sum += e;
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int sumFixed(List<int> list) {
+  int sum = 0;
+  for (final e in list) {
+    sum += e;
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int sumTyped(Int32List list) {
+  int sum = 0;
+  for (final e in list) {
+    sum += e;
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int sumSet(Set<int> set) {
+  int sum = 0;
+  for (final e in set) {
+    sum += e;
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+int sumMap(Map<int, int> map) {
+  int sum = 0;
+  for (final k in map.keys) {
+    sum += k;
+  }
+  for (final v in map.values) {
+    sum += v;
+  }
+  return sum;
+}
+
+@pragma('vm:never-inline')
+void appendWhileIterating(List<int> list) {
+  for (final e in list) {
+    if (e == 2) list.add(42);
+  }
+}
+
+@pragma('vm:never-inline')
+void removeWhileIterating(List<int> list) {
+  for (final e in list) {
+    if (e == 2) list.removeLast();
+  }
+}
+
+@pragma('vm:never-inline')
+void addToSetWhileIterating(Set<int> set) {
+  for (final e in set) {
+    if (e == 2) set.add(42);
+  }
+}
+
+@pragma('vm:never-inline')
+void addToMapWhileIterating(Map<int, int> map) {
+  for (final k in map.keys) {
+    if (k == 2) map[42] = 42;
+  }
+}
+
+void main() {
+  for (int i = 0; i < 200; i++) {
+    final growable = <int>[1, 2, 3, 4];
+    Expect.equals(10, sumGrowable(growable));
+    Expect.equals(0, sumGrowable(<int>[]));
+    Expect.equals(10, sumFixed(List<int>.of(growable, growable: false)));
+    Expect.equals(10, sumTyped(Int32List.fromList(growable)));
+    Expect.equals(10, sumSet({1, 2, 3, 4}));
+    Expect.equals(20, sumMap({1: 1, 2: 2, 3: 3, 4: 4}));
+
+    Expect.throws<ConcurrentModificationError>(
+      () => appendWhileIterating(<int>[1, 2, 3]),
+    );
+    Expect.throws<ConcurrentModificationError>(
+      () => removeWhileIterating(<int>[1, 2, 3]),
+    );
+    Expect.throws<ConcurrentModificationError>(
+      () => addToSetWhileIterating({1, 2, 3}),
+    );
+    Expect.throws<ConcurrentModificationError>(
+      () => addToMapWhileIterating({1: 1, 2: 2, 3: 3}),
+    );
+  }
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that gen_snapshot --snapshot-cache-dir reuses the AOT snapshot of an
+// unchanged build, and builds a new one when an input changes.
+
+import "dart:io";
+
+import 'package:expect/config.dart';
+import 'package:expect/expect.dart';
+import 'package:path/path.dart' as path;
+
+import 'use_flag_test_helper.dart';
+
+const cacheHitMessage = 'Copied AOT snapshot from';
+
+Future<bool> buildSnapshot(
+  String dill,
+  String snapshot,
+  String cacheDir,
+) async {
+  final result = await runHelper(genSnapshot, <String>[
+    '--verbose',
+    '--snapshot-kind=app-aot-elf',
+    '--elf=$snapshot',
+    '--snapshot-cache-dir=$cacheDir',
+    dill,
+  ]);
+  Expect.equals(0, result.exitCode, result.stderr);
+  return result.stderr.contains(cacheHitMessage);
+}
+
+Future<void> compileScript(String source, String script, String dill) async {
+  File(script).writeAsStringSync(source);
+  await run(genKernel, <String>[
+    '--aot',
+    '--platform=$platformDill',
+    '-o',
+    dill,
+    script,
+  ]);
+}
+
+main(List<String> args) async {
+  if (!isVmAotConfiguration) {
+    return; // Running in JIT: AOT binaries not available.
+  }
+
+  if (Platform.isAndroid) {
+    return; // SDK tree and gen_snapshot not available on the test device.
+  }
+
+  await withTempDir('gen-snapshot-cache-test', (String tempDir) async {
+    final cacheDir = path.join(tempDir, 'cache');
+    Directory(cacheDir).createSync();
+    int cacheEntries() => Directory(cacheDir).listSync().length;
+
+    final script = path.join(tempDir, 'script.dart');
+    final dill = path.join(tempDir, 'script.dill');
+    await compileScript("main() => print('one');", script, dill);
+
+    final first = path.join(tempDir, 'first.so');
+    Expect.isFalse(await buildSnapshot(dill, first, cacheDir));
+    Expect.equals(1, cacheEntries());
+
+    final second = path.join(tempDir, 'second.so');
+    Expect.isTrue(await buildSnapshot(dill, second, cacheDir));
+    Expect.equals(1, cacheEntries());
+    Expect.listEquals(
+      File(first).readAsBytesSync(),
+      File(second).readAsBytesSync(),
+    );
+
+    await compileScript("main() => print('two');", script, dill);
+    final third = path.join(tempDir, 'third.so');
+    Expect.isFalse(await buildSnapshot(dill, third, cacheDir));
+    Expect.equals(2, cacheEntries());
+  });
+}
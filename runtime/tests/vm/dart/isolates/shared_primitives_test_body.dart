@@ -8,6 +8,7 @@ import 'dart:concurrent';
 import 'dart:ffi';
 import 'dart:io';
 import 'dart:isolate';
+import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
 import 'package:test/test.dart';
@@ -20,6 +21,9 @@ late Mutex mutexCondvar;
 @pragma('vm:shared')
 late ConditionVariable condVar;
 
+@pragma('vm:shared')
+late Int64List counters;
+
 void main() {
   group('mutex', () {
     test('simple', () {
@@ -27,6 +31,12 @@ void main() {
       expect(mutex.runLocked(() => 42), equals(42));
     });
 
+    test('throwing action releases the mutex', () {
+      final mutex = Mutex();
+      expect(() => mutex.runLocked(() => throw 'failure'), throwsA('failure'));
+      expect(mutex.runLocked(() => 'locked again'), equals('locked again'));
+    });
+
     Future<String> spawnHelperIsolate(int ptrAddress) {
       return Isolate.run(() {
         final ptr = Pointer<Uint8>.fromAddress(ptrAddress);
@@ -75,6 +85,45 @@ void main() {
     });
   });
 
+  group('atomics', () {
+    test('simple', () {
+      final list = Int64List(2);
+      expect(Int64ListAtomics.compareExchange(list, 1, 0, 5), equals(0));
+      expect(Int64ListAtomics.compareExchange(list, 1, 0, 7), equals(5));
+      expect(Int64ListAtomics.fetchAdd(list, 1, 3), equals(5));
+      Int64ListAtomics.storeRelease(list, 0, -1);
+      expect(Int64ListAtomics.loadAcquire(list, 0), equals(-1));
+      expect(Int64ListAtomics.loadAcquire(list, 1), equals(8));
+      expect(() => Int64ListAtomics.fetchAdd(list, 2, 1), throwsRangeError);
+    });
+
+    test('isolates', () async {
+      const isolateCount = 4;
+      const increments = 10000;
+      counters = Int64List(2);
+      await Future.wait([
+        for (int i = 0; i < isolateCount; i++)
+          Isolate.run(() {
+            for (int j = 0; j < increments; j++) {
+              Int64ListAtomics.fetchAdd(counters, 0, 1);
+              int value;
+              do {
+                value = Int64ListAtomics.loadAcquire(counters, 1);
+              } while (Int64ListAtomics.compareExchange(
+                    counters,
+                    1,
+                    value,
+                    value + 2,
+                  ) !=
+                  value);
+            }
+          }),
+      ]);
+      expect(counters[0], equals(isolateCount * increments));
+      expect(counters[1], equals(2 * isolateCount * increments));
+    });
+  });
+
   group('condvar', () {
     Future<String> spawnHelperIsolate(int ptrAddress) {
       return Isolate.run(() {
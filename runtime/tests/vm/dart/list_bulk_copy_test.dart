@@ -0,0 +1,54 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests copies between VM lists which are short enough to be done by a loop
+// and long enough to be done by the runtime.
+
+import 'package:expect/expect.dart';
+
+const lengths = [0, 1, 63, 64, 65, 1000, 100000];
+
+void expectElements(List<Object?> list, int length, [int offset = 0]) {
+  Expect.equals(length + offset, list.length);
+  for (var i = 0; i < length; i++) {
+    Expect.equals('e$i', list[offset + i]);
+  }
+}
+
+main() {
+  for (final length in lengths) {
+    final growable = <String>[for (var i = 0; i < length; i++) 'e$i'];
+    expectElements(growable, length);
+    final fixed = List<String>.of(growable, growable: false);
+    expectElements(fixed, length);
+    final immutable = List<String>.unmodifiable(growable);
+    expectElements(immutable, length);
+
+    for (final source in [growable, fixed, immutable]) {
+      expectElements(source.toList(), length);
+      expectElements(source.toList(growable: false), length);
+      expectElements(List<String>.of(source), length);
+      expectElements(List<Object>.of(source, growable: false), length);
+      final target = <Object?>['x', 'y']..addAll(source);
+      expectElements(target, length, 2);
+      Expect.equals('x', target[0]);
+      Expect.equals('y', target[1]);
+    }
+
+    // Growing and shrinking the backing store preserves the elements.
+    final list = <String>[];
+    for (var i = 0; i < length; i++) {
+      list.add('e$i');
+    }
+    expectElements(list, length);
+    list.length = length ~/ 3;
+    expectElements(list, length ~/ 3);
+
+    final typed = List<String>.of(growable, growable: false);
+    Expect.isTrue(typed is List<String>);
+    if (length > 0) {
+      Expect.throwsTypeError(() => (typed as List<Object>)[0] = 1);
+    }
+  }
+}
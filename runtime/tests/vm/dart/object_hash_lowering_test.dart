@@ -0,0 +1,51 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that Object.hash calls, which are lowered to direct SystemHash calls
+// for their number of arguments, hash like Object.hashAll and evaluate their
+// arguments in order.
+
+import 'package:expect/expect.dart';
+
+final log = <String>[];
+
+class Logged {
+  final String name;
+  Logged(this.name);
+
+  @override
+  int get hashCode {
+    log.add('hashCode $name');
+    return name.hashCode;
+  }
+}
+
+T eval<T>(String name, T value) {
+  log.add(name);
+  return value;
+}
+
+main() {
+  final a = Object(), b = 'b', c = 3, d = 4.5;
+  Expect.equals(Object.hashAll([a, b]), Object.hash(a, b));
+  Expect.equals(Object.hashAll([a, b, c]), Object.hash(a, b, c));
+  Expect.equals(Object.hashAll([null, b, c, d]), Object.hash(null, b, c, d));
+  Expect.equals(
+    Object.hashAll([1, 2, 3, 4, 5, 6, 7, 8, 9, 10]),
+    Object.hash(1, 2, 3, 4, 5, 6, 7, 8, 9, 10),
+  );
+  Expect.equals(
+    Object.hashAll([a, b, c, d, a, b, c, d, a, b, c, d, a, b, c, d, a, b]),
+    Object.hash(a, b, c, d, a, b, c, d, a, b, c, d, a, b, c, d, a, b),
+  );
+  Expect.notEquals(Object.hash(a, b), Object.hash(b, a));
+
+  // All arguments are evaluated before any of their hash codes.
+  final x = Logged('x'), y = Logged('y');
+  Object.hash(eval('1', x), eval('2', y), eval('3', 3));
+  Expect.listEquals(['1', '2', '3', 'hashCode x', 'hashCode y'], log);
+
+  var v = 1;
+  Expect.equals(Object.hash(1, 2), Object.hash(v, v = 2));
+}
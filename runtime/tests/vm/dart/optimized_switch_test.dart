@@ -194,6 +194,23 @@ void main() {
   Expect.isTrue(jumpTableIntWithDefault(15) == 15);
   Expect.isTrue(jumpTableIntWithDefault(16) == 16);
   Expect.isTrue(jumpTableIntWithDefault(17) == null);
+
+  Expect.isTrue(hashString('zero') == 0);
+  Expect.isTrue(hashString('one') == 1);
+  Expect.isTrue(hashString('two') == 2);
+  Expect.isTrue(hashString('three') == 3);
+  Expect.isTrue(hashString('four') == 4);
+  Expect.isTrue(hashString('five') == null);
+  Expect.isTrue(hashString('') == null);
+  Expect.isTrue(hashString('t' + 'wo') == 2);
+
+  Expect.isTrue(hashStringWithDefault('zero') == 0);
+  Expect.isTrue(hashStringWithDefault('one') == 1);
+  Expect.isTrue(hashStringWithDefault('two') == 1);
+  Expect.isTrue(hashStringWithDefault('three') == 3);
+  Expect.isTrue(hashStringWithDefault('four') == 4);
+  Expect.isTrue(hashStringWithDefault('five') == -1);
+  Expect.isTrue(hashStringWithDefault('\u{1F600}') == 5);
 }
 
 /// Small enum that is used to test binary search switches.
@@ -622,3 +639,37 @@ int? jumpTableIntWithDefault(int? v) {
       return null;
   }
 }
+
+int? hashString(String v) {
+  switch (v) {
+    case 'zero':
+      return 0;
+    case 'one':
+      return 1;
+    case 'two':
+      return 2;
+    case 'three':
+      return 3;
+    case 'four':
+      return 4;
+  }
+  return null;
+}
+
+int hashStringWithDefault(String v) {
+  switch (v) {
+    case 'zero':
+      return 0;
+    case 'one':
+    case 'two':
+      return 1;
+    case 'three':
+      return 3;
+    case 'four':
+      return 4;
+    case '\u{1F600}':
+      return 5;
+    default:
+      return -1;
+  }
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Verifies string interpolations with two or three pieces, which are passed
+// to the runtime without a temporary array.
+
+// VMOptions=--optimization-counter-threshold=100 --no-background-compilation
+
+import 'package:expect/expect.dart';
+
+class Obj {
+  final String s;
+  Obj(this.s);
+  String toString() => s;
+}
+
+@pragma('vm:never-inline')
+String two(Object? a, Object? b) => '$a$b';
+
+@pragma('vm:never-inline')
+String three(Object? a, Object? b, Object? c) => '$a$b$c';
+
+@pragma('vm:never-inline')
+String withLiterals(Object? a) => '<$a>';
+
+void main() {
+  final long = 'x' * 200;
+  for (int i = 0; i < 200; i++) {
+    Expect.equals('ab', two('a', 'b'));
+    Expect.equals('', two('', ''));
+    Expect.equals('1null', two(1, null));
+    Expect.equals('truefalse', two(true, false));
+    Expect.equals('a\u{1F600}', two('a', '\u{1F600}'));
+    Expect.equals('Āb', two(Obj('Ā'), Obj('b')));
+    Expect.equals('$long$long', two(long, long));
+    Expect.equals(400, two(long, long).length);
+
+    Expect.equals('abc', three('a', 'b', 'c'));
+    Expect.equals('1.5[1, 2]x', three(1.5, [1, 2], Obj('x')));
+    Expect.equals('aĀc', three('a', 'Ā', 'c'));
+    Expect.equals('${long}b$long', three(long, 'b', long));
+    Expect.equals(401, three(long, 'b', long).length);
+
+    Expect.equals('<42>', withLiterals(42));
+    Expect.equals('<Ā>', withLiterals('Ā'));
+  }
+}
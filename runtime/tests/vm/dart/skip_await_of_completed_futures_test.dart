@@ -0,0 +1,62 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--skip_await_of_completed_futures
+
+// Verifies that 'await' of a future which already completed with a value
+// takes the value without suspending, and suspends otherwise.
+
+import 'dart:async';
+
+import 'package:expect/expect.dart';
+
+Future<void> testCompletedValue() async {
+  final future = Future<int>.value(42);
+  // Let the future complete.
+  await null;
+  bool microtaskRan = false;
+  scheduleMicrotask(() => microtaskRan = true);
+  Expect.equals(42, await future);
+  Expect.isFalse(microtaskRan);
+  await null;
+  Expect.isTrue(microtaskRan);
+}
+
+Future<void> testCompletedError() async {
+  final future = Future<int>.error('error');
+  await future.then((_) {}, onError: (_) {});
+  bool microtaskRan = false;
+  scheduleMicrotask(() => microtaskRan = true);
+  try {
+    await future;
+    Expect.fail('await should throw');
+  } catch (e) {
+    Expect.equals('error', e);
+  }
+  Expect.isTrue(microtaskRan);
+}
+
+Future<void> testIncomplete() async {
+  final completer = Completer<int>();
+  scheduleMicrotask(() => completer.complete(1));
+  Expect.equals(1, await completer.future);
+}
+
+Future<void> testCustomZone() async {
+  final future = Future<int>.value(42);
+  await null;
+  await runZoned(() async {
+    bool microtaskRan = false;
+    scheduleMicrotask(() => microtaskRan = true);
+    Expect.equals(42, await future);
+    Expect.isTrue(microtaskRan);
+  }, zoneValues: {#key: 'value'});
+}
+
+main() async {
+  await testCompletedValue();
+  await testCompletedError();
+  await testIncomplete();
+  await testCustomZone();
+}
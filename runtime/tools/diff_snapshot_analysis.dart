@@ -0,0 +1,123 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tool to compare two results of analyze_snapshot, e.g. of a snapshot before
+// and after a change, to find what regresses its size or startup time:
+//
+// analyze_snapshot --out=old.json old.so
+// analyze_snapshot --out=new.json new.so
+// dart diff_snapshot_analysis.dart old.json new.json
+//
+// Prints the differences in cluster sizes and read times, in the code and
+// data size of each library and in the largest canonical constants, largest
+// differences first.
+
+import 'dart:convert';
+import 'dart:io';
+
+const maxRows = 30;
+
+class Row {
+  final String name;
+  final num oldValue;
+  final num newValue;
+  Row(this.name, this.oldValue, this.newValue);
+  num get delta => newValue - oldValue;
+}
+
+Map<String, num> sumBy(List<dynamic>? entries, String Function(dynamic) key,
+    num Function(dynamic) value) {
+  final result = <String, num>{};
+  for (final entry in entries ?? const []) {
+    final k = key(entry);
+    result[k] = (result[k] ?? 0) + value(entry);
+  }
+  return result;
+}
+
+void printDiff(String title, Map<String, num> oldValues,
+    Map<String, num> newValues, String unit) {
+  final rows = <Row>[
+    for (final name in {...oldValues.keys, ...newValues.keys})
+      Row(name, oldValues[name] ?? 0, newValues[name] ?? 0),
+  ]..removeWhere((row) => row.delta == 0);
+  rows.sort((a, b) => b.delta.abs().compareTo(a.delta.abs()));
+  final oldTotal = oldValues.values.fold<num>(0, (a, b) => a + b);
+  final newTotal = newValues.values.fold<num>(0, (a, b) => a + b);
+  print('$title: ${format(oldTotal)} -> ${format(newTotal)} $unit '
+      '(${formatDelta(newTotal - oldTotal)})');
+  for (final row in rows.take(maxRows)) {
+    print('  ${formatDelta(row.delta).padLeft(12)}  '
+        '${format(row.oldValue).padLeft(12)} -> '
+        '${format(row.newValue).padLeft(12)}  ${row.name}');
+  }
+  if (rows.length > maxRows) {
+    print('  ... ${rows.length - maxRows} more');
+  }
+  print('');
+}
+
+String format(num value) =>
+    value is int ? value.toString() : value.toStringAsFixed(1);
+
+String formatDelta(num value) => (value > 0 ? '+' : '') + format(value);
+
+String clusterName(dynamic cluster) =>
+    cluster['canonical'] ? '${cluster['name']} (canonical)' : cluster['name'];
+
+void main(List<String> args) {
+  if (args.length != 2) {
+    stderr.writeln('Usage: dart diff_snapshot_analysis.dart '
+        '<old analysis json> <new analysis json>');
+    exit(1);
+  }
+  final oldJson = json.decode(File(args[0]).readAsStringSync());
+  final newJson = json.decode(File(args[1]).readAsStringSync());
+
+  final oldClusters = oldJson['deserialization']?['clusters'];
+  final newClusters = newJson['deserialization']?['clusters'];
+  if (oldClusters == null || newClusters == null) {
+    print('Cluster statistics are missing in one of the inputs.\n');
+  } else {
+    printDiff(
+        'Cluster size',
+        sumBy(oldClusters, clusterName,
+            (c) => c['alloc_size'] + c['fill_size']),
+        sumBy(newClusters, clusterName,
+            (c) => c['alloc_size'] + c['fill_size']),
+        'bytes');
+    printDiff(
+        'Cluster objects',
+        sumBy(oldClusters, clusterName, (c) => c['objects']),
+        sumBy(newClusters, clusterName, (c) => c['objects']),
+        'objects');
+    num readMicros(dynamic c) =>
+        c['alloc_micros'] + c['fill_micros'] + c['post_load_micros'];
+    printDiff(
+        'Cluster read time',
+        sumBy(oldClusters, clusterName, readMicros),
+        sumBy(newClusters, clusterName, readMicros),
+        'us');
+  }
+
+  String url(dynamic library) => library['url'];
+  printDiff(
+      'Library code size',
+      sumBy(oldJson['library_sizes'], url, (l) => l['code_size']),
+      sumBy(newJson['library_sizes'], url, (l) => l['code_size']),
+      'bytes');
+  printDiff(
+      'Library data size',
+      sumBy(oldJson['library_sizes'], url, (l) => l['data_size']),
+      sumBy(newJson['library_sizes'], url, (l) => l['data_size']),
+      'bytes');
+
+  String constantName(dynamic constant) =>
+      '${constant['class']}: ${constant['value']}';
+  printDiff(
+      'Largest constants',
+      sumBy(oldJson['top_constants'], constantName, (c) => c['size']),
+      sumBy(newJson['top_constants'], constantName, (c) => c['size']),
+      'bytes');
+}
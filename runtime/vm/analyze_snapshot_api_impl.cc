@@ -2,13 +2,16 @@
 // for details. All rights reserved. Use of this source code is governed by a
 // BSD-style license that can be found in the LICENSE file.
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <sstream>
 
 #include "include/analyze_snapshot_api.h"
+#include "vm/app_snapshot.h"
 #include "vm/compiler/runtime_api.h"
 #include "vm/dart_api_impl.h"
+#include "vm/heap/heap.h"
 #include "vm/json_writer.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
@@ -17,8 +20,12 @@
 namespace dart {
 namespace snapshot_analyzer {
 
-constexpr intptr_t kSnapshotAnalyzerVersion = 2;
+constexpr intptr_t kSnapshotAnalyzerVersion = 3;
 constexpr intptr_t kStartIndex = 1;
+// How many of the largest canonical constants are listed.
+constexpr intptr_t kMaxTopConstants = 100;
+// Longer descriptions of constants are truncated.
+constexpr intptr_t kMaxConstantDescriptionLength = 100;
 
 class FieldVisitor : public ObjectPointerVisitor {
  public:
@@ -47,6 +54,81 @@ class FieldVisitor : public ObjectPointerVisitor {
   std::function<void(ObjectPtr object)>* callback_ = nullptr;
 };
 
+// Sizes of the objects which belong to a library, i.e. its classes, their
+// functions, fields and code, and instances of its classes.
+struct LibrarySizes {
+  intptr_t code_size = 0;
+  intptr_t data_size = 0;
+  intptr_t num_classes = 0;
+  intptr_t num_functions = 0;
+  intptr_t num_codes = 0;
+};
+
+class LibrarySizeVisitor : public ObjectVisitor {
+ public:
+  LibrarySizeVisitor(Zone* zone,
+                     ClassTable* class_table,
+                     std::map<uword, LibrarySizes>* sizes)
+      : class_table_(class_table),
+        sizes_(sizes),
+        klass_(Class::Handle(zone)),
+        field_(Field::Handle(zone)),
+        code_(Code::Handle(zone)),
+        owner_(Object::Handle(zone)) {}
+
+  void VisitObject(ObjectPtr obj) override {
+    const intptr_t cid = obj->GetClassId();
+    intptr_t code_size = 0;
+    klass_ = Class::null();
+    switch (cid) {
+      case kClassCid:
+        klass_ ^= obj;
+        break;
+      case kFunctionCid:
+        klass_ = Function::Owner(Function::RawCast(obj));
+        break;
+      case kFieldCid:
+        field_ ^= obj;
+        klass_ = field_.Owner();
+        break;
+      case kCodeCid:
+        code_ ^= obj;
+        code_size = code_.Size();
+        owner_ = code_.owner();
+        if (owner_.IsFunction()) {
+          klass_ = Function::Cast(owner_).Owner();
+        } else if (owner_.IsClass()) {
+          klass_ ^= owner_.ptr();
+        }
+        break;
+      default:
+        if (cid < kNumPredefinedCids || !class_table_->HasValidClassAt(cid)) {
+          return;
+        }
+        klass_ = class_table_->At(cid);
+        break;
+    }
+    if (klass_.IsNull() || klass_.library() == Library::null()) return;
+
+    LibrarySizes& sizes = (*sizes_)[static_cast<uword>(klass_.library())];
+    sizes.code_size += code_size;
+    sizes.data_size += obj->untag()->HeapSize();
+    if (cid == kClassCid) sizes.num_classes++;
+    if (cid == kFunctionCid) sizes.num_functions++;
+    if (cid == kCodeCid) sizes.num_codes++;
+  }
+
+ private:
+  ClassTable* const class_table_;
+  std::map<uword, LibrarySizes>* const sizes_;
+  Class& klass_;
+  Field& field_;
+  Code& code_;
+  Object& owner_;
+
+  DISALLOW_COPY_AND_ASSIGN(LibrarySizeVisitor);
+};
+
 class SnapshotAnalyzer {
  public:
   explicit SnapshotAnalyzer(const Dart_SnapshotAnalyzerInformation& info)
@@ -68,6 +150,9 @@ class SnapshotAnalyzer {
   void DumpObjectPool(const ObjectPool& pool);
 
   void DumpInterestingObjects();
+  void DumpClusterStatistics();
+  void DumpLibrarySizes();
+  void DumpTopConstants();
   void DumpMetadata();
 
   intptr_t GetObjectId(ObjectPtr obj) { return heap_->GetObjectId(obj); }
@@ -320,6 +405,124 @@ void SnapshotAnalyzer::DumpInterestingObjects() {
   js_.CloseArray();
 }
 
+void SnapshotAnalyzer::DumpClusterStatistics() {
+  SnapshotStatistics* statistics =
+      thread_->isolate_group()->snapshot_statistics();
+  if (statistics == nullptr) return;
+
+  const double micros_per_tick =
+      1000000.0 / static_cast<double>(OS::GetCurrentMonotonicFrequency());
+  js_.OpenObject("deserialization");
+  js_.PrintProperty("clustered_size", statistics->clustered_size);
+  js_.PrintProperty("micros", statistics->total_ticks * micros_per_tick);
+  js_.OpenArray("clusters");
+  for (const auto& cluster : statistics->clusters()) {
+    js_.OpenObject();
+    js_.PrintProperty("name", cluster.name);
+    js_.PrintPropertyBool("canonical", cluster.is_canonical);
+    js_.PrintProperty("objects", cluster.num_objects);
+    js_.PrintProperty("alloc_size", cluster.alloc_size);
+    js_.PrintProperty("fill_size", cluster.fill_size);
+    js_.PrintProperty("alloc_micros", cluster.alloc_ticks * micros_per_tick);
+    js_.PrintProperty("fill_micros", cluster.fill_ticks * micros_per_tick);
+    js_.PrintProperty("post_load_micros",
+                      cluster.post_load_ticks * micros_per_tick);
+    js_.CloseObject();
+  }
+  js_.CloseArray();
+  js_.CloseObject();
+}
+
+void SnapshotAnalyzer::DumpLibrarySizes() {
+  Zone* zone = thread_->zone();
+  std::map<uword, LibrarySizes> sizes;
+  {
+    HeapIterationScope iteration(thread_);
+    LibrarySizeVisitor visitor(zone, thread_->isolate_group()->class_table(),
+                               &sizes);
+    iteration.IterateObjects(&visitor);
+  }
+
+  // Largest libraries first.
+  std::vector<std::pair<uword, LibrarySizes>> sorted(sizes.begin(),
+                                                     sizes.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+    return (a.second.code_size + a.second.data_size) >
+           (b.second.code_size + b.second.data_size);
+  });
+
+  auto& library = Library::Handle(zone);
+  js_.OpenArray("library_sizes");
+  for (const auto& entry : sorted) {
+    library = static_cast<LibraryPtr>(entry.first);
+    js_.OpenObject();
+    js_.PrintProperty("url", String::Handle(zone, library.url()).ToCString());
+    js_.PrintProperty("code_size", entry.second.code_size);
+    js_.PrintProperty("data_size", entry.second.data_size);
+    js_.PrintProperty("classes", entry.second.num_classes);
+    js_.PrintProperty("functions", entry.second.num_functions);
+    js_.PrintProperty("codes", entry.second.num_codes);
+    js_.CloseObject();
+  }
+  js_.CloseArray();
+}
+
+void SnapshotAnalyzer::DumpTopConstants() {
+  Zone* zone = thread_->zone();
+  auto class_table = thread_->isolate_group()->class_table();
+  auto& klass = Class::Handle(zone);
+  auto& constants = Array::Handle(zone);
+  struct Constant {
+    const Object* object;
+    intptr_t size;
+  };
+  std::vector<Constant> all_constants;
+  for (intptr_t cid = 0; cid < class_table->NumCids(); ++cid) {
+    if (!class_table->HasValidClassAt(cid)) continue;
+    klass = class_table->At(cid);
+    constants = klass.constants();
+    if (constants.IsNull()) continue;
+    for (intptr_t i = 0; i < constants.Length(); ++i) {
+      ObjectPtr constant = constants.At(i);
+      if (!constant->IsHeapObject()) continue;
+      all_constants.push_back({&Object::Handle(zone, constant),
+                               constant->untag()->HeapSize()});
+    }
+  }
+
+  const intptr_t count = Utils::Minimum(
+      kMaxTopConstants, static_cast<intptr_t>(all_constants.size()));
+  std::partial_sort(
+      all_constants.begin(), all_constants.begin() + count,
+      all_constants.end(),
+      [](const Constant& a, const Constant& b) { return a.size > b.size; });
+
+  auto& library = Library::Handle(zone);
+  js_.OpenArray("top_constants");
+  for (intptr_t i = 0; i < count; ++i) {
+    const Constant& constant = all_constants[i];
+    klass = constant.object->clazz();
+    library = klass.library();
+    const char* description = constant.object->ToCString();
+    if (strlen(description) > kMaxConstantDescriptionLength) {
+      description =
+          OS::SCreate(zone, "%.*s...",
+                      static_cast<int>(kMaxConstantDescriptionLength),
+                      description);
+    }
+    js_.OpenObject();
+    js_.PrintProperty("class", String::Handle(zone, klass.Name()).ToCString());
+    if (!library.IsNull()) {
+      js_.PrintProperty("library",
+                        String::Handle(zone, library.url()).ToCString());
+    }
+    js_.PrintProperty("size", constant.size);
+    js_.PrintProperty("value", description);
+    js_.CloseObject();
+  }
+  js_.CloseArray();
+}
+
 void SnapshotAnalyzer::DumpMetadata() {
   js_.OpenObject("metadata");
   js_.OpenObject("offsets");
@@ -366,6 +569,9 @@ void SnapshotAnalyzer::DumpSnapshotInformation(char** buffer,
     // vm internal fields.
     SafepointReadRwLocker ml(thread_, thread_->isolate_group()->program_lock());
     DumpInterestingObjects();
+    DumpClusterStatistics();
+    DumpLibrarySizes();
+    DumpTopConstants();
     DumpMetadata();
   }
 
@@ -25,6 +25,7 @@
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/profiler.h"
 #include "vm/program_visitor.h"
 #include "vm/raw_object_fields.h"
 #include "vm/stub_code.h"
@@ -33,6 +34,7 @@
 #include "vm/v8_snapshot_writer.h"
 #include "vm/version.h"
 #include "vm/zone_text_buffer.h"
+#include "zlib/zlib.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/compiler/backend/code_statistics.h"
@@ -40,8 +42,19 @@
 #include "vm/compiler/relocation.h"
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
+#if defined(DART_PRECOMPILER)
+#include "vm/compiler/aot/aot_profile.h"
+#endif  // defined(DART_PRECOMPILER)
+
 namespace dart {
 
+DEFINE_FLAG(int,
+            snapshot_fill_tasks,
+            0,
+            "Number of helper threads used to fill self-contained clusters "
+            "(instances, arrays, records, typed data) while deserializing a "
+            "snapshot. 0 fills all clusters on the deserializing thread.");
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
 DEFINE_FLAG(bool,
             print_cluster_information,
@@ -49,6 +62,25 @@ DEFINE_FLAG(bool,
             "Print information about clusters written to snapshot");
 #endif
 
+DEFINE_FLAG(bool,
+            record_snapshot_statistics,
+            false,
+            "Record the size and read time of each cluster of the program "
+            "snapshot. Clusters are then filled on the deserializing thread.");
+
+DEFINE_FLAG(bool,
+            compress_snapshot_data,
+            false,
+            "Compress the clustered data of isolate snapshots with zlib. "
+            "The mapped read-only data and instructions are not compressed.");
+
+// How the clustered data after the version and features is stored.
+enum ClusteredDataCompression : uint8_t {
+  kUncompressedClusteredData = 0,
+  // Preceded by the inflated and compressed sizes.
+  kZlibClusteredData = 1,
+};
+
 #if defined(DART_PRECOMPILER)
 DEFINE_FLAG(charp,
             write_v8_snapshot_profile_to,
@@ -233,6 +265,19 @@ class DeserializationCluster : public ZoneAllocated {
   // Initialize the cluster's objects. Do not touch the memory of other objects.
   virtual void ReadFill(Deserializer* deserializer) = 0;
 
+  // Whether this cluster's fill only reads the snapshot stream and the ref
+  // array and writes only to the cluster's own objects, so that it can be run
+  // on a helper thread without a Thread while other clusters are being filled.
+  virtual bool CanFillConcurrently() const { return false; }
+
+  // Same as ReadFill, but reads the fill section from [start, end) instead of
+  // the deserializer's stream. Only called if CanFillConcurrently().
+  virtual void ReadFillAt(Deserializer* deserializer,
+                          const uint8_t* start,
+                          const uint8_t* end) {
+    UNREACHABLE();
+  }
+
   // Complete any action that requires the full graph to be deserialized, such
   // as rehashing.
   virtual void PostLoad(Deserializer* deserializer, const Array& refs) {
@@ -248,6 +293,7 @@ class DeserializationCluster : public ZoneAllocated {
 
   const char* name() const { return name_; }
   bool is_canonical() const { return is_canonical_; }
+  intptr_t num_objects() const { return stop_index_ - start_index_; }
 
  protected:
   void ReadAllocFixedSize(Deserializer* deserializer, intptr_t instance_size);
@@ -350,6 +396,9 @@ class Serializer : public ThreadStackResource {
   }
 
   void WriteVersionAndFeatures(bool is_vm_snapshot);
+  // Compresses the clustered data written after the features, if requested
+  // with --compress_snapshot_data.
+  void CompressClusteredData();
 
   ZoneGrowableArray<Object*>* Serialize(SerializationRoots* roots);
   void PrintSnapshotSizes();
@@ -514,6 +563,13 @@ class Serializer : public ThreadStackResource {
   // Sorts Code objects and reorders instructions before writing snapshot.
   // Builds binary search table for stack maps.
   void PrepareInstructions(const CompressedStackMaps& canonical_smap);
+#if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32)
+  // Appends the lookup index for the instructions starting at |pc_offsets|
+  // to the UntaggedInstructionsTable::Data being written to |stream|.
+  static void WriteInstructionsTableLookupIndex(
+      MallocWriteStream* stream,
+      const GrowableArray<uint32_t>& pc_offsets);
+#endif
 
   void WriteInstructions(InstructionsPtr instr,
                          uint32_t unchecked_offset,
@@ -617,6 +673,9 @@ class Serializer : public ThreadStackResource {
   // True if writing VM snapshot, false for Isolate snapshot.
   bool vm_;
 
+  bool compress_clustered_data_ = false;
+  intptr_t clustered_data_start_ = 0;
+
   V8SnapshotProfileWriter* profile_writer_ = nullptr;
   struct ProfilingObject {
     ObjectPtr object_ = nullptr;
@@ -759,6 +818,18 @@ class Deserializer : public ThreadStackResource {
 
   void Deserialize(DeserializationRoots* roots);
 
+  // Records the clusters read by Deserialize into |statistics|.
+  void set_statistics(SnapshotStatistics* statistics) {
+    statistics_ = statistics;
+  }
+
+  // Whether the buffer was inflated from compressed snapshot data, so it is
+  // not part of the snapshot the embedder provided.
+  void set_buffer_is_inflated(bool value) { buffer_is_inflated_ = value; }
+  // Whether deserialized objects point into the buffer, which then has to
+  // outlive them.
+  bool references_buffer() const { return references_buffer_; }
+
   DeserializationCluster* ReadCluster();
 
   void ReadDispatchTable() {
@@ -800,13 +871,26 @@ class Deserializer : public ThreadStackResource {
         : ReadStream(d->stream_.buffer_, d->stream_.current_, d->stream_.end_),
           d_(d),
           refs_(d->refs_),
-          null_(Object::null()) {
+          null_(Object::null()),
+          detached_(false) {
 #if defined(DEBUG)
       // Can't mix use of Deserializer::Read*.
       d->stream_.current_ = nullptr;
 #endif
     }
-    ~Local() { d_->stream_.current_ = current_; }
+    // Reads [start, end) without touching the deserializer's stream, so
+    // several of these can be used at once from different threads.
+    Local(Deserializer* d, const uint8_t* start, const uint8_t* end)
+        : ReadStream(d->stream_.buffer_, start, end),
+          d_(d),
+          refs_(d->refs_),
+          null_(Object::null()),
+          detached_(true) {}
+    ~Local() {
+      if (!detached_) {
+        d_->stream_.current_ = current_;
+      }
+    }
 
     ObjectPtr Ref(intptr_t index) const {
       ASSERT(index > 0);
@@ -851,9 +935,12 @@ class Deserializer : public ThreadStackResource {
     Deserializer* const d_;
     const ArrayPtr refs_;
     const ObjectPtr null_;
+    const bool detached_;
   };
 
  private:
+  void ReadFillSections();
+
   Heap* heap_;
   PageSpace* old_space_;
   FreeList* freelist_;
@@ -872,6 +959,9 @@ class Deserializer : public ThreadStackResource {
   DeserializationCluster** clusters_;
   const bool is_non_root_unit_;
   InstructionsTable& instructions_table_;
+  SnapshotStatistics* statistics_ = nullptr;
+  bool buffer_is_inflated_ = false;
+  bool references_buffer_ = false;
 };
 
 DART_FORCE_INLINE
@@ -1772,6 +1862,20 @@ class FunctionSerializationCluster : public SerializationCluster {
         s->Write<bool>(func->untag()->is_optimizable_);
       }
       s->Write<uint32_t>(func->untag()->kind_tag_);
+      if (kind == Snapshot::kFullJIT) {
+        // Keep the feedback collected by the training run, so functions which
+        // got hot do not have to warm up again and functions which were
+        // deoptimized are not optimized with the same speculations again.
+        // The counter is negative while the function is being optimized.
+        s->Write<int32_t>(Utils::Maximum(func->untag()->usage_counter_, 0));
+        s->Write<uint16_t>(func->untag()->optimized_instruction_count_);
+        s->Write<uint16_t>(func->untag()->optimized_call_site_count_);
+        s->Write<int8_t>(func->untag()->deoptimization_counter_);
+        // Whether the function has code is decided again in PostLoad.
+        s->Write<int8_t>(Function::WasCompiledBit::update(
+            false, func->untag()->state_bits_));
+        s->Write<int8_t>(func->untag()->inlining_depth_);
+      }
     }
   }
 
@@ -1891,6 +1995,9 @@ class FunctionDeserializationCluster : public DeserializationCluster {
 
     ASSERT(!is_canonical());  // Never canonical.
     Snapshot::Kind kind = d_->kind();
+#if defined(DART_PRECOMPILED_RUNTIME)
+    const bool entry_points_final = EntryPointsFinalAfterFill(d_);
+#endif
 
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
       FunctionPtr func = static_cast<FunctionPtr>(d.Ref(id));
@@ -1912,6 +2019,13 @@ class FunctionDeserializationCluster : public DeserializationCluster {
       if (entry_point != 0) {
         func->untag()->entry_point_ = entry_point;
         func->untag()->unchecked_entry_point_ = entry_point;
+      } else if (entry_points_final) {
+        // The Code cluster has already been filled, so there is no need to
+        // revisit this function in PostLoad.
+        ASSERT(code->untag()->entry_point_ != 0);
+        func->untag()->entry_point_ = code->untag()->entry_point_;
+        func->untag()->unchecked_entry_point_ =
+            code->untag()->unchecked_entry_point_;
       }
 #else
       ASSERT(kind != Snapshot::kFullAOT);
@@ -1940,18 +2054,30 @@ class FunctionDeserializationCluster : public DeserializationCluster {
 
       func->untag()->kind_tag_ = d.Read<uint32_t>();
 #if !defined(DART_PRECOMPILED_RUNTIME)
-      func->untag()->usage_counter_ = 0;
-      func->untag()->optimized_instruction_count_ = 0;
-      func->untag()->optimized_call_site_count_ = 0;
-      func->untag()->deoptimization_counter_ = 0;
-      func->untag()->state_bits_ = 0;
-      func->untag()->inlining_depth_ = 0;
+      if (kind == Snapshot::kFullJIT) {
+        func->untag()->usage_counter_ = d.Read<int32_t>();
+        func->untag()->optimized_instruction_count_ = d.Read<uint16_t>();
+        func->untag()->optimized_call_site_count_ = d.Read<uint16_t>();
+        func->untag()->deoptimization_counter_ = d.Read<int8_t>();
+        func->untag()->state_bits_ = d.Read<int8_t>();
+        func->untag()->inlining_depth_ = d.Read<int8_t>();
+      } else {
+        func->untag()->usage_counter_ = 0;
+        func->untag()->optimized_instruction_count_ = 0;
+        func->untag()->optimized_call_site_count_ = 0;
+        func->untag()->deoptimization_counter_ = 0;
+        func->untag()->state_bits_ = 0;
+        func->untag()->inlining_depth_ = 0;
+      }
 #endif
     }
   }
 
   void PostLoad(Deserializer* d, const Array& refs) override {
     if (d->kind() == Snapshot::kFullAOT) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+      if (EntryPointsFinalAfterFill(d)) return;
+#endif
       Function& func = Function::Handle(d->zone());
       for (intptr_t i = start_index_, n = stop_index_; i < n; i++) {
         func ^= refs.At(i);
@@ -1987,6 +2113,20 @@ class FunctionDeserializationCluster : public DeserializationCluster {
       }
     }
   }
+
+ private:
+#if defined(DART_PRECOMPILED_RUNTIME)
+  // In the root unit of an isolate snapshot, every Code object a function can
+  // refer to is either a stub from the VM snapshot or has been filled by the
+  // Code cluster (which precedes this one), so entry points can be copied
+  // during ReadFill. Non-root units refer to deferred Code objects of their
+  // parent that only get their instructions in ReadRoots, and the VM snapshot
+  // installs stubs in ReadRoots, so both still set entry points in PostLoad.
+  static bool EntryPointsFinalAfterFill(Deserializer* d) {
+    return !d->is_non_root_unit() &&
+           (d->isolate_group() != Dart::vm_isolate_group());
+  }
+#endif
 };
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
@@ -2725,6 +2865,7 @@ class CodeSerializationCluster : public SerializationCluster {
     CodePtr code;
     intptr_t not_discarded;  // 1 if this code was not discarded and
                              // 0 otherwise.
+    intptr_t temperature;    // See CodeTemperature.
     intptr_t instructions_id;
   };
 
@@ -2739,10 +2880,15 @@ class CodeSerializationCluster : public SerializationCluster {
   // there is no way to identify which specific Code object (out of those
   // which point to the specific instructions range) actually corresponds
   // to a particular frame.
+  //
+  // Within these groups code is ordered by its temperature to keep
+  // frequently executed code together.
   static int CompareCodeOrderInfo(CodeOrderInfo const* a,
                                   CodeOrderInfo const* b) {
     if (a->not_discarded < b->not_discarded) return -1;
     if (a->not_discarded > b->not_discarded) return 1;
+    if (a->temperature < b->temperature) return -1;
+    if (a->temperature > b->temperature) return 1;
     if (a->instructions_id < b->instructions_id) return -1;
     if (a->instructions_id > b->instructions_id) return 1;
     return 0;
@@ -2769,9 +2915,41 @@ class CodeSerializationCluster : public SerializationCluster {
     info.code = code;
     info.instructions_id = instructions_id;
     info.not_discarded = Code::IsDiscarded(code) ? 0 : 1;
+    info.temperature = CodeTemperature(code);
     order_list->Add(info);
   }
 
+  enum { kHotCode = 0, kWarmCode = 1, kColdCode = 2 };
+
+  // Code of functions which were optimized during the training run recorded
+  // in the AOT profile is hot. Code of functions which were not executed
+  // during the training run or are expected to run at most once is cold.
+  static intptr_t CodeTemperature(CodePtr code) {
+#if defined(DART_PRECOMPILER)
+    if (!FLAG_precompiled_mode) {
+      return kWarmCode;
+    }
+    const Object& owner = Object::Handle(
+        WeakSerializationReference::Unwrap(code->untag()->owner()));
+    if (!owner.IsFunction()) {
+      return kWarmCode;
+    }
+    const Function& function = Function::Cast(owner);
+    if (function.IsFieldInitializer() || function.IsNoSuchMethodDispatcher()) {
+      return kColdCode;
+    }
+    if (AotProfile* profile = AotProfile::Current()) {
+      if (profile->IsHot(function)) {
+        return kHotCode;
+      }
+      if (!profile->WasExecuted(function)) {
+        return kColdCode;
+      }
+    }
+#endif  // defined(DART_PRECOMPILER)
+    return kWarmCode;
+  }
+
   static void Sort(Serializer* s, GrowableArray<CodePtr>* codes) {
     GrowableArray<CodeOrderInfo> order_list;
     IntMap<intptr_t> order_map;
@@ -3109,6 +3287,8 @@ class CodeDeserializationCluster : public DeserializationCluster {
     d->EndInstructions();
 
 #if !defined(PRODUCT)
+    // Deserialized code is not recorded when installed.
+    CodeLookupTable::Invalidate(d->thread());
     if (!CodeObservers::AreActive() && !FLAG_support_disassembler) return;
 #endif
     Code& code = Code::Handle(d->zone());
@@ -4611,7 +4791,20 @@ class InstanceDeserializationCluster
 
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
+    ReadFill(&d);
+  }
 
+  bool CanFillConcurrently() const override { return true; }
+
+  void ReadFillAt(Deserializer* d_,
+                  const uint8_t* start,
+                  const uint8_t* end) override {
+    Deserializer::Local d(d_, start, end);
+    ReadFill(&d);
+  }
+
+ private:
+  void ReadFill(Deserializer::Local* d) {
     const intptr_t cid = cid_;
     const bool mark_canonical = is_root_unit_ && is_canonical();
     const bool is_immutable = is_immutable_;
@@ -4619,10 +4812,10 @@ class InstanceDeserializationCluster
                                  << kCompressedWordSizeLog2;
     intptr_t instance_size = Object::RoundedAllocationSize(
         instance_size_in_words_ * kCompressedWordSize);
-    const UnboxedFieldBitmap unboxed_fields_bitmap(d.ReadUnsigned64());
+    const UnboxedFieldBitmap unboxed_fields_bitmap(d->ReadUnsigned64());
 
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
-      InstancePtr instance = static_cast<InstancePtr>(d.Ref(id));
+      InstancePtr instance = static_cast<InstancePtr>(d->Ref(id));
       Deserializer::InitializeHeader(instance, cid, instance_size,
                                      mark_canonical, is_immutable);
       intptr_t offset = Instance::NextFieldOffset();
@@ -4631,11 +4824,11 @@ class InstanceDeserializationCluster
           compressed_uword* p = reinterpret_cast<compressed_uword*>(
               reinterpret_cast<uword>(instance->untag()) + offset);
           // Reads 32 bits of the unboxed value at a time
-          *p = d.ReadWordWith32BitReads();
+          *p = d->ReadWordWith32BitReads();
         } else {
           CompressedObjectPtr* p = reinterpret_cast<CompressedObjectPtr*>(
               reinterpret_cast<uword>(instance->untag()) + offset);
-          *p = d.ReadRef();
+          *p = d->ReadRef();
         }
         offset += kCompressedWordSize;
       }
@@ -5648,18 +5841,31 @@ class RecordDeserializationCluster
 
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
+    ReadFill(&d);
+  }
+
+  bool CanFillConcurrently() const override { return true; }
+
+  void ReadFillAt(Deserializer* d_,
+                  const uint8_t* start,
+                  const uint8_t* end) override {
+    Deserializer::Local d(d_, start, end);
+    ReadFill(&d);
+  }
 
+ private:
+  void ReadFill(Deserializer::Local* d) {
     const bool stamp_canonical = is_root_unit_ && is_canonical();
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
-      RecordPtr record = static_cast<RecordPtr>(d.Ref(id));
-      const intptr_t shape = d.ReadUnsigned();
+      RecordPtr record = static_cast<RecordPtr>(d->Ref(id));
+      const intptr_t shape = d->ReadUnsigned();
       const intptr_t num_fields = RecordShape(shape).num_fields();
       Deserializer::InitializeHeader(record, kRecordCid,
                                      Record::InstanceSize(num_fields),
                                      stamp_canonical);
       record->untag()->shape_ = Smi::New(shape);
       for (intptr_t j = 0; j < num_fields; ++j) {
-        record->untag()->data()[j] = d.ReadRef();
+        record->untag()->data()[j] = d->ReadRef();
       }
     }
   }
@@ -5729,21 +5935,34 @@ class TypedDataDeserializationCluster : public DeserializationCluster {
 
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
+    ReadFill(&d);
+  }
+
+  bool CanFillConcurrently() const override { return true; }
+
+  void ReadFillAt(Deserializer* d_,
+                  const uint8_t* start,
+                  const uint8_t* end) override {
+    Deserializer::Local d(d_, start, end);
+    ReadFill(&d);
+  }
 
+ private:
+  void ReadFill(Deserializer::Local* d) {
     ASSERT(!is_canonical());  // Never canonical.
     intptr_t element_size = TypedData::ElementSizeInBytes(cid_);
 
     const intptr_t cid = cid_;
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
-      TypedDataPtr data = static_cast<TypedDataPtr>(d.Ref(id));
-      const intptr_t length = d.ReadUnsigned();
+      TypedDataPtr data = static_cast<TypedDataPtr>(d->Ref(id));
+      const intptr_t length = d->ReadUnsigned();
       const intptr_t length_in_bytes = length * element_size;
       Deserializer::InitializeHeader(data, cid,
                                      TypedData::InstanceSize(length_in_bytes));
       data->untag()->length_ = Smi::New(length);
       data->untag()->RecomputeDataField();
       uint8_t* cdata = reinterpret_cast<uint8_t*>(data->untag()->data());
-      d.ReadBytes(cdata, length_in_bytes);
+      d->ReadBytes(cdata, length_in_bytes);
     }
   }
 
@@ -6499,12 +6718,25 @@ class ArrayDeserializationCluster
 
   void ReadFill(Deserializer* d_) override {
     Deserializer::Local d(d_);
+    ReadFill(&d);
+  }
 
+  bool CanFillConcurrently() const override { return true; }
+
+  void ReadFillAt(Deserializer* d_,
+                  const uint8_t* start,
+                  const uint8_t* end) override {
+    Deserializer::Local d(d_, start, end);
+    ReadFill(&d);
+  }
+
+ private:
+  void ReadFill(Deserializer::Local* d) {
     const intptr_t cid = cid_;
     const bool stamp_canonical = is_root_unit_ && is_canonical();
     for (intptr_t id = start_index_, n = stop_index_; id < n; id++) {
-      ArrayPtr array = static_cast<ArrayPtr>(d.Ref(id));
-      const intptr_t length = d.ReadUnsigned();
+      ArrayPtr array = static_cast<ArrayPtr>(d->Ref(id));
+      const intptr_t length = d->ReadUnsigned();
       Deserializer::InitializeHeader(array, cid, Array::InstanceSize(length),
                                      stamp_canonical);
       if (Array::UseCardMarkingForAllocation(length)) {
@@ -6512,10 +6744,10 @@ class ArrayDeserializationCluster
         Page::Of(array)->AllocateCardTable();
       }
       array->untag()->type_arguments_ =
-          static_cast<TypeArgumentsPtr>(d.ReadRef());
+          static_cast<TypeArgumentsPtr>(d->ReadRef());
       array->untag()->length_ = Smi::New(length);
       for (intptr_t j = 0; j < length; j++) {
-        array->untag()->data()[j] = d.ReadRef();
+        array->untag()->data()[j] = d->ReadRef();
       }
     }
   }
@@ -7380,12 +7612,18 @@ class UnitDeserializationRoots : public DeserializationRoots {
         d->isolate_group()->object_store()->global_object_pool();
     const intptr_t length = pool->untag()->length_;
     uint8_t* entry_bits = pool->untag()->entry_bits();
+    // The global pool may be on a permanent page (see
+    // PageSpace::MakePagesPermanent), where updated entries must be dirtied.
+    Page* pool_page = Page::Of(pool);
     for (intptr_t i = d->ReadUnsigned(); i < length; i += d->ReadUnsigned()) {
       auto entry_type = ObjectPool::TypeBits::decode(entry_bits[i]);
       ASSERT(entry_type == ObjectPool::EntryType::kTaggedObject);
       // The existing entry will usually be null, but it might also be an
       // equivalent object that was duplicated in another loading unit.
       pool->untag()->data()[i].raw_obj_ = d->ReadRef();
+      if (pool_page->has_dirty_cards()) {
+        pool_page->RememberDirtyCard(&pool->untag()->data()[i].raw_obj_);
+      }
     }
 
     // Reinitialize the dispatch table by rereading the table's serialization
@@ -8108,6 +8346,45 @@ intptr_t Serializer::GetCodeIndex(CodePtr code) {
 }
 #endif  // defined(DART_PRECOMPILER)
 
+#if defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32)
+void Serializer::WriteInstructionsTableLookupIndex(
+    MallocWriteStream* stream,
+    const GrowableArray<uint32_t>& pc_offsets) {
+  using Table = UntaggedInstructionsTable;
+  const intptr_t length = pc_offsets.length();
+  ASSERT(length > 0);
+  stream->Align(sizeof(uint32_t));
+  const intptr_t index_offset = stream->bytes_written();
+  reinterpret_cast<Table::Data*>(stream->buffer())->lookup_index_offset =
+      index_offset;
+  const intptr_t pages = (pc_offsets.Last() >> Table::kLookupPageSizeLog2) + 1;
+  stream->WriteFixed<uint32_t>(pages);
+
+  // Returns the index of the entry containing the instruction at |pc_offset|.
+  // Must be called with increasing offsets.
+  intptr_t entry = 0;
+  auto entry_at = [&](uword pc_offset) {
+    while ((entry + 1 < length) && (pc_offsets[entry + 1] <= pc_offset)) {
+      entry++;
+    }
+    return entry;
+  };
+  for (intptr_t page = 0; page < pages; page++) {
+    const uword page_offset = page << Table::kLookupPageSizeLog2;
+    Table::LookupPage lookup;
+    lookup.first_entry = static_cast<uint32_t>(entry_at(page_offset));
+    for (intptr_t i = 0; i < Table::kLookupSubPages; i++) {
+      const intptr_t delta =
+          entry_at(page_offset + (i << Table::kLookupSubPageSizeLog2)) -
+          lookup.first_entry;
+      lookup.sub_page_delta[i] = static_cast<uint8_t>(
+          Utils::Minimum<intptr_t>(delta, Table::kMaxLookupDelta));
+    }
+    stream->WriteFixed<Table::LookupPage>(lookup);
+  }
+}
+#endif  // defined(DART_PRECOMPILER) && !defined(TARGET_ARCH_IA32)
+
 void Serializer::PrepareInstructions(
     const CompressedStackMaps& canonical_stack_map_entries) {
   if (!Snapshot::IncludesCode(kind())) return;
@@ -8171,7 +8448,8 @@ void Serializer::PrepareInstructions(
     //    - a binary search table mapping an Instructions entry point to its
     //      stack maps (by offset from the beginning of the Data object);
     //    - followed by stack maps bytes;
-    //    - followed by canonical stack map entries.
+    //    - followed by canonical stack map entries;
+    //    - followed by the lookup index narrowing down the binary search.
     //
     struct StackMapInfo : public ZoneAllocated {
       CompressedStackMapsPtr map;
@@ -8284,6 +8562,7 @@ void Serializer::PrepareInstructions(
 
     // Now that we have offsets to all stack maps we can write binary
     // search table.
+    GrowableArray<uint32_t> pc_offsets(total);
     pc_mapping.SetPosition(
         sizeof(UntaggedInstructionsTable::Data));  // Skip the header.
     for (auto& cmd : writer_commands) {
@@ -8298,11 +8577,14 @@ void Serializer::PrepareInstructions(
 
         pc_mapping.WriteFixed<UntaggedInstructionsTable::DataEntry>(
             {static_cast<uint32_t>(entry), offset});
+        pc_offsets.Add(static_cast<uint32_t>(entry));
       }
     }
     // Restore position so that Steal does not truncate the buffer.
     pc_mapping.SetPosition(total_bytes);
 
+    WriteInstructionsTableLookupIndex(&pc_mapping, pc_offsets);
+
     intptr_t length = 0;
     uint8_t* bytes = pc_mapping.Steal(&length);
 
@@ -8530,6 +8812,31 @@ void Serializer::WriteVersionAndFeatures(bool is_vm_snapshot) {
   WriteBytes(reinterpret_cast<const uint8_t*>(expected_features),
              features_len + 1);
   free(expected_features);
+
+  compress_clustered_data_ = FLAG_compress_snapshot_data && !is_vm_snapshot;
+  Write<uint8_t>(compress_clustered_data_ ? kZlibClusteredData
+                                          : kUncompressedClusteredData);
+  clustered_data_start_ = bytes_written();
+}
+
+void Serializer::CompressClusteredData() {
+  if (!compress_clustered_data_) return;
+  const intptr_t size = bytes_written() - clustered_data_start_;
+  uLongf compressed_size = compressBound(size);
+  CAllocUniquePtr<uint8_t> compressed(
+      reinterpret_cast<uint8_t*>(malloc(compressed_size)));
+  const int result =
+      compress2(compressed.get(), &compressed_size,
+                stream_->buffer() + clustered_data_start_, size,
+                Z_BEST_COMPRESSION);
+  if (result != Z_OK) {
+    FATAL("Failed to compress the snapshot data: %s", zError(result));
+  }
+  stream_->SetPosition(clustered_data_start_);
+  Write<intptr_t>(size);
+  Write<intptr_t>(compressed_size);
+  WriteBytes(compressed.get(), compressed_size);
+  object_currently_writing_.last_stream_position_ = stream_->Position();
 }
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
@@ -8711,10 +9018,23 @@ ZoneGrowableArray<Object*>* Serializer::Serialize(SerializationRoots* roots) {
 #endif
 
   for (SerializationCluster* cluster : clusters) {
+    // Each fill section is prefixed with its size so the deserializer can
+    // locate all sections up front and fill independent clusters in parallel.
+    const intptr_t size_position = bytes_written();
+    Write<uint32_t>(0);
     cluster->WriteAndMeasureFill(this);
 #if defined(DEBUG)
     Write<int32_t>(kSectionMarker);
 #endif
+    const intptr_t end_position = bytes_written();
+    const intptr_t section_size =
+        end_position - size_position - sizeof(uint32_t);
+    if (!Utils::IsUint(32, section_size)) {
+      FATAL("Fill section of %s cluster is too large", cluster->name());
+    }
+    stream_->SetPosition(size_position);
+    Write<uint32_t>(static_cast<uint32_t>(section_size));
+    stream_->SetPosition(end_position);
   }
 
   roots->WriteRoots(this);
@@ -8998,6 +9318,8 @@ DeserializationCluster* Deserializer::ReadCluster() {
   }
   if (IsExternalTypedDataClassId(cid)) {
     ASSERT(!is_canonical);
+    // The data of ExternalTypedData is not copied out of the snapshot.
+    references_buffer_ = true;
     return new (Z) ExternalTypedDataDeserializationCluster(cid);
   }
   if (IsTypedDataClassId(cid)) {
@@ -9393,6 +9715,36 @@ char* SnapshotHeaderReader::ReadFeatures(const char** features,
   return nullptr;
 }
 
+char* SnapshotHeaderReader::ReadClusteredData(ClusteredData* data) {
+  const uint8_t compression = stream_.Read<uint8_t>();
+  if (compression == kUncompressedClusteredData) {
+    data->offset = stream_.Position();
+    return nullptr;
+  }
+  if (compression != kZlibClusteredData) {
+    return BuildError("Unknown compression of the snapshot data");
+  }
+  const intptr_t size = stream_.Read<intptr_t>();
+  const intptr_t compressed_size = stream_.Read<intptr_t>();
+  if ((size < 0) || (compressed_size < 0) ||
+      (compressed_size > stream_.PendingBytes())) {
+    return BuildError("Truncated compressed snapshot data");
+  }
+  data->inflated.reset(reinterpret_cast<uint8_t*>(malloc(size)));
+  uLongf inflated_size = size;
+  const int result = uncompress(data->inflated.get(), &inflated_size,
+                                stream_.AddressOfCurrentPosition(),
+                                compressed_size);
+  if ((result != Z_OK) || (inflated_size != static_cast<uLongf>(size))) {
+    return BuildError("Failed to inflate the snapshot data");
+  }
+  stream_.Advance(compressed_size);
+  data->buffer = data->inflated.get();
+  data->size = size;
+  data->offset = 0;
+  return nullptr;
+}
+
 char* SnapshotHeaderReader::BuildError(const char* message) {
   return Utils::StrDup(message);
 }
@@ -9517,8 +9869,161 @@ class HeapLocker : public StackResource {
   FreeList* freelist_;
 };
 
+// Fill sections of clusters that can be filled concurrently, shared between
+// the deserializing thread and the helper tasks.
+class ConcurrentFillSections : public ValueObject {
+ public:
+  explicit ConcurrentFillSections(Deserializer* d) : d_(d) {}
+
+  void Add(DeserializationCluster* cluster,
+           const uint8_t* start,
+           const uint8_t* end) {
+    sections_.Add({cluster, start, end});
+    total_size_ += end - start;
+  }
+
+  intptr_t length() const { return sections_.length(); }
+  intptr_t total_size() const { return total_size_; }
+
+  // Fills sections until none are left to claim.
+  void Fill() {
+    const intptr_t n = sections_.length();
+    for (intptr_t i = next_.fetch_add(1); i < n; i = next_.fetch_add(1)) {
+      const Section& section = sections_[i];
+      section.cluster->ReadFillAt(d_, section.start, section.end);
+    }
+  }
+
+  void TaskStarted() {
+    MonitorLocker ml(&monitor_);
+    running_tasks_++;
+  }
+
+  void TaskFinished() {
+    MonitorLocker ml(&monitor_);
+    running_tasks_--;
+    if (running_tasks_ == 0) {
+      ml.NotifyAll();
+    }
+  }
+
+  void WaitForTasks() {
+    MonitorLocker ml(&monitor_);
+    while (running_tasks_ > 0) {
+      ml.Wait();
+    }
+  }
+
+ private:
+  struct Section {
+    DeserializationCluster* cluster;
+    const uint8_t* start;
+    const uint8_t* end;
+  };
+
+  Deserializer* const d_;
+  GrowableArray<Section> sections_;
+  intptr_t total_size_ = 0;
+  RelaxedAtomic<intptr_t> next_ = {0};
+  Monitor monitor_;
+  intptr_t running_tasks_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentFillSections);
+};
+
+class ConcurrentFillTask : public ThreadPool::Task {
+ public:
+  explicit ConcurrentFillTask(ConcurrentFillSections* sections)
+      : sections_(sections) {
+    sections_->TaskStarted();
+  }
+
+  virtual void Run() {
+    sections_->Fill();
+    sections_->TaskFinished();
+  }
+
+ private:
+  ConcurrentFillSections* const sections_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentFillTask);
+};
+
+// Don't bother starting helper tasks when there is little to fill.
+static constexpr intptr_t kMinConcurrentFillSize = 256 * KB;
+
+void Deserializer::ReadFillSections() {
+  if ((FLAG_snapshot_fill_tasks <= 0) || (statistics_ != nullptr)) {
+    for (intptr_t i = 0; i < num_clusters_; i++) {
+      const intptr_t size = Read<uint32_t>();
+      const int64_t start = statistics_ != nullptr
+                                ? OS::GetCurrentMonotonicTicks()
+                                : 0;
+      clusters_[i]->ReadFill(this);
+      if (statistics_ != nullptr) {
+        auto& cluster = statistics_->ClusterAt(i);
+        cluster.fill_size = size;
+        cluster.fill_ticks = OS::GetCurrentMonotonicTicks() - start;
+      }
+#if defined(DEBUG)
+      int32_t section_marker = Read<int32_t>();
+      ASSERT(section_marker == kSectionMarker);
+#endif
+    }
+    return;
+  }
+
+  // Locate every fill section first, so the self-contained ones can be handed
+  // to helper tasks while the rest are filled in order on this thread.
+  intptr_t* positions = zone_->Alloc<intptr_t>(num_clusters_);
+  ConcurrentFillSections concurrent(this);
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    const intptr_t size = Read<uint32_t>();
+    positions[i] = position();
+    if (clusters_[i]->CanFillConcurrently()) {
+      const uint8_t* start = AddressOfCurrentPosition();
+      concurrent.Add(clusters_[i], start, start + size);
+      positions[i] = -1;
+    }
+    Advance(size);
+  }
+  const intptr_t fill_end = position();
+
+  const bool use_tasks = (concurrent.length() > 1) &&
+                         (concurrent.total_size() >= kMinConcurrentFillSize);
+  if (use_tasks) {
+    const intptr_t num_tasks =
+        Utils::Minimum(static_cast<intptr_t>(FLAG_snapshot_fill_tasks),
+                       concurrent.length() - 1);
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      if (!Dart::thread_pool()->Run<ConcurrentFillTask>(&concurrent)) {
+        // The pool is shutting down; this thread fills the sections itself.
+        concurrent.TaskFinished();
+      }
+    }
+  }
+
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    if (positions[i] < 0) continue;
+    set_position(positions[i]);
+    clusters_[i]->ReadFill(this);
+#if defined(DEBUG)
+    int32_t section_marker = Read<int32_t>();
+    ASSERT(section_marker == kSectionMarker);
+#endif
+  }
+
+  // Help out with whatever the helper tasks have not claimed yet.
+  concurrent.Fill();
+  concurrent.WaitForTasks();
+  set_position(fill_end);
+}
+
 void Deserializer::Deserialize(DeserializationRoots* roots) {
   const void* clustered_start = AddressOfCurrentPosition();
+  const intptr_t start_position = position();
+  const int64_t start_ticks =
+      statistics_ != nullptr ? OS::GetCurrentMonotonicTicks() : 0;
 
   Array& refs = Array::Handle(zone_);
   num_base_objects_ = ReadUnsigned();
@@ -9581,8 +10086,19 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
     {
       TIMELINE_DURATION(thread(), Isolate, "ReadAlloc");
       for (intptr_t i = 0; i < num_clusters_; i++) {
+        const intptr_t alloc_start = position();
+        const int64_t alloc_start_ticks =
+            statistics_ != nullptr ? OS::GetCurrentMonotonicTicks() : 0;
         clusters_[i] = ReadCluster();
         clusters_[i]->ReadAlloc(this);
+        if (statistics_ != nullptr) {
+          statistics_->AddCluster(
+              {clusters_[i]->name(), clusters_[i]->is_canonical(),
+               clusters_[i]->num_objects(), position() - alloc_start,
+               /*fill_size=*/0,
+               OS::GetCurrentMonotonicTicks() - alloc_start_ticks,
+               /*fill_ticks=*/0, /*post_load_ticks=*/0});
+        }
 #if defined(DEBUG)
         intptr_t serializers_next_ref_index_ = Read<int32_t>();
         ASSERT_EQUAL(serializers_next_ref_index_, next_ref_index_);
@@ -9595,13 +10111,7 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
 
     {
       TIMELINE_DURATION(thread(), Isolate, "ReadFill");
-      for (intptr_t i = 0; i < num_clusters_; i++) {
-        clusters_[i]->ReadFill(this);
-#if defined(DEBUG)
-        int32_t section_marker = Read<int32_t>();
-        ASSERT(section_marker == kSectionMarker);
-#endif
-      }
+      ReadFillSections();
     }
 
     roots->ReadRoots(this);
@@ -9627,11 +10137,24 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
   {
     TIMELINE_DURATION(thread(), Isolate, "PostLoad");
     for (intptr_t i = 0; i < num_clusters_; i++) {
+      const int64_t post_load_start =
+          statistics_ != nullptr ? OS::GetCurrentMonotonicTicks() : 0;
       clusters_[i]->PostLoad(this, refs);
+      if (statistics_ != nullptr) {
+        statistics_->ClusterAt(i).post_load_ticks =
+            OS::GetCurrentMonotonicTicks() - post_load_start;
+      }
     }
   }
 
-  if (isolate_group->snapshot_is_dontneed_safe()) {
+  if (statistics_ != nullptr) {
+    statistics_->clustered_size = position() - start_position;
+    statistics_->total_ticks = OS::GetCurrentMonotonicTicks() - start_ticks;
+  }
+
+  // An inflated buffer is malloc'ed memory, which madvise would clobber
+  // together with its neighbours.
+  if (isolate_group->snapshot_is_dontneed_safe() && !buffer_is_inflated_) {
     size_t clustered_length =
         reinterpret_cast<uword>(AddressOfCurrentPosition()) -
         reinterpret_cast<uword>(clustered_start);
@@ -9732,6 +10255,7 @@ void FullSnapshotWriter::WriteProgramSnapshot(
   if (units != nullptr) {
     (*units)[LoadingUnit::kRootId]->set_objects(objects);
   }
+  serializer.CompressClusteredData();
   serializer.FillHeader(serializer.kind());
   clustered_isolate_size_ = serializer.bytes_written();
   heap_isolate_size_ = serializer.bytes_heap_allocated();
@@ -9771,6 +10295,7 @@ void FullSnapshotWriter::WriteUnitSnapshot(
   UnitSerializationRoots roots(unit);
   unit->set_objects(serializer.Serialize(&roots));
 
+  serializer.CompressClusteredData();
   serializer.FillHeader(serializer.kind());
   clustered_isolate_size_ = serializer.bytes_written();
 
@@ -9935,12 +10460,26 @@ char* SnapshotHeaderReader::InitializeGlobalVMFlagsFromSnapshot(
   return nullptr;
 }
 
+// Objects pointing into inflated snapshot data keep it alive for as long as
+// the isolate group. Otherwise it is freed once the snapshot has been read.
+static void RetainInflatedData(IsolateGroup* isolate_group,
+                               const Deserializer& deserializer,
+                               ClusteredData* clustered) {
+  if (clustered->is_inflated() && deserializer.references_buffer()) {
+    isolate_group->RetainSnapshotData(clustered->inflated.release());
+  }
+}
+
 ApiErrorPtr FullSnapshotReader::ReadVMSnapshot() {
   SnapshotHeaderReader header_reader(kind_, buffer_, size_);
 
   intptr_t offset = 0;
   char* error = header_reader.VerifyVersionAndFeatures(
       /*isolate_group=*/nullptr, &offset);
+  ClusteredData clustered(buffer_, size_, offset);
+  if (error == nullptr) {
+    error = header_reader.ReadClusteredData(&clustered);
+  }
   if (error != nullptr) {
     return ConvertToApiError(error);
   }
@@ -9950,9 +10489,10 @@ ApiErrorPtr FullSnapshotReader::ReadVMSnapshot() {
   // program lock is held.
   SafepointWriteRwLocker ml(thread_, isolate_group()->program_lock());
 
-  Deserializer deserializer(thread_, kind_, buffer_, size_, data_image_,
-                            instructions_image_, /*is_non_root_unit=*/false,
-                            offset);
+  Deserializer deserializer(thread_, kind_, clustered.buffer, clustered.size,
+                            data_image_, instructions_image_,
+                            /*is_non_root_unit=*/false, clustered.offset);
+  deserializer.set_buffer_is_inflated(clustered.is_inflated());
   ApiErrorPtr api_error = deserializer.VerifyImageAlignment();
   if (api_error != ApiError::null()) {
     return api_error;
@@ -9988,6 +10528,10 @@ ApiErrorPtr FullSnapshotReader::ReadProgramSnapshot() {
   intptr_t offset = 0;
   char* error =
       header_reader.VerifyVersionAndFeatures(thread_->isolate_group(), &offset);
+  ClusteredData clustered(buffer_, size_, offset);
+  if (error == nullptr) {
+    error = header_reader.ReadClusteredData(&clustered);
+  }
   if (error != nullptr) {
     return ConvertToApiError(error);
   }
@@ -9997,9 +10541,10 @@ ApiErrorPtr FullSnapshotReader::ReadProgramSnapshot() {
   // program lock is held.
   SafepointWriteRwLocker ml(thread_, isolate_group()->program_lock());
 
-  Deserializer deserializer(thread_, kind_, buffer_, size_, data_image_,
-                            instructions_image_, /*is_non_root_unit=*/false,
-                            offset);
+  Deserializer deserializer(thread_, kind_, clustered.buffer, clustered.size,
+                            data_image_, instructions_image_,
+                            /*is_non_root_unit=*/false, clustered.offset);
+  deserializer.set_buffer_is_inflated(clustered.is_inflated());
   ApiErrorPtr api_error = deserializer.VerifyImageAlignment();
   if (api_error != ApiError::null()) {
     return api_error;
@@ -10014,8 +10559,19 @@ ApiErrorPtr FullSnapshotReader::ReadProgramSnapshot() {
                                              /* is_executable */ true);
   }
 
+  SnapshotStatistics* statistics = nullptr;
+  if (FLAG_record_snapshot_statistics) {
+    statistics = new SnapshotStatistics();
+    deserializer.set_statistics(statistics);
+  }
+
   ProgramDeserializationRoots roots(thread_->isolate_group()->object_store());
   deserializer.Deserialize(&roots);
+  RetainInflatedData(thread_->isolate_group(), deserializer, &clustered);
+
+  if (statistics != nullptr) {
+    thread_->isolate_group()->set_snapshot_statistics(statistics);
+  }
 
   if (Snapshot::IncludesCode(kind_)) {
     const auto& units = Array::Handle(
@@ -10041,13 +10597,19 @@ ApiErrorPtr FullSnapshotReader::ReadUnitSnapshot(const LoadingUnit& unit) {
   intptr_t offset = 0;
   char* error =
       header_reader.VerifyVersionAndFeatures(thread_->isolate_group(), &offset);
+  ClusteredData clustered(buffer_, size_, offset);
+  if (error == nullptr) {
+    error = header_reader.ReadClusteredData(&clustered);
+  }
   if (error != nullptr) {
     return ConvertToApiError(error);
   }
 
   Deserializer deserializer(
-      thread_, kind_, buffer_, size_, data_image_, instructions_image_,
-      /*is_non_root_unit=*/unit.id() != LoadingUnit::kRootId, offset);
+      thread_, kind_, clustered.buffer, clustered.size, data_image_,
+      instructions_image_,
+      /*is_non_root_unit=*/unit.id() != LoadingUnit::kRootId, clustered.offset);
+  deserializer.set_buffer_is_inflated(clustered.is_inflated());
   ApiErrorPtr api_error = deserializer.VerifyImageAlignment();
   if (api_error != ApiError::null()) {
     return api_error;
@@ -10076,6 +10638,7 @@ ApiErrorPtr FullSnapshotReader::ReadUnitSnapshot(const LoadingUnit& unit) {
 
   UnitDeserializationRoots roots(unit);
   deserializer.Deserialize(&roots);
+  RetainInflatedData(thread_->isolate_group(), deserializer, &clustered);
 
   InitializeBSS();
 
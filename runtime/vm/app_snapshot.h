@@ -67,6 +67,53 @@ class LoadingUnitSerializationData : public ZoneAllocated {
   ZoneGrowableArray<Object*>* objects_;
 };
 
+// The clustered part of a snapshot, which follows its version and features.
+// It is inflated into a separate buffer if it was written compressed.
+struct ClusteredData {
+  ClusteredData(const uint8_t* buffer, intptr_t size, intptr_t offset)
+      : buffer(buffer), size(size), offset(offset) {}
+
+  const uint8_t* buffer;
+  intptr_t size;
+  intptr_t offset;
+  CAllocUniquePtr<uint8_t> inflated;
+
+  bool is_inflated() const { return inflated != nullptr; }
+};
+
+// Sizes and read times of the clusters of a program snapshot, recorded while
+// it is deserialized if --record_snapshot_statistics is set. Times are in
+// OS::GetCurrentMonotonicTicks units.
+class SnapshotStatistics {
+ public:
+  struct Cluster {
+    const char* name;
+    bool is_canonical;
+    intptr_t num_objects;
+    // Bytes of the alloc and fill sections of the cluster.
+    intptr_t alloc_size;
+    intptr_t fill_size;
+    int64_t alloc_ticks;
+    int64_t fill_ticks;
+    int64_t post_load_ticks;
+  };
+
+  SnapshotStatistics() {}
+
+  const MallocGrowableArray<Cluster>& clusters() const { return clusters_; }
+  Cluster& ClusterAt(intptr_t index) { return clusters_[index]; }
+  void AddCluster(const Cluster& cluster) { clusters_.Add(cluster); }
+
+  // Size of the clustered data and total time to deserialize it.
+  intptr_t clustered_size = 0;
+  int64_t total_ticks = 0;
+
+ private:
+  MallocGrowableArray<Cluster> clusters_;
+
+  DISALLOW_COPY_AND_ASSIGN(SnapshotStatistics);
+};
+
 // This class can be used to read version and features from a snapshot before
 // the VM has been initialized.
 class SnapshotHeaderReader {
@@ -95,6 +142,12 @@ class SnapshotHeaderReader {
   // features.
   char* VerifyVersionAndFeatures(IsolateGroup* isolate_group, intptr_t* offset);
 
+  // Reads how the clustered data after the features is stored, and inflates
+  // it if it is compressed. Must be called after VerifyVersionAndFeatures.
+  //
+  // Returns null on success and a malloc()ed error on failure.
+  char* ReadClusteredData(ClusteredData* data);
+
  private:
   char* VerifyVersion();
   char* ReadFeatures(const char** features, intptr_t* features_length);
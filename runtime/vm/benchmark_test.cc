@@ -4,6 +4,16 @@
 
 #include "vm/benchmark_test.h"
 
+#if defined(DART_HOST_OS_LINUX)
+#include <linux/perf_event.h>  // NOLINT
+#include <sys/ioctl.h>         // NOLINT
+#include <sys/syscall.h>       // NOLINT
+#include <unistd.h>            // NOLINT
+#endif
+
+#include <algorithm>
+#include <cmath>
+
 #include "bin/builtin.h"
 #include "bin/file.h"
 #include "bin/isolate_data.h"
@@ -18,14 +28,28 @@
 #include "vm/app_snapshot.h"
 #include "vm/dart_api_impl.h"
 #include "vm/datastream.h"
+#include "vm/hash_table.h"
+#include "vm/json_writer.h"
 #include "vm/message_snapshot.h"
 #include "vm/stack_frame.h"
+#include "vm/symbols.h"
 #include "vm/timer.h"
 
 using dart::bin::File;
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            benchmark_repetitions,
+            1,
+            "Number of times each benchmark is run. The median score is "
+            "reported.");
+DEFINE_FLAG(charp,
+            benchmark_json,
+            nullptr,
+            "Append the statistics of each benchmark run as a line of JSON "
+            "to this file.");
+
 Benchmark* Benchmark::first_ = nullptr;
 Benchmark* Benchmark::tail_ = nullptr;
 const char* Benchmark::executable_ = nullptr;
@@ -39,6 +63,163 @@ void Benchmark::RunAll(const char* executable) {
   }
 }
 
+BenchmarkCounters::BenchmarkCounters() {
+  for (intptr_t i = 0; i < kNumHardwareCounters; i++) {
+    fds_[i] = -1;
+  }
+  for (intptr_t i = 0; i < kNumCounters; i++) {
+    values_[i] = -1;
+  }
+}
+
+const char* BenchmarkCounters::Name(Counter counter) {
+  switch (counter) {
+    case kCycles:
+      return "cycles";
+    case kInstructions:
+      return "instructions";
+    case kL1DataMisses:
+      return "l1d_misses";
+    case kLastLevelCacheMisses:
+      return "llc_misses";
+    case kAllocatedBytes:
+      return "allocated_bytes";
+    default:
+      UNREACHABLE();
+      return nullptr;
+  }
+}
+
+#if defined(DART_HOST_OS_LINUX)
+static int OpenPerfCounter(uint32_t type, uint64_t config) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // Only the current thread, on any CPU.
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif  // defined(DART_HOST_OS_LINUX)
+
+void BenchmarkCounters::Start() {
+#if defined(DART_HOST_OS_LINUX)
+  fds_[kCycles] = OpenPerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  fds_[kInstructions] =
+      OpenPerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[kL1DataMisses] = OpenPerfCounter(
+      PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                              (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+  fds_[kLastLevelCacheMisses] =
+      OpenPerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  for (intptr_t i = 0; i < kNumHardwareCounters; i++) {
+    if (fds_[i] >= 0) {
+      ioctl(fds_[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif  // defined(DART_HOST_OS_LINUX)
+  start_allocated_in_words_ =
+      Thread::Current()->heap()->TotalAllocatedInWords();
+}
+
+void BenchmarkCounters::Stop() {
+  values_[kAllocatedBytes] =
+      (Thread::Current()->heap()->TotalAllocatedInWords() -
+       start_allocated_in_words_) *
+      kWordSize;
+  for (intptr_t i = 0; i < kNumHardwareCounters; i++) {
+    values_[i] = -1;
+#if defined(DART_HOST_OS_LINUX)
+    if (fds_[i] < 0) continue;
+    ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+    uint64_t value;
+    if (read(fds_[i], &value, sizeof(value)) == sizeof(value)) {
+      values_[i] = static_cast<int64_t>(value);
+    }
+    close(fds_[i]);
+    fds_[i] = -1;
+#endif  // defined(DART_HOST_OS_LINUX)
+  }
+}
+
+static int64_t Median(MallocGrowableArray<int64_t>* values) {
+  values->Sort([](const int64_t* a, const int64_t* b) {
+    return (*a < *b) ? -1 : ((*a > *b) ? 1 : 0);
+  });
+  return values->At(values->length() / 2);
+}
+
+int64_t Benchmark::RunRepeated() {
+  const intptr_t repetitions = Utils::Maximum(1, FLAG_benchmark_repetitions);
+  MallocGrowableArray<int64_t> scores(repetitions);
+  // Per iteration, for the runs in which the counter was available.
+  MallocGrowableArray<int64_t> counters[BenchmarkCounters::kNumCounters];
+  for (intptr_t r = 0; r < repetitions; r++) {
+    iterations_ = 1;
+    Run();
+    scores.Add(score());
+    for (intptr_t i = 0; i < BenchmarkCounters::kNumCounters; i++) {
+      const auto counter = static_cast<BenchmarkCounters::Counter>(i);
+      if (counters_.IsAvailable(counter)) {
+        counters[i].Add(counters_.value(counter) /
+                        Utils::Maximum<int64_t>(1, iterations_));
+      }
+    }
+  }
+
+  double mean = 0;
+  for (intptr_t r = 0; r < repetitions; r++) {
+    mean += static_cast<double>(scores[r]) / repetitions;
+  }
+  double variance = 0;
+  for (intptr_t r = 0; r < repetitions; r++) {
+    const double delta = scores[r] - mean;
+    variance += delta * delta / repetitions;
+  }
+  const int64_t median = Median(&scores);
+
+  if (FLAG_benchmark_json != nullptr) {
+    JSONWriter writer;
+    writer.OpenObject();
+    writer.PrintProperty("name", name());
+    writer.PrintProperty("kind", score_kind());
+    writer.PrintProperty("repetitions", repetitions);
+    writer.PrintProperty64("iterations", iterations_);
+    writer.OpenObject("score");
+    writer.PrintProperty64("min", scores[0]);
+    writer.PrintProperty64("median", median);
+    writer.PrintProperty64("max", scores[repetitions - 1]);
+    writer.PrintProperty("mean", mean);
+    writer.PrintProperty("stddev", sqrt(variance));
+    writer.CloseObject();
+    // Medians per iteration.
+    writer.OpenObject("counters");
+    for (intptr_t i = 0; i < BenchmarkCounters::kNumCounters; i++) {
+      if (!counters[i].is_empty()) {
+        writer.PrintProperty64(
+            BenchmarkCounters::Name(static_cast<BenchmarkCounters::Counter>(i)),
+            Median(&counters[i]));
+      }
+    }
+    writer.CloseObject();
+    writer.CloseObject();
+
+    FILE* file = fopen(FLAG_benchmark_json, "a");
+    if (file == nullptr) {
+      OS::PrintErr("Could not open %s\n", FLAG_benchmark_json);
+    } else {
+      fprintf(file, "%s\n", writer.ToCString());
+      fclose(file);
+    }
+  }
+  return median;
+}
+
 //
 // Measure compile of all functions in dart core lib classes.
 //
@@ -569,6 +750,99 @@ BENCHMARK(LargeMap) {
   benchmark->set_score(elapsed_time);
 }
 
+//
+// Measure lookups of existing symbols.
+//
+BENCHMARK(SymbolsLookup) {
+  const intptr_t kNumSymbols = 1000;
+  const intptr_t kLoopCount = 100;
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  char** names = zone.GetZone()->Alloc<char*>(kNumSymbols);
+  for (intptr_t i = 0; i < kNumSymbols; i++) {
+    names[i] = OS::SCreate(zone.GetZone(), "benchmarkSymbol%" Pd, i);
+    Symbols::New(thread, names[i]);
+  }
+  String& symbol = String::Handle(zone.GetZone());
+  Timer timer;
+  timer.Start();
+  for (intptr_t i = 0; i < kLoopCount; i++) {
+    for (intptr_t j = 0; j < kNumSymbols; j++) {
+      symbol = Symbols::New(thread, names[j]);
+    }
+  }
+  timer.Stop();
+  benchmark->set_iterations(kLoopCount * kNumSymbols);
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+class BenchmarkSmiTraits {
+ public:
+  static const char* Name() { return "BenchmarkSmiTraits"; }
+  static bool ReportStats() { return false; }
+
+  static bool IsMatch(const Object& a, const Object& b) {
+    return Smi::Cast(a).Value() == Smi::Cast(b).Value();
+  }
+  static uword Hash(const Object& obj) {
+    return Utils::WordHash(Smi::Cast(obj).Value());
+  }
+};
+
+//
+// Measure insertion into and lookups in a growing HashTable.
+//
+BENCHMARK(HashTableInsertLookup) {
+  const intptr_t kNumKeys = 10000;
+  const intptr_t kLoopCount = 10;
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  Smi& key = Smi::Handle(zone.GetZone());
+  Object& value = Object::Handle(zone.GetZone());
+  Timer timer;
+  timer.Start();
+  for (intptr_t i = 0; i < kLoopCount; i++) {
+    UnorderedHashMap<BenchmarkSmiTraits> map(
+        HashTables::New<UnorderedHashMap<BenchmarkSmiTraits>>(16));
+    for (intptr_t j = 0; j < kNumKeys; j++) {
+      key = Smi::New(j);
+      map.UpdateOrInsert(key, key);
+    }
+    for (intptr_t j = 0; j < kNumKeys; j++) {
+      key = Smi::New(j);
+      value = map.GetOrNull(key);
+    }
+    map.Release();
+  }
+  timer.Stop();
+  benchmark->set_iterations(kLoopCount * kNumKeys);
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
+//
+// Measure small zone allocations, including the release of the zones.
+//
+BENCHMARK(ZoneAllocation) {
+  const intptr_t kNumAllocations = 10000;
+  const intptr_t kLoopCount = 100;
+  TransitionNativeToVM transition(thread);
+  uword checksum = 0;
+  Timer timer;
+  timer.Start();
+  for (intptr_t i = 0; i < kLoopCount; i++) {
+    StackZone zone(thread);
+    for (intptr_t j = 0; j < kNumAllocations; j++) {
+      uword* data = zone.GetZone()->Alloc<uword>(1 + (j & 7));
+      data[0] = j;
+      checksum += reinterpret_cast<uword>(data);
+    }
+  }
+  timer.Stop();
+  EXPECT(checksum != 0);
+  benchmark->set_iterations(kLoopCount * kNumAllocations);
+  benchmark->set_score(timer.TotalElapsedTime());
+}
+
 BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
@@ -39,7 +39,9 @@ extern const uint8_t* core_isolate_snapshot_instructions;
     BenchmarkIsolateScope __isolate__(benchmark);                              \
     Thread* __thread__ = Thread::Current();                                    \
     ASSERT(__thread__->isolate() == benchmark->isolate());                     \
+    benchmark->counters()->Start();                                            \
     Dart_BenchmarkHelper##name(benchmark, __thread__);                         \
+    benchmark->counters()->Stop();                                             \
   }                                                                            \
   static void Dart_BenchmarkHelper##name(Benchmark* benchmark, Thread* thread)
 
@@ -51,6 +53,43 @@ inline Dart_Handle NewString(const char* str) {
   return Dart_NewStringFromCString(str);
 }
 
+// Hardware performance counters of the current thread (via perf_event_open
+// on Linux) and the allocation in the current isolate group, measured
+// between Start and Stop.
+class BenchmarkCounters {
+ public:
+  enum Counter {
+    kCycles,
+    kInstructions,
+    kL1DataMisses,
+    kLastLevelCacheMisses,
+    kAllocatedBytes,
+    kNumCounters,
+  };
+
+  BenchmarkCounters();
+
+  // The hardware counters are opened in Start and closed in Stop.
+  void Start();
+  void Stop();
+
+  // Whether the counter could be read, e.g. hardware counters are not
+  // available in most virtual machines.
+  bool IsAvailable(Counter counter) const { return values_[counter] >= 0; }
+  int64_t value(Counter counter) const { return values_[counter]; }
+
+  static const char* Name(Counter counter);
+
+ private:
+  static constexpr intptr_t kNumHardwareCounters = kAllocatedBytes;
+
+  int fds_[kNumHardwareCounters];
+  int64_t values_[kNumCounters];
+  int64_t start_allocated_in_words_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(BenchmarkCounters);
+};
+
 class Benchmark {
  public:
   typedef void(RunEntry)(Benchmark* benchmark);
@@ -60,6 +99,7 @@ class Benchmark {
         name_(name),
         score_kind_(score_kind),
         score_(0),
+        iterations_(1),
         isolate_(nullptr),
         next_(nullptr) {
     if (first_ == nullptr) {
@@ -75,11 +115,20 @@ class Benchmark {
   const char* score_kind() const { return score_kind_; }
   void set_score(int64_t value) { score_ = value; }
   int64_t score() const { return score_; }
+  // The number of iterations of the measured operation in one run, which the
+  // counters are divided by. Defaults to 1.
+  void set_iterations(int64_t value) { iterations_ = value; }
+  int64_t iterations() const { return iterations_; }
+  BenchmarkCounters* counters() { return &counters_; }
   Isolate* isolate() const { return reinterpret_cast<Isolate*>(isolate_); }
 
   void Run() { (*run_)(this); }
   void RunBenchmark();
 
+  // Runs the benchmark --benchmark_repetitions times and returns the median
+  // score. The statistics of all runs are appended to --benchmark_json.
+  int64_t RunRepeated();
+
   static void RunAll(const char* executable);
   static void SetExecutable(const char* arg) { executable_ = arg; }
   static const char* Executable() { return executable_; }
@@ -98,6 +147,8 @@ class Benchmark {
   const char* name_;
   const char* score_kind_;
   int64_t score_;
+  int64_t iterations_;
+  BenchmarkCounters counters_;
   Dart_Isolate isolate_;
   Benchmark* next_;
 
@@ -115,6 +115,7 @@ namespace dart {
   V(List_setIndexed, 3)                                                        \
   V(List_getLength, 1)                                                         \
   V(List_slice, 4)                                                             \
+  V(List_copyRange, 5)                                                         \
   V(ImmutableList_from, 4)                                                     \
   V(StringBase_createFromCodePoints, 3)                                        \
   V(StringBase_substringUnchecked, 3)                                          \
@@ -122,6 +123,7 @@ namespace dart {
   V(StringBase_intern, 1)                                                      \
   V(StringBuffer_createStringFromUint16Array, 3)                               \
   V(OneByteString_substringUnchecked, 3)                                       \
+  V(OneByteString_indexOf, 3)                                                  \
   V(OneByteString_allocateFromOneByteList, 3)                                  \
   V(TwoByteString_allocateFromTwoByteList, 3)                                  \
   V(String_getHashCode, 1)                                                     \
@@ -151,6 +153,8 @@ namespace dart {
   V(Timeline_reportTaskEvent, 5)                                               \
   V(TypedDataBase_length, 1)                                                   \
   V(TypedDataBase_setClampedRange, 5)                                          \
+  V(TypedDataBase_fillBytes, 4)                                                \
+  V(TypedDataBase_indexOfByte, 3)                                              \
   V(TypedData_GetFloat32, 2)                                                   \
   V(TypedData_SetFloat32, 3)                                                   \
   V(TypedData_GetFloat64, 2)                                                   \
@@ -296,6 +300,7 @@ namespace dart {
   V(VMService_AddUserTagsToStreamableSampleList, 1)                            \
   V(VMService_RemoveUserTagsFromStreamableSampleList, 1)                       \
   V(Ffi_createNativeCallableListener, 2)                                       \
+  V(Ffi_takeNativeCallableListenerBatch, 1)                                    \
   V(Ffi_createNativeCallableIsolateLocal, 3)                                   \
   V(Ffi_deleteNativeCallable, 1)                                               \
   V(Ffi_updateNativeCallableKeepIsolateAliveCounter, 1)                        \
@@ -371,8 +376,15 @@ namespace dart {
   V(ConditionVariable_NotifyAll, void, (Dart_Handle))                          \
   V(ConditionVariable_Wait, void, (Dart_Handle, Dart_Handle))                  \
   V(FinalizerEntry_SetExternalSize, void, (Dart_Handle, intptr_t))             \
+  V(Int64ListAtomics_CompareExchange, int64_t,                                 \
+    (int64_t*, intptr_t, int64_t, int64_t))                                    \
+  V(Int64ListAtomics_FetchAdd, int64_t, (int64_t*, intptr_t, int64_t))         \
+  V(Int64ListAtomics_LoadAcquire, int64_t, (int64_t*, intptr_t))               \
+  V(Int64ListAtomics_StoreRelease, void, (int64_t*, intptr_t, int64_t))        \
   V(Mutex_Initialize, void, (Dart_Handle))                                     \
-  V(Mutex_RunLocked, Dart_Handle, (Dart_Handle, Dart_Handle))                  \
+  V(Mutex_Lock, void, (void*))                                                 \
+  V(Mutex_TryLock, bool, (void*))                                              \
+  V(Mutex_Unlock, void, (void*))                                               \
   V(Pointer_asTypedListFinalizerAllocateData, void*, ())                       \
   V(Pointer_asTypedListFinalizerCallbackPointer, void*, ())
 
@@ -34,6 +34,11 @@
 namespace dart {
 
 DEFINE_FLAG(bool, dump_kernel_bytecode, false, "Dump kernel bytecode");
+DEFINE_FLAG(bool,
+            lazy_bytecode_functions,
+            true,
+            "Read the bytecode of functions in dynamic modules when the "
+            "functions are first called instead of when the module is loaded.");
 
 namespace bytecode {
 
@@ -75,6 +80,26 @@ BytecodeLoader::BytecodeLoader(Thread* thread, const TypedDataBase& binary)
   ASSERT(binary_.IsExternalOrExternalView());
 }
 
+static TypedDataBasePtr ModuleBinary(const Array& module) {
+  const auto& component = Array::Handle(
+      Array::RawCast(module.At(BytecodeLoader::kModuleComponent)));
+  return BytecodeComponentData(component).GetTypedData();
+}
+
+BytecodeLoader::BytecodeLoader(Thread* thread, const Array& module)
+    : thread_(thread),
+      binary_(TypedDataBase::Handle(thread->zone(), ModuleBinary(module))),
+      bytecode_component_array_(Array::Handle(
+          thread->zone(),
+          Array::RawCast(module.At(kModuleComponent)))),
+      bytecode_offsets_map_(Array::Handle(
+          thread->zone(),
+          Array::RawCast(module.At(kModuleOffsets)))) {
+  ASSERT(thread_ == Thread::Current());
+  ASSERT(thread_->bytecode_loader() == nullptr);
+  thread_->set_bytecode_loader(this);
+}
+
 BytecodeLoader::~BytecodeLoader() {
   ASSERT(thread_->bytecode_loader() == this);
   thread_->set_bytecode_loader(nullptr);
@@ -92,6 +117,21 @@ FunctionPtr BytecodeLoader::LoadBytecode() {
                               bytecode_component.GetLibraryIndexOffset());
   bytecode_reader.ReadLibraryDeclarations(bytecode_component.GetNumLibraries());
 
+  if (FLAG_lazy_bytecode_functions) {
+    Zone* zone = thread_->zone();
+    ObjectStore* object_store = thread_->isolate_group()->object_store();
+    auto& modules = GrowableObjectArray::Handle(
+        zone, object_store->lazy_bytecode_modules());
+    if (modules.IsNull()) {
+      modules = GrowableObjectArray::New(Heap::kOld);
+      object_store->set_lazy_bytecode_modules(modules);
+    }
+    const auto& module = Array::Handle(zone, Array::New(kModuleSize));
+    module.SetAt(kModuleComponent, bytecode_component_array_);
+    module.SetAt(kModuleOffsets, bytecode_offsets_map_);
+    modules.Add(module, Heap::kOld);
+  }
+
   if (bytecode_component.GetMainOffset() == 0) {
     return Function::null();
   }
@@ -116,6 +156,13 @@ intptr_t BytecodeLoader::GetOffset(const Object& obj) {
   return offset;
 }
 
+intptr_t BytecodeLoader::LookupOffset(const Object& obj) {
+  BytecodeOffsetsMap map(bytecode_offsets_map_.ptr());
+  const auto value = map.GetOrNull(obj);
+  ASSERT(map.Release().ptr() == bytecode_offsets_map_.ptr());
+  return value == Object::null() ? -1 : Smi::Value(Smi::RawCast(value));
+}
+
 BytecodeReaderHelper::BytecodeReaderHelper(Thread* thread,
                                            const TypedDataBase& typed_data)
     : reader_(typed_data),
@@ -2159,6 +2206,21 @@ void BytecodeReaderHelper::ReadLibraryDeclarations(intptr_t num_libraries) {
       Exceptions::PropagateError(error);
       UNREACHABLE();
     }
+    if (FLAG_lazy_bytecode_functions) {
+      // Bodies are read by ReadLazyBytecode, which finds initializers by
+      // their function.
+      members = cls.fields();
+      for (intptr_t j = 0, m = members.Length(); j < m; ++j) {
+        field ^= members.At(j);
+        if ((field.is_static() || field.is_late()) &&
+            field.has_nontrivial_initializer()) {
+          function = field.EnsureInitializerFunction();
+          BytecodeLoader* loader = thread_->bytecode_loader();
+          loader->SetOffset(function, loader->GetOffset(field));
+        }
+      }
+      continue;
+    }
     members = cls.functions();
     for (intptr_t j = 0, m = members.Length(); j < m; ++j) {
       function ^= members.At(j);
@@ -2447,6 +2509,53 @@ void BytecodeReader::FinishClassLoading(const Class& cls) {
   bytecode_reader.ReadMembers(cls, discard_fields);
 }
 
+// Returns the code offset of [function] and the module containing it, or -1
+// if the body of [function] is not read lazily.
+static intptr_t FindLazyFunction(Thread* thread,
+                                 const Function& function,
+                                 Array* module) {
+  Zone* zone = thread->zone();
+  const auto& modules = GrowableObjectArray::Handle(
+      zone, thread->isolate_group()->object_store()->lazy_bytecode_modules());
+  if (modules.IsNull()) {
+    return -1;
+  }
+  auto& offsets = Array::Handle(zone);
+  for (intptr_t i = 0, n = modules.Length(); i < n; ++i) {
+    *module ^= modules.At(i);
+    offsets ^= module->At(BytecodeLoader::kModuleOffsets);
+    BytecodeOffsetsMap map(offsets.ptr());
+    const auto value = map.GetOrNull(function);
+    map.Release();
+    if (value != Object::null()) {
+      return Smi::Value(Smi::RawCast(value));
+    }
+  }
+  return -1;
+}
+
+bool BytecodeReader::ReadLazyBytecode(const Function& function) {
+  ASSERT(!function.is_abstract());
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  SafepointWriteRwLocker ml(thread, thread->isolate_group()->program_lock());
+  if (function.HasBytecode()) {
+    // Read by another thread.
+    return true;
+  }
+  auto& module = Array::Handle(zone);
+  const intptr_t offset = FindLazyFunction(thread, function, &module);
+  if (offset < 0) {
+    return false;
+  }
+  BytecodeLoader loader(thread, module);
+  BytecodeComponentData bytecode_component(
+      Array::Handle(zone, loader.bytecode_component_array()));
+  BytecodeReaderHelper bytecode_reader(thread, &bytecode_component);
+  bytecode_reader.ReadCode(function, offset);
+  return true;
+}
+
 void BytecodeReader::ReadParameterCovariance(
     const Function& function,
     BitVector* is_covariant,
@@ -2469,9 +2578,16 @@ void BytecodeReader::ReadParameterCovariance(
   const auto& bytecode = Bytecode::Handle(zone, function.GetBytecode());
   if (bytecode.IsNull()) {
     BytecodeLoader* loader = thread->bytecode_loader();
-    ASSERT(loader != nullptr);
-    binary = loader->binary();
-    offset = loader->GetOffset(function);
+    if (loader != nullptr) {
+      binary = loader->binary();
+      offset = loader->GetOffset(function);
+    } else {
+      // The body of the function is read lazily.
+      auto& module = Array::Handle(zone);
+      offset = FindLazyFunction(thread, function, &module);
+      RELEASE_ASSERT(offset > 0);
+      binary = ModuleBinary(module);
+    }
   } else {
     binary = bytecode.binary();
     ASSERT(!binary.IsNull());
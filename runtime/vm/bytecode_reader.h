@@ -20,7 +20,17 @@ class BytecodeComponentData;
 
 class BytecodeLoader {
  public:
+  // Loader state which is retained after loading a module, so that
+  // function bodies can be read when the functions are first called.
+  enum {
+    kModuleComponent,
+    kModuleOffsets,
+    kModuleSize,
+  };
+
   BytecodeLoader(Thread* thread, const TypedDataBase& binary);
+  // Restores the loader of a module retained by LoadBytecode.
+  BytecodeLoader(Thread* thread, const Array& module);
   ~BytecodeLoader();
 
   FunctionPtr LoadBytecode();
@@ -32,6 +42,8 @@ class BytecodeLoader {
 
   void SetOffset(const Object& obj, intptr_t offset);
   intptr_t GetOffset(const Object& obj);
+  // Returns -1 if no offset was recorded for |obj|.
+  intptr_t LookupOffset(const Object& obj);
 
  private:
   Thread* thread_;
@@ -466,6 +478,11 @@ class BytecodeReader : public AllStatic {
   static void ReadParameterCovariance(const Function& function,
                                       BitVector* is_covariant,
                                       BitVector* is_generic_covariant_impl);
+
+  // Reads the bytecode of a function whose body was not read when its
+  // module was loaded (see --lazy_bytecode_functions). Returns false if
+  // [function] has no such body.
+  static bool ReadLazyBytecode(const Function& function);
 };
 
 class BytecodeSourcePositionsIterator : ValueObject {
@@ -23,6 +23,7 @@ class CharArray {
     result.SetHash(hash_);
     return result.ptr();
   }
+  bool ToSymbolReusesString() const { return false; }
   bool Equals(const String& other) const {
     ASSERT(other.HasHash());
     if (other.Hash() != hash_) {
@@ -48,6 +49,9 @@ class StringSlice {
     hash_ = is_all() ? str.Hash() : String::Hash(str, begin_index, length);
   }
   StringPtr ToSymbol() const;
+  // Whether ToSymbol canonicalizes the original string in place instead of
+  // allocating a new one.
+  bool ToSymbolReusesString() const { return is_all() && str_.IsOld(); }
   bool Equals(const String& other) const {
     ASSERT(other.HasHash());
     if (other.Hash() != hash_) {
@@ -70,6 +74,7 @@ class ConcatString {
   ConcatString(const String& str1, const String& str2)
       : str1_(str1), str2_(str2), hash_(String::HashConcat(str1, str2)) {}
   StringPtr ToSymbol() const;
+  bool ToSymbolReusesString() const { return false; }
   bool Equals(const String& other) const {
     ASSERT(other.HasHash());
     if (other.Hash() != hash_) {
@@ -116,6 +121,9 @@ class SymbolTraits {
     return concat.Equals(String::Cast(obj));
   }
   static uword Hash(const Object& key) { return String::Cast(key).Hash(); }
+  static uword CachedHash(ObjectPtr key) {
+    return String::GetCachedHash(static_cast<StringPtr>(key));
+  }
   template <typename CharType>
   static uword Hash(const CharArray<CharType>& array) {
     return array.Hash();
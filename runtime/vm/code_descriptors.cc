@@ -748,6 +748,102 @@ void CodeSourceMapReader::DumpInlineIntervals(uword start) {
   THR_Print("}\n");
 }
 
+void CodeSourceMapReader::AddInlinedCalleeSizes(
+    GrowableArray<intptr_t>* sizes) {
+  ASSERT(sizes->length() == functions_.Length());
+  GrowableArray<int32_t> function_stack;
+  NoSafepointScope no_safepoint;
+  ReadStream stream(map_.Data(), map_.Length());
+
+  while (stream.PendingBytes() > 0) {
+    int32_t arg;
+    const uint8_t opcode = CodeSourceMapOps::Read(&stream, &arg);
+    switch (opcode) {
+      case CodeSourceMapOps::kAdvancePC: {
+        if (!function_stack.is_empty()) {
+          (*sizes)[function_stack[0]] += arg;
+        }
+        break;
+      }
+      case CodeSourceMapOps::kPushFunction: {
+        function_stack.Add(arg);
+        break;
+      }
+      case CodeSourceMapOps::kPopFunction: {
+        // We never pop the root function.
+        ASSERT(!function_stack.is_empty());
+        function_stack.RemoveLast();
+        break;
+      }
+      case CodeSourceMapOps::kChangePosition:
+      case CodeSourceMapOps::kNullCheck: {
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
+void CodeSourceMapReader::GetSourcePositions(
+    GrowableArray<int32_t>* pc_offsets,
+    GrowableArray<const Function*>* functions,
+    GrowableArray<TokenPosition>* token_positions) {
+  GrowableArray<const Function*> function_stack;
+  GrowableArray<TokenPosition> position_stack;
+  NoSafepointScope no_safepoint;
+  ReadStream stream(map_.Data(), map_.Length());
+
+  int32_t current_pc_offset = 0;
+  function_stack.Add(&root_);
+  position_stack.Add(InitialPosition());
+
+  while (stream.PendingBytes() > 0) {
+    int32_t arg;
+    const uint8_t opcode = CodeSourceMapOps::Read(&stream, &arg);
+    switch (opcode) {
+      case CodeSourceMapOps::kChangePosition: {
+        const TokenPosition& old_token = position_stack.Last();
+        position_stack.Last() = TokenPosition::Deserialize(
+            Utils::AddWithWrapAround(arg, old_token.Serialize()));
+        break;
+      }
+      case CodeSourceMapOps::kAdvancePC: {
+        // Skip empty ranges, like the one describing the function entry.
+        if (arg == 0) break;
+        if (functions->is_empty() ||
+            functions->Last() != function_stack.Last() ||
+            token_positions->Last() != position_stack.Last()) {
+          pc_offsets->Add(current_pc_offset);
+          functions->Add(function_stack.Last());
+          token_positions->Add(position_stack.Last());
+        }
+        current_pc_offset += arg;
+        break;
+      }
+      case CodeSourceMapOps::kPushFunction: {
+        function_stack.Add(
+            &Function::Handle(Function::RawCast(functions_.At(arg))));
+        position_stack.Add(InitialPosition());
+        break;
+      }
+      case CodeSourceMapOps::kPopFunction: {
+        // We never pop the root function.
+        ASSERT(function_stack.length() > 1);
+        ASSERT(position_stack.length() > 1);
+        function_stack.RemoveLast();
+        position_stack.RemoveLast();
+        break;
+      }
+      case CodeSourceMapOps::kNullCheck: {
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
 void CodeSourceMapReader::DumpSourcePositions(uword start) {
   GrowableArray<const Function*> function_stack;
   GrowableArray<TokenPosition> token_positions;
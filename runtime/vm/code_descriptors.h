@@ -342,8 +342,20 @@ class CodeSourceMapReader : public ValueObject {
                              GrowableArray<TokenPosition>* token_positions);
   NOT_IN_PRODUCT(void PrintJSONInlineIntervals(JSONObject* jsobj));
   void DumpInlineIntervals(uword start);
+
+  // Adds the size of the instructions of each function inlined directly into
+  // the root function, including the functions inlined into it, to the entry
+  // of |sizes| at the index of the function in |functions|.
+  void AddInlinedCalleeSizes(GrowableArray<intptr_t>* sizes);
+
   void DumpSourcePositions(uword start);
 
+  // Appends the PC offset at which each range of instructions starts together
+  // with the innermost function and token position of that range.
+  void GetSourcePositions(GrowableArray<int32_t>* pc_offsets,
+                          GrowableArray<const Function*>* functions,
+                          GrowableArray<TokenPosition>* token_positions);
+
   intptr_t GetNullCheckNameIndexAt(int32_t pc_offset);
 
  private:
@@ -13,6 +13,7 @@
 #if !defined(PRODUCT)
 namespace dart {
 
+class Code;
 class CodeComments;
 
 // Object observing code creation events. Used by external profilers and
@@ -27,14 +28,15 @@ class CodeObserver {
   // about newly created code objects.
   virtual bool IsActive() const = 0;
 
-  // Notify code observer about a newly created code object with the
+  // Notify code observer about a newly created code object |code| with the
   // given properties.
   virtual void Notify(const char* name,
                       uword base,
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) = 0;
+                      const CodeComments* comments,
+                      const Code& code) = 0;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(CodeObserver);
@@ -56,7 +58,8 @@ class CodeObservers : public AllStatic {
                         uword prologue_offset,
                         uword size,
                         bool optimized,
-                        const CodeComments* comments);
+                        const CodeComments* comments,
+                        const Code& code);
 
   // Returns true if there is at least one active code observer.
   static bool AreActive();
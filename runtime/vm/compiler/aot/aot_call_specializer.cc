@@ -7,6 +7,7 @@
 #include <utility>
 
 #include "vm/bit_vector.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
@@ -39,6 +40,9 @@ DEFINE_FLAG(int,
             "If a call receiver is known to be of at most this many classes, "
             "generate exhaustive class tests instead of a megamorphic call");
 
+DECLARE_FLAG(int, aot_profile_min_coverage);
+DECLARE_FLAG(bool, trace_aot_profile);
+
 // Quick access to the current isolate and zone.
 #define IG (isolate_group())
 #define Z (zone())
@@ -964,6 +968,10 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
     }
   }
 
+  if (targets.is_empty() && TryDevirtualizeUsingProfile(instr)) {
+    return;
+  }
+
   // More than one target. Generate generic polymorphic call without
   // deoptimization.
   if (targets.length() > 0) {
@@ -978,6 +986,61 @@ void AotCallSpecializer::VisitInstanceCall(InstanceCallInstr* instr) {
   }
 }
 
+bool AotCallSpecializer::TryDevirtualizeUsingProfile(InstanceCallInstr* instr) {
+  AotProfile* profile = AotProfile::Current();
+  if (profile == nullptr) {
+    return false;
+  }
+  const Function& caller = AotProfile::CallerOf(*flow_graph(), *instr);
+  MallocGrowableArray<AotProfile::Receiver> receivers;
+  const intptr_t total = profile->Receivers(caller, instr->token_pos(),
+                                            instr->function_name(), &receivers);
+  if ((total == 0) || receivers.is_empty() ||
+      (receivers.length() > FLAG_max_polymorphic_checks)) {
+    return false;
+  }
+
+  const Array& args_desc_array =
+      Array::Handle(Z, instr->GetArgumentsDescriptor());
+  const ICData& ic_data = ICData::Handle(
+      Z, ICData::New(flow_graph()->function(), instr->function_name(),
+                     args_desc_array, DeoptId::kNone,
+                     /* args_tested = */ 1, ICData::kOptimized));
+  Class& cls = Class::Handle(Z);
+  Function& target = Function::Handle(Z);
+  intptr_t covered = 0;
+  for (intptr_t i = 0; i < receivers.length(); i++) {
+    cls = isolate_group()->class_table()->At(receivers[i].cid);
+    target = instr->ResolveForReceiverClass(cls);
+    if (target.IsNull()) {
+      continue;
+    }
+    ic_data.AddReceiverCheck(receivers[i].cid, target, receivers[i].count);
+    covered += receivers[i].count;
+  }
+  if ((covered == 0) ||
+      (covered * 100 < total * FLAG_aot_profile_min_coverage)) {
+    return false;
+  }
+
+  if (FLAG_trace_aot_profile) {
+    THR_Print("Devirtualized %s in %s using the AOT profile (%" Pd
+              " targets, %" Pd "/%" Pd " calls)\n",
+              instr->function_name().ToCString(), caller.ToQualifiedCString(),
+              ic_data.NumberOfChecks(), covered, total);
+  }
+
+  // Calls with receivers not seen during training fall back to the
+  // megamorphic call.
+  const CallTargets* targets = CallTargets::Create(Z, ic_data);
+  ASSERT(!targets->is_empty());
+  PolymorphicInstanceCallInstr* call =
+      PolymorphicInstanceCallInstr::FromCall(Z, instr, *targets,
+                                             /* complete = */ false);
+  instr->ReplaceWith(call, current_iterator());
+  return true;
+}
+
 void AotCallSpecializer::VisitStaticCall(StaticCallInstr* instr) {
   if (TryInlineFieldAccess(instr)) {
     return;
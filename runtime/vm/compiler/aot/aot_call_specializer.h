@@ -41,6 +41,10 @@ class AotCallSpecializer : public CallSpecializer {
   bool TryInlineFieldAccess(InstanceCallInstr* call);
   bool TryInlineFieldAccess(StaticCallInstr* call);
 
+  // Replaces [instr] with a polymorphic call checking for the receiver
+  // classes recorded in the AOT profile, if they cover most of its calls.
+  bool TryDevirtualizeUsingProfile(InstanceCallInstr* instr);
+
   bool IsSupportedIntOperandForStaticDoubleOp(CompileType* operand_type);
   Value* PrepareStaticOpInput(Value* input, intptr_t cid, Instruction* call);
 
@@ -0,0 +1,429 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/aot_profile.h"
+
+#include "platform/text_buffer.h"
+#include "vm/class_table.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/isolate.h"
+#include "vm/log.h"
+#include "vm/object.h"
+#include "vm/object_store.h"
+#include "vm/os.h"
+#include "vm/program_visitor.h"
+
+namespace dart {
+
+DEFINE_FLAG(charp,
+            write_aot_profile_to,
+            nullptr,
+            "Write call site and hotness feedback collected by the JIT to the "
+            "given file on isolate shutdown (see --aot_profile).");
+
+#if defined(DART_PRECOMPILER)
+DEFINE_FLAG(charp,
+            aot_profile,
+            nullptr,
+            "Use feedback written by --write_aot_profile_to to guide inlining, "
+            "devirtualization and code layout.");
+DEFINE_FLAG(int,
+            aot_profile_min_coverage,
+            90,
+            "Devirtualize a call using the AOT profile only if the receiver "
+            "classes it was seen with cover this percentage of its calls.");
+DEFINE_FLAG(bool, trace_aot_profile, false, "Trace uses of the AOT profile.");
+#endif  // defined(DART_PRECOMPILER)
+
+// Returns the key of [cls] in the profile or nullptr if [cls] can't be
+// identified across processes.
+static const char* ClassKey(Zone* zone, const Class& cls) {
+  const Library& library = Library::Handle(zone, cls.library());
+  if (library.IsNull()) {
+    return nullptr;
+  }
+  const String& url = String::Handle(zone, library.url());
+  const String& name = String::Handle(zone, cls.Name());
+  return OS::SCreate(zone, "%s\t%s", url.ToCString(), String::ScrubName(name));
+}
+
+static const char* FunctionKey(Zone* zone, const Function& function) {
+  const Class& owner = Class::Handle(zone, function.Owner());
+  const char* class_key = ClassKey(zone, owner);
+  if (class_key == nullptr) {
+    return nullptr;
+  }
+  const String& name = String::Handle(zone, function.name());
+  return OS::SCreate(zone, "%s\t%s\t%" Pd32, class_key,
+                     String::ScrubName(name),
+                     function.token_pos().Serialize());
+}
+
+// Forwarders and dispatchers share name and position with the function they
+// forward to, so they are left out of the profile.
+static bool IsForwarder(const Function& function) {
+  return function.IsDynamicInvocationForwarder() ||
+         function.IsMethodExtractor() || function.IsImplicitClosureFunction() ||
+         function.IsInvokeFieldDispatcher() ||
+         function.IsNoSuchMethodDispatcher();
+}
+
+class AotProfileWriter : public FunctionVisitor {
+ public:
+  AotProfileWriter(Zone* zone, ClassTable* class_table, TextBuffer* buffer)
+      : zone_(zone),
+        class_table_(class_table),
+        buffer_(buffer),
+        code_(Code::Handle(zone)),
+        descriptors_(PcDescriptors::Handle(zone)),
+        cls_(Class::Handle(zone)),
+        selector_(String::Handle(zone)),
+        ic_data_map_(new(zone) ZoneGrowableArray<const ICData*>()) {}
+
+  void VisitFunction(const Function& function) {
+    if (IsForwarder(function) || !function.HasCode()) {
+      return;
+    }
+    // Feedback is only collected by unoptimized code, which stops being
+    // executed once the function is optimized.
+    code_ = function.unoptimized_code();
+    if (code_.IsNull()) {
+      return;
+    }
+    const char* key = FunctionKey(zone_, function);
+    if (key == nullptr) {
+      return;
+    }
+    buffer_->Printf("F\t%d\t%s\n", function.HasOptimizedCode() ? 1 : 0, key);
+
+    ic_data_map_->Clear();
+    function.RestoreICDataMap(ic_data_map_, /*clone_ic_data=*/false);
+    descriptors_ = code_.pc_descriptors();
+    PcDescriptors::Iterator iter(descriptors_,
+                                 UntaggedPcDescriptors::kIcCall |
+                                     UntaggedPcDescriptors::kUnoptStaticCall);
+    while (iter.MoveNext()) {
+      const intptr_t deopt_id = iter.DeoptId();
+      if (!iter.TokenPos().IsReal() || (deopt_id < 0) ||
+          (deopt_id >= ic_data_map_->length())) {
+        continue;
+      }
+      const ICData* ic_data = (*ic_data_map_)[deopt_id];
+      if (ic_data == nullptr) {
+        continue;
+      }
+      const intptr_t count = ic_data->AggregateCount();
+      if (count == 0) {
+        continue;
+      }
+      selector_ = ic_data->target_name();
+      buffer_->Printf("C\t%" Pd32 "\t%s\t%" Pd "\n",
+                      iter.TokenPos().Serialize(), String::ScrubName(selector_),
+                      count);
+      if (ic_data->is_static_call() || (ic_data->NumArgsTested() == 0)) {
+        continue;
+      }
+      for (intptr_t i = 0, n = ic_data->NumberOfChecks(); i < n; i++) {
+        const intptr_t receiver_count = ic_data->GetCountAt(i);
+        if (receiver_count == 0) {
+          continue;
+        }
+        cls_ = class_table_->At(ic_data->GetReceiverClassIdAt(i));
+        const char* class_key = ClassKey(zone_, cls_);
+        if (class_key != nullptr) {
+          buffer_->Printf("R\t%" Pd "\t%s\n", receiver_count, class_key);
+        }
+      }
+    }
+  }
+
+ private:
+  Zone* const zone_;
+  ClassTable* const class_table_;
+  TextBuffer* const buffer_;
+  Code& code_;
+  PcDescriptors& descriptors_;
+  Class& cls_;
+  String& selector_;
+  ZoneGrowableArray<const ICData*>* const ic_data_map_;
+
+  DISALLOW_COPY_AND_ASSIGN(AotProfileWriter);
+};
+
+void AotProfile::Write(Thread* thread, const char* path) {
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return;
+  }
+
+  StackZone stack_zone(thread);
+  HandleScope handle_scope(thread);
+  TextBuffer buffer(64 * KB);
+  AotProfileWriter writer(thread->zone(),
+                          thread->isolate_group()->class_table(), &buffer);
+  ProgramVisitor::WalkProgram(thread->zone(), thread->isolate_group(), &writer);
+
+  auto file = file_open(path, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write AOT profile: %s\n", path);
+    return;
+  }
+  file_write(buffer.buffer(), buffer.length(), file);
+  file_close(file);
+}
+
+#if defined(DART_PRECOMPILER)
+
+AotProfile* AotProfile::current_ = nullptr;
+
+AotProfile::~AotProfile() {
+  for (intptr_t i = 0; i < strings_.length(); i++) {
+    free(strings_[i]);
+  }
+}
+
+void AotProfile::Load(Thread* thread, const char* path) {
+  auto file_open = Dart::file_open_callback();
+  auto file_read = Dart::file_read_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_read == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return;
+  }
+  auto file = file_open(path, /*write=*/false);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", path);
+    return;
+  }
+  uint8_t* data = nullptr;
+  intptr_t length = -1;
+  file_read(&data, &length, file);
+  file_close(file);
+  if ((data == nullptr) || (length < 0)) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", path);
+    return;
+  }
+  char* contents = reinterpret_cast<char*>(realloc(data, length + 1));
+  contents[length] = '\0';
+
+  auto profile = new AotProfile();
+  profile->strings_.Add(contents);
+
+  // Map class keys to the class ids of this process.
+  Zone* zone = thread->zone();
+  const GrowableObjectArray& libraries = GrowableObjectArray::Handle(
+      zone, thread->isolate_group()->object_store()->libraries());
+  Library& library = Library::Handle(zone);
+  Class& cls = Class::Handle(zone);
+  for (intptr_t i = 0; i < libraries.Length(); i++) {
+    library ^= libraries.At(i);
+    ClassDictionaryIterator it(library,
+                               ClassDictionaryIterator::kIteratePrivate);
+    while (it.HasNext()) {
+      cls = it.GetNextClass();
+      const char* key = ClassKey(zone, cls);
+      if ((key == nullptr) || profile->class_map_.HasKey(key)) {
+        continue;
+      }
+      char* copy = Utils::StrDup(key);
+      profile->strings_.Add(copy);
+      profile->class_map_.Insert({copy, cls.id()});
+    }
+  }
+
+  if (!profile->Parse(contents)) {
+    OS::PrintErr("warning: Malformed AOT profile: %s\n", path);
+    delete profile;
+    return;
+  }
+  if (FLAG_trace_aot_profile) {
+    THR_Print("Loaded AOT profile %s: %" Pd " functions, %" Pd " call sites\n",
+              path, profile->functions_.length(), profile->calls_.length());
+  }
+  delete current_;
+  current_ = profile;
+}
+
+// Returns the field at [*cursor] and advances [*cursor] past the next tab.
+static char* NextField(char** cursor) {
+  char* field = *cursor;
+  if (field == nullptr) {
+    return nullptr;
+  }
+  char* tab = strchr(field, '\t');
+  if (tab != nullptr) {
+    *tab = '\0';
+    *cursor = tab + 1;
+  } else {
+    *cursor = nullptr;
+  }
+  return field;
+}
+
+static bool ParseInt(const char* field, int64_t* value) {
+  return (field != nullptr) && OS::StringToInt64(field, value);
+}
+
+bool AotProfile::Parse(char* contents) {
+  intptr_t function_index = -1;
+  intptr_t call_index = -1;
+  char* next = nullptr;
+  for (char* line = contents; line != nullptr; line = next) {
+    next = strchr(line, '\n');
+    if (next != nullptr) {
+      *next++ = '\0';
+    }
+    char* cursor = line;
+    const char* kind = NextField(&cursor);
+    int64_t value = 0;
+    int64_t count = 0;
+    if (strcmp(kind, "F") == 0) {
+      if (!ParseInt(NextField(&cursor), &value) || (cursor == nullptr)) {
+        return false;
+      }
+      // The remaining fields form the key of the function.
+      if (function_map_.HasKey(cursor)) {
+        function_index = -1;
+      } else {
+        function_index = functions_.length();
+        functions_.Add({value != 0, calls_.length(), 0});
+        function_map_.Insert({cursor, function_index});
+      }
+      call_index = -1;
+    } else if (strcmp(kind, "C") == 0) {
+      const char* selector = nullptr;
+      if (!ParseInt(NextField(&cursor), &value) ||
+          ((selector = NextField(&cursor)) == nullptr) ||
+          !ParseInt(NextField(&cursor), &count)) {
+        return false;
+      }
+      if (function_index == -1) {
+        continue;
+      }
+      call_index = calls_.length();
+      calls_.Add({static_cast<int32_t>(value), selector,
+                  static_cast<intptr_t>(count), receivers_.length(), 0});
+      functions_[function_index].call_count++;
+    } else if (strcmp(kind, "R") == 0) {
+      if (!ParseInt(NextField(&cursor), &count) || (cursor == nullptr)) {
+        return false;
+      }
+      if (call_index == -1) {
+        continue;
+      }
+      const intptr_t cid = class_map_.LookupValue(cursor);
+      if (cid != CStringIntMapKeyValueTrait::kNoValue) {
+        receivers_.Add({cid, static_cast<intptr_t>(count)});
+        calls_[call_index].receiver_count++;
+      }
+    } else if (*kind != '\0') {
+      return false;
+    }
+  }
+  return true;
+}
+
+const Function& AotProfile::CallerOf(const FlowGraph& graph,
+                                     const Instruction& call) {
+  const auto& inline_id_to_function =
+      graph.inlining_info().inline_id_to_function;
+  const intptr_t inlining_id = call.inlining_id();
+  if ((inlining_id >= 0) && (inlining_id < inline_id_to_function.length())) {
+    return *inline_id_to_function[inlining_id];
+  }
+  return graph.function();
+}
+
+const AotProfile::FunctionProfile* AotProfile::Lookup(
+    const Function& function) const {
+  const char* key = FunctionKey(Thread::Current()->zone(), function);
+  if (key == nullptr) {
+    return nullptr;
+  }
+  const intptr_t index = function_map_.LookupValue(key);
+  if (index == CStringIntMapKeyValueTrait::kNoValue) {
+    return nullptr;
+  }
+  return &functions_[index];
+}
+
+bool AotProfile::IsHot(const Function& function) const {
+  const FunctionProfile* profile = Lookup(function);
+  return (profile != nullptr) && profile->optimized;
+}
+
+bool AotProfile::WasExecuted(const Function& function) const {
+  return IsForwarder(function) || (Lookup(function) != nullptr);
+}
+
+intptr_t AotProfile::CallCount(const Function& caller,
+                               TokenPosition token_pos,
+                               const String* selector) const {
+  if (!token_pos.IsReal()) {
+    return -1;
+  }
+  const FunctionProfile* profile = Lookup(caller);
+  if (profile == nullptr) {
+    return -1;
+  }
+  const int32_t pos = token_pos.Serialize();
+  const char* name =
+      (selector != nullptr) ? String::ScrubName(*selector) : nullptr;
+  intptr_t count = 0;
+  for (intptr_t i = 0; i < profile->call_count; i++) {
+    const CallProfile& call = calls_[profile->first_call + i];
+    if ((call.token_pos == pos) &&
+        ((name == nullptr) || (strcmp(call.selector, name) == 0))) {
+      count += call.count;
+    }
+  }
+  return count;
+}
+
+static int CompareReceiverCounts(const AotProfile::Receiver* a,
+                                 const AotProfile::Receiver* b) {
+  if (a->count > b->count) return -1;
+  if (a->count < b->count) return 1;
+  return 0;
+}
+
+intptr_t AotProfile::Receivers(const Function& caller,
+                               TokenPosition token_pos,
+                               const String& selector,
+                               MallocGrowableArray<Receiver>* receivers) const {
+  if (!token_pos.IsReal()) {
+    return 0;
+  }
+  const FunctionProfile* profile = Lookup(caller);
+  if (profile == nullptr) {
+    return 0;
+  }
+  const int32_t pos = token_pos.Serialize();
+  const char* name = String::ScrubName(selector);
+  intptr_t count = 0;
+  for (intptr_t i = 0; i < profile->call_count; i++) {
+    const CallProfile& call = calls_[profile->first_call + i];
+    if ((call.token_pos != pos) || (strcmp(call.selector, name) != 0)) {
+      continue;
+    }
+    count += call.count;
+    for (intptr_t j = 0; j < call.receiver_count; j++) {
+      receivers->Add(receivers_[call.first_receiver + j]);
+    }
+  }
+  receivers->Sort(CompareReceiverCounts);
+  return count;
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
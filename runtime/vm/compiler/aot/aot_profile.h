@@ -0,0 +1,125 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+#define RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "platform/growable_array.h"
+#include "vm/allocation.h"
+#include "vm/hash_map.h"
+#include "vm/token_position.h"
+
+namespace dart {
+
+class FlowGraph;
+class Function;
+class Instruction;
+class String;
+class Thread;
+
+// Execution profile recorded by the JIT during a training run
+// (--write_aot_profile_to) and consumed by the precompiler (--aot_profile).
+//
+// The profile is a text file with one tab separated record per line:
+//
+//   F <optimized> <library url> <class> <function> <token pos>
+//   C <token pos> <selector> <count>
+//   R <count> <library url> <class>
+//
+// Each F record describes a function which was executed during training and
+// is followed by the C records of its call sites, each of which is followed
+// by the R records of the receiver classes observed at that call site.
+// Functions, classes and selectors are identified by their names with
+// library private keys removed, and call sites by their source positions,
+// because class ids and deopt ids are not stable across processes.
+class AotProfile : public MallocAllocated {
+ public:
+  struct Receiver {
+    intptr_t cid;
+    intptr_t count;
+  };
+
+  // Writes the feedback collected by the unoptimized code of all functions
+  // of the current isolate group into [path].
+  static void Write(Thread* thread, const char* path);
+
+#if defined(DART_PRECOMPILER)
+  // Loads the profile from [path] and makes it the current one. Class names
+  // are resolved to class ids of the current class table, so this has to be
+  // called after class ids have been finalized.
+  static void Load(Thread* thread, const char* path);
+
+  // Returns the loaded profile or nullptr if none was loaded.
+  static AotProfile* Current() { return current_; }
+
+  // Returns the function whose source contains [call], which differs from
+  // the function of [graph] if [call] was inlined.
+  static const Function& CallerOf(const FlowGraph& graph,
+                                  const Instruction& call);
+
+  // Returns true if [function] was optimized during the training run.
+  bool IsHot(const Function& function) const;
+
+  // Returns false if [function] was not executed during the training run.
+  bool WasExecuted(const Function& function) const;
+
+  // Returns the number of times calls at [token_pos] in [caller] were
+  // executed during the training run. Only calls to [selector] are
+  // considered unless it is nullptr. Returns -1 if [caller] was not
+  // executed during the training run.
+  intptr_t CallCount(const Function& caller,
+                     TokenPosition token_pos,
+                     const String* selector) const;
+
+  // Appends the receiver classes observed at the call to [selector] at
+  // [token_pos] in [caller] into [receivers], most frequent first, and
+  // returns the number of times the call was executed.
+  intptr_t Receivers(const Function& caller,
+                     TokenPosition token_pos,
+                     const String& selector,
+                     MallocGrowableArray<Receiver>* receivers) const;
+
+  ~AotProfile();
+
+ private:
+  struct FunctionProfile {
+    bool optimized;
+    intptr_t first_call;
+    intptr_t call_count;
+  };
+
+  struct CallProfile {
+    int32_t token_pos;
+    const char* selector;
+    intptr_t count;
+    intptr_t first_receiver;
+    intptr_t receiver_count;
+  };
+
+  AotProfile() : function_map_(), class_map_() {}
+
+  bool Parse(char* contents);
+  intptr_t LookupClass(const char* library_url, const char* class_name);
+  const FunctionProfile* Lookup(const Function& function) const;
+
+  MallocGrowableArray<char*> strings_;
+  MallocGrowableArray<FunctionProfile> functions_;
+  MallocGrowableArray<CallProfile> calls_;
+  MallocGrowableArray<Receiver> receivers_;
+  MallocDirectChainedHashMap<CStringIntMapKeyValueTrait> function_map_;
+  MallocDirectChainedHashMap<CStringIntMapKeyValueTrait> class_map_;
+
+  static AotProfile* current_;
+
+  DISALLOW_COPY_AND_ASSIGN(AotProfile);
+#endif  // defined(DART_PRECOMPILER)
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
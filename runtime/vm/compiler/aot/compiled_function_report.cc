@@ -0,0 +1,217 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/compiled_function_report.h"
+
+#include "vm/code_descriptors.h"
+#include "vm/compiler/aot/precompiler.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/hash_map.h"
+#include "vm/json_writer.h"
+
+namespace dart {
+
+#if defined(DART_PRECOMPILER)
+
+DEFINE_FLAG(charp,
+            write_compiled_function_report_to,
+            nullptr,
+            "Write the compile time, code size and inlined callees of each "
+            "function compiled by the precompiler as JSON into the given file");
+
+static bool IsCheck(Instruction* instr) {
+  return instr->IsAssertAssignable() || instr->IsAssertSubtype() ||
+         instr->IsCheckClass() || instr->IsCheckClassId() ||
+         instr->IsCheckSmi() || instr->IsCheckNull() ||
+         instr->IsCheckCondition() || instr->IsCheckEitherNonSmi() ||
+         instr->IsCheckBoundBase() || instr->IsCheckWritable();
+}
+
+void CompiledFunctionReport::Measurements::CountChecks(FlowGraph* flow_graph) {
+  check_count = 0;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (IsCheck(it.Current())) {
+        check_count++;
+      }
+    }
+  }
+}
+
+CompiledFunctionReport* CompiledFunctionReport::StartIfRequested(
+    Precompiler* precompiler) {
+  const char* filename = FLAG_write_compiled_function_report_to;
+  if (filename == nullptr) {
+    return nullptr;
+  }
+  if ((Dart::file_write_callback() == nullptr) ||
+      (Dart::file_open_callback() == nullptr) ||
+      (Dart::file_close_callback() == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return nullptr;
+  }
+  void* file = Dart::file_open_callback()(filename, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write compiled function report: %s\n",
+                 filename);
+    return nullptr;
+  }
+  return new CompiledFunctionReport(precompiler, file);
+}
+
+CompiledFunctionReport::CompiledFunctionReport(Precompiler* precompiler,
+                                               void* stream)
+    : precompiler_(precompiler),
+      stream_(stream),
+      functions_(GrowableObjectArray::Handle(GrowableObjectArray::New())) {}
+
+void CompiledFunctionReport::Add(const Function& function,
+                                 const Code& code,
+                                 const Measurements& measurements) {
+  Zone* zone = Thread::Current()->zone();
+  const auto& inlined_functions =
+      Array::Handle(zone, code.inlined_id_to_function());
+  GrowableArray<intptr_t> sizes(zone, 0);
+  if (!inlined_functions.IsNull()) {
+    for (intptr_t i = 0; i < inlined_functions.Length(); i++) {
+      sizes.Add(0);
+    }
+    const auto& map = CodeSourceMap::Handle(zone, code.code_source_map());
+    CodeSourceMapReader reader(map, inlined_functions, function);
+    reader.AddInlinedCalleeSizes(&sizes);
+  }
+
+  auto& callee = Function::Handle(zone);
+  // Adding to functions_ allocates.
+  SafepointMutexLocker ml(&mutex_);
+  Entry entry;
+  entry.function = functions_.Length();
+  functions_.Add(function);
+  entry.first_pass_time = pass_times_.length();
+  for (intptr_t i = 0; i < CompilerPass::kNumPasses; i++) {
+    if (measurements.pass_micros[i] != 0) {
+      pass_times_.Add({i, measurements.pass_micros[i]});
+    }
+  }
+  entry.num_pass_times = pass_times_.length() - entry.first_pass_time;
+  entry.first_inlined_size = inlined_sizes_.length();
+  for (intptr_t i = 0; i < sizes.length(); i++) {
+    if (sizes[i] != 0) {
+      callee ^= inlined_functions.At(i);
+      inlined_sizes_.Add({functions_.Length(), sizes[i]});
+      functions_.Add(callee);
+    }
+  }
+  entry.num_inlined_sizes = inlined_sizes_.length() - entry.first_inlined_size;
+  entry.size = code.Size();
+  entry.build_graph_micros = measurements.build_graph_micros;
+  entry.compile_micros = measurements.compile_micros;
+  entry.check_count = measurements.check_count;
+  entries_.Add(entry);
+}
+
+void CompiledFunctionReport::WriteFunction(JSONWriter* writer,
+                                           const char* property,
+                                           intptr_t index) {
+  const auto& function =
+      Function::Handle(Function::RawCast(functions_.At(index)));
+  writer->PrintProperty(property, function.QualifiedUserVisibleNameCString());
+}
+
+void CompiledFunctionReport::Finalize() {
+  Zone* zone = Thread::Current()->zone();
+  auto& function = Function::Handle(zone);
+  auto& library = Library::Handle(zone);
+  auto& url = String::Handle(zone);
+
+  struct LibrarySummary {
+    const char* url;
+    intptr_t function_count;
+    intptr_t retained_count;
+    intptr_t size;
+    int64_t compile_micros;
+  };
+  GrowableArray<LibrarySummary> libraries(zone, 16);
+  CStringIntMap library_indices;
+
+  JSONWriter writer(64 * KB);
+  writer.OpenObject();
+  writer.OpenArray("functions");
+  for (const Entry& entry : entries_) {
+    function ^= functions_.At(entry.function);
+    library = Class::Handle(zone, function.Owner()).library();
+    url = library.IsNull() ? String::null() : library.url();
+    const char* url_cstr = url.IsNull() ? "" : url.ToCString();
+    const bool retained = precompiler_->IsFunctionRetained(function);
+
+    writer.OpenObject();
+    writer.PrintProperty("library", url_cstr);
+    WriteFunction(&writer, "name", entry.function);
+    writer.PrintPropertyBool("retained", retained);
+    writer.PrintProperty("size", entry.size);
+    writer.PrintProperty64("compileMicros", entry.compile_micros);
+    writer.PrintProperty64("buildGraphMicros", entry.build_graph_micros);
+    writer.OpenObject("passMicros");
+    for (intptr_t i = 0; i < entry.num_pass_times; i++) {
+      const PassTime& time = pass_times_[entry.first_pass_time + i];
+      const CompilerPass* pass =
+          CompilerPass::Get(static_cast<CompilerPass::Id>(time.pass));
+      writer.PrintProperty64(pass->name(), time.micros);
+    }
+    writer.CloseObject();
+    writer.PrintProperty("checks", entry.check_count);
+    writer.OpenArray("inlined");
+    for (intptr_t i = 0; i < entry.num_inlined_sizes; i++) {
+      const InlinedSize& inlined = inlined_sizes_[entry.first_inlined_size + i];
+      writer.OpenObject();
+      WriteFunction(&writer, "name", inlined.function);
+      writer.PrintProperty("size", inlined.size);
+      writer.CloseObject();
+    }
+    writer.CloseArray();
+    writer.CloseObject();
+
+    auto pair = library_indices.Lookup(url_cstr);
+    intptr_t index;
+    if (pair == nullptr) {
+      index = libraries.length();
+      libraries.Add({url_cstr, 0, 0, 0, 0});
+      library_indices.Insert({url_cstr, index});
+    } else {
+      index = pair->value;
+    }
+    LibrarySummary& summary = libraries[index];
+    summary.function_count++;
+    if (retained) summary.retained_count++;
+    summary.size += entry.size;
+    summary.compile_micros += entry.compile_micros;
+  }
+  writer.CloseArray();
+
+  writer.OpenArray("libraries");
+  for (const LibrarySummary& summary : libraries) {
+    writer.OpenObject();
+    writer.PrintProperty("library", summary.url);
+    writer.PrintProperty("functions", summary.function_count);
+    writer.PrintProperty("retained", summary.retained_count);
+    writer.PrintProperty("size", summary.size);
+    writer.PrintProperty64("compileMicros", summary.compile_micros);
+    writer.CloseObject();
+  }
+  writer.CloseArray();
+  writer.CloseObject();
+  writer.buffer()->AddChar('\n');
+
+  char* output = nullptr;
+  intptr_t output_length = 0;
+  writer.Steal(&output, &output_length);
+  Dart::file_write_callback()(output, output_length, stream_);
+  free(output);
+  Dart::file_close_callback()(stream_);
+}
+
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
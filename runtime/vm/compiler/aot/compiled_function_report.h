@@ -0,0 +1,101 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_COMPILED_FUNCTION_REPORT_H_
+#define RUNTIME_VM_COMPILER_AOT_COMPILED_FUNCTION_REPORT_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "platform/growable_array.h"
+#include "vm/allocation.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+class Code;
+class FlowGraph;
+class Function;
+class GrowableObjectArray;
+class JSONWriter;
+class Precompiler;
+
+#if defined(DART_PRECOMPILER)
+// Report of the compile time, code size and inlining of each function
+// compiled by the precompiler, written to --write_compiled_function_report_to
+// as JSON. Functions are also summed up per library.
+class CompiledFunctionReport : public ZoneAllocated {
+ public:
+  // What is measured while compiling one function.
+  struct Measurements {
+    int64_t build_graph_micros = 0;
+    int64_t pass_micros[CompilerPass::kNumPasses] = {};
+    int64_t compile_micros = 0;
+    // Instructions which check a condition at runtime, e.g. CheckNull,
+    // CheckBound and AssertAssignable.
+    intptr_t check_count = 0;
+
+    // Counts the checks in the final flow graph.
+    void CountChecks(FlowGraph* flow_graph);
+  };
+
+  static CompiledFunctionReport* StartIfRequested(Precompiler* precompiler);
+
+  // Records the compilation of |function| into |code|. Can be called from
+  // any compiler thread.
+  void Add(const Function& function,
+           const Code& code,
+           const Measurements& measurements);
+
+  // Writes the report, once the precompiler knows the retained functions.
+  void Finalize();
+
+ private:
+  struct PassTime {
+    intptr_t pass;
+    int64_t micros;
+  };
+
+  struct InlinedSize {
+    intptr_t function;
+    intptr_t size;
+  };
+
+  struct Entry {
+    // Indices into functions_, pass_times_ and inlined_sizes_.
+    intptr_t function;
+    intptr_t first_pass_time;
+    intptr_t num_pass_times;
+    intptr_t first_inlined_size;
+    intptr_t num_inlined_sizes;
+
+    intptr_t size;
+    int64_t build_graph_micros;
+    int64_t compile_micros;
+    intptr_t check_count;
+  };
+
+  CompiledFunctionReport(Precompiler* precompiler, void* stream);
+
+  void WriteFunction(JSONWriter* writer, const char* property, intptr_t index);
+
+  Precompiler* const precompiler_;
+  void* const stream_;
+
+  Mutex mutex_;
+  // The compiled functions and their inlined callees.
+  GrowableObjectArray& functions_;
+  MallocGrowableArray<Entry> entries_;
+  MallocGrowableArray<PassTime> pass_times_;
+  MallocGrowableArray<InlinedSize> inlined_sizes_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompiledFunctionReport);
+};
+#endif  // defined(DART_PRECOMPILER)
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_COMPILED_FUNCTION_REPORT_H_
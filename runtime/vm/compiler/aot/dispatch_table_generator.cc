@@ -8,16 +8,37 @@
 
 #include <memory>
 
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/frontend/kernel_translation_helper.h"
+#include "vm/compiler/runtime_api.h"
 #include "vm/dispatch_table.h"
+#include "vm/flags.h"
 #include "vm/stub_code.h"
 #include "vm/thread.h"
 
 #define Z zone_
 
 namespace dart {
+
+DEFINE_FLAG(bool,
+            dispatch_table_cache_aware_packing,
+            false,
+            "Place the dispatch table rows of the hottest selectors first and "
+            "such that their entries for hot classes share cache lines.");
+DEFINE_FLAG(int,
+            dispatch_table_hot_rows,
+            64,
+            "Number of rows placed by --dispatch_table_cache_aware_packing.");
+
 namespace compiler {
 
+// Assumed cache line size of the target, in dispatch table entries.
+static constexpr intptr_t kEntriesPerCacheLine = 64 / target::kWordSize;
+
+// Maximum number of offsets at which a hot row fits that are compared when
+// looking for the one sharing most cache lines with other hot rows.
+static constexpr intptr_t kMaxHotRowCandidates = 32;
+
 class Interval {
  public:
   Interval() : begin_(-1), end_(-1) {}
@@ -92,12 +113,58 @@ class CidInterval {
   const Function* function_;
 };
 
+// Sorts [ranges] and removes the ones contained in or adjacent to another one,
+// so that the result are disjunct ranges covering the same cids. Ranges must
+// either be disjunct or nested.
+static void MergeRanges(GrowableArray<Interval>* ranges) {
+  struct IntervalSorter {
+    static int Compare(const Interval* a, const Interval* b) {
+      if (a->begin() != b->begin()) {
+        return a->begin() - b->begin();
+      }
+      return b->length() - a->length();
+    }
+  };
+
+  ranges->Sort(IntervalSorter::Compare);
+
+  intptr_t current_index = 0;
+  intptr_t write_index = 1;
+  intptr_t read_index = 1;
+  for (; read_index < ranges->length(); read_index++) {
+    Interval& current_range = (*ranges)[current_index];
+    Interval& next_range = (*ranges)[read_index];
+    if (current_range.Contains(next_range)) {
+      // We drop the entry.
+    } else if (current_range.end() == next_range.begin()) {
+      // We extend the current entry and drop the entry.
+      current_range.ExtendToIncludeInterval(next_range);
+    } else {
+      // We keep the entry.
+      if (read_index != write_index) {
+        (*ranges)[write_index] = (*ranges)[read_index];
+      }
+      current_index = write_index;
+      write_index++;
+    }
+  }
+  ranges->TruncateTo(write_index);
+
+  for (intptr_t i = 0; i < ranges->length() - 1; i++) {
+    const Interval& a = (*ranges)[i];
+    const Interval& b = (*ranges)[i + 1];
+    ASSERT(a.begin() < b.begin());
+    ASSERT(a.end() < b.begin());
+  }
+}
+
 class SelectorRow {
  public:
   SelectorRow(Zone* zone, TableSelector* selector)
       : selector_(selector),
         class_ranges_(zone, 0),
         ranges_(zone, 0),
+        hot_ranges_(zone, 0),
         code_(Code::ZoneHandle(zone)) {}
 
   TableSelector* selector() const { return selector_; }
@@ -106,6 +173,10 @@ class SelectorRow {
 
   const GrowableArray<Interval>& ranges() const { return ranges_; }
 
+  // Subset of [ranges] which is expected to be used frequently. Only
+  // computed by [ComputeHotRanges].
+  const GrowableArray<Interval>& hot_ranges() const { return hot_ranges_; }
+
   const GrowableArray<CidInterval>& class_ranges() const {
     return class_ranges_;
   }
@@ -116,8 +187,20 @@ class SelectorRow {
                                                const Function* function);
   bool Finalize();
 
+  // Computes [hot_ranges]: the ranges of the implementations which were
+  // executed according to [profile], or all ranges if there is no profile.
+  void ComputeHotRanges(const AotProfile* profile);
+
   int32_t CallCount() const { return selector_->call_count; }
 
+  // Number of call sites of the selector, or 0 if none of its
+  // implementations is expected to be executed.
+  int32_t Hotness() const {
+    return hot_ranges_.is_empty() ? 0 : selector_->call_count;
+  }
+
+  int32_t HotSize() const;
+
   bool IsAllocated() const {
     return selector_->offset != SelectorMap::kInvalidSelectorOffset;
   }
@@ -127,6 +210,8 @@ class SelectorRow {
     selector_->offset = offset;
   }
 
+  int32_t offset() const { return selector_->offset; }
+
   void FillTable(ClassTable* class_table, const Array& entries);
 
  private:
@@ -135,9 +220,41 @@ class SelectorRow {
 
   GrowableArray<CidInterval> class_ranges_;
   GrowableArray<Interval> ranges_;
+  GrowableArray<Interval> hot_ranges_;
   Code& code_;
 };
 
+// Set of cache lines of the dispatch table.
+class CacheLineSet : public ValueObject {
+ public:
+  explicit CacheLineSet(Zone* zone) : lines_(zone, 0) {}
+
+  intptr_t Size() const { return size_; }
+
+  // Returns the number of cache lines touched by the entries for [ranges]
+  // of a row at [offset] which are not in the set yet.
+  intptr_t CountMissing(const GrowableArray<Interval>& ranges,
+                        int32_t offset) const;
+
+  // Adds the cache lines touched by the entries for [ranges] of a row at
+  // [offset] to the set.
+  void Add(const GrowableArray<Interval>& ranges, int32_t offset);
+
+ private:
+  static intptr_t LineOf(int32_t entry) {
+    return entry / kEntriesPerCacheLine;
+  }
+
+  bool Contains(intptr_t line) const {
+    return line < lines_.length() && lines_[line];
+  }
+
+  GrowableArray<bool> lines_;
+  intptr_t size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CacheLineSet);
+};
+
 class RowFitter {
  public:
   RowFitter() : first_slot_index_(0) { free_slots_.Add(Interval(0, INT_MAX)); }
@@ -154,9 +271,20 @@ class RowFitter {
                       int32_t min_offset,
                       int32_t max_offset = INT32_MAX);
 
+  // Like [FitAndAllocate], but among the first offsets where the row fits
+  // chooses the one where its hot ranges touch the fewest cache lines not in
+  // [hot_lines], and adds these lines to [hot_lines].
+  void FitAndAllocateHot(SelectorRow* row,
+                         CacheLineSet* hot_lines,
+                         int32_t min_offset,
+                         int32_t max_offset = INT32_MAX);
+
   int32_t TableSize() const { return free_slots_.Last().begin(); }
 
  private:
+  // Like [TryFit], but does not mark any entries as occupied.
+  bool Fits(SelectorRow* row, int32_t offset, int32_t* next_offset);
+
   intptr_t MoveForwardToCover(const Interval range, intptr_t slot_index);
 
   void UpdateFreeSlots(int32_t offset,
@@ -188,52 +316,71 @@ bool SelectorRow::Finalize() {
   for (intptr_t i = 0; i < class_ranges_.length(); i++) {
     ranges_.Add(class_ranges_[i].range());
   }
+  MergeRanges(&ranges_);
 
-  struct IntervalSorter {
-    static int Compare(const Interval* a, const Interval* b) {
-      if (a->begin() != b->begin()) {
-        return a->begin() - b->begin();
-      }
-      return b->length() - a->length();
-    }
-  };
+  for (intptr_t i = 0; i < ranges_.length(); i++) {
+    total_size_ += ranges_[i].length();
+  }
 
-  ranges_.Sort(IntervalSorter::Compare);
+  return true;
+}
 
-  intptr_t current_index = 0;
-  intptr_t write_index = 1;
-  intptr_t read_index = 1;
-  for (; read_index < ranges_.length(); read_index++) {
-    Interval& current_range = ranges_[current_index];
-    Interval& next_range = ranges_[read_index];
-    if (current_range.Contains(next_range)) {
-      // We drop the entry.
-    } else if (current_range.end() == next_range.begin()) {
-      // We extend the current entry and drop the entry.
-      current_range.ExtendToIncludeInterval(next_range);
-    } else {
-      // We keep the entry.
-      if (read_index != write_index) {
-        ranges_[write_index] = ranges_[read_index];
-      }
-      current_index = write_index;
-      write_index++;
+void SelectorRow::ComputeHotRanges(const AotProfile* profile) {
+  ASSERT(hot_ranges_.is_empty());
+  if (profile == nullptr) {
+    hot_ranges_.AddArray(ranges_);
+    return;
+  }
+  for (intptr_t i = 0; i < class_ranges_.length(); i++) {
+    const Function* function = class_ranges_[i].function();
+    if (function != nullptr && profile->WasExecuted(*function)) {
+      hot_ranges_.Add(class_ranges_[i].range());
     }
   }
-  ranges_.TruncateTo(write_index);
+  if (!hot_ranges_.is_empty()) {
+    MergeRanges(&hot_ranges_);
+  }
+}
 
-  for (intptr_t i = 0; i < ranges_.length() - 1; i++) {
-    const Interval& a = ranges_[i];
-    const Interval& b = ranges_[i + 1];
-    ASSERT(a.begin() < b.begin());
-    ASSERT(a.end() < b.begin());
+int32_t SelectorRow::HotSize() const {
+  int32_t size = 0;
+  for (intptr_t i = 0; i < hot_ranges_.length(); i++) {
+    size += hot_ranges_[i].length();
   }
+  return size;
+}
 
-  for (intptr_t i = 0; i < ranges_.length(); i++) {
-    total_size_ += ranges_[i].length();
+intptr_t CacheLineSet::CountMissing(const GrowableArray<Interval>& ranges,
+                                    int32_t offset) const {
+  intptr_t count = 0;
+  intptr_t last_line = -1;
+  for (intptr_t i = 0; i < ranges.length(); i++) {
+    const Interval range = ranges[i].WithOffset(offset);
+    // Disjunct ranges of a row can still share a line.
+    const intptr_t first_line =
+        Utils::Maximum(LineOf(range.begin()), last_line + 1);
+    last_line = LineOf(range.end() - 1);
+    for (intptr_t line = first_line; line <= last_line; line++) {
+      if (!Contains(line)) count++;
+    }
   }
+  return count;
+}
 
-  return true;
+void CacheLineSet::Add(const GrowableArray<Interval>& ranges, int32_t offset) {
+  for (intptr_t i = 0; i < ranges.length(); i++) {
+    const Interval range = ranges[i].WithOffset(offset);
+    const intptr_t last_line = LineOf(range.end() - 1);
+    if (last_line >= lines_.length()) {
+      lines_.EnsureLength(last_line + 1, false);
+    }
+    for (intptr_t line = LineOf(range.begin()); line <= last_line; line++) {
+      if (!lines_[line]) {
+        lines_[line] = true;
+        size_++;
+      }
+    }
+  }
 }
 
 void SelectorRow::FillTable(ClassTable* class_table, const Array& entries) {
@@ -281,7 +428,57 @@ void RowFitter::FitAndAllocate(SelectorRow* row,
   }
 }
 
+void RowFitter::FitAndAllocateHot(SelectorRow* row,
+                                  CacheLineSet* hot_lines,
+                                  int32_t min_offset,
+                                  int32_t max_offset) {
+  if (row->IsAllocated()) {
+    return;
+  }
+
+  const GrowableArray<Interval>& hot_ranges = row->hot_ranges();
+  int32_t best_offset = -1;
+  intptr_t best_missing = 0;
+  intptr_t candidates = 0;
+  int32_t next_offset;
+
+  int32_t offset = min_offset;
+  while (offset <= max_offset && candidates < kMaxHotRowCandidates) {
+    if (!Fits(row, offset, &next_offset)) {
+      offset = next_offset;
+      continue;
+    }
+    candidates++;
+    const intptr_t missing = hot_lines->CountMissing(hot_ranges, offset);
+    if (best_offset == -1 || missing < best_missing) {
+      best_offset = offset;
+      best_missing = missing;
+      if (missing == 0) break;
+    }
+    // All larger offsets place the row entirely behind the end of the table.
+    if (offset + row->ranges()[0].begin() >= TableSize()) break;
+    offset++;
+  }
+  if (best_offset == -1) {
+    return;
+  }
+
+  if (!TryFit(row, best_offset, &next_offset)) {
+    UNREACHABLE();
+  }
+  row->AllocateAt(best_offset);
+  hot_lines->Add(hot_ranges, best_offset);
+}
+
 bool RowFitter::TryFit(SelectorRow* row, int32_t offset, int32_t* next_offset) {
+  if (!Fits(row, offset, next_offset)) {
+    return false;
+  }
+  UpdateFreeSlots(offset, row->ranges(), first_slot_index_);
+  return true;
+}
+
+bool RowFitter::Fits(SelectorRow* row, int32_t offset, int32_t* next_offset) {
   const GrowableArray<Interval>& ranges = row->ranges();
 
   Interval first_range = ranges[0].WithOffset(offset);
@@ -305,7 +502,6 @@ bool RowFitter::TryFit(SelectorRow* row, int32_t offset, int32_t* next_offset) {
     }
   }
 
-  UpdateFreeSlots(offset, ranges, first_slot_index_);
   return true;
 }
 
@@ -620,6 +816,12 @@ void DispatchTableGenerator::ComputeSelectorOffsets() {
 
   RowFitter fitter;
 
+  GrowableArray<SelectorRow*> hot_rows(Z, 0);
+  if (FLAG_dispatch_table_cache_aware_packing) {
+    SelectHotRows(&hot_rows);
+  }
+  CacheLineSet hot_lines(Z);
+
   // Sort the table rows according to popularity, descending.
   struct PopularitySorter {
     static int Compare(SelectorRow* const* a, SelectorRow* const* b) {
@@ -633,6 +835,11 @@ void DispatchTableGenerator::ComputeSelectorOffsets() {
   for (intptr_t i = 0; i < table_rows_.length(); i++) {
     fitter.FitAndAllocate(table_rows_[i], optimal_offset, optimal_offset);
   }
+  for (intptr_t i = 0; i < hot_rows.length(); i++) {
+    if (hot_rows[i]->IsAllocated()) {
+      hot_lines.Add(hot_rows[i]->hot_ranges(), hot_rows[i]->offset());
+    }
+  }
 
   // Sort the table rows according to popularity / size, descending.
   struct PopularitySizeRatioSorter {
@@ -643,8 +850,12 @@ void DispatchTableGenerator::ComputeSelectorOffsets() {
   };
   table_rows_.Sort(PopularitySizeRatioSorter::Compare);
 
-  // Try to allocate at small offsets.
+  // Try to allocate at small offsets, hot rows first so they end up next to
+  // each other.
   const int32_t max_offset = DispatchTable::kLargestSmallOffset;
+  for (intptr_t i = 0; i < hot_rows.length(); i++) {
+    fitter.FitAndAllocateHot(hot_rows[i], &hot_lines, 0, max_offset);
+  }
   for (intptr_t i = 0; i < table_rows_.length(); i++) {
     fitter.FitAndAllocate(table_rows_[i], 0, max_offset);
   }
@@ -659,11 +870,64 @@ void DispatchTableGenerator::ComputeSelectorOffsets() {
 
   // Allocate remaining rows at large offsets.
   const int32_t min_large_offset = DispatchTable::kLargestSmallOffset + 1;
+  for (intptr_t i = 0; i < hot_rows.length(); i++) {
+    fitter.FitAndAllocateHot(hot_rows[i], &hot_lines, min_large_offset);
+  }
   for (intptr_t i = 0; i < table_rows_.length(); i++) {
     fitter.FitAndAllocate(table_rows_[i], min_large_offset);
   }
 
   table_size_ = fitter.TableSize();
+  ComputeLayoutInfo(hot_rows);
+}
+
+void DispatchTableGenerator::SelectHotRows(
+    GrowableArray<SelectorRow*>* hot_rows) {
+  const AotProfile* profile = AotProfile::Current();
+  for (intptr_t i = 0; i < table_rows_.length(); i++) {
+    SelectorRow* row = table_rows_[i];
+    row->ComputeHotRanges(profile);
+    if (row->Hotness() > 0) {
+      hot_rows->Add(row);
+    }
+  }
+
+  // Sort the hot rows according to hotness, descending. Rows of the same
+  // hotness are kept in selector id order to make the layout deterministic.
+  struct HotnessSorter {
+    static int Compare(SelectorRow* const* a, SelectorRow* const* b) {
+      if ((*a)->Hotness() != (*b)->Hotness()) {
+        return (*b)->Hotness() - (*a)->Hotness();
+      }
+      return (*a)->selector()->id - (*b)->selector()->id;
+    }
+  };
+  hot_rows->Sort(HotnessSorter::Compare);
+  if (hot_rows->length() > FLAG_dispatch_table_hot_rows) {
+    hot_rows->TruncateTo(Utils::Maximum(FLAG_dispatch_table_hot_rows, 0));
+  }
+}
+
+void DispatchTableGenerator::ComputeLayoutInfo(
+    const GrowableArray<SelectorRow*>& hot_rows) {
+  layout_info_.table_size = table_size_;
+  layout_info_.rows = table_rows_.length();
+  CacheLineSet lines(Z);
+  for (intptr_t i = 0; i < table_rows_.length(); i++) {
+    SelectorRow* row = table_rows_[i];
+    layout_info_.used_entries += row->total_size();
+    lines.Add(row->ranges(), row->offset());
+  }
+  layout_info_.cache_lines = lines.Size();
+
+  layout_info_.hot_rows = hot_rows.length();
+  CacheLineSet hot_lines(Z);
+  for (intptr_t i = 0; i < hot_rows.length(); i++) {
+    SelectorRow* row = hot_rows[i];
+    layout_info_.hot_entries += row->HotSize();
+    hot_lines.Add(row->hot_ranges(), row->offset());
+  }
+  layout_info_.hot_cache_lines = hot_lines.Size();
 }
 
 ArrayPtr DispatchTableGenerator::BuildCodeArray() {
@@ -88,6 +88,23 @@ class SelectorMap {
 
 class DispatchTableGenerator {
  public:
+  // Occupancy of the computed table, reported by the precompiler tracer.
+  // Cache lines are counted assuming that the table starts at a cache line
+  // boundary.
+  struct LayoutInfo {
+    // Number of entries in the table and number of them used by some row.
+    int32_t table_size = 0;
+    int32_t used_entries = 0;
+    intptr_t rows = 0;
+    intptr_t cache_lines = 0;
+    // Rows placed by --dispatch_table_cache_aware_packing, entries used by
+    // their class ids which are expected to be hot and cache lines touched by
+    // these entries (the estimated hot working set of the table).
+    intptr_t hot_rows = 0;
+    intptr_t hot_entries = 0;
+    intptr_t hot_cache_lines = 0;
+  };
+
   explicit DispatchTableGenerator(Zone* zone);
 
   SelectorMap* selector_map() { return &selector_map_; }
@@ -99,11 +116,15 @@ class DispatchTableGenerator {
   // deserialized as a DispatchTable at runtime.
   ArrayPtr BuildCodeArray();
 
+  const LayoutInfo& layout_info() const { return layout_info_; }
+
  private:
   void ReadTableSelectorInfo();
   void NumberSelectors();
   void SetupSelectorRows();
   void ComputeSelectorOffsets();
+  void SelectHotRows(GrowableArray<SelectorRow*>* hot_rows);
+  void ComputeLayoutInfo(const GrowableArray<SelectorRow*>& hot_rows);
 
   Zone* const zone_;
   ClassTable* classes_;
@@ -114,6 +135,7 @@ class DispatchTableGenerator {
   GrowableArray<SelectorRow*> table_rows_;
 
   SelectorMap selector_map_;
+  LayoutInfo layout_info_;
 };
 
 }  // namespace compiler
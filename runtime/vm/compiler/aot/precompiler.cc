@@ -13,6 +13,8 @@
 #include "vm/closure_functions_cache.h"
 #include "vm/code_patcher.h"
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/aot_profile.h"
+#include "vm/compiler/aot/compiled_function_report.h"
 #include "vm/compiler/aot/precompiler_tracer.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
@@ -34,6 +36,7 @@
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/compiler/frontend/kernel_to_il.h"
 #include "vm/compiler/jit/compiler.h"
+#include "vm/dart.h"
 #include "vm/dart_entry.h"
 #include "vm/exceptions.h"
 #include "vm/ffi/native_assets.h"
@@ -47,6 +50,7 @@
 #include "vm/os.h"
 #include "vm/parser.h"
 #include "vm/program_visitor.h"
+#include "vm/regexp/regexp.h"
 #include "vm/regexp/regexp_assembler.h"
 #include "vm/regexp/regexp_parser.h"
 #include "vm/resolver.h"
@@ -54,6 +58,7 @@
 #include "vm/stack_trace.h"
 #include "vm/symbols.h"
 #include "vm/tags.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/timer.h"
 #include "vm/type_testing_stubs.h"
@@ -80,7 +85,24 @@ DEFINE_FLAG(charp,
             write_retained_reasons_to,
             nullptr,
             "Print reasons for retaining objects to the given file");
+DEFINE_FLAG(int,
+            precompiler_compile_threads,
+            0,
+            "Number of functions whose flow graphs are built and optimized "
+            "concurrently on helper threads. Code is still generated for one "
+            "function at a time in a deterministic order.");
+DEFINE_FLAG(bool,
+            precompile_regexps,
+            false,
+            "Compile regexps created from constant patterns to native code "
+            "instead of interpreting them at runtime.");
+DEFINE_FLAG(bool,
+            aot_coverage,
+            false,
+            "Make precompiled code record which functions and blocks are "
+            "executed. The coverage is written by Dart_WriteCodeCoverage.");
 
+DECLARE_FLAG(charp, aot_profile);
 DECLARE_FLAG(bool, print_flow_graph);
 DECLARE_FLAG(bool, print_flow_graph_optimized);
 DECLARE_FLAG(bool, trace_compiler);
@@ -169,6 +191,9 @@ struct RetainReasons : public AllStatic {
   // The signature is used in a function with an entry point pragma.
   static constexpr const char* kEntryPointPragmaSignature =
       "signature of entry point function";
+  // The function is a specialization of a regexp with a constant pattern.
+  static constexpr const char* kRegExpSpecialization =
+      "regexp specialization";
 };
 
 class RetainedReasonsWriter : public StackResource {
@@ -330,20 +355,29 @@ class RetainedReasonsWriter : public StackResource {
   void* file_;
 };
 
+class PrecompilationBatch;
+
 class PrecompileParsedFunctionHelper : public ValueObject {
  public:
   PrecompileParsedFunctionHelper(Precompiler* precompiler,
                                  ParsedFunction* parsed_function)
       : precompiler_(precompiler),
         parsed_function_(parsed_function),
-        thread_(Thread::Current()) {}
+        thread_(Thread::Current()),
+        report_(precompiler->function_report()) {}
 
   bool Compile();
 
+  // Compiles the function at [index] in [batch] on a helper thread. Returns
+  // false if compilation failed, leaving no sticky error behind.
+  bool CompileInBatch(PrecompilationBatch* batch, intptr_t index);
+
  private:
   ParsedFunction* parsed_function() const { return parsed_function_; }
   Thread* thread() const { return thread_; }
 
+  FlowGraph* BuildAndOptimizeGraph();
+
   bool GenerateCode(FlowGraph* flow_graph);
 
   void FinalizeCompilation(compiler::Assembler* assembler,
@@ -354,10 +388,121 @@ class PrecompileParsedFunctionHelper : public ValueObject {
   Precompiler* precompiler_;
   ParsedFunction* parsed_function_;
   Thread* const thread_;
+  CompiledFunctionReport* const report_;
+  CompiledFunctionReport::Measurements measurements_;
 
   DISALLOW_COPY_AND_ASSIGN(PrecompileParsedFunctionHelper);
 };
 
+// Functions compiled concurrently by PrecompileFunctionTasks, one task per
+// function. Each task builds and optimizes the flow graph of its function,
+// waits until all tasks are done with that and then generates code in the
+// order of the batch. As only one task generates code at a time and no task
+// observes code generated for other functions of the batch while optimizing,
+// the output only depends on the order of the batch.
+class PrecompilationBatch : public ValueObject {
+ public:
+  PrecompilationBatch(Precompiler* precompiler, const Array& functions)
+      : precompiler_(precompiler),
+        functions_(functions),
+        compiled_(functions.Length()) {
+    for (intptr_t i = 0; i < functions.Length(); ++i) {
+      compiled_.Add(false);
+    }
+  }
+
+  Precompiler* precompiler() const { return precompiler_; }
+  const Array& functions() const { return functions_; }
+  intptr_t length() const { return functions_.Length(); }
+
+  // Returns true if code was generated for the function at [index].
+  bool compiled(intptr_t index) const { return compiled_[index]; }
+
+  // Called by the task compiling the function at [index] once its flow graph
+  // is optimized. Returns when it is the turn of this task to generate code.
+  void WaitForTurn(Thread* thread, intptr_t index) {
+    MonitorLocker ml(&monitor_);
+    if (++optimized_count_ == length()) {
+      ml.NotifyAll();
+    }
+    while ((optimized_count_ < length()) || (turn_ != index)) {
+      ml.WaitWithSafepointCheck(thread);
+    }
+  }
+
+  void FinishTurn(intptr_t index, bool compiled) {
+    MonitorLocker ml(&monitor_);
+    ASSERT(turn_ == index);
+    compiled_[index] = compiled;
+    turn_++;
+    ml.NotifyAll();
+  }
+
+  // Called by each task after it has left the isolate group.
+  void TaskExited() {
+    MonitorLocker ml(&monitor_);
+    exited_count_++;
+    ml.NotifyAll();
+  }
+
+  void WaitForTasks(Thread* thread) {
+    MonitorLocker ml(&monitor_);
+    while (exited_count_ < length()) {
+      ml.WaitWithSafepointCheck(thread);
+    }
+  }
+
+ private:
+  Precompiler* const precompiler_;
+  const Array& functions_;
+  MallocGrowableArray<bool> compiled_;
+
+  Monitor monitor_;
+  intptr_t optimized_count_ = 0;
+  intptr_t turn_ = 0;
+  intptr_t exited_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(PrecompilationBatch);
+};
+
+class PrecompileFunctionTask : public ThreadPool::Task {
+ public:
+  PrecompileFunctionTask(IsolateGroup* isolate_group,
+                         PrecompilationBatch* batch,
+                         intptr_t index)
+      : isolate_group_(isolate_group), batch_(batch), index_(index) {}
+
+  virtual Priority priority() const { return kCompilerPriority; }
+
+  virtual void Run() {
+    bool result = Thread::EnterIsolateGroupAsHelper(
+        isolate_group_, Thread::kCompilerTask, /*bypass_safepoint=*/false);
+    ASSERT(result);
+    {
+      Thread* thread = Thread::Current();
+      StackZone stack_zone(thread);
+      Zone* zone = stack_zone.GetZone();
+      HANDLESCOPE(thread);
+      const auto& function = Function::ZoneHandle(
+          zone, Function::RawCast(batch_->functions().At(index_)));
+      ParsedFunction* parsed_function =
+          new (zone) ParsedFunction(thread, function);
+      PrecompileParsedFunctionHelper helper(batch_->precompiler(),
+                                            parsed_function);
+      helper.CompileInBatch(batch_, index_);
+    }
+    Thread::ExitIsolateGroupAsHelper(/*bypass_safepoint=*/false);
+    batch_->TaskExited();
+  }
+
+ private:
+  IsolateGroup* const isolate_group_;
+  PrecompilationBatch* const batch_;
+  const intptr_t index_;
+
+  DISALLOW_COPY_AND_ASSIGN(PrecompileFunctionTask);
+};
+
 static void Jump(const Error& error) {
   Thread::Current()->long_jump_base()->Jump(1, error);
 }
@@ -403,6 +548,11 @@ Precompiler::Precompiler(Thread* thread)
           thread->isolate_group()->object_store()->libraries())),
       pending_functions_(
           GrowableObjectArray::Handle(GrowableObjectArray::New())),
+      precompiled_regexps_(
+          GrowableObjectArray::Handle(GrowableObjectArray::New())),
+      coverage_arrays_(
+          GrowableObjectArray::Handle(GrowableObjectArray::New())),
+      coverage_map_(Array::Handle(HashTables::New<FunctionMap>(16))),
       sent_selectors_(),
       functions_called_dynamically_(
           HashTables::New<FunctionSet>(/*initial_capacity=*/1024)),
@@ -478,6 +628,11 @@ void Precompiler::DoCompileAll() {
 
       ClassFinalizer::SortClasses();
 
+      // Class ids are final from here on, so the profile can be resolved.
+      if (FLAG_aot_profile != nullptr) {
+        AotProfile::Load(T, FLAG_aot_profile);
+      }
+
       // Collects type usage information which allows us to decide when/how to
       // optimize runtime type tests.
       TypeUsageInfo type_usage_info(T);
@@ -507,6 +662,7 @@ void Precompiler::DoCompileAll() {
           /*including_nonchanging_cids=*/true);
 
       tracer_ = PrecompilerTracer::StartTracingIfRequested(this);
+      function_report_ = CompiledFunctionReport::StartIfRequested(this);
 
       // All stubs have already been generated, all of them share the same pool.
       // We use that pool to initialize our global object pool, to guarantee
@@ -588,6 +744,14 @@ void Precompiler::DoCompileAll() {
         TraceForRetainedFunctions();
       }
 
+      FinalizeRegExps();
+      FinalizeCoverage();
+
+      if (function_report_ != nullptr) {
+        function_report_->Finalize();
+        function_report_ = nullptr;
+      }
+
       FinalizeDispatchTable();
       ReplaceFunctionStaticCallEntries();
 
@@ -770,6 +934,10 @@ void Precompiler::Iterate() {
     changed_ = false;
 
     while (pending_functions_.Length() > 0) {
+      if (FLAG_precompiler_compile_threads > 0) {
+        ProcessFunctionsInParallel();
+        continue;
+      }
       function ^= pending_functions_.RemoveLast();
       ProcessFunction(function);
     }
@@ -877,6 +1045,57 @@ void Precompiler::ProcessFunction(const Function& function) {
   AddCalleesOf(function, gop_offset);
 }
 
+void Precompiler::ProcessFunctionsInParallel() {
+  PRECOMPILER_TIMER_SCOPE(this, CompileFunction);
+  HANDLESCOPE(T);
+  const intptr_t batch_length =
+      Utils::Minimum(static_cast<intptr_t>(FLAG_precompiler_compile_threads),
+                     pending_functions_.Length());
+  const auto& functions = Array::Handle(Z, Array::New(batch_length));
+  for (intptr_t i = 0; i < batch_length; ++i) {
+    functions.SetAt(i, Object::Handle(Z, pending_functions_.RemoveLast()));
+  }
+
+  const intptr_t gop_offset = global_object_pool_builder()->CurrentLength();
+  PrecompilationBatch batch(this, functions);
+  {
+    NoActiveIsolateScope no_isolate_scope;
+    for (intptr_t i = 0; i < batch_length; ++i) {
+      bool result = Dart::thread_pool()->Run<PrecompileFunctionTask>(
+          IG, &batch, i);
+      ASSERT(result);
+    }
+    batch.WaitForTasks(T);
+  }
+
+  // Pool entries added by the batch are scanned once, together with the
+  // callees of its first function.
+  intptr_t callees_gop_offset = gop_offset;
+  Function& function = Function::Handle(Z);
+  for (intptr_t i = 0; i < batch_length; ++i) {
+    function ^= functions.At(i);
+    if (!batch.compiled(i)) {
+      // Compile again on this thread to report the error.
+      ProcessFunction(function);
+    } else {
+      TracingScope tracing_scope(this);
+      function_count_++;
+      if (FLAG_trace_precompiler) {
+        THR_Print("Precompiling %" Pd " %s (%s, %s)\n", function_count_,
+                  function.ToLibNamePrefixedQualifiedCString(),
+                  function.token_pos().ToCString(),
+                  Function::KindToCString(function.kind()));
+      }
+      if (is_tracing()) {
+        tracer_->WriteCompileFunctionEvent(function);
+      }
+      function.ClearICDataArray();
+      AddCalleesOf(function, callees_gop_offset);
+    }
+    callees_gop_offset = global_object_pool_builder()->CurrentLength();
+  }
+}
+
 void Precompiler::AddCalleesOf(const Function& function, intptr_t gop_offset) {
   PRECOMPILER_TIMER_SCOPE(this, AddCalleesOf);
   ASSERT(function.HasCode());
@@ -1457,6 +1676,35 @@ void Precompiler::AddTableSelector(const compiler::TableSelector* selector) {
   changed_ = true;
 }
 
+void Precompiler::AddRegExp(const String& pattern, RegExpFlags flags) {
+  Thread* thread = Thread::Current();
+  Zone* zone = thread->zone();
+  // Invalid patterns are left to the RegExp factory, which throws a
+  // FormatException for them at runtime.
+  RegExpCompileData compile_data;
+  if (!RegExpParser::TryParseRegExp(pattern, flags, &compile_data)) return;
+
+  const auto& regexp = RegExp::Handle(
+      zone, RegExpEngine::InsertCanonical(thread, pattern, flags));
+  if (Object::Handle(zone, regexp.function(kOneByteStringCid, false))
+          .IsFunction()) {
+    return;
+  }
+
+  const auto& owner = Class::Handle(
+      zone, Library::Handle(zone, Library::CoreLibrary())
+                .LookupClass(Symbols::RegExp()));
+  auto& function = Function::Handle(zone);
+  for (intptr_t cid = kOneByteStringCid; cid <= kTwoByteStringCid; cid++) {
+    for (const bool sticky : {false, true}) {
+      CreateSpecializedFunction(thread, zone, regexp, cid, sticky, owner);
+      function = regexp.function(cid, sticky);
+      AddFunction(function, RetainReasons::kRegExpSpecialization);
+    }
+  }
+  precompiled_regexps_.Add(regexp);
+}
+
 bool Precompiler::IsHitByTableSelector(const Function& function) {
   const int32_t selector_id = selector_map()->SelectorId(function);
   if (selector_id == compiler::SelectorMap::kInvalidSelectorId) return false;
@@ -2024,6 +2272,20 @@ void Precompiler::TraceForRetainedFunctions() {
     return true;  // Continue iteration.
   });
 
+  // Regexp specializations are only reachable from their RegExp and are
+  // invoked through DartEntry, so their Code objects must be kept.
+  RegExp& regexp = RegExp::Handle(Z);
+  for (intptr_t i = 0; i < precompiled_regexps_.Length(); i++) {
+    regexp ^= precompiled_regexps_.At(i);
+    for (intptr_t cid = kOneByteStringCid; cid <= kTwoByteStringCid; cid++) {
+      for (const bool sticky : {false, true}) {
+        function = regexp.function(cid, sticky);
+        AddTypesOf(function);
+        functions_called_dynamically_.Insert(function);
+      }
+    }
+  }
+
 #ifdef DEBUG
   // Make sure functions_to_retain_ is a super-set of
   // possibly_retained_functions_.
@@ -2041,6 +2303,95 @@ void Precompiler::TraceForRetainedFunctions() {
 #endif  // DEBUG
 }
 
+void Precompiler::FinalizeRegExps() {
+  if (precompiled_regexps_.Length() == 0) return;
+
+  IG->object_store()->set_precompiled_regexps(
+      Array::Handle(Z, Array::MakeFixedLength(precompiled_regexps_)));
+
+  // The table of canonical regexps is weak. Only keep the precompiled
+  // regexps in it, which are held by the object store, so no entry is
+  // cleared when the snapshot is written.
+  CanonicalRegExpSet table(
+      Z, HashTables::New<CanonicalRegExpSet>(precompiled_regexps_.Length(),
+                                             Heap::kOld));
+  RegExp& regexp = RegExp::Handle(Z);
+  for (intptr_t i = 0; i < precompiled_regexps_.Length(); i++) {
+    regexp ^= precompiled_regexps_.At(i);
+    table.Insert(regexp);
+  }
+  IG->object_store()->set_regexp_table(table.Release());
+}
+
+ArrayPtr Precompiler::RegisterCoverageArray(const Function& function,
+                                            const Array& array) {
+  ASSERT(!array.IsNull());
+  SafepointMutexLocker ml(&coverage_mutex_);
+  Zone* zone = Thread::Current()->zone();
+  FunctionMap map(zone, coverage_map_.ptr());
+  const auto& existing =
+      Array::Handle(zone, Array::RawCast(map.GetOrNull(function)));
+  bool same_positions = !existing.IsNull() &&
+                        (existing.Length() == array.Length());
+  for (intptr_t i = 0; same_positions && (i < array.Length()); i += 2) {
+    same_positions = existing.At(i) == array.At(i);
+  }
+  ArrayPtr result = array.ptr();
+  if (same_positions) {
+    result = existing.ptr();
+  } else {
+    if (existing.IsNull()) {
+      map.UpdateOrInsert(function, array);
+    }
+    coverage_arrays_.Add(function);
+    coverage_arrays_.Add(array);
+  }
+  coverage_map_ = map.Release().ptr();
+  return result;
+}
+
+void Precompiler::FinalizeCoverage() {
+  if (coverage_arrays_.Length() == 0) return;
+
+  // Group the arrays by script, so they can be merged without a lookup at
+  // runtime: [uri, arrays of uri, uri, arrays of uri, ...].
+  CStringIntMap indices;
+  GrowableArray<const GrowableObjectArray*> arrays_by_script(Z, 64);
+  const auto& uris = GrowableObjectArray::Handle(Z, GrowableObjectArray::New());
+  auto& function = Function::Handle(Z);
+  auto& script = Script::Handle(Z);
+  auto& uri = String::Handle(Z);
+  for (intptr_t i = 0; i < coverage_arrays_.Length(); i += 2) {
+    function ^= coverage_arrays_.At(i);
+    script = function.script();
+    if (script.IsNull()) continue;
+    uri = script.url();
+    const char* uri_cstr = uri.ToCString();
+    auto pair = indices.Lookup(uri_cstr);
+    intptr_t index;
+    if (pair == nullptr) {
+      index = uris.Length();
+      uris.Add(uri);
+      arrays_by_script.Add(
+          &GrowableObjectArray::ZoneHandle(Z, GrowableObjectArray::New()));
+      indices.Insert({uri_cstr, index});
+    } else {
+      index = pair->value;
+    }
+    arrays_by_script[index]->Add(
+        Object::Handle(Z, coverage_arrays_.At(i + 1)));
+  }
+
+  const auto& coverage = Array::Handle(Z, Array::New(2 * uris.Length()));
+  auto& arrays = Array::Handle(Z);
+  for (intptr_t i = 0; i < uris.Length(); i++) {
+    coverage.SetAt(2 * i, Object::Handle(Z, uris.At(i)));
+    arrays = Array::MakeFixedLength(*arrays_by_script[i]);
+    coverage.SetAt(2 * i + 1, arrays);
+  }
+  IG->object_store()->set_code_coverage(coverage);
+}
+
 void Precompiler::FinalizeDispatchTable() {
   PRECOMPILER_TIMER_SCOPE(this, FinalizeDispatchTable);
   HANDLESCOPE(T);
@@ -3454,7 +3805,8 @@ void PrecompileParsedFunctionHelper::FinalizeCompilation(
   graph_compiler->FinalizeCodeSourceMap(code);
 
   // Installs code while at safepoint.
-  ASSERT(thread()->IsDartMutatorThread());
+  ASSERT(thread()->IsDartMutatorThread() ||
+         (thread()->task_kind() == Thread::kCompilerTask));
   function.InstallOptimizedCode(code);
 
   if (function.IsFfiCallbackTrampoline()) {
@@ -3473,7 +3825,85 @@ static void GenerateNecessaryAllocationStubs(FlowGraph* flow_graph) {
   }
 }
 
+// Returns true if |call| creates a RegExp from a constant pattern with
+// constant flags, which are returned in |pattern| and |flags|.
+static bool IsRegExpLiteral(StaticCallInstr* call,
+                            String* pattern,
+                            RegExpFlags* flags) {
+  const Function& target = call->function();
+  if (!target.IsFactory()) return false;
+  const Class& owner = Class::Handle(target.Owner());
+  if ((owner.library() != Library::CoreLibrary()) ||
+      ((owner.Name() != Symbols::RegExp().ptr()) &&
+       (owner.Name() != Symbols::_RegExp().ptr()))) {
+    return false;
+  }
+
+  // The first argument is the type arguments of the factory.
+  const intptr_t pattern_index = call->FirstArgIndex() + 1;
+  Value* pattern_value = call->ArgumentValueAt(pattern_index);
+  if (!pattern_value->BindsToConstant() ||
+      !pattern_value->BoundConstant().IsString()) {
+    return false;
+  }
+  *pattern = String::Cast(pattern_value->BoundConstant()).ptr();
+
+  bool multi_line = false;
+  bool case_sensitive = true;
+  bool unicode = false;
+  bool dot_all = false;
+  const Array& names = call->argument_names();
+  const intptr_t num_named = names.IsNull() ? 0 : names.Length();
+  const intptr_t first_named = call->ArgumentCount() - num_named;
+  auto& name = String::Handle();
+  for (intptr_t i = 0; i < num_named; i++) {
+    Value* value = call->ArgumentValueAt(first_named + i);
+    if (!value->BindsToConstant() || !value->BoundConstant().IsBool()) {
+      return false;
+    }
+    const bool is_true = value->BoundConstant().ptr() == Bool::True().ptr();
+    name ^= names.At(i);
+    if (name.Equals("multiLine")) {
+      multi_line = is_true;
+    } else if (name.Equals("caseSensitive")) {
+      case_sensitive = is_true;
+    } else if (name.Equals("unicode")) {
+      unicode = is_true;
+    } else if (name.Equals("dotAll")) {
+      dot_all = is_true;
+    } else {
+      return false;
+    }
+  }
+
+  // Must agree with the RegExp factory.
+  *flags = RegExpFlags();
+  flags->SetGlobal();
+  if (!case_sensitive) flags->SetIgnoreCase();
+  if (multi_line) flags->SetMultiLine();
+  if (unicode) flags->SetUnicode();
+  if (dot_all) flags->SetDotAll();
+  return true;
+}
+
+// Compiles the regexps created by |flow_graph| from constant patterns.
+static void AddRegExpLiterals(Precompiler* precompiler, FlowGraph* flow_graph) {
+  auto& pattern = String::Handle();
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      RegExpFlags flags;
+      if (auto call = it.Current()->AsStaticCall()) {
+        if (IsRegExpLiteral(call, &pattern, &flags)) {
+          precompiler->AddRegExp(pattern, flags);
+        }
+      }
+    }
+  }
+}
+
 bool PrecompileParsedFunctionHelper::GenerateCode(FlowGraph* flow_graph) {
+  const int64_t start_micros =
+      report_ != nullptr ? OS::GetCurrentMonotonicMicros() : 0;
   // We may reattempt compilation if the function needs to be assembled using
   // far branches on ARM. In the else branch of the setjmp call, done is set to
   // false, and use_far_branches is set to true if there is a longjmp from the
@@ -3517,11 +3947,15 @@ bool PrecompileParsedFunctionHelper::GenerateCode(FlowGraph* flow_graph) {
 
       CompilerPassState pass_state(thread(), flow_graph, precompiler_);
       pass_state.graph_compiler = &graph_compiler;
+      if (report_ != nullptr) {
+        pass_state.pass_micros = measurements_.pass_micros;
+      }
       CompilerPass::GenerateCode(&pass_state);
       {
         COMPILER_TIMINGS_TIMER_SCOPE(thread(), FinalizeCode);
         TIMELINE_DURATION(thread(), CompilerVerbose, "FinalizeCompilation");
-        ASSERT(thread()->IsDartMutatorThread());
+        ASSERT(thread()->IsDartMutatorThread() ||
+               (thread()->task_kind() == Thread::kCompilerTask));
         FinalizeCompilation(&assembler, &graph_compiler, flow_graph,
                             function_stats);
       }
@@ -3538,6 +3972,10 @@ bool PrecompileParsedFunctionHelper::GenerateCode(FlowGraph* flow_graph) {
         for (intptr_t i = 0; i < call_selectors.length(); i++) {
           precompiler_->AddTableSelector(call_selectors[i]);
         }
+
+        if (FLAG_precompile_regexps) {
+          AddRegExpLiterals(precompiler_, flow_graph);
+        }
       } else {
         // We should not be generating code outside of these two specific
         // precompilation phases.
@@ -3591,39 +4029,52 @@ bool PrecompileParsedFunctionHelper::GenerateCode(FlowGraph* flow_graph) {
       is_compiled = false;
     }
   }
+
+  if (is_compiled && (report_ != nullptr) &&
+      (precompiler_->phase() == Precompiler::Phase::kFixpointCodeGeneration)) {
+    measurements_.compile_micros +=
+        OS::GetCurrentMonotonicMicros() - start_micros;
+    measurements_.CountChecks(flow_graph);
+    const Function& function = parsed_function()->function();
+    report_->Add(function, Code::Handle(function.CurrentCode()),
+                 measurements_);
+  }
   return is_compiled;
 }
 
-// Return false if bailed out.
-bool PrecompileParsedFunctionHelper::Compile() {
-  ASSERT(CompilerState::Current().is_aot());
+FlowGraph* PrecompileParsedFunctionHelper::BuildAndOptimizeGraph() {
   Zone* const zone = thread()->zone();
-  HANDLESCOPE(thread());
-
-  FlowGraph* flow_graph = nullptr;
   const Function& function = parsed_function()->function();
-  ASSERT(!function.IsIrregexpFunction());
-  ASSERT(function.IsOptimizable());
-
-  CompilerState compiler_state(thread(), /*is_aot=*/true,
-                               /*is_optimizing=*/true,
-                               CompilerState::ShouldTrace(function));
-  compiler_state.set_function(function);
-
+  FlowGraph* flow_graph = nullptr;
+  const int64_t start_micros =
+      report_ != nullptr ? OS::GetCurrentMonotonicMicros() : 0;
   {
     ZoneGrowableArray<const ICData*>* ic_data_array =
         new (zone) ZoneGrowableArray<const ICData*>();
 
     TIMELINE_DURATION(thread(), CompilerVerbose, "BuildFlowGraph");
     COMPILER_TIMINGS_TIMER_SCOPE(thread(), BuildGraph);
-    kernel::FlowGraphBuilder builder(parsed_function(), ic_data_array,
-                                     /* not building var desc */ nullptr,
-                                     /* not inlining */ nullptr,
-                                     /*optimizing=*/true,
-                                     Compiler::kNoOSRDeoptId);
-    flow_graph = builder.BuildGraph();
+    if (function.IsIrregexpFunction()) {
+      // Specializations of regexps with constant patterns, see
+      // --precompile_regexps.
+      flow_graph = Compiler::BuildFlowGraph(zone, parsed_function(),
+                                            ic_data_array,
+                                            Compiler::kNoOSRDeoptId,
+                                            /*optimized=*/true);
+    } else {
+      kernel::FlowGraphBuilder builder(parsed_function(), ic_data_array,
+                                       /* not building var desc */ nullptr,
+                                       /* not inlining */ nullptr,
+                                       /*optimizing=*/true,
+                                       Compiler::kNoOSRDeoptId);
+      flow_graph = builder.BuildGraph();
+    }
     ASSERT(flow_graph != nullptr);
   }
+  if (report_ != nullptr) {
+    measurements_.build_graph_micros =
+        OS::GetCurrentMonotonicMicros() - start_micros;
+  }
 
   flow_graph->PopulateWithICData(function);
 
@@ -3633,10 +4084,33 @@ bool PrecompileParsedFunctionHelper::Compile() {
     AotCallSpecializer call_specializer(precompiler_, flow_graph);
     CompilerPassState pass_state(thread(), flow_graph, precompiler_);
     pass_state.call_specializer = &call_specializer;
+    if (report_ != nullptr) {
+      pass_state.pass_micros = measurements_.pass_micros;
+    }
 
     flow_graph = CompilerPass::RunPipeline(CompilerPass::kAOT, &pass_state);
   }
+  if (report_ != nullptr) {
+    measurements_.compile_micros =
+        OS::GetCurrentMonotonicMicros() - start_micros;
+  }
+  return flow_graph;
+}
+
+// Return false if bailed out.
+bool PrecompileParsedFunctionHelper::Compile() {
+  ASSERT(CompilerState::Current().is_aot());
+  HANDLESCOPE(thread());
+
+  const Function& function = parsed_function()->function();
+  ASSERT(function.IsOptimizable());
+
+  CompilerState compiler_state(thread(), /*is_aot=*/true,
+                               /*is_optimizing=*/true,
+                               CompilerState::ShouldTrace(function));
+  compiler_state.set_function(function);
 
+  FlowGraph* flow_graph = BuildAndOptimizeGraph();
   ASSERT(precompiler_ != nullptr);
 
   // When generating code in bare instruction mode all code objects
@@ -3652,6 +4126,41 @@ bool PrecompileParsedFunctionHelper::Compile() {
   return GenerateCode(flow_graph);
 }
 
+bool PrecompileParsedFunctionHelper::CompileInBatch(PrecompilationBatch* batch,
+                                                    intptr_t index) {
+  const Function& function = parsed_function()->function();
+  ASSERT(function.IsOptimizable());
+
+  CompilerState compiler_state(thread(), /*is_aot=*/true,
+                               /*is_optimizing=*/true,
+                               CompilerState::ShouldTrace(function));
+  compiler_state.set_function(function);
+
+  // Errors are reported when the function is compiled again on the main
+  // thread.
+  FlowGraph* volatile flow_graph = nullptr;
+  {
+    LongJumpScope jump;
+    if (DART_SETJMP(*jump.Set()) == 0) {
+      flow_graph = BuildAndOptimizeGraph();
+    } else {
+      thread()->ClearStickyError();
+    }
+  }
+
+  batch->WaitForTurn(thread(), index);
+  bool compiled = false;
+  if (flow_graph != nullptr) {
+    GenerateNecessaryAllocationStubs(flow_graph);
+    compiled = GenerateCode(flow_graph);
+    if (!compiled) {
+      thread()->ClearStickyError();
+    }
+  }
+  batch->FinishTurn(index, compiled);
+  return compiled;
+}
+
 void Precompiler::CompileFunction(Precompiler* precompiler,
                                   Thread* thread,
                                   const Function& function) {
@@ -22,6 +22,7 @@ namespace dart {
 
 // Forward declarations.
 class Class;
+class CompiledFunctionReport;
 class Error;
 class Field;
 class Function;
@@ -81,6 +82,7 @@ struct FunctionKeyTraits {
 };
 
 typedef UnorderedHashSet<FunctionKeyTraits> FunctionSet;
+typedef UnorderedHashMap<FunctionKeyTraits> FunctionMap;
 
 class ClassKeyValueTrait {
  public:
@@ -260,10 +262,22 @@ class Precompiler : public ValueObject {
     return dispatch_table_generator_->selector_map();
   }
 
+  compiler::DispatchTableGenerator* dispatch_table_generator() const {
+    return dispatch_table_generator_;
+  }
+
   static Precompiler* Instance() { return singleton_; }
 
   void AddField(const Field& field);
   void AddTableSelector(const compiler::TableSelector* selector);
+  // Compiles the regexp for |pattern| and |flags| to native code, see
+  // --precompile_regexps.
+  void AddRegExp(const String& pattern, RegExpFlags flags);
+  // Returns the array in which code compiled for |function| records its
+  // coverage, see --aot_coverage. This is |array| unless an array with the
+  // same positions was registered by an earlier flow graph of |function|, so
+  // all copies of an inlined function record into the same array.
+  ArrayPtr RegisterCoverageArray(const Function& function, const Array& array);
 
   enum class Phase {
     kPreparation,
@@ -276,6 +290,12 @@ class Precompiler : public ValueObject {
 
   bool is_tracing() const { return is_tracing_; }
 
+  CompiledFunctionReport* function_report() const { return function_report_; }
+
+  bool IsFunctionRetained(const Function& function) {
+    return functions_to_retain_.ContainsKey(function);
+  }
+
   Thread* thread() const { return thread_; }
   Zone* zone() const { return zone_; }
 
@@ -332,12 +352,17 @@ class Precompiler : public ValueObject {
   bool HasApiUse(const Object& obj);
 
   void ProcessFunction(const Function& function);
+  // Compiles up to --precompiler_compile_threads pending functions
+  // concurrently.
+  void ProcessFunctionsInParallel();
   void CheckForNewDynamicFunctions();
   void CollectCallbackFields();
 
   void AttachOptimizedTypeTestingStub();
 
   void TraceForRetainedFunctions();
+  void FinalizeRegExps();
+  void FinalizeCoverage();
   void FinalizeDispatchTable();
   void ReplaceFunctionStaticCallEntries();
   void DropFunctions();
@@ -388,6 +413,13 @@ class Precompiler : public ValueObject {
   compiler::ObjectPoolBuilder global_object_pool_builder_;
   GrowableObjectArray& libraries_;
   const GrowableObjectArray& pending_functions_;
+  const GrowableObjectArray& precompiled_regexps_;
+  // Pairs of functions and their coverage arrays, and the first array of each
+  // function. Guarded by coverage_mutex_ as flow graphs are built
+  // concurrently.
+  const GrowableObjectArray& coverage_arrays_;
+  Array& coverage_map_;
+  Mutex coverage_mutex_;
   SymbolSet sent_selectors_;
   FunctionSet functions_called_dynamically_;
   FunctionSet functions_with_entry_point_pragmas_;
@@ -411,6 +443,7 @@ class Precompiler : public ValueObject {
 
   Phase phase_ = Phase::kPreparation;
   PrecompilerTracer* tracer_ = nullptr;
+  CompiledFunctionReport* function_report_ = nullptr;
   RetainedReasonsWriter* retained_reasons_writer_ = nullptr;
   bool is_tracing_ = false;
 };
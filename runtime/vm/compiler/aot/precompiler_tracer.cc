@@ -53,6 +53,8 @@ void PrecompilerTracer::Finalize() {
   WriteEntityTable();
   Write(",");
   WriteStringTable();
+  Write(",");
+  WriteDispatchTableInfo();
   Write("}\n");
 
   const intptr_t output_length = buffer_.length();
@@ -114,6 +116,15 @@ void PrecompilerTracer::WriteEntityTable() {
   Write("]");
 }
 
+void PrecompilerTracer::WriteDispatchTableInfo() {
+  const auto& info = precompiler_->dispatch_table_generator()->layout_info();
+  Write("\"dispatch_table\":{\"size\":%" Pd32 ",\"used\":%" Pd32
+        ",\"rows\":%" Pd ",\"lines\":%" Pd ",\"hot_rows\":%" Pd
+        ",\"hot_entries\":%" Pd ",\"hot_lines\":%" Pd "}",
+        info.table_size, info.used_entries, info.rows, info.cache_lines,
+        info.hot_rows, info.hot_entries, info.hot_cache_lines);
+}
+
 void PrecompilerTracer::WriteStringTable() {
   Write("\"strings\":[");
   GrowableArray<const char*> strings_by_id(strings_.NumOccupied());
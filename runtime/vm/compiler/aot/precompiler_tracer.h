@@ -127,6 +127,7 @@ class PrecompilerTracer : public ZoneAllocated {
 
   void WriteEntityTable();
   void WriteStringTable();
+  void WriteDispatchTableInfo();
 
   Zone* zone_;
   Precompiler* precompiler_;
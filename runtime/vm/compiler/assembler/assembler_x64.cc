@@ -502,6 +502,46 @@ void Assembler::EmitL(int dst, int src, int opcode, int prefix2, int prefix1) {
   EmitRegisterOperand(dst & 7, src);
 }
 
+void Assembler::EmitVex(XmmRegister dst,
+                        XmmRegister src1,
+                        XmmRegister src2,
+                        int opcode,
+                        int prefix) {
+  ASSERT(dst <= XMM15 && src1 <= XMM15 && src2 <= XMM15);
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  // The legacy prefix is folded into the pp field.
+  int pp = 0;
+  switch (prefix) {
+    case -1:
+      break;
+    case 0x66:
+      pp = 1;
+      break;
+    case 0xF3:
+      pp = 2;
+      break;
+    case 0xF2:
+      pp = 3;
+      break;
+    default:
+      UNREACHABLE();
+  }
+  // R, X, B and vvvv are stored inverted; L (vector length) is 0 for 128-bit.
+  const uint8_t r = dst > 7 ? 0 : 0x80;
+  const uint8_t vvvv = (~src1 & 0xF) << 3;
+  if (src2 > 7) {
+    // Three byte form, needed for VEX.B. X is not used, map is 0F.
+    EmitUint8(0xC4);
+    EmitUint8(r | 0x40 | 0x01);
+    EmitUint8(vvvv | pp);
+  } else {
+    EmitUint8(0xC5);
+    EmitUint8(r | vvvv | pp);
+  }
+  EmitUint8(opcode);
+  EmitRegisterOperand(dst & 7, src2);
+}
+
 void Assembler::EmitW(Register dst,
                       Register src,
                       int opcode,
@@ -317,6 +317,9 @@ class Assembler : public AssemblerBase {
   void popq(const Address& address) { EmitUnaryL(address, 0x8F, 0); }
 
   void setcc(Condition condition, ByteRegister dst);
+  void cmovq(Condition condition, Register dst, Register src) {
+    EmitQ(dst, src, 0x40 + condition, 0x0F);
+  }
 
   void EnterFullSafepoint();
   void ExitFullSafepoint(bool ignore_unwind_in_progress);
@@ -467,6 +470,24 @@ class Assembler : public AssemblerBase {
 #undef AX
 #undef XA
 
+  // VEX encoded three operand forms of the packed instructions above, which
+  // leave both sources intact. Only available if AVX is supported.
+#define DECLARE_VEX_XMM(name, code)                                            \
+  void v##name##ps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {      \
+    EmitVex(dst, src1, src2, 0x50 + code);                                     \
+  }                                                                            \
+  void v##name##pd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {      \
+    EmitVex(dst, src1, src2, 0x50 + code, 0x66);                               \
+  }
+  XMM_ALU_CODES(DECLARE_VEX_XMM)
+#undef DECLARE_VEX_XMM
+  void vsubpl(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+    EmitVex(dst, src1, src2, 0xFA, 0x66);
+  }
+  void vaddpl(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+    EmitVex(dst, src1, src2, 0xFE, 0x66);
+  }
+
 #define DECLARE_CMPPS(name, code)                                              \
   void cmpps##name(XmmRegister dst, XmmRegister src) {                         \
     EmitL(dst, src, 0xC2, 0x0F);                                               \
@@ -1468,6 +1489,12 @@ class Assembler : public AssemblerBase {
              int prefix2 = -1,
              int prefix1 = -1);
   void EmitB(int reg, const Address& address, int opcode);
+  // Emits a 128-bit VEX encoded instruction from the 0F opcode map.
+  void EmitVex(XmmRegister dst,
+               XmmRegister src1,
+               XmmRegister src2,
+               int opcode,
+               int prefix = -1);
   void CmpPS(XmmRegister dst, XmmRegister src, int condition);
 
   inline void EmitUint8(uint8_t value);
@@ -3726,6 +3726,46 @@ ASSEMBLER_TEST_RUN(PackedFPOperations, test) {
       "ret\n");
 }
 
+ASSEMBLER_TEST_GENERATE(PackedFPOperationsVex, assembler) {
+  __ movq(RAX, Immediate(bit_cast<int32_t, float>(12.3f)));
+  __ movd(XMM10, RAX);
+  __ shufps(XMM10, XMM10, Immediate(0x0));
+  __ movq(RAX, Immediate(bit_cast<int32_t, float>(3.4f)));
+  __ movd(XMM9, RAX);
+  __ shufps(XMM9, XMM9, Immediate(0x0));
+  __ vaddps(XMM2, XMM10, XMM9);   // 15.7f
+  __ vmulps(XMM11, XMM2, XMM9);   // 53.38f
+  __ vsubps(XMM1, XMM11, XMM9);   // 49.98f
+  __ vdivps(XMM0, XMM1, XMM9);    // 14.7f
+  __ vaddpd(XMM12, XMM10, XMM2);  // Leaves the sources intact.
+  __ shufps(XMM0, XMM0, Immediate(0x55));  // Copy second lane into all 4 lanes.
+  __ ret();
+}
+
+ASSEMBLER_TEST_RUN(PackedFPOperationsVex, test) {
+  SetFlagScope<bool> sfs(&FLAG_use_avx, true);
+  if (!HostCPUFeatures::avx_supported()) {
+    return;
+  }
+  typedef float (*PackedFPOperationsVexCode)();
+  float res = reinterpret_cast<PackedFPOperationsVexCode>(test->entry())();
+  EXPECT_FLOAT_EQ(14.7f, res, 0.001f);
+  EXPECT_DISASSEMBLY(
+      "movl rax,0x4144cccd\n"
+      "movd xmm10,rax\n"
+      "shufps xmm10,xmm10 [0]\n"
+      "movl rax,0x4059999a\n"
+      "movd xmm9,rax\n"
+      "shufps xmm9,xmm9 [0]\n"
+      "vaddps xmm2,xmm10,xmm9\n"
+      "vmulps xmm11,xmm2,xmm9\n"
+      "vsubps xmm1,xmm11,xmm9\n"
+      "vdivps xmm0,xmm1,xmm9\n"
+      "vaddpd xmm12,xmm10,xmm2\n"
+      "shufps xmm0,xmm0 [55]\n"
+      "ret\n");
+}
+
 ASSEMBLER_TEST_GENERATE(PackedIntOperations, assembler) {
   __ movl(RAX, Immediate(0x2));
   __ movd(XMM0, RAX);
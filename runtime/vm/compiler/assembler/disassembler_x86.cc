@@ -347,6 +347,9 @@ class DisassemblerX64 : public ValueObject {
   const char* TwoByteMnemonic(uint8_t opcode);
   int TwoByteOpcodeInstruction(uint8_t* data);
   int Print660F38Instruction(uint8_t* data);
+#if defined(TARGET_ARCH_X64)
+  int VexInstruction(uint8_t* data);
+#endif
 
   int F6F7Instruction(uint8_t* data);
   int ShiftInstruction(uint8_t* data);
@@ -1649,6 +1652,48 @@ const char* DisassemblerX64::TwoByteMnemonic(uint8_t opcode) {
   }
 }
 
+#if defined(TARGET_ARCH_X64)
+// Handles the VEX encoded three operand packed instructions emitted by the
+// assembler: 128-bit operations from the 0F map.
+int DisassemblerX64::VexInstruction(uint8_t* data) {
+  uint8_t* current = data + 1;
+  // R, X, B and vvvv are stored inverted.
+  uint8_t rex = REX_PREFIX | ((*current & 0x80) == 0 ? REX_R : 0);
+  if (*data == 0xC4) {
+    if ((*current & 0x1F) != 0x01) {
+      UnimplementedInstruction(*data);
+      return 1;
+    }
+    if ((*current & 0x20) == 0) rex |= REX_B;
+    current++;
+  }
+  const int src1 = (~*current >> 3) & 0xF;
+  const int pp = *current & 0x3;
+  const bool vector_length_256 = (*current & 0x4) != 0;
+  current++;
+  const uint8_t opcode = *current++;
+  const char* mnemonic = nullptr;
+  if (!vector_length_256 && opcode >= 0x50 && opcode <= 0x5F && pp <= 1) {
+    const XmmMnemonic& names = xmm_instructions[opcode & 0xF];
+    mnemonic = pp == 0 ? names.ps_name : names.pd_name;
+  } else if (!vector_length_256 && pp == 1 && opcode == 0xFE) {
+    mnemonic = "paddd";
+  } else if (!vector_length_256 && pp == 1 && opcode == 0xFA) {
+    mnemonic = "psubd";
+  } else {
+    UnimplementedInstruction(*data);
+    return 1;
+  }
+  setRex(rex);
+  int mod, regop, rm;
+  get_modrm(*current, &mod, &regop, &rm);
+  Print("v%s %s,%s,", mnemonic, NameOfXMMRegister(regop),
+        NameOfXMMRegister(src1));
+  current += PrintRightXMMOperand(current);
+  return current - data;
+}
+#endif  // defined(TARGET_ARCH_X64)
+
 int DisassemblerX64::InstructionDecode(uword pc) {
   uint8_t* data = reinterpret_cast<uint8_t*>(pc);
 
@@ -1692,6 +1737,14 @@ int DisassemblerX64::InstructionDecode(uword pc) {
         data += TwoByteOpcodeInstruction(data);
         break;
 
+#if defined(TARGET_ARCH_X64)
+      case 0xC4:
+        FALL_THROUGH;
+      case 0xC5:
+        data += VexInstruction(data);
+        break;
+#endif
+
       case 0x8F: {
         data++;
         int mod, regop, rm;
@@ -243,7 +243,8 @@ void BlockScheduler::ReorderBlocksJIT(FlowGraph* flow_graph) {
 // AOT block order is based on reverse post order but with two changes:
 //
 // - Blocks which always throw and their direct predecessors are considered
-// *cold* and moved to the end of the order.
+// *cold* and moved to the end of the order. So are exception handlers and
+// blocks which are only reachable from them.
 // - Blocks which belong to the same loop are kept together (where possible)
 // and not interspersed with other blocks.
 //
@@ -260,6 +261,7 @@ class AOTBlockScheduler {
   }
 
   void ComputeOrder() {
+    MarkCatchBlocksCold();
     ComputeOrderImpl();
 
     const auto codegen_order = flow_graph_->CodegenBlockOrder();
@@ -272,6 +274,28 @@ class AOTBlockScheduler {
   }
 
  private:
+  void MarkCatchBlocksCold() {
+    const auto& reverse_postorder = flow_graph_->reverse_postorder();
+    for (intptr_t i = 0; i < reverse_postorder.length(); i++) {
+      BlockEntryInstr* block = reverse_postorder[i];
+      bool is_cold = block->IsCatchBlockEntry();
+      if (!is_cold && (block->PredecessorCount() > 0)) {
+        // Predecessors along back edges are not marked yet, so loop headers
+        // are conservatively considered hot.
+        is_cold = true;
+        for (intptr_t j = 0; j < block->PredecessorCount(); j++) {
+          if ((MarksOf(block->PredecessorAt(j)) & kColdMark) == 0) {
+            is_cold = false;
+            break;
+          }
+        }
+      }
+      if (is_cold) {
+        MarksOf(block) |= kColdMark;
+      }
+    }
+  }
+
   // The algorithm below is almost identical to |FlowGraph::DiscoverBlocks|, but
   // with few tweaks which guarantee improved scheduling for cold code and
   // loops.
@@ -350,7 +374,8 @@ class AOTBlockScheduler {
   static constexpr uint8_t kSeenMark = 1 << 0;
   // The block was visited and all of its successors were added to the stack.
   static constexpr uint8_t kVisitedMark = 1 << 1;
-  // The block terminates with unconditional throw or rethrow.
+  // The block terminates with unconditional throw or rethrow or is only
+  // reachable from an exception handler.
   static constexpr uint8_t kColdMark = 1 << 2;
   // The block should not move to cold section.
   static constexpr uint8_t kPinnedMark = 1 << 3;
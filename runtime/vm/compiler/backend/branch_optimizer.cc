@@ -229,7 +229,7 @@ static bool IsTrivialBlock(BlockEntryInstr* block, Definition* defn) {
 
 static void EliminateTrivialBlock(BlockEntryInstr* block,
                                   Definition* instr,
-                                  IfThenElseInstr* before) {
+                                  Definition* before) {
   block->UnuseAllInputs();
   block->last_instruction()->UnuseAllInputs();
 
@@ -240,6 +240,97 @@ static void EliminateTrivialBlock(BlockEntryInstr* block,
   }
 }
 
+// Detect diamond control flow pattern which materializes a value depending
+// on the result of the condition:
+//
+// B_pred:
+//   ...
+//   Branch if COND goto (B_pred1, B_pred2)
+// B_pred1: -- trivial block that contains at most one definition
+//   v1 = ...
+//   goto B_block
+// B_pred2: -- trivial block that contains at most one definition
+//   v2 = ...
+//   goto B_block
+// B_block:
+//   v3 = phi(v1, v2) -- single phi
+//
+// Returns the branch in B_pred if the given block matches the pattern.
+static BranchInstr* MatchDiamond(BlockEntryInstr* block) {
+  JoinEntryInstr* join = block->AsJoinEntry();
+  if ((join == nullptr) || (join->phis() == nullptr) ||
+      (join->phis()->length() != 1) || (block->PredecessorCount() != 2)) {
+    return nullptr;
+  }
+  BlockEntryInstr* pred1 = block->PredecessorAt(0);
+  BlockEntryInstr* pred2 = block->PredecessorAt(1);
+
+  PhiInstr* phi = (*join->phis())[0];
+  if (!IsTrivialBlock(pred1, phi->InputAt(0)->definition()) ||
+      !IsTrivialBlock(pred2, phi->InputAt(1)->definition()) ||
+      (pred1->PredecessorAt(0) != pred2->PredecessorAt(0))) {
+    return nullptr;
+  }
+  BlockEntryInstr* pred = pred1->PredecessorAt(0);
+  BranchInstr* branch = pred->last_instruction()->AsBranch();
+  if (branch == nullptr) {
+    // There is no "B_pred" block, or the block is the IndirectGoto
+    // of a switch that uses it as a jump table.
+    ASSERT(pred->last_instruction()->IsGraphEntry() ||
+           pred->last_instruction()->IsIndirectGoto());
+  }
+  return branch;
+}
+
+// Replaces the diamond matched by MatchDiamond with the given definition
+// of the value of its phi, which is inserted in place of the branch.
+static void ReplaceDiamond(FlowGraph* flow_graph,
+                           JoinEntryInstr* join,
+                           BranchInstr* branch,
+                           Definition* replacement) {
+  BlockEntryInstr* pred1 = join->PredecessorAt(0);
+  BlockEntryInstr* pred2 = join->PredecessorAt(1);
+  BlockEntryInstr* pred = branch->GetBlock();
+  PhiInstr* phi = (*join->phis())[0];
+  Value* v1 = phi->InputAt(0);
+  Value* v2 = phi->InputAt(1);
+
+  flow_graph->InsertBefore(branch, replacement, nullptr, FlowGraph::kValue);
+
+  phi->ReplaceUsesWith(replacement);
+
+  // Connect the replacement to the first instruction in the merge block
+  // effectively eliminating diamond control flow.
+  // Current block as well as pred1 and pred2 blocks are no longer in
+  // the graph at this point.
+  replacement->LinkTo(join->next());
+  pred->set_last_instruction(join->last_instruction());
+
+  // Resulting block must inherit block id from the eliminated current
+  // block to guarantee that ordering of phi operands in its successor
+  // stays consistent.
+  pred->set_block_id(join->block_id());
+
+  // If v1 and v2 were defined inside eliminated blocks pred1/pred2
+  // move them out to the place before inserted replacement instruction.
+  EliminateTrivialBlock(pred1, v1->definition(), replacement);
+  EliminateTrivialBlock(pred2, v2->definition(), replacement);
+
+  // Update use lists to reflect changes in the graph.
+  phi->UnuseAllInputs();
+  branch->UnuseAllInputs();
+  join->UnuseAllInputs();
+}
+
+static void FinishIfConversion(FlowGraph* flow_graph, bool changed) {
+  if (changed) {
+    // We may have changed the block order and the dominator tree.
+    flow_graph->DiscoverBlocks();
+    GrowableArray<BitVector*> dominance_frontier;
+    flow_graph->ComputeDominators(&dominance_frontier);
+  }
+}
+
 void IfConverter::Simplify(FlowGraph* flow_graph) {
   Zone* zone = flow_graph->zone();
   bool changed = false;
@@ -247,107 +338,123 @@ void IfConverter::Simplify(FlowGraph* flow_graph) {
   const GrowableArray<BlockEntryInstr*>& postorder = flow_graph->postorder();
   for (BlockIterator it(postorder); !it.Done(); it.Advance()) {
     BlockEntryInstr* block = it.Current();
-    JoinEntryInstr* join = block->AsJoinEntry();
 
-    // Detect diamond control flow pattern which materializes a value depending
-    // on the result of the condition:
-    //
-    // B_pred:
-    //   ...
-    //   Branch if COND goto (B_pred1, B_pred2)
-    // B_pred1: -- trivial block that contains at most one definition
-    //   v1 = Constant(...)
-    //   goto B_block
-    // B_pred2: -- trivial block that contains at most one definition
-    //   v2 = Constant(...)
-    //   goto B_block
-    // B_block:
-    //   v3 = phi(v1, v2) -- single phi
-    //
-    // and replace it with
+    // Replace the diamond which materializes one of two constants with
     //
     // Ba:
     //   v3 = IfThenElse(COND ? v1 : v2)
     //
-    if ((join != nullptr) && (join->phis() != nullptr) &&
-        (join->phis()->length() == 1) && (block->PredecessorCount() == 2)) {
-      BlockEntryInstr* pred1 = block->PredecessorAt(0);
-      BlockEntryInstr* pred2 = block->PredecessorAt(1);
-
-      PhiInstr* phi = (*join->phis())[0];
-      Value* v1 = phi->InputAt(0);
-      Value* v2 = phi->InputAt(1);
-
-      if (IsTrivialBlock(pred1, v1->definition()) &&
-          IsTrivialBlock(pred2, v2->definition()) &&
-          (pred1->PredecessorAt(0) == pred2->PredecessorAt(0))) {
-        BlockEntryInstr* pred = pred1->PredecessorAt(0);
-        BranchInstr* branch = pred->last_instruction()->AsBranch();
-
-        if (branch == nullptr) {
-          // There is no "B_pred" block, or the block is the IndirectGoto
-          // of a switch that uses it as a jump table.
-          ASSERT(pred->last_instruction()->IsGraphEntry() ||
-                 pred->last_instruction()->IsIndirectGoto());
-          continue;
-        }
+    BranchInstr* branch = MatchDiamond(block);
+    if (branch == nullptr) {
+      continue;
+    }
+    JoinEntryInstr* join = block->AsJoinEntry();
+    PhiInstr* phi = (*join->phis())[0];
+    Value* v1 = phi->InputAt(0);
+    Value* v2 = phi->InputAt(1);
+    ConditionInstr* condition = branch->condition();
+
+    // Check if the platform supports efficient branchless IfThenElseInstr
+    // for the given combination of condition and values flowing from
+    // false and true paths.
+    if (IfThenElseInstr::Supports(condition, v1, v2)) {
+      const bool v1_is_true =
+          block->PredecessorAt(0) == branch->true_successor();
+      Value* if_true = v1_is_true ? v1 : v2;
+      Value* if_false = v1_is_true ? v2 : v1;
+
+      ConditionInstr* new_condition =
+          condition->CopyWithNewOperands(condition->InputAt(0)->Copy(zone),
+                                         condition->InputAt(1)->Copy(zone));
+      IfThenElseInstr* if_then_else =
+          new (zone) IfThenElseInstr(new_condition, if_true->Copy(zone),
+                                     if_false->Copy(zone), DeoptId::kNone);
+      ReplaceDiamond(flow_graph, join, branch, if_then_else);
+
+      // The graph has changed. Recompute dominators and block orders after
+      // this pass is finished.
+      changed = true;
+    }
+  }
 
-        ConditionInstr* condition = branch->condition();
-
-        // Check if the platform supports efficient branchless IfThenElseInstr
-        // for the given combination of condition and values flowing from
-        // false and true paths.
-        if (IfThenElseInstr::Supports(condition, v1, v2)) {
-          Value* if_true = (pred1 == branch->true_successor()) ? v1 : v2;
-          Value* if_false = (pred2 == branch->true_successor()) ? v1 : v2;
-
-          ConditionInstr* new_condition =
-              condition->CopyWithNewOperands(condition->InputAt(0)->Copy(zone),
-                                             condition->InputAt(1)->Copy(zone));
-          IfThenElseInstr* if_then_else =
-              new (zone) IfThenElseInstr(new_condition, if_true->Copy(zone),
-                                         if_false->Copy(zone), DeoptId::kNone);
-          flow_graph->InsertBefore(branch, if_then_else, nullptr,
-                                   FlowGraph::kValue);
-
-          phi->ReplaceUsesWith(if_then_else);
-
-          // Connect IfThenElseInstr to the first instruction in the merge block
-          // effectively eliminating diamond control flow.
-          // Current block as well as pred1 and pred2 blocks are no longer in
-          // the graph at this point.
-          if_then_else->LinkTo(join->next());
-          pred->set_last_instruction(join->last_instruction());
-
-          // Resulting block must inherit block id from the eliminated current
-          // block to guarantee that ordering of phi operands in its successor
-          // stays consistent.
-          pred->set_block_id(block->block_id());
-
-          // If v1 and v2 were defined inside eliminated blocks pred1/pred2
-          // move them out to the place before inserted IfThenElse instruction.
-          EliminateTrivialBlock(pred1, v1->definition(), if_then_else);
-          EliminateTrivialBlock(pred2, v2->definition(), if_then_else);
-
-          // Update use lists to reflect changes in the graph.
-          phi->UnuseAllInputs();
-          branch->UnuseAllInputs();
-          block->UnuseAllInputs();
-
-          // The graph has changed. Recompute dominators and block orders after
-          // this pass is finished.
-          changed = true;
-        }
-      }
+  FinishIfConversion(flow_graph, changed);
+}
+
+// Returns true if the given definition from an arm of a diamond is cheap
+// and can be evaluated even if the arm is not taken.
+static bool CanSpeculate(BlockEntryInstr* block, Definition* defn) {
+  if (block->next() != defn) {
+    // The value is defined outside of the (empty) arm.
+    return true;
+  }
+  if (defn->ComputeCanDeoptimize() || defn->MayThrow() ||
+      defn->HasUnknownSideEffects() || (defn->env() != nullptr)) {
+    return false;
+  }
+  if (auto* op = defn->AsBinaryInt64Op()) {
+    switch (op->op_kind()) {
+      case Token::kADD:
+      case Token::kSUB:
+      case Token::kBIT_AND:
+      case Token::kBIT_OR:
+      case Token::kBIT_XOR:
+        return true;
+      default:
+        return false;
     }
   }
+  return false;
+}
 
-  if (changed) {
-    // We may have changed the block order and the dominator tree.
-    flow_graph->DiscoverBlocks();
-    GrowableArray<BitVector*> dominance_frontier;
-    flow_graph->ComputeDominators(&dominance_frontier);
+void IfConverter::ConvertToSelects(FlowGraph* flow_graph) {
+  Zone* zone = flow_graph->zone();
+  bool changed = false;
+
+  const GrowableArray<BlockEntryInstr*>& postorder = flow_graph->postorder();
+  for (BlockIterator it(postorder); !it.Done(); it.Advance()) {
+    BlockEntryInstr* block = it.Current();
+
+    // Replace the diamond with
+    //
+    // Ba:
+    //   [v1 = ...]
+    //   [v2 = ...]
+    //   v3 = Select(COND ? v1 : v2)
+    //
+    // if each arm computes at most one cheap value, so that evaluating
+    // both of them is cheaper than a potentially mispredicted branch.
+    BranchInstr* branch = MatchDiamond(block);
+    if (branch == nullptr) {
+      continue;
+    }
+    JoinEntryInstr* join = block->AsJoinEntry();
+    PhiInstr* phi = (*join->phis())[0];
+    Value* v1 = phi->InputAt(0);
+    Value* v2 = phi->InputAt(1);
+    ConditionInstr* condition = branch->condition();
+
+    if (!SelectInstr::Supports(condition, phi->representation()) ||
+        !CanSpeculate(block->PredecessorAt(0), v1->definition()) ||
+        !CanSpeculate(block->PredecessorAt(1), v2->definition())) {
+      continue;
+    }
+
+    const bool v1_is_true =
+        block->PredecessorAt(0) == branch->true_successor();
+    Value* if_true = v1_is_true ? v1 : v2;
+    Value* if_false = v1_is_true ? v2 : v1;
+
+    ConditionInstr* new_condition =
+        condition->CopyWithNewOperands(condition->InputAt(0)->Copy(zone),
+                                       condition->InputAt(1)->Copy(zone));
+    SelectInstr* select =
+        new (zone) SelectInstr(new_condition, if_true->Copy(zone),
+                               if_false->Copy(zone), phi->representation());
+    ReplaceDiamond(flow_graph, join, branch, select);
+    changed = true;
   }
+
+  FinishIfConversion(flow_graph, changed);
 }
 
 }  // namespace dart
@@ -58,6 +58,10 @@ class BranchSimplifier : public AllStatic {
 class IfConverter : public AllStatic {
  public:
   static void Simplify(FlowGraph* flow_graph);
+
+  // Rewrite diamonds which select one of two cheap values computed on
+  // either path into SelectInstr. Runs after representation selection.
+  static void ConvertToSelects(FlowGraph* flow_graph);
 };
 
 }  // namespace dart
@@ -578,6 +578,22 @@ void ConstantPropagator::VisitIfThenElse(IfThenElseInstr* instr) {
   }
 }
 
+void ConstantPropagator::VisitSelect(SelectInstr* instr) {
+  instr->condition()->Accept(this);
+  const Object& value = instr->condition()->constant_value();
+  ASSERT(!value.IsNull());
+  if (IsUnknown(value)) {
+    return;
+  }
+  if (value.IsBool()) {
+    Value* result =
+        Bool::Cast(value).value() ? instr->if_true() : instr->if_false();
+    SetValue(instr, result->definition()->constant_value());
+  } else {
+    SetValue(instr, non_constant_);
+  }
+}
+
 void ConstantPropagator::VisitStrictCompare(StrictCompareInstr* instr) {
   Definition* left_defn = instr->left()->definition();
   Definition* right_defn = instr->right()->definition();
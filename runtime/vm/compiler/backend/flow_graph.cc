@@ -2205,18 +2205,23 @@ void FlowGraph::InsertConversion(Representation from,
     // Insert conversion to an unboxed record, which can be only used
     // in Return instruction.
     ASSERT(use->instruction()->IsDartReturn());
-    Definition* x = new (Z)
-        LoadFieldInstr(use->CopyWithType(),
-                       Slot::GetRecordFieldSlot(
-                           thread(), compiler::target::Record::field_offset(0)),
-                       InstructionSource());
-    InsertBefore(insert_before, x, nullptr, FlowGraph::kValue);
-    Definition* y = new (Z)
-        LoadFieldInstr(use->CopyWithType(),
-                       Slot::GetRecordFieldSlot(
-                           thread(), compiler::target::Record::field_offset(1)),
-                       InstructionSource());
-    InsertBefore(insert_before, y, nullptr, FlowGraph::kValue);
+    Definition* x = nullptr;
+    Definition* y = nullptr;
+    PhiInstr* phi = use->definition()->AsPhi();
+    if (phi == nullptr || !TryUnboxRecordPhi(phi, use, &x, &y)) {
+      x = new (Z) LoadFieldInstr(
+          use->CopyWithType(),
+          Slot::GetRecordFieldSlot(thread(),
+                                   compiler::target::Record::field_offset(0)),
+          InstructionSource());
+      InsertBefore(insert_before, x, nullptr, FlowGraph::kValue);
+      y = new (Z) LoadFieldInstr(
+          use->CopyWithType(),
+          Slot::GetRecordFieldSlot(thread(),
+                                   compiler::target::Record::field_offset(1)),
+          InstructionSource());
+      InsertBefore(insert_before, y, nullptr, FlowGraph::kValue);
+    }
     converted = new (Z) MakePairInstr(new (Z) Value(x), new (Z) Value(y));
   } else if ((to == kTagged) && (from == kPairOfTagged)) {
     // Handled in FlowGraph::InsertRecordBoxing.
@@ -2259,6 +2264,48 @@ void FlowGraph::InsertConversion(Representation from,
   }
 }
 
+bool FlowGraph::TryUnboxRecordPhi(PhiInstr* phi,
+                                  Value* use,
+                                  Definition** x,
+                                  Definition** y) {
+  if (!phi->HasOnlyInputUse(use)) {
+    return false;
+  }
+  for (intptr_t i = 0; i < phi->InputCount(); i++) {
+    auto* alloc = phi->InputAt(i)->definition()->AsAllocateSmallRecord();
+    if (alloc == nullptr || alloc->num_fields() != 2) {
+      return false;
+    }
+    // Inputs of allocations in predecessors which are not processed yet
+    // (across a back edge) may still need conversions.
+    for (intptr_t j = 0; j < 2; j++) {
+      if (alloc->InputAt(j)->definition()->representation() != kTagged) {
+        return false;
+      }
+    }
+  }
+  JoinEntryInstr* join = phi->block();
+  PhiInstr* fields[2];
+  for (intptr_t j = 0; j < 2; j++) {
+    fields[j] = new (Z) PhiInstr(join, phi->InputCount());
+    AllocateSSAIndex(fields[j]);
+    fields[j]->mark_alive();
+    for (intptr_t i = 0; i < phi->InputCount(); i++) {
+      Definition* value =
+          phi->InputAt(i)->definition()->InputAt(j)->definition();
+      Value* input = new (Z) Value(value);
+      fields[j]->SetInputAt(i, input);
+      value->AddInputUse(input);
+    }
+    join->InsertPhi(fields[j]);
+  }
+  // The record phi and the allocations become dead once the return uses
+  // the field phis and are removed by dead code elimination.
+  *x = fields[0];
+  *y = fields[1];
+  return true;
+}
+
 static bool NeedsRecordBoxing(Definition* def) {
   if (def->env_use_list() != nullptr) return true;
   for (Value::Iterator it(def->input_use_list()); !it.Done(); it.Advance()) {
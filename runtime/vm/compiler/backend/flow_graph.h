@@ -469,6 +469,12 @@ class FlowGraph : public ZoneAllocated {
   // Mark this flow graph as huge and disable certain optimizations.
   void mark_huge_method() { huge_method_ = true; }
 
+  // Returns true if this flow graph is optimized by the quick tier of the JIT
+  // (see --jit_quick_tier), whose code is reoptimized with the full pipeline
+  // once it stays hot.
+  bool is_quick_tier() const { return quick_tier_; }
+  void mark_quick_tier() { quick_tier_ = true; }
+
   PrologueInfo prologue_info() const { return prologue_info_; }
 
   // Computes the loop hierarchy of the flow graph on demand.
@@ -724,6 +730,14 @@ class FlowGraph : public ZoneAllocated {
   // which returns an unboxed record.
   void InsertRecordBoxing(Definition* def);
 
+  // Replaces the [phi] of two-field records allocated in its predecessors
+  // by phis of their fields [x] and [y], so the records do not need to be
+  // allocated when [phi] is returned as an unboxed record.
+  bool TryUnboxRecordPhi(PhiInstr* phi,
+                         Value* use,
+                         Definition** x,
+                         Definition** y);
+
   void ComputeIsReceiver(PhiInstr* phi) const;
   void ComputeIsReceiverRecursive(PhiInstr* phi,
                                   GrowableArray<PhiInstr*>* unmark) const;
@@ -777,6 +791,7 @@ class FlowGraph : public ZoneAllocated {
   bool licm_allowed_;
   bool unmatched_representations_allowed_ = true;
   bool huge_method_ = false;
+  bool quick_tier_ = false;
   const bool should_reorder_blocks_;
 
   const PrologueInfo prologue_info_;
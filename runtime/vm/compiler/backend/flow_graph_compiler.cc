@@ -238,6 +238,9 @@ void FlowGraphCompiler::InitCompiler() {
       }
     }
   }
+  if (flow_graph().is_quick_tier()) {
+    may_reoptimize_ = true;
+  }
 
   if (!is_optimizing() && FLAG_reorder_basic_blocks) {
     // Initialize edge counter array.
@@ -259,6 +262,10 @@ bool FlowGraphCompiler::CanOptimizeFunction() const {
   return CanOptimize() && !parsed_function().function().HasBreakpoint();
 }
 
+bool FlowGraphCompiler::counts_invocations() const {
+  return !is_optimizing() || flow_graph().is_quick_tier();
+}
+
 bool FlowGraphCompiler::CanOSRFunction() const {
   return isolate_group()->use_osr() && CanOptimizeFunction() &&
          !is_optimizing();
@@ -878,6 +878,10 @@ class FlowGraphCompiler : public ValueObject {
 
   bool may_reoptimize() const { return may_reoptimize_; }
 
+  // Unoptimized code and code compiled by the quick tier of the JIT count
+  // their invocations at the entry to trigger (re)optimization.
+  bool counts_invocations() const;
+
   // Use in unoptimized compilation to preserve/reuse ICData.
   //
   // If [binary_smi_target] is non-null and we have to create the ICData, the
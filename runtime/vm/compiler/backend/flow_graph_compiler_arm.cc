@@ -238,8 +238,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
                    function_reg,
                    compiler::target::Function::usage_counter_offset()));
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function, unless it was
+    // compiled by the quick tier.
+    if (counts_invocations()) {
       __ add(R3, R3, compiler::Operand(1));
       __ str(R3, compiler::FieldAddress(
                      function_reg,
@@ -353,8 +353,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
     __ LoadObject(function_reg, function);
 
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function, unless it was
+    // compiled by the quick tier.
+    if (counts_invocations()) {
       __ incl(compiler::FieldAddress(function_reg,
                                      Function::usage_counter_offset()));
     }
@@ -220,8 +220,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
                            Function::usage_counter_offset(),
                            compiler::kFourBytes);
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function, unless it was
+    // compiled by the quick tier.
+    if (counts_invocations()) {
       __ addi(usage_reg, usage_reg, 1);
       __ StoreFieldToOffset(usage_reg, function_reg,
                             Function::usage_counter_offset(),
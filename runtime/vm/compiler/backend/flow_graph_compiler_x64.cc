@@ -243,8 +243,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
               compiler::FieldAddress(CODE_REG, Code::owner_offset()));
 
       // Reoptimization of an optimized function is triggered by counting in
-      // IC stubs, but not at the entry of the function.
-      if (!is_optimizing()) {
+      // IC stubs, but not at the entry of the function, unless it was
+      // compiled by the quick tier.
+      if (counts_invocations()) {
         __ incl(compiler::FieldAddress(function_reg,
                                        Function::usage_counter_offset()));
       }
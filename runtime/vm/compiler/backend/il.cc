@@ -5721,6 +5721,25 @@ static Definition* CanonicalizeStringInterpolateSingle(StaticCallInstr* call,
   return call;
 }
 
+static Definition* CanonicalizeStringInterpolateShort(StaticCallInstr* call,
+                                                      FlowGraph* flow_graph) {
+  Thread* thread = flow_graph->thread();
+  Zone* zone = flow_graph->zone();
+  const intptr_t num_pieces = call->ArgumentCount();
+  GrowableHandlePtrArray<const String> pieces(zone, num_pieces);
+  for (intptr_t i = 0; i < num_pieces; i++) {
+    const String& piece =
+        EvaluateToString(zone, call->ArgumentValueAt(i)->definition());
+    if (piece.IsNull()) {
+      return call;
+    }
+    pieces.Add(piece);
+  }
+  const String& concatenated =
+      String::ZoneHandle(zone, Symbols::FromConcatAll(thread, pieces));
+  return flow_graph->GetConstant(concatenated);
+}
+
 static bool CanFlowIntoCatch(FlowGraph* flow_graph, Definition* defn) {
   if (flow_graph->try_entries().is_empty()) {
     // No try/catch blocks.
@@ -5746,6 +5765,16 @@ static bool CanFlowIntoCatch(FlowGraph* flow_graph, Definition* defn) {
   return false;
 }
 
+bool StaticCallInstr::IsStringInterpolateShort() const {
+  const intptr_t num_pieces = ArgumentCount();
+  if (num_pieces != 2 && num_pieces != 3) {
+    return false;
+  }
+  const auto& interpolate =
+      CompilerState::Current().StringBaseInterpolateShort(num_pieces);
+  return function().ptr() == interpolate.ptr();
+}
+
 Definition* StaticCallInstr::Canonicalize(FlowGraph* flow_graph) {
   auto& compiler_state = CompilerState::Current();
 
@@ -5754,6 +5783,8 @@ Definition* StaticCallInstr::Canonicalize(FlowGraph* flow_graph) {
   } else if (function().ptr() ==
              compiler_state.StringBaseInterpolateSingle().ptr()) {
     return CanonicalizeStringInterpolateSingle(this, flow_graph);
+  } else if (IsStringInterpolateShort()) {
+    return CanonicalizeStringInterpolateShort(this, flow_graph);
   }
 
   const auto kind = function().recognized_kind();
@@ -6605,6 +6636,35 @@ bool IfThenElseInstr::Supports(ConditionInstr* condition,
   return false;
 }
 
+bool SelectInstr::Supports(ConditionInstr* condition, Representation rep) {
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+  if ((rep != kTagged) && (rep != kUnboxedInt64)) {
+    return false;
+  }
+  if (condition->ComputeCanDeoptimize() || condition->MayThrow() ||
+      condition->CanCallDart()) {
+    return false;
+  }
+  // Only conditions which are emitted as a single comparison of integers
+  // or references without using the branch labels are supported.
+  if (auto* strict_compare = condition->AsStrictCompare()) {
+    return !strict_compare->needs_number_check();
+  }
+  if (auto* equality = condition->AsEqualityCompare()) {
+    return ((equality->input_representation() == kTagged) ||
+            (equality->input_representation() == kUnboxedInt64)) &&
+           !equality->is_null_aware();
+  }
+  if (auto* comparison = condition->AsRelationalOp()) {
+    return (comparison->input_representation() == kTagged) ||
+           (comparison->input_representation() == kUnboxedInt64);
+  }
+  return false;
+#else
+  return false;
+#endif
+}
+
 bool PhiInstr::IsRedundant() const {
   ASSERT(InputCount() > 1);
   Definition* first = InputAt(0)->definition();
@@ -6727,8 +6787,8 @@ LocationSummary* CheckConditionInstr::MakeLocationSummary(Zone* zone,
 
 void CheckConditionInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   compiler::Label if_true;
-  compiler::Label* if_false =
-      compiler->AddDeoptStub(deopt_id(), ICData::kDeoptUnknown);
+  compiler::Label* if_false = compiler->AddDeoptStub(
+      deopt_id(), ICData::kDeoptUnknown, deopt_flags());
   BranchLabels labels = {&if_true, if_false, &if_true};
   Condition true_condition = condition()->EmitConditionCode(compiler, labels);
   if (true_condition != kInvalidCondition) {
@@ -518,6 +518,7 @@ struct InstrAttrs {
   M(GuardFieldLength, _)                                                       \
   M(GuardFieldType, _)                                                         \
   M(IfThenElse, kNoGC)                                                         \
+  M(Select, kNoGC)                                                             \
   M(MaterializeObject, _)                                                      \
   M(TestInt, kNoGC)                                                            \
   M(TestCids, kNoGC)                                                           \
@@ -1418,6 +1419,7 @@ class Instruction : public ZoneAllocated {
  private:
   friend class BranchInstr;          // For RawSetInputAt.
   friend class IfThenElseInstr;      // For RawSetInputAt.
+  friend class SelectInstr;          // For RawSetInputAt.
   friend class CheckConditionInstr;  // For RawSetInputAt.
 
   virtual void RawSetInputAt(intptr_t i, Value* value) = 0;
@@ -2840,6 +2842,7 @@ class TemplateDefinition : public CSETrait<Definition, PureDefinition>::Base {
  private:
   friend class BranchInstr;
   friend class IfThenElseInstr;
+  friend class SelectInstr;
 
   virtual void RawSetInputAt(intptr_t i, Value* value) { inputs_[i] = value; }
 };
@@ -5556,6 +5559,91 @@ class IfThenElseInstr : public Definition {
   DISALLOW_COPY_AND_ASSIGN(IfThenElseInstr);
 };
 
+// Selects one of two values depending on the result of the condition
+// without branching, e.g. using cmov on X64 and csel on ARM64.
+//
+// The first inputs are the inputs of the embedded condition, followed by
+// the values selected on the true and false paths.
+class SelectInstr : public Definition {
+ public:
+  SelectInstr(ConditionInstr* condition,
+              Value* if_true,
+              Value* if_false,
+              Representation representation)
+      : Definition(DeoptId::kNone),
+        condition_(condition),
+        representation_(representation) {
+    // Adjust uses at the condition.
+    ASSERT(condition->env() == nullptr);
+    const intptr_t n = condition->InputCount();
+    for (intptr_t i = n - 1; i >= 0; --i) {
+      condition->InputAt(i)->set_instruction(this);
+    }
+    SetInputAt(n + kIfTruePos, if_true);
+    SetInputAt(n + kIfFalsePos, if_false);
+  }
+
+  // Returns true if selects between values of the given representation
+  // under this condition are supported on the current platform.
+  static bool Supports(ConditionInstr* condition, Representation rep);
+
+  DECLARE_INSTRUCTION(Select)
+
+  intptr_t InputCount() const { return condition()->InputCount() + 2; }
+
+  Value* InputAt(intptr_t i) const {
+    const intptr_t n = condition()->InputCount();
+    return (i < n) ? condition()->InputAt(i) : values_[i - n];
+  }
+
+  ConditionInstr* condition() const { return condition_; }
+  Value* if_true() const { return values_[kIfTruePos]; }
+  Value* if_false() const { return values_[kIfFalsePos]; }
+
+  virtual bool ComputeCanDeoptimize() const { return false; }
+
+  virtual Representation RequiredInputRepresentation(intptr_t i) const {
+    const intptr_t n = condition()->InputCount();
+    return (i < n) ? condition()->RequiredInputRepresentation(i)
+                   : representation_;
+  }
+
+  virtual Representation representation() const { return representation_; }
+
+  virtual CompileType ComputeType() const;
+
+  virtual bool HasUnknownSideEffects() const { return false; }
+
+  virtual bool MayThrow() const { return false; }
+
+  PRINT_OPERANDS_TO_SUPPORT
+
+#define FIELD_LIST(F)                                                          \
+  F(ConditionInstr*, condition_)                                               \
+  F(const Representation, representation_)
+
+  DECLARE_INSTRUCTION_SERIALIZABLE_FIELDS(SelectInstr, Definition, FIELD_LIST)
+#undef FIELD_LIST
+  DECLARE_EXTRA_SERIALIZATION
+
+ private:
+  static constexpr intptr_t kIfTruePos = 0;
+  static constexpr intptr_t kIfFalsePos = 1;
+
+  virtual void RawSetInputAt(intptr_t i, Value* value) {
+    const intptr_t n = condition()->InputCount();
+    if (i < n) {
+      condition()->RawSetInputAt(i, value);
+    } else {
+      values_[i - n] = value;
+    }
+  }
+
+  EmbeddedArray<Value*, 2> values_;
+
+  DISALLOW_COPY_AND_ASSIGN(SelectInstr);
+};
+
 class StaticCallInstr : public TemplateDartCall<0> {
  public:
   StaticCallInstr(const InstructionSource& source,
@@ -5699,6 +5787,10 @@ class StaticCallInstr : public TemplateDartCall<0> {
 
   bool IsRecognizedFactory() const { return is_known_list_constructor(); }
 
+  // Returns true if this is a call to _StringBase._interpolate2 or
+  // _StringBase._interpolate3.
+  bool IsStringInterpolateShort() const;
+
   virtual intptr_t ArgumentsSize() const;
 
   virtual Representation RequiredInputRepresentation(intptr_t idx) const;
@@ -6803,6 +6895,7 @@ class LoadIndexedInstr : public TemplateDefinition<2, NoThrow> {
   intptr_t index_scale() const { return index_scale_; }
   intptr_t class_id() const { return class_id_; }
   bool aligned() const { return alignment_ == kAlignedAccess; }
+  CompileType* result_type() const { return result_type_; }
 
   virtual intptr_t DeoptimizationTarget() const {
     // Direct access since this instruction cannot deoptimize, and the deopt-id
@@ -7393,6 +7486,7 @@ class TemplateAllocation : public AllocationInstr {
  private:
   friend class BranchInstr;
   friend class IfThenElseInstr;
+  friend class SelectInstr;
   friend class RecordCoverageInstr;
 
   virtual void RawSetInputAt(intptr_t i, Value* value) { inputs_[i] = value; }
@@ -8304,6 +8398,11 @@ class InstantiateTypeArgumentsInstr : public TemplateDefinition<3, Throws> {
   virtual intptr_t NumberOfInputsConsumedBeforeCall() const {
     return InputCount();
   }
+  virtual bool CanBecomeDeoptimizationTarget() const {
+    // Speculatively specialized instantiations are guarded by a check which
+    // deoptimizes to before the instantiation.
+    return true;
+  }
 
   virtual bool HasUnknownSideEffects() const { return false; }
 
@@ -10660,11 +10759,16 @@ class CheckWritableInstr : public TemplateDefinition<1, Throws, Pure> {
 };
 
 // Instruction evaluates the given condition and deoptimizes if it evaluates
-// to false.
+// to false. [deopt_flags] are the ICData::DeoptFlags recorded on
+// deoptimization.
 class CheckConditionInstr : public Instruction {
  public:
-  CheckConditionInstr(ConditionInstr* condition, intptr_t deopt_id)
-      : Instruction(deopt_id), condition_(condition) {
+  CheckConditionInstr(ConditionInstr* condition,
+                      intptr_t deopt_id,
+                      uint32_t deopt_flags = 0)
+      : Instruction(deopt_id),
+        condition_(condition),
+        deopt_flags_(deopt_flags) {
     ASSERT(condition->ArgumentCount() == 0);
     ASSERT(condition->env() == nullptr);
     for (intptr_t i = condition->InputCount() - 1; i >= 0; --i) {
@@ -10673,6 +10777,7 @@ class CheckConditionInstr : public Instruction {
   }
 
   ConditionInstr* condition() const { return condition_; }
+  uint32_t deopt_flags() const { return deopt_flags_; }
 
   DECLARE_INSTRUCTION(CheckCondition)
 
@@ -10699,7 +10804,9 @@ class CheckConditionInstr : public Instruction {
 
   PRINT_OPERANDS_TO_SUPPORT
 
-#define FIELD_LIST(F) F(ConditionInstr*, condition_)
+#define FIELD_LIST(F)                                                          \
+  F(ConditionInstr*, condition_)                                               \
+  F(const uint32_t, deopt_flags_)
 
   DECLARE_INSTRUCTION_SERIALIZABLE_FIELDS(CheckConditionInstr,
                                           Instruction,
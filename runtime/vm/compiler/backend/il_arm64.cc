@@ -574,6 +574,49 @@ LocationSummary* IfThenElseInstr::MakeLocationSummary(Zone* zone,
   return condition()->locs();
 }
 
+LocationSummary* SelectInstr::MakeLocationSummary(Zone* zone,
+                                                  bool opt) const {
+  condition()->InitializeLocationSummary(zone, opt);
+  const LocationSummary* condition_locs = condition()->locs();
+  const intptr_t n = condition()->InputCount();
+  LocationSummary* summary = new (zone) LocationSummary(
+      zone, InputCount(), condition_locs->temp_count(),
+      LocationSummary::kNoCall);
+  for (intptr_t i = 0; i < n; i++) {
+    summary->set_in(i, condition_locs->in(i));
+  }
+  for (intptr_t i = 0; i < condition_locs->temp_count(); i++) {
+    summary->set_temp(i, condition_locs->temp(i));
+  }
+  summary->set_in(n, Location::RequiresRegister());
+  summary->set_in(n + 1, Location::RequiresRegister());
+  summary->set_out(0, Location::RequiresRegister());
+  return summary;
+}
+
+void SelectInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  // The condition emits its code using its own location summary, so
+  // pass the allocated locations to it.
+  LocationSummary* condition_locs = condition()->locs();
+  const intptr_t n = condition()->InputCount();
+  for (intptr_t i = 0; i < n; i++) {
+    condition_locs->set_in(i, locs()->in(i));
+  }
+  for (intptr_t i = 0; i < condition_locs->temp_count(); i++) {
+    condition_locs->set_temp(i, locs()->temp(i));
+  }
+
+  // SelectInstr::Supports() should prevent EmitConditionCode from using
+  // the labels or returning an invalid condition.
+  BranchLabels labels = {nullptr, nullptr, nullptr};
+  const Condition true_condition =
+      condition()->EmitConditionCode(compiler, labels);
+  ASSERT(true_condition != kInvalidCondition);
+
+  __ csel(locs()->out(0).reg(), locs()->in(n).reg(), locs()->in(n + 1).reg(),
+          true_condition);
+}
+
 void IfThenElseInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   const Register result = locs()->out(0).reg();
 
@@ -1416,11 +1459,13 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
   if (is_leaf_) {
 #if !defined(PRODUCT)
-    // Set the thread object's top_exit_frame_info and VMTag to enable the
-    // profiler to determine that thread is no longer executing Dart code.
-    __ StoreToOffset(FPREG, THR,
-                     compiler::target::Thread::top_exit_frame_info_offset());
-    __ StoreToOffset(branch, THR, compiler::target::Thread::vm_tag_offset());
+    if (FLAG_profile_ffi_leaf_calls) {
+      // Set the thread object's top_exit_frame_info and VMTag to enable the
+      // profiler to determine that thread is no longer executing Dart code.
+      __ StoreToOffset(FPREG, THR,
+                       compiler::target::Thread::top_exit_frame_info_offset());
+      __ StoreToOffset(branch, THR, compiler::target::Thread::vm_tag_offset());
+    }
 #endif
 
     // We are entering runtime code, so the C stack pointer must be restored
@@ -1439,10 +1484,12 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
     __ mov(CSP, temp_csp);
 
 #if !defined(PRODUCT)
-    __ LoadImmediate(temp1, compiler::target::Thread::vm_tag_dart_id());
-    __ StoreToOffset(temp1, THR, compiler::target::Thread::vm_tag_offset());
-    __ StoreToOffset(ZR, THR,
-                     compiler::target::Thread::top_exit_frame_info_offset());
+    if (FLAG_profile_ffi_leaf_calls) {
+      __ LoadImmediate(temp1, compiler::target::Thread::vm_tag_dart_id());
+      __ StoreToOffset(temp1, THR, compiler::target::Thread::vm_tag_offset());
+      __ StoreToOffset(ZR, THR,
+                       compiler::target::Thread::top_exit_frame_info_offset());
+    }
 #endif
   } else {
     // We need to copy a dummy return address up into the dummy stack frame so
@@ -1135,22 +1135,26 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
   if (is_leaf_) {
 #if !defined(PRODUCT)
-    // Set the thread object's top_exit_frame_info and VMTag to enable the
-    // profiler to determine that thread is no longer executing Dart code.
-    __ movl(compiler::Address(
-                THR, compiler::target::Thread::top_exit_frame_info_offset()),
-            FPREG);
-    __ movl(compiler::Assembler::VMTagAddress(), branch);
+    if (FLAG_profile_ffi_leaf_calls) {
+      // Set the thread object's top_exit_frame_info and VMTag to enable the
+      // profiler to determine that thread is no longer executing Dart code.
+      __ movl(compiler::Address(
+                  THR, compiler::target::Thread::top_exit_frame_info_offset()),
+              FPREG);
+      __ movl(compiler::Assembler::VMTagAddress(), branch);
+    }
 #endif
 
     __ call(branch);
 
 #if !defined(PRODUCT)
-    __ movl(compiler::Assembler::VMTagAddress(),
-            compiler::Immediate(compiler::target::Thread::vm_tag_dart_id()));
-    __ movl(compiler::Address(
-                THR, compiler::target::Thread::top_exit_frame_info_offset()),
-            compiler::Immediate(0));
+    if (FLAG_profile_ffi_leaf_calls) {
+      __ movl(compiler::Assembler::VMTagAddress(),
+              compiler::Immediate(compiler::target::Thread::vm_tag_dart_id()));
+      __ movl(compiler::Address(
+                  THR, compiler::target::Thread::top_exit_frame_info_offset()),
+              compiler::Immediate(0));
+    }
 #endif
   } else {
     // We need to copy a dummy return address up into the dummy stack frame so
@@ -1842,6 +1846,8 @@ void StoreIndexedInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
 DEFINE_UNIMPLEMENTED_INSTRUCTION(GuardFieldTypeInstr)
 
+DEFINE_UNIMPLEMENTED_INSTRUCTION(SelectInstr)
+
 LocationSummary* GuardFieldClassInstr::MakeLocationSummary(Zone* zone,
                                                            bool opt) const {
   const intptr_t kNumInputs = 1;
@@ -974,6 +974,14 @@ void IfThenElseInstr::PrintOperandsTo(BaseTextBuffer* f) const {
   f->Printf(" ? %" Pd " : %" Pd, if_true_, if_false_);
 }
 
+void SelectInstr::PrintOperandsTo(BaseTextBuffer* f) const {
+  condition()->PrintOperandsTo(f);
+  f->AddString(" ? ");
+  if_true()->PrintTo(f);
+  f->AddString(" : ");
+  if_false()->PrintTo(f);
+}
+
 void LoadStaticFieldInstr::PrintOperandsTo(BaseTextBuffer* f) const {
   f->Printf("%s", String::Handle(field().name()).ToCString());
   if (calls_initializer()) {
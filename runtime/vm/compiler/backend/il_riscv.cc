@@ -1509,11 +1509,13 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
   if (is_leaf_) {
 #if !defined(PRODUCT)
-    // Set the thread object's top_exit_frame_info and VMTag to enable the
-    // profiler to determine that thread is no longer executing Dart code.
-    __ StoreToOffset(FPREG, THR,
-                     compiler::target::Thread::top_exit_frame_info_offset());
-    __ StoreToOffset(target, THR, compiler::target::Thread::vm_tag_offset());
+    if (FLAG_profile_ffi_leaf_calls) {
+      // Set the thread object's top_exit_frame_info and VMTag to enable the
+      // profiler to determine that thread is no longer executing Dart code.
+      __ StoreToOffset(FPREG, THR,
+                       compiler::target::Thread::top_exit_frame_info_offset());
+      __ StoreToOffset(target, THR, compiler::target::Thread::vm_tag_offset());
+    }
 #endif
 
     __ mv(A3, T3);  // TODO(rmacnak): Only when needed.
@@ -1522,10 +1524,12 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
     __ jalr(target);
 
 #if !defined(PRODUCT)
-    __ LoadImmediate(temp1, compiler::target::Thread::vm_tag_dart_id());
-    __ StoreToOffset(temp1, THR, compiler::target::Thread::vm_tag_offset());
-    __ StoreToOffset(ZR, THR,
-                     compiler::target::Thread::top_exit_frame_info_offset());
+    if (FLAG_profile_ffi_leaf_calls) {
+      __ LoadImmediate(temp1, compiler::target::Thread::vm_tag_dart_id());
+      __ StoreToOffset(temp1, THR, compiler::target::Thread::vm_tag_offset());
+      __ StoreToOffset(ZR, THR,
+                       compiler::target::Thread::top_exit_frame_info_offset());
+    }
 #endif
   } else {
     // We need to copy a dummy return address up into the dummy stack frame so
@@ -2404,6 +2408,8 @@ static void LoadValueCid(FlowGraphCompiler* compiler,
 
 DEFINE_UNIMPLEMENTED_INSTRUCTION(GuardFieldTypeInstr)
 
+DEFINE_UNIMPLEMENTED_INSTRUCTION(SelectInstr)
+
 LocationSummary* GuardFieldClassInstr::MakeLocationSummary(Zone* zone,
                                                            bool opt) const {
   const intptr_t kNumInputs = 1;
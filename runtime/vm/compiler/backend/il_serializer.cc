@@ -1079,6 +1079,28 @@ void IfThenElseInstr::ReadExtra(FlowGraphDeserializer* d) {
   }
 }
 
+void SelectInstr::WriteExtra(FlowGraphSerializer* s) {
+  // Select reuses inputs from its embedded Condition, which are
+  // written together with the Condition.
+  WriteExtraWithoutInputs(s);
+  condition_->WriteExtra(s);
+  s->Write<Value*>(if_true());
+  s->Write<Value*>(if_false());
+}
+
+void SelectInstr::ReadExtra(FlowGraphDeserializer* d) {
+  ReadExtraWithoutInputs(d);
+  condition_->ReadExtra(d);
+  const intptr_t n = condition_->InputCount();
+  for (intptr_t i = n - 1; i >= 0; --i) {
+    condition_->InputAt(i)->set_instruction(this);
+  }
+  for (intptr_t i = n; i < InputCount(); ++i) {
+    SetInputAt(i, d->Read<Value*>());
+    InputAt(i)->definition()->AddInputUse(InputAt(i));
+  }
+}
+
 void IndirectGotoInstr::WriteTo(FlowGraphSerializer* s) {
   TemplateInstruction::WriteTo(s);
   s->Write<intptr_t>(offsets_.Length());
@@ -1982,6 +1982,122 @@ ISOLATE_UNIT_TEST_CASE(IL_RecordCoverageSurvivesOptimizations) {
   EXPECT(flow_graph->graph_entry()->normal_entry()->next()->IsRecordCoverage());
 }
 
+#if defined(DART_PRECOMPILER)
+DECLARE_FLAG(bool, aot_coverage);
+
+// Precompiled code records the coverage of function entries and blocks, but
+// not of each call like the JIT.
+ISOLATE_UNIT_TEST_CASE(IL_AotCoverageRecordsFunctionsAndBlocks) {
+  SetFlagScope<bool> sfs(&FLAG_aot_coverage, true);
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    int bar() => 42;
+
+    int foo(bool b) {
+      if (b) {
+        return bar();
+      }
+      return 0;
+    }
+
+    main() => foo(true);
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  const Array& coverage_array = flow_graph->coverage_array();
+  EXPECT_EQ(4, coverage_array.Length());
+  for (intptr_t i = 0; i < coverage_array.Length(); i += 2) {
+    bool is_branch_coverage = false;
+    TokenPosition::DecodeCoveragePosition(
+        Smi::Value(Smi::RawCast(coverage_array.At(i))), &is_branch_coverage);
+    EXPECT(is_branch_coverage);
+  }
+
+  intptr_t record_count = 0;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (it.Current()->IsRecordCoverage()) record_count++;
+    }
+  }
+  EXPECT_EQ(2, record_count);
+}
+#endif  // defined(DART_PRECOMPILER)
+
+// Records merged by a phi are not allocated when returned unboxed.
+ISOLATE_UNIT_TEST_CASE(IL_UnboxedRecordReturnOfPhi) {
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    (int, int) foo(bool b, int x, int y) => b ? (x, y) : (y, x);
+
+    main() => foo(true, 1, 2);
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  function.set_unboxed_record_return();
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  intptr_t allocation_count = 0;
+  intptr_t make_pair_count = 0;
+  for (auto block : flow_graph->reverse_postorder()) {
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (it.Current()->IsAllocateSmallRecord()) allocation_count++;
+      if (auto* make_pair = it.Current()->AsMakePair()) {
+        make_pair_count++;
+        EXPECT(make_pair->InputAt(0)->definition()->IsPhi());
+        EXPECT(make_pair->InputAt(1)->definition()->IsPhi());
+      }
+    }
+  }
+  EXPECT_EQ(0, allocation_count);
+  EXPECT_EQ(1, make_pair_count);
+}
+
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+// Diamonds selecting between cheap integer values are converted into
+// branchless selects.
+ISOLATE_UNIT_TEST_CASE(IL_IfConvertToSelect) {
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    int min(int a, int b) => a < b ? a : b;
+
+    @pragma('vm:never-inline')
+    int inc(int a, int b) => a == b ? a + 1 : b;
+
+    main() {
+      print(min(1, 2));
+      print(inc(1, 2));
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+
+  for (const char* name : {"min", "inc"}) {
+    const auto& function = Function::Handle(GetFunction(root_library, name));
+    TestPipeline pipeline(function, CompilerPass::kAOT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+
+    intptr_t select_count = 0;
+    intptr_t branch_count = 0;
+    for (auto block : flow_graph->reverse_postorder()) {
+      for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+        if (it.Current()->IsSelect()) select_count++;
+        if (it.Current()->IsBranch()) branch_count++;
+      }
+    }
+    EXPECT_EQ(1, select_count);
+    EXPECT_EQ(0, branch_count);
+    pipeline.CompileGraphAndAttachFunction();
+  }
+}
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
 // This test verifies that the ASSERT in Assembler::ElementAddressForIntIndex
 // appropriately accounts for the heap object tag to check the displacement.
 // Regression test for https://github.com/dart-lang/sdk/issues/56588.
@@ -590,6 +590,58 @@ void IfThenElseInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   }
 }
 
+LocationSummary* SelectInstr::MakeLocationSummary(Zone* zone,
+                                                  bool opt) const {
+  condition()->InitializeLocationSummary(zone, opt);
+  const LocationSummary* condition_locs = condition()->locs();
+  const intptr_t n = condition()->InputCount();
+  LocationSummary* summary = new (zone) LocationSummary(
+      zone, InputCount(), condition_locs->temp_count(),
+      LocationSummary::kNoCall);
+  for (intptr_t i = 0; i < n; i++) {
+    summary->set_in(i, condition_locs->in(i));
+  }
+  for (intptr_t i = 0; i < condition_locs->temp_count(); i++) {
+    summary->set_temp(i, condition_locs->temp(i));
+  }
+  summary->set_in(n, Location::RequiresRegister());
+  summary->set_in(n + 1, Location::RequiresRegister());
+  summary->set_out(0, Location::RequiresRegister());
+  return summary;
+}
+
+void SelectInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  // The condition emits its code using its own location summary, so
+  // pass the allocated locations to it.
+  LocationSummary* condition_locs = condition()->locs();
+  const intptr_t n = condition()->InputCount();
+  for (intptr_t i = 0; i < n; i++) {
+    condition_locs->set_in(i, locs()->in(i));
+  }
+  for (intptr_t i = 0; i < condition_locs->temp_count(); i++) {
+    condition_locs->set_temp(i, locs()->temp(i));
+  }
+  const Register if_true = locs()->in(n).reg();
+  const Register if_false = locs()->in(n + 1).reg();
+  const Register result = locs()->out(0).reg();
+
+  // SelectInstr::Supports() should prevent EmitConditionCode from using
+  // the labels or returning an invalid condition.
+  BranchLabels labels = {nullptr, nullptr, nullptr};
+  const Condition true_condition =
+      condition()->EmitConditionCode(compiler, labels);
+  ASSERT(true_condition != kInvalidCondition);
+
+  // The result register can be shared with one of the values. Moves do
+  // not affect the flags.
+  if (result == if_true) {
+    __ cmovq(InvertCondition(true_condition), result, if_false);
+  } else {
+    __ MoveRegister(result, if_false);
+    __ cmovq(true_condition, result, if_true);
+  }
+}
+
 LocationSummary* LoadLocalInstr::MakeLocationSummary(Zone* zone,
                                                      bool opt) const {
   const intptr_t kNumInputs = 0;
@@ -1298,12 +1350,14 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
   if (is_leaf_) {
 #if !defined(PRODUCT)
-    // Set the thread object's top_exit_frame_info and VMTag to enable the
-    // profiler to determine that thread is no longer executing Dart code.
-    __ movq(compiler::Address(
-                THR, compiler::target::Thread::top_exit_frame_info_offset()),
-            FPREG);
-    __ movq(compiler::Assembler::VMTagAddress(), target_address);
+    if (FLAG_profile_ffi_leaf_calls) {
+      // Set the thread object's top_exit_frame_info and VMTag to enable the
+      // profiler to determine that thread is no longer executing Dart code.
+      __ movq(compiler::Address(
+                  THR, compiler::target::Thread::top_exit_frame_info_offset()),
+              FPREG);
+      __ movq(compiler::Assembler::VMTagAddress(), target_address);
+    }
 #endif
 
     if (marshaller_.contains_varargs() &&
@@ -1315,11 +1369,13 @@ void FfiCallInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
     __ CallCFunction(target_address, /*restore_rsp=*/true);
 
 #if !defined(PRODUCT)
-    __ movq(compiler::Assembler::VMTagAddress(),
-            compiler::Immediate(compiler::target::Thread::vm_tag_dart_id()));
-    __ movq(compiler::Address(
-                THR, compiler::target::Thread::top_exit_frame_info_offset()),
-            compiler::Immediate(0));
+    if (FLAG_profile_ffi_leaf_calls) {
+      __ movq(compiler::Assembler::VMTagAddress(),
+              compiler::Immediate(compiler::target::Thread::vm_tag_dart_id()));
+      __ movq(compiler::Address(
+                  THR, compiler::target::Thread::top_exit_frame_info_offset()),
+              compiler::Immediate(0));
+    }
 #endif
   } else {
     // We need to copy a dummy return address up into the dummy stack frame so
@@ -4078,7 +4134,7 @@ Condition DoubleTestOpInstr::EmitConditionCode(FlowGraphCompiler* compiler,
   V(Float32x4##Name, op##ps)                                                   \
   V(Float64x2##Name, op##pd)
 
-#define SIMD_OP_SIMPLE_BINARY(V)                                               \
+#define SIMD_OP_ARITH_BINARY(V)                                                \
   SIMD_OP_FLOAT_ARITH(V, Add, add)                                             \
   SIMD_OP_FLOAT_ARITH(V, Sub, sub)                                             \
   SIMD_OP_FLOAT_ARITH(V, Mul, mul)                                             \
@@ -4089,7 +4145,10 @@ Condition DoubleTestOpInstr::EmitConditionCode(FlowGraphCompiler* compiler,
   V(Int32x4Sub, subpl)                                                         \
   V(Int32x4BitAnd, andps)                                                      \
   V(Int32x4BitOr, orps)                                                        \
-  V(Int32x4BitXor, xorps)                                                      \
+  V(Int32x4BitXor, xorps)
+
+#define SIMD_OP_SIMPLE_BINARY(V)                                               \
+  SIMD_OP_ARITH_BINARY(V)                                                      \
   V(Float32x4Equal, cmppseq)                                                   \
   V(Float32x4NotEqual, cmppsneq)                                               \
   V(Float32x4LessThan, cmppslt)                                                \
@@ -4392,6 +4451,36 @@ DEFINE_EMIT(Int32x4Select,
   __ orps(mask, temp);
 }
 
+// With AVX the arithmetic binary operations use the three operand VEX
+// encoding, which does not require the output to be the left input.
+DEFINE_EMIT(SimdBinaryOpVex,
+            (XmmRegister out, XmmRegister left, XmmRegister right)) {
+  switch (instr->kind()) {
+#define EMIT(Name, op)                                                         \
+  case SimdOpInstr::k##Name:                                                   \
+    __ v##op(out, left, right);                                                \
+    break;
+    SIMD_OP_ARITH_BINARY(EMIT)
+#undef EMIT
+    default:
+      UNREACHABLE();
+  }
+}
+
+static bool UseVexEncoding(SimdOpInstr::Kind kind) {
+  if (!TargetCPUFeatures::avx_supported()) {
+    return false;
+  }
+  switch (kind) {
+#define CASE(Name, op) case SimdOpInstr::k##Name:
+    SIMD_OP_ARITH_BINARY(CASE)
+#undef CASE
+      return true;
+    default:
+      return false;
+  }
+}
+
 // Map SimdOpInstr::Kind-s to corresponding emit functions. Uses the following
 // format:
 //
@@ -4453,6 +4542,9 @@ DEFINE_EMIT(Int32x4Select,
   SIMPLE(Int32x4Select)
 
 LocationSummary* SimdOpInstr::MakeLocationSummary(Zone* zone, bool opt) const {
+  if (UseVexEncoding(kind())) {
+    return MakeLocationSummaryFromEmitter(zone, this, &EmitSimdBinaryOpVex);
+  }
   switch (kind()) {
 #define CASE(Name, ...) case k##Name:
 #define EMIT(Name)                                                             \
@@ -4472,6 +4564,10 @@ LocationSummary* SimdOpInstr::MakeLocationSummary(Zone* zone, bool opt) const {
 }
 
 void SimdOpInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
+  if (UseVexEncoding(kind())) {
+    InvokeEmitter(compiler, this, &EmitSimdBinaryOpVex);
+    return;
+  }
   switch (kind()) {
 #define CASE(Name, ...) case k##Name:
 #define EMIT(Name)                                                             \
@@ -5,6 +5,7 @@
 #include "vm/compiler/backend/inliner.h"
 
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
@@ -257,6 +258,26 @@ static intptr_t AotCallCountApproximation(intptr_t nesting_depth) {
   }
 }
 
+#if defined(DART_PRECOMPILER)
+// Returns the number of times [call] was executed during the training run
+// recorded in the AOT profile, or -1 if it is unknown.
+static intptr_t AotProfiledCallCount(FlowGraph* caller_graph,
+                                     Definition* call) {
+  AotProfile* profile = AotProfile::Current();
+  if (profile == nullptr) {
+    return -1;
+  }
+  const String* selector = nullptr;
+  if (auto instance_call = call->AsInstanceCallBase()) {
+    selector = &instance_call->function_name();
+  } else if (auto static_call = call->AsStaticCall()) {
+    selector = &String::Handle(static_call->function().name());
+  }
+  return profile->CallCount(AotProfile::CallerOf(*caller_graph, *call),
+                            call->token_pos(), selector);
+}
+#endif  // defined(DART_PRECOMPILER)
+
 // A collection of call sites to consider for inlining.
 class CallSites : public ValueObject {
  public:
@@ -278,7 +299,14 @@ class CallSites : public ValueObject {
           call_depth(call_depth),
           nesting_depth(nesting_depth) {
       if (CompilerState::Current().is_aot()) {
-        call_count = AotCallCountApproximation(nesting_depth);
+#if defined(DART_PRECOMPILER)
+        call_count = AotProfiledCallCount(caller_graph, call);
+#else
+        call_count = -1;
+#endif  // defined(DART_PRECOMPILER)
+        if (call_count < 0) {
+          call_count = AotCallCountApproximation(nesting_depth);
+        }
       } else {
         call_count = call->CallCount();
       }
@@ -11,12 +11,24 @@
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/loops.h"
 #include "vm/compiler/backend/parallel_move_resolver.h"
+#include "vm/flags.h"
 #include "vm/log.h"
 #include "vm/parser.h"
 #include "vm/stack_frame.h"
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            fast_register_allocation_threshold,
+            20000,
+            "Number of instructions above which the register allocator "
+            "trades code quality for allocation time, -1 means never.");
+DEFINE_FLAG(int,
+            max_register_allocation_instructions,
+            200000,
+            "Number of instructions above which the JIT leaves functions "
+            "unoptimized instead of allocating registers, -1 means no limit.");
+
 #if !defined(PRODUCT)
 #define INCLUDE_LINEAR_SCAN_TRACING_CODE
 #endif
@@ -115,7 +127,8 @@ FlowGraphAllocator::FlowGraphAllocator(const FlowGraph& flow_graph,
       quad_spill_slots_(),
       untagged_spill_slots_(),
       cpu_spill_slot_count_(0),
-      intrinsic_mode_(intrinsic_mode) {
+      intrinsic_mode_(intrinsic_mode),
+      fast_mode_(false) {
   for (intptr_t i = 0; i < vreg_count_; i++) {
     live_ranges_.Add(nullptr);
   }
@@ -2079,7 +2092,7 @@ LiveRange* FlowGraphAllocator::SplitBetween(LiveRange* range,
     //            ^      ^        ^
     //            H      S        X
     LoopInfo* loop_info = split_block_entry->loop_info();
-    if (loop_info == nullptr) {
+    if ((loop_info == nullptr) && !fast_mode_) {
       const LoopHierarchy& loop_hierarchy = flow_graph_.loop_hierarchy();
       const intptr_t num_loops = loop_hierarchy.num_loops();
       for (intptr_t i = 0; i < num_loops; i++) {
@@ -2623,7 +2636,8 @@ void FlowGraphAllocator::AllocateAnyRegister(LiveRange* unallocated) {
   UsePosition* register_use =
       unallocated->finger()->FirstRegisterUse(unallocated->Start());
   if ((register_use == nullptr) &&
-      !(unallocated->is_loop_phi() && HasCheapEvictionCandidate(unallocated))) {
+      (fast_mode_ || !(unallocated->is_loop_phi() &&
+                       HasCheapEvictionCandidate(unallocated)))) {
     Spill(unallocated);
     return;
   }
@@ -2936,18 +2950,23 @@ static void AddToSortedListOfRanges(GrowableArray<LiveRange*>* list,
                                     LiveRange* range) {
   range->finger()->Initialize(range);
 
-  if (list->is_empty()) {
-    list->Add(range);
-    return;
-  }
-
-  for (intptr_t i = list->length() - 1; i >= 0; i--) {
-    if (ShouldBeAllocatedBefore(range, (*list)[i])) {
-      list->InsertAt(i + 1, range);
-      return;
+  // The list is sorted by decreasing start. Insert [range] after the last
+  // range it should be allocated before.
+  intptr_t lo = 0;
+  intptr_t hi = list->length();
+  while (lo < hi) {
+    const intptr_t mid = lo + (hi - lo) / 2;
+    if (ShouldBeAllocatedBefore(range, (*list)[mid])) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
     }
   }
-  list->InsertAt(0, range);
+  if (lo == list->length()) {
+    list->Add(range);
+  } else {
+    list->InsertAt(lo, range);
+  }
 }
 
 void FlowGraphAllocator::AddToUnallocated(LiveRange* range) {
@@ -3044,6 +3063,14 @@ void FlowGraphAllocator::AllocateUnallocatedRanges() {
     // TODO(vegorov): eagerly spill liveranges without register uses.
     AdvanceActiveIntervals(start);
 
+    // In fast mode ranges without register uses are spilled eagerly, so they
+    // never occupy a register that later has to be evicted.
+    if (fast_mode_ &&
+        (range->finger()->FirstRegisterUse(range->Start()) == nullptr)) {
+      Spill(range);
+      continue;
+    }
+
     if (!AllocateFreeRegister(range)) {
       if (intrinsic_mode_) {
         // No spilling when compiling intrinsics.
@@ -3623,6 +3650,18 @@ void FlowGraphAllocator::AllocateRegisters() {
 
   NumberInstructions();
 
+  const intptr_t instruction_count = instructions_.length();
+  if (!FLAG_precompiled_mode && !intrinsic_mode_ &&
+      (FLAG_max_register_allocation_instructions >= 0) &&
+      (instruction_count > FLAG_max_register_allocation_instructions) &&
+      !flow_graph_.function().ForceOptimize()) {
+    flow_graph_.parsed_function().Bailout("FlowGraphAllocator",
+                                          "too many instructions");
+  }
+  fast_mode_ = !intrinsic_mode_ &&
+               (FLAG_fast_register_allocation_threshold >= 0) &&
+               (instruction_count > FLAG_fast_register_allocation_threshold);
+
   // Reserve spill slot for :suspend_state synthetic variable before
   // reserving spill slots for parameter variables.
   AllocateSpillSlotForSuspendState();
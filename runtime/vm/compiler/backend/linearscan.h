@@ -386,6 +386,11 @@ class FlowGraphAllocator : public ValueObject {
 
   const bool intrinsic_mode_;
 
+  // Set for functions above --fast_register_allocation_threshold. Ranges
+  // without register uses are spilled eagerly and split positions are not
+  // moved to enclosing loop headers.
+  bool fast_mode_;
+
   DISALLOW_COPY_AND_ASSIGN(FlowGraphAllocator);
 };
 
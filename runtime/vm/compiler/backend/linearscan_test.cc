@@ -14,6 +14,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, fast_register_allocation_threshold);
+
 class DummyDef : public Definition {
  public:
   explicit DummyDef(
@@ -216,4 +218,49 @@ ISOLATE_UNIT_TEST_CASE(LinearScan_TestSameAsFirstOrSecondNoFlip2) {
   EXPECT_PROPERTY(binop->InputAt(1)->definition(), &it == rhs);
 }
 
+ISOLATE_UNIT_TEST_CASE(LinearScan_FastMode) {
+  using compiler::BlockBuilder;
+  SetFlagScope<int> sfs(&FLAG_fast_register_allocation_threshold, 0);
+  CompilerState S(thread, /*is_aot=*/false, /*is_optimizing=*/true);
+  FlowGraphBuilderHelper H;
+
+  auto zone = H.flow_graph()->zone();
+
+  auto b1 = H.flow_graph()->graph_entry()->normal_entry();
+
+  DummyDef* value;
+  DummyDef* use_in_register;
+  DummyDef* use_anywhere;
+
+  {
+    BlockBuilder builder(H.flow_graph(), b1);
+
+    value = builder.AddDefinition(
+        new DummyDef(zone, {}, Location::RequiresRegister()));
+    use_in_register = builder.AddDefinition(new DummyDef(
+        zone, {{value, Location::RequiresRegister()}},
+        Location::RequiresRegister()));
+    auto call = builder.AddDefinition(new DummyDef(
+        zone, {}, Location::RegisterLocation(CallingConventions::kReturnReg),
+        LocationSummary::kCall));
+    use_anywhere = builder.AddDefinition(
+        new DummyDef(zone, {{value, Location::Any()}}, Location()));
+    builder.AddInstruction(new DartReturnInstr(
+        InstructionSource(), new Value(call), S.GetNextDeoptId()));
+  }
+  H.FinishGraph();
+
+  H.flow_graph()->InsertMoveArguments();
+  // Ensure loop hierarchy has been computed.
+  H.flow_graph()->GetLoopHierarchy();
+  // Perform register allocation on the SSA graph.
+  FlowGraphAllocator allocator(*H.flow_graph());
+  allocator.AllocateRegisters();
+
+  // Uses which require a register still get one, while the rest of [value],
+  // which has no register uses, lives in its spill slot.
+  EXPECT(use_in_register->locs()->in(0).IsRegister());
+  EXPECT(use_anywhere->locs()->in(0).IsStackSlot());
+}
+
 }  // namespace dart
@@ -0,0 +1,584 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/compiler/backend/range_analysis.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_vectorization,
+            false,
+            "Vectorize counted loops over Float64List elements.");
+DEFINE_FLAG(bool,
+            trace_loop_vectorization,
+            false,
+            "Trace loop vectorization.");
+
+// Number of double lanes in a Float64x2 value.
+static constexpr intptr_t kLanes = 2;
+
+// Vectorizes a single counted loop of the form
+//
+//   for (int i = start; i < limit; i++) {
+//     // Element-wise double arithmetic on Float64List elements at [i].
+//   }
+//
+// which consists of a header block H and a single body block B. A vector
+// loop processing [kLanes] elements per iteration is inserted in front of
+// the original loop, which is kept to process the remaining elements:
+//
+//        P                     P: vector_limit = start + ((limit - start) & -2)
+//        |                     |
+//   +--> H --> exit       +--> VH --> VX --> H --> exit
+//   |    |                |    |             ^ |
+//   +--- B                +--- VB            +-B
+//
+// Only accesses at exactly index [i] are supported, which makes vectorization
+// safe as long as distinct arrays don't partially overlap. Internal
+// Float64List objects never partially overlap, so the vector loop is only
+// entered if all accessed arrays are the same object or internal Float64List
+// objects. Other arrays (views and external typed data) are handled by the
+// scalar loop.
+class CountedLoopVectorizer : public ZoneAllocated {
+ public:
+  CountedLoopVectorizer(FlowGraph* flow_graph, LoopInfo* loop)
+      : flow_graph_(flow_graph), loop_(loop) {}
+
+  // Returns true if the loop can be vectorized.
+  bool Analyze();
+
+  // Inserts the vector loop. The caller must recompute the block order and
+  // dominators afterwards.
+  void Transform();
+
+  BlockEntryInstr* header() const { return header_; }
+
+ private:
+  Zone* zone() const { return flow_graph_->zone(); }
+
+  bool IsLoopInvariant(Definition* def) const {
+    return !loop_->Contains(def->GetBlock());
+  }
+
+  bool IsIndex(Value* index) const;
+  bool IsArray(Value* array) const;
+  bool IsLaneOperand(Value* operand) const;
+  bool IsElementAccess(intptr_t class_id,
+                       bool aligned,
+                       intptr_t index_scale,
+                       Value* index) const;
+  bool AnalyzeBodyInstruction(Instruction* current);
+  bool AnalyzeAliasing();
+
+  Definition* ArrayRoot(Definition* array) const;
+
+  ConstantInstr* IntConstant(int64_t value) const;
+  Definition* EmitInPreHeader(Definition* def);
+  Definition* EmitIntOp(Token::Kind op_kind,
+                        Definition* left,
+                        Definition* right);
+  Definition* EmitGuard(Definition* mask);
+
+  Value* VectorOperand(Value* operand);
+  Value* ArrayOperand(Value* array);
+  void Emit(Definition* original, Definition* replacement);
+  void Emit(Instruction* instr);
+  void VectorizeBodyInstruction(Instruction* current);
+
+  FlowGraph* const flow_graph_;
+  LoopInfo* const loop_;
+
+  JoinEntryInstr* header_ = nullptr;
+  TargetEntryInstr* body_ = nullptr;
+  BlockEntryInstr* pre_header_ = nullptr;
+  intptr_t pre_header_index_ = -1;
+  PhiInstr* induction_ = nullptr;
+  Definition* increment_ = nullptr;
+  Definition* start_ = nullptr;
+  Definition* limit_ = nullptr;
+  CheckStackOverflowInstr* stack_overflow_check_ = nullptr;
+  BranchInstr* branch_ = nullptr;
+
+  // Accessed arrays (with redefinitions inside the loop stripped) and the
+  // subset of those which need a class id check before entering the vector
+  // loop.
+  GrowableArray<Definition*> arrays_;
+  GrowableArray<Definition*> guarded_arrays_;
+  bool has_stores_ = false;
+
+  // State of the transformation.
+  GotoInstr* pre_header_goto_ = nullptr;
+  PhiInstr* vector_induction_ = nullptr;
+  Instruction* cursor_ = nullptr;
+  // Maps scalar definitions to their vector counterparts, indexed by
+  // ssa_temp_index.
+  GrowableArray<Definition*> vector_defs_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountedLoopVectorizer);
+};
+
+bool CountedLoopVectorizer::Analyze() {
+  if (loop_->inner() != nullptr) return false;
+
+  header_ = loop_->header()->AsJoinEntry();
+  if ((header_ == nullptr) || header_->InsideTryBlock() ||
+      (header_->PredecessorCount() != 2) ||
+      (loop_->back_edges().length() != 1)) {
+    return false;
+  }
+  body_ = loop_->back_edges()[0]->AsTargetEntry();
+  if ((body_ == nullptr) || (body_->PredecessorCount() != 1) ||
+      (body_->PredecessorAt(0) != header_)) {
+    return false;
+  }
+  intptr_t num_blocks = 0;
+  for (BitVector::Iterator it(loop_->blocks()); !it.Done(); it.Advance()) {
+    ++num_blocks;
+  }
+  if (num_blocks != 2) return false;
+
+  pre_header_index_ = (header_->PredecessorAt(0) == body_) ? 1 : 0;
+  pre_header_ = header_->PredecessorAt(pre_header_index_);
+  if (!pre_header_->last_instruction()->IsGoto()) return false;
+
+  // The only header phi must be the induction variable i = phi(start, i + 1).
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    if (induction_ != nullptr) return false;
+    induction_ = it.Current();
+  }
+  if ((induction_ == nullptr) ||
+      (induction_->representation() != kUnboxedInt64)) {
+    return false;
+  }
+  int64_t stride = 0;
+  if (!InductionVar::IsLinear(loop_->LookupInduction(induction_), &stride) ||
+      (stride != 1)) {
+    return false;
+  }
+  start_ = induction_->InputAt(pre_header_index_)->definition();
+  increment_ = induction_->InputAt(1 - pre_header_index_)->definition();
+  if (!increment_->IsBinaryInt64Op() || (increment_->GetBlock() != body_)) {
+    return false;
+  }
+
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (auto check = current->AsCheckStackOverflow()) {
+      if (stack_overflow_check_ != nullptr) return false;
+      stack_overflow_check_ = check;
+    } else if (!current->IsBranch()) {
+      return false;
+    }
+  }
+  branch_ = header_->last_instruction()->AsBranch();
+  if ((branch_ == nullptr) || (branch_->true_successor() != body_)) {
+    return false;
+  }
+  auto compare = branch_->condition()->AsRelationalOp();
+  if ((compare == nullptr) ||
+      (compare->input_representation() != kUnboxedInt64)) {
+    return false;
+  }
+  if ((compare->kind() == Token::kLT) &&
+      (compare->left()->definition() == induction_)) {
+    limit_ = compare->right()->definition();
+  } else if ((compare->kind() == Token::kGT) &&
+             (compare->right()->definition() == induction_)) {
+    limit_ = compare->left()->definition();
+  } else {
+    return false;
+  }
+  // Non-negative bounds guarantee that computing the vector limit in the
+  // pre-header can't overflow. Bounds checks on the accesses can only be
+  // eliminated if this holds anyway.
+  if (!IsLoopInvariant(limit_) ||
+      !RangeUtils::IsWithin(start_->range(), 0, kMaxInt64) ||
+      !RangeUtils::IsWithin(limit_->range(), 0, kMaxInt64)) {
+    return false;
+  }
+
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if ((current == increment_) || current->IsGoto()) continue;
+    if (!AnalyzeBodyInstruction(current)) {
+      if (FLAG_trace_loop_vectorization) {
+        THR_Print("Loop at B%" Pd " not vectorized: %s\n",
+                  header_->block_id(), current->ToCString());
+      }
+      return false;
+    }
+  }
+  return has_stores_ && AnalyzeAliasing();
+}
+
+bool CountedLoopVectorizer::IsIndex(Value* index) const {
+  Definition* def = index->definition();
+  if (auto box = def->AsBoxInt64()) {
+    def = box->value()->definition();
+  }
+  return def == induction_;
+}
+
+bool CountedLoopVectorizer::IsArray(Value* array) const {
+  Definition* def = array->definition();
+  if (IsLoopInvariant(def)) return true;
+  // Checks inside the loop have already been accepted if they precede
+  // the use.
+  return def->IsCheckNull() || def->IsCheckWritable();
+}
+
+bool CountedLoopVectorizer::IsLaneOperand(Value* operand) const {
+  Definition* def = operand->definition();
+  if (def->representation() != kUnboxedDouble) return false;
+  if (IsLoopInvariant(def)) return true;
+  return def->IsLoadIndexed() || def->IsBinaryDoubleOp() ||
+         def->IsUnaryDoubleOp();
+}
+
+bool CountedLoopVectorizer::IsElementAccess(intptr_t class_id,
+                                            bool aligned,
+                                            intptr_t index_scale,
+                                            Value* index) const {
+  return (class_id == kTypedDataFloat64ArrayCid) && aligned &&
+         (index_scale == kDoubleSize) && IsIndex(index);
+}
+
+bool CountedLoopVectorizer::AnalyzeBodyInstruction(Instruction* current) {
+  if (auto box = current->AsBoxInt64()) {
+    return box->value()->definition() == induction_;
+  }
+  if (auto check = current->AsCheckNull()) {
+    return IsArray(check->value());
+  }
+  if (auto check = current->AsCheckWritable()) {
+    return IsArray(check->value());
+  }
+  if (auto load = current->AsLoadIndexed()) {
+    if (!IsElementAccess(load->class_id(), load->aligned(),
+                         load->index_scale(), load->index()) ||
+        !IsArray(load->array())) {
+      return false;
+    }
+    arrays_.Add(ArrayRoot(load->array()->definition()));
+    return true;
+  }
+  if (auto store = current->AsStoreIndexed()) {
+    if (!IsElementAccess(store->class_id(), store->aligned(),
+                         store->index_scale(), store->index()) ||
+        !IsArray(store->array()) || !IsLaneOperand(store->value())) {
+      return false;
+    }
+    arrays_.Add(ArrayRoot(store->array()->definition()));
+    has_stores_ = true;
+    return true;
+  }
+  if (auto op = current->AsBinaryDoubleOp()) {
+    switch (op->op_kind()) {
+      case Token::kADD:
+      case Token::kSUB:
+      case Token::kMUL:
+      case Token::kDIV:
+        return (op->representation() == kUnboxedDouble) &&
+               IsLaneOperand(op->left()) && IsLaneOperand(op->right());
+      default:
+        return false;
+    }
+  }
+  if (auto op = current->AsUnaryDoubleOp()) {
+    switch (op->op_kind()) {
+      case Token::kNEGATE:
+      case Token::kSQRT:
+      case Token::kSQUARE:
+        return (op->representation() == kUnboxedDouble) &&
+               IsLaneOperand(op->value());
+      default:
+        return false;
+    }
+  }
+  return false;
+}
+
+Definition* CountedLoopVectorizer::ArrayRoot(Definition* array) const {
+  while (!IsLoopInvariant(array)) {
+    ASSERT(array->IsCheckNull() || array->IsCheckWritable());
+    array = array->InputAt(0)->definition();
+  }
+  return array;
+}
+
+bool CountedLoopVectorizer::AnalyzeAliasing() {
+  // A single array is only ever accessed at index [i] in each iteration.
+  bool single_array = true;
+  for (intptr_t i = 1; i < arrays_.length(); ++i) {
+    if (arrays_[i]->OriginalDefinition() != arrays_[0]->OriginalDefinition()) {
+      single_array = false;
+      break;
+    }
+  }
+  if (single_array) return true;
+
+  for (intptr_t i = 0; i < arrays_.length(); ++i) {
+    Definition* array = arrays_[i];
+    if ((array->Type()->ToCid() == kTypedDataFloat64ArrayCid) ||
+        guarded_arrays_.Contains(array)) {
+      continue;
+    }
+    guarded_arrays_.Add(array);
+  }
+  return true;
+}
+
+ConstantInstr* CountedLoopVectorizer::IntConstant(int64_t value) const {
+  return flow_graph_->GetConstant(Smi::ZoneHandle(zone(), Smi::New(value)),
+                                  kUnboxedInt64);
+}
+
+Definition* CountedLoopVectorizer::EmitInPreHeader(Definition* def) {
+  flow_graph_->InsertBefore(pre_header_goto_, def, nullptr, FlowGraph::kValue);
+  return def;
+}
+
+Definition* CountedLoopVectorizer::EmitIntOp(Token::Kind op_kind,
+                                             Definition* left,
+                                             Definition* right) {
+  return EmitInPreHeader(new (zone()) BinaryInt64OpInstr(
+      op_kind, new (zone()) Value(left), new (zone()) Value(right),
+      DeoptId::kNone));
+}
+
+Definition* CountedLoopVectorizer::EmitGuard(Definition* mask) {
+  Definition* mismatch = nullptr;
+  for (intptr_t i = 0; i < guarded_arrays_.length(); ++i) {
+    Definition* cid = EmitInPreHeader(new (zone()) LoadClassIdInstr(
+        new (zone()) Value(guarded_arrays_[i]), kUnboxedUword));
+    Definition* diff = EmitIntOp(Token::kBIT_XOR, cid,
+                                 IntConstant(kTypedDataFloat64ArrayCid));
+    mismatch = (mismatch == nullptr)
+                   ? diff
+                   : EmitIntOp(Token::kBIT_OR, mismatch, diff);
+  }
+  // Class ids are non-negative, so (0 - mismatch) >> 63 is -1 if any of the
+  // arrays is not an internal Float64List and 0 otherwise. Clearing the mask
+  // in the former case makes the vector loop execute zero iterations.
+  Definition* any_mismatch = EmitIntOp(
+      Token::kSHR, EmitIntOp(Token::kSUB, IntConstant(0), mismatch),
+      IntConstant(63));
+  return EmitIntOp(Token::kBIT_AND, mask,
+                   EmitIntOp(Token::kBIT_XOR, any_mismatch, IntConstant(-1)));
+}
+
+Value* CountedLoopVectorizer::VectorOperand(Value* operand) {
+  Definition* def = operand->definition();
+  Definition* vector = vector_defs_[def->ssa_temp_index()];
+  if (vector == nullptr) {
+    // Broadcast loop invariant scalars in the pre-header.
+    ASSERT(IsLoopInvariant(def));
+    vector = EmitInPreHeader(SimdOpInstr::Create(
+        MethodRecognizer::kFloat64x2Splat, new (zone()) Value(def),
+        DeoptId::kNone));
+    vector_defs_[def->ssa_temp_index()] = vector;
+  }
+  return new (zone()) Value(vector);
+}
+
+Value* CountedLoopVectorizer::ArrayOperand(Value* array) {
+  Definition* def = array->definition();
+  Definition* copy = vector_defs_[def->ssa_temp_index()];
+  return new (zone()) Value(copy != nullptr ? copy : def);
+}
+
+void CountedLoopVectorizer::Emit(Definition* original,
+                                 Definition* replacement) {
+  flow_graph_->AllocateSSAIndex(replacement);
+  cursor_ = cursor_->AppendInstruction(replacement);
+  vector_defs_[original->ssa_temp_index()] = replacement;
+}
+
+void CountedLoopVectorizer::Emit(Instruction* instr) {
+  cursor_ = cursor_->AppendInstruction(instr);
+}
+
+void CountedLoopVectorizer::VectorizeBodyInstruction(Instruction* current) {
+  if (auto check = current->AsCheckNull()) {
+    Emit(check, new (zone()) CheckNullInstr(
+                    ArrayOperand(check->value()), check->function_name(),
+                    check->deopt_id(), check->source(),
+                    check->exception_type()));
+  } else if (auto check = current->AsCheckWritable()) {
+    Emit(check, new (zone()) CheckWritableInstr(
+                    ArrayOperand(check->value()), check->deopt_id(),
+                    check->source(), check->kind()));
+  } else if (auto load = current->AsLoadIndexed()) {
+    Emit(load, new (zone()) LoadIndexedInstr(
+                   ArrayOperand(load->array()),
+                   new (zone()) Value(vector_induction_),
+                   /*index_unboxed=*/true, load->index_scale(),
+                   kTypedDataFloat64x2ArrayCid, kAlignedAccess,
+                   DeoptId::kNone, load->source()));
+  } else if (auto store = current->AsStoreIndexed()) {
+    Emit(new (zone()) StoreIndexedInstr(
+        ArrayOperand(store->array()), new (zone()) Value(vector_induction_),
+        VectorOperand(store->value()), kNoStoreBarrier,
+        /*index_unboxed=*/true, store->index_scale(),
+        kTypedDataFloat64x2ArrayCid, kAlignedAccess, DeoptId::kNone,
+        store->source()));
+  } else if (auto op = current->AsBinaryDoubleOp()) {
+    SimdOpInstr::Kind kind = SimdOpInstr::kIllegalSimdOp;
+    switch (op->op_kind()) {
+      case Token::kADD:
+        kind = SimdOpInstr::kFloat64x2Add;
+        break;
+      case Token::kSUB:
+        kind = SimdOpInstr::kFloat64x2Sub;
+        break;
+      case Token::kMUL:
+        kind = SimdOpInstr::kFloat64x2Mul;
+        break;
+      case Token::kDIV:
+        kind = SimdOpInstr::kFloat64x2Div;
+        break;
+      default:
+        UNREACHABLE();
+    }
+    Emit(op, SimdOpInstr::Create(kind, VectorOperand(op->left()),
+                                 VectorOperand(op->right()), DeoptId::kNone));
+  } else if (auto op = current->AsUnaryDoubleOp()) {
+    switch (op->op_kind()) {
+      case Token::kNEGATE:
+        Emit(op, SimdOpInstr::Create(MethodRecognizer::kFloat64x2Negate,
+                                     VectorOperand(op->value()),
+                                     DeoptId::kNone));
+        break;
+      case Token::kSQRT:
+        Emit(op, SimdOpInstr::Create(MethodRecognizer::kFloat64x2Sqrt,
+                                     VectorOperand(op->value()),
+                                     DeoptId::kNone));
+        break;
+      case Token::kSQUARE:
+        Emit(op, SimdOpInstr::Create(
+                     SimdOpInstr::kFloat64x2Mul, VectorOperand(op->value()),
+                     VectorOperand(op->value()), DeoptId::kNone));
+        break;
+      default:
+        UNREACHABLE();
+    }
+  } else {
+    ASSERT(current->IsBoxInt64() || current->IsGoto() ||
+           (current == increment_));
+  }
+}
+
+void CountedLoopVectorizer::Transform() {
+  vector_defs_.EnsureLength(flow_graph_->current_ssa_temp_index(), nullptr);
+  pre_header_goto_ = pre_header_->last_instruction()->AsGoto();
+
+  // Number of elements processed by the vector loop.
+  Definition* mask = IntConstant(-kLanes);
+  if (!guarded_arrays_.is_empty()) {
+    mask = EmitGuard(mask);
+  }
+  Definition* vector_limit = EmitIntOp(
+      Token::kADD, start_,
+      EmitIntOp(Token::kBIT_AND, EmitIntOp(Token::kSUB, limit_, start_),
+                mask));
+
+  const intptr_t try_index = header_->try_index();
+  auto vector_header = new (zone()) JoinEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  auto vector_body = new (zone()) TargetEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  auto vector_exit = new (zone()) TargetEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  pre_header_goto_->set_successor(vector_header);
+
+  // The pre-header is discovered before the back edge, so it becomes the
+  // first predecessor of the vector header.
+  vector_induction_ = flow_graph_->AddPhi(vector_header, start_, start_);
+  vector_induction_->set_representation(kUnboxedInt64);
+
+  cursor_ = vector_header;
+  if (stack_overflow_check_ != nullptr) {
+    Emit(new (zone()) CheckStackOverflowInstr(
+        stack_overflow_check_->source(), stack_overflow_check_->stack_depth(),
+        stack_overflow_check_->loop_depth(), stack_overflow_check_->deopt_id(),
+        CheckStackOverflowInstr::kOsrAndPreemption));
+  }
+  auto compare = new (zone()) RelationalOpInstr(
+      branch_->condition()->source(), Token::kLT,
+      new (zone()) Value(vector_induction_), new (zone()) Value(vector_limit),
+      kUnboxedInt64, DeoptId::kNone);
+  auto branch = new (zone()) BranchInstr(compare, DeoptId::kNone);
+  Emit(branch);
+  vector_header->set_last_instruction(branch);
+  *branch->true_successor_address() = vector_body;
+  *branch->false_successor_address() = vector_exit;
+
+  cursor_ = vector_body;
+  for (ForwardInstructionIterator it(body_); !it.Done(); it.Advance()) {
+    VectorizeBodyInstruction(it.Current());
+  }
+  auto next = new (zone()) BinaryInt64OpInstr(
+      Token::kADD, new (zone()) Value(vector_induction_),
+      new (zone()) Value(IntConstant(kLanes)), DeoptId::kNone);
+  flow_graph_->AllocateSSAIndex(next);
+  Emit(next);
+  vector_induction_->InputAt(1)->BindTo(next);
+  auto back_edge = new (zone()) GotoInstr(vector_header, DeoptId::kNone);
+  Emit(back_edge);
+  vector_body->set_last_instruction(back_edge);
+
+  // The scalar loop continues from where the vector loop stopped.
+  auto exit_goto = new (zone()) GotoInstr(header_, DeoptId::kNone);
+  vector_exit->AppendInstruction(exit_goto);
+  vector_exit->set_last_instruction(exit_goto);
+  induction_->InputAt(pre_header_index_)->BindTo(vector_induction_);
+
+  if (FLAG_trace_loop_vectorization) {
+    THR_Print("Vectorized loop at B%" Pd " in %s\n", header_->block_id(),
+              flow_graph_->function().ToFullyQualifiedCString());
+  }
+}
+
+void LoopVectorizer::Optimize(FlowGraph* flow_graph) {
+  // Vector accesses use the int64 induction variable as an unboxed intptr
+  // index.
+  if (!FLAG_loop_vectorization || (kUnboxedIntPtr != kUnboxedInt64) ||
+      !FlowGraphCompiler::SupportsUnboxedSimd128()) {
+    return;
+  }
+
+  const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+  const ZoneGrowableArray<BlockEntryInstr*>& loop_headers =
+      loop_hierarchy.headers();
+  loop_hierarchy.ComputeInduction();
+
+  GrowableArray<CountedLoopVectorizer*> loops;
+  for (intptr_t i = 0; i < loop_headers.length(); ++i) {
+    auto loop = new (flow_graph->zone())
+        CountedLoopVectorizer(flow_graph, loop_headers[i]->loop_info());
+    if (loop->Analyze()) {
+      loops.Add(loop);
+    }
+  }
+  if (loops.is_empty()) return;
+
+  for (intptr_t i = 0; i < loops.length(); ++i) {
+    loops[i]->Transform();
+  }
+
+  // We have changed the block order and the dominator tree.
+  flow_graph->DiscoverBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph->ComputeDominators(&dominance_frontier);
+}
+
+}  // namespace dart
@@ -0,0 +1,137 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, loop_vectorization);
+
+#if defined(DART_PRECOMPILER) && defined(TARGET_ARCH_IS_64_BIT)
+
+struct VectorizedInstructions {
+  intptr_t loads = 0;
+  intptr_t stores = 0;
+  intptr_t simd_ops = 0;
+  intptr_t class_id_checks = 0;
+};
+
+static VectorizedInstructions CountVectorizedInstructions(
+    FlowGraph* flow_graph) {
+  VectorizedInstructions result;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* current = it.Current();
+      if (auto load = current->AsLoadIndexed()) {
+        if (load->class_id() == kTypedDataFloat64x2ArrayCid) result.loads++;
+      } else if (auto store = current->AsStoreIndexed()) {
+        if (store->class_id() == kTypedDataFloat64x2ArrayCid) result.stores++;
+      } else if (current->IsSimdOp()) {
+        result.simd_ops++;
+      } else if (current->IsLoadClassId()) {
+        result.class_id_checks++;
+      }
+    }
+  }
+  return result;
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_LoopVectorizer_SingleArray) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  SetFlagScope<bool> sfs(&FLAG_loop_vectorization, true);
+
+  const char* kScript = R"(
+    import 'dart:typed_data';
+
+    void scale(Float64List list, double factor) {
+      for (int i = 0; i < list.length; i++) {
+        list[i] = list[i] * factor;
+      }
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "scale"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  const auto counts = CountVectorizedInstructions(flow_graph);
+  EXPECT_EQ(1, counts.loads);
+  EXPECT_EQ(1, counts.stores);
+  // Splat of [factor] and the multiplication.
+  EXPECT_EQ(2, counts.simd_ops);
+  // The same array is loaded and stored, so no guard is needed.
+  EXPECT_EQ(0, counts.class_id_checks);
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_LoopVectorizer_DistinctArrays) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  SetFlagScope<bool> sfs(&FLAG_loop_vectorization, true);
+
+  const char* kScript = R"(
+    import 'dart:typed_data';
+
+    @pragma('vm:unsafe:no-bounds-checks')
+    void add(Float64List dst, Float64List a, Float64List b) {
+      final n = dst.length;
+      for (int i = 0; i < n; i++) {
+        dst[i] = a[i] + b[i];
+      }
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "add"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  const auto counts = CountVectorizedInstructions(flow_graph);
+  EXPECT_EQ(2, counts.loads);
+  EXPECT_EQ(1, counts.stores);
+  EXPECT_EQ(1, counts.simd_ops);
+  // Any of the arrays could be a view, so the vector loop is guarded by
+  // class id checks.
+  EXPECT_EQ(3, counts.class_id_checks);
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_LoopVectorizer_Reduction) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  SetFlagScope<bool> sfs(&FLAG_loop_vectorization, true);
+
+  // Reassociating the sum would change rounding, so the loop is left alone.
+  const char* kScript = R"(
+    import 'dart:typed_data';
+
+    double sum(Float64List list) {
+      double result = 0.0;
+      for (int i = 0; i < list.length; i++) {
+        result += list[i];
+      }
+      return result;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "sum"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  const auto counts = CountVectorizedInstructions(flow_graph);
+  EXPECT_EQ(0, counts.loads);
+  EXPECT_EQ(0, counts.simd_ops);
+}
+
+#endif  // defined(DART_PRECOMPILER) && defined(TARGET_ARCH_IS_64_BIT)
+
+}  // namespace dart
@@ -0,0 +1,604 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_versioning.h"
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/compiler/backend/range_analysis.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_versioning,
+            false,
+            "Run counted loops without bounds checks for as long as the "
+            "checks are known to succeed.");
+DEFINE_FLAG(int,
+            loop_unrolling_max_size,
+            0,
+            "Unroll loops without bounds checks twice if their body has at "
+            "most this many instructions.");
+DEFINE_FLAG(bool, trace_loop_versioning, false, "Trace loop versioning.");
+
+// Bounds on the induction variable stride and the constant index offsets,
+// which guarantee that computing the limit of the checked-free loop can't
+// overflow.
+static constexpr int64_t kMaxStride = 1 << 20;
+static constexpr int64_t kMaxOffset = 1 << 20;
+
+// Versions a single counted loop of the form
+//
+//   for (int i = start; i < limit; i += stride) {
+//     ... GenericCheckBound(length, i + offset) ...
+//   }
+//
+// where [length] is loop invariant and the header H is the only block with
+// a successor outside of the loop. A copy of the loop with these bounds
+// checks turned into phantom checks is inserted in front of it:
+//
+//        P                   P: fast_limit = min(limit, length - offset, ...)
+//        |                   |
+//   +--> H --> exit     +--> FH --> FX --> H --> exit
+//   |    |              |    |             ^ |
+//   +--- B...           +--- FB...         +-B...
+//
+// The copy only runs while i < fast_limit, which guarantees that the
+// removed checks succeed as start >= 0. The original loop continues from
+// where the copy stopped and throws if one of the checks fails.
+//
+// If the copy is unrolled, its body is duplicated and it runs while
+// i < fast_limit - stride instead.
+class CountedLoopVersioner : public ZoneAllocated {
+ public:
+  CountedLoopVersioner(FlowGraph* flow_graph, LoopInfo* loop)
+      : flow_graph_(flow_graph), loop_(loop) {}
+
+  // Returns true if the loop can be versioned.
+  bool Analyze();
+
+  // Inserts the copy of the loop. The caller must recompute the block order
+  // and dominators afterwards.
+  void Transform();
+
+ private:
+  struct Bound {
+    Definition* length;
+    int64_t offset;
+  };
+
+  Zone* zone() const { return flow_graph_->zone(); }
+
+  bool IsLoopInvariant(Definition* def) const {
+    return !loop_->Contains(def->GetBlock());
+  }
+
+  bool AnalyzeHeader();
+  bool AnalyzeBody();
+  static bool IsCopyable(Instruction* current);
+  void TryRemoveCheck(GenericCheckBoundInstr* check);
+
+  ConstantInstr* IntConstant(int64_t value) const;
+  Definition* EmitInPreHeader(Definition* def);
+  Definition* EmitIntOp(Token::Kind op_kind,
+                        Definition* left,
+                        Definition* right);
+  Definition* EmitMin(Definition* left, Definition* right);
+
+  Value* CopyOperand(Value* value) const;
+  JoinEntryInstr* CopyOf(JoinEntryInstr* block, JoinEntryInstr* next) const;
+  TargetEntryInstr* CopyOf(TargetEntryInstr* block) const;
+  Instruction* CopyInstruction(Instruction* current, JoinEntryInstr* next);
+  void CopyDefinition(Definition* original, Definition* copy);
+  PhiInstr* CopyPhi(PhiInstr* phi, JoinEntryInstr* join);
+  // Copies the loop body starting at [entry]. The back edge of the copy
+  // jumps to [next].
+  void CopyBody(BlockEntryInstr* entry, JoinEntryInstr* next);
+
+  FlowGraph* const flow_graph_;
+  LoopInfo* const loop_;
+
+  JoinEntryInstr* header_ = nullptr;
+  BlockEntryInstr* pre_header_ = nullptr;
+  BlockEntryInstr* latch_ = nullptr;
+  PhiInstr* induction_ = nullptr;
+  int64_t stride_ = 0;
+  Definition* start_ = nullptr;
+  Definition* limit_ = nullptr;
+  CheckStackOverflowInstr* stack_overflow_check_ = nullptr;
+  BranchInstr* branch_ = nullptr;
+  TargetEntryInstr* body_entry_ = nullptr;
+
+  // Blocks of the loop except the header in reverse postorder.
+  GrowableArray<BlockEntryInstr*> body_;
+  intptr_t body_size_ = 0;
+  bool unroll_ = false;
+
+  // Bounds checks which always succeed if i < fast_limit and the bounds
+  // they imply on the induction variable.
+  GrowableArray<GenericCheckBoundInstr*> removed_checks_;
+  GrowableArray<Bound> bounds_;
+
+  // State of the transformation. Copies of blocks are indexed by preorder
+  // number and copies of definitions by ssa_temp_index.
+  GotoInstr* pre_header_goto_ = nullptr;
+  GrowableArray<BlockEntryInstr*> block_copies_;
+  GrowableArray<Definition*> def_copies_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountedLoopVersioner);
+};
+
+bool CountedLoopVersioner::Analyze() {
+  if (loop_->inner() != nullptr) return false;
+
+  header_ = loop_->header()->AsJoinEntry();
+  if ((header_ == nullptr) || header_->InsideTryBlock() ||
+      (header_->PredecessorCount() != 2) ||
+      (loop_->back_edges().length() != 1)) {
+    return false;
+  }
+  // Copies of the header phis take the input from the pre-header first.
+  latch_ = loop_->back_edges()[0];
+  pre_header_ = header_->PredecessorAt(0);
+  if ((pre_header_ == latch_) || !pre_header_->last_instruction()->IsGoto()) {
+    return false;
+  }
+  return AnalyzeHeader() && AnalyzeBody();
+}
+
+bool CountedLoopVersioner::AnalyzeHeader() {
+  for (ForwardInstructionIterator it(header_); !it.Done(); it.Advance()) {
+    Instruction* current = it.Current();
+    if (auto check = current->AsCheckStackOverflow()) {
+      if (stack_overflow_check_ != nullptr) return false;
+      stack_overflow_check_ = check;
+    } else if (!current->IsBranch()) {
+      return false;
+    }
+  }
+  branch_ = header_->last_instruction()->AsBranch();
+  if ((branch_ == nullptr) ||
+      !loop_->Contains(branch_->true_successor()) ||
+      loop_->Contains(branch_->false_successor())) {
+    return false;
+  }
+  body_entry_ = branch_->true_successor();
+
+  auto compare = branch_->condition()->AsRelationalOp();
+  if ((compare == nullptr) ||
+      (compare->input_representation() != kUnboxedInt64)) {
+    return false;
+  }
+  Definition* induction = nullptr;
+  if (compare->kind() == Token::kLT) {
+    induction = compare->left()->definition();
+    limit_ = compare->right()->definition();
+  } else if (compare->kind() == Token::kGT) {
+    induction = compare->right()->definition();
+    limit_ = compare->left()->definition();
+  } else {
+    return false;
+  }
+  induction_ = induction->AsPhi();
+  if ((induction_ == nullptr) || (induction_->block() != header_) ||
+      !IsLoopInvariant(limit_)) {
+    return false;
+  }
+  if (!InductionVar::IsLinear(loop_->LookupInduction(induction_), &stride_) ||
+      (stride_ <= 0) || (stride_ > kMaxStride)) {
+    return false;
+  }
+  start_ = induction_->InputAt(0)->definition();
+  return RangeUtils::IsWithin(start_->range(), 0, kMaxInt64);
+}
+
+bool CountedLoopVersioner::AnalyzeBody() {
+  const auto& reverse_postorder = flow_graph_->reverse_postorder();
+  for (intptr_t i = 0; i < reverse_postorder.length(); ++i) {
+    BlockEntryInstr* block = reverse_postorder[i];
+    if ((block == header_) || !loop_->Contains(block)) continue;
+    if (!block->IsTargetEntry() && !block->IsJoinEntry()) return false;
+    body_.Add(block);
+
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      if (!IsCopyable(current)) {
+        if (FLAG_trace_loop_versioning) {
+          THR_Print("Loop at B%" Pd " not versioned: %s\n",
+                    header_->block_id(), current->ToCString());
+        }
+        return false;
+      }
+      if (auto check = current->AsGenericCheckBound()) {
+        TryRemoveCheck(check);
+      }
+      body_size_++;
+    }
+    // The only exit of the loop is the header.
+    Instruction* last = block->last_instruction();
+    for (intptr_t j = 0; j < last->SuccessorCount(); j++) {
+      BlockEntryInstr* successor = last->SuccessorAt(j);
+      if (!loop_->Contains(successor) ||
+          ((successor == header_) && (block != latch_))) {
+        return false;
+      }
+    }
+  }
+  if (removed_checks_.is_empty()) return false;
+
+  // Unrolling computes fast_limit - stride, which needs a lower bound on
+  // the limit.
+  unroll_ = (body_size_ <= FLAG_loop_unrolling_max_size) &&
+            RangeUtils::IsWithin(limit_->range(), 0, kMaxInt64);
+  return true;
+}
+
+bool CountedLoopVersioner::IsCopyable(Instruction* current) {
+  if (auto branch = current->AsBranch()) {
+    ConditionInstr* condition = branch->condition();
+    return condition->IsEqualityCompare() || condition->IsRelationalOp() ||
+           condition->IsStrictCompare() || condition->IsTestInt();
+  }
+  return current->IsGoto() || current->IsBinaryInt64Op() ||
+         current->IsUnaryInt64Op() || current->IsBoxInt64() ||
+         current->IsUnboxInt64() || current->IsIntConverter() ||
+         current->IsGenericCheckBound() || current->IsLoadIndexed() ||
+         current->IsStoreIndexed() || current->IsEqualityCompare() ||
+         current->IsRelationalOp() || current->IsStrictCompare() ||
+         current->IsTestInt();
+}
+
+void CountedLoopVersioner::TryRemoveCheck(GenericCheckBoundInstr* check) {
+  Definition* length = check->length()->definition();
+  if (check->IsPhantom() || !IsLoopInvariant(length)) return;
+
+  Definition* index = check->index()->definition();
+  int64_t offset = 0;
+  if (auto add = index->AsBinaryInt64Op()) {
+    if ((add->op_kind() != Token::kADD) ||
+        !add->right()->BindsToSmiConstant()) {
+      return;
+    }
+    offset = add->right()->BoundSmiConstant();
+    index = add->left()->definition();
+  }
+  if ((index != induction_) || (offset < 0) || (offset > kMaxOffset)) return;
+
+  removed_checks_.Add(check);
+  for (intptr_t i = 0; i < bounds_.length(); ++i) {
+    if (bounds_[i].length == length) {
+      bounds_[i].offset = Utils::Maximum(bounds_[i].offset, offset);
+      return;
+    }
+  }
+  bounds_.Add({length, offset});
+}
+
+ConstantInstr* CountedLoopVersioner::IntConstant(int64_t value) const {
+  return flow_graph_->GetConstant(Smi::ZoneHandle(zone(), Smi::New(value)),
+                                  kUnboxedInt64);
+}
+
+Definition* CountedLoopVersioner::EmitInPreHeader(Definition* def) {
+  flow_graph_->InsertBefore(pre_header_goto_, def, nullptr, FlowGraph::kValue);
+  return def;
+}
+
+Definition* CountedLoopVersioner::EmitIntOp(Token::Kind op_kind,
+                                            Definition* left,
+                                            Definition* right) {
+  return EmitInPreHeader(new (zone()) BinaryInt64OpInstr(
+      op_kind, new (zone()) Value(left), new (zone()) Value(right),
+      DeoptId::kNone));
+}
+
+Definition* CountedLoopVersioner::EmitMin(Definition* left,
+                                          Definition* right) {
+  return EmitInPreHeader(new (zone()) MathMinMaxInstr(
+      MethodRecognizer::kMathMin, new (zone()) Value(left),
+      new (zone()) Value(right), DeoptId::kNone, kUnboxedInt64));
+}
+
+Value* CountedLoopVersioner::CopyOperand(Value* value) const {
+  Definition* def = value->definition();
+  if (def->HasSSATemp() && (def_copies_[def->ssa_temp_index()] != nullptr)) {
+    def = def_copies_[def->ssa_temp_index()];
+  }
+  return new (zone()) Value(def);
+}
+
+JoinEntryInstr* CountedLoopVersioner::CopyOf(JoinEntryInstr* block,
+                                             JoinEntryInstr* next) const {
+  return (block == header_)
+             ? next
+             : block_copies_[block->preorder_number()]->AsJoinEntry();
+}
+
+TargetEntryInstr* CountedLoopVersioner::CopyOf(
+    TargetEntryInstr* block) const {
+  return block_copies_[block->preorder_number()]->AsTargetEntry();
+}
+
+Instruction* CountedLoopVersioner::CopyInstruction(Instruction* current,
+                                                   JoinEntryInstr* next) {
+  if (auto goto_instr = current->AsGoto()) {
+    return new (zone())
+        GotoInstr(CopyOf(goto_instr->successor(), next), DeoptId::kNone);
+  }
+  if (auto branch = current->AsBranch()) {
+    ConditionInstr* condition = branch->condition();
+    auto copy = new (zone()) BranchInstr(
+        condition->CopyWithNewOperands(CopyOperand(condition->InputAt(0)),
+                                       CopyOperand(condition->InputAt(1))),
+        DeoptId::kNone);
+    *copy->true_successor_address() = CopyOf(branch->true_successor());
+    *copy->false_successor_address() = CopyOf(branch->false_successor());
+    return copy;
+  }
+  if (auto compare = current->AsCondition()) {
+    return compare->CopyWithNewOperands(CopyOperand(compare->InputAt(0)),
+                                        CopyOperand(compare->InputAt(1)));
+  }
+  if (auto op = current->AsBinaryInt64Op()) {
+    return new (zone())
+        BinaryInt64OpInstr(op->op_kind(), CopyOperand(op->left()),
+                           CopyOperand(op->right()), DeoptId::kNone);
+  }
+  if (auto op = current->AsUnaryInt64Op()) {
+    return new (zone()) UnaryInt64OpInstr(
+        op->op_kind(), CopyOperand(op->value()), DeoptId::kNone);
+  }
+  if (auto box = current->AsBoxInt64()) {
+    return new (zone()) BoxInt64Instr(CopyOperand(box->value()));
+  }
+  if (auto unbox = current->AsUnboxInt64()) {
+    return new (zone()) UnboxInt64Instr(CopyOperand(unbox->value()),
+                                        DeoptId::kNone, unbox->value_mode());
+  }
+  if (auto conversion = current->AsIntConverter()) {
+    return new (zone())
+        IntConverterInstr(conversion->from(), conversion->to(),
+                          CopyOperand(conversion->value()));
+  }
+  if (auto check = current->AsGenericCheckBound()) {
+    const bool is_phantom =
+        check->IsPhantom() || removed_checks_.Contains(check);
+    return new (zone()) GenericCheckBoundInstr(
+        CopyOperand(check->length()), CopyOperand(check->index()),
+        check->deopt_id(),
+        is_phantom ? GenericCheckBoundInstr::Mode::kPhantom
+                   : GenericCheckBoundInstr::Mode::kReal);
+  }
+  if (auto load = current->AsLoadIndexed()) {
+    return new (zone()) LoadIndexedInstr(
+        CopyOperand(load->array()), CopyOperand(load->index()),
+        load->RequiredInputRepresentation(LoadIndexedInstr::kIndexPos) ==
+            kUnboxedIntPtr,
+        load->index_scale(), load->class_id(),
+        load->aligned() ? kAlignedAccess : kUnalignedAccess, DeoptId::kNone,
+        load->source(), load->result_type());
+  }
+  if (auto store = current->AsStoreIndexed()) {
+    return new (zone()) StoreIndexedInstr(
+        CopyOperand(store->array()), CopyOperand(store->index()),
+        CopyOperand(store->value()),
+        store->ShouldEmitStoreBarrier() ? kEmitStoreBarrier : kNoStoreBarrier,
+        store->RequiredInputRepresentation(StoreIndexedInstr::kIndexPos) ==
+            kUnboxedIntPtr,
+        store->index_scale(), store->class_id(),
+        store->aligned() ? kAlignedAccess : kUnalignedAccess, DeoptId::kNone,
+        store->source());
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
+void CountedLoopVersioner::CopyDefinition(Definition* original,
+                                          Definition* copy) {
+  flow_graph_->AllocateSSAIndex(copy);
+  // The copy executes a prefix of the iterations of the original loop, so
+  // the range of the original still applies.
+  if (original->range() != nullptr) {
+    copy->set_range(*original->range());
+  }
+  def_copies_.EnsureLength(flow_graph_->current_ssa_temp_index(), nullptr);
+  def_copies_[original->ssa_temp_index()] = copy;
+}
+
+PhiInstr* CountedLoopVersioner::CopyPhi(PhiInstr* phi, JoinEntryInstr* join) {
+  auto copy = new (zone()) PhiInstr(join, phi->InputCount());
+  copy->mark_alive();
+  copy->set_representation(phi->representation());
+  for (intptr_t i = 0; i < phi->InputCount(); ++i) {
+    Value* input = CopyOperand(phi->InputAt(i));
+    copy->SetInputAt(i, input);
+    input->definition()->AddInputUse(input);
+  }
+  join->InsertPhi(copy);
+  CopyDefinition(phi, copy);
+  return copy;
+}
+
+void CountedLoopVersioner::CopyBody(BlockEntryInstr* entry,
+                                    JoinEntryInstr* next) {
+  const intptr_t try_index = header_->try_index();
+  for (BlockEntryInstr* block : body_) {
+    BlockEntryInstr* copy = entry;
+    if (block != body_entry_) {
+      if (block->IsJoinEntry()) {
+        copy = new (zone()) JoinEntryInstr(flow_graph_->allocate_block_id(),
+                                           try_index, DeoptId::kNone);
+      } else {
+        copy = new (zone()) TargetEntryInstr(
+            flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+      }
+    }
+    block_copies_[block->preorder_number()] = copy;
+  }
+
+  // Blocks are visited in reverse postorder and the body contains no back
+  // edges, so all operands are copied before their uses.
+  for (BlockEntryInstr* block : body_) {
+    BlockEntryInstr* copy = block_copies_[block->preorder_number()];
+    if (auto join = block->AsJoinEntry()) {
+      for (PhiIterator it(join); !it.Done(); it.Advance()) {
+        CopyPhi(it.Current(), copy->AsJoinEntry());
+      }
+    }
+    Instruction* cursor = copy;
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      Instruction* instr = CopyInstruction(current, next);
+      if (auto def = current->AsDefinition()) {
+        if (def->HasSSATemp()) {
+          CopyDefinition(def, instr->AsDefinition());
+        }
+      }
+      cursor = cursor->AppendInstruction(instr);
+    }
+    copy->set_last_instruction(cursor);
+  }
+}
+
+void CountedLoopVersioner::Transform() {
+  def_copies_.EnsureLength(flow_graph_->current_ssa_temp_index(), nullptr);
+  block_copies_.EnsureLength(flow_graph_->preorder().length(), nullptr);
+  pre_header_goto_ = pre_header_->last_instruction()->AsGoto();
+
+  // i + offset < length for all removed checks if i < length - offset.
+  Definition* fast_limit = limit_;
+  for (const Bound& bound : bounds_) {
+    Definition* length = bound.length;
+    if (bound.offset != 0) {
+      length = EmitIntOp(Token::kSUB, length, IntConstant(bound.offset));
+    }
+    fast_limit = EmitMin(fast_limit, length);
+  }
+  // An unrolled iteration also executes the body for i + stride.
+  if (unroll_) {
+    fast_limit = EmitIntOp(Token::kSUB, fast_limit, IntConstant(stride_));
+  }
+
+  const intptr_t try_index = header_->try_index();
+  auto fast_header = new (zone()) JoinEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  auto fast_body = new (zone()) TargetEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  auto fast_exit = new (zone()) TargetEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  pre_header_goto_->set_successor(fast_header);
+
+  // The pre-header is discovered before the back edge, so it stays the
+  // first predecessor of both headers. The back edge inputs are filled in
+  // once the body has been copied.
+  GrowableArray<PhiInstr*> header_phis;
+  GrowableArray<PhiInstr*> fast_phis;
+  for (PhiIterator it(header_); !it.Done(); it.Advance()) {
+    PhiInstr* phi = it.Current();
+    PhiInstr* copy = flow_graph_->AddPhi(fast_header,
+                                         phi->InputAt(0)->definition(),
+                                         phi->InputAt(0)->definition());
+    copy->set_representation(phi->representation());
+    if (phi->range() != nullptr) {
+      copy->set_range(*phi->range());
+    }
+    def_copies_[phi->ssa_temp_index()] = copy;
+    header_phis.Add(phi);
+    fast_phis.Add(copy);
+  }
+
+  Instruction* cursor = fast_header;
+  if (stack_overflow_check_ != nullptr) {
+    cursor = cursor->AppendInstruction(new (zone()) CheckStackOverflowInstr(
+        stack_overflow_check_->source(), stack_overflow_check_->stack_depth(),
+        stack_overflow_check_->loop_depth(), stack_overflow_check_->deopt_id(),
+        CheckStackOverflowInstr::kOsrAndPreemption));
+  }
+  auto compare = new (zone()) RelationalOpInstr(
+      branch_->condition()->source(), Token::kLT,
+      new (zone()) Value(def_copies_[induction_->ssa_temp_index()]),
+      new (zone()) Value(fast_limit), kUnboxedInt64, DeoptId::kNone);
+  auto branch = new (zone()) BranchInstr(compare, DeoptId::kNone);
+  cursor = cursor->AppendInstruction(branch);
+  fast_header->set_last_instruction(branch);
+  *branch->true_successor_address() = fast_body;
+  *branch->false_successor_address() = fast_exit;
+
+  if (unroll_) {
+    // The second copy is entered from the back edge of the first one.
+    auto unrolled_body = new (zone()) JoinEntryInstr(
+        flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+    CopyBody(fast_body, unrolled_body);
+
+    // Header phis of the second copy are the back edge values of the first.
+    GrowableArray<Definition*> next_values;
+    for (PhiInstr* phi : header_phis) {
+      next_values.Add(CopyOperand(phi->InputAt(1))->definition());
+    }
+    for (intptr_t i = 0; i < header_phis.length(); ++i) {
+      def_copies_[header_phis[i]->ssa_temp_index()] = next_values[i];
+    }
+    CopyBody(unrolled_body, fast_header);
+  } else {
+    CopyBody(fast_body, fast_header);
+  }
+  for (intptr_t i = 0; i < header_phis.length(); ++i) {
+    fast_phis[i]->InputAt(1)->BindTo(
+        CopyOperand(header_phis[i]->InputAt(1))->definition());
+  }
+
+  // The original loop continues from where the copy stopped and executes
+  // the remaining checks.
+  auto exit_goto = new (zone()) GotoInstr(header_, DeoptId::kNone);
+  fast_exit->AppendInstruction(exit_goto);
+  fast_exit->set_last_instruction(exit_goto);
+  for (intptr_t i = 0; i < header_phis.length(); ++i) {
+    header_phis[i]->InputAt(0)->BindTo(fast_phis[i]);
+  }
+
+  if (FLAG_trace_loop_versioning) {
+    THR_Print("Versioned loop at B%" Pd " in %s: %" Pd
+              " bounds checks removed%s\n",
+              header_->block_id(),
+              flow_graph_->function().ToFullyQualifiedCString(),
+              removed_checks_.length(), unroll_ ? ", unrolled" : "");
+  }
+}
+
+void LoopVersioning::Optimize(FlowGraph* flow_graph) {
+  // Bounds checks operate on unboxed int64 values only on 64-bit targets.
+  if (!FLAG_loop_versioning ||
+      !GenericCheckBoundInstr::UseUnboxedRepresentation()) {
+    return;
+  }
+
+  const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+  const ZoneGrowableArray<BlockEntryInstr*>& loop_headers =
+      loop_hierarchy.headers();
+  loop_hierarchy.ComputeInduction();
+
+  GrowableArray<CountedLoopVersioner*> loops;
+  for (intptr_t i = 0; i < loop_headers.length(); ++i) {
+    auto loop = new (flow_graph->zone())
+        CountedLoopVersioner(flow_graph, loop_headers[i]->loop_info());
+    if (loop->Analyze()) {
+      loops.Add(loop);
+    }
+  }
+  if (loops.is_empty()) return;
+
+  for (intptr_t i = 0; i < loops.length(); ++i) {
+    loops[i]->Transform();
+  }
+
+  // We have changed the block order and the dominator tree.
+  flow_graph->DiscoverBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph->ComputeDominators(&dominance_frontier);
+}
+
+}  // namespace dart
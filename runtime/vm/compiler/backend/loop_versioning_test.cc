@@ -0,0 +1,114 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, loop_versioning);
+DECLARE_FLAG(int, loop_unrolling_max_size);
+
+#if defined(DART_PRECOMPILER) && defined(TARGET_ARCH_IS_64_BIT)
+
+struct VersionedInstructions {
+  intptr_t bounds_checks = 0;
+  intptr_t loads = 0;
+};
+
+static VersionedInstructions CountVersionedInstructions(
+    FlowGraph* flow_graph) {
+  VersionedInstructions result;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* current = it.Current();
+      if (auto check = current->AsGenericCheckBound()) {
+        if (!check->IsPhantom()) result.bounds_checks++;
+      } else if (current->IsLoadIndexed()) {
+        result.loads++;
+      }
+    }
+  }
+  return result;
+}
+
+static const char* kCountZerosScript = R"(
+    import 'dart:typed_data';
+
+    int countZeros(Uint8List list, int n) {
+      int count = 0;
+      for (int i = 0; i < n; i++) {
+        if (list[i] == 0) count++;
+      }
+      return count;
+    }
+  )";
+
+ISOLATE_UNIT_TEST_CASE(IRTest_LoopVersioning_BoundsCheck) {
+  SetFlagScope<bool> sfs(&FLAG_loop_versioning, true);
+
+  const auto& root_library = Library::Handle(LoadTestScript(kCountZerosScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "countZeros"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  const auto counts = CountVersionedInstructions(flow_graph);
+  // Only the original loop, which runs once [n] exceeds the length of the
+  // list, checks the index.
+  EXPECT_EQ(1, counts.bounds_checks);
+  EXPECT_EQ(2, counts.loads);
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_LoopVersioning_Unrolled) {
+  SetFlagScope<bool> sfs(&FLAG_loop_versioning, true);
+  SetFlagScope<int> sfs_unroll(&FLAG_loop_unrolling_max_size, 32);
+
+  // [n] must be known to be non-negative to unroll the loop.
+  const char* kScript = R"(
+    import 'dart:typed_data';
+
+    int countZeros(Uint8List list) {
+      int count = 0;
+      for (int i = 0; i < list.length; i++) {
+        if (list[i] == 0) count++;
+      }
+      return count;
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "countZeros"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  const auto counts = CountVersionedInstructions(flow_graph);
+  EXPECT_EQ(1, counts.bounds_checks);
+  EXPECT_EQ(3, counts.loads);
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_LoopVersioning_Disabled) {
+  const auto& root_library = Library::Handle(LoadTestScript(kCountZerosScript));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "countZeros"));
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  const auto counts = CountVersionedInstructions(flow_graph);
+  EXPECT_EQ(1, counts.bounds_checks);
+  EXPECT_EQ(1, counts.loads);
+}
+
+#endif  // defined(DART_PRECOMPILER) && defined(TARGET_ARCH_IS_64_BIT)
+
+}  // namespace dart
@@ -2976,6 +2976,53 @@ void IfThenElseInstr::InferRange(RangeAnalysis* analysis, Range* range) {
       Range(RangeBoundary::FromConstant(min), RangeBoundary::FromConstant(max));
 }
 
+// Converts a loop invariant bound computed by induction analysis into a range
+// boundary. Only constants and array lengths with an offset are supported.
+static bool InductionBoundaryToRangeBoundary(InductionVar* x,
+                                             RangeBoundary* boundary) {
+  int64_t value = 0;
+  if (InductionVar::IsConstant(x, &value)) {
+    *boundary = RangeBoundary::FromConstant(value);
+    return true;
+  }
+  if (InductionVar::IsInvariant(x) && x->mult() == 1 &&
+      Definition::IsLengthLoad(x->def()) &&
+      RangeBoundary::IsValidOffsetForSymbolicRangeBoundary(x->offset())) {
+    *boundary = RangeBoundary::FromDefinition(x->def(), x->offset());
+    return true;
+  }
+  return false;
+}
+
+// Computes the range of the given definition from its induction in the
+// enclosing loop. This bounds inductions which are not compared against
+// the loop limit themselves, e.g. k in
+//
+//    for (int i = 0, k = 10; i < a.length; i++, k++)
+//
+// which range analysis alone would widen to the full integer range.
+static bool InferRangeFromInduction(Definition* defn, Range* range) {
+  LoopInfo* loop = defn->GetBlock()->loop_info();
+  if (loop == nullptr) {
+    return false;
+  }
+  InductionVar* induc = loop->LookupInduction(defn);
+  InductionVar* min = nullptr;
+  InductionVar* max = nullptr;
+  if (!InductionVar::IsInduction(induc) ||
+      !induc->CanComputeBounds(loop, defn, &min, &max)) {
+    return false;
+  }
+  RangeBoundary lower;
+  RangeBoundary upper;
+  if (!InductionBoundaryToRangeBoundary(min, &lower) ||
+      !InductionBoundaryToRangeBoundary(max, &upper)) {
+    return false;
+  }
+  *range = Range(lower, upper);
+  return true;
+}
+
 void BinaryIntegerOpInstr::InferRangeHelper(const Range* left_range,
                                             const Range* right_range,
                                             Range* range) {
@@ -2989,6 +3036,11 @@ void BinaryIntegerOpInstr::InferRangeHelper(const Range* left_range,
                   range);
   ASSERT(!Range::IsUnknown(range));
 
+  Range induction_range;
+  if (InferRangeFromInduction(this, &induction_range)) {
+    *range = range->Intersect(&induction_range);
+  }
+
   // Calculate overflowed status before clamping if operation is
   // not truncating.
   if (!is_truncating()) {
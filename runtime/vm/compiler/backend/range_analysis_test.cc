@@ -676,4 +676,44 @@ ISOLATE_UNIT_TEST_CASE(RangeAnalysis_LoadClassId) {
   EXPECT(load_cid->range()->max().ConstantValue() == kDoubleCid);
 }
 
+// Induction k is not compared against the loop limit, but is bounded by
+// the array length through its difference with the loop control i.
+ISOLATE_UNIT_TEST_CASE(RangeAnalysis_DerivedInduction) {
+  const char* kScript = R"(
+    import 'dart:typed_data';
+
+    @pragma('vm:never-inline')
+    void foo(Uint32List a, List<int> b) {
+      for (int i = 0, k = 10; i < a.length; i++, k++) {
+        b[i] = k;
+      }
+    }
+    void main() {
+      final b = List<int>.filled(100, 0);
+      foo(Uint32List(100), b);
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (auto* op = it.Current()->AsBinaryIntegerOp()) {
+        EXPECT(op->op_kind() == Token::kADD);
+        EXPECT(Range::Fits(op->range(), kTagged, TaggedMode::kTaggedIsSmi));
+        count++;
+      }
+    }
+  }
+  EXPECT_EQ(2, count);
+}
+
 }  // namespace dart
@@ -3544,6 +3544,87 @@ static Definition* LoadSource(Definition* instr) {
   return nullptr;
 }
 
+// Returns the definition which can replace [instr], a use of the supported
+// allocation [alloc], or nullptr if [instr] can't be simplified.
+Definition* AllocationSinking::SimplifiedUseOf(Definition* alloc,
+                                               Instruction* instr) {
+  // The class of an allocation is known exactly and it is never null, so
+  // redefinitions and null checks of it carry no extra information.
+  if (instr->IsRedefinition() || instr->IsCheckNull()) {
+    return alloc;
+  }
+  if (auto load = instr->AsLoadClassId()) {
+    const intptr_t cid = alloc->Type()->ToCid();
+    if (cid == kDynamicCid) return nullptr;
+    return flow_graph_->GetConstant(Smi::ZoneHandle(zone(), Smi::New(cid)),
+                                    load->representation());
+  }
+  // A fresh object is only identical to itself. Comparisons used by
+  // branches are left to constant propagation.
+  if (auto compare = instr->AsStrictCompare()) {
+    if (compare->needs_number_check()) return nullptr;
+    Definition* left = compare->left()->definition();
+    Definition* right = compare->right()->definition();
+    Definition* other = (left == alloc) ? right : left;
+    bool identical;
+    if (other == alloc) {
+      identical = true;
+    } else if (other->IsConstant() || IsSupportedAllocation(other)) {
+      identical = false;
+    } else {
+      return nullptr;
+    }
+    return flow_graph_->GetConstant(
+        Bool::Get(identical == (compare->kind() == Token::kEQ_STRICT)));
+  }
+  return nullptr;
+}
+
+// Inlining leaves behind uses of allocations which don't let the object
+// escape but are not stores, e.g. redefinitions of the receiver of an inlined
+// method. Replace them with the allocation itself or with constants, so that
+// they don't prevent allocation sinking.
+void AllocationSinking::SimplifyUsesOfAllocations() {
+  GrowableArray<Instruction*> worklist;
+  for (BlockIterator block_it = flow_graph_->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      if (!IsSupportedAllocation(current)) {
+        continue;
+      }
+
+      // Replacing a redefinition adds its uses to the use list of the
+      // allocation, so repeat until nothing changes.
+      Definition* alloc = current->Cast<Definition>();
+      bool changed;
+      do {
+        changed = false;
+        worklist.Clear();
+        for (Value* use = alloc->input_use_list(); use != nullptr;
+             use = use->next_use()) {
+          if (!worklist.Contains(use->instruction())) {
+            worklist.Add(use->instruction());
+          }
+        }
+        for (Instruction* instr : worklist) {
+          Definition* replacement = SimplifiedUseOf(alloc, instr);
+          if (replacement == nullptr) continue;
+          if (FLAG_trace_optimization && flow_graph_->should_print()) {
+            THR_Print("simplifying use of v%" Pd ": %s\n",
+                      alloc->ssa_temp_index(), instr->ToCString());
+          }
+          Definition* def = instr->Cast<Definition>();
+          def->ReplaceUsesWith(replacement);
+          def->RemoveFromGraph();
+          changed = true;
+        }
+      } while (changed);
+    }
+  }
+}
+
 // Remove the given allocation from the graph. It is not observable.
 // If deoptimization occurs the object will be materialized.
 void AllocationSinking::EliminateAllocation(Definition* alloc) {
@@ -3798,6 +3879,8 @@ void AllocationSinking::Optimize() {
     return;
   }
 
+  SimplifyUsesOfAllocations();
+
   CollectCandidates();
 
   // Insert MaterializeObject instructions that will describe the state of the
@@ -58,6 +58,10 @@ class AllocationSinking : public ZoneAllocated {
     GrowableArray<Definition*> worklist_;
   };
 
+  void SimplifyUsesOfAllocations();
+
+  Definition* SimplifiedUseOf(Definition* alloc, Instruction* instr);
+
   void CollectCandidates();
 
   void NormalizeMaterializations();
@@ -0,0 +1,150 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/type_arguments_specializer.h"
+
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/flags.h"
+#include "vm/object.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            specialize_type_arguments,
+            false,
+            "Specialize generic code in JIT mode for the type arguments it "
+            "was observed to run with.");
+DEFINE_FLAG(bool,
+            trace_type_arguments_specialization,
+            false,
+            "Trace specialization of generic code for observed type "
+            "arguments.");
+
+class TypeArgumentsSpecialization : public ValueObject {
+ public:
+  explicit TypeArgumentsSpecialization(FlowGraph* flow_graph)
+      : flow_graph_(flow_graph),
+        zone_(flow_graph->zone()),
+        instantiator_type_args_(TypeArguments::Handle(zone_)),
+        function_type_args_(TypeArguments::Handle(zone_)) {}
+
+  void Optimize() {
+    GrowableArray<InstantiateTypeArgumentsInstr*> instantiations;
+    for (BlockIterator block_it = flow_graph_->reverse_postorder_iterator();
+         !block_it.Done(); block_it.Advance()) {
+      for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+           it.Advance()) {
+        if (auto instantiate = it.Current()->AsInstantiateTypeArguments()) {
+          instantiations.Add(instantiate);
+        }
+      }
+    }
+    // Earlier guards replace the inputs of the instantiations they dominate,
+    // which are then no longer guarded again.
+    for (intptr_t i = 0; i < instantiations.length(); ++i) {
+      Specialize(instantiations[i]);
+    }
+  }
+
+ private:
+  // Looks up the single instantiation in the cache of [type_args], if any.
+  bool LookupObservedTypeArguments(const TypeArguments& type_args) {
+    SafepointMutexLocker ml(
+        flow_graph_->isolate_group()->type_arguments_canonicalization_mutex());
+    TypeArguments::Cache cache(zone_, type_args);
+    if (cache.NumOccupied() != 1 || !cache.IsLinear()) return false;
+    // Occupied entries of linear caches come first.
+    instantiator_type_args_ = cache.RetrieveInstantiatorTypeArguments(0);
+    function_type_args_ = cache.RetrieveFunctionTypeArguments(0);
+    return true;
+  }
+
+  void Specialize(InstantiateTypeArgumentsInstr* instantiate) {
+    // Deoptimization on a guard marks the innermost function at the guard,
+    // which differs from the function of the graph if it was inlined.
+    if (instantiate->env() == nullptr ||
+        instantiate->env()->function().ProhibitsTypeArgumentsSpeculation()) {
+      return;
+    }
+    if (!instantiate->type_arguments()->BindsToConstant() ||
+        !instantiate->type_arguments()->BoundConstant().IsTypeArguments()) {
+      return;
+    }
+    const auto& type_args =
+        TypeArguments::Cast(instantiate->type_arguments()->BoundConstant());
+    if (type_args.IsInstantiated() || !LookupObservedTypeArguments(type_args)) {
+      return;
+    }
+    if (!type_args.IsInstantiated(kCurrentClass)) {
+      Guard(instantiate, instantiate->instantiator_type_arguments(),
+            instantiator_type_args_);
+    }
+    if (!type_args.IsInstantiated(kFunctions)) {
+      Guard(instantiate, instantiate->function_type_arguments(),
+            function_type_args_);
+    }
+  }
+
+  // Deoptimizes before [instantiate] unless [value] is [expected] and
+  // replaces the uses of [value] dominated by the check with [expected].
+  void Guard(InstantiateTypeArgumentsInstr* instantiate,
+             Value* value,
+             const TypeArguments& expected) {
+    if (value->BindsToConstant()) return;
+    // Guarded values are embedded into the code.
+    if (!expected.IsNull() && !expected.IsCanonical()) return;
+
+    Definition* defn = value->definition()->OriginalDefinition();
+    ConstantInstr* constant = flow_graph_->GetConstant(expected);
+    const intptr_t deopt_id = instantiate->deopt_id();
+    auto guard = new (zone_) CheckConditionInstr(
+        new (zone_) StrictCompareInstr(
+            instantiate->source(), Token::kEQ_STRICT, new (zone_) Value(defn),
+            new (zone_) Value(constant),
+            /*needs_number_check=*/false, deopt_id),
+        deopt_id, ICData::kSpeculativeTypeArguments);
+    flow_graph_->InsertBefore(instantiate, guard, instantiate->env(),
+                              FlowGraph::kEffect);
+
+    // Uses in phis flow in from predecessors, which the check may not
+    // dominate.
+    GrowableArray<Value*> uses;
+    for (Value::Iterator it(defn->input_use_list()); !it.Done();
+         it.Advance()) {
+      Value* use = it.Current();
+      Instruction* instr = use->instruction();
+      if (instr == guard || instr->IsPhi()) continue;
+      if (instr->IsDominatedBy(guard)) uses.Add(use);
+    }
+    for (intptr_t i = 0; i < uses.length(); ++i) {
+      uses[i]->BindTo(constant);
+    }
+
+    if (FLAG_trace_type_arguments_specialization) {
+      THR_Print("Specialized v%" Pd " to %s at %s in %s: %" Pd " uses\n",
+                defn->ssa_temp_index(), expected.ToCString(),
+                instantiate->ToCString(),
+                flow_graph_->function().ToFullyQualifiedCString(),
+                uses.length());
+    }
+  }
+
+  FlowGraph* const flow_graph_;
+  Zone* const zone_;
+  TypeArguments& instantiator_type_args_;
+  TypeArguments& function_type_args_;
+
+  DISALLOW_COPY_AND_ASSIGN(TypeArgumentsSpecialization);
+};
+
+void TypeArgumentsSpecializer::Optimize(FlowGraph* flow_graph) {
+  // Type arguments feedback is only collected by unoptimized JIT code.
+  if (!FLAG_specialize_type_arguments || CompilerState::Current().is_aot()) {
+    return;
+  }
+  TypeArgumentsSpecialization(flow_graph).Optimize();
+}
+
+}  // namespace dart
@@ -0,0 +1,35 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_TYPE_ARGUMENTS_SPECIALIZER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_TYPE_ARGUMENTS_SPECIALIZER_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+
+// Specializes generic code in JIT mode for the instantiator and function type
+// arguments it was observed to run with.
+//
+// If the instantiations cache of the type arguments instantiated by an
+// InstantiateTypeArguments instruction holds a single entry, the type
+// arguments the instruction depends on are guarded to be the ones of that
+// entry. Uses dominated by the guard are then replaced with constants, which
+// allows constant propagation to fold the dependent instantiations, type
+// checks and covariance checks. A function which deoptimized on such a guard
+// is no longer specialized.
+class TypeArgumentsSpecializer : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_TYPE_ARGUMENTS_SPECIALIZER_H_
@@ -0,0 +1,100 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, specialize_type_arguments);
+
+struct SpecializedInstructions {
+  intptr_t instantiations = 0;
+  intptr_t guards = 0;
+};
+
+static SpecializedInstructions CountSpecializedInstructions(
+    FlowGraph* flow_graph) {
+  SpecializedInstructions result;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* current = it.Current();
+      if (current->IsInstantiateTypeArguments()) {
+        result.instantiations++;
+      } else if (auto check = current->AsCheckCondition()) {
+        if (check->deopt_flags() == ICData::kSpeculativeTypeArguments) {
+          result.guards++;
+        }
+      }
+    }
+  }
+  return result;
+}
+
+static const char* kMakeMapScript = R"(
+    @pragma('vm:never-inline')
+    Map<String, T> makeMap<T>() => <String, T>{};
+
+    @pragma('vm:entry-point', 'call')
+    void main() {
+      makeMap<int>();
+    }
+  )";
+
+static FlowGraph* CompileMakeMap(const Library& root_library) {
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "makeMap"));
+  Invoke(root_library, "main");
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  return pipeline.RunPasses({});
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_SpecializeTypeArguments) {
+  SetFlagScope<bool> sfs(&FLAG_specialize_type_arguments, true);
+
+  const auto& root_library = Library::Handle(LoadTestScript(kMakeMapScript));
+  FlowGraph* flow_graph = CompileMakeMap(root_library);
+
+  // The instantiation of <String, T> is folded for T = int.
+  const auto counts = CountSpecializedInstructions(flow_graph);
+  EXPECT_EQ(0, counts.instantiations);
+  EXPECT_EQ(1, counts.guards);
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_SpecializeTypeArguments_Polymorphic) {
+  SetFlagScope<bool> sfs(&FLAG_specialize_type_arguments, true);
+
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    Map<String, T> makeMap<T>() => <String, T>{};
+
+    @pragma('vm:entry-point', 'call')
+    void main() {
+      makeMap<int>();
+      makeMap<double>();
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  FlowGraph* flow_graph = CompileMakeMap(root_library);
+
+  const auto counts = CountSpecializedInstructions(flow_graph);
+  EXPECT_EQ(1, counts.instantiations);
+  EXPECT_EQ(0, counts.guards);
+}
+
+ISOLATE_UNIT_TEST_CASE(IRTest_SpecializeTypeArguments_Disabled) {
+  const auto& root_library = Library::Handle(LoadTestScript(kMakeMapScript));
+  FlowGraph* flow_graph = CompileMakeMap(root_library);
+
+  const auto counts = CountSpecializedInstructions(flow_graph);
+  EXPECT_EQ(1, counts.instantiations);
+  EXPECT_EQ(0, counts.guards);
+}
+
+}  // namespace dart
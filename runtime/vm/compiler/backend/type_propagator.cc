@@ -1161,6 +1161,12 @@ CompileType IfThenElseInstr::ComputeType() const {
   return CompileType::FromCid(kSmiCid);
 }
 
+CompileType SelectInstr::ComputeType() const {
+  CompileType result = *if_true()->Type();
+  result.Union(if_false()->Type());
+  return result;
+}
+
 CompileType ParameterInstr::ComputeType() const {
   // Note that returning the declared type of the formal parameter would be
   // incorrect, because ParameterInstr is used as input to the type check
@@ -12,8 +12,11 @@
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/inliner.h"
 #include "vm/compiler/backend/linearscan.h"
+#include "vm/compiler/backend/loop_vectorizer.h"
+#include "vm/compiler/backend/loop_versioning.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/backend/redundancy_elimination.h"
+#include "vm/compiler/backend/type_arguments_specializer.h"
 #include "vm/compiler/backend/type_propagator.h"
 #include "vm/compiler/call_specializer.h"
 #include "vm/compiler/compiler_timings.h"
@@ -214,7 +217,13 @@ void CompilerPass::Run(CompilerPassState* state) const {
       TIMELINE_DURATION(thread, CompilerVerbose, name());
       {
         COMPILER_TIMINGS_PASS_TIMER_SCOPE(thread, id());
+        const int64_t start_micros =
+            state->pass_micros != nullptr ? OS::GetCurrentMonotonicMicros() : 0;
         repeat = DoBody(state);
+        if (state->pass_micros != nullptr) {
+          state->pass_micros[id()] +=
+              OS::GetCurrentMonotonicMicros() - start_micros;
+        }
       }
       thread->CheckForSafepoint();
     }
@@ -303,6 +312,7 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   INVOKE_PASS(ApplyClassIds);
   INVOKE_PASS(TypePropagation);
   INVOKE_PASS(ApplyICData);
+  INVOKE_PASS(SpecializeTypeArguments);
   INVOKE_PASS(Canonicalize);
   INVOKE_PASS(BranchSimplify);
   INVOKE_PASS(IfConvert);
@@ -333,6 +343,8 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   // so it should not be lifted earlier than that pass.
   INVOKE_PASS(DCE);
   INVOKE_PASS(Canonicalize);
+  INVOKE_PASS_AOT(VersionLoops);
+  INVOKE_PASS_AOT(VectorizeLoops);
   INVOKE_PASS_AOT(DelayAllocations);
   // Repeat branches optimization after DCE, as it could make more
   // empty blocks.
@@ -343,6 +355,7 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   INVOKE_PASS(Canonicalize);
   INVOKE_PASS(TypePropagation);
   INVOKE_PASS(SelectRepresentations_Final);
+  INVOKE_PASS(IfConvertToSelects);
   INVOKE_PASS(UseTableDispatch);
   INVOKE_PASS(EliminateStackOverflowChecks);
   INVOKE_PASS(Canonicalize);
@@ -358,6 +371,37 @@ FlowGraph* CompilerPass::RunPipeline(PipelineMode mode,
   return pass_state->flow_graph();
 }
 
+FlowGraph* CompilerPass::RunQuickPipeline(CompilerPassState* pass_state,
+                                          bool compute_ssa) {
+  if (compute_ssa) {
+    INVOKE_PASS(ComputeSSA);
+  }
+  // Class checks and implicit getters and setters are still specialized
+  // and inlined using ICData, but no other calls are inlined and passes
+  // which are superlinear or iterate to a fixed point are skipped.
+  INVOKE_PASS(ApplyICData);
+  INVOKE_PASS(SetOuterInliningId);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(ApplyClassIds);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(SelectRepresentations);
+  INVOKE_PASS(EliminateEnvironments);
+  INVOKE_PASS(EliminateDeadPhis);
+  INVOKE_PASS(DCE);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(SelectRepresentations_Final);
+  INVOKE_PASS(EliminateStackOverflowChecks);
+  INVOKE_PASS(EliminateWriteBarriers);
+  INVOKE_PASS(LoweringAfterCodeMotionDisabled);
+  INVOKE_PASS(FinalizeGraph);
+  INVOKE_PASS(Canonicalize);
+  INVOKE_PASS(ReorderBlocks);
+  INVOKE_PASS(AllocateRegisters);
+  return pass_state->flow_graph();
+}
+
 FlowGraph* CompilerPass::RunPipelineWithPasses(
     CompilerPassState* state,
     std::initializer_list<CompilerPass::Id> passes) {
@@ -407,6 +451,10 @@ COMPILER_PASS(BranchSimplify, { BranchSimplifier::Simplify(flow_graph); });
 
 COMPILER_PASS(IfConvert, { IfConverter::Simplify(flow_graph); });
 
+COMPILER_PASS(IfConvertToSelects, {
+  IfConverter::ConvertToSelects(flow_graph);
+});
+
 COMPILER_PASS_REPEAT(ConstantPropagation, {
   ConstantPropagator::Optimize(flow_graph);
   return true;
@@ -475,6 +523,9 @@ COMPILER_PASS(OptimizeBranches, {
 COMPILER_PASS(OptimizeTypedDataAccesses,
               { TypedDataSpecializer::Optimize(flow_graph); });
 
+COMPILER_PASS(SpecializeTypeArguments,
+              { TypeArgumentsSpecializer::Optimize(flow_graph); });
+
 COMPILER_PASS(TryCatchOptimization, {
   OptimizeCatchEntryStates(flow_graph,
                            /*is_aot=*/CompilerState::Current().is_aot());
@@ -489,6 +540,10 @@ COMPILER_PASS(DCE, { DeadCodeElimination::EliminateDeadCode(flow_graph); });
 
 COMPILER_PASS(DelayAllocations, { DelayAllocations::Optimize(flow_graph); });
 
+COMPILER_PASS(VectorizeLoops, { LoopVectorizer::Optimize(flow_graph); });
+
+COMPILER_PASS(VersionLoops, { LoopVersioning::Optimize(flow_graph); });
+
 COMPILER_PASS(AllocationSinking_Sink, {
   // TODO(vegorov): Support allocation sinking with try-catch.
   if (flow_graph->try_entries().is_empty()) {
@@ -38,6 +38,7 @@ namespace dart {
   V(EliminateStackOverflowChecks)                                              \
   V(FinalizeGraph)                                                             \
   V(IfConvert)                                                                 \
+  V(IfConvertToSelects)                                                        \
   V(Inlining)                                                                  \
   V(LICM)                                                                      \
   V(OptimisticallySpecializeSmiPhis)                                           \
@@ -48,10 +49,13 @@ namespace dart {
   V(SelectRepresentations)                                                     \
   V(SelectRepresentations_Final)                                               \
   V(SetOuterInliningId)                                                        \
+  V(SpecializeTypeArguments)                                                   \
   V(TryCatchOptimization)                                                      \
   V(TryOptimizePatterns)                                                       \
   V(TypePropagation)                                                           \
   V(UseTableDispatch)                                                          \
+  V(VectorizeLoops)                                                            \
+  V(VersionLoops)                                                              \
   V(EliminateWriteBarriers)                                                    \
   V(TestILSerialization)                                                       \
   V(LoweringAfterCodeMotionDisabled)                                           \
@@ -87,6 +91,10 @@ struct CompilerPassState {
 
   FlowGraphCompiler* graph_compiler = nullptr;
 
+  // If not null, the time spent in each pass is added to the entry for its
+  // id, see CompilerPass::kNumPasses.
+  int64_t* pass_micros = nullptr;
+
  private:
   FlowGraph* flow_graph_;
 };
@@ -165,6 +173,11 @@ class CompilerPass {
   static FlowGraph* RunPipeline(PipelineMode mode,
                                 CompilerPassState* state,
                                 bool compute_ssa = true);
+  // Runs only the passes needed to generate optimized code together with a
+  // few cheap ones. Used by the quick tier of the JIT (see --jit_quick_tier).
+  DART_WARN_UNUSED_RESULT
+  static FlowGraph* RunQuickPipeline(CompilerPassState* state,
+                                     bool compute_ssa = true);
   DART_WARN_UNUSED_RESULT
   static FlowGraph* RunPipelineWithPasses(
       CompilerPassState* state,
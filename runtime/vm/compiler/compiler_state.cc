@@ -93,6 +93,26 @@ const Function& CompilerState::StringBaseInterpolate() {
   }
   return *interpolate_;
 }
+
+const Function& CompilerState::StringBaseInterpolateShort(
+    intptr_t num_pieces) {
+  ASSERT(num_pieces == 2 || num_pieces == 3);
+  const Function*& result = num_pieces == 2 ? interpolate2_ : interpolate3_;
+  if (result == nullptr) {
+    Thread* thread = Thread::Current();
+    Zone* zone = thread->zone();
+
+    const Class& cls =
+        Class::Handle(Library::LookupCoreClass(Symbols::StringBase()));
+    ASSERT(!cls.IsNull());
+    result = &Function::ZoneHandle(
+        zone, cls.LookupFunctionAllowPrivate(num_pieces == 2
+                                                 ? Symbols::Interpolate2()
+                                                 : Symbols::Interpolate3()));
+    ASSERT(!result->IsNull());
+  }
+  return *result;
+}
 #define DEFINE_TYPED_LIST_NATIVE_FUNCTION_GETTER(Upper, Lower)                 \
   const Function& CompilerState::TypedListGet##Upper() {                       \
     if (typed_list_get_##Lower##_ == nullptr) {                                \
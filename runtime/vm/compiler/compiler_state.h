@@ -115,6 +115,10 @@ class CompilerState : public ThreadStackResource {
   // Returns _StringBase._interpolateSingle
   const Function& StringBaseInterpolateSingle();
 
+  // Returns _StringBase._interpolate2 or _StringBase._interpolate3, which
+  // take the pieces of a short interpolation as separate arguments.
+  const Function& StringBaseInterpolateShort(intptr_t num_pieces);
+
   const Function& TypedListGetFloat32();
   const Function& TypedListSetFloat32();
   const Function& TypedListGetFloat64();
@@ -176,6 +180,8 @@ class CompilerState : public ThreadStackResource {
   const Class* comparable_class_ = nullptr;
   const Function* interpolate_ = nullptr;
   const Function* interpolate_single_ = nullptr;
+  const Function* interpolate2_ = nullptr;
+  const Function* interpolate3_ = nullptr;
   const Class* typed_list_class_ = nullptr;
   const Class* array_class_ = nullptr;
   const Class* compound_class_ = nullptr;
@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/range_analysis.h"       // For Range.
 #include "vm/compiler/frontend/flow_graph_builder.h"  // For InlineExitCollector.
 #include "vm/compiler/frontend/kernel_to_il.h"        // For FlowGraphBuilder.
@@ -17,6 +18,9 @@
 #include "vm/resolver.h"
 
 namespace dart {
+
+DECLARE_FLAG(bool, aot_coverage);
+
 namespace kernel {
 
 #define Z (zone_)
@@ -1326,13 +1330,36 @@ Fragment BaseFlowGraphBuilder::RecordBranchCoverage(TokenPosition position) {
   return RecordCoverageImpl(position, true /** is_branch_coverage **/);
 }
 
+Fragment BaseFlowGraphBuilder::RecordFunctionCoverage(TokenPosition position) {
+  if (!IsAotCoverageEnabled()) return Fragment();
+  return RecordCoverageImpl(position, true /** is_branch_coverage **/);
+}
+
+bool BaseFlowGraphBuilder::IsAotCoverageEnabled() const {
+#if defined(DART_PRECOMPILER)
+  // Code of the core libraries is hot enough to make recording its coverage
+  // noticeable, and is not what --aot_coverage is for.
+  return FLAG_aot_coverage && CompilerState::Current().is_aot() &&
+         !Library::Handle(Z, Class::Handle(Z, function_.Owner()).library())
+              .is_dart_scheme();
+#else
+  return false;
+#endif
+}
+
 Fragment BaseFlowGraphBuilder::RecordCoverageImpl(TokenPosition position,
                                                   bool is_branch_coverage) {
   Fragment instructions;
-  if (!SupportsCoverage()) return instructions;
-  if (!IG->coverage()) return instructions;
   if (!position.IsReal()) return instructions;
-  if (is_branch_coverage && !IG->branch_coverage()) return instructions;
+  if (IsAotCoverageEnabled()) {
+    // Only function entries and blocks are recorded in precompiled code,
+    // which costs one store per block.
+    if (!is_branch_coverage) return instructions;
+  } else {
+    if (!SupportsCoverage()) return instructions;
+    if (!IG->coverage()) return instructions;
+    if (is_branch_coverage && !IG->branch_coverage()) return instructions;
+  }
 
   const intptr_t coverage_index =
       GetCoverageIndexFor(position.EncodeCoveragePosition(is_branch_coverage));
@@ -1406,6 +1433,15 @@ void BaseFlowGraphBuilder::FinalizeCoverageArray() {
     value = Smi::New(0);  // no coverage recorded.
     coverage_array_.SetAt(p->value, value);
   }
+
+#if defined(DART_PRECOMPILER)
+  // Unit tests build AOT flow graphs without a precompiler.
+  if (IsAotCoverageEnabled() && (Precompiler::Instance() != nullptr)) {
+    // All RecordCoverage instructions refer to coverage_array_ by handle.
+    coverage_array_ = Precompiler::Instance()->RegisterCoverageArray(
+        function_, coverage_array_);
+  }
+#endif
 }
 
 }  // namespace kernel
@@ -503,6 +503,9 @@ class BaseFlowGraphBuilder {
   // Records coverage for this position, if the current VM mode supports it.
   Fragment RecordCoverage(TokenPosition position);
   Fragment RecordBranchCoverage(TokenPosition position);
+  // Records the entry of the function at this position when precompiling
+  // with --aot_coverage.
+  Fragment RecordFunctionCoverage(TokenPosition position);
 
   // Returns whether this function has a saved arguments descriptor array.
   bool has_saved_args_desc_array() {
@@ -520,6 +523,7 @@ class BaseFlowGraphBuilder {
  protected:
   intptr_t AllocateBlockId() { return ++last_used_block_id_; }
   Fragment RecordCoverageImpl(TokenPosition position, bool is_branch_coverage);
+  bool IsAotCoverageEnabled() const;
   intptr_t GetCoverageIndexFor(intptr_t encoded_position);
 
   static bool ShouldOmitCheckBoundsIn(const Function& function,
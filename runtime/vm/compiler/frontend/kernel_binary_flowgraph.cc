@@ -17,6 +17,9 @@
 #include "vm/stack_frame.h"
 
 namespace dart {
+
+DECLARE_FLAG(bool, skip_await_of_completed_futures);
+
 namespace kernel {
 
 #define Z (zone_)
@@ -840,6 +843,7 @@ FlowGraph* StreamingFlowGraphBuilder::BuildGraphOfFunction(
   // objects than necessary during GC.
   const Fragment body =
       ClearRawParameters(dart_function) +
+      B->RecordFunctionCoverage(token_position) +
       InitSuspendableFunction(dart_function, emitted_value_type) +
       BuildFunctionBody(dart_function, first_parameter, is_constructor);
 
@@ -1697,6 +1701,12 @@ Fragment StreamingFlowGraphBuilder::StringInterpolate(TokenPosition position) {
   return flow_graph_builder_->StringInterpolate(position);
 }
 
+Fragment StreamingFlowGraphBuilder::StringInterpolateShort(
+    intptr_t num_pieces,
+    TokenPosition position) {
+  return flow_graph_builder_->StringInterpolateShort(num_pieces, position);
+}
+
 Fragment StreamingFlowGraphBuilder::StringInterpolateSingle(
     TokenPosition position) {
   return flow_graph_builder_->StringInterpolateSingle(position);
@@ -3790,6 +3800,22 @@ Fragment StreamingFlowGraphBuilder::BuildStringConcatenation(TokenPosition* p) {
     return instructions;
   }
 
+  if (collector.pieces.length() <= 3) {
+    // Short interpolations pass their pieces as arguments instead of
+    // storing them into a temporary array.
+    Fragment instructions;
+    for (intptr_t i = 0; i < collector.pieces.length(); ++i) {
+      if (collector.pieces[i].literal != nullptr) {
+        instructions += Constant(*collector.pieces[i].literal);
+      } else {
+        AlternativeReadingScope scope(&reader_, collector.pieces[i].offset);
+        instructions += BuildExpression();
+      }
+    }
+    instructions += StringInterpolateShort(collector.pieces.length(), position);
+    return instructions;
+  }
+
   Fragment instructions;
   instructions += Constant(TypeArguments::ZoneHandle(Z));
   instructions += IntConstant(collector.pieces.length());
@@ -4537,6 +4563,11 @@ Fragment StreamingFlowGraphBuilder::BuildAwaitExpression(
     }
   }
 
+  if (FLAG_skip_await_of_completed_futures &&
+      stub_id == SuspendInstr::StubId::kAwait) {
+    return instructions + BuildAwaitOrTakeCompletedValue(pos);
+  }
+
   if (NeedsDebugStepCheck(parsed_function()->function(), pos)) {
     instructions += DebugStepCheck(pos);
   }
@@ -4544,6 +4575,50 @@ Fragment StreamingFlowGraphBuilder::BuildAwaitExpression(
   return instructions;
 }
 
+// Suspends at the awaited operand on the top of the stack unless it is a
+// future which already completed with a value, in which case the value is
+// taken directly.
+Fragment StreamingFlowGraphBuilder::BuildAwaitOrTakeCompletedValue(
+    TokenPosition pos) {
+  const auto& can_skip_await = Function::ZoneHandle(
+      Z, IG->object_store()->suspend_state_can_skip_await());
+  const auto& completed_value = Function::ZoneHandle(
+      Z, IG->object_store()->suspend_state_completed_value());
+  LocalVariable* result = parsed_function()->expression_temp_var();
+
+  Fragment instructions;
+  LocalVariable* operand = MakeTemporary("awaited");
+  instructions += LoadLocal(operand);
+  instructions += StaticCall(pos, can_skip_await, 1, ICData::kStatic);
+  TargetEntryInstr* skip_entry;
+  TargetEntryInstr* suspend_entry;
+  instructions += BranchIfTrue(&skip_entry, &suspend_entry, /*negate=*/false);
+
+  Fragment skip(skip_entry);
+  skip += LoadLocal(operand);
+  skip += StaticCall(pos, completed_value, 1, ICData::kStatic);
+  skip += StoreLocal(TokenPosition::kNoSource, result);
+  skip += Drop();
+
+  Fragment suspend(suspend_entry);
+  if (NeedsDebugStepCheck(parsed_function()->function(), pos)) {
+    suspend += DebugStepCheck(pos);
+  }
+  suspend += LoadLocal(operand);
+  suspend += B->Suspend(pos, SuspendInstr::StubId::kAwait);
+  suspend += StoreLocal(TokenPosition::kNoSource, result);
+  suspend += Drop();
+
+  JoinEntryInstr* join = BuildJoinEntry();
+  skip += Goto(join);
+  suspend += Goto(join);
+
+  instructions = Fragment(instructions.entry, join);
+  instructions += DropTemporary(&operand);
+  instructions += LoadLocal(result);
+  return instructions;
+}
+
 Fragment StreamingFlowGraphBuilder::BuildFileUriExpression(
     TokenPosition* position) {
   ReadUInt();  // read uri
@@ -5122,6 +5197,15 @@ Fragment StreamingFlowGraphBuilder::BuildOptimizedSwitchPrelude(
     instructions += B->LoadField(enum_index_field, /*calls_initializer=*/false);
     instructions += StoreLocal(pos, scopes()->switch_variable);
     instructions += Drop();
+  } else if (helper->is_string_switch()) {
+    // For a string switch, we dispatch on the hash code of the string but
+    // keep the string itself in the switch variable to compare it with the
+    // case expressions.
+    instructions += LoadLocal(scopes()->switch_variable);
+    instructions += InstanceCall(pos, Symbols::GetHashCode(), Token::kGET,
+                                 /*argument_count=*/1);
+    instructions += StoreLocal(pos, scopes()->switch_hash_variable);
+    instructions += Drop();
   }
 
   return instructions;
@@ -5163,6 +5247,9 @@ Fragment StreamingFlowGraphBuilder::BuildBinarySearchSwitch(
   }
 
   Fragment current_instructions = BuildOptimizedSwitchPrelude(helper, join);
+  LocalVariable* dispatch_variable = helper->is_string_switch()
+                                         ? scopes()->switch_hash_variable
+                                         : scopes()->switch_variable;
 
   GrowableArray<SwitchRange> stack;
   stack.Add(SwitchRange::Branch(0, expression_count - 1, current_instructions));
@@ -5176,13 +5263,32 @@ Fragment StreamingFlowGraphBuilder::BuildBinarySearchSwitch(
       const SwitchExpression& expression =
           *sorted_expressions.At(expression_index);
 
-      if (!range.is_bounds_checked() &&
-          ((helper->RequiresLowerBoundCheck() && expression_index == 0) ||
-           (helper->RequiresUpperBoundCheck() &&
-            expression_index == expression_count - 1))) {
-        // This leaf needs a bound check.
+      if (!range.is_bounds_checked() && helper->is_string_switch()) {
+        // Equal hash codes do not imply equal strings, so every leaf of a
+        // string switch compares the strings. This subsumes bound checks.
 
+        branch_instructions += Constant(expression.value());
         branch_instructions += LoadLocal(scopes()->switch_variable);
+        branch_instructions += InstanceCall(
+            expression.position(), Symbols::EqualOperator(), Token::kEQ,
+            /*argument_count=*/2,
+            /*checked_argument_count=*/2);
+        branch_instructions +=
+            BranchIfTrue(&then_entry, &otherwise_entry, /*negate=*/false);
+
+        Fragment otherwise_instructions(otherwise_entry);
+        otherwise_instructions += Goto(join);
+
+        stack.Add(SwitchRange::Leaf(expression_index, Fragment(then_entry),
+                                    /*is_bounds_checked=*/true));
+      } else if (!range.is_bounds_checked() &&
+                 ((helper->RequiresLowerBoundCheck() &&
+                   expression_index == 0) ||
+                  (helper->RequiresUpperBoundCheck() &&
+                   expression_index == expression_count - 1))) {
+        // This leaf needs a bound check.
+
+        branch_instructions += LoadLocal(dispatch_variable);
         branch_instructions += Constant(expression.integer());
         branch_instructions +=
             StrictCompare(expression.position(), Token::kEQ_STRICT,
@@ -5236,7 +5342,7 @@ Fragment StreamingFlowGraphBuilder::BuildBinarySearchSwitch(
           *sorted_expressions.At(middle);
       const SwitchExpression& next_expression = *sorted_expressions.At(next);
 
-      branch_instructions += LoadLocal(scopes()->switch_variable);
+      branch_instructions += LoadLocal(dispatch_variable);
       branch_instructions += Constant(middle_expression.integer());
       branch_instructions +=
           B->IntRelationalOp(middle_expression.position(), Token::kLTE);
@@ -5246,12 +5352,14 @@ Fragment StreamingFlowGraphBuilder::BuildBinarySearchSwitch(
       Fragment lower_branch_instructions(then_entry);
       Fragment upper_branch_instructions(otherwise_entry);
 
-      if (next_expression.integer().Value() >
-          middle_expression.integer().Value() + 1) {
+      if (!helper->is_string_switch() &&
+          (next_expression.integer().Value() >
+           middle_expression.integer().Value() + 1)) {
         // The upper branch is not contiguous with the lower branch.
         // Before continuing in the upper branch we add a bound check.
+        // Leafs of string switches are always checked instead.
 
-        upper_branch_instructions += LoadLocal(scopes()->switch_variable);
+        upper_branch_instructions += LoadLocal(dispatch_variable);
         upper_branch_instructions += Constant(next_expression.integer());
         upper_branch_instructions +=
             B->IntRelationalOp(next_expression.position(), Token::kGTE);
@@ -226,6 +226,7 @@ class StreamingFlowGraphBuilder : public KernelReaderHelper {
   Fragment StoreStaticField(TokenPosition position, const Field& field);
   Fragment StringInterpolate(TokenPosition position);
   Fragment StringInterpolateSingle(TokenPosition position);
+  Fragment StringInterpolateShort(intptr_t num_pieces, TokenPosition position);
   Fragment LoadInstantiatorTypeArguments();
   Fragment LoadFunctionTypeArguments();
   Fragment InstantiateType(const AbstractType& type);
@@ -344,6 +345,7 @@ class StreamingFlowGraphBuilder : public KernelReaderHelper {
   Fragment BuildLibraryPrefixAction(TokenPosition* position,
                                     const String& selector);
   Fragment BuildAwaitExpression(TokenPosition* position);
+  Fragment BuildAwaitOrTakeCompletedValue(TokenPosition pos);
   Fragment BuildFileUriExpression(TokenPosition* position);
 
   Fragment BuildExpressionStatement(TokenPosition* position);
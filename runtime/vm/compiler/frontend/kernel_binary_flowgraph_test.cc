@@ -55,30 +55,13 @@ ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_ConstFoldStringConcats) {
   EXPECT(ret_str.Equals("aaaabbbbcccc"));
 }
 
-ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_FlattenNestedStringInterp) {
-  // We should collapse nested StringInterpolates:
-  const char* kScript = R"(
-    test(String s) {
-      return '$s' '${'d' 'e'}';
-    }
-    main() => test('u');
-  )";
-
-  const auto& root_library = Library::Handle(LoadTestScript(kScript));
-  const auto& function = Function::Handle(GetFunction(root_library, "test"));
-
-  Invoke(root_library, "main");
-
-  TestPipeline pipeline(function, CompilerPass::kJIT);
-  FlowGraph* flow_graph = pipeline.RunPasses({
-      CompilerPass::kComputeSSA,
-  });
-
+// Matches a short string interpolation, which passes its pieces to
+// _StringBase._interpolate2 or _interpolate3 without a temporary array.
+static StaticCallInstr* MatchShortStringInterpolate(FlowGraph* flow_graph) {
   auto entry = flow_graph->graph_entry()->normal_entry();
   EXPECT(entry != nullptr);
 
-  StoreIndexedInstr* store1 = nullptr;
-  StoreIndexedInstr* store2 = nullptr;
+  StaticCallInstr* call = nullptr;
 
   ILMatcher cursor(flow_graph, entry);
   // clang-format off
@@ -86,31 +69,50 @@ ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_FlattenNestedStringInterp) {
     kMatchAndMoveFunctionEntry,
     kMatchAndMoveCheckStackOverflow,
     kMoveDebugStepChecks,
-    kMatchAndMoveCreateArray,
-    {kMatchAndMoveStoreIndexed, &store1},
-    {kMatchAndMoveStoreIndexed, &store2},
     kMatchAndMoveRecordCoverage,
-    kMatchAndMoveStaticCall,
+    {kMatchAndMoveStaticCall, &call},
     kMoveDebugStepChecks,
     kMatchDartReturn,
   }));
   // clang-format on
 
-  // StoreIndexed(tmp_array, 0, s)
-  EXPECT(store1->index()->BindsToConstant());
-  EXPECT(store1->index()->BoundConstant().IsInteger());
-  EXPECT(Integer::Cast(store1->index()->BoundConstant()).Value() == 0);
+  EXPECT(call->IsStringInterpolateShort());
+  return call;
+}
+
+static void ExpectStringPiece(StaticCallInstr* call,
+                              intptr_t index,
+                              const char* expected) {
+  Value* piece = call->ArgumentValueAt(index);
+  EXPECT(piece->BindsToConstant());
+  EXPECT(piece->BoundConstant().IsString());
+  EXPECT(String::Cast(piece->BoundConstant()).Equals(expected));
+}
+
+ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_FlattenNestedStringInterp) {
+  // We should collapse nested StringInterpolates:
+  const char* kScript = R"(
+    test(String s) {
+      return '$s' '${'d' 'e'}';
+    }
+    main() => test('u');
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
 
-  EXPECT(!store1->value()->BindsToConstant());
+  Invoke(root_library, "main");
 
-  // StoreIndexed(tmp_array, 1, "de")
-  EXPECT(store2->index()->BindsToConstant());
-  EXPECT(store2->index()->BoundConstant().IsInteger());
-  EXPECT(Integer::Cast(store2->index()->BoundConstant()).Value() == 1);
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+  });
 
-  EXPECT(store2->value()->BindsToConstant());
-  EXPECT(store2->value()->BoundConstant().IsString());
-  EXPECT(String::Cast(store2->value()->BoundConstant()).Equals("de"));
+  // _interpolate2(s, "de")
+  StaticCallInstr* call = MatchShortStringInterpolate(flow_graph);
+  EXPECT_EQ(2, call->ArgumentCount());
+  EXPECT(!call->ArgumentValueAt(0)->BindsToConstant());
+  ExpectStringPiece(call, 1, "de");
 }
 
 ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_DropEmptyStringInterp) {
@@ -132,54 +134,12 @@ ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_DropEmptyStringInterp) {
       CompilerPass::kComputeSSA,
   });
 
-  auto entry = flow_graph->graph_entry()->normal_entry();
-  EXPECT(entry != nullptr);
-
-  StoreIndexedInstr* store1 = nullptr;
-  StoreIndexedInstr* store2 = nullptr;
-  StoreIndexedInstr* store3 = nullptr;
-
-  ILMatcher cursor(flow_graph, entry);
-  // clang-format off
-  RELEASE_ASSERT(cursor.TryMatch({
-    kMatchAndMoveFunctionEntry,
-    kMatchAndMoveCheckStackOverflow,
-    kMoveDebugStepChecks,
-    kMatchAndMoveCreateArray,
-    {kMatchAndMoveStoreIndexed, &store1},
-    {kMatchAndMoveStoreIndexed, &store2},
-    {kMatchAndMoveStoreIndexed, &store3},
-    kMatchAndMoveRecordCoverage,
-    kMatchAndMoveStaticCall,
-    kMoveDebugStepChecks,
-    kMatchDartReturn,
-  }));
-  // clang-format on
-
-  // StoreIndexed(tmp_array, 0, "ab")
-  EXPECT(store1->index()->BindsToConstant());
-  EXPECT(store1->index()->BoundConstant().IsInteger());
-  EXPECT(Integer::Cast(store1->index()->BoundConstant()).Value() == 0);
-
-  EXPECT(store1->value()->BindsToConstant());
-  EXPECT(store1->value()->BoundConstant().IsString());
-  EXPECT(String::Cast(store1->value()->BoundConstant()).Equals("a"));
-
-  // StoreIndexed(tmp_array, 1, s)
-  EXPECT(store2->index()->BindsToConstant());
-  EXPECT(store2->index()->BoundConstant().IsInteger());
-  EXPECT(Integer::Cast(store2->index()->BoundConstant()).Value() == 1);
-
-  EXPECT(!store2->value()->BindsToConstant());
-
-  // StoreIndexed(tmp_array, 2, "b")
-  EXPECT(store3->index()->BindsToConstant());
-  EXPECT(store3->index()->BoundConstant().IsInteger());
-  EXPECT(Integer::Cast(store3->index()->BoundConstant()).Value() == 2);
-
-  EXPECT(store3->value()->BindsToConstant());
-  EXPECT(store3->value()->BoundConstant().IsString());
-  EXPECT(String::Cast(store3->value()->BoundConstant()).Equals("b"));
+  // _interpolate3("a", s, "b")
+  StaticCallInstr* call = MatchShortStringInterpolate(flow_graph);
+  EXPECT_EQ(3, call->ArgumentCount());
+  ExpectStringPiece(call, 0, "a");
+  EXPECT(!call->ArgumentValueAt(1)->BindsToConstant());
+  ExpectStringPiece(call, 2, "b");
 }
 
 ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_ConcatStringLits) {
@@ -201,13 +161,36 @@ ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_ConcatStringLits) {
       CompilerPass::kComputeSSA,
   });
 
+  // _interpolate3("ab", s, "cd")
+  StaticCallInstr* call = MatchShortStringInterpolate(flow_graph);
+  EXPECT_EQ(3, call->ArgumentCount());
+  ExpectStringPiece(call, 0, "ab");
+  EXPECT(!call->ArgumentValueAt(1)->BindsToConstant());
+  ExpectStringPiece(call, 2, "cd");
+}
+
+ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_LongStringInterp) {
+  // Longer interpolations still use a temporary array:
+  const char* kScript = R"(
+    test(s, t) {
+      return 'a' '$s' 'b' '$t';
+    }
+    main() => test('u', 'v');
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "test"));
+
+  Invoke(root_library, "main");
+
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+  });
+
   auto entry = flow_graph->graph_entry()->normal_entry();
   EXPECT(entry != nullptr);
 
-  StoreIndexedInstr* store1 = nullptr;
-  StoreIndexedInstr* store2 = nullptr;
-  StoreIndexedInstr* store3 = nullptr;
-
   ILMatcher cursor(flow_graph, entry);
   // clang-format off
   RELEASE_ASSERT(cursor.TryMatch({
@@ -215,40 +198,16 @@ ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_ConcatStringLits) {
     kMatchAndMoveCheckStackOverflow,
     kMoveDebugStepChecks,
     kMatchAndMoveCreateArray,
-    {kMatchAndMoveStoreIndexed, &store1},
-    {kMatchAndMoveStoreIndexed, &store2},
-    {kMatchAndMoveStoreIndexed, &store3},
+    kMatchAndMoveStoreIndexed,
+    kMatchAndMoveStoreIndexed,
+    kMatchAndMoveStoreIndexed,
+    kMatchAndMoveStoreIndexed,
     kMatchAndMoveRecordCoverage,
     kMatchAndMoveStaticCall,
     kMoveDebugStepChecks,
     kMatchDartReturn,
   }));
   // clang-format on
-
-  // StoreIndexed(tmp_array, 0, "ab")
-  EXPECT(store1->index()->BindsToConstant());
-  EXPECT(store1->index()->BoundConstant().IsInteger());
-  EXPECT(Integer::Cast(store1->index()->BoundConstant()).Value() == 0);
-
-  EXPECT(store1->value()->BindsToConstant());
-  EXPECT(store1->value()->BoundConstant().IsString());
-  EXPECT(String::Cast(store1->value()->BoundConstant()).Equals("ab"));
-
-  // StoreIndexed(tmp_array, 1, s)
-  EXPECT(store2->index()->BindsToConstant());
-  EXPECT(store2->index()->BoundConstant().IsInteger());
-  EXPECT(Integer::Cast(store2->index()->BoundConstant()).Value() == 1);
-
-  EXPECT(!store2->value()->BindsToConstant());
-
-  // StoreIndexed(tmp_array, 2, "cd")
-  EXPECT(store3->index()->BindsToConstant());
-  EXPECT(store3->index()->BoundConstant().IsInteger());
-  EXPECT(Integer::Cast(store3->index()->BoundConstant()).Value() == 2);
-
-  EXPECT(store3->value()->BindsToConstant());
-  EXPECT(store3->value()->BoundConstant().IsString());
-  EXPECT(String::Cast(store3->value()->BoundConstant()).Equals("cd"));
 }
 
 ISOLATE_UNIT_TEST_CASE(StreamingFlowGraphBuilder_InvariantFlagInListLiterals) {
@@ -53,6 +53,13 @@ DEFINE_FLAG(int,
             "Force switch statements to use a particular dispatch type: "
             "-1=auto, 0=linear scan, 1=binary search, 2=jump table");
 
+DEFINE_FLAG(bool,
+            skip_await_of_completed_futures,
+            false,
+            "Take the value of futures which already completed with a value "
+            "in the root zone instead of suspending at 'await'. Changes the "
+            "order in which microtasks run.");
+
 namespace kernel {
 
 #define Z (zone_)
@@ -712,6 +719,15 @@ Fragment FlowGraphBuilder::StringInterpolate(TokenPosition position) {
   return instructions;
 }
 
+Fragment FlowGraphBuilder::StringInterpolateShort(intptr_t num_pieces,
+                                                  TokenPosition position) {
+  Fragment instructions;
+  instructions += StaticCall(
+      position, CompilerState::Current().StringBaseInterpolateShort(num_pieces),
+      num_pieces, ICData::kStatic);
+  return instructions;
+}
+
 Fragment FlowGraphBuilder::ThrowNoSuchMethodError(TokenPosition position,
                                                   const Function& target,
                                                   bool incompatible_arguments,
@@ -4839,9 +4855,8 @@ static classid_t typed_data_cid(intptr_t chunk_size) {
   UNREACHABLE();
 }
 
-// Only for use within FfiCallbackConvertCompoundArgumentToDart and
-// FfiCallbackConvertCompoundReturnToNative, where we know the "array" being
-// passed is an untagged pointer coming from C.
+// Only for use within FfiCallbackConvertCompoundReturnToNative, where we know
+// the "array" being passed is an untagged pointer coming from C.
 static classid_t external_typed_data_cid(intptr_t chunk_size) {
   switch (chunk_size) {
     case 8:
@@ -5037,29 +5052,15 @@ Fragment FlowGraphBuilder::FfiCallbackConvertCompoundArgumentToDart(
     body +=
         AllocateTypedData(TokenPosition::kNoSource, kTypedDataUint8ArrayCid);
     LocalVariable* typed_data_base = MakeTemporary("typed_data_base");
-    intptr_t offset_in_bytes = 0;
-    while (offset_in_bytes < length_in_bytes) {
-      const intptr_t bytes_left = length_in_bytes - offset_in_bytes;
-      const intptr_t chunk_sizee = chunk_size(bytes_left);
-
-      body += LoadLocal(address_of_compound);
-      body += IntConstant(offset_in_bytes);
-      body +=
-          LoadIndexed(external_typed_data_cid(chunk_sizee), /*index_scale=*/1,
-                      /*index_unboxed=*/false);
-      LocalVariable* chunk_value = MakeTemporary("chunk_value");
-
-      body += LoadLocal(typed_data_base);
-      body += IntConstant(offset_in_bytes);
-      body += LoadLocal(chunk_value);
-      body += StoreIndexedTypedData(typed_data_cid(chunk_sizee),
-                                    /*index_scale=*/1,
-                                    /*index_unboxed=*/false);
-      body += DropTemporary(&chunk_value);
-
-      offset_in_bytes += chunk_sizee;
-    }
-    ASSERT(offset_in_bytes == length_in_bytes);
+    // The copy has a constant length, so it is unrolled into as few word
+    // sized moves as the length allows.
+    body += LoadLocal(address_of_compound);
+    body += LoadLocal(typed_data_base);
+    body += IntConstant(0);
+    body += IntConstant(0);
+    body += IntConstant(length_in_bytes);
+    body += MemoryCopy(kExternalTypedDataUint8ArrayCid, kTypedDataUint8ArrayCid,
+                       /*unboxed_inputs=*/false, /*can_overlap=*/false);
     body += DropTempsPreserveTop(1);  // Drop address_of_compound.
   }
   // Wrap typed data in compound class.
@@ -5927,6 +5928,9 @@ SwitchHelper::SwitchHelper(Zone* zone,
                    .is_enum_class()) {
       is_optimizable_ = true;
       is_enum_switch_ = true;
+    } else if (expression_type.IsStringType()) {
+      is_optimizable_ = true;
+      is_string_switch_ = true;
     }
   }
 }
@@ -5973,6 +5977,9 @@ SwitchDispatch SwitchHelper::SelectDispatchStrategy() {
   // If the ratio of holes to expressions is too great we fall back to a
   // binary search to avoid code size explosion.
   const double kJumpTableMaxHolesRatio = 1.0;
+  // Below this many cases comparing the strings one by one is cheaper
+  // than computing the hash code of the scrutinee.
+  const intptr_t kStringSwitchMinExpressions = 4;
 
   if (!is_optimizable() || expressions().is_empty()) {
     // The switch is not optimizable, so we can only use linear scan.
@@ -6001,6 +6008,14 @@ SwitchDispatch SwitchHelper::SelectDispatchStrategy() {
     return kSwitchDispatchBinarySearch;
   }
 
+  if (is_string_switch()) {
+    // Hash codes are sparse, so a jump table is never used.
+    if (expressions().length() < kStringSwitchMinExpressions) {
+      return kSwitchDispatchLinearScan;
+    }
+    return kSwitchDispatchBinarySearch;
+  }
+
   const int64_t range = ExpressionRange();
   if (range > kJumpTableMaxSize) {
     return kSwitchDispatchBinarySearch;
@@ -6075,6 +6090,8 @@ void SwitchHelper::PrepareForOptimizedSwitch() {
       }
       integer = &Integer::ZoneHandle(
           zone_, Integer::RawCast(value.GetField(*enum_index_field)));
+    } else if (is_string_switch()) {
+      integer = &Smi::ZoneHandle(zone_, Smi::New(String::Cast(value).Hash()));
     } else {
       integer = &Integer::Cast(value);
     }
@@ -6100,7 +6117,8 @@ void SwitchHelper::PrepareForOptimizedSwitch() {
 
   // Check that there are no duplicate case expressions.
   // Duplicate expressions are allowed in switch statements, but
-  // optimized switches don't implemented them.
+  // optimized switches don't implemented them. For switches over strings
+  // this also rejects distinct strings with the same hash code.
   for (intptr_t i = 0; i < sorted_expressions_.length() - 1; ++i) {
     const SwitchExpression& a = *sorted_expressions_.At(i);
     const SwitchExpression& b = *sorted_expressions_.At(i + 1);
@@ -259,6 +259,7 @@ class FlowGraphBuilder : public BaseFlowGraphBuilder {
                                   intptr_t type_args_len = 0);
   Fragment StringInterpolateSingle(TokenPosition position);
   Fragment StringInterpolate(TokenPosition position);
+  Fragment StringInterpolateShort(intptr_t num_pieces, TokenPosition position);
 
   // [incompatible_arguments] should be true if the NSM is due to a mismatch
   // between the provided arguments and the function signature.
@@ -949,7 +950,8 @@ class SwitchExpression {
   const Instance& value() const { return *value_; }
 
   // Integer representation of the expression.
-  // For Integers it is the value itself and for Enums it is the index.
+  // For Integers it is the value itself, for Enums it is the index and
+  // for Strings it is the hash code.
   const Integer& integer() const {
     ASSERT(integer_ != nullptr);
     return *integer_;
@@ -1021,8 +1023,8 @@ class SwitchHelper {
                intptr_t case_count);
 
   // A switch statement is optimizable if static type of the scrutinee
-  // expression is a non-nullable int or enum, and all case expressions
-  // are instances of the scrutinee static type.
+  // expression is a non-nullable int, enum or String, and all case
+  // expressions are instances of the scrutinee static type.
   bool is_optimizable() const { return is_optimizable_; }
   const TokenPosition& position() const { return position_; }
   bool is_exhaustive() const { return is_exhaustive_; }
@@ -1067,6 +1069,10 @@ class SwitchHelper {
 
   bool is_enum_switch() const { return is_enum_switch_; }
 
+  // A switch over strings dispatches on the hash codes of the strings
+  // with a binary search and compares the strings at the leaves.
+  bool is_string_switch() const { return is_string_switch_; }
+
   // Returns size of [min..max] range, or kMaxInt64 on overflow.
   int64_t ExpressionRange() const;
 
@@ -1087,6 +1093,7 @@ class SwitchHelper {
   Zone* zone_;
   bool is_optimizable_ = false;
   bool is_enum_switch_ = false;
+  bool is_string_switch_ = false;
   const TokenPosition position_;
   const bool is_exhaustive_;
   const AbstractType& expression_type_;
@@ -37,7 +37,8 @@ TranslationHelper::TranslationHelper(Thread* thread)
       constants_(Array::Handle(Z)),
       constants_table_(TypedDataView::Handle(Z)),
       info_(KernelProgramInfo::Handle(Z)),
-      name_index_handle_(Smi::Handle(Z)) {}
+      name_index_handle_(Smi::Handle(Z)),
+      symbols_(Array::Handle(Z)) {}
 
 TranslationHelper::TranslationHelper(Thread* thread, Heap::Space space)
     : thread_(thread),
@@ -52,7 +53,8 @@ TranslationHelper::TranslationHelper(Thread* thread, Heap::Space space)
       constants_(Array::Handle(Z)),
       constants_table_(TypedDataView::Handle(Z)),
       info_(KernelProgramInfo::Handle(Z)),
-      name_index_handle_(Smi::Handle(Z)) {}
+      name_index_handle_(Smi::Handle(Z)),
+      symbols_(Array::Handle(Z)) {}
 
 void TranslationHelper::Reset() {
   string_offsets_ = TypedData::null();
@@ -61,6 +63,7 @@ void TranslationHelper::Reset() {
   metadata_payloads_ = TypedDataView::null();
   metadata_mappings_ = TypedDataView::null();
   constants_ = Array::null();
+  symbols_ = Array::null();
 }
 
 void TranslationHelper::InitFromKernelProgramInfo(
@@ -84,6 +87,7 @@ void TranslationHelper::InitFromKernelProgramInfo(
 void TranslationHelper::SetStringOffsets(const TypedData& string_offsets) {
   ASSERT(string_offsets_.IsNull());
   string_offsets_ = string_offsets.ptr();
+  symbols_ = Array::null();
 }
 
 void TranslationHelper::SetStringData(const TypedDataView& string_data) {
@@ -343,14 +347,27 @@ const String& TranslationHelper::DartSymbolPlain(const char* content) const {
 }
 
 String& TranslationHelper::DartSymbolPlain(StringIndex string_index) const {
+  // The same names are looked up many times while loading a component, so
+  // the symbols are cached by string index to avoid decoding and hashing
+  // the UTF-8 contents again.
+  if (symbols_.IsNull()) {
+    // The string offsets table has one more entry than there are strings.
+    const intptr_t count = string_offsets_.Length() - 1;
+    symbols_ = Array::New(count);
+  }
+  String& result = String::ZoneHandle(Z);
+  result ^= symbols_.At(string_index);
+  if (!result.IsNull()) {
+    return result;
+  }
   intptr_t length = StringSize(string_index);
   uint8_t* buffer = Z->Alloc<uint8_t>(length);
   {
     NoSafepointScope no_safepoint;
     memmove(buffer, StringBuffer(string_index), length);
   }
-  String& result =
-      String::ZoneHandle(Z, Symbols::FromUTF8(thread_, buffer, length));
+  result = Symbols::FromUTF8(thread_, buffer, length);
+  symbols_.SetAt(string_index, result);
   return result;
 }
 
@@ -365,14 +382,7 @@ const String& TranslationHelper::DartSymbolObfuscate(
 }
 
 String& TranslationHelper::DartSymbolObfuscate(StringIndex string_index) const {
-  intptr_t length = StringSize(string_index);
-  uint8_t* buffer = Z->Alloc<uint8_t>(length);
-  {
-    NoSafepointScope no_safepoint;
-    memmove(buffer, StringBuffer(string_index), length);
-  }
-  String& result =
-      String::ZoneHandle(Z, Symbols::FromUTF8(thread_, buffer, length));
+  String& result = DartSymbolPlain(string_index);
   if (IG->obfuscate()) {
     Obfuscator obfuscator(thread_, String::Handle(Z));
     result = obfuscator.Rename(result, true);
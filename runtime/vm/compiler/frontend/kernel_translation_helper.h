@@ -258,6 +258,9 @@ class TranslationHelper {
   TypedDataView& constants_table_;
   KernelProgramInfo& info_;
   Smi& name_index_handle_;
+  // Symbols of the strings in the string table, by string index. Allocated
+  // on first use.
+  Array& symbols_;
   GrowableObjectArray* potential_extension_libraries_ = nullptr;
   Function* expression_evaluation_function_ = nullptr;
 
@@ -11,6 +11,9 @@
 #include "vm/flags.h"
 
 namespace dart {
+
+DECLARE_FLAG(bool, skip_await_of_completed_futures);
+
 namespace kernel {
 
 #define Z (zone_)
@@ -1064,6 +1067,9 @@ void ScopeBuilder::VisitExpression() {
       helper_.ReadUInt();      // library index
       break;
     case kAwaitExpression:
+      if (FLAG_skip_await_of_completed_futures) {
+        needs_expr_temp_ = true;
+      }
       helper_.ReadPosition();  // read position.
       VisitExpression();       // read operand.
       if (helper_.ReadTag() == kSomething) {
@@ -1899,6 +1905,13 @@ void ScopeBuilder::AddSwitchVariable() {
                      Symbols::SwitchExpr(), AbstractType::dynamic_type());
     current_function_scope_->AddVariable(variable);
     result_->switch_variable = variable;
+    if (CompilerState::Current().is_aot()) {
+      LocalVariable* hash_variable =
+          MakeVariable(TokenPosition::kNoSource, TokenPosition::kNoSource,
+                       Symbols::SwitchHash(), AbstractType::dynamic_type());
+      current_function_scope_->AddVariable(hash_variable);
+      result_->switch_hash_variable = hash_variable;
+    }
   }
 }
 
@@ -183,6 +183,7 @@ class ScopeBuildingResult : public ZoneAllocated {
   ScopeBuildingResult()
       : type_arguments_variable(nullptr),
         switch_variable(nullptr),
+        switch_hash_variable(nullptr),
         finally_return_variable(nullptr),
         setter_value(nullptr),
         raw_variable_counter_(0) {}
@@ -206,6 +207,10 @@ class ScopeBuildingResult : public ZoneAllocated {
   // Non-nullptr when the function contains a switch statement.
   LocalVariable* switch_variable;
 
+  // Non-nullptr when the function contains a switch statement in AOT.
+  // Holds the hash code of the scrutinee of a switch over strings.
+  LocalVariable* switch_hash_variable;
+
   // Non-nullptr when the function contains a return inside a finally block.
   LocalVariable* finally_return_variable;
 
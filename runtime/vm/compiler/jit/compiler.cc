@@ -4,6 +4,8 @@
 
 #include "vm/compiler/jit/compiler.h"
 
+#include "vm/bytecode_reader.h"
+
 #if !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/code_patcher.h"
 #include "vm/compiler/assembler/assembler.h"
@@ -16,6 +18,7 @@
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/inliner.h"
 #include "vm/compiler/backend/linearscan.h"
+#include "vm/compiler/backend/loops.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
@@ -85,6 +88,16 @@ DEFINE_FLAG(bool,
             false,
             "Trace only optimizing compiler operations.");
 DEFINE_FLAG(bool, trace_bailout, false, "Print bailout from ssa compiler.");
+DEFINE_FLAG(int,
+            background_compiler_threads,
+            1,
+            "Maximum number of threads optimizing functions in the background "
+            "at the same time.");
+DEFINE_FLAG(bool,
+            jit_quick_tier,
+            false,
+            "Optimize functions without loops with a cheaper pipeline first "
+            "and reoptimize them with the full pipeline once they stay hot.");
 
 DECLARE_FLAG(bool, trace_failed_optimization_attempts);
 
@@ -213,6 +226,13 @@ DEFINE_RUNTIME_ENTRY(CompileFunction, 1) {
     SafepointReadRwLocker ml(thread, thread->isolate_group()->program_lock());
   }
 
+#if defined(DART_DYNAMIC_MODULES)
+  if (function.is_declared_in_bytecode() &&
+      bytecode::BytecodeReader::ReadLazyBytecode(function)) {
+    return;
+  }
+#endif  // defined(DART_DYNAMIC_MODULES)
+
   // Will throw if compilation failed (e.g. with compile-time error).
   function.EnsureHasCode();
 }
@@ -312,6 +332,7 @@ class CompileParsedFunctionHelper : public ValueObject {
   CodePtr FinalizeCompilation(compiler::Assembler* assembler,
                               FlowGraphCompiler* graph_compiler,
                               FlowGraph* flow_graph);
+  bool ShouldUseQuickTier(FlowGraph* flow_graph) const;
 
   ParsedFunction* parsed_function_;
   const bool optimized_;
@@ -418,6 +439,9 @@ CodePtr CompileParsedFunctionHelper::FinalizeCompilation(
     if (code_is_valid && Compiler::CanOptimizeFunction(thread(), function)) {
       if (osr_id() == Compiler::kNoOSRDeoptId) {
         function.InstallOptimizedCode(code);
+        if (flow_graph->is_quick_tier()) {
+          function.SetWasQuickOptimized(true);
+        }
       } else {
         // OSR is not compiled in background.
         ASSERT(!Compiler::IsBackgroundCompilation());
@@ -474,6 +498,22 @@ CodePtr CompileParsedFunctionHelper::FinalizeCompilation(
   return code.ptr();
 }
 
+// Functions are optimized by the quick tier only the first time they become
+// hot. Functions with loops go directly to the full pipeline: there is no OSR
+// out of optimized code, so a long running loop would stay in quick code.
+bool CompileParsedFunctionHelper::ShouldUseQuickTier(
+    FlowGraph* flow_graph) const {
+  const Function& function = parsed_function()->function();
+  if (!FLAG_jit_quick_tier || (osr_id() != Compiler::kNoOSRDeoptId) ||
+      function.ForceOptimize() || function.IsIrregexpFunction() ||
+      function.WasQuickOptimized()) {
+    return false;
+  }
+  const bool has_loops = flow_graph->GetLoopHierarchy().num_loops() > 0;
+  flow_graph->ResetLoopHierarchy();
+  return !has_loops;
+}
+
 // Return null if bailed out.
 CodePtr CompileParsedFunctionHelper::Compile() {
   ASSERT(!FLAG_precompiled_mode);
@@ -563,7 +603,16 @@ CodePtr CompileParsedFunctionHelper::Compile() {
         JitCallSpecializer call_specializer(flow_graph);
         pass_state.call_specializer = &call_specializer;
 
-        flow_graph = CompilerPass::RunPipeline(CompilerPass::kJIT, &pass_state);
+        flow_graph = CompilerPass::RunPipelineWithPasses(
+            &pass_state, {CompilerPass::kComputeSSA});
+        if (ShouldUseQuickTier(flow_graph)) {
+          flow_graph->mark_quick_tier();
+          flow_graph = CompilerPass::RunQuickPipeline(&pass_state,
+                                                      /*compute_ssa=*/false);
+        } else {
+          flow_graph = CompilerPass::RunPipeline(
+              CompilerPass::kJIT, &pass_state, /*compute_ssa=*/false);
+        }
       }
 
       compiler::ObjectPoolBuilder object_pool_builder;
@@ -963,7 +1012,9 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
 class QueueElement {
  public:
   explicit QueueElement(const Function& function)
-      : next_(nullptr), function_(function.ptr()) {}
+      : next_(nullptr),
+        function_(function.ptr()),
+        enqueue_micros_(OS::GetCurrentMonotonicMicros()) {}
 
   virtual ~QueueElement() {
     next_ = nullptr;
@@ -980,15 +1031,27 @@ class QueueElement {
     return reinterpret_cast<ObjectPtr*>(&function_);
   }
 
+  int64_t enqueue_micros() const { return enqueue_micros_; }
+
+  // Functions are reset to the minimal usage counter when they are enqueued
+  // (see OptimizeInvokedFunction), so this counts the invocations and loop
+  // iterations of their unoptimized code while waiting in the queue.
+  int64_t Hotness(dart::Function* scratch) const {
+    *scratch = function_;
+    return static_cast<int64_t>(scratch->usage_counter()) - kMinInt32;
+  }
+
  private:
   QueueElement* next_;
   FunctionPtr function_;
+  const int64_t enqueue_micros_;
 
   DISALLOW_COPY_AND_ASSIGN(QueueElement);
 };
 
 // Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
+// It implements a FIFO queue, using Peek, Add, Remove operations, and
+// RemoveHottest to take functions out in priority order.
 class BackgroundCompilationQueue {
  public:
   BackgroundCompilationQueue() : first_(nullptr), last_(nullptr) {}
@@ -1005,6 +1068,14 @@ class BackgroundCompilationQueue {
 
   bool IsEmpty() const { return first_ == nullptr; }
 
+  intptr_t Length() const {
+    intptr_t length = 0;
+    for (QueueElement* p = first_; p != nullptr; p = p->next()) {
+      length++;
+    }
+    return length;
+  }
+
   void Add(QueueElement* value) {
     ASSERT(value != nullptr);
     ASSERT(value->next() == nullptr);
@@ -1040,6 +1111,33 @@ class BackgroundCompilationQueue {
     return result;
   }
 
+  // Removes the element whose function got hottest while it was waiting,
+  // preferring the oldest one if several are equally hot.
+  QueueElement* RemoveHottest(Function* scratch) {
+    ASSERT(first_ != nullptr);
+    QueueElement* hottest_prev = nullptr;
+    QueueElement* hottest = first_;
+    int64_t hottest_hotness = hottest->Hotness(scratch);
+    for (QueueElement *prev = first_, *p = first_->next(); p != nullptr;
+         prev = p, p = p->next()) {
+      const int64_t hotness = p->Hotness(scratch);
+      if (hotness > hottest_hotness) {
+        hottest_prev = prev;
+        hottest = p;
+        hottest_hotness = hotness;
+      }
+    }
+    if (hottest_prev == nullptr) {
+      return Remove();
+    }
+    hottest_prev->set_next(hottest->next());
+    if (last_ == hottest) {
+      last_ = hottest_prev;
+    }
+    hottest->set_next(nullptr);
+    return hottest;
+  }
+
   bool ContainsObj(const Object& obj) const {
     QueueElement* p = first_;
     while (p != nullptr) {
@@ -1075,6 +1173,8 @@ class BackgroundCompilerTask : public ThreadPool::Task {
  private:
   virtual void Run() { background_compiler_->Run(); }
 
+  virtual Priority priority() const { return kCompilerPriority; }
+
   BackgroundCompiler* background_compiler_;
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundCompilerTask);
@@ -1085,7 +1185,7 @@ BackgroundCompiler::BackgroundCompiler(IsolateGroup* isolate_group)
       monitor_(),
       function_queue_(new BackgroundCompilationQueue()),
       running_(false),
-      done_(true),
+      running_tasks_(0),
       disabled_depth_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
@@ -1107,11 +1207,30 @@ void BackgroundCompiler::Run() {
     {
       SafepointMonitorLocker ml(&monitor_);
       if (running_ && !function_queue()->IsEmpty()) {
-        element = function_queue()->Remove();
+        element = function_queue()->RemoveHottest(&function);
         function ^= element->function();
       }
     }
     if (element != nullptr) {
+#if !defined(PRODUCT)
+      TimelineStream* stream = Timeline::GetCompilerStream();
+      ASSERT(stream != nullptr);
+      if (stream->enabled()) {
+        const char* function_name = function.ToQualifiedCString();
+        const int64_t hotness = element->Hotness(&function);
+        TimelineEvent* event = stream->StartEvent();
+        if (event != nullptr) {
+          event->Duration("BackgroundCompilationQueueWait",
+                          element->enqueue_micros(),
+                          OS::GetCurrentMonotonicMicros());
+          event->SetNumArguments(2);
+          event->CopyArgument(0, "function", function_name);
+          event->FormatArgument(1, "hotness", "%" Pd64, hotness);
+          event->Complete();
+        }
+      }
+#endif  // !defined(PRODUCT)
+      function ^= element->function();
       delete element;
       Compiler::CompileOptimizedFunction(thread, function,
                                          Compiler::kNoOSRDeoptId);
@@ -1136,12 +1255,11 @@ void BackgroundCompiler::Run() {
     if (running_ && !function_queue()->IsEmpty() &&
         Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
       // Successfully scheduled a new task.
-    } else {
+    } else if (--running_tasks_ == 0) {
       // Background compiler done. This notification must happen after the
       // thread leaves to group to avoid a shutdown race with the thread
       // registry.
       running_ = false;
-      done_ = true;
       ml.NotifyAll();
     }
   }
@@ -1154,24 +1272,29 @@ bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
 
   SafepointMonitorLocker ml(&monitor_);
   if (disabled_depth_ > 0) return false;
-  if (!running_ && done_) {
+  if (!running_ && (running_tasks_ == 0)) {
     running_ = true;
-    done_ = false;
-    // If we ever wanted to run the BG compiler on the
-    // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
-    // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
-    // notification would not work anymore.
-    if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
-      running_ = false;
-      done_ = true;
-      return false;
-    }
   }
 
   ASSERT(running_);
   if (function_queue()->ContainsObj(function)) {
     return true;
   }
+  // Start another task unless enough of them are running already. Tasks
+  // which find the queue empty exit immediately.
+  //
+  // If we ever wanted to run the BG compiler on the
+  // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
+  // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
+  // notification would not work anymore.
+  if (running_tasks_ < Utils::Maximum(1, FLAG_background_compiler_threads)) {
+    if (Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+      running_tasks_++;
+    } else if (running_tasks_ == 0) {
+      running_ = false;
+      return false;
+    }
+  }
   QueueElement* elem = new QueueElement(function);
   function_queue()->Add(elem);
   ml.NotifyAll();
@@ -1182,6 +1305,11 @@ void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   function_queue_->VisitObjectPointers(visitor);
 }
 
+intptr_t BackgroundCompiler::QueueLength() {
+  MonitorLocker ml(&monitor_);
+  return function_queue_->Length();
+}
+
 void BackgroundCompiler::Stop() {
   Thread* thread = Thread::Current();
   ASSERT(thread->isolate() == nullptr || !thread->BypassSafepoints());
@@ -1195,7 +1323,7 @@ void BackgroundCompiler::StopLocked(Thread* thread,
                                     SafepointMonitorLocker* locker) {
   running_ = false;
   function_queue_->Clear();
-  while (!done_) {
+  while (running_tasks_ > 0) {
     locker->Wait();
   }
 }
@@ -1219,7 +1347,7 @@ void BackgroundCompiler::Disable() {
 
   SafepointMonitorLocker ml(&monitor_);
   disabled_depth_++;
-  if (done_) return;
+  if (running_tasks_ == 0) return;
   StopLocked(thread, &ml);
 }
 
@@ -1227,6 +1355,12 @@ void BackgroundCompiler::Disable() {
 
 DEFINE_RUNTIME_ENTRY(CompileFunction, 1) {
   const Function& function = Function::CheckedHandle(zone, arguments.ArgAt(0));
+#if defined(DART_DYNAMIC_MODULES)
+  if (function.is_declared_in_bytecode() &&
+      bytecode::BytecodeReader::ReadLazyBytecode(function)) {
+    return;
+  }
+#endif  // defined(DART_DYNAMIC_MODULES)
   FATAL("Precompilation missed function %s (%s, %s)\n",
         function.ToLibNamePrefixedQualifiedCString(),
         function.token_pos().ToCString(),
@@ -1282,6 +1416,11 @@ void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   UNREACHABLE();
 }
 
+intptr_t BackgroundCompiler::QueueLength() {
+  UNREACHABLE();
+  return 0;
+}
+
 void BackgroundCompiler::Stop() {
   UNREACHABLE();
 }
@@ -82,9 +82,10 @@ class Compiler : public AllStatic {
   static void AbortBackgroundCompilation(intptr_t deopt_id, const char* msg);
 };
 
-// Class to run optimizing compilation in a background thread.
-// Current implementation: one task per isolate, it dies with the owning
-// isolate.
+// Class to run optimizing compilation in background threads.
+// Current implementation: up to --background_compiler_threads tasks per
+// isolate group, which compile the hottest queued functions first and die
+// with the owning isolate group.
 // No OSR compilation in the background compiler.
 class BackgroundCompiler {
  public:
@@ -105,6 +106,9 @@ class BackgroundCompiler {
   BackgroundCompilationQueue* function_queue() const { return function_queue_; }
   bool is_running() const { return running_; }
 
+  // The number of functions waiting to be compiled.
+  intptr_t QueueLength();
+
   void Run();
 
  private:
@@ -114,14 +118,14 @@ class BackgroundCompiler {
   void StopLocked(Thread* thread, SafepointMonitorLocker* done_locker);
   void Enable();
   void Disable();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return running_tasks_ > 0; }
 
   IsolateGroup* isolate_group_;
 
   Monitor monitor_;  // Controls access to the queue and running state.
   BackgroundCompilationQueue* function_queue_;
-  bool running_;  // While true, will try to read queue and compile.
-  bool done_;     // True if the thread is done.
+  bool running_;            // While true, will try to read queue and compile.
+  intptr_t running_tasks_;  // Number of tasks which are not done.
   int16_t disabled_depth_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(BackgroundCompiler);
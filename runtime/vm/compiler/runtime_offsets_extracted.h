@@ -698,7 +698,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -1425,7 +1425,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -2141,7 +2141,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -2870,7 +2870,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -3593,7 +3593,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -4318,7 +4318,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -5036,7 +5036,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -5764,7 +5764,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -6473,7 +6473,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x10;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -7192,7 +7192,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -7900,7 +7900,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x10;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -8621,7 +8621,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -9336,7 +9336,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -10053,7 +10053,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x28;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x38;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -10763,7 +10763,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x8;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0xc;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x10;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x1c;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x4;
@@ -11483,7 +11483,7 @@ static constexpr dart::compiler::target::word PcDescriptors_HeaderSize = 0x10;
 static constexpr dart::compiler::target::word Pointer_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word ReceivePort_InstanceSize = 0x20;
 static constexpr dart::compiler::target::word RecordType_InstanceSize = 0x38;
-static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word Script_InstanceSize = 0x50;
 static constexpr dart::compiler::target::word SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word Sentinel_InstanceSize = 0x8;
@@ -12272,7 +12272,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -13073,7 +13073,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x30;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -13882,7 +13882,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x30;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -14685,7 +14685,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -15490,7 +15490,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -16290,7 +16290,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -17092,7 +17092,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x30;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -17882,7 +17882,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x10;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -18674,7 +18674,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -19474,7 +19474,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -20268,7 +20268,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -21064,7 +21064,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x18;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x28;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x40;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
@@ -21855,7 +21855,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x10;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x1c;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x2c;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x30;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x28;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x4;
@@ -22648,7 +22648,7 @@ static constexpr dart::compiler::target::word AOT_ReceivePort_InstanceSize =
     0x20;
 static constexpr dart::compiler::target::word AOT_RecordType_InstanceSize =
     0x38;
-static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x58;
+static constexpr dart::compiler::target::word AOT_RegExp_InstanceSize = 0x60;
 static constexpr dart::compiler::target::word AOT_Script_InstanceSize = 0x48;
 static constexpr dart::compiler::target::word AOT_SendPort_InstanceSize = 0x18;
 static constexpr dart::compiler::target::word AOT_Sentinel_InstanceSize = 0x8;
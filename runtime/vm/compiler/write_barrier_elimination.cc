@@ -63,10 +63,11 @@ typedef DirectChainedHashMap<DefinitionIndexPairTrait> DefinitionIndexMap;
 // However, many instructions can trigger GC in unlikely cases, like
 // CheckStackOverflow and Box. To avoid interrupting write barrier elimination
 // across these instructions, the runtime ensures that any live temporaries
-// (except arrays) promoted during a scavenge caused by a non-Dart-call
-// instruction (see Instruction::CanCallDart()) will be added to the store
-// buffer. Additionally, if concurrent marking was initiated, the runtime
-// ensures that all live temporaries are also in the deferred marking stack.
+// (except arrays longer than Array::kMaxLengthForWriteBarrierElimination)
+// promoted during a scavenge caused by a non-Dart-call instruction (see
+// Instruction::CanCallDart()) will be added to the store buffer. Additionally,
+// if concurrent marking was initiated, the runtime ensures that all live
+// temporaries are also in the deferred marking stack.
 //
 // See also Thread::RememberLiveTemporaries() and
 // Thread::DeferredMarkLiveTemporaries().
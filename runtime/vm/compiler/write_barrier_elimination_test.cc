@@ -221,10 +221,10 @@ ISOLATE_UNIT_TEST_CASE(IRTest_WriteBarrierElimination_Regress43786) {
       SetFlagScope<bool> sfs(&FLAG_trace_write_barrier_elimination, true));
   const char* kScript = R"(
       foo() {
-        final root = List<dynamic>.filled(128, null);
+        final root = List<dynamic>.filled(1024, null);
         List<dynamic> last = root;
         for (int i = 0; i < 10 * 1024; ++i) {
-          final nc = List<dynamic>.filled(128, null);
+          final nc = List<dynamic>.filled(1024, null);
           last[0] = nc;
           last = nc;
         }
@@ -16,6 +16,9 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, background_compiler_threads);
+DECLARE_FLAG(bool, jit_quick_tier);
+
 ISOLATE_UNIT_TEST_CASE(CompileFunction) {
   const char* kScriptChars =
       "class A {\n"
@@ -100,6 +103,57 @@ ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionOnHelperThread) {
   delete m;
 }
 
+ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionsOnHelperThreads) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo() { return 42; }\n"
+      "  static bar() { return 43; }\n"
+      "  static baz() { return 44; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+  const char* kNames[] = {"foo", "bar", "baz"};
+  GrowableArray<Function*> functions;
+  for (const char* name : kNames) {
+    Function* func = &Function::Handle(
+        cls.LookupStaticFunction(String::Handle(String::New(name))));
+    CompilerTest::TestCompileFunction(*func);
+    EXPECT(func->HasCode());
+    functions.Add(func);
+  }
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  SetFlagScope<int> sfs(&FLAG_background_compiler_threads, 2);
+  auto isolate_group = thread->isolate_group();
+  for (Function* func : functions) {
+    func->SetUsageCounter(kMinInt32);
+    EXPECT(isolate_group->background_compiler()->EnqueueCompilation(*func));
+  }
+  Monitor* m = new Monitor();
+  {
+    SafepointMonitorLocker ml(m);
+    for (Function* func : functions) {
+      while (!func->HasOptimizedCode()) {
+        ml.Wait(1);
+      }
+    }
+  }
+  delete m;
+}
+
 ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   // Create a simple function and compile it without optimization.
   const char* kScriptChars =
@@ -127,6 +181,55 @@ ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   EXPECT(func.HasCode());
 }
 
+ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionWithQuickTier) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo(x) { return x + 1; }\n"
+      "  static bar(n) {\n"
+      "    var sum = 0;\n"
+      "    for (var i = 0; i < n; i++) sum += i;\n"
+      "    return sum;\n"
+      "  }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+
+  SetFlagScope<bool> sfs(&FLAG_jit_quick_tier, true);
+  Function& foo = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("foo"))));
+  Function& bar = Function::Handle(
+      cls.LookupStaticFunction(String::Handle(String::New("bar"))));
+  CompilerTest::TestCompileFunction(foo);
+  CompilerTest::TestCompileFunction(bar);
+
+  // The first optimization of a function without loops uses the quick tier.
+  Compiler::CompileOptimizedFunction(thread, foo);
+  EXPECT(foo.HasOptimizedCode());
+  EXPECT(foo.WasQuickOptimized());
+
+  // Reoptimization uses the full pipeline.
+  const Code& quick_code = Code::Handle(foo.CurrentCode());
+  Compiler::CompileOptimizedFunction(thread, foo);
+  EXPECT(foo.HasOptimizedCode());
+  EXPECT(foo.CurrentCode() != quick_code.ptr());
+
+  // Functions with loops are never optimized by the quick tier.
+  Compiler::CompileOptimizedFunction(thread, bar);
+  EXPECT(bar.HasOptimizedCode());
+  EXPECT(!bar.WasQuickOptimized());
+}
+
 ISOLATE_UNIT_TEST_CASE(RegenerateAllocStubs) {
   const char* kScriptChars =
       "class A {\n"
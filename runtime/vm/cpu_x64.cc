@@ -13,6 +13,10 @@
 namespace dart {
 
 DEFINE_FLAG(bool, use_sse41, true, "Use SSE 4.1 if available");
+DEFINE_FLAG(bool,
+            use_avx,
+            false,
+            "Use VEX encoded AVX instructions if available");
 
 void CPU::FlushICache(uword start, uword size) {
   // Nothing to be done here.
@@ -31,6 +35,7 @@ bool HostCPUFeatures::sse2_supported_ = true;
 bool HostCPUFeatures::sse4_1_supported_ = false;
 bool HostCPUFeatures::popcnt_supported_ = false;
 bool HostCPUFeatures::abm_supported_ = false;
+bool HostCPUFeatures::avx_supported_ = false;
 
 #if defined(DEBUG)
 bool HostCPUFeatures::initialized_ = false;
@@ -44,6 +49,7 @@ void HostCPUFeatures::Init() {
                       CpuInfo::FieldContains(kCpuInfoFeatures, "sse4.1");
   popcnt_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "popcnt");
   abm_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "abm");
+  avx_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "avx");
 #if defined(DEBUG)
   initialized_ = true;
 #endif
@@ -68,6 +74,7 @@ void HostCPUFeatures::Init() {
   sse4_1_supported_ = false;
   popcnt_supported_ = false;
   abm_supported_ = false;
+  avx_supported_ = false;
 #if defined(DEBUG)
   initialized_ = true;
 #endif
@@ -25,6 +25,7 @@ bool CpuId::sse2_ = false;
 bool CpuId::sse41_ = false;
 bool CpuId::popcnt_ = false;
 bool CpuId::abm_ = false;
+bool CpuId::avx_ = false;
 
 const char* CpuId::id_string_ = nullptr;
 const char* CpuId::brand_string_ = nullptr;
@@ -41,6 +42,18 @@ static void GetCpuId(int32_t level, uint32_t info[4]) {
 #endif
 }
 
+// Reads an extended control register, to check which register state the OS
+// saves on context switches.
+static uint64_t GetXcr(uint32_t xcr) {
+#if defined(DART_HOST_OS_WINDOWS)
+  return _xgetbv(xcr);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(xcr));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
 void CpuId::Init() {
   const int info_length = 4;
   uint32_t info[info_length] = {static_cast<uint32_t>(-1)};
@@ -72,10 +85,14 @@ void CpuId::Init() {
   CpuId::sse41_ = (info[2] & (1 << 19)) != 0;
   CpuId::sse2_ = (info[3] & (1 << 26)) != 0;
   CpuId::popcnt_ = (info[2] & (1 << 23)) != 0;
+  // AVX is only usable if the OS saves the XMM and YMM state (OSXSAVE and
+  // XCR0 bits 1 and 2).
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  CpuId::avx_ = (info[2] & (1 << 28)) != 0 && osxsave && ((GetXcr(0) & 6) == 6);
   if (FLAG_trace_cpuid) {
-    OS::PrintErr("sse41? %s sse2? %s popcnt? %s\n",
+    OS::PrintErr("sse41? %s sse2? %s popcnt? %s avx? %s\n",
                  CpuId::sse41_ ? "yes" : "no", CpuId::sse2_ ? "yes" : "no",
-                 CpuId::popcnt_ ? "yes" : "no");
+                 CpuId::popcnt_ ? "yes" : "no", CpuId::avx_ ? "yes" : "no");
   }
 
   GetCpuId(0x80000001, info);
@@ -152,6 +169,9 @@ const char* CpuId::field(CpuInfoIndices idx) {
       if (abm()) {
         p += snprintf(p, q - p, "abm ");
       }
+      if (avx()) {
+        p += snprintf(p, q - p, "avx ");
+      }
       // Remove last space before returning string.
       if (p != buffer) *(p - 1) = '\0';
       return Utils::StrDup(buffer);
@@ -58,6 +58,7 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, permanent_snapshot_pages);
 DECLARE_FLAG(bool, print_class_table);
 DEFINE_FLAG(bool, trace_shutdown, false, "Trace VM shutdown on stderr");
 
@@ -622,6 +623,36 @@ void Dart::WaitForIsolateShutdown() {
   ASSERT(OnlyVmIsolateLeft());
 }
 
+char* Dart::PrepareToExit() {
+  ASSERT(Isolate::Current() == nullptr);
+  if (!DartInitializationState::SetCleaningup()) {
+    return Utils::StrDup("VM already terminated.");
+  }
+
+  if (FLAG_trace_shutdown) {
+    OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Preparing to exit\n",
+                 UptimeMillis());
+  }
+
+#if !defined(PRODUCT)
+  Profiler::Cleanup();
+#endif  // !defined(PRODUCT)
+
+  Isolate::DisableIsolateCreation();
+
+#if defined(SUPPORT_TIMELINE)
+  // Safe while isolates are still running, recording events stops once the
+  // recorder is shutting down.
+  Timeline::Cleanup();
+#endif
+
+  if (FLAG_trace_shutdown) {
+    OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Done preparing to exit\n",
+                 UptimeMillis());
+  }
+  return nullptr;
+}
+
 char* Dart::Cleanup() {
   ASSERT(Isolate::Current() == nullptr);
   if (!DartInitializationState::SetCleaningup()) {
@@ -861,6 +892,12 @@ ErrorPtr Dart::InitIsolateGroupFromSnapshot(
 
     T->SetupDartMutatorStateDependingOnSnapshot(IG);
 
+#if defined(DART_PRECOMPILED_RUNTIME)
+    if (FLAG_permanent_snapshot_pages) {
+      IG->heap()->old_space()->MakePagesPermanent();
+    }
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
 #if defined(SUPPORT_TIMELINE)
     if (tbes.enabled()) {
       tbes.SetNumArguments(2);
@@ -35,6 +35,10 @@ class Dart : public AllStatic {
   // (caller owns error message and has to free it).
   static char* Cleanup();
 
+  // Like Cleanup, but only flushes the output written on shutdown and leaves
+  // isolates running, for embedders which exit the process right after.
+  static char* PrepareToExit();
+
   // Returns true if the VM is initialized.
   static bool IsInitialized();
   static bool IsShuttingDown();
@@ -43,6 +43,7 @@
 #include "vm/os_thread.h"
 #include "vm/port.h"
 #include "vm/profiler.h"
+#include "vm/profiler_export.h"
 #include "vm/profiler_service.h"
 #include "vm/program_visitor.h"
 #include "vm/resolver.h"
@@ -1175,6 +1176,11 @@ DART_EXPORT char* Dart_Cleanup() {
   return Dart::Cleanup();
 }
 
+DART_EXPORT char* Dart_PrepareToExit() {
+  CHECK_NO_ISOLATE(Isolate::Current());
+  return Dart::PrepareToExit();
+}
+
 DART_EXPORT char* Dart_SetVMFlags(int argc, const char** argv) {
   return Flags::ProcessCommandLineFlags(argc, argv);
 }
@@ -4044,6 +4050,22 @@ class AcquiredData {
   DISALLOW_COPY_AND_ASSIGN(AcquiredData);
 };
 
+// Whether the data of a typed data object is outside of the heap.
+static bool IsExternalTypedDataOrView(Zone* zone,
+                                      Dart_Handle object,
+                                      intptr_t class_id) {
+  if (IsExternalTypedDataClassId(class_id)) {
+    return true;
+  }
+  if (IsTypedDataClassId(class_id)) {
+    return false;
+  }
+  const auto& view_obj = Api::UnwrapTypedDataViewHandle(zone, object);
+  ASSERT(!view_obj.IsNull());
+  return ExternalTypedData::IsExternalTypedData(
+      Instance::Handle(zone, view_obj.typed_data()));
+}
+
 DART_EXPORT Dart_Handle Dart_TypedDataAcquireData(Dart_Handle object,
                                                   Dart_TypedData_Type* type,
                                                   void** data,
@@ -4071,8 +4093,6 @@ DART_EXPORT Dart_Handle Dart_TypedDataAcquireData(Dart_Handle object,
   intptr_t size_in_bytes = 0;
   void* data_tmp = nullptr;
   bool external = false;
-  T->IncrementNoSafepointScopeDepth();
-  START_NO_CALLBACK_SCOPE(T);
   if (IsExternalTypedDataClassId(class_id)) {
     const ExternalTypedData& obj =
         Api::UnwrapExternalTypedDataHandle(Z, object);
@@ -4109,6 +4129,12 @@ DART_EXPORT Dart_Handle Dart_TypedDataAcquireData(Dart_Handle object,
       external = true;
     }
   }
+  if (!external) {
+    // The data is in the heap, so GC must not move it until it is released.
+    // External data does not move, and the handle keeps it alive.
+    T->IncrementNoSafepointScopeDepth();
+    START_NO_CALLBACK_SCOPE(T);
+  }
   if (FLAG_verify_acquired_data) {
     {
       NoSafepointScope no_safepoint(T);
@@ -4165,8 +4191,10 @@ DART_EXPORT Dart_Handle Dart_TypedDataReleaseData(Dart_Handle object) {
     table->SetValue(obj.ptr(), 0);  // Delete entry from table.
     delete ad;
   }
-  T->DecrementNoSafepointScopeDepth();
-  END_NO_CALLBACK_SCOPE(T);
+  if (!IsExternalTypedDataOrView(Z, object, class_id)) {
+    T->DecrementNoSafepointScopeDepth();
+    END_NO_CALLBACK_SCOPE(T);
+  }
   return Api::Success();
 }
 
@@ -4703,6 +4731,41 @@ DART_EXPORT Dart_Handle Dart_InvokeClosure(Dart_Handle closure,
   return Api::NewHandle(T, DartEntry::InvokeClosure(T, args));
 }
 
+DART_EXPORT Dart_Handle Dart_PrepareInvoke(Dart_Handle target,
+                                           Dart_Handle name,
+                                           int number_of_arguments) {
+  if (number_of_arguments < 0) {
+    return Api::NewError(
+        "%s expects argument 'number_of_arguments' to be non-negative.",
+        CURRENT_FUNC);
+  }
+  // Getting a method tears it off, so the closure is bound to the receiver
+  // and the name is resolved only once.
+  Dart_Handle callable = Dart_GetField(target, name);
+  if (Api::IsError(callable)) {
+    return callable;
+  }
+
+  DARTSCOPE(Thread::Current());
+  CHECK_CALLBACK_STATE(T);
+  const Instance& instance = Api::UnwrapInstanceHandle(Z, callable);
+  Function& function = Function::Handle(Z);
+  if (instance.IsNull() || !instance.IsCallable(&function)) {
+    return Api::NewError("%s: '%s' is not callable.", CURRENT_FUNC,
+                         Api::UnwrapStringHandle(Z, name).ToCString());
+  }
+  const intptr_t kTypeArgsLen = 0;
+  const ArgumentsDescriptor args_desc(Array::Handle(
+      Z, ArgumentsDescriptor::NewBoxed(kTypeArgsLen, number_of_arguments + 1)));
+  if (!function.AreValidArguments(args_desc, nullptr)) {
+    return Api::NewError("%s: '%s' does not accept %d arguments.",
+                         CURRENT_FUNC,
+                         Api::UnwrapStringHandle(Z, name).ToCString(),
+                         number_of_arguments);
+  }
+  return callable;
+}
+
 DART_EXPORT Dart_Handle Dart_GetField(Dart_Handle container, Dart_Handle name) {
   DARTSCOPE(Thread::Current());
   API_TIMELINE_DURATION(T);
@@ -6373,6 +6436,92 @@ DART_EXPORT void Dart_SetTimelineRecorderCallback(
 #endif
 }
 
+DART_EXPORT void Dart_SetCpuProfileExportCallback(
+    Dart_CpuProfileExportCallback callback,
+    void* context,
+    int64_t period_micros) {
+#if !defined(PRODUCT)
+  CpuProfileExporter::SetCallback(callback, context, period_micros);
+#endif
+}
+
+DART_EXPORT Dart_Handle Dart_WriteCodeCoverage(bool reset,
+                                               uint8_t** buffer,
+                                               intptr_t* buffer_length) {
+  Thread* thread = Thread::Current();
+  DARTSCOPE(thread);
+  if (buffer == nullptr) {
+    RETURN_NULL_ERROR(buffer);
+  }
+  if (buffer_length == nullptr) {
+    RETURN_NULL_ERROR(buffer_length);
+  }
+  const auto& coverage =
+      Array::Handle(Z, T->isolate_group()->object_store()->code_coverage());
+  if (coverage.IsNull()) {
+    return Api::NewError("%s: The code does not record coverage. Compile it "
+                         "with --aot_coverage.",
+                         CURRENT_FUNC);
+  }
+
+  // Note: can't use JSONStream in PRODUCT builds.
+  ZoneTextBuffer text_buffer(Api::TopScope(T)->zone(), 64 * KB);
+  // A position is a hit if any copy of its function executed it.
+  struct Position {
+    intptr_t pos;
+    bool hit;
+  };
+  MallocGrowableArray<Position> positions;
+  auto& uri = String::Handle(Z);
+  auto& arrays = Array::Handle(Z);
+  auto& array = Array::Handle(Z);
+  text_buffer.AddString("{\"type\":\"CodeCoverage\",\"scripts\":[");
+  for (intptr_t i = 0; i < coverage.Length(); i += 2) {
+    uri ^= coverage.At(i);
+    arrays ^= coverage.At(i + 1);
+    positions.Clear();
+    for (intptr_t j = 0; j < arrays.Length(); j++) {
+      array ^= arrays.At(j);
+      for (intptr_t k = 0; k < array.Length(); k += 2) {
+        bool is_branch_coverage;
+        const TokenPosition token_pos = TokenPosition::DecodeCoveragePosition(
+            Smi::Value(Smi::RawCast(array.At(k))), &is_branch_coverage);
+        positions.Add({token_pos.Pos(), array.At(k + 1) != Smi::New(0)});
+        if (reset) {
+          array.SetAt(k + 1, Object::smi_zero());
+        }
+      }
+    }
+    positions.Sort([](const Position* a, const Position* b) {
+      if (a->pos != b->pos) return a->pos < b->pos ? -1 : 1;
+      return (a->hit == b->hit) ? 0 : (a->hit ? -1 : 1);
+    });
+
+    if (i > 0) text_buffer.AddChar(',');
+    text_buffer.AddString("{\"uri\":\"");
+    text_buffer.AddEscapedString(uri.ToCString());
+    text_buffer.AddChar('"');
+    for (const bool hits : {true, false}) {
+      text_buffer.AddString(hits ? ",\"hits\":[" : ",\"misses\":[");
+      bool first = true;
+      for (intptr_t j = 0; j < positions.length(); j++) {
+        // Hits are sorted first, so only the first entry of a position counts.
+        if ((j > 0) && (positions[j].pos == positions[j - 1].pos)) continue;
+        if (positions[j].hit != hits) continue;
+        text_buffer.Printf(first ? "%" Pd : ",%" Pd, positions[j].pos);
+        first = false;
+      }
+      text_buffer.AddChar(']');
+    }
+    text_buffer.AddChar('}');
+  }
+  text_buffer.AddString("]}");
+
+  *buffer_length = text_buffer.length();
+  *reinterpret_cast<char**>(buffer) = text_buffer.buffer();
+  return Api::Success();
+}
+
 DART_EXPORT void Dart_SetThreadName(const char* name) {
   OSThread* thread = OSThread::Current();
   if (thread == nullptr) {
@@ -6974,4 +7123,25 @@ DART_EXPORT char* Dart_WriteHeapSnapshot(
 #endif
 }
 
+DART_EXPORT char* Dart_WriteHeapSnapshotInChildProcess(
+    Dart_HeapSnapshotWriteChunkCallback write,
+    void* context,
+    int64_t* child_pid) {
+#if defined(DART_ENABLE_HEAP_SNAPSHOT_WRITER)
+  DARTSCOPE(Thread::Current());
+  CallbackHeapSnapshotWriter callback_writer(T, write, context);
+  HeapSnapshotWriter writer(T, &callback_writer);
+  const intptr_t pid = writer.WriteInChildProcess();
+  if (pid < 0) {
+    return Utils::StrDup("Failed to fork a process for the heap snapshot.");
+  }
+  if (child_pid != nullptr) {
+    *child_pid = pid;
+  }
+  return nullptr;
+#else
+  return Utils::StrDup("VM is built without the heap snapshot writer.");
+#endif
+}
+
 }  // namespace dart
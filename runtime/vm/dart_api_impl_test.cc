@@ -6,6 +6,11 @@
 
 #include <thread>  // NOLINT(build/c++11)
 
+#if defined(DART_HOST_OS_LINUX)
+#include <sys/wait.h>  // NOLINT
+#include <unistd.h>    // NOLINT
+#endif
+
 #include "bin/builtin.h"
 #include "bin/dartutils.h"
 #include "include/dart_api.h"
@@ -3274,6 +3279,32 @@ TEST_CASE(DartAPI_ExternalAllocationDuringNoCallbackScope) {
             Thread::Current()->heap()->Collections(Heap::kNew));
 }
 
+TEST_CASE(DartAPI_ExternalTypedDataAcquireAllowsGC) {
+  uint8_t data[] = {0, 11, 22, 33, 44, 55, 66, 77};
+  Dart_Handle bytes =
+      Dart_NewExternalTypedData(Dart_TypedData_kUint8, data, ARRAY_SIZE(data));
+  EXPECT_VALID(bytes);
+
+  Dart_TypedData_Type type;
+  void* raw_data;
+  intptr_t len;
+  EXPECT_VALID(Dart_TypedDataAcquireData(bytes, &type, &raw_data, &len));
+  EXPECT(raw_data == data);
+
+  // The data is not in the heap, so acquiring it does not prevent GC.
+  intptr_t gc_count_before = Thread::Current()->heap()->Collections(Heap::kNew);
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectNewSpace();
+  }
+  EXPECT_LT(gc_count_before,
+            Thread::Current()->heap()->Collections(Heap::kNew));
+  EXPECT_VALID(Dart_NewInteger(kMaxInt64));
+  EXPECT(raw_data == data);
+
+  EXPECT_VALID(Dart_TypedDataReleaseData(bytes));
+}
+
 static void ExternalTypedDataAccessTests(Dart_Handle obj,
                                          Dart_TypedData_Type expected_type,
                                          uint8_t data[],
@@ -7342,6 +7373,53 @@ TEST_CASE(DartAPI_InvokeNoSuchMethod) {
   EXPECT_EQ(3, value);
 }
 
+TEST_CASE(DartAPI_PrepareInvoke) {
+  const char* kScriptChars =
+      "class Adder {\n"
+      "  Adder(this.base);\n"
+      "  final int base;\n"
+      "  int add(int i) => base + i;\n"
+      "  static int twice(int i) => 2 * i;\n"
+      "}\n"
+      "int _square(int i) => i * i;\n"
+      "Adder makeAdder() => Adder(100);\n";
+  SetFlagScope<bool> sfs(&FLAG_verify_entry_points, false);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  Dart_Handle adder = Dart_Invoke(lib, NewString("makeAdder"), 0, nullptr);
+  EXPECT_VALID(adder);
+  Dart_Handle type =
+      Dart_GetNonNullableType(lib, NewString("Adder"), 0, nullptr);
+  EXPECT_VALID(type);
+
+  Dart_Handle args[1];
+  int64_t value = 0;
+
+  Dart_Handle square = Dart_PrepareInvoke(lib, NewString("_square"), 1);
+  EXPECT_VALID(square);
+  Dart_Handle add = Dart_PrepareInvoke(adder, NewString("add"), 1);
+  EXPECT_VALID(add);
+  Dart_Handle twice = Dart_PrepareInvoke(type, NewString("twice"), 1);
+  EXPECT_VALID(twice);
+  for (intptr_t i = 0; i < 3; i++) {
+    args[0] = Dart_NewInteger(i);
+    Dart_Handle result = Dart_InvokeClosure(square, 1, args);
+    EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+    EXPECT_EQ(i * i, value);
+    result = Dart_InvokeClosure(add, 1, args);
+    EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+    EXPECT_EQ(100 + i, value);
+    result = Dart_InvokeClosure(twice, 1, args);
+    EXPECT_VALID(Dart_IntegerToInt64(result, &value));
+    EXPECT_EQ(2 * i, value);
+  }
+
+  EXPECT_ERROR(Dart_PrepareInvoke(adder, NewString("add"), 2),
+               "does not accept 2 arguments");
+  EXPECT_ERROR(Dart_PrepareInvoke(adder, NewString("base"), 0),
+               "is not callable");
+  EXPECT(Dart_IsError(Dart_PrepareInvoke(lib, NewString("missing"), 0)));
+}
+
 TEST_CASE(DartAPI_InvokeClosure) {
   const char* kScriptChars =
       "class InvokeClosure {\n"
@@ -11054,6 +11132,53 @@ TEST_CASE(DartAPI_WriteHeapSnapshot) {
   EXPECT_GT(context.bytes_written, 0);
   EXPECT(context.saw_last_chunk);
 }
+
+#if defined(DART_HOST_OS_LINUX)
+TEST_CASE(DartAPI_WriteHeapSnapshotInChildProcess) {
+  int fds[2];
+  ASSERT(pipe(fds) == 0);
+
+  // The callback runs in the child, so it can only report back through the
+  // pipe.
+  int64_t child_pid = -1;
+  char* error = Dart_WriteHeapSnapshotInChildProcess(
+      [](void* context, uint8_t* buffer, intptr_t size, bool is_last) {
+        const int fd = *reinterpret_cast<int*>(context);
+        intptr_t written = 0;
+        while (written < size) {
+          const ssize_t result = write(fd, buffer + written, size - written);
+          if (result <= 0) break;
+          written += result;
+        }
+        free(buffer);
+      },
+      &fds[1], &child_pid);
+  close(fds[1]);
+  EXPECT(error == nullptr);
+  EXPECT_GT(child_pid, 0);
+
+  char magic[8];
+  intptr_t bytes_read = 0;
+  intptr_t total = 0;
+  uint8_t buffer[4096];
+  ssize_t result;
+  while ((result = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    for (intptr_t i = 0; i < result && bytes_read < 8; i++) {
+      magic[bytes_read++] = buffer[i];
+    }
+    total += result;
+  }
+  close(fds[0]);
+
+  int status = 0;
+  EXPECT_EQ(child_pid, waitpid(child_pid, &status, 0));
+  EXPECT(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+  EXPECT_EQ(8, bytes_read);
+  EXPECT(strncmp(magic, "dartheap", 8) == 0);
+  EXPECT_GT(total, 8);
+}
+#endif  // defined(DART_HOST_OS_LINUX)
 #endif  // defined(DART_ENABLE_HEAP_SNAPSHOT_WRITER)
 
 }  // namespace dart
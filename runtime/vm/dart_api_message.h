@@ -10,6 +10,7 @@
 #include "vm/allocation.h"
 #include "vm/dart_api_state.h"
 #include "vm/message.h"
+#include "vm/object.h"
 #include "vm/raw_object.h"
 #include "vm/snapshot.h"
 
@@ -18,12 +19,39 @@ namespace dart {
 // This class handles translation of certain ObjectPtrs to CObjects for
 // NativeMessageHandlers.
 //
-// TODO(zra): Expand to support not only null, but also other VM heap objects
-// as well.
+// TODO(zra): Expand to support not only null and bools, but also other VM heap
+// objects as well.
 class ApiObjectConverter : public AllStatic {
  public:
   static bool CanConvert(const ObjectPtr raw_obj) {
-    return !raw_obj->IsHeapObject() || (raw_obj == Object::null());
+    return !raw_obj->IsHeapObject() || (raw_obj == Object::null()) ||
+           (raw_obj == Object::bool_true().ptr()) ||
+           (raw_obj == Object::bool_false().ptr());
+  }
+
+  // The inverse of Convert, for [c_obj]s which are posted without being
+  // serialized. Returns Object::sentinel() for any other [c_obj].
+  static ObjectPtr ConvertBack(const Dart_CObject* c_obj) {
+    switch (c_obj->type) {
+      case Dart_CObject_kNull:
+        return Object::null();
+      case Dart_CObject_kBool:
+        return c_obj->value.as_bool ? Object::bool_true().ptr()
+                                    : Object::bool_false().ptr();
+      case Dart_CObject_kInt32:
+        if (Smi::IsValid(c_obj->value.as_int32)) {
+          return Smi::New(c_obj->value.as_int32);
+        }
+        break;
+      case Dart_CObject_kInt64:
+        if (Smi::IsValid(c_obj->value.as_int64)) {
+          return Smi::New(c_obj->value.as_int64);
+        }
+        break;
+      default:
+        break;
+    }
+    return Object::sentinel().ptr();
   }
 
   static bool Convert(const ObjectPtr raw_obj, Dart_CObject* c_obj) {
@@ -31,6 +59,10 @@ class ApiObjectConverter : public AllStatic {
       ConvertSmi(static_cast<const SmiPtr>(raw_obj), c_obj);
     } else if (raw_obj == Object::null()) {
       ConvertNull(c_obj);
+    } else if (raw_obj == Object::bool_true().ptr() ||
+               raw_obj == Object::bool_false().ptr()) {
+      c_obj->type = Dart_CObject_kBool;
+      c_obj->value.as_bool = raw_obj == Object::bool_true().ptr();
     } else {
       return false;
     }
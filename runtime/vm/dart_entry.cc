@@ -5,6 +5,7 @@
 #include "vm/dart_entry.h"
 
 #include "platform/safe_stack.h"
+#include "vm/bytecode_reader.h"
 #include "vm/class_finalizer.h"
 #include "vm/debugger.h"
 #include "vm/dispatch_table.h"
@@ -132,6 +133,10 @@ ObjectPtr DartEntry::InvokeFunction(const Function& function,
   ASSERT(!function.IsNull());
 
 #if defined(DART_DYNAMIC_MODULES)
+  if (!function.HasBytecode() && function.is_declared_in_bytecode() &&
+      !function.is_abstract()) {
+    bytecode::BytecodeReader::ReadLazyBytecode(function);
+  }
   if (function.HasBytecode()) {
     // SuspendLongJumpScope suspend_long_jump_scope(thread);
     TransitionToGenerated transition(thread);
@@ -1516,91 +1516,131 @@ bool Debugger::SetResumeAction(ResumeAction action,
   }
 }
 
-// Deoptimize all functions in the isolate.
-// TODO(hausner): Actually we only need to deoptimize those functions
-// that inline the function that contains the newly created breakpoint.
-// We currently don't have this info so we deoptimize all functions.
-void Debugger::DeoptimizeWorld() {
-#if defined(DART_PRECOMPILED_RUNTIME)
-  UNREACHABLE();
-#else
-  if (FLAG_trace_deoptimization) {
-    THR_Print("Deopt for debugger\n");
-  }
-  isolate_->set_has_attempted_stepping(true);
-
-  DeoptimizeFunctionsOnStack();
-
-  // Iterate over all classes, deoptimize functions.
-  // TODO(hausner): Could possibly be combined with RemoveOptimizedCode()
-  const ClassTable& class_table = *isolate_->group()->class_table();
-  auto thread = Thread::Current();
-  auto isolate_group = thread->isolate_group();
+#if !defined(DART_PRECOMPILED_RUNTIME)
+// Calls |callback| for every function of the isolate group, including
+// implicit closure functions and closures.
+static void ForEachFunction(
+    Thread* thread,
+    const std::function<void(const Function&)>& callback) {
+  const ClassTable& class_table = *thread->isolate_group()->class_table();
   auto zone = thread->zone();
-  CallSiteResetter resetter(zone);
   Class& cls = Class::Handle(zone);
   Array& functions = Array::Handle(zone);
   Function& function = Function::Handle(zone);
-  Code& code = Code::Handle(zone);
+  Function& closure = Function::Handle(zone);
 
   const intptr_t num_classes = class_table.NumCids();
   const intptr_t num_tlc_classes = class_table.NumTopLevelCids();
-  SafepointWriteRwLocker ml(thread, isolate_group->program_lock());
   for (intptr_t i = 1; i < num_classes + num_tlc_classes; i++) {
     const intptr_t cid =
         i < num_classes ? i : ClassTable::CidFromTopLevelIndex(i - num_classes);
     if (class_table.HasValidClassAt(cid)) {
       cls = class_table.At(cid);
-
-      // Disable optimized functions.
       functions = cls.functions();
       if (!functions.IsNull()) {
         intptr_t num_functions = functions.Length();
         for (intptr_t pos = 0; pos < num_functions; pos++) {
           function ^= functions.At(pos);
           ASSERT(!function.IsNull());
-          // Force-optimized functions don't have unoptimized code and can't
-          // deoptimize. Their optimized codes are still valid.
-          if (!function.ForceOptimize()) {
-            if (function.HasOptimizedCode()) {
-              function.SwitchToUnoptimizedCode();
-            }
-            code = function.unoptimized_code();
-            if (!code.IsNull()) {
-              resetter.ResetSwitchableCalls(code);
-            }
-          }
-          // Also disable any optimized implicit closure functions.
+          callback(function);
           if (function.HasImplicitClosureFunction()) {
-            function = function.ImplicitClosureFunction();
-            if (!function.ForceOptimize()) {
-              if (function.HasOptimizedCode()) {
-                function.SwitchToUnoptimizedCode();
-              }
-              code = function.unoptimized_code();
-              if (!code.IsNull()) {
-                resetter.ResetSwitchableCalls(code);
-              }
-            }
+            closure = function.ImplicitClosureFunction();
+            callback(closure);
           }
         }
       }
     }
   }
 
-  // Disable optimized closure functions.
   ClosureFunctionsCache::ForAllClosureFunctions([&](const Function& function) {
-    if (!function.ForceOptimize()) {
-      if (function.HasOptimizedCode()) {
-        function.SwitchToUnoptimizedCode();
-      }
-      code = function.unoptimized_code();
-      if (!code.IsNull()) {
-        resetter.ResetSwitchableCalls(code);
+    callback(function);
+    return true;  // Continue iteration.
+  });
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+// Deoptimize all functions in the isolate. This is needed for stepping, which
+// can enter any function. Breakpoints use DeoptimizeFunctions instead.
+void Debugger::DeoptimizeWorld() {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  UNREACHABLE();
+#else
+  if (FLAG_trace_deoptimization) {
+    THR_Print("Deopt for debugger\n");
+  }
+  isolate_->set_has_attempted_stepping(true);
+
+  DeoptimizeFunctionsOnStack();
+
+  auto thread = Thread::Current();
+  auto isolate_group = thread->isolate_group();
+  auto zone = thread->zone();
+  CallSiteResetter resetter(zone);
+  Code& code = Code::Handle(zone);
+
+  SafepointWriteRwLocker ml(thread, isolate_group->program_lock());
+  ForEachFunction(thread, [&](const Function& function) {
+    // Force-optimized functions don't have unoptimized code and can't
+    // deoptimize. Their optimized codes are still valid.
+    if (function.ForceOptimize()) return;
+    if (function.HasOptimizedCode()) {
+      function.SwitchToUnoptimizedCode();
+    }
+    code = function.unoptimized_code();
+    if (!code.IsNull()) {
+      resetter.ResetSwitchableCalls(code);
+    }
+  });
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
+// Deoptimize only the code which breakpoints in |functions| apply to: the
+// optimized code of these functions and the optimized code which inlines any
+// of them. The compiler neither optimizes nor inlines functions with
+// breakpoints, so all other optimized code can be kept.
+void Debugger::DeoptimizeFunctions(const GrowableObjectArray& functions) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  UNREACHABLE();
+#else
+  if (FLAG_trace_deoptimization) {
+    THR_Print("Deopt for breakpoint\n");
+  }
+  auto thread = Thread::Current();
+  auto isolate_group = thread->isolate_group();
+  auto zone = thread->zone();
+  Array& inlined_functions = Array::Handle(zone);
+  const auto is_affected = [&](const Code& code) {
+    inlined_functions = code.inlined_id_to_function();
+    for (intptr_t i = 0; i < functions.Length(); i++) {
+      if (code.function() == functions.At(i)) return true;
+      if (inlined_functions.IsNull()) continue;
+      for (intptr_t j = 0; j < inlined_functions.Length(); j++) {
+        if (inlined_functions.At(j) == functions.At(i)) return true;
       }
     }
-    return true;  // Continue iteration.
+    return false;
+  };
+
+  DeoptimizeFunctionsOnStack(is_affected);
+
+  CallSiteResetter resetter(zone);
+  Code& code = Code::Handle(zone);
+  SafepointWriteRwLocker ml(thread, isolate_group->program_lock());
+  ForEachFunction(thread, [&](const Function& function) {
+    if (function.ForceOptimize() || !function.HasOptimizedCode()) return;
+    code = function.CurrentCode();
+    if (is_affected(code)) {
+      function.SwitchToUnoptimizedCode();
+    }
   });
+  Function& function = Function::Handle(zone);
+  for (intptr_t i = 0; i < functions.Length(); i++) {
+    function ^= functions.At(i);
+    code = function.unoptimized_code();
+    if (!code.IsNull()) {
+      resetter.ResetSwitchableCalls(code);
+    }
+  }
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 }
 
@@ -1616,6 +1656,18 @@ void Debugger::RunWithStoppedDeoptimizedWorld(std::function<void()> fun) {
 #endif
 }
 
+void Debugger::RunWithStoppedDeoptimizedFunctions(
+    const GrowableObjectArray& functions,
+    std::function<void()> fun) {
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  RELOAD_OPERATION_SCOPE(Thread::Current());
+  group_debugger()->isolate_group()->RunWithStoppedMutators([&]() {
+    DeoptimizeFunctions(functions);
+    fun();
+  });
+#endif
+}
+
 void Debugger::NotifySingleStepping(bool value) {
   if (value) {
     // Setting breakpoint requires unoptimized code, make sure we stop all
@@ -2705,8 +2757,8 @@ ErrorPtr Debugger::SetBreakpoint(
       BreakpointLocation* loc = nullptr;
       // Ensure that code stays deoptimized (and background compiler disabled)
       // until we have installed the breakpoint (at which point the compiler
-      // will not try to optimize it anymore).
-      RunWithStoppedDeoptimizedWorld([&] {
+      // will not try to optimize or inline it anymore).
+      RunWithStoppedDeoptimizedFunctions(code_functions, [&] {
         loc = SetCodeBreakpoints(scripts, token_pos, last_token_pos,
                                  requested_line, requested_column,
                                  exact_token_pos, code_functions);
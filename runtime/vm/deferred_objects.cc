@@ -143,6 +143,10 @@ void DeferredRetAddr::Materialize(DeoptContext* deopt_context) {
     if (deopt_context->HasDeoptFlag(ICData::kGeneralized)) {
       function.SetProhibitsBoundsCheckGeneralization(true);
     }
+
+    if (deopt_context->HasDeoptFlag(ICData::kSpeculativeTypeArguments)) {
+      function.SetProhibitsTypeArgumentsSpeculation(true);
+    }
   }
 }
 
@@ -152,11 +152,101 @@ StringPtr DoubleToStringAsPrecision(double d, int precision) {
   return String::New(builder.Finalize());
 }
 
+#if defined(DOUBLE_CONVERSION_CORRECT_DOUBLE_OPERATIONS)
+// Parses the common numerals of the form [+-]digits[.digits][e[+-]digits]
+// whose value can be computed with a single correctly rounded floating
+// point operation: the significand has at most 53 bits and the power of ten
+// is exactly representable (Clinger's fast path). Returns false for all other
+// input, which is then left to double-conversion.
+static bool FastCStringToDouble(const char* str,
+                                intptr_t length,
+                                double* result) {
+  static const double kExactPowersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+  };
+  const intptr_t kMaxExactPowerOfTen = ARRAY_SIZE(kExactPowersOfTen) - 1;
+  const uint64_t kMaxExactSignificand = static_cast<uint64_t>(1) << 53;
+  const intptr_t kMaxSignificandDigits = 19;
+
+  const char* p = str;
+  const char* end = str + length;
+  bool negative = false;
+  if (*p == '-' || *p == '+') {
+    negative = (*p == '-');
+    p++;
+  }
+  if (p == end || !Utils::IsDecimalDigit(*p)) return false;
+  // Leave numerals with leading zeros to double-conversion.
+  if (*p == '0' && (p + 1) < end && Utils::IsDecimalDigit(p[1])) {
+    return false;
+  }
+
+  uint64_t significand = 0;
+  intptr_t significand_digits = 0;
+  intptr_t exponent = 0;
+  for (; p < end && Utils::IsDecimalDigit(*p); p++) {
+    if (significand != 0 || *p != '0') {
+      if (++significand_digits > kMaxSignificandDigits) return false;
+      significand = significand * 10 + (*p - '0');
+    }
+  }
+  if (p < end && *p == '.') {
+    p++;
+    if (p == end || !Utils::IsDecimalDigit(*p)) return false;
+    for (; p < end && Utils::IsDecimalDigit(*p); p++) {
+      if (significand != 0 || *p != '0') {
+        if (++significand_digits > kMaxSignificandDigits) return false;
+        significand = significand * 10 + (*p - '0');
+      }
+      exponent--;
+    }
+  }
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    p++;
+    bool negative_exponent = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+      negative_exponent = (*p == '-');
+      p++;
+    }
+    if (p == end || !Utils::IsDecimalDigit(*p)) return false;
+    intptr_t explicit_exponent = 0;
+    for (; p < end && Utils::IsDecimalDigit(*p); p++) {
+      if (explicit_exponent > 10000) return false;
+      explicit_exponent = explicit_exponent * 10 + (*p - '0');
+    }
+    exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+  }
+  if (p != end) return false;
+
+  if (significand > kMaxExactSignificand) return false;
+  double value = static_cast<double>(significand);
+  if (significand != 0) {
+    if (exponent < -kMaxExactPowerOfTen || exponent > kMaxExactPowerOfTen) {
+      return false;
+    }
+    if (exponent < 0) {
+      value /= kExactPowersOfTen[-exponent];
+    } else {
+      value *= kExactPowersOfTen[exponent];
+    }
+  }
+  *result = negative ? -value : value;
+  return true;
+}
+#endif  // defined(DOUBLE_CONVERSION_CORRECT_DOUBLE_OPERATIONS)
+
 bool CStringToDouble(const char* str, intptr_t length, double* result) {
   if (length == 0) {
     return false;
   }
 
+#if defined(DOUBLE_CONVERSION_CORRECT_DOUBLE_OPERATIONS)
+  if (FastCStringToDouble(str, length, result)) {
+    return true;
+  }
+#endif  // defined(DOUBLE_CONVERSION_CORRECT_DOUBLE_OPERATIONS)
+
   double_conversion::StringToDoubleConverter converter(
       double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, 0.0,
       kInfinitySymbol, kNaNSymbol);
@@ -0,0 +1,44 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/double_conversion.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static double ParseDouble(const char* str) {
+  double result = 0.0;
+  EXPECT(CStringToDouble(str, strlen(str), &result));
+  return result;
+}
+
+TEST_CASE(CStringToDouble) {
+  EXPECT_EQ(0.0, ParseDouble("0"));
+  EXPECT(signbit(ParseDouble("-0.0")));
+  EXPECT_EQ(1.5, ParseDouble("1.5"));
+  EXPECT_EQ(-1.5, ParseDouble("-1.5"));
+  EXPECT_EQ(1.5, ParseDouble("+1.5"));
+  EXPECT_EQ(0.1, ParseDouble("0.1"));
+  EXPECT_EQ(0.3, ParseDouble("0.30"));
+  EXPECT_EQ(123.456, ParseDouble("123.456"));
+  EXPECT_EQ(1e22, ParseDouble("1e22"));
+  EXPECT_EQ(1e-22, ParseDouble("1E-22"));
+  EXPECT_EQ(9007199254740993.0, ParseDouble("9007199254740993"));
+  EXPECT_EQ(1e23, ParseDouble("1e23"));
+  EXPECT_EQ(1e-300, ParseDouble("0.1e-299"));
+  EXPECT_EQ(0.1, ParseDouble("0.10000000000000000000000001"));
+  EXPECT_EQ(12.0, ParseDouble("012"));
+  EXPECT(isinf(ParseDouble("Infinity")));
+  EXPECT(isnan(ParseDouble("NaN")));
+
+  double result = 0.0;
+  EXPECT(!CStringToDouble("", 0, &result));
+  EXPECT(!CStringToDouble("1.", 2, &result));
+  EXPECT(!CStringToDouble("1e", 2, &result));
+  EXPECT(!CStringToDouble("1.5x", 4, &result));
+  EXPECT(!CStringToDouble("-", 1, &result));
+}
+
+}  // namespace dart
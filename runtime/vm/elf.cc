@@ -14,11 +14,18 @@
 #include "vm/thread.h"
 #include "vm/unwinding_records.h"
 #include "vm/zone_text_buffer.h"
+#include "zlib/zlib.h"
 
 namespace dart {
 
 #if defined(DART_PRECOMPILER)
 
+DEFINE_FLAG(bool,
+            compress_debug_sections,
+            false,
+            "Compress the DWARF sections of ELF snapshots and separate "
+            "debugging information with zlib (SHF_COMPRESSED).");
+
 // A wrapper around BaseWriteStream that provides methods useful for
 // writing ELF files (e.g., using ELF definitions of data sizes).
 class ElfWriteStream : public ValueObject {
@@ -87,6 +94,7 @@ static constexpr intptr_t kLinearInitValue = -1;
   V(SymbolTable)                                                               \
   V(DynamicTable)                                                              \
   V(BitsContainer)                                                             \
+  V(CompressedSection)                                                         \
   V(TextSection) V(DataSection) V(BssSection) V(PseudoSection) V(SectionTable)
 #define DEFINE_TYPE_CHECK_FOR(Type)                                            \
   bool Is##Type() const {                                                      \
@@ -110,9 +118,10 @@ class Section : public ZoneAllocated {
           bool allocate,
           bool executable,
           bool writable,
-          intptr_t align = compiler::target::kWordSize)
+          intptr_t align = compiler::target::kWordSize,
+          intptr_t extra_flags = 0)
       : type(t),
-        flags(EncodeFlags(allocate, executable, writable)),
+        flags(EncodeFlags(allocate, executable, writable) | extra_flags),
         alignment(align),
         // Non-segments will never have a memory offset, here represented by 0.
         memory_offset_(allocate ? kLinearInitValue : 0) {
@@ -935,6 +944,77 @@ class BitsContainer : public Section {
   intptr_t total_size_ = 0;
 };
 
+// An unallocated section whose contents are compressed with zlib, following
+// an ELF compression header.
+class CompressedSection : public Section {
+ public:
+  explicit CompressedSection(const BitsContainer* contents)
+      : Section(contents->type,
+                /*allocate=*/false,
+                /*executable=*/false,
+                /*writable=*/false,
+                kHeaderAlignment,
+                elf::SHF_COMPRESSED),
+        contents_(contents) {
+    ASSERT(!contents->IsAllocated());
+  }
+
+  DEFINE_TYPE_CHECK_FOR(CompressedSection)
+
+  // Must be called after the values of the symbols used in relocations within
+  // the contents have been finalized.
+  void Compress(Zone* zone, const Elf& elf) {
+    ZoneWriteStream stream(zone, contents_->FileSize());
+    ElfWriteStream wrapped(&stream, elf);
+    contents_->Write(&wrapped);
+    uncompressed_size_ = stream.bytes_written();
+    uLongf compressed_size = compressBound(uncompressed_size_);
+    bytes_ = zone->Alloc<uint8_t>(compressed_size);
+    const int result = compress2(bytes_, &compressed_size, stream.buffer(),
+                                 uncompressed_size_, Z_BEST_COMPRESSION);
+    if (result != Z_OK) {
+      FATAL("Failed to compress ELF section: %s", zError(result));
+    }
+    compressed_size_ = compressed_size;
+  }
+
+  intptr_t FileSize() const {
+    ASSERT(bytes_ != nullptr);
+    return kHeaderSize + compressed_size_;
+  }
+
+  void Write(ElfWriteStream* stream) const {
+    ASSERT(bytes_ != nullptr);
+#if defined(TARGET_ARCH_IS_32_BIT)
+    stream->WriteWord(elf::ELFCOMPRESS_ZLIB);
+    stream->WriteWord(uncompressed_size_);
+    stream->WriteWord(contents_->alignment);
+#else
+    stream->WriteWord(elf::ELFCOMPRESS_ZLIB);
+    stream->WriteWord(0);  // Reserved.
+    stream->WriteXWord(uncompressed_size_);
+    stream->WriteXWord(contents_->alignment);
+#endif
+    stream->WriteBytes(bytes_, compressed_size_);
+  }
+
+ private:
+  // The size and alignment of Elf32_Chdr or Elf64_Chdr.
+#if defined(TARGET_ARCH_IS_32_BIT)
+  static constexpr intptr_t kHeaderSize = 3 * sizeof(uint32_t);
+  static constexpr intptr_t kHeaderAlignment = sizeof(uint32_t);
+#else
+  static constexpr intptr_t kHeaderSize =
+      2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+  static constexpr intptr_t kHeaderAlignment = sizeof(uint64_t);
+#endif
+
+  const BitsContainer* const contents_;
+  intptr_t uncompressed_size_ = 0;
+  uint8_t* bytes_ = nullptr;
+  intptr_t compressed_size_ = 0;
+};
+
 class NoteSection : public BitsContainer {
  public:
   NoteSection()
@@ -1543,7 +1623,11 @@ void Elf::FinalizeDwarfSections() {
         new (zone_) BitsContainer(elf::SectionHeaderType::SHT_PROGBITS);
     container->AddPortion(stream.buffer(), stream.bytes_written(),
                           stream.relocations());
-    section_table_->Add(container, name);
+    if (FLAG_compress_debug_sections) {
+      section_table_->Add(new (zone_) CompressedSection(container), name);
+    } else {
+      section_table_->Add(container, name);
+    }
   };
   {
     ZoneWriteStream stream(zone(), kInitialDwarfBufferSize);
@@ -2030,10 +2114,32 @@ void Elf::ComputeOffsets() {
     }
   }
 
+  // This must be true for uses of the map to be correct.
+  ASSERT_EQUAL(address_map[elf::SHN_UNDEF], 0);
+  // Adjust addresses in symbol tables as we now have section memory offsets.
+  // Also finalize the entries of the dynamic table, as some are memory offsets.
+  // Only allocated sections have memory offsets, so this can be done before
+  // compressing unallocated sections, whose relocations use the symbols.
   const auto& sections = section_table_->sections();
+  for (auto* const section : sections) {
+    if (auto* const table = section->AsSymbolTable()) {
+      table->Finalize(address_map);
+    } else if (auto* const dynamic = section->AsDynamicTable()) {
+      dynamic->Finalize();
+    }
+  }
+  // Also adjust addresses in symtab for stripped snapshots.
+  if (IsStripped()) {
+    ASSERT_EQUAL(symtab_->index, elf::SHN_UNDEF);
+    symtab_->Finalize(address_map);
+  }
+
   for (; section_index < sections.length(); section_index++) {
     auto* const section = sections[section_index];
     ASSERT(!section->IsAllocated());
+    if (auto* const compressed = section->AsCompressedSection()) {
+      compressed->Compress(zone_, *this);
+    }
     calculate_section_offsets(section);
   }
 
@@ -2048,23 +2154,6 @@ void Elf::ComputeOffsets() {
     ASSERT(Utils::IsAligned(segment->MemoryOffset(), segment->Alignment()));
   }
 #endif
-
-  // This must be true for uses of the map to be correct.
-  ASSERT_EQUAL(address_map[elf::SHN_UNDEF], 0);
-  // Adjust addresses in symbol tables as we now have section memory offsets.
-  // Also finalize the entries of the dynamic table, as some are memory offsets.
-  for (auto* const section : sections) {
-    if (auto* const table = section->AsSymbolTable()) {
-      table->Finalize(address_map);
-    } else if (auto* const dynamic = section->AsDynamicTable()) {
-      dynamic->Finalize();
-    }
-  }
-  // Also adjust addresses in symtab for stripped snapshots.
-  if (IsStripped()) {
-    ASSERT_EQUAL(symtab_->index, elf::SHN_UNDEF);
-    symtab_->Finalize(address_map);
-  }
 }
 
 void ElfHeader::Write(ElfWriteStream* stream) const {
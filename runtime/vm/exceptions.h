@@ -126,6 +126,15 @@ struct ExceptionHandlerInfo {
   int8_t is_generated;         // True if this is a generated handler.
 };
 
+// Result of StackFrame::FindExceptionHandler for a return address, cached
+// per isolate, also for frames without a handler.
+struct CachedExceptionHandler {
+  uword handler_pc;  // 0 if the frame has no handler.
+  bool needs_stacktrace;
+  bool has_catch_all;
+  bool is_optimized;
+};
+
 //
 // Support for try/catch in the optimized code.
 //
@@ -105,14 +105,10 @@ void FieldTable::Grow(intptr_t new_capacity) {
 
   auto old_table = table_;
   auto new_table = static_cast<ObjectPtr*>(
-      malloc(new_capacity * sizeof(ObjectPtr)));  // NOLINT
-  intptr_t i;
-  for (i = 0; i < top_; i++) {
+      calloc(new_capacity, sizeof(ObjectPtr)));  // NOLINT
+  for (intptr_t i = 0; i < top_; i++) {
     new_table[i] = old_table[i];
   }
-  for (; i < new_capacity; i++) {
-    new_table[i] = ObjectPtr();
-  }
   capacity_ = new_capacity;
   old_tables_->Add(old_table);
   // Ensure that new_table_ is populated before it is published
@@ -143,9 +139,13 @@ FieldTable* FieldTable::Clone(Isolate* for_isolate,
     ASSERT(top_ == 0);
     ASSERT(free_head_ == -1);
   } else {
+    // Only the registered fields have values, the remaining capacity is
+    // zeroed (see AllocateIndex). Spawning an isolate clones the group's
+    // initial field table, so avoid reading the unused part of it, and let
+    // calloc hand out untouched zero pages for it.
     auto new_table = static_cast<ObjectPtr*>(
-        malloc(capacity_ * sizeof(ObjectPtr)));  // NOLINT
-    memmove(new_table, table_, capacity_ * sizeof(ObjectPtr));
+        calloc(capacity_, sizeof(ObjectPtr)));  // NOLINT
+    memmove(new_table, table_, top_ * sizeof(ObjectPtr));
     clone->table_ = new_table;
     clone->capacity_ = capacity_;
     clone->top_ = top_;
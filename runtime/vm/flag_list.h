@@ -104,6 +104,8 @@ constexpr bool FLAG_support_il_printer = false;
     "madvise(DONTNEED) free areas in partially used heap regions")             \
   R(dump_megamorphic_stats, false, bool, false,                                \
     "Dump megamorphic cache statistics")                                       \
+  R(dump_subtype_test_cache_stats, false, bool, false,                         \
+    "Dump per type statistics of subtype test cache misses")                   \
   R(dump_symbol_stats, false, bool, false, "Dump symbol table statistics")     \
   P(enable_asserts, bool, false, "Enable assert statements.")                  \
   P(inline_alloc, bool, true, "Whether to use inline allocation fast paths.")  \
@@ -135,6 +137,9 @@ constexpr bool FLAG_support_il_printer = false;
   P(marker_tasks, int, 2,                                                      \
     "The number of tasks to spawn during old gen GC marking (0 means "         \
     "perform all marking on main thread).")                                    \
+  P(become_tasks, int, 2,                                                      \
+    "The number of tasks to spawn while forwarding pointers during become "    \
+    "(0 means perform all forwarding on the main thread).")                    \
   P(hash_map_probes_limit, int, kMaxInt32,                                     \
     "Limit number of probes while doing lookups in hash maps.")                \
   P(max_polymorphic_checks, int, 4,                                            \
@@ -172,6 +177,9 @@ constexpr bool FLAG_support_il_printer = false;
     "Attempt to print a native stack trace when an API error is created.")     \
   D(print_variable_descriptors, bool, false,                                   \
     "Print variable descriptors in disassembly.")                              \
+  R(profile_ffi_leaf_calls, false, bool, true,                                 \
+    "Publish the exit frame and VM tag around leaf FFI calls, which lets "     \
+    "the profiler attribute samples to native code.")                          \
   R(profiler, false, bool, false, "Enable the profiler.")                      \
   R(profiler_native_memory, false, bool, false,                                \
     "Enable native memory statistic collection.")                              \
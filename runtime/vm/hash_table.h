@@ -5,6 +5,8 @@
 #ifndef RUNTIME_VM_HASH_TABLE_H_
 #define RUNTIME_VM_HASH_TABLE_H_
 
+#include <type_traits>
+
 #include "platform/assert.h"
 #include "vm/object.h"
 
@@ -104,6 +106,16 @@ class HashTableBase : public ValueObject {
   static const Object& DeletedMarker() { return Object::null_object(); }
 };
 
+// Whether KeyTraits defines uword CachedHash(ObjectPtr key), which returns
+// the hash of a key in the table without a handle, or 0 if it is not known.
+template <typename KeyTraits, typename = void>
+struct HasCachedKeyHash : std::false_type {};
+template <typename KeyTraits>
+struct HasCachedKeyHash<
+    KeyTraits,
+    std::void_t<decltype(KeyTraits::CachedHash(ObjectPtr()))>>
+    : std::true_type {};
+
 // OVERVIEW:
 //
 // Hash maps and hash sets all use RawArray as backing storage. At the lowest
@@ -258,14 +270,17 @@ class HashTable : public HashTableBase {
     intptr_t probe = hash & (num_entries - 1);
     int probe_distance = 1;
     while (true) {
-      if (IsUnused(probe)) {
+      const ObjectPtr candidate = InternalGetKey(probe);
+      if (candidate == UnusedMarker().ptr()) {
         NOT_IN_PRODUCT(UpdateCollisions(collisions);)
         return -1;
-      } else if (!IsDeleted(probe)) {
-        *key_handle_ = GetKey(probe);
-        if (KeyTraits::IsMatch(key, *key_handle_)) {
-          NOT_IN_PRODUCT(UpdateCollisions(collisions);)
-          return probe;
+      } else if (candidate != DeletedMarker().ptr()) {
+        if (MayMatch(candidate, hash)) {
+          *key_handle_ = candidate;
+          if (KeyTraits::IsMatch(key, *key_handle_)) {
+            NOT_IN_PRODUCT(UpdateCollisions(collisions);)
+            return probe;
+          }
         }
         NOT_IN_PRODUCT(collisions += 1;)
       }
@@ -293,20 +308,23 @@ class HashTable : public HashTableBase {
     int probe_distance = 1;
     intptr_t deleted = -1;
     while (true) {
-      if (IsUnused(probe)) {
+      const ObjectPtr candidate = InternalGetKey(probe);
+      if (candidate == UnusedMarker().ptr()) {
         *entry = (deleted != -1) ? deleted : probe;
         NOT_IN_PRODUCT(UpdateCollisions(collisions);)
         return false;
-      } else if (IsDeleted(probe)) {
+      } else if (candidate == DeletedMarker().ptr()) {
         if (deleted == -1) {
           deleted = probe;
         }
       } else {
-        *key_handle_ = GetKey(probe);
-        if (KeyTraits::IsMatch(key, *key_handle_)) {
-          *entry = probe;
-          NOT_IN_PRODUCT(UpdateCollisions(collisions);)
-          return true;
+        if (MayMatch(candidate, hash)) {
+          *key_handle_ = candidate;
+          if (KeyTraits::IsMatch(key, *key_handle_)) {
+            *entry = probe;
+            NOT_IN_PRODUCT(UpdateCollisions(collisions);)
+            return true;
+          }
         }
         NOT_IN_PRODUCT(collisions += 1;)
       }
@@ -489,6 +507,17 @@ class HashTable : public HashTableBase {
         StorageTraits::At(data_, KeyIndex(entry)));
   }
 
+  // Filters out keys with a different cached hash before they are compared
+  // through a handle, for KeyTraits which can read the hash of a raw key.
+  static bool MayMatch(ObjectPtr candidate, uword hash) {
+    if constexpr (HasCachedKeyHash<KeyTraits>::value) {
+      const uword cached = KeyTraits::CachedHash(candidate);
+      return (cached == 0) || (cached == hash);
+    } else {
+      return true;
+    }
+  }
+
   void InternalSetKey(intptr_t entry, const Object& key) const {
     StorageTraits::SetAt(data_, KeyIndex(entry), key);
   }
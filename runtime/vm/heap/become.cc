@@ -12,6 +12,7 @@
 #include "vm/isolate_reload.h"
 #include "vm/object.h"
 #include "vm/raw_object.h"
+#include "vm/thread_barrier.h"
 #include "vm/timeline.h"
 #include "vm/visitor.h"
 
@@ -218,6 +219,43 @@ class WritableCodeLiteralsScope : public ValueObject {
 };
 #endif
 
+// Small heaps are not worth waking up helper threads for.
+static constexpr intptr_t kMinPagesPerTask = 8;
+
+// Forwards the pointers in a share of the heap pages. Each task claims pages
+// one at a time, so every object is visited by exactly one task and the
+// barrier is reapplied through that task's own store buffer.
+class ParallelForwardTask : public SafepointTask {
+ public:
+  ParallelForwardTask(IsolateGroup* isolate_group,
+                      ThreadBarrier* barrier,
+                      const MallocGrowableArray<Page*>* pages,
+                      RelaxedAtomic<intptr_t>* next_page)
+      : SafepointTask(isolate_group, barrier, Thread::kCompactorTask),
+        pages_(pages),
+        next_page_(next_page) {}
+
+  void RunEnteredIsolateGroup() override {
+    Thread* thread = Thread::Current();
+    TIMELINE_FUNCTION_GC_DURATION(thread, "ParallelForwardPointers");
+    ForwardPointersVisitor pointer_visitor(thread);
+    ForwardHeapPointersVisitor object_visitor(&pointer_visitor);
+    for (;;) {
+      const intptr_t i = next_page_->fetch_add(1);
+      if (i >= pages_->length()) break;
+      // The main thread owns the safepoint on behalf of the helpers.
+      pages_->At(i)->VisitObjectsUnsafe(&object_visitor);
+    }
+    pointer_visitor.VisitingObject(nullptr);
+  }
+
+ private:
+  const MallocGrowableArray<Page*>* pages_;
+  RelaxedAtomic<intptr_t>* next_page_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelForwardTask);
+};
+
 Become::Become() {
   IsolateGroup* group = Thread::Current()->isolate_group();
   ASSERT(group->become() == nullptr);  // Only one outstanding become at a time.
@@ -358,9 +396,26 @@ void Become::FollowForwardingPointers(Thread* thread) {
   {
     // Heap pointers.
     WritableCodeLiteralsScope writable_code(heap);
-    ForwardHeapPointersVisitor object_visitor(&pointer_visitor);
-    heap->VisitObjects(&object_visitor);
-    pointer_visitor.VisitingObject(nullptr);
+    MallocGrowableArray<Page*> pages;
+    if ((FLAG_become_tasks > 0) && thread->OwnsSafepoint()) {
+      heap->AddPagesTo(&pages);
+    }
+    const intptr_t num_tasks = Utils::Minimum<intptr_t>(
+        FLAG_become_tasks, pages.length() / kMinPagesPerTask);
+    if (num_tasks > 1) {
+      ThreadBarrier* barrier = new ThreadBarrier(num_tasks, /*initial=*/1);
+      RelaxedAtomic<intptr_t> next_page = 0;
+      IntrusiveDList<SafepointTask> tasks;
+      for (intptr_t i = 0; i < num_tasks; i++) {
+        tasks.Append(new ParallelForwardTask(isolate_group, barrier, &pages,
+                                             &next_page));
+      }
+      isolate_group->safepoint_handler()->RunTasks(&tasks);
+    } else {
+      ForwardHeapPointersVisitor object_visitor(&pointer_visitor);
+      heap->VisitObjects(&object_visitor);
+      pointer_visitor.VisitingObject(nullptr);
+    }
   }
 
   // C++ pointers.
@@ -194,4 +194,42 @@ ISOLATE_UNIT_TEST_CASE(BecomeForwardRememberedCards) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(BecomeForwardParallel) {
+  SetFlagScope<int> sfs(&FLAG_become_tasks, 4);
+
+  // Spread references over enough old-space pages to use all tasks.
+  const intptr_t kNumArrays = 2 * KB;
+  const intptr_t kArrayLength = KB;
+  const String& before_obj = String::Handle(String::New("old", Heap::kOld));
+  const String& after_obj = String::Handle(String::New("new", Heap::kNew));
+  const Array& arrays = Array::Handle(Array::New(kNumArrays, Heap::kOld));
+  Array& array = Array::Handle();
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    array = Array::New(kArrayLength, Heap::kOld);
+    array.SetAt(0, before_obj);
+    array.SetAt(kArrayLength - 1, before_obj);
+    arrays.SetAt(i, array);
+  }
+
+  Become become;
+  become.Add(before_obj, after_obj);
+  become.Forward();
+
+  EXPECT(before_obj.ptr() == after_obj.ptr());
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    array ^= arrays.At(i);
+    EXPECT(array.At(0) == after_obj.ptr());
+    EXPECT(array.At(kArrayLength - 1) == after_obj.ptr());
+    // The generational barrier was reapplied by whichever task visited it.
+    EXPECT(array.ptr()->untag()->IsRemembered());
+  }
+
+  GCTestHelper::CollectAllGarbage();
+
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    array ^= arrays.At(i);
+    EXPECT(array.At(0) == after_obj.ptr());
+  }
+}
+
 }  // namespace dart
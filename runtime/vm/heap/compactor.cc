@@ -801,6 +801,7 @@ void GCCompactor::VisitHandle(uword addr) {
 
 void GCCompactor::SetupLargePages() {
   large_pages_ = heap_->old_space()->large_pages_;
+  permanent_pages_ = heap_->old_space()->permanent_pages_;
 }
 
 void GCCompactor::ForwardLargePages() {
@@ -812,6 +813,13 @@ void GCCompactor::ForwardLargePages() {
     page->VisitObjectPointers(this);
     ml.Lock();
   }
+  while (permanent_pages_ != nullptr) {
+    Page* page = permanent_pages_;
+    permanent_pages_ = page->next();
+    ml.Unlock();
+    page->VisitObjectPointers(this);
+    ml.Lock();
+  }
   while (fixed_pages_ != nullptr) {
     Page* page = fixed_pages_;
     fixed_pages_ = page->next();
@@ -822,7 +830,7 @@ void GCCompactor::ForwardLargePages() {
     bool page_in_use;
     {
       MutexLocker ml(freelist->mutex());
-      page_in_use = sweeper.SweepPage(page, freelist);
+      page_in_use = sweeper.SweepPage(page, freelist, heap_->old_space());
     }
     ASSERT(page_in_use);
 
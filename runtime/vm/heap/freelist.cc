@@ -91,7 +91,7 @@ uword FreeList::TryAllocateLocked(intptr_t size, bool is_protected) {
 
   // Postcondition: if allocation succeeds, the allocated block is writable.
   int index = IndexForSize(size);
-  if ((index != kNumLists) && free_map_.Test(index)) {
+  if ((index < kNumLists) && free_map_.Test(index)) {
     FreeListElement* element = DequeueElement(index);
     if (is_protected) {
       VirtualMemory::Protect(reinterpret_cast<void*>(element), size,
@@ -123,71 +123,125 @@ uword FreeList::TryAllocateLocked(intptr_t size, bool is_protected) {
     }
   }
 
-  FreeListElement* previous = nullptr;
-  FreeListElement* current = free_lists_[kNumLists];
-  // We are willing to search the freelist further for a big block.
+  FreeListElement* element = DequeueLargeElement(size, is_protected);
+  if (element == nullptr) {
+    return 0;  // Trigger allocation of new page.
+  }
+  SplitElementAfterAndEnqueue(element, size, is_protected);
+  return reinterpret_cast<uword>(element);
+}
+
+FreeListElement* FreeList::DequeueLargeElement(intptr_t size,
+                                               bool is_protected) {
+  // Small requests that could not be satisfied by the exact-size lists are
+  // served from the smallest large list.
+  const intptr_t index =
+      Utils::Maximum<intptr_t>(IndexForSize(size), kNumLists);
+
+  // Elements in this size class may still be smaller than the request, so
+  // search it first-fit. We are willing to search further for a big block.
   // For each successful free-list search we:
   //   * increase the search budget by #allocated-words
   //   * decrease the search budget by #free-list-entries-traversed
   //     which guarantees us to not waste more than around 1 search step per
   //     word of allocation
   //
-  // If we run out of search budget we fall back to allocating a new page and
-  // reset the search budget.
+  // If we run out of search budget we reset it and fall back to the larger
+  // size classes.
+  FreeListElement* previous = nullptr;
+  FreeListElement* current = free_lists_[index];
   intptr_t tries_left = freelist_search_budget_ + (size >> kWordSizeLog2);
+  intptr_t traversed = 0;
   while (current != nullptr) {
     if (current->HeapSize() >= size) {
-      // Found an element large enough to hold the requested size. Dequeue,
-      // split and enqueue the remainder.
-      intptr_t remainder_size = current->HeapSize() - size;
-      intptr_t region_size =
-          size + FreeListElement::HeaderSizeFor(remainder_size);
-      if (is_protected) {
-        // Make the allocated block and the header of the remainder element
-        // writable.  The remainder will be non-writable if necessary after
-        // the call to SplitElementAfterAndEnqueue.
-        VirtualMemory::Protect(reinterpret_cast<void*>(current), region_size,
-                               VirtualMemory::kReadWrite);
-      }
-
-      if (previous == nullptr) {
-        free_lists_[kNumLists] = current->next();
-      } else {
-        // If the previous free list element's next field is protected, it
-        // needs to be unprotected before storing to it and reprotected
-        // after.
-        bool target_is_protected = false;
-        uword target_address = 0L;
-        if (is_protected) {
-          uword writable_start = reinterpret_cast<uword>(current);
-          uword writable_end = writable_start + region_size - 1;
-          target_address = previous->next_address();
-          target_is_protected =
-              !VirtualMemory::InSamePage(target_address, writable_start) &&
-              !VirtualMemory::InSamePage(target_address, writable_end);
-        }
-        if (target_is_protected) {
-          VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
-                                 kWordSize, VirtualMemory::kReadWrite);
-        }
-        previous->set_next(current->next());
-        if (target_is_protected) {
-          VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
-                                 kWordSize, VirtualMemory::kReadExecute);
-        }
-      }
-      SplitElementAfterAndEnqueue(current, size, is_protected);
+      UnlinkLargeElement(index, previous, current, size, is_protected);
       freelist_search_budget_ =
           Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
-      return reinterpret_cast<uword>(current);
+      RecordSearchLength(traversed);
+      return current;
     } else if (tries_left-- < 0) {
       freelist_search_budget_ = kInitialFreeListSearchBudget;
-      return 0;  // Trigger allocation of new page.
+      break;
     }
     previous = current;
     current = current->next();
+    traversed++;
+  }
+
+  // Any element of a larger size class fits.
+  if ((index + 1) < kNumAllLists) {
+    intptr_t next_index = large_map_.Next(index + 1 - kNumLists);
+    if (next_index != -1) {
+      next_index += kNumLists;
+      FreeListElement* element = free_lists_[next_index];
+      UnlinkLargeElement(next_index, nullptr, element, size, is_protected);
+      RecordSearchLength(traversed);
+      return element;
+    }
+  }
+  RecordSearchLength(traversed);
+  return nullptr;
+}
+
+void FreeList::UnlinkLargeElement(intptr_t index,
+                                  FreeListElement* previous,
+                                  FreeListElement* element,
+                                  intptr_t size,
+                                  bool is_protected) {
+  ASSERT(index >= kNumLists);
+  ASSERT(element->HeapSize() >= size);
+  intptr_t remainder_size = element->HeapSize() - size;
+  intptr_t region_size = size + FreeListElement::HeaderSizeFor(remainder_size);
+  if (is_protected) {
+    // Make the allocated block and the header of the remainder element
+    // writable.  The remainder will be non-writable if necessary after
+    // the call to SplitElementAfterAndEnqueue.
+    VirtualMemory::Protect(reinterpret_cast<void*>(element), region_size,
+                           VirtualMemory::kReadWrite);
+  }
+
+  if (previous == nullptr) {
+    free_lists_[index] = element->next();
+    if (free_lists_[index] == nullptr) {
+      large_map_.Set(index - kNumLists, false);
+    }
+  } else {
+    // If the previous free list element's next field is protected, it
+    // needs to be unprotected before storing to it and reprotected
+    // after.
+    bool target_is_protected = false;
+    uword target_address = 0L;
+    if (is_protected) {
+      uword writable_start = reinterpret_cast<uword>(element);
+      uword writable_end = writable_start + region_size - 1;
+      target_address = previous->next_address();
+      target_is_protected =
+          !VirtualMemory::InSamePage(target_address, writable_start) &&
+          !VirtualMemory::InSamePage(target_address, writable_end);
+    }
+    if (target_is_protected) {
+      VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
+                             kWordSize, VirtualMemory::kReadWrite);
+    }
+    previous->set_next(element->next());
+    if (target_is_protected) {
+      VirtualMemory::Protect(reinterpret_cast<void*>(target_address),
+                             kWordSize, VirtualMemory::kReadExecute);
+    }
+  }
+}
+
+void FreeList::RecordSearchLength(intptr_t length) {
+  intptr_t bucket = (length == 0) ? 0 : Utils::HighestBit(length) + 1;
+  bucket = Utils::Minimum(bucket, kNumSearchLengthBuckets - 1);
+  search_lengths_[bucket]++;
+}
+
+void FreeList::AddSearchLengthsTo(intptr_t* histogram) const {
+  MutexLocker ml(&mutex_);
+  for (intptr_t i = 0; i < kNumSearchLengthBuckets; i++) {
+    histogram[i] += search_lengths_[i];
   }
-  return 0;
 }
 
 void FreeList::Free(uword addr, intptr_t size) {
@@ -211,18 +265,38 @@ void FreeList::FreeLocked(uword addr, intptr_t size) {
 void FreeList::Reset() {
   MutexLocker ml(&mutex_);
   free_map_.Reset();
+  large_map_.Reset();
   last_free_small_size_ = -1;
-  for (int i = 0; i < (kNumLists + 1); i++) {
+  for (int i = 0; i < kNumAllLists; i++) {
     free_lists_[i] = nullptr;
   }
 }
 
+void FreeList::RebuildMaps() {
+  free_map_.Reset();
+  large_map_.Reset();
+  last_free_small_size_ = -1;
+  for (intptr_t i = 0; i < kNumLists; i++) {
+    if (free_lists_[i] != nullptr) {
+      free_map_.Set(i, true);
+      last_free_small_size_ = i << kObjectAlignmentLog2;
+    }
+  }
+  for (intptr_t i = 0; i < kNumLargeLists; i++) {
+    large_map_.Set(i, free_lists_[kNumLists + i] != nullptr);
+  }
+}
+
 void FreeList::EnqueueElement(FreeListElement* element, intptr_t index) {
   FreeListElement* next = free_lists_[index];
-  if (next == nullptr && index != kNumLists) {
-    free_map_.Set(index, true);
-    last_free_small_size_ =
-        Utils::Maximum(last_free_small_size_, index << kObjectAlignmentLog2);
+  if (next == nullptr) {
+    if (index < kNumLists) {
+      free_map_.Set(index, true);
+      last_free_small_size_ =
+          Utils::Maximum(last_free_small_size_, index << kObjectAlignmentLog2);
+    } else {
+      large_map_.Set(index - kNumLists, true);
+    }
   }
   element->set_next(next);
   free_lists_[index] = element;
@@ -285,13 +359,15 @@ class IntptrPair {
 void FreeList::PrintLarge() const {
   intptr_t large_bytes = 0;
   MallocDirectChainedHashMap<NumbersKeyValueTrait<IntptrPair> > map;
-  FreeListElement* node;
-  for (node = free_lists_[kNumLists]; node != nullptr; node = node->next()) {
-    IntptrPair* pair = map.Lookup(node->HeapSize());
-    if (pair == nullptr) {
-      map.Insert(IntptrPair(node->HeapSize(), 1));
-    } else {
-      pair->set_second(pair->second() + 1);
+  for (intptr_t i = kNumLists; i < kNumAllLists; i++) {
+    FreeListElement* node;
+    for (node = free_lists_[i]; node != nullptr; node = node->next()) {
+      IntptrPair* pair = map.Lookup(node->HeapSize());
+      if (pair == nullptr) {
+        map.Insert(IntptrPair(node->HeapSize(), 1));
+      } else {
+        pair->set_second(pair->second() + 1);
+      }
     }
   }
 
@@ -360,31 +436,20 @@ FreeListElement* FreeList::TryAllocateLarge(intptr_t minimum_size) {
 
 FreeListElement* FreeList::TryAllocateLargeLocked(intptr_t minimum_size) {
   DEBUG_ASSERT(mutex_.IsOwnedByCurrentThread());
-  FreeListElement* previous = nullptr;
-  FreeListElement* current = free_lists_[kNumLists];
-  // TODO(koda): Find largest.
-  // We are willing to search the freelist further for a big block.
-  intptr_t tries_left =
-      freelist_search_budget_ + (minimum_size >> kWordSizeLog2);
-  while (current != nullptr) {
-    FreeListElement* next = current->next();
-    if (current->HeapSize() >= minimum_size) {
-      if (previous == nullptr) {
-        free_lists_[kNumLists] = next;
-      } else {
-        previous->set_next(next);
-      }
-      freelist_search_budget_ =
-          Utils::Minimum(tries_left, kInitialFreeListSearchBudget);
-      return current;
-    } else if (tries_left-- < 0) {
-      freelist_search_budget_ = kInitialFreeListSearchBudget;
-      return nullptr;  // Trigger allocation of new page.
+  // Prefer the largest size class: the element becomes a bump allocation
+  // region, which then needs refilling less often.
+  intptr_t last = large_map_.Last();
+  if (last != -1) {
+    const intptr_t index = kNumLists + last;
+    FreeListElement* element = free_lists_[index];
+    if (element->HeapSize() >= minimum_size) {
+      UnlinkLargeElement(index, nullptr, element, minimum_size,
+                         /*is_protected=*/false);
+      RecordSearchLength(0);
+      return element;
     }
-    previous = current;
-    current = next;
   }
-  return nullptr;
+  return DequeueLargeElement(minimum_size, /*is_protected=*/false);
 }
 
 }  // namespace dart
@@ -88,6 +88,14 @@ class FreeList {
 
   void Print() const;
 
+  // Number of entries in SearchLengthHistogram. Bucket 0 counts large
+  // allocations that found an element without traversing a list; bucket i > 0
+  // counts searches that traversed [2^(i-1), 2^i) elements, with the last
+  // bucket also counting longer searches.
+  static constexpr intptr_t kNumSearchLengthBuckets = 12;
+  // Adds this free list's large-allocation search lengths to |histogram|.
+  void AddSearchLengthsTo(intptr_t* histogram) const;
+
   Mutex* mutex() { return &mutex_; }
   uword TryAllocateLocked(intptr_t size, bool is_protected);
   void FreeLocked(uword addr, intptr_t size);
@@ -104,7 +112,7 @@ class FreeList {
       return 0;
     }
     int index = IndexForSize(size);
-    if (index != kNumLists && free_map_.Test(index)) {
+    if (index < kNumLists && free_map_.Test(index)) {
       return reinterpret_cast<uword>(DequeueElement(index));
     }
     if ((index + 1) < kNumLists) {
@@ -163,7 +171,15 @@ class FreeList {
   void AddUnaccountedSize(intptr_t size) { unaccounted_size_ += size; }
 
  private:
+  // Exact-size lists for small elements.
   static constexpr int kNumLists = 128;
+  // Elements too large for the exact-size lists are segregated into lists
+  // covering [kMinLargeSize * 2^i, kMinLargeSize * 2^(i+1)), the last list
+  // being unbounded. Any element in a list above the one for the requested size
+  // fits, so a large allocation searches at most one list.
+  static constexpr int kNumLargeLists = 16;
+  static constexpr int kNumAllLists = kNumLists + kNumLargeLists;
+  static constexpr intptr_t kMinLargeSize = kNumLists << kObjectAlignmentLog2;
   static constexpr intptr_t kInitialFreeListSearchBudget = 1000;
 
   static intptr_t IndexForSize(intptr_t size) {
@@ -172,7 +188,9 @@ class FreeList {
 
     intptr_t index = size >> kObjectAlignmentLog2;
     if (index >= kNumLists) {
-      index = kNumLists;
+      index = kNumLists +
+              Utils::Minimum<intptr_t>(Utils::HighestBit(size / kMinLargeSize),
+                                       kNumLargeLists - 1);
     }
     return index;
   }
@@ -183,7 +201,7 @@ class FreeList {
   FreeListElement* DequeueElement(intptr_t index) {
     FreeListElement* result = free_lists_[index];
     FreeListElement* next = result->next();
-    if (next == nullptr && index != kNumLists) {
+    if (next == nullptr && index < kNumLists) {
       intptr_t size = index << kObjectAlignmentLog2;
       if (size == last_free_small_size_) {
         // Note: This is -1 * kObjectAlignment if no other small sizes remain.
@@ -201,6 +219,22 @@ class FreeList {
                                    intptr_t size,
                                    bool is_protected);
 
+  // Unlinks and returns an element of at least |size| from the large lists,
+  // or nullptr if none is found within the search budget. If |is_protected|,
+  // the first |size| bytes of the element and the header of its remainder are
+  // made writable.
+  FreeListElement* DequeueLargeElement(intptr_t size, bool is_protected);
+  void UnlinkLargeElement(intptr_t index,
+                          FreeListElement* previous,
+                          FreeListElement* element,
+                          intptr_t size,
+                          bool is_protected);
+  void RecordSearchLength(intptr_t length);
+
+  // Recomputes free_map_, large_map_ and last_free_small_size_ after the lists
+  // have been edited directly.
+  void RebuildMaps();
+
   void PrintSmall() const;
   void PrintLarge() const;
 
@@ -216,8 +250,11 @@ class FreeList {
   mutable Mutex mutex_;
 
   BitSet<kNumLists> free_map_;
+  BitSet<kNumLargeLists> large_map_;
+
+  FreeListElement* free_lists_[kNumAllLists];
 
-  FreeListElement* free_lists_[kNumLists + 1];
+  intptr_t search_lengths_[kNumSearchLengthBuckets] = {};
 
   intptr_t freelist_search_budget_ = kInitialFreeListSearchBudget;
 
@@ -185,6 +185,38 @@ TEST_CASE(FreeListProtectedVariableSizeObjects) {
   delete[] objects;
 }
 
+TEST_CASE(FreeListLargeSizeClasses) {
+  std::unique_ptr<FreeList> free_list(new FreeList());
+  std::unique_ptr<VirtualMemory> region(VirtualMemory::Allocate(
+      256 * KB, /*is_executable=*/false, /*is_compressed=*/false, "test"));
+  // Three separate free blocks in different large size classes.
+  const uword small_block = region->start();
+  const uword medium_block = small_block + 8 * KB;
+  const uword big_block = small_block + 32 * KB;
+  free_list->Free(small_block, 4 * KB);
+  free_list->Free(medium_block, 8 * KB);
+  free_list->Free(big_block, 64 * KB);
+
+  // Bump regions are taken from the largest size class.
+  FreeListElement* element = free_list->TryAllocateLarge(2 * KB);
+  EXPECT_EQ(big_block, reinterpret_cast<uword>(element));
+  EXPECT_EQ(64 * KB, element->HeapSize());
+
+  // The 4KB block is too small, so the next larger size class is used.
+  EXPECT_EQ(medium_block, Allocate(free_list.get(), 6 * KB, false));
+  EXPECT_EQ(small_block, Allocate(free_list.get(), 4 * KB, false));
+  EXPECT_EQ(0u, Allocate(free_list.get(), 4 * KB, false));
+
+  intptr_t histogram[FreeList::kNumSearchLengthBuckets] = {};
+  free_list->AddSearchLengthsTo(histogram);
+  intptr_t searches = 0;
+  for (intptr_t i = 0; i < FreeList::kNumSearchLengthBuckets; i++) {
+    searches += histogram[i];
+  }
+  EXPECT_EQ(4, searches);
+  EXPECT_EQ(1, histogram[1]);  // Skipped the 4KB block once.
+}
+
 static void TestRegress38528(intptr_t header_overlap) {
   // Test the following scenario.
   //
@@ -20,6 +20,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, defer_finalizer_callbacks);
+
 // These object types have a linked list chaining all pending objects when
 // processing these in the GC.
 // The field should not be visited by pointer visitors.
@@ -132,7 +134,12 @@ void RunNativeFinalizerCallback(NativeFinalizerPtr raw_finalizer,
                       raw_finalizer->untag(), callback, peer);
     }
     raw_entry.untag()->set_token(raw_entry);
-    (*callback)(peer);
+    if (FLAG_defer_finalizer_callbacks) {
+      visitor->isolate_group()->heap()->EnqueueFinalizerCallback(callback,
+                                                                 peer);
+    } else {
+      (*callback)(peer);
+    }
     if (external_size > 0) {
       if (FLAG_trace_finalizers) {
         TRACE_FINALIZER("Clearing external size %" Pd " bytes in %s space",
@@ -41,6 +41,12 @@ DEFINE_FLAG(bool,
             false,
             "Explicitly disable heap verification.");
 
+DEFINE_FLAG(bool,
+            defer_finalizer_callbacks,
+            true,
+            "Run native finalizer callbacks after the GC safepoint is released "
+            "rather than while the mutators are stopped.");
+
 Heap::Heap(IsolateGroup* isolate_group,
            bool is_vm_isolate,
            intptr_t max_new_gen_semi_words,
@@ -60,7 +66,21 @@ Heap::Heap(IsolateGroup* isolate_group,
   stats_.num_ = 0;
 }
 
+Heap::FinalizerCallback Heap::WeakTableCleanupFor(WeakSelector sel) {
+#if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
+  if (sel == kHeapSamplingData) {
+    return HeapProfileSampler::delete_callback();
+  }
+  if (sel == kSampledAllocations) {
+    return HeapProfileSampler::FreedSampledAllocation;
+  }
+#endif
+  return nullptr;
+}
+
 Heap::~Heap() {
+  RunPendingFinalizerCallbacks();
+
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
   Dart_HeapSamplingDeleteCallback cleanup =
       HeapProfileSampler::delete_callback();
@@ -76,6 +96,36 @@ Heap::~Heap() {
   }
 }
 
+void Heap::EnqueueFinalizerCallback(FinalizerCallback callback, void* peer) {
+  MutexLocker ml(&pending_finalizers_mutex_);
+  pending_finalizers_.Add({callback, peer});
+}
+
+void Heap::EnqueueFinalizerCallbacks(const PendingFinalizers& batch) {
+  if (batch.is_empty()) return;
+  MutexLocker ml(&pending_finalizers_mutex_);
+  for (intptr_t i = 0; i < batch.length(); i++) {
+    pending_finalizers_.Add(batch[i]);
+  }
+}
+
+void Heap::RunPendingFinalizerCallbacks() {
+  PendingFinalizers batch;
+  for (;;) {
+    {
+      MutexLocker ml(&pending_finalizers_mutex_);
+      if (pending_finalizers_.is_empty()) return;
+      // Take the whole queue so GC workers are never blocked behind the
+      // callbacks.
+      batch = std::move(pending_finalizers_);
+    }
+    for (intptr_t i = 0; i < batch.length(); i++) {
+      batch[i].callback(batch[i].peer);
+    }
+    batch.Clear();
+  }
+}
+
 uword Heap::AllocateNew(Thread* thread, intptr_t size) {
   ASSERT(thread->no_safepoint_scope_depth() == 0);
   CollectForDebugging(thread);
@@ -538,6 +588,7 @@ void Heap::CollectOldSpaceGarbage(Thread* thread,
     TIMELINE_FUNCTION_GC_DURATION(thread, "CollectOldGeneration");
     old_space_.CollectGarbage(thread, /*compact=*/type == GCType::kMarkCompact,
                               /*finalize=*/true);
+    new_space_.ResetPretenuring();
     RecordAfterGC(type);
     PrintStats();
 #if defined(SUPPORT_TIMELINE)
@@ -717,6 +768,11 @@ void Heap::AddRegionsToObjectSet(ObjectSet* set) const {
   set->SortRegions();
 }
 
+void Heap::AddPagesTo(MallocGrowableArray<Page*>* pages) const {
+  new_space_.AddPagesTo(pages);
+  old_space_.AddPagesTo(pages);
+}
+
 void Heap::CollectOnNthAllocation(intptr_t num_allocations) {
   // Prevent generated code from using the TLAB fast path on next allocation.
   new_space_.AbandonRemainingTLABForDebugging(Thread::Current());
@@ -832,6 +888,19 @@ int64_t Heap::GCTimeInMicros(Space space) const {
   return old_space_.gc_time_micros();
 }
 
+int64_t Heap::AllocatedInWords(Space space) const {
+  return space == kNew ? new_allocated_in_words_.load()
+                       : old_allocated_in_words_.load();
+}
+
+int64_t Heap::TotalAllocatedInWords() const {
+  return new_allocated_in_words_.load() + old_allocated_in_words_.load() +
+         Utils::Maximum<intptr_t>(
+             0, new_space_.UsedInWords() - new_used_after_gc_in_words_) +
+         Utils::Maximum<intptr_t>(
+             0, old_space_.UsedInWords() - old_used_after_gc_in_words_);
+}
+
 intptr_t Heap::Collections(Space space) const {
   if (space == kNew) {
     return new_space_.collections();
@@ -1010,6 +1079,11 @@ void Heap::RecordBeforeGC(GCType type, GCReason reason) {
   stats_.before_.new_ = new_space_.GetCurrentUsage();
   stats_.before_.old_ = old_space_.GetCurrentUsage();
   stats_.before_.store_buffer_ = isolate_group_->store_buffer()->Size();
+  // Old space usage also drops when the concurrent sweeper frees memory.
+  new_allocated_in_words_ += Utils::Maximum<intptr_t>(
+      0, stats_.before_.new_.used_in_words - new_used_after_gc_in_words_);
+  old_allocated_in_words_ += Utils::Maximum<intptr_t>(
+      0, stats_.before_.old_.used_in_words - old_used_after_gc_in_words_);
 }
 
 void Heap::RecordAfterGC(GCType type) {
@@ -1025,6 +1099,8 @@ void Heap::RecordAfterGC(GCType type) {
   stats_.after_.new_ = new_space_.GetCurrentUsage();
   stats_.after_.old_ = old_space_.GetCurrentUsage();
   stats_.after_.store_buffer_ = isolate_group_->store_buffer()->Size();
+  new_used_after_gc_in_words_ = stats_.after_.new_.used_in_words;
+  old_used_after_gc_in_words_ = stats_.after_.old_.used_in_words;
 #ifndef PRODUCT
   // For now we'll emit the same GC events on all isolates.
   if (Service::gc_stream.enabled()) {
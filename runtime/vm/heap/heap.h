@@ -50,6 +50,7 @@ class Heap {
     kLoadingUnits,
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
     kHeapSamplingData,
+    kSampledAllocations,
 #endif
     kNumWeakSelectors
   };
@@ -151,6 +152,17 @@ class Heap {
   intptr_t TotalExternalInWords() const;
   // Return the amount of GCing in microseconds.
   int64_t GCTimeInMicros(Space space) const;
+  // Return the amount of memory allocated in a space between GCs, up to the
+  // start of the last GC. Promotion by the scavenger is not included.
+  int64_t AllocatedInWords(Space space) const;
+  // Like AllocatedInWords summed over new and old space, but also includes
+  // the allocation since the last GC. New space memory is counted as the
+  // TLABs holding it are released.
+  int64_t TotalAllocatedInWords() const;
+  // Return the capacity of the pages holding instructions, excluding images.
+  intptr_t ExecutableCapacityInWords() const {
+    return old_space_.ExecutableCapacityInWords();
+  }
 
   intptr_t Collections(Space space) const;
 
@@ -213,6 +225,9 @@ class Heap {
   void SetHeapSamplingData(ObjectPtr obj, void* data) {
     SetWeakEntry(obj, kHeapSamplingData, reinterpret_cast<intptr_t>(data));
   }
+  void SetSampledAllocationBytes(ObjectPtr obj, intptr_t sampled_bytes) {
+    SetWeakEntry(obj, kSampledAllocations, sampled_bytes);
+  }
 #endif
 
   // Used by the GC algorithms to propagate weak entries.
@@ -241,6 +256,26 @@ class Heap {
   void ForwardWeakEntries(ObjectPtr before_object, ObjectPtr after_object);
   void ForwardWeakTables(ObjectPointerVisitor* visitor);
 
+  // Native finalizer and weak table cleanup callbacks for objects found dead
+  // by a GC are queued here instead of being run while the mutators are
+  // stopped. They run when the thread that owned the safepoint releases it.
+  typedef void (*FinalizerCallback)(void* peer);
+  struct PendingFinalizer {
+    FinalizerCallback callback;
+    void* peer;
+  };
+  typedef MallocGrowableArray<PendingFinalizer> PendingFinalizers;
+
+  // Returns the callback that releases a value of the weak table |sel| once
+  // its key has been collected, or nullptr if the values need no cleanup.
+  static FinalizerCallback WeakTableCleanupFor(WeakSelector sel);
+
+  // Can be called concurrently by GC workers.
+  void EnqueueFinalizerCallback(FinalizerCallback callback, void* peer);
+  void EnqueueFinalizerCallbacks(const PendingFinalizers& batch);
+  // Must be called outside of a safepoint operation.
+  void RunPendingFinalizerCallbacks();
+
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
   void ReportSurvivingAllocations(Dart_HeapSamplingReportCallback callback,
                                   void* context) {
@@ -342,6 +377,7 @@ class Heap {
   void PrintStatsToTimeline(TimelineEventScope* event, GCReason reason);
 
   void AddRegionsToObjectSet(ObjectSet* set) const;
+  void AddPagesTo(MallocGrowableArray<Page*>* pages) const;
 
   // Trigger major GC if 'gc_on_nth_allocation_' is set.
   void CollectForDebugging(Thread* thread);
@@ -356,6 +392,9 @@ class Heap {
   WeakTable* new_weak_tables_[kNumWeakSelectors];
   WeakTable* old_weak_tables_[kNumWeakSelectors];
 
+  Mutex pending_finalizers_mutex_;
+  PendingFinalizers pending_finalizers_;
+
   // GC stats collection.
   GCStats stats_;
 
@@ -366,6 +405,13 @@ class Heap {
 
   bool assume_scavenge_will_fail_;
 
+  // Allocation totals, see AllocatedInWords. The usage after the last GC is
+  // the baseline for the allocation until the next GC.
+  RelaxedAtomic<int64_t> new_allocated_in_words_ = {0};
+  RelaxedAtomic<int64_t> old_allocated_in_words_ = {0};
+  intptr_t new_used_after_gc_in_words_ = 0;
+  intptr_t old_used_after_gc_in_words_ = 0;
+
   static constexpr intptr_t kNoForcedGarbageCollection = -1;
 
   // Whether the next heap allocation (new or old) should trigger
@@ -373,7 +419,7 @@ class Heap {
   // sensitive codepaths.
   intptr_t gc_on_nth_allocation_;
 
-  friend class Become;       // VisitObjectPointers
+  friend class Become;       // VisitObjectPointers, AddPagesTo
   friend class GCCompactor;  // VisitObjectPointers
   friend class Precompiler;  // VisitObjects
   friend class ServiceEvent;
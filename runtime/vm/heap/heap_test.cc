@@ -16,6 +16,7 @@
 #include "vm/globals.h"
 #include "vm/heap/become.h"
 #include "vm/heap/heap.h"
+#include "vm/heap/safepoint.h"
 #include "vm/message_handler.h"
 #include "vm/message_snapshot.h"
 #include "vm/object_graph.h"
@@ -26,6 +27,12 @@
 namespace dart {
 
 DECLARE_FLAG(int, early_tenuring_threshold);
+DECLARE_FLAG(int, marker_task_heap_mb);
+DECLARE_FLAG(int, pretenure_survival_percent);
+DECLARE_FLAG(bool, new_gen_adaptive_sizing);
+DECLARE_FLAG(int, old_gen_release_rate);
+DECLARE_FLAG(int, sweeper_tasks);
+DECLARE_FLAG(bool, concurrent_sweep);
 
 TEST_CASE(OldGC) {
   const char* kScriptChars =
@@ -67,6 +74,36 @@ TEST_CASE(OldGC_Unsync) {
   TransitionNativeToVM transition(thread);
   GCTestHelper::CollectOldSpace();
 }
+
+TEST_CASE(OldGC_AdaptiveMarkerTasks) {
+  // Finalize any GC in progress as it is unsafe to change the number of
+  // marker tasks when incremental marking is in progress.
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectAllGarbage();
+  }
+  const intptr_t saved_heap_mb = FLAG_marker_task_heap_mb;
+  FLAG_marker_task_heap_mb = 1;
+
+  const char* kScriptChars =
+      "main() {\n"
+      "  return List.generate(100000, (i) => [i]);\n"
+      "}\n";
+  FLAG_log_marker_tasks = true;
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, nullptr);
+
+  EXPECT_VALID(result);
+  EXPECT(!Dart_IsNull(result));
+  EXPECT(Dart_IsList(result));
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectOldSpace();
+    GCTestHelper::CollectAllGarbage();
+  }
+  FLAG_log_marker_tasks = false;
+  FLAG_marker_task_heap_mb = saved_heap_mb;
+}
 #endif  // !defined(PRODUCT)
 
 TEST_CASE(LargeSweep) {
@@ -213,8 +250,92 @@ TEST_CASE(ClassHeapStats) {
     }
   }
 }
+
+TEST_CASE(PretenureSurvivingClass) {
+  const char* kScriptChars =
+      "class Node {\n"
+      "  var next;\n"
+      "}\n"
+      "var nodes;\n"
+      "main() {\n"
+      "  nodes = List.generate(100000, (i) => new Node());\n"
+      "}\n";
+  const intptr_t saved_percent = FLAG_pretenure_survival_percent;
+  FLAG_pretenure_survival_percent = 90;
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  Dart_Handle result = Dart_Invoke(h_lib, NewString("main"), 0, nullptr);
+  EXPECT_VALID(result);
+  {
+    TransitionNativeToVM transition(thread);
+    Library& lib = Library::Handle();
+    lib ^= Api::UnwrapHandle(h_lib);
+    const Class& cls = Class::Handle(GetClass(lib, "Node"));
+    Scavenger* new_space = thread->heap()->new_space();
+
+    // Every node survives, so once the survivors of one scavenge have been
+    // promoted by the next, the class is pretenured.
+    GCTestHelper::CollectNewSpace();
+    GCTestHelper::CollectNewSpace();
+    GCTestHelper::CollectNewSpace();
+    EXPECT(new_space->ShouldPretenure(cls.id()));
+    EXPECT(Instance::Handle(Instance::New(cls)).ptr()->IsOldObject());
+
+    // Old-space GCs forget the decision.
+    GCTestHelper::CollectOldSpace();
+    EXPECT(!new_space->ShouldPretenure(cls.id()));
+    EXPECT(Instance::Handle(Instance::New(cls)).ptr()->IsNewObject());
+  }
+  FLAG_pretenure_survival_percent = saved_percent;
+}
 #endif  // !PRODUCT
 
+ISOLATE_UNIT_TEST_CASE(AdaptiveNewSpaceSizing) {
+  const bool saved_adaptive = FLAG_new_gen_adaptive_sizing;
+  FLAG_new_gen_adaptive_sizing = true;
+  Scavenger* new_space = thread->heap()->new_space();
+  const intptr_t collections = new_space->collections();
+
+  // Allocate enough short-lived garbage to fill new-space several times.
+  for (intptr_t i = 0; i < 64 * MB / (1 * KB); i++) {
+    HANDLESCOPE(thread);
+    Array::Handle(Array::New(1 * KB / kWordSize, Heap::kNew));
+  }
+  EXPECT(new_space->collections() > collections + 1);
+
+  // Whatever the policy decided, new-space stays within its bounds.
+  EXPECT(new_space->ThresholdInWords() >= kPageSizeInWords);
+  EXPECT(new_space->ThresholdInWords() <=
+         FLAG_new_gen_semi_max_size * MBInWords *
+             IsolateGroup::Current()->MutatorCount());
+
+  FLAG_new_gen_adaptive_sizing = saved_adaptive;
+}
+
+static intptr_t deferred_finalizer_count = 0;
+
+static void CountDeferredFinalizer(void* peer) {
+  deferred_finalizer_count += reinterpret_cast<intptr_t>(peer);
+}
+
+ISOLATE_UNIT_TEST_CASE(DeferredFinalizerCallbacks) {
+  Heap* heap = thread->heap();
+  deferred_finalizer_count = 0;
+  {
+    GcSafepointOperationScope safepoint_operation(thread);
+    {
+      GcSafepointOperationScope nested(thread);
+      heap->EnqueueFinalizerCallback(CountDeferredFinalizer,
+                                     reinterpret_cast<void*>(1));
+      Heap::PendingFinalizers batch;
+      batch.Add({CountDeferredFinalizer, reinterpret_cast<void*>(2)});
+      heap->EnqueueFinalizerCallbacks(batch);
+    }
+    // Still inside the outer operation.
+    EXPECT_EQ(0, deferred_finalizer_count);
+  }
+  EXPECT_EQ(3, deferred_finalizer_count);
+}
+
 ISOLATE_UNIT_TEST_CASE(IterateReadOnly) {
   const String& obj = String::Handle(String::New("x", Heap::kOld));
 
@@ -1279,9 +1400,68 @@ ISOLATE_UNIT_TEST_CASE(SweepDontNeed) {
   EXPECT(delta_dontneed < -50 * MB);
 
   EXPECT(delta_dontneed < delta_normal);  // More negative.
+  FLAG_dontneed_on_sweep = false;
+
+  // A budget large enough to release all the free blocks.
+  FLAG_old_gen_release_rate = 1 * GB;
+  const intptr_t delta_release = gc_with_fragmentation();
+  EXPECT(delta_release < -50 * MB);
+  EXPECT(thread->isolate_group()->heap()->old_space()->released_in_bytes() >
+         50 * MB);
+  FLAG_old_gen_release_rate = 0;
 }
 #endif  // !defined(PRODUCT) && !defined(DART_HOST_OS_LINUX)
 
+ISOLATE_UNIT_TEST_CASE(ConcurrentSweepAllocation) {
+  SetFlagScope<int> sweeper_tasks(&FLAG_sweeper_tasks, 4);
+  SetFlagScope<bool> concurrent_sweep(&FLAG_concurrent_sweep, true);
+  Heap* heap = thread->isolate_group()->heap();
+
+  // Fill old-space pages with objects of which every fourth survives, so that
+  // sweeping leaves them partly used.
+  const intptr_t num_elements = 32 * MB / Array::InstanceSize(16);
+  const Array& list = Array::Handle(Array::New(num_elements, Heap::kOld));
+  {
+    HANDLESCOPE(thread);
+    Array& element = Array::Handle();
+    for (intptr_t i = 0; i < num_elements; i++) {
+      element = Array::New(16, Heap::kOld);
+      list.SetAt(i, element);
+    }
+  }
+  GCTestHelper::CollectOldSpace();
+  for (intptr_t i = 0; i < num_elements; i++) {
+    if ((i % 4) != 0) {
+      list.SetAt(i, Object::null_object());
+    }
+  }
+  const intptr_t capacity_before = heap->CapacityInWords(Heap::kOld);
+
+  // Allocate as much as was freed right after the GC, while the sweeper tasks
+  // are still running. Allocations finding no free space yet sweep pages
+  // themselves rather than growing old space.
+  heap->CollectGarbage(thread, GCType::kMarkSweep, GCReason::kDebugging);
+  {
+    HANDLESCOPE(thread);
+    Array& element = Array::Handle();
+    for (intptr_t i = 0; i < num_elements; i++) {
+      if ((i % 4) != 0) {
+        element = Array::New(16, Heap::kOld);
+        list.SetAt(i, element);
+      }
+    }
+  }
+  GCTestHelper::WaitForGCTasks();
+
+  // Old space only grows when the remaining pages are being swept by the
+  // sweeper tasks, or when lazily sweeping kMaxLazySweepPages pages did not
+  // free enough.
+  const intptr_t capacity_after = heap->CapacityInWords(Heap::kOld);
+  const intptr_t max_growth =
+      (FLAG_sweeper_tasks + PageSpace::kMaxLazySweepPages) * kPageSizeInWords;
+  EXPECT_LE(capacity_after, capacity_before + max_growth);
+}
+
 static void TestCardRememberedArray(bool immutable, bool compact) {
   constexpr intptr_t kNumElements = kNewAllocatableSize / kCompressedWordSize;
   Array& array = Array::Handle(Array::New(kNumElements));
@@ -1368,6 +1548,42 @@ ISOLATE_UNIT_TEST_CASE(CardRememberedWeakArray) {
   TestCardRememberedWeakArray(false);
 }
 
+ISOLATE_UNIT_TEST_CASE(PermanentPages_ObjectPool) {
+  const intptr_t length = PageSpace::kMinDirtyTrackedPoolLength;
+  const intptr_t young_index = length / 2;
+  const ObjectPool& pool = ObjectPool::Handle(ObjectPool::New(length));
+  const String& old_string = String::Handle(String::New("old", Heap::kOld));
+  for (intptr_t i = 0; i < length; i++) {
+    pool.SetTypeAt(i, ObjectPool::EntryType::kTaggedObject,
+                   ObjectPool::Patchability::kNotPatchable,
+                   ObjectPool::SnapshotBehavior::kSnapshotable);
+    pool.SetObjectAt(i, old_string);
+  }
+  {
+    const String& young_string =
+        String::Handle(String::New("young", Heap::kNew));
+    pool.SetObjectAt(young_index, young_string);
+  }
+
+  GCTestHelper::WaitForGCTasks();
+  PageSpace* old_space = thread->isolate_group()->heap()->old_space();
+  old_space->MakePagesPermanent();
+  Page* page = Page::Of(pool.ptr());
+  EXPECT(page->is_permanent());
+  EXPECT(page->has_dirty_cards());
+  EXPECT(pool.ptr()->untag()->IsMarked());
+
+  // The young string is only reachable through a dirty card of the pool.
+  GCTestHelper::CollectAllGarbage(/*compact=*/true);
+  GCTestHelper::CollectAllGarbage(/*compact=*/false);
+  String& result = String::Handle();
+  result ^= pool.ObjectAt(young_index);
+  EXPECT(result.Equals("young"));
+  result ^= pool.ObjectAt(0);
+  EXPECT(result.ptr() == old_string.ptr());
+  EXPECT(pool.ptr()->untag()->IsMarked());
+}
+
 struct ExistingObject;
 
 static constexpr uword kMarkBit = 1;
@@ -12,12 +12,21 @@
 #include "vm/heap/heap.h"
 #include "vm/heap/pages.h"
 #include "vm/log.h"
+#include "vm/os.h"
 #include "vm/thread_barrier.h"
 #include "vm/timeline.h"
 #include "vm/visitor.h"
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            incremental_compact_pause_ms,
+            0,
+            "If positive, size each incremental compaction's evacuation from "
+            "the measured cost of the previous one so that its pause stays "
+            "within this many milliseconds. Defaults to --gc_pause_target_ms.");
+DECLARE_FLAG(int, gc_pause_target_ms);
+
 void GCIncrementalCompactor::Prologue(PageSpace* old_space) {
   ASSERT(Thread::Current()->OwnsGCSafepoint());
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "StartIncrementalCompact");
@@ -147,8 +156,8 @@ class PrologueTask : public SafepointTask {
     for (;;) {
       intptr_t chunk = state_->freelist_cursor.fetch_add(1);
       if (chunk >= state_->freelist_limit) break;
-      intptr_t list_index = chunk / (FreeList::kNumLists + 1);
-      intptr_t size_class_index = chunk % (FreeList::kNumLists + 1);
+      intptr_t list_index = chunk / FreeList::kNumAllLists;
+      intptr_t size_class_index = chunk % FreeList::kNumAllLists;
       FreeList* freelist = &old_space_->freelists_[list_index];
 
       // Empty bump-region, no need to prune this.
@@ -181,8 +190,21 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
   // Evacuate no more than this amount of objects. This puts a bound on the
   // stop-the-world evacuate step that is similar to the existing longest
   // stop-the-world step of the scavenger.
-  const intptr_t kMaxEvacuatedBytes =
+  intptr_t max_evacuated_bytes =
       (old_space->heap_->new_space()->ThresholdInWords() << kWordSizeLog2) / 4;
+  const intptr_t pause_ms = FLAG_incremental_compact_pause_ms > 0
+                               ? FLAG_incremental_compact_pause_ms
+                               : FLAG_gc_pause_target_ms;
+  if ((pause_ms > 0) && (old_space->evacuate_bytes_per_micro_ > 0)) {
+    // Whatever part of the target is left after the forwarding work goes to
+    // copying. Always evacuate at least one page's worth so fragmentation is
+    // still reduced when forwarding alone exceeds the target.
+    const int64_t copy_micros = pause_ms * kMicrosecondsPerMillisecond -
+                                old_space->evacuate_fixed_micros_;
+    max_evacuated_bytes = Utils::Maximum<int64_t>(
+        kEvacuationThreshold,
+        copy_micros * old_space->evacuate_bytes_per_micro_);
+  }
 
   PrologueState state;
   {
@@ -206,7 +228,7 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
     intptr_t cumulative_live_bytes = 0;
     for (intptr_t i = 0; i < state.pages.length(); i++) {
       intptr_t live_bytes = state.pages[i].live_bytes;
-      if (cumulative_live_bytes + live_bytes <= kMaxEvacuatedBytes) {
+      if (cumulative_live_bytes + live_bytes <= max_evacuated_bytes) {
         num_candidates++;
         cumulative_live_bytes += live_bytes;
         state.pages[i].page->set_evacuation_candidate(true);
@@ -222,10 +244,8 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
 
     state.page_cursor = 0;
     state.page_limit = num_candidates;
-    state.freelist_cursor =
-        PageSpace::kDataFreelist * (FreeList::kNumLists + 1);
-    state.freelist_limit =
-        old_space->num_freelists_ * (FreeList::kNumLists + 1);
+    state.freelist_cursor = PageSpace::kDataFreelist * FreeList::kNumAllLists;
+    state.freelist_limit = old_space->num_freelists_ * FreeList::kNumAllLists;
 
     if (num_candidates == 0) return false;
   }
@@ -247,10 +267,7 @@ bool GCIncrementalCompactor::SelectEvacuationCandidates(PageSpace* old_space) {
        i < n; i++) {
     FreeList* freelist = &old_space->freelists_[i];
     ASSERT(freelist->top_ == freelist->end_);
-    freelist->free_map_.Reset();
-    for (intptr_t j = 0; j < FreeList::kNumLists; j++) {
-      freelist->free_map_.Set(j, freelist->free_lists_[j] != nullptr);
-    }
+    freelist->RebuildMaps();
   }
 
   return true;
@@ -265,7 +282,7 @@ void GCIncrementalCompactor::CheckFreeLists(PageSpace* old_space) {
       Page* page = Page::Of(freelist->top_);
       ASSERT(!page->is_evacuation_candidate());
     }
-    for (intptr_t j = 0; j <= FreeList::kNumLists; j++) {
+    for (intptr_t j = 0; j < FreeList::kNumAllLists; j++) {
       FreeListElement* current = freelist->free_lists_[j];
       while (current != nullptr) {
         Page* page = Page::Of(reinterpret_cast<uword>(current));
@@ -583,6 +600,18 @@ class EpilogueState {
   void AddNewFreeSize(intptr_t size) { new_free_size_ += size; }
   intptr_t NewFreeSize() { return new_free_size_; }
 
+  void AddBytesEvacuated(intptr_t size) { bytes_evacuated_ += size; }
+  intptr_t BytesEvacuated() { return bytes_evacuated_; }
+
+  // Called by every task once all tasks have finished copying; the first
+  // caller records the time.
+  void RecordEvacuationEnd() {
+    if (evacuation_end_slice_.exchange(false)) {
+      evacuation_end_micros_ = OS::GetCurrentMonotonicMicros();
+    }
+  }
+  int64_t EvacuationEndMicros() { return evacuation_end_micros_; }
+
  private:
   Page* evac_page_;
   StoreBufferBlock* block_;
@@ -596,6 +625,9 @@ class EpilogueState {
   RelaxedAtomic<bool> roots_slice_ = {true};
   RelaxedAtomic<bool> reset_progress_bars_slice_ = {true};
   RelaxedAtomic<intptr_t> new_free_size_ = {0};
+  RelaxedAtomic<intptr_t> bytes_evacuated_ = {0};
+  RelaxedAtomic<bool> evacuation_end_slice_ = {true};
+  int64_t evacuation_end_micros_ = 0;
 };
 
 class EpilogueTask : public SafepointTask {
@@ -619,6 +651,8 @@ class EpilogueTask : public SafepointTask {
 
     barrier_->Sync();
 
+    state_->RecordEvacuationEnd();
+
     IncrementalForwardingVisitor visitor(thread);
     if (state_->TakeOOM()) {
       old_space_->VisitRoots(&visitor);  // OOM reservation.
@@ -732,6 +766,7 @@ class EpilogueTask : public SafepointTask {
 
     old_space_->ReleaseLock(freelist_);
     old_space_->usage_.used_in_words -= (bytes_evacuated >> kWordSizeLog2);
+    state_->AddBytesEvacuated(bytes_evacuated);
 #if defined(SUPPORT_TIMELINE)
     tbes.SetNumArguments(1);
     tbes.FormatArgument(0, "bytes_evacuated", "%" Pd, bytes_evacuated);
@@ -764,6 +799,10 @@ class EpilogueTask : public SafepointTask {
          page = page->next()) {
       page->VisitRememberedCards(visitor, /*only_marked*/ true);
     }
+    for (Page* page = old_space_->permanent_pages_; page != nullptr;
+         page = page->next()) {
+      page->VisitRememberedCards(visitor, /*only_marked*/ true);
+    }
   }
 
   void ForwardNewSpace(IncrementalForwardingVisitor* visitor) {
@@ -843,7 +882,17 @@ void GCIncrementalCompactor::Evacuate(PageSpace* old_space) {
     tasks.Append(new EpilogueTask(barrier, isolate_group, old_space,
                                   old_space->DataFreeList(i), &state));
   }
+  const int64_t start = OS::GetCurrentMonotonicMicros();
   isolate_group->safepoint_handler()->RunTasks(&tasks);
+  const int64_t end = OS::GetCurrentMonotonicMicros();
+
+  const int64_t copy_micros = state.EvacuationEndMicros() - start;
+  const intptr_t bytes_evacuated = state.BytesEvacuated();
+  if ((copy_micros > 0) && (bytes_evacuated > 0)) {
+    old_space->evacuate_bytes_per_micro_ =
+        Utils::Maximum<intptr_t>(1, bytes_evacuated / copy_micros);
+  }
+  old_space->evacuate_fixed_micros_ = end - state.EvacuationEndMicros();
 
   old_space->heap_->new_space()->set_freed_in_words(state.NewFreeSize() >>
                                                     kWordSizeLog2);
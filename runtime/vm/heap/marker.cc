@@ -24,6 +24,13 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            marker_task_heap_mb,
+            0,
+            "When positive, use one old gen marking task per this many MB of "
+            "old gen in use, at least --marker_tasks and at most the number "
+            "of available processors.");
+
 template <bool sync>
 class MarkingVisitorBase : public ObjectPointerVisitor {
  public:
@@ -42,11 +49,15 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
         marked_bytes_(0),
         marked_micros_(0),
         concurrent_(true),
-        has_evacuation_candidate_(false) {}
+        has_evacuation_candidate_(false) {
+    set_stack_map_cache(&stack_map_cache_);
+  }
   ~MarkingVisitorBase() { ASSERT(delayed_.IsEmpty()); }
 
   uintptr_t marked_bytes() const { return marked_bytes_; }
   int64_t marked_micros() const { return marked_micros_; }
+  intptr_t steals() const { return steals_; }
+  int64_t idle_micros() const { return idle_micros_; }
   void AddMicros(int64_t micros) { marked_micros_ += micros; }
   void set_concurrent(bool value) { concurrent_ = value; }
 
@@ -238,6 +249,65 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
     return obj->untag()->HeapSize();
   }
 
+  // Objects on permanent pages are always marked, so MarkObject never pushes
+  // them. Treat them as roots instead, except for the clean cards of large
+  // object pools, whose targets are all permanent or pre-marked.
+  void VisitPermanentPage(Page* page) {
+    ASSERT(page->is_permanent());
+    uword cursor = page->object_start();
+    const uword end = page->object_end();
+    while (cursor < end) {
+      ObjectPtr obj = UntaggedObject::FromAddr(cursor);
+      const intptr_t class_id = obj->GetClassIdOfHeapObject();
+      const intptr_t size = obj->untag()->HeapSize();
+      cursor += size;
+      if ((class_id == kFreeListElement) || (class_id == kForwardingCorpse)) {
+        continue;
+      }
+      ASSERT(obj->untag()->IsMarked());
+      if ((class_id == kObjectPoolCid) && page->has_dirty_cards() &&
+          (static_cast<ObjectPoolPtr>(obj)->untag()->length_ >=
+           PageSpace::kMinDirtyTrackedPoolLength)) {
+        VisitDirtyCards(static_cast<ObjectPoolPtr>(obj));
+        marked_bytes_ += size;
+      } else {
+        old_work_list_.Push(obj);
+      }
+    }
+  }
+
+  void VisitDirtyCards(ObjectPoolPtr pool) {
+    Page* page = Page::Of(pool);
+    UntaggedObjectPool::Entry* entries = pool->untag()->data();
+    const uint8_t* entry_bits = pool->untag()->entry_bits();
+    const intptr_t length = pool->untag()->length_;
+    intptr_t i = 0;
+    while (i < length) {
+      ObjectPtr* slot = &entries[i].raw_obj_;
+      const uword card_end = Utils::RoundUp(reinterpret_cast<uword>(slot) + 1,
+                                            Page::kBytesPerDirtyCard);
+      const intptr_t next = Utils::Minimum(
+          length, i + static_cast<intptr_t>(
+                          (card_end - reinterpret_cast<uword>(slot)) /
+                          sizeof(UntaggedObjectPool::Entry)));
+      if (page->IsCardDirty(slot)) {
+        for (intptr_t j = i; j < next; j++) {
+          if (ObjectPool::TypeBits::decode(entry_bits[j]) ==
+              ObjectPool::EntryType::kTaggedObject) {
+            VisitPointer(&entries[j].raw_obj_);
+          }
+        }
+      }
+      i = next;
+    }
+    if (has_evacuation_candidate_) {
+      has_evacuation_candidate_ = false;
+      if (pool->untag()->TryAcquireRememberedBit()) {
+        Thread::Current()->StoreBufferAddObjectGC(pool);
+      }
+    }
+  }
+
   void DrainMarkingStack() {
     ASSERT(!concurrent_);
     Thread* thread = Thread::Current();
@@ -278,6 +348,9 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
         if (!obj->IsNewObject()) {
           marked_bytes_ += size;
         }
+        if (sync) {
+          old_work_list_.ShareWorkIfRequested();
+        }
       }
     } while (ProcessPendingWeakProperties());
   }
@@ -593,7 +666,13 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
   }
 
   bool WaitForWork(RelaxedAtomic<uintptr_t>* num_busy) {
-    return old_work_list_.WaitForWork(num_busy);
+    int64_t start = OS::GetCurrentMonotonicMicros();
+    bool more_work = old_work_list_.WaitForWork(num_busy);
+    idle_micros_ += OS::GetCurrentMonotonicMicros() - start;
+    if (more_work) {
+      steals_++;
+    }
+    return more_work;
   }
 
   void Flush(GCLinkedLists* global_list) {
@@ -720,8 +799,11 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
   GCLinkedLists delayed_;
   uintptr_t marked_bytes_;
   int64_t marked_micros_;
+  intptr_t steals_ = 0;
+  int64_t idle_micros_ = 0;
   bool concurrent_;
   bool has_evacuation_candidate_;
+  StackMapCache stack_map_cache_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MarkingVisitorBase);
 };
@@ -788,6 +870,7 @@ void GCMarker::ResetSlices() {
   root_slices_count_ = kNumFixedRootSlices;
 
   weak_slices_started_ = 0;
+  weak_table_chunks_started_ = 0;
 }
 
 void GCMarker::IterateRoots(ObjectPointerVisitor* visitor) {
@@ -823,12 +906,34 @@ void GCMarker::IterateRoots(ObjectPointerVisitor* visitor) {
 
 enum WeakSlices {
   kWeakHandles = 0,
-  kWeakTables,
   kRememberedSet,
   kNumWeakSlices,
 };
 
+template <class MarkingVisitorType>
+void GCMarker::IteratePermanentPages(MarkingVisitorType* visitor) {
+  Page* head = heap_->old_space()->permanent_pages();
+  if (head == nullptr) return;
+
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessPermanentPages");
+  // Pages are claimed in list order. The claim counter is not reset by
+  // ResetSlices, so each page is visited once per marking cycle even when
+  // concurrent marking is followed by a final parallel mark.
+  intptr_t claimed = permanent_pages_started_.fetch_add(1);
+  intptr_t index = 0;
+  for (Page* page = head; page != nullptr; page = page->next(), index++) {
+    if (index == claimed) {
+      visitor->VisitPermanentPage(page);
+      claimed = permanent_pages_started_.fetch_add(1);
+    }
+  }
+}
+
 void GCMarker::IterateWeakRoots(Thread* thread) {
+  // Every worker helps with the weak tables first, since they can be
+  // arbitrarily large.
+  ProcessWeakTables(thread);
+
   for (;;) {
     intptr_t slice = weak_slices_started_.fetch_add(1);
     if (slice >= kNumWeakSlices) {
@@ -839,9 +944,6 @@ void GCMarker::IterateWeakRoots(Thread* thread) {
       case kWeakHandles:
         ProcessWeakHandles(thread);
         break;
-      case kWeakTables:
-        ProcessWeakTables(thread);
-        break;
       case kRememberedSet:
         ProcessRememberedSet(thread);
         break;
@@ -859,46 +961,59 @@ void GCMarker::ProcessWeakHandles(Thread* thread) {
   isolate_group_->VisitWeakPersistentHandles(&visitor);
 }
 
+// Weak tables are split into chunks of this many entries, which the workers
+// claim from a shared counter.
+static constexpr intptr_t kWeakTableChunkSize = 16 * KB;
+
 void GCMarker::ProcessWeakTables(Thread* thread) {
   TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessWeakTables");
-  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
-    Dart_HeapSamplingDeleteCallback cleanup = nullptr;
-#if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
-    if (sel == Heap::kHeapSamplingData) {
-      cleanup = HeapProfileSampler::delete_callback();
-    }
-#endif
-    WeakTable* table =
-        heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel));
-    intptr_t size = table->size();
-    for (intptr_t i = 0; i < size; i++) {
-      if (table->IsValidEntryAtExclusive(i)) {
-        // The object has been collected.
-        ObjectPtr obj = table->ObjectAtExclusive(i);
-        if (obj->IsHeapObject() && !obj->untag()->IsMarked()) {
-          if (cleanup != nullptr) {
-            cleanup(reinterpret_cast<void*>(table->ValueAtExclusive(i)));
-          }
-          table->InvalidateAtExclusive(i);
-        }
+  Heap::PendingFinalizers cleanups;
+  for (;;) {
+    // Map the claimed chunk onto a table. The tables are not resized while
+    // the marker holds the safepoint, so every worker sees the same layout.
+    intptr_t chunk = weak_table_chunks_started_.fetch_add(1);
+    WeakTable* table = nullptr;
+    Heap::FinalizerCallback cleanup = nullptr;
+    for (intptr_t i = 0; i < 2 * Heap::kNumWeakSelectors; i++) {
+      const auto sel = static_cast<Heap::WeakSelector>(i >> 1);
+      WeakTable* candidate =
+          heap_->GetWeakTable((i & 1) == 0 ? Heap::kOld : Heap::kNew, sel);
+      const intptr_t num_chunks =
+          Utils::RoundUp(candidate->size(), kWeakTableChunkSize) /
+          kWeakTableChunkSize;
+      if (chunk < num_chunks) {
+        table = candidate;
+        cleanup = Heap::WeakTableCleanupFor(sel);
+        break;
       }
+      chunk -= num_chunks;
+    }
+    if (table == nullptr) {
+      break;  // No more chunks.
     }
-    table =
-        heap_->GetWeakTable(Heap::kNew, static_cast<Heap::WeakSelector>(sel));
-    size = table->size();
-    for (intptr_t i = 0; i < size; i++) {
+
+    const intptr_t start = chunk * kWeakTableChunkSize;
+    const intptr_t end =
+        Utils::Minimum(start + kWeakTableChunkSize, table->size());
+    for (intptr_t i = start; i < end; i++) {
       if (table->IsValidEntryAtExclusive(i)) {
         // The object has been collected.
         ObjectPtr obj = table->ObjectAtExclusive(i);
         if (obj->IsHeapObject() && !obj->untag()->IsMarked()) {
           if (cleanup != nullptr) {
-            cleanup(reinterpret_cast<void*>(table->ValueAtExclusive(i)));
+            void* value = reinterpret_cast<void*>(table->ValueAtExclusive(i));
+            if (FLAG_defer_finalizer_callbacks) {
+              cleanups.Add({cleanup, value});
+            } else {
+              cleanup(value);
+            }
           }
           table->InvalidateAtExclusive(i);
         }
       }
     }
   }
+  heap_->EnqueueFinalizerCallbacks(cleanups);
 }
 
 void GCMarker::ProcessRememberedSet(Thread* thread) {
@@ -956,6 +1071,7 @@ class ParallelMarkTask : public SafepointTask {
       visitor_->set_concurrent(false);
       marker_->IterateRoots(visitor_);
       visitor_->FinishedRoots();
+      marker_->IteratePermanentPages(visitor_);
 
       visitor_->ProcessDeferredMarking();
 
@@ -1012,8 +1128,10 @@ class ParallelMarkTask : public SafepointTask {
       int64_t stop = OS::GetCurrentMonotonicMicros();
       visitor_->AddMicros(stop - start);
       if (FLAG_log_marker_tasks) {
-        THR_Print("Task marked %" Pd " bytes in %" Pd64 " micros.\n",
-                  visitor_->marked_bytes(), visitor_->marked_micros());
+        THR_Print("Task marked %" Pd " bytes in %" Pd64
+                  " micros, idle %" Pd64 " micros, %" Pd " steals.\n",
+                  visitor_->marked_bytes(), visitor_->marked_micros(),
+                  visitor_->idle_micros(), visitor_->steals());
       }
     }
   }
@@ -1043,6 +1161,8 @@ class ConcurrentMarkTask : public ThreadPool::Task {
 #endif
   }
 
+  virtual Priority priority() const { return kGCPriority; }
+
   virtual void Run() {
     bool result = Thread::EnterIsolateGroupAsHelper(
         isolate_group_, Thread::kMarkerTask, /*bypass_safepoint=*/true);
@@ -1053,6 +1173,7 @@ class ConcurrentMarkTask : public ThreadPool::Task {
 
       marker_->IterateRoots(visitor_);
       visitor_->FinishedRoots();
+      marker_->IteratePermanentPages(visitor_);
 
       visitor_->DrainMarkingStackWithPauseChecks();
       int64_t stop = OS::GetCurrentMonotonicMicros();
@@ -1106,26 +1227,42 @@ intptr_t GCMarker::MarkedWordsPerMicro() const {
   if (marked_words_per_job_micro == 0) {
     marked_words_per_job_micro = 1;  // Prevent division by zero.
   }
-  intptr_t jobs = FLAG_marker_tasks;
+  intptr_t jobs = num_tasks_;
   if (jobs == 0) {
     jobs = 1;  // Marking on main thread is still one job.
   }
   return marked_words_per_job_micro * jobs;
 }
 
+// Without --marker_task_heap_mb, this is --marker_tasks. Otherwise, large old
+// gens get more workers so that the final stop-the-world marking pause does not
+// grow linearly with the heap on machines with many cores.
+static intptr_t NumMarkerTasks(Heap* heap) {
+  intptr_t num_tasks = FLAG_marker_tasks;
+  if ((num_tasks <= 0) || (FLAG_marker_task_heap_mb <= 0)) {
+    return num_tasks;
+  }
+  const intptr_t used_mb = RoundWordsToMB(heap->UsedInWords(Heap::kOld));
+  const intptr_t wanted = used_mb / FLAG_marker_task_heap_mb;
+  const intptr_t max_tasks = OS::NumberOfAvailableProcessors();
+  return Utils::Maximum(num_tasks, Utils::Minimum(wanted, max_tasks));
+}
+
 GCMarker::GCMarker(IsolateGroup* isolate_group, Heap* heap)
     : isolate_group_(isolate_group),
       heap_(heap),
+      num_tasks_(NumMarkerTasks(heap)),
       old_marking_stack_(),
       new_marking_stack_(),
       tlab_deferred_marking_stack_(),
       deferred_marking_stack_(),
       global_list_(),
       visitors_(),
+      permanent_pages_started_(0),
       marked_bytes_(0),
       marked_micros_(0) {
-  visitors_ = new SyncMarkingVisitor*[FLAG_marker_tasks];
-  for (intptr_t i = 0; i < FLAG_marker_tasks; i++) {
+  visitors_ = new SyncMarkingVisitor*[num_tasks_];
+  for (intptr_t i = 0; i < num_tasks_; i++) {
     visitors_[i] = nullptr;
   }
 }
@@ -1135,7 +1272,7 @@ GCMarker::~GCMarker() {
   // marker and before finalizing.
   if (isolate_group_->old_marking_stack() != nullptr) {
     isolate_group_->DisableIncrementalBarrier();
-    for (intptr_t i = 0; i < FLAG_marker_tasks; i++) {
+    for (intptr_t i = 0; i < num_tasks_; i++) {
       visitors_[i]->AbandonWork();
       delete visitors_[i];
     }
@@ -1147,7 +1284,7 @@ void GCMarker::StartConcurrentMark(PageSpace* page_space) {
   isolate_group_->EnableIncrementalBarrier(
       &old_marking_stack_, &new_marking_stack_, &deferred_marking_stack_);
 
-  const intptr_t num_tasks = FLAG_marker_tasks;
+  const intptr_t num_tasks = num_tasks_;
 
   {
     // Bulk increase task count before starting any task, instead of
@@ -1324,7 +1461,7 @@ void GCMarker::MarkObjects(PageSpace* page_space) {
   Prologue();
   {
     Thread* thread = Thread::Current();
-    const int num_tasks = FLAG_marker_tasks;
+    const intptr_t num_tasks = num_tasks_;
     if (num_tasks == 0) {
       TIMELINE_FUNCTION_GC_DURATION(thread, "Mark");
       int64_t start = OS::GetCurrentMonotonicMicros();
@@ -1336,6 +1473,7 @@ void GCMarker::MarkObjects(PageSpace* page_space) {
       ResetSlices();
       IterateRoots(&visitor);
       visitor.FinishedRoots();
+      IteratePermanentPages(&visitor);
       visitor.ProcessDeferredMarking();
       visitor.DrainMarkingStack();
       visitor.ProcessDeferredMarking();
@@ -1412,7 +1550,7 @@ void GCMarker::MarkObjects(PageSpace* page_space) {
 
 void GCMarker::PruneWeak(Scavenger* scavenger) {
   scavenger->PruneWeak(&global_list_);
-  for (intptr_t i = 0, n = FLAG_marker_tasks; i < n; i++) {
+  for (intptr_t i = 0, n = num_tasks_; i < n; i++) {
     scavenger->PruneWeak(visitors_[i]->delayed());
   }
 }
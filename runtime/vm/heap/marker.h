@@ -49,6 +49,8 @@ class GCMarker {
   void MarkObjects(PageSpace* page_space);
 
   intptr_t marked_words() const { return marked_bytes_ >> kWordSizeLog2; }
+  // Number of marking tasks, fixed for the lifetime of this marker.
+  intptr_t num_tasks() const { return num_tasks_; }
   intptr_t MarkedWordsPerMicro() const;
 
   void PruneWeak(Scavenger* scavenger);
@@ -58,6 +60,8 @@ class GCMarker {
   void Epilogue();
   void ResetSlices();
   void IterateRoots(ObjectPointerVisitor* visitor);
+  template <class MarkingVisitorType>
+  void IteratePermanentPages(MarkingVisitorType* visitor);
   void IterateWeakRoots(Thread* thread);
   void ProcessWeakHandles(Thread* thread);
   void ProcessWeakTables(Thread* thread);
@@ -69,6 +73,8 @@ class GCMarker {
 
   IsolateGroup* const isolate_group_;
   Heap* const heap_;
+  const intptr_t num_tasks_;
+
   // The regular marking worklists, divided by generation. The marker and the
   // write-barrier push here. Dividing by generation allows faster filtering at
   // the end of a scavenge.
@@ -93,6 +99,8 @@ class GCMarker {
   intptr_t root_slices_finished_;
   intptr_t root_slices_count_;
   RelaxedAtomic<intptr_t> weak_slices_started_;
+  RelaxedAtomic<intptr_t> weak_table_chunks_started_;
+  RelaxedAtomic<intptr_t> permanent_pages_started_;
 
   uintptr_t marked_bytes_;
   int64_t marked_micros_;
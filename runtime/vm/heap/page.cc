@@ -21,6 +21,11 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            numa_interleave_old_space,
+            false,
+            "Spread the memory of old-space data pages across NUMA nodes.");
+
 // This cache needs to be at least as big as FLAG_new_gen_semi_max_size or
 // munmap will noticeably impact performance.
 static constexpr intptr_t kPageCacheCapacity = 128 * kWordSize;
@@ -80,9 +85,17 @@ Page* Page::Allocate(intptr_t size, uword flags) {
   if (memory == nullptr) {
     memory = VirtualMemory::AllocateAligned(size, kPageSize, executable,
                                             compressed, name);
-  }
-  if (memory == nullptr) {
-    return nullptr;  // Out of memory.
+    if (memory == nullptr) {
+      return nullptr;  // Out of memory.
+    }
+    // Old-space is shared by every mutator and GC worker, so interleaving
+    // avoids concentrating it on one node's memory controller. New-space is
+    // left to first-touch placement, which keeps a thread's TLAB on its node.
+    // Cached pages keep whatever policy they were mapped with.
+    if (FLAG_numa_interleave_old_space &&
+        ((flags & (kNew | kExecutable)) == 0)) {
+      VirtualMemory::Interleave(memory->address(), size);
+    }
   }
 
   if ((flags & kNew) != 0) {
@@ -115,6 +128,7 @@ Page* Page::Allocate(intptr_t size, uword flags) {
   result->survivor_end_ = 0;
   result->resolved_top_ = 0;
   result->live_bytes_ = 0;
+  result->dirty_cards_ = nullptr;
 
   if ((flags & kNew) != 0) {
     uword top = result->object_start();
@@ -141,6 +155,7 @@ void Page::Deallocate() {
   }
 
   free(card_table_);
+  free(dirty_cards_);
 
   // Load before unregistering with LSAN, or LSAN will temporarily think it has
   // been leaked.
@@ -73,6 +73,7 @@ class Page {
     kNew = 1 << 4,
     kEvacuationCandidate = 1 << 5,
     kNeverEvacuate = 1 << 6,
+    kPermanent = 1 << 7,
   };
   bool is_executable() const { return (flags_ & kExecutable) != 0; }
   bool is_large() const { return (flags_ & kLarge) != 0; }
@@ -80,6 +81,9 @@ class Page {
   bool is_vm_isolate() const { return (flags_ & kVMIsolate) != 0; }
   bool is_new() const { return (flags_ & kNew) != 0; }
   bool is_old() const { return !is_new(); }
+  // Permanent pages hold pre-marked objects that are never swept, moved or
+  // freed. See PageSpace::MakePagesPermanent.
+  bool is_permanent() const { return (flags_ & kPermanent) != 0; }
   bool is_evacuation_candidate() const {
     return (flags_ & kEvacuationCandidate) != 0;
   }
@@ -200,6 +204,39 @@ class Page {
                             bool only_marked = false);
   void ResetProgressBar();
 
+  // Dirty cards track which uncompressed slots of a permanent page have been
+  // written since the page became permanent. Unlike the card table, they are
+  // never cleared, and the marker uses them to skip the clean parts of large
+  // object pools.
+  static constexpr intptr_t kBytesPerDirtyCardLog2 =
+      kWordSizeLog2 + kSlotsPerCardLog2;
+  static constexpr intptr_t kBytesPerDirtyCard = 1 << kBytesPerDirtyCardLog2;
+
+  bool has_dirty_cards() const { return dirty_cards_ != nullptr; }
+  void AllocateDirtyCards() {
+    ASSERT(dirty_cards_ == nullptr);
+    ASSERT(is_permanent());
+    size_t size_in_bits = memory_->size() >> kBytesPerDirtyCardLog2;
+    size_t size_in_bytes =
+        Utils::RoundUp(size_in_bits, kBitsPerWord) >> kBitsPerByteLog2;
+    dirty_cards_ = reinterpret_cast<RelaxedAtomic<uword>*>(
+        calloc(size_in_bytes, sizeof(uint8_t)));
+  }
+  void RememberDirtyCard(ObjectPtr const* slot) {
+    const intptr_t index = DirtyCardIndexOf(reinterpret_cast<uword>(slot));
+    const uword bit_mask = static_cast<uword>(1)
+                           << (index & (kBitsPerWord - 1));
+    if ((dirty_cards_[index >> kBitsPerWordLog2].load() & bit_mask) == 0) {
+      dirty_cards_[index >> kBitsPerWordLog2].fetch_or(bit_mask);
+    }
+  }
+  bool IsCardDirty(ObjectPtr const* slot) const {
+    const intptr_t index = DirtyCardIndexOf(reinterpret_cast<uword>(slot));
+    const uword bit_mask = static_cast<uword>(1)
+                           << (index & (kBitsPerWord - 1));
+    return (dirty_cards_[index >> kBitsPerWordLog2].load() & bit_mask) != 0;
+  }
+
   Thread* owner() const { return owner_; }
 
   // Remember the limit to which objects have been copied.
@@ -293,6 +330,11 @@ class Page {
     uword bit_mask = static_cast<uword>(1) << bit_offset;
     card_table_[word_offset].fetch_or(bit_mask);
   }
+  intptr_t DirtyCardIndexOf(uword slot) const {
+    ASSERT(Contains(slot));
+    ASSERT(dirty_cards_ != nullptr);
+    return (slot - reinterpret_cast<uword>(this)) >> kBytesPerDirtyCardLog2;
+  }
   bool IsCardRemembered(uword slot) {
     ASSERT(Contains(slot));
     if (card_table_ == nullptr) {
@@ -346,6 +388,9 @@ class Page {
 
   RelaxedAtomic<intptr_t> live_bytes_;
 
+  // Only allocated for permanent pages holding large object pools.
+  RelaxedAtomic<uword>* dirty_cards_;
+
   friend class CheckStoreBufferScavengeVisitor;
   friend class CheckStoreBufferEvacuateVisitor;
   friend class GCCompactor;
@@ -46,6 +46,27 @@ DEFINE_FLAG(bool,
             false,
             "Print free list statistics after a GC");
 DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
+DEFINE_FLAG(bool,
+            permanent_snapshot_pages,
+            false,
+            "In AOT, make the old-space pages holding the program snapshot "
+            "permanent after loading it, so old-space marking skips clean "
+            "object pool entries. Snapshot objects are never collected.");
+DEFINE_FLAG(int,
+            gc_pause_target_ms,
+            0,
+            "If positive, schedule GC work to keep pauses within this many "
+            "milliseconds: start concurrent marking early enough to finish "
+            "before the growth target, bound incremental compaction, and stop "
+            "growing new-space when scavenges exceed it. The target GC time "
+            "share is --old_gen_growth_time_ratio.");
+DEFINE_FLAG(int,
+            old_gen_release_rate,
+            0,
+            "If positive, the max number of KB per second of wall time between "
+            "GCs that sweeping returns to the OS from large free blocks in "
+            "partially used old-space pages.");
+DECLARE_FLAG(bool, huge_pages);
 
 // The initial estimate of how many words we can mark per microsecond (usage
 // before / mark-sweep time). This is a conservative value observed running
@@ -103,6 +124,7 @@ PageSpace::~PageSpace() {
   FreePages(pages_);
   FreePages(exec_pages_);
   FreePages(large_pages_);
+  FreePages(permanent_pages_);
   FreePages(image_pages_);
   ASSERT(marker_ == nullptr);
   delete[] freelists_;
@@ -430,6 +452,51 @@ uword PageSpace::TryAllocateInternal(intptr_t size,
   return result;
 }
 
+// Each mutator thread starts at its own data freelist, so isolates of the same
+// group that allocate in old space concurrently mostly take different locks,
+// and all of the free space the sweeper distributes over the freelists is
+// reachable from mutators. Other freelists are tried before growing.
+uword PageSpace::TryAllocateMutatorData(intptr_t size,
+                                        GrowthPolicy growth_policy) {
+  if (!IsAllocatableViaFreeLists(size)) {
+    return TryAllocateInternal(size, DataFreeList(), /*is_exec=*/false,
+                               growth_policy, /*is_protected=*/false,
+                               /*is_locked=*/false);
+  }
+  const intptr_t num_shards = heap_->new_space()->NumScavengeWorkers();
+  const intptr_t first =
+      num_shards == 1
+          ? 0
+          : Utils::WordHash(reinterpret_cast<intptr_t>(Thread::Current())) %
+                num_shards;
+  for (intptr_t i = 0; i < num_shards; i++) {
+    FreeList* freelist = DataFreeList((first + i) % num_shards);
+    uword result = freelist->TryAllocate(size, /*is_protected=*/false);
+    if (result != 0) {
+      Page::Of(result)->add_live_bytes(size);
+      usage_.used_in_words += (size >> kWordSizeLog2);
+      return result;
+    }
+  }
+  // Rather than growing while the concurrent sweepers have not reached every
+  // page yet, sweep a few pages here. This bounds the mutator's work while
+  // still recovering free space at the allocation rate.
+  FreeList* freelist = DataFreeList(first);
+  for (intptr_t i = 0; i < kMaxLazySweepPages; i++) {
+    if (!SweepPageForAllocation(freelist)) break;
+    uword result = freelist->TryAllocate(size, /*is_protected=*/false);
+    if (result != 0) {
+      Page::Of(result)->add_live_bytes(size);
+      usage_.used_in_words += (size >> kWordSizeLog2);
+      return result;
+    }
+  }
+  uword result = TryAllocateInFreshPage(size, freelist, /*is_exec=*/false,
+                                        growth_policy, /*is_locked=*/false);
+  ASSERT((result & kObjectAlignmentMask) == kOldObjectAlignmentOffset);
+  return result;
+}
+
 void PageSpace::AcquireLock(FreeList* freelist) {
   freelist->mutex()->Lock();
 }
@@ -492,6 +559,10 @@ class BasePageIterator : ValueObject {
       page_ = space_->large_pages_;
     }
     if ((page_ == nullptr) && (list_ == kLarge)) {
+      list_ = kPermanent;
+      page_ = space_->permanent_pages_;
+    }
+    if ((page_ == nullptr) && (list_ == kPermanent)) {
       list_ = kImage;
       page_ = space_->image_pages_;
     }
@@ -499,7 +570,7 @@ class BasePageIterator : ValueObject {
   }
 
  protected:
-  enum List { kRegular, kExecutable, kLarge, kImage };
+  enum List { kRegular, kExecutable, kLarge, kPermanent, kImage };
 
   void Initialize() {
     list_ = kRegular;
@@ -511,8 +582,12 @@ class BasePageIterator : ValueObject {
         list_ = kLarge;
         page_ = space_->large_pages_;
         if (page_ == nullptr) {
-          list_ = kImage;
-          page_ = space_->image_pages_;
+          list_ = kPermanent;
+          page_ = space_->permanent_pages_;
+          if (page_ == nullptr) {
+            list_ = kImage;
+            page_ = space_->image_pages_;
+          }
         }
       }
     }
@@ -641,6 +716,12 @@ bool PageSpace::DataContains(uword addr) const {
   return false;
 }
 
+void PageSpace::AddPagesTo(MallocGrowableArray<Page*>* pages) const {
+  for (ExclusivePageIterator it(this); !it.Done(); it.Advance()) {
+    pages->Add(it.page());
+  }
+}
+
 void PageSpace::AddRegionsToObjectSet(ObjectSet* set) const {
   ASSERT((pages_ != nullptr) || (exec_pages_ != nullptr) ||
          (large_pages_ != nullptr));
@@ -712,12 +793,20 @@ void PageSpace::VisitRememberedCards(
     if (page == tail) break;
     page = page->next();
   }
+
+  // The permanent page list does not change after it is created.
+  for (page = permanent_pages_; page != nullptr; page = page->next()) {
+    page->VisitRememberedCards(visitor);
+  }
 }
 
 void PageSpace::ResetProgressBars() const {
   for (Page* page = large_pages_; page != nullptr; page = page->next()) {
     page->ResetProgressBar();
   }
+  for (Page* page = permanent_pages_; page != nullptr; page = page->next()) {
+    page->ResetProgressBar();
+  }
 }
 
 void PageSpace::WriteProtect(bool read_only) {
@@ -756,6 +845,21 @@ void PageSpace::PrintToJSONObject(JSONObject* object) const {
   } else {
     space.AddProperty("avgCollectionPeriodMillis", 0.0);
   }
+  if (FLAG_huge_pages) {
+    // Covers all heap pages, since new-space pages share the same mappings.
+    intptr_t huge_page_bytes = VirtualMemory::HugePageBackedBytes();
+    if (huge_page_bytes >= 0) {
+      space.AddProperty64("_hugePageBackedBytes", huge_page_bytes);
+    }
+  }
+  intptr_t search_lengths[FreeList::kNumSearchLengthBuckets] = {};
+  for (intptr_t i = 0; i < num_freelists_; i++) {
+    freelists_[i].AddSearchLengthsTo(search_lengths);
+  }
+  JSONArray lengths(&space, "_freeListSearchLengths");
+  for (intptr_t i = 0; i < FreeList::kNumSearchLengthBuckets; i++) {
+    lengths.AddValue(search_lengths[i]);
+  }
 }
 
 class HeapMapAsJSONVisitor : public ObjectVisitor {
@@ -929,6 +1033,78 @@ void PageSpace::AssistTasks(MonitorLocker* ml) {
   }
 }
 
+void PageSpace::MakePagesPermanent() {
+  {
+    MonitorLocker ml(tasks_lock());
+    if ((phase() != kDone) || (tasks() > 0) || (marker_ != nullptr)) {
+      return;  // Concurrent marking or sweeping in progress.
+    }
+  }
+
+  // Nothing may be allocated on the pages after they become permanent, so
+  // drop every free block; they remain on the pages as walkable free list
+  // elements.
+  TryReleaseReservation();
+  ReleaseBumpAllocation();
+  for (intptr_t i = 0; i < num_freelists_; i++) {
+    freelists_[i].Reset();
+  }
+
+  {
+    MutexLocker ml(&pages_lock_);
+    Page* lists[] = {pages_, large_pages_};
+    for (Page* page : lists) {
+      while (page != nullptr) {
+        Page* next = page->next();
+        MakePagePermanentLocked(page);
+        page->set_next(permanent_pages_);
+        permanent_pages_ = page;
+        page = next;
+      }
+    }
+    pages_ = pages_tail_ = nullptr;
+    large_pages_ = large_pages_tail_ = nullptr;
+  }
+
+  TryReserveForOOM();
+}
+
+void PageSpace::MakePagePermanentLocked(Page* page) {
+  ASSERT(!page->is_executable());
+  // Never evacuate, so stale forwarding pages are ignored by the compactor.
+  page->flags_ |= Page::kPermanent | Page::kNeverEvacuate;
+
+  uword cursor = page->object_start();
+  uword end = page->object_end();
+  while (cursor < end) {
+    ObjectPtr obj = UntaggedObject::FromAddr(cursor);
+    const intptr_t cid = obj->GetClassIdOfHeapObject();
+    if ((cid != kFreeListElement) && (cid != kForwardingCorpse)) {
+      if (!obj->untag()->IsMarked()) {
+        obj->untag()->SetMarkBit();
+      }
+      if ((cid == kObjectPoolCid) &&
+          (static_cast<ObjectPoolPtr>(obj)->untag()->length_ >=
+           kMinDirtyTrackedPoolLength)) {
+        UntaggedObjectPool* pool = static_cast<ObjectPoolPtr>(obj)->untag();
+        if (!page->has_dirty_cards()) {
+          page->AllocateDirtyCards();
+        }
+        // Everything else in old-space is now permanent or pre-marked, so only
+        // entries pointing into new-space start out dirty.
+        for (intptr_t i = 0; i < pool->length_; i++) {
+          if ((ObjectPool::TypeBits::decode(pool->entry_bits()[i]) ==
+               ObjectPool::EntryType::kTaggedObject) &&
+              pool->data()[i].raw_obj_->IsNewObjectMayBeSmi()) {
+            page->RememberDirtyCard(&pool->data()[i].raw_obj_);
+          }
+        }
+      }
+    }
+    cursor += obj->untag()->HeapSize();
+  }
+}
+
 void PageSpace::TryReleaseReservation() {
   ASSERT(phase() != kSweepingLarge);
   ASSERT(phase() != kSweepingRegular);
@@ -960,6 +1136,34 @@ void PageSpace::TryReserveForOOM() {
   }
 }
 
+void PageSpace::ResetReleaseBudget() {
+  released_in_bytes_ = 0;
+  if (FLAG_old_gen_release_rate <= 0) {
+    release_budget_in_bytes_ = 0;
+    return;
+  }
+  // Memory freed by a burst of garbage is returned over the following GCs
+  // rather than all at once, so it is cheap to reuse if the burst repeats.
+  const int64_t kMaxReleaseBudgetMicros = 10 * kMicrosecondsPerSecond;
+  const int64_t now = OS::GetCurrentMonotonicMicros();
+  const int64_t elapsed = Utils::Minimum(now - last_release_budget_micros_,
+                                         kMaxReleaseBudgetMicros);
+  last_release_budget_micros_ = now;
+  const double budget = static_cast<double>(elapsed) *
+                        FLAG_old_gen_release_rate * KB / kMicrosecondsPerSecond;
+  release_budget_in_bytes_ = static_cast<intptr_t>(
+      Utils::Minimum(budget, static_cast<double>(kIntptrMax / 2)));
+}
+
+bool PageSpace::TryConsumeReleaseBudget(intptr_t size) {
+  if (release_budget_in_bytes_.fetch_sub(size) < size) {
+    release_budget_in_bytes_.fetch_add(size);
+    return false;
+  }
+  released_in_bytes_.fetch_add(size);
+  return true;
+}
+
 void PageSpace::VisitRoots(ObjectPointerVisitor* visitor) {
   if (oom_reservation_ != nullptr) {
     // FreeListElements are generally held untagged, but ObjectPointerVisitors
@@ -1117,6 +1321,8 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
     freelists_[i].Reset();
   }
 
+  ResetReleaseBudget();
+
   {
     // Move pages to sweeper work lists.
     MutexLocker ml(&pages_lock_);
@@ -1367,7 +1573,7 @@ void PageSpace::SweepExecutable() {
   MutexLocker ml(freelist->mutex());
   while (page != nullptr) {
     Page* next_page = page->next();
-    bool page_in_use = sweeper.SweepPage(page, freelist);
+    bool page_in_use = sweeper.SweepPage(page, freelist, this);
     if (page_in_use) {
       prev_page = page;
     } else {
@@ -1437,45 +1643,67 @@ void PageSpace::Sweep(bool exclusive) {
     }
   }
 
-  MutexLocker ml(&pages_lock_);
-  while (sweep_regular_ != nullptr) {
-    Page* page = sweep_regular_;
-    sweep_regular_ = page->next();
-    page->set_next(nullptr);
-    ASSERT(!page->is_executable());
-
-    ml.Unlock();
-    // Cycle through the shards round-robin so that free space is roughly
-    // evenly distributed among the freelists and so roughly evenly available
-    // to each scavenger worker.
+  // Cycle through the shards round-robin so that free space is roughly
+  // evenly distributed among the freelists and so roughly evenly available
+  // to each scavenger worker.
+  do {
     shard = (shard + 1) % num_shards;
-    FreeList* freelist = DataFreeList(shard);
-    if (!exclusive) {
-      freelist->mutex()->Lock();
-    }
-    bool page_in_use = sweeper.SweepPage(page, freelist);
-    if (!exclusive) {
-      freelist->mutex()->Unlock();
-    }
-    intptr_t size;
-    if (!page_in_use) {
-      size = page->memory_->size();
-      page->Deallocate();
+  } while (SweepNextRegularPage(&sweeper, DataFreeList(shard), exclusive));
+
+  if (exclusive) {
+    for (intptr_t i = 0; i < num_shards; i++) {
+      DataFreeList(i)->mutex()->Unlock();
     }
-    ml.Lock();
+  }
+}
 
-    if (page_in_use) {
-      AddPageLocked(page);
-    } else {
-      IncreaseCapacityInWordsLocked(-(size >> kWordSizeLog2));
+bool PageSpace::SweepNextRegularPage(GCSweeper* sweeper,
+                                     FreeList* freelist,
+                                     bool freelist_locked) {
+  Page* page;
+  {
+    MutexLocker ml(&pages_lock_);
+    page = sweep_regular_;
+    if (page == nullptr) {
+      return false;
     }
+    sweep_regular_ = page->next();
+    page->set_next(nullptr);
   }
+  ASSERT(!page->is_executable());
 
-  if (exclusive) {
-    for (intptr_t i = 0; i < num_shards; i++) {
-      DataFreeList(i)->mutex()->Unlock();
+  if (!freelist_locked) {
+    freelist->mutex()->Lock();
+  }
+  bool page_in_use = sweeper->SweepPage(page, freelist, this);
+  if (!freelist_locked) {
+    freelist->mutex()->Unlock();
+  }
+  intptr_t size;
+  if (!page_in_use) {
+    size = page->memory_->size();
+    page->Deallocate();
+  }
+
+  MutexLocker ml(&pages_lock_);
+  if (page_in_use) {
+    AddPageLocked(page);
+  } else {
+    IncreaseCapacityInWordsLocked(-(size >> kWordSizeLog2));
+  }
+  return true;
+}
+
+bool PageSpace::SweepPageForAllocation(FreeList* freelist) {
+  {
+    MonitorLocker ml(tasks_lock());
+    if (phase() != kSweepingRegular) {
+      return false;
     }
   }
+
+  GCSweeper sweeper;
+  return SweepNextRegularPage(&sweeper, freelist, /*freelist_locked=*/false);
 }
 
 void PageSpace::ConcurrentSweep(IsolateGroup* isolate_group) {
@@ -1587,6 +1815,7 @@ void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   page->survivor_end_ = 0;
   page->resolved_top_ = 0;
   page->live_bytes_ = 0;
+  page->dirty_cards_ = nullptr;
 
   MutexLocker ml(&pages_lock_);
   page->next_ = image_pages_;
@@ -1653,6 +1882,7 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
                                                     int64_t start,
                                                     int64_t end) {
   ASSERT(end >= start);
+  const int64_t previous_end = history_.LastEndMicros();
   history_.AddGarbageCollectionTime(start, end);
   const int gc_time_fraction = history_.GarbageCollectionTimeFraction();
 
@@ -1660,6 +1890,23 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
   // G = kA, and estimate k from the previous cycle.
   const intptr_t allocated_since_previous_gc =
       before.CombinedUsedInWords() - last_usage_.CombinedUsedInWords();
+
+  // Under a pause target, mutators should not end up doing the marking work
+  // themselves (see Heap::CheckConcurrentMarking), so begin concurrent marking
+  // early enough for the markers to finish at the current allocation rate.
+  marking_lead_in_words_ = 0;
+  if ((FLAG_gc_pause_target_ms > 0) && (heap_ != nullptr) &&
+      (previous_end != 0) && (start > previous_end) &&
+      (allocated_since_previous_gc > 0)) {
+    const double allocated_words_per_micro =
+        allocated_since_previous_gc / static_cast<double>(start - previous_end);
+    const intptr_t mark_words_per_micro =
+        Utils::Maximum<intptr_t>(1, heap_->old_space()->mark_words_per_micro_);
+    const double mark_micros =
+        after.CombinedUsedInWords() / static_cast<double>(mark_words_per_micro);
+    marking_lead_in_words_ =
+        static_cast<intptr_t>(allocated_words_per_micro * mark_micros);
+  }
   intptr_t growth_in_pages;
   if (allocated_since_previous_gc > 0) {
     intptr_t garbage =
@@ -1791,7 +2038,12 @@ void PageSpaceController::RecordUpdate(SpaceUsage before,
 
   bool concurrent_mark = FLAG_concurrent_mark && (FLAG_marker_tasks != 0);
   if (concurrent_mark) {
-    soft_gc_threshold_in_words_ = threshold;
+    // Never start marking before there is at least a page of new allocation.
+    soft_gc_threshold_in_words_ =
+        Utils::Maximum(threshold - marking_lead_in_words_,
+                       after.CombinedUsedInWords() + kPageSizeInWords);
+    soft_gc_threshold_in_words_ =
+        Utils::Minimum(soft_gc_threshold_in_words_, threshold);
     hard_gc_threshold_in_words_ = kIntptrMax / kWordSize;
   } else {
     soft_gc_threshold_in_words_ = kIntptrMax / kWordSize;
@@ -26,6 +26,7 @@ class ObjectPointerVisitor;
 class ObjectSet;
 class ForwardingPage;
 class GCMarker;
+class GCSweeper;
 
 // The history holds the timing information of the last garbage collection
 // runs.
@@ -40,6 +41,11 @@ class PageSpaceGarbageCollectionHistory {
 
   bool IsEmpty() const { return history_.Size() == 0; }
 
+  // End of the most recent collection, or 0 if there is none.
+  int64_t LastEndMicros() const {
+    return IsEmpty() ? 0 : history_.Get(0).end;
+  }
+
  private:
   struct Entry {
     int64_t start;
@@ -119,6 +125,10 @@ class PageSpaceController {
   // Run idle GC if time permits when usage exceeds this amount.
   intptr_t idle_gc_threshold_in_words_;
 
+  // With FLAG_gc_pause_target_ms, how far below the growth target concurrent
+  // marking starts, i.e., the words expected to be allocated while marking.
+  intptr_t marking_lead_in_words_ = 0;
+
   PageSpaceGarbageCollectionHistory history_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(PageSpaceController);
@@ -135,17 +145,23 @@ class PageSpace {
     kSweepingRegular
   };
 
+  // Upper bound on the pages a failed allocation sweeps before growing.
+  static constexpr intptr_t kMaxLazySweepPages = 4;
+
   PageSpace(Heap* heap, intptr_t max_capacity_in_words);
   ~PageSpace();
 
   uword TryAllocate(intptr_t size,
                     bool is_executable = false,
                     GrowthPolicy growth_policy = kControlGrowth) {
-    bool is_protected = (is_executable) && FLAG_write_protect_code;
+    if (!is_executable) {
+      return TryAllocateMutatorData(size, growth_policy);
+    }
+    bool is_protected = FLAG_write_protect_code;
     bool is_locked = false;
-    return TryAllocateInternal(
-        size, &freelists_[is_executable ? kExecutableFreelist : kDataFreelist],
-        is_executable, growth_policy, is_protected, is_locked);
+    return TryAllocateInternal(size, &freelists_[kExecutableFreelist],
+                               is_executable, growth_policy, is_protected,
+                               is_locked);
   }
   DART_FORCE_INLINE
   uword TryAllocatePromoLocked(FreeList* freelist, intptr_t size) {
@@ -173,6 +189,8 @@ class PageSpace {
   void TryReserveForOOM();
   void VisitRoots(ObjectPointerVisitor* visitor);
 
+  intptr_t mark_words_per_micro() const { return mark_words_per_micro_; }
+
   bool ReachedHardThreshold() const {
     return page_space_controller_.ReachedHardThreshold(usage_);
   }
@@ -223,6 +241,20 @@ class PageSpace {
     return size >> kWordSizeLog2;
   }
 
+  intptr_t ExecutableCapacityInWords() const {
+    intptr_t size = 0;
+    MutexLocker ml(&pages_lock_);
+    for (Page* page = exec_pages_; page != nullptr; page = page->next()) {
+      size += page->memory_->size();
+    }
+    for (Page* page = large_pages_; page != nullptr; page = page->next()) {
+      if (page->is_executable()) {
+        size += page->memory_->size();
+      }
+    }
+    return size >> kWordSizeLog2;
+  }
+
   bool Contains(uword addr) const;
   bool ContainsUnsafe(uword addr) const;
   bool CodeContains(uword addr) const;
@@ -242,6 +274,7 @@ class PageSpace {
   void CollectGarbage(Thread* thread, bool compact, bool finalize);
 
   void AddRegionsToObjectSet(ObjectSet* set) const;
+  void AddPagesTo(MallocGrowableArray<Page*>* pages) const;
 
   // Note: Code pages are made executable/non-executable when 'read_only' is
   // true/false, respectively.
@@ -260,6 +293,16 @@ class PageSpace {
 
   void IncrementCollections() { collections_++; }
 
+  // Free memory in partially used pages is returned to the OS while sweeping
+  // at the rate of FLAG_old_gen_release_rate. The budget is refilled at the
+  // start of each sweep.
+  void ResetReleaseBudget();
+  bool TryConsumeReleaseBudget(intptr_t size);
+  void AddReleased(intptr_t size) { released_in_bytes_.fetch_add(size); }
+  // The amount returned to the OS by the last sweep. Some of it may have been
+  // allocated again since.
+  intptr_t released_in_bytes() const { return released_in_bytes_; }
+
   intptr_t collections() const { return collections_; }
 
 #ifndef PRODUCT
@@ -343,6 +386,16 @@ class PageSpace {
 
   // Return any bump allocation block to the freelist.
   void ReleaseBumpAllocation();
+
+  // Moves every regular and large data page into the permanent page list and
+  // pre-marks their objects. Permanent pages are never swept, evacuated or
+  // freed, and receive no further allocation, so their objects become
+  // immortal. In exchange, the marker treats them as roots and only scans the
+  // dirty cards of object pools with at least kMinDirtyTrackedPoolLength
+  // entries. Intended to be called right after loading an AOT snapshot.
+  void MakePagesPermanent();
+  static constexpr intptr_t kMinDirtyTrackedPoolLength = 4 * KB;
+  Page* permanent_pages() const { return permanent_pages_; }
   // Have threads release marking stack blocks, etc.
   void AbandonMarkingForShutdown();
 
@@ -393,6 +446,7 @@ class PageSpace {
 
   // Attempt to allocate from bump block rather than normal freelist.
   uword TryAllocateDataBumpLocked(FreeList* freelist, intptr_t size);
+  uword TryAllocateMutatorData(intptr_t size, GrowthPolicy growth_policy);
   uword TryAllocatePromoLockedSlow(FreeList* freelist, intptr_t size);
   uword AllocateSnapshotLockedSlow(FreeList* freelist, intptr_t size);
 
@@ -413,6 +467,7 @@ class PageSpace {
   void FreePage(Page* page, Page* previous_page);
   void FreeLargePage(Page* page, Page* previous_page);
   void FreePages(Page* pages);
+  void MakePagePermanentLocked(Page* page);
 
   void CollectGarbageHelper(Thread* thread, bool compact, bool finalize);
   void VerifyStoreBuffers(const char* msg);
@@ -420,6 +475,15 @@ class PageSpace {
   void SweepNew();
   void SweepLarge();
   void Sweep(bool exclusive);
+  // Takes the next page off sweep_regular_ and sweeps it into 'freelist',
+  // which the caller has locked if 'freelist_locked'. Returns false if there
+  // was none.
+  bool SweepNextRegularPage(GCSweeper* sweeper,
+                            FreeList* freelist,
+                            bool freelist_locked);
+  // Sweeps one page not yet reached by the concurrent sweepers into
+  // 'freelist'. Returns false if there was none.
+  bool SweepPageForAllocation(FreeList* freelist);
   void ConcurrentSweep(IsolateGroup* isolate_group);
   void Compact(Thread* thread);
 
@@ -442,7 +506,8 @@ class PageSpace {
   // FLAG_scavenger_tasks count of lists for data pages starting at
   // freelists_[kDataFreelist]. The sweeper inserts into the data page
   // freelists round-robin. The scavenger workers each use one of the data
-  // page freelists without locking.
+  // page freelists without locking. Mutator threads are spread over the same
+  // data page freelists, see TryAllocateMutatorData.
   const intptr_t num_freelists_;
   enum {
     kExecutableFreelist = 0,
@@ -461,6 +526,7 @@ class PageSpace {
   Page* large_pages_ = nullptr;
   Page* large_pages_tail_ = nullptr;
   Page* image_pages_ = nullptr;
+  Page* permanent_pages_ = nullptr;
   Page* sweep_regular_ = nullptr;
   Page* sweep_large_ = nullptr;
   Page* sweep_new_ = nullptr;
@@ -492,6 +558,17 @@ class PageSpace {
   intptr_t collections_;
   intptr_t mark_words_per_micro_;
 
+  // Measured cost of the last incremental compaction epilogue, split into the
+  // evacuation copy speed and the remaining forwarding work that does not
+  // depend on how much was evacuated. Used to size the next evacuation to
+  // FLAG_incremental_compact_pause_ms.
+  intptr_t evacuate_bytes_per_micro_ = 0;
+  int64_t evacuate_fixed_micros_ = 0;
+
+  RelaxedAtomic<intptr_t> release_budget_in_bytes_ = {0};
+  RelaxedAtomic<intptr_t> released_in_bytes_ = {0};
+  int64_t last_release_budget_micros_ = 0;
+
   bool enable_concurrent_mark_;
 
   friend class BasePageIterator;
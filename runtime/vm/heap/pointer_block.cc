@@ -141,6 +141,7 @@ typename BlockStack<BlockSize>::Block* BlockStack<BlockSize>::WaitForWork(
       num_busy->fetch_add(1u);
       return partial_.Pop();
     }
+    work_requested_.store(true);
     ml.Wait();
     if (num_busy->load() == 0) {
       return nullptr;
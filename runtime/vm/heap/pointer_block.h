@@ -113,6 +113,11 @@ class BlockStack {
 
   Block* WaitForWork(RelaxedAtomic<uintptr_t>* num_busy, bool abort);
 
+  // Set when a worker blocks in WaitForWork. A busy worker that observes the
+  // request claims it and publishes part of its local work.
+  bool WorkRequested() const { return work_requested_.load(); }
+  bool ClaimWorkRequest() { return work_requested_.exchange(false); }
+
   void VisitObjectPointers(ObjectPointerVisitor* visitor);
 
  protected:
@@ -144,6 +149,7 @@ class BlockStack {
   List full_;
   List partial_;
   Monitor monitor_;
+  RelaxedAtomic<bool> work_requested_ = {false};
 
   // Note: This is shared on the basis of block size.
   static constexpr intptr_t kMaxGlobalEmpty = 100;
@@ -235,6 +241,22 @@ class BlockWorkList : public ValueObject {
     }
   }
 
+  // If another worker is waiting for work, publishes the local output block so
+  // the waiting worker can take it over instead of idling until this worker
+  // overflows a block. Returns true if a block was shared.
+  DART_FORCE_INLINE
+  bool ShareWorkIfRequested() {
+    if (LIKELY(!stack_->WorkRequested()) || local_output_->IsEmpty()) {
+      return false;
+    }
+    if (!stack_->ClaimWorkRequest()) {
+      return false;  // Another worker answered the request.
+    }
+    stack_->PushBlock(local_output_);
+    local_output_ = stack_->PopEmptyBlock();
+    return true;
+  }
+
   bool WaitForWork(RelaxedAtomic<uintptr_t>* num_busy, bool abort = false) {
     ASSERT(local_input_->IsEmpty() || abort);
     Block* new_work = stack_->WaitForWork(num_busy, abort);
@@ -8,6 +8,7 @@
 #include "vm/thread.h"
 #include "vm/thread_barrier.h"
 #include "vm/thread_registry.h"
+#include "vm/timeline.h"
 
 namespace dart {
 
@@ -28,6 +29,14 @@ SafepointOperationScope::~SafepointOperationScope() {
 
   auto handler = T->isolate_group()->safepoint_handler();
   handler->ResumeThreads(T, level_);
+
+  if (!T->OwnsSafepoint()) {
+    // Outermost operation: run finalizers the GC deferred past the pause.
+    Heap* heap = T->isolate_group()->heap();
+    if (heap != nullptr) {
+      heap->RunPendingFinalizerCallbacks();
+    }
+  }
 }
 
 ForceGrowthSafepointOperationScope::ForceGrowthSafepointOperationScope(
@@ -130,7 +139,19 @@ void SafepointHandler::SafepointThreads(Thread* T, SafepointLevel level) {
   }
 
   // Now wait for all threads that are not already at a safepoint to check-in.
-  handlers_[level]->WaitUntilThreadsReachedSafepointLevel();
+  {
+    TIMELINE_DURATION(T, VM, "TimeToSafepoint");
+#if defined(SUPPORT_TIMELINE)
+    if (tbes.enabled()) {
+      tbes.SetNumArguments(1);
+      tbes.FormatArgument(0, "level", "%d", static_cast<int>(level));
+    }
+#endif
+    const int64_t start_micros = OS::GetCurrentMonotonicMicros();
+    handlers_[level]->WaitUntilThreadsReachedSafepointLevel();
+    isolate_group()->GetSafepointTimeP99Metric()->Record(
+        OS::GetCurrentMonotonicMicros() - start_micros);
+  }
 
   // No other mutator is running at this point. We'll set ourselves as owners of
   // all the lower levels as well - since higher levels provide even more
@@ -332,6 +353,8 @@ void SafepointHandler::BlockForSafepoint(Thread* T) {
     EnterSafepointLocked(T, &tl, level);
     ExitSafepointLocked(T, &tl, level);
     ASSERT(!T->IsSafepointRequestedLocked(level));
+  } else if (T->IsHandshakeRequested()) {
+    RunHandshakeLocked(T, &tl);
   }
 }
 
@@ -362,7 +385,10 @@ void SafepointHandler::ExitSafepointLocked(Thread* T,
                                            MonitorLocker* tl,
                                            SafepointLevel level) {
   ASSERT(T == Thread::Current());
-  while (T->IsSafepointRequestedLocked(level)) {
+  // A handshake requester running its operation against us relies on us
+  // staying parked until it is done.
+  while (T->IsSafepointRequestedLocked(level) ||
+         (T->IsHandshakeRequested() && T->handshake_claimed_)) {
     T->SetBlockedForSafepoint(true);
     tl->Wait();
     T->SetBlockedForSafepoint(false);
@@ -384,6 +410,123 @@ void SafepointHandler::ExitSafepointLocked(Thread* T,
     }
   }
   T->SetAtSafepoint(false, level);
+
+  if (T->IsHandshakeRequested()) {
+    RunHandshakeLocked(T, tl);
+  }
+}
+
+bool SafepointHandler::Handshake(Thread* T,
+                                 Thread* target,
+                                 HandshakeOperation* op) {
+  ASSERT(T == Thread::Current());
+  ASSERT(T->execution_state() == Thread::kThreadInVM);
+  ASSERT(!target->BypassSafepoints());
+  if (target == T) {
+    op->Run(T);
+    return true;
+  }
+
+  TIMELINE_DURATION(T, VM, "Handshake");
+  bool installed = false;
+  for (;;) {
+    bool ran = false;
+    {
+      MonitorLocker ml(threads_lock());
+      MonitorLocker tl(target->thread_lock());
+      if (installed) {
+        if (op->completed_) {
+          return true;
+        }
+        if (target->handshake_operation_ != op) {
+          return false;  // Dropped when the target left the group.
+        }
+      } else {
+        if (!IsActiveThreadLocked(target)) {
+          return false;
+        }
+        if (target->handshake_operation_ == nullptr) {
+          // Setting the request forces the target's safepoint transitions
+          // onto the slow path, where it picks up the operation or waits for
+          // us to finish running it.
+          target->handshake_operation_ = op;
+          target->SetHandshakeRequested(true);
+          installed = true;
+          if (target->IsDartMutatorThread()) {
+            target->ScheduleInterrupts(Thread::kVMInterrupt);
+          }
+        }
+      }
+      if (installed && !target->handshake_claimed_ &&
+          target->IsAtSafepoint()) {
+        // The target is parked and cannot leave its safepoint (or the group,
+        // since we hold the registry lock) until we release it.
+        target->handshake_claimed_ = true;
+        {
+          MonitorLeaveScope mls(&tl);
+          op->Run(target);
+        }
+        CompleteHandshakeLocked(target);
+        tl.NotifyAll();
+        ran = true;
+      }
+    }
+    if (ran) {
+      NotifyHandshakeCompleted();
+      return true;
+    }
+
+    // Wait for the target to run the operation, for it to park, or for an
+    // earlier handshake on it to finish. Parking does not notify, so poll.
+    MonitorLocker hl(&handshake_lock_);
+    hl.WaitWithSafepointCheck(T, /*millis=*/1);
+  }
+}
+
+bool SafepointHandler::IsActiveThreadLocked(Thread* target) {
+  ASSERT(threads_lock()->IsOwnedByCurrentThread());
+  for (auto current = isolate_group()->thread_registry()->active_list();
+       current != nullptr; current = current->next()) {
+    if (current == target) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SafepointHandler::RunHandshakeLocked(Thread* T, MonitorLocker* tl) {
+  ASSERT(T == Thread::Current());
+  ASSERT(T->IsHandshakeRequested());
+  ASSERT(!T->handshake_claimed_);
+  HandshakeOperation* op = T->handshake_operation_;
+  ASSERT(op != nullptr);
+  T->handshake_claimed_ = true;
+  {
+    MonitorLeaveScope mls(tl);
+    Thread::ExecutionState execution_state = T->execution_state();
+    T->set_execution_state(Thread::kThreadInVM);
+    op->Run(T);
+    T->set_execution_state(execution_state);
+  }
+  CompleteHandshakeLocked(T);
+  {
+    MonitorLeaveScope mls(tl);
+    NotifyHandshakeCompleted();
+  }
+}
+
+void SafepointHandler::CompleteHandshakeLocked(Thread* target) {
+  ASSERT(target->thread_lock()->IsOwnedByCurrentThread());
+  ASSERT(target->handshake_claimed_);
+  target->handshake_operation_->completed_ = true;
+  target->handshake_operation_ = nullptr;
+  target->handshake_claimed_ = false;
+  target->SetHandshakeRequested(false);
+}
+
+void SafepointHandler::NotifyHandshakeCompleted() {
+  MonitorLocker hl(&handshake_lock_);
+  hl.NotifyAll();
 }
 
 void SafepointHandler::RunTasks(IntrusiveDList<SafepointTask>* tasks) {
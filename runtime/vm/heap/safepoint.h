@@ -91,6 +91,7 @@ class SafepointTask : public ThreadPool::Task,
   virtual ~SafepointTask();
 
   void Run();
+  virtual Priority priority() const { return kGCPriority; }
   void RunBlockedAtSafepoint();
   void RunMain();
   virtual void RunEnteredIsolateGroup() = 0;
@@ -104,6 +105,28 @@ class SafepointTask : public ThreadPool::Task,
   DISALLOW_COPY_AND_ASSIGN(SafepointTask);
 };
 
+// An operation that only needs one particular thread to be stopped, e.g.
+// scanning its stack or retiring its TLAB. See [SafepointHandler::Handshake].
+class HandshakeOperation {
+ public:
+  HandshakeOperation() {}
+  virtual ~HandshakeOperation() {}
+
+  // Runs while [target] is stopped at a point where it could be safepointed:
+  // either on the requesting thread, if [target] is parked, or on [target]
+  // itself at its next safepoint check. Must not start a safepoint operation
+  // or take the thread registry lock.
+  virtual void Run(Thread* target) = 0;
+
+ private:
+  friend class SafepointHandler;
+
+  // Guarded by the target's thread lock.
+  bool completed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(HandshakeOperation);
+};
+
 // Implements handling of safepoint operations for all threads in an
 // IsolateGroup.
 class SafepointHandler {
@@ -144,6 +167,16 @@ class SafepointHandler {
 
   void RunTasks(IntrusiveDList<SafepointTask>* tasks);
 
+  // Runs [op] for [target] without stopping the other threads of the group
+  // and returns once it has run. Returns false without running [op] if
+  // [target] is not, or stops being, an active thread of this group.
+  //
+  // Threads that are parked (in native code, blocked, descheduled) are
+  // handled right away by the calling thread. Running threads handle the
+  // operation at their next safepoint check; Dart mutators are interrupted
+  // to get there.
+  bool Handshake(Thread* T, Thread* target, HandshakeOperation* op);
+
  private:
   class LevelHandler {
    public:
@@ -223,6 +256,12 @@ class SafepointHandler {
   void EnterSafepointLocked(Thread* T, MonitorLocker* tl, SafepointLevel level);
   void ExitSafepointLocked(Thread* T, MonitorLocker* tl, SafepointLevel level);
 
+  // Helper methods for [Handshake].
+  bool IsActiveThreadLocked(Thread* target);
+  void RunHandshakeLocked(Thread* T, MonitorLocker* tl);
+  void CompleteHandshakeLocked(Thread* target);
+  void NotifyHandshakeCompleted();
+
   IsolateGroup* isolate_group() const { return isolate_group_; }
   Monitor* threads_lock() const {
     return isolate_group_->thread_registry()->threads_lock();
@@ -233,6 +272,9 @@ class SafepointHandler {
   LevelHandler* handlers_[SafepointLevel::kNumLevels];
   IntrusiveDList<SafepointTask> tasks_;
 
+  // Used by threads waiting for a handshake to complete.
+  Monitor handshake_lock_;
+
   friend class Isolate;
   friend class IsolateGroup;
   friend class SafepointOperationScope;
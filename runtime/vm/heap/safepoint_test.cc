@@ -388,6 +388,96 @@ class CheckinTask : public StateMachineTask {
   }
 };
 
+class RecordingHandshake : public HandshakeOperation {
+ public:
+  RecordingHandshake() {}
+
+  virtual void Run(Thread* target) {
+    target_ = target;
+    ran_on_ = Thread::Current();
+  }
+
+  std::atomic<Thread*> target_ = {nullptr};
+  std::atomic<Thread*> ran_on_ = {nullptr};
+};
+
+class HandshakeTask : public StateMachineTask {
+ public:
+  enum State {
+    kStartLoop = StateMachineTask::kNext,
+  };
+
+  struct Data : public StateMachineTask::Data {
+    Data(IsolateGroup* isolate_group, bool park)
+        : StateMachineTask::Data(isolate_group), park(park) {}
+
+    bool park;
+    std::atomic<Thread*> thread = {nullptr};
+  };
+
+  explicit HandshakeTask(std::shared_ptr<Data> data)
+      : StateMachineTask(data) {}
+
+ protected:
+  Data* data() { return reinterpret_cast<Data*>(data_.get()); }
+
+  virtual void RunInternal() {
+    data()->thread = thread_;
+    data_->WaitUntil(kStartLoop);
+    if (data()->park) {
+      thread_->EnterSafepoint();
+    }
+    while (!data()->IsIn(kPleaseExit)) {
+      OS::SleepMicros(100);
+      if (!data()->park) {
+        thread_->CheckForSafepoint();
+      }
+    }
+    if (data()->park) {
+      thread_->ExitSafepoint();
+    }
+  }
+};
+
+static void RunHandshakeTest(Thread* thread, bool park) {
+  std::shared_ptr<HandshakeTask::Data> data(
+      new HandshakeTask::Data(thread->isolate_group(), park));
+  ThreadPool pool;
+  pool.Run<HandshakeTask>(data);
+  data->WaitUntil(HandshakeTask::kEntered);
+  data->MarkAndNotify(HandshakeTask::kStartLoop);
+
+  Thread* target;
+  while ((target = data->thread) == nullptr) {
+    OS::SleepMicros(100);
+  }
+  RecordingHandshake op;
+  EXPECT(thread->isolate_group()->safepoint_handler()->Handshake(thread, target,
+                                                                 &op));
+  EXPECT_EQ(target, op.target_.load());
+  // A parked target is handled by the requester, a running one by itself.
+  EXPECT_EQ(park ? thread : target, op.ran_on_.load());
+  EXPECT(!target->IsHandshakeRequested());
+
+  data->MarkAndNotify(HandshakeTask::kPleaseExit);
+  data->WaitUntil(HandshakeTask::kExited);
+}
+
+ISOLATE_UNIT_TEST_CASE(Handshake_RunningThread) {
+  RunHandshakeTest(thread, /*park=*/false);
+}
+
+ISOLATE_UNIT_TEST_CASE(Handshake_ParkedThread) {
+  RunHandshakeTest(thread, /*park=*/true);
+}
+
+ISOLATE_UNIT_TEST_CASE(Handshake_Self) {
+  RecordingHandshake op;
+  EXPECT(thread->isolate_group()->safepoint_handler()->Handshake(thread, thread,
+                                                                 &op));
+  EXPECT_EQ(thread, op.ran_on_.load());
+}
+
 // Test that mutators will not check-in to "deopt safepoint operations" at
 // at places where the mutator cannot depot (which is indicated by the
 // [Thread::runtime_call_deopt_ability_] value).
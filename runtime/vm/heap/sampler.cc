@@ -40,6 +40,9 @@ Dart_HeapSamplingDeleteCallback HeapProfileSampler::delete_callback_ = nullptr;
 RwLock* HeapProfileSampler::lock_ = new RwLock();
 intptr_t HeapProfileSampler::sampling_interval_ =
     HeapProfileSampler::kDefaultSamplingInterval;
+bool HeapProfileSampler::allocation_profile_enabled_ = false;
+std::atomic<intptr_t> HeapProfileSampler::sampled_bytes_ = 0;
+std::atomic<intptr_t> HeapProfileSampler::freed_sampled_bytes_ = 0;
 
 HeapProfileSampler::HeapProfileSampler(Thread* thread)
     : interval_to_next_sample_(kUninitialized), thread_(thread) {}
@@ -57,6 +60,29 @@ void HeapProfileSampler::Enable(bool enabled) {
   });
 }
 
+void HeapProfileSampler::EnableAllocationProfile(bool enabled) {
+  bool sampling_enabled;
+  {
+    WriteRwLocker locker(Thread::Current(), lock_);
+    allocation_profile_enabled_ = enabled;
+    // Leave sampling on when disabling the profile if an embedder is still
+    // consuming samples.
+    sampling_enabled = enabled || (create_callback_ != nullptr && enabled_);
+  }
+  if (sampling_enabled != enabled_) {
+    Enable(sampling_enabled);
+  }
+}
+
+void HeapProfileSampler::ResetAllocationProfileCounters() {
+  sampled_bytes_ = 0;
+  freed_sampled_bytes_ = 0;
+}
+
+void HeapProfileSampler::FreedSampledAllocation(void* data) {
+  freed_sampled_bytes_.fetch_add(reinterpret_cast<intptr_t>(data));
+}
+
 void HeapProfileSampler::SetSamplingInterval(intptr_t bytes_interval) {
   // Don't try and change sampling interval state if sampler instances are
   // currently doing work.
@@ -199,8 +225,15 @@ void HeapProfileSampler::HandleNewTLAB(intptr_t old_tlab_remaining_space,
 
 void* HeapProfileSampler::InvokeCallbackForLastSample(intptr_t cid) {
   ASSERT(enabled_);
-  ASSERT(create_callback_ != nullptr);
   ReadRwLocker locker(thread_, lock_);
+  if (allocation_profile_enabled_) {
+    sampled_bytes_.fetch_add(last_sample_size_);
+  }
+  if (create_callback_ == nullptr) {
+    // Only the built-in allocation profile is consuming samples.
+    last_sample_size_ = kUninitialized;
+    return nullptr;
+  }
   ClassTable* table = IsolateGroup::Current()->class_table();
   void* result = create_callback_(
       reinterpret_cast<Dart_Isolate>(thread_->isolate()),
@@ -55,6 +55,29 @@ class HeapProfileSampler {
     return delete_callback_;
   }
 
+  // Enables or disables the VM's built-in sampled allocation profile.
+  //
+  // While enabled, every sampled allocation also records the allocating
+  // Dart stack in the profiler's allocation sample buffer, weighted by the
+  // number of bytes the sample accounts for. Sampled objects are tracked in
+  // a weak table so the bytes they account for can be reported as freed
+  // once they are collected. This works with or without an embedder
+  // sampling callback, and enables heap sampling if it is not already on.
+  static void EnableAllocationProfile(bool enabled);
+  static bool allocation_profile_enabled() {
+    return allocation_profile_enabled_;
+  }
+
+  // Total bytes accounted for by sampled allocations, and the portion of
+  // those that belonged to objects which have since been collected.
+  static intptr_t sampled_bytes() { return sampled_bytes_.load(); }
+  static intptr_t freed_sampled_bytes() { return freed_sampled_bytes_.load(); }
+  static void ResetAllocationProfileCounters();
+
+  // Weak table cleanup for Heap::kSampledAllocations entries. |data| holds
+  // the number of sampled bytes recorded for the collected object.
+  static void FreedSampledAllocation(void* data);
+
   void Initialize();
   void Cleanup() {
     ResetState();
@@ -119,8 +142,13 @@ class HeapProfileSampler {
   // allocations.
   void HandleNewTLAB(intptr_t old_tlab_remaining_space, bool is_first_tlab);
 
+  // Invokes the embedder's create callback, if any, for the outstanding
+  // sample and clears it. Returns nullptr if there is no embedder callback.
   void* InvokeCallbackForLastSample(intptr_t cid);
 
+  // The number of bytes accounted for by the outstanding sample.
+  intptr_t last_sample_size() const { return last_sample_size_; }
+
   bool HasOutstandingSample() const {
     return last_sample_size_ != kUninitialized;
   }
@@ -158,6 +186,9 @@ class HeapProfileSampler {
   static Dart_HeapSamplingCreateCallback create_callback_;
   static Dart_HeapSamplingDeleteCallback delete_callback_;
   static intptr_t sampling_interval_;
+  static bool allocation_profile_enabled_;
+  static std::atomic<intptr_t> sampled_bytes_;
+  static std::atomic<intptr_t> freed_sampled_bytes_;
 
   static constexpr intptr_t kUninitialized = -1;
   static constexpr intptr_t kDefaultSamplingInterval = 512 * KB;
@@ -46,6 +46,18 @@ DEFINE_FLAG(int,
             90,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
+DEFINE_FLAG(bool,
+            new_gen_adaptive_sizing,
+            false,
+            "Size new gen to minimize the measured scavenge cost per allocated "
+            "word, and shrink it when allocation is slow.");
+DEFINE_FLAG(int,
+            pretenure_survival_percent,
+            0,
+            "When positive, allocate instances of a class directly in old "
+            "space once at least this percentage of its scavenge survivors "
+            "are promoted by the next scavenge. 0 disables pretenuring.");
+DECLARE_FLAG(int, gc_pause_target_ms);
 
 // Scavenger uses the kCardRememberedBit to distinguish forwarded and
 // non-forwarded objects. We must choose a bit that is clear for all new-space
@@ -144,7 +156,9 @@ class ScavengerVisitorBase : public ObjectPointerVisitor,
         bytes_promoted_(0),
         visiting_old_object_(nullptr),
         pending_(nullptr),
-        promoted_list_(promotion_stack) {}
+        promoted_list_(promotion_stack) {
+    set_stack_map_cache(&stack_map_cache_);
+  }
   ~ScavengerVisitorBase() { ASSERT(pending_ == nullptr); }
 
 #ifdef DEBUG
@@ -334,7 +348,23 @@ class ScavengerVisitorBase : public ObjectPointerVisitor,
   }
 
   bool WaitForWork(RelaxedAtomic<uintptr_t>* num_busy) {
-    return promoted_list_.WaitForWork(num_busy, scavenger_->abort_);
+    int64_t start = OS::GetCurrentMonotonicMicros();
+    bool more_work = promoted_list_.WaitForWork(num_busy, scavenger_->abort_);
+    idle_micros_ += OS::GetCurrentMonotonicMicros() - start;
+    if (more_work) {
+      steals_++;
+    }
+    return more_work;
+  }
+
+  intptr_t steals() const { return steals_; }
+  int64_t idle_micros() const { return idle_micros_; }
+
+  const MallocGrowableArray<intptr_t>& copied_words_by_cid() const {
+    return copied_words_by_cid_;
+  }
+  const MallocGrowableArray<intptr_t>& promoted_words_by_cid() const {
+    return promoted_words_by_cid_;
   }
 
   void ProcessWeak() {
@@ -518,6 +548,9 @@ class ScavengerVisitorBase : public ObjectPointerVisitor,
           promoted_list_.Push(new_obj);
           bytes_promoted_ += size;
         }
+        if (UNLIKELY(FLAG_pretenure_survival_percent > 0)) {
+          RecordSurvivor(cid, size, new_obj->IsOldObject());
+        }
       } else {
         ASSERT(IsForwarding(header));
         if (new_obj->IsOldObject()) {
@@ -569,6 +602,18 @@ class ScavengerVisitorBase : public ObjectPointerVisitor,
 
   DART_NOINLINE uword TryAllocateCopySlow(intptr_t size);
 
+  void RecordSurvivor(intptr_t cid, intptr_t size, bool promoted) {
+    // Only user classes are pretenured: predefined classes such as strings,
+    // closures and boxes are allocated by too many unrelated sites.
+    if (cid < kNumPredefinedCids) return;
+    MallocGrowableArray<intptr_t>* words =
+        promoted ? &promoted_words_by_cid_ : &copied_words_by_cid_;
+    while (words->length() <= cid) {
+      words->Add(0);
+    }
+    (*words)[cid] += size >> kWordSizeLog2;
+  }
+
   DART_NOINLINE DART_NORETURN void AbortScavenge() {
     if (FLAG_verbose_gc) {
       OS::PrintErr("Aborting scavenge\n");
@@ -619,6 +664,10 @@ class ScavengerVisitorBase : public ObjectPointerVisitor,
   PageSpace* page_space_;
   FreeList* freelist_;
   intptr_t bytes_promoted_;
+  intptr_t steals_ = 0;
+  int64_t idle_micros_ = 0;
+  MallocGrowableArray<intptr_t> copied_words_by_cid_;
+  MallocGrowableArray<intptr_t> promoted_words_by_cid_;
   ObjectPtr visiting_old_object_;
   StoreBufferBlock* pending_;
   PromotionWorkList promoted_list_;
@@ -631,6 +680,8 @@ class ScavengerVisitorBase : public ObjectPointerVisitor,
   Page* tail_ = nullptr;  // Allocating from here.
   Page* scan_ = nullptr;  // Resolving from here.
 
+  StackMapCache stack_map_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(ScavengerVisitorBase);
 };
 
@@ -853,6 +904,22 @@ intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
     }
   }
 
+  if ((FLAG_gc_pause_target_ms > 0) && (stats_history_.Size() != 0) &&
+      (stats_history_.Get(0).DurationMicros() >
+       FLAG_gc_pause_target_ms * kMicrosecondsPerMillisecond)) {
+    // Scavenges are already over the pause target; a bigger new-space would
+    // only give them more to copy.
+    grow = false;
+  }
+
+  const intptr_t limit = MaxNewSizeInWords();
+
+  intptr_t growth_factor = grow ? FLAG_new_gen_growth_factor : 1;
+  return Utils::Minimum(old_size_in_words * growth_factor, limit);
+}
+
+intptr_t Scavenger::MaxNewSizeInWords() const {
+  intptr_t num_mutators = heap_->isolate_group()->MutatorCount();
   // Let new-space scale up with the number of active mutators.
   intptr_t limit = max_semi_capacity_in_words_ *
                    Utils::Minimum(num_mutators, static_cast<intptr_t>(8));
@@ -862,9 +929,99 @@ intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
   limit = Utils::Maximum(limit, max_semi_capacity_in_words_);
   // Align to TLAB size.
   limit = Utils::RoundDown(limit, kPageSizeInWords);
+  return limit;
+}
 
-  intptr_t growth_factor = grow ? FLAG_new_gen_growth_factor : 1;
-  return Utils::Minimum(old_size_in_words * growth_factor, limit);
+// If filling new-space took longer than this, allocation is slow enough that
+// a smaller new-space costs little extra scavenging.
+static constexpr int64_t kSlowFillMicros = 1000 * kMicrosecondsPerMillisecond;
+
+intptr_t Scavenger::AdaptiveNewSizeInWords(intptr_t old_size_in_words,
+                                           GCReason reason) {
+  const intptr_t num_mutators = heap_->isolate_group()->MutatorCount();
+  // Keep at least two TLABs per mutator.
+  const intptr_t min_size = Utils::Maximum(
+      Utils::RoundUp(Utils::Minimum(max_semi_capacity_in_words_,
+                                    FLAG_new_gen_semi_initial_size * MBInWords),
+                     kPageSizeInWords),
+      2 * num_mutators * kPageSizeInWords);
+  const intptr_t max_size = Utils::Maximum(MaxNewSizeInWords(), min_size);
+  const intptr_t old_size =
+      Utils::Minimum(Utils::Maximum(old_size_in_words, min_size), max_size);
+
+  // A scavenge for another reason than new-space being full says nothing
+  // about the new-space size.
+  if ((reason != GCReason::kNewSpace) || (stats_history_.Size() < 2)) {
+    return old_size;
+  }
+  const ScavengeStats& last = stats_history_.Get(0);
+  const ScavengeStats& previous = stats_history_.Get(1);
+  const intptr_t allocated = last.UsedBeforeInWords();
+  if (allocated == 0) {
+    return old_size;
+  }
+
+  // The cost of a scavenge includes the old-space marking work its promotions
+  // will cause later.
+  const intptr_t mark_words_per_micro =
+      Utils::Maximum<intptr_t>(1, heap_->old_space()->mark_words_per_micro());
+  const double cost_per_word =
+      (last.DurationMicros() +
+       last.promoted_in_words() / static_cast<double>(mark_words_per_micro)) /
+      allocated;
+  const int64_t fill_micros = last.start_micros() - previous.end_micros();
+
+  // Hill-climb on the cost: keep stepping in the same direction while the
+  // cost falls, reverse when it rises, and hold when it is flat.
+  intptr_t step = 0;  // -1 shrink, 0 hold, 1 grow.
+  const char* reason_text = "flat cost";
+  if (fill_micros > kSlowFillMicros) {
+    growing_ = false;
+    step = -1;
+    reason_text = "slow allocation";
+  } else if (last_cost_per_word_ == 0.0) {
+    growing_ = last.ExpectedGarbageFraction(old_size) <
+               (FLAG_new_gen_garbage_threshold / 100.0);
+    step = growing_ ? 1 : 0;
+    reason_text = growing_ ? "high survival" : "low survival";
+  } else if (cost_per_word < 0.95 * last_cost_per_word_) {
+    step = growing_ ? 1 : -1;
+    reason_text = "cost fell";
+  } else if (cost_per_word > 1.05 * last_cost_per_word_) {
+    growing_ = !growing_;
+    step = growing_ ? 1 : -1;
+    reason_text = "cost rose";
+  }
+  last_cost_per_word_ = cost_per_word;
+
+  if ((step > 0) && (FLAG_gc_pause_target_ms > 0) &&
+      (last.DurationMicros() >
+       FLAG_gc_pause_target_ms * kMicrosecondsPerMillisecond)) {
+    step = 0;
+    reason_text = "pause target";
+  }
+
+  intptr_t new_size = old_size;
+  if (step > 0) {
+    new_size = old_size * FLAG_new_gen_growth_factor;
+  } else if (step < 0) {
+    new_size = old_size / FLAG_new_gen_growth_factor;
+  }
+  new_size = Utils::RoundDown(new_size, kPageSizeInWords);
+  new_size = Utils::Minimum(Utils::Maximum(new_size, min_size), max_size);
+
+  if (FLAG_verbose_gc) {
+    OS::PrintErr("[ New-space sizing: survival %.1f%%, promoted %" Pd
+                 " KB, cost %.2f us/MB, %s (%s): %" Pd " KB -> %" Pd
+                 " KB ]\n",
+                 last.SurvivalFraction() * 100.0,
+                 RoundWordsToKB(last.promoted_in_words()),
+                 cost_per_word * MBInWords,
+                 step > 0 ? "grow" : (step < 0 ? "shrink" : "hold"),
+                 reason_text,
+                 RoundWordsToKB(old_size), RoundWordsToKB(new_size));
+  }
+  return new_size;
 }
 
 class CollectStoreBufferScavengeVisitor : public ObjectPointerVisitor {
@@ -1063,7 +1220,10 @@ SemiSpace* Scavenger::Prologue(GCReason reason) {
   {
     MutexLocker ml(&space_lock_);
     from = to_;
-    to_ = new SemiSpace(NewSizeInWords(from->gc_threshold_in_words(), reason));
+    const intptr_t old_size = from->gc_threshold_in_words();
+    to_ = new SemiSpace(FLAG_new_gen_adaptive_sizing
+                            ? AdaptiveNewSizeInWords(old_size, reason)
+                            : NewSizeInWords(old_size, reason));
   }
 
   return from;
@@ -1259,11 +1419,13 @@ void Scavenger::IterateRoots(ScavengerVisitorBase<parallel>* visitor) {
 
 enum WeakSlices {
   kWeakHandles = 0,
-  kWeakTables,
+  kForwardTables,
   kProgressBars,
   kRememberLiveTemporaries,
   kPruneWeak,
-  kNumWeakSlices,
+  // One slice per weak selector, so the tables are rehashed in parallel.
+  kWeakTables,
+  kNumWeakSlices = kWeakTables + Heap::kNumWeakSelectors,
 };
 
 void Scavenger::IterateWeak() {
@@ -1277,8 +1439,8 @@ void Scavenger::IterateWeak() {
       case kWeakHandles:
         MournWeakHandles();
         break;
-      case kWeakTables:
-        MournWeakTables();
+      case kForwardTables:
+        MournForwardTables();
         break;
       case kProgressBars:
         heap_->old_space()->ResetProgressBars();
@@ -1294,7 +1456,9 @@ void Scavenger::IterateWeak() {
         }
       } break;
       default:
-        UNREACHABLE();
+        ASSERT(slice >= kWeakTables);
+        MournWeakTable(slice - kWeakTables);
+        break;
     }
   }
 
@@ -1320,6 +1484,9 @@ void ScavengerVisitorBase<parallel>::ProcessToSpace() {
     while (resolved_top < scan_->top_) {
       ObjectPtr obj = UntaggedObject::FromAddr(resolved_top);
       resolved_top += ProcessObject(obj);
+      if (parallel) {
+        promoted_list_.ShareWorkIfRequested();
+      }
     }
     scan_->resolved_top_ = resolved_top;
 
@@ -1342,6 +1509,9 @@ void ScavengerVisitorBase<parallel>::ProcessPromotedList() {
     if (thread_->is_marking() && obj->untag()->TryAcquireMarkBit()) {
       thread_->MarkingStackAddObject(obj);
     }
+    if (parallel) {
+      promoted_list_.ShareWorkIfRequested();
+    }
   }
 }
 
@@ -1441,57 +1611,68 @@ intptr_t ScavengerVisitorBase<parallel>::ProcessObject(ObjectPtr obj) {
   return obj->untag()->VisitPointersNonvirtual(this);
 }
 
-void Scavenger::MournWeakTables() {
-  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "MournWeakTables");
-
-  auto rehash_weak_table = [](WeakTable* table, WeakTable* replacement_new,
-                              WeakTable* replacement_old,
-                              Dart_HeapSamplingDeleteCallback cleanup) {
-    intptr_t size = table->size();
-    for (intptr_t i = 0; i < size; i++) {
-      if (table->IsValidEntryAtExclusive(i)) {
-        ObjectPtr obj = table->ObjectAtExclusive(i);
-        ASSERT(obj->IsHeapObject());
-        uword raw_addr = UntaggedObject::ToAddr(obj);
-        uword header = *reinterpret_cast<uword*>(raw_addr);
-        if (IsForwarding(header)) {
-          // The object has survived.  Preserve its record.
-          obj = ForwardedObj(header);
-          auto replacement =
-              obj->IsNewObject() ? replacement_new : replacement_old;
-          replacement->SetValueExclusive(obj, table->ValueAtExclusive(i));
-        } else {
-          // The object has been collected.
-          if (cleanup != nullptr) {
-            cleanup(reinterpret_cast<void*>(table->ValueAtExclusive(i)));
+// Moves the surviving entries of 'table' into the replacement for their new
+// space, and reports the values of dead entries to 'cleanup'.
+static void RehashWeakTable(WeakTable* table,
+                            WeakTable* replacement_new,
+                            WeakTable* replacement_old,
+                            Heap::FinalizerCallback cleanup,
+                            Heap::PendingFinalizers* cleanups) {
+  intptr_t size = table->size();
+  for (intptr_t i = 0; i < size; i++) {
+    if (table->IsValidEntryAtExclusive(i)) {
+      ObjectPtr obj = table->ObjectAtExclusive(i);
+      ASSERT(obj->IsHeapObject());
+      uword raw_addr = UntaggedObject::ToAddr(obj);
+      uword header = *reinterpret_cast<uword*>(raw_addr);
+      if (IsForwarding(header)) {
+        // The object has survived.  Preserve its record.
+        obj = ForwardedObj(header);
+        auto replacement =
+            obj->IsNewObject() ? replacement_new : replacement_old;
+        replacement->SetValueExclusive(obj, table->ValueAtExclusive(i));
+      } else {
+        // The object has been collected.
+        if (cleanup != nullptr) {
+          void* value = reinterpret_cast<void*>(table->ValueAtExclusive(i));
+          if (FLAG_defer_finalizer_callbacks) {
+            cleanups->Add({cleanup, value});
+          } else {
+            cleanup(value);
           }
         }
       }
     }
-  };
-
-  // Rehash the weak tables now that we know which objects survive this cycle.
-  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
-    const auto selector = static_cast<Heap::WeakSelector>(sel);
-    auto table = heap_->GetWeakTable(Heap::kNew, selector);
-    auto table_old = heap_->GetWeakTable(Heap::kOld, selector);
-
-    // Create a new weak table for the new-space.
-    auto table_new = WeakTable::NewFrom(table);
+  }
+}
 
-    Dart_HeapSamplingDeleteCallback cleanup = nullptr;
-#if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
-    if (sel == Heap::kHeapSamplingData) {
-      cleanup = HeapProfileSampler::delete_callback();
-    }
-#endif
-    rehash_weak_table(table, table_new, table_old, cleanup);
-    heap_->SetWeakTable(Heap::kNew, selector, table_new);
+void Scavenger::MournWeakTable(intptr_t sel) {
+  const auto selector = static_cast<Heap::WeakSelector>(sel);
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "MournWeakTable");
+
+  // Rehash the weak table now that we know which objects survive this cycle.
+  // Each selector has its own pair of tables, so workers handling different
+  // selectors do not interfere.
+  auto table = heap_->GetWeakTable(Heap::kNew, selector);
+  auto table_old = heap_->GetWeakTable(Heap::kOld, selector);
+
+  // Create a new weak table for the new-space.
+  auto table_new = WeakTable::NewFrom(table);
+
+  Heap::FinalizerCallback cleanup =
+      Heap::WeakTableCleanupFor(static_cast<Heap::WeakSelector>(selector));
+  Heap::PendingFinalizers cleanups;
+  RehashWeakTable(table, table_new, table_old, cleanup, &cleanups);
+  heap_->SetWeakTable(Heap::kNew, selector, table_new);
+  heap_->EnqueueFinalizerCallbacks(cleanups);
+
+  // Remove the old table as it has been replaced with the newly allocated
+  // table above.
+  delete table;
+}
 
-    // Remove the old table as it has been replaced with the newly allocated
-    // table above.
-    delete table;
-  }
+void Scavenger::MournForwardTables() {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "MournForwardTables");
 
   // Each isolate might have a weak table used for fast snapshot writing (i.e.
   // isolate communication). Rehash those tables if need be.
@@ -1500,8 +1681,8 @@ void Scavenger::MournWeakTables() {
         auto table = isolate->forward_table_new();
         if (table != nullptr) {
           auto replacement = WeakTable::NewFrom(table);
-          rehash_weak_table(table, replacement, isolate->forward_table_old(),
-                            nullptr);
+          RehashWeakTable(table, replacement, isolate->forward_table_old(),
+                          nullptr, nullptr);
           isolate->set_forward_table_new(replacement);
         }
       },
@@ -1777,6 +1958,13 @@ void Scavenger::VisitObjects(ObjectVisitor* visitor) const {
   }
 }
 
+void Scavenger::AddPagesTo(MallocGrowableArray<Page*>* pages) const {
+  ASSERT(Thread::Current()->OwnsGCSafepoint());
+  for (Page* page = to_->head(); page != nullptr; page = page->next()) {
+    pages->Add(page);
+  }
+}
+
 void Scavenger::AddRegionsToObjectSet(ObjectSet* set) const {
   for (Page* page = to_->head(); page != nullptr; page = page->next()) {
     set->AddRegion(page->start(), page->end());
@@ -1923,15 +2111,20 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   SemiSpace* from = Prologue(reason);
 
   intptr_t bytes_promoted;
+  intptr_t steals = 0;
+  int64_t idle_micros = 0;
   if (FLAG_scavenger_tasks == 0) {
     bytes_promoted = SerialScavenge(from);
   } else {
-    bytes_promoted = ParallelScavenge(from);
+    bytes_promoted = ParallelScavenge(from, &steals, &idle_micros);
   }
   if (abort_) {
     ReverseScavenge(&from);
     bytes_promoted = 0;
+    copied_words_by_cid_.Clear();
+    promoted_words_by_cid_.Clear();
   } else {
+    UpdatePretenuring();
     if ((ThresholdInWords() - UsedInWords()) < KBInWords) {
       // Don't scavenge again until the next old-space GC has occurred. Prevents
       // performing one scavenge per allocation as the heap limit is approached.
@@ -1944,7 +2137,14 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   int64_t end = OS::GetCurrentMonotonicMicros();
   stats_history_.Add(ScavengeStats(
       start, end, usage_before, GetCurrentUsage(), promo_candidate_words,
-      bytes_promoted >> kWordSizeLog2, abandoned_bytes >> kWordSizeLog2));
+      bytes_promoted >> kWordSizeLog2, abandoned_bytes >> kWordSizeLog2,
+      steals, idle_micros));
+  if (FLAG_verbose_gc && (FLAG_scavenger_tasks != 0)) {
+    OS::PrintErr("[ Scavenge tasks: %" Pd ", steals: %" Pd
+                 ", idle: %.2f ms ]\n",
+                 NumScavengeWorkers(), steals,
+                 MicrosecondsToMilliseconds(idle_micros));
+  }
   Epilogue(from);
   heap_->old_space()->ResumeConcurrentMarking();
 
@@ -1964,6 +2164,76 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
          failed_to_promote_);
 }
 
+template <bool parallel>
+void Scavenger::AddSurvivorsFrom(ScavengerVisitorBase<parallel>* visitor) {
+  auto add = [](const MallocGrowableArray<intptr_t>& from,
+                MallocGrowableArray<intptr_t>* to) {
+    while (to->length() < from.length()) {
+      to->Add(0);
+    }
+    for (intptr_t cid = 0; cid < from.length(); cid++) {
+      (*to)[cid] += from[cid];
+    }
+  };
+  add(visitor->copied_words_by_cid(), &copied_words_by_cid_);
+  add(visitor->promoted_words_by_cid(), &promoted_words_by_cid_);
+}
+
+// Objects promoted by this scavenge are those that were copied within new
+// space by the previous one. If nearly all instances of a class that survive
+// once go on to survive again, copying them is wasted work. (After early
+// tenuring, first-time survivors are promoted too, which only happens when
+// most survivors are already long lived.)
+void Scavenger::UpdatePretenuring() {
+  // Ignore classes with too few survivors for the ratio to be meaningful.
+  constexpr intptr_t kMinCandidateWords = 64 * KBInWords;
+
+  for (intptr_t cid = 0; cid < promoted_words_by_cid_.length(); cid++) {
+    const intptr_t candidates = cid < prior_copied_words_by_cid_.length()
+                                    ? prior_copied_words_by_cid_[cid]
+                                    : 0;
+    const intptr_t promoted = promoted_words_by_cid_[cid];
+    if ((candidates >= kMinCandidateWords) &&
+        (promoted * 100 >= candidates * FLAG_pretenure_survival_percent) &&
+        !ShouldPretenure(cid)) {
+      SetPretenured(cid, true);
+      if (FLAG_verbose_gc) {
+        OS::PrintErr("Pretenuring class id %" Pd " (%" Pd " of %" Pd
+                     " surviving words promoted)\n",
+                     cid, promoted, candidates);
+      }
+    }
+  }
+
+  prior_copied_words_by_cid_.Clear();
+  for (intptr_t cid = 0; cid < copied_words_by_cid_.length(); cid++) {
+    prior_copied_words_by_cid_.Add(copied_words_by_cid_[cid]);
+  }
+  copied_words_by_cid_.Clear();
+  promoted_words_by_cid_.Clear();
+}
+
+void Scavenger::SetPretenured(intptr_t cid, bool value) {
+  while (pretenured_cids_.length() <= cid) {
+    pretenured_cids_.Add(false);
+  }
+  pretenured_cids_[cid] = value;
+#if !defined(PRODUCT)
+  // Make the inline allocation fast paths take the allocation stub slow path,
+  // which allocates through the runtime.
+  heap_->isolate_group()->class_table()->SetPretenureFor(cid, value);
+#endif
+}
+
+void Scavenger::ResetPretenuring() {
+  for (intptr_t cid = 0; cid < pretenured_cids_.length(); cid++) {
+    if (pretenured_cids_[cid]) {
+      SetPretenured(cid, false);
+    }
+  }
+  pretenured_cids_.Clear();
+}
+
 static constexpr intptr_t kMinAutoScavengeWorkers = 2;
 static constexpr intptr_t kMaxAutoScavengeWorkers = 4;
 
@@ -2006,10 +2276,13 @@ intptr_t Scavenger::SerialScavenge(SemiSpace* from) {
   visitor.ProcessWeak();
   visitor.Finalize(heap_->isolate_group()->store_buffer());
   to_->AddList(visitor.head(), visitor.tail());
+  AddSurvivorsFrom(&visitor);
   return visitor.bytes_promoted();
 }
 
-intptr_t Scavenger::ParallelScavenge(SemiSpace* from) {
+intptr_t Scavenger::ParallelScavenge(SemiSpace* from,
+                                     intptr_t* steals,
+                                     int64_t* idle_micros) {
   intptr_t bytes_promoted = 0;
   const intptr_t num_tasks = NumScavengeWorkers();
 
@@ -2036,6 +2309,9 @@ intptr_t Scavenger::ParallelScavenge(SemiSpace* from) {
     visitor->Finalize(store_buffer);
     to_->AddList(visitor->head(), visitor->tail());
     bytes_promoted += visitor->bytes_promoted();
+    *steals += visitor->steals();
+    *idle_micros += visitor->idle_micros();
+    AddSurvivorsFrom(visitor);
     delete visitor;
   }
 
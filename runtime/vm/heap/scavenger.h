@@ -11,6 +11,7 @@
 #include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/growable_array.h"
 #include "vm/heap/page.h"
 #include "vm/heap/spaces.h"
 #include "vm/isolate.h"
@@ -80,14 +81,18 @@ class ScavengeStats {
                 SpaceUsage after,
                 intptr_t promo_candidates_in_words,
                 intptr_t promoted_in_words,
-                intptr_t abandoned_in_words)
+                intptr_t abandoned_in_words,
+                intptr_t steals,
+                int64_t idle_micros)
       : start_micros_(start_micros),
         end_micros_(end_micros),
         before_(before),
         after_(after),
         promo_candidates_in_words_(promo_candidates_in_words),
         promoted_in_words_(promoted_in_words),
-        abandoned_in_words_(abandoned_in_words) {}
+        abandoned_in_words_(abandoned_in_words),
+        steals_(steals),
+        idle_micros_(idle_micros) {}
 
   // Of all data before scavenge, what fraction was found to be garbage?
   // If this scavenge included growth, assume the extra capacity would become
@@ -109,8 +114,25 @@ class ScavengeStats {
 
   intptr_t UsedBeforeInWords() const { return before_.used_in_words; }
 
+  // Fraction of the data before the scavenge that was copied or promoted.
+  double SurvivalFraction() const {
+    return before_.used_in_words > 0
+               ? (after_.used_in_words + promoted_in_words_) /
+                     static_cast<double>(before_.used_in_words)
+               : 0.0;
+  }
+
+  intptr_t promoted_in_words() const { return promoted_in_words_; }
+  int64_t start_micros() const { return start_micros_; }
+  int64_t end_micros() const { return end_micros_; }
+
   int64_t DurationMicros() const { return end_micros_ - start_micros_; }
 
+  // Number of times a parallel worker that ran out of work picked up work
+  // published by another worker, and the total time workers spent waiting.
+  intptr_t steals() const { return steals_; }
+  int64_t idle_micros() const { return idle_micros_; }
+
  private:
   int64_t start_micros_;
   int64_t end_micros_;
@@ -119,6 +141,8 @@ class ScavengeStats {
   intptr_t promo_candidates_in_words_;
   intptr_t promoted_in_words_;
   intptr_t abandoned_in_words_;
+  intptr_t steals_;
+  int64_t idle_micros_;
 };
 
 class Scavenger {
@@ -179,6 +203,7 @@ class Scavenger {
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
   void AddRegionsToObjectSet(ObjectSet* set) const;
+  void AddPagesTo(MallocGrowableArray<Page*>* pages) const;
 
   void WriteProtect(bool read_only);
 
@@ -248,6 +273,18 @@ class Scavenger {
   intptr_t NumScavengeWorkers();
   static intptr_t NumDataFreelists();
 
+  // Whether instances of the class |cid| have consistently survived
+  // scavenges, so that allocating them directly in old space is cheaper than
+  // copying them until they are promoted. See --pretenure_survival_percent.
+  // Only changes at safepoints.
+  bool ShouldPretenure(intptr_t cid) const {
+    return (cid < pretenured_cids_.length()) && pretenured_cids_[cid];
+  }
+  // Forgets all pretenuring decisions, so that classes whose instances no
+  // longer live long are allocated in new space again. Called after each
+  // old-space GC.
+  void ResetPretenuring();
+
  private:
   // Ids for time and data records in Heap::GCStats.
   enum {
@@ -278,7 +315,9 @@ class Scavenger {
   void TryAllocateNewTLAB(Thread* thread, intptr_t size, bool can_safepoint);
 
   SemiSpace* Prologue(GCReason reason);
-  intptr_t ParallelScavenge(SemiSpace* from);
+  intptr_t ParallelScavenge(SemiSpace* from,
+                            intptr_t* steals,
+                            int64_t* idle_micros);
   intptr_t SerialScavenge(SemiSpace* from);
   void ReverseScavenge(SemiSpace** from);
   void IterateIsolateRoots(ObjectPointerVisitor* visitor);
@@ -291,15 +330,23 @@ class Scavenger {
   void IterateRoots(ScavengerVisitorBase<parallel>* visitor);
   void IterateWeak();
   void MournWeakHandles();
-  void MournWeakTables();
+  void MournWeakTable(intptr_t selector);
+  void MournForwardTables();
   void Epilogue(SemiSpace* from);
 
   void VerifyStoreBuffers(const char* msg);
 
+  template <bool parallel>
+  void AddSurvivorsFrom(ScavengerVisitorBase<parallel>* visitor);
+  void UpdatePretenuring();
+  void SetPretenured(intptr_t cid, bool value);
+
   void UpdateMaxHeapCapacity();
   void UpdateMaxHeapUsage();
 
   intptr_t NewSizeInWords(intptr_t old_size_in_words, GCReason reason) const;
+  intptr_t AdaptiveNewSizeInWords(intptr_t old_size_in_words, GCReason reason);
+  intptr_t MaxNewSizeInWords() const;
 
   Heap* heap_;
 
@@ -323,6 +370,12 @@ class Scavenger {
   static constexpr int kStatsHistoryCapacity = 4;
   RingBuffer<ScavengeStats, kStatsHistoryCapacity> stats_history_;
 
+  // State of the FLAG_new_gen_adaptive_sizing policy: the cost per allocated
+  // word measured after the last resize decision, and the direction of the
+  // last step.
+  double last_cost_per_word_ = 0.0;
+  bool growing_ = true;
+
   intptr_t scavenge_words_per_micro_;
   intptr_t idle_scavenge_threshold_in_words_ = 0;
 
@@ -330,6 +383,13 @@ class Scavenger {
   RelaxedAtomic<intptr_t> external_size_ = {0};
   RelaxedAtomic<intptr_t> freed_in_words_ = 0;
 
+  // Words of each class that survived their first scavenge (copied within new
+  // space) or their second (promoted), in the current and previous scavenge.
+  MallocGrowableArray<intptr_t> copied_words_by_cid_;
+  MallocGrowableArray<intptr_t> promoted_words_by_cid_;
+  MallocGrowableArray<intptr_t> prior_copied_words_by_cid_;
+  MallocGrowableArray<bool> pretenured_cids_;
+
   RelaxedAtomic<bool> failed_to_promote_ = {false};
   RelaxedAtomic<bool> abort_ = {false};
 
@@ -4,6 +4,7 @@
 
 #include "vm/heap/sweeper.h"
 
+#include "vm/flags.h"
 #include "vm/globals.h"
 #include "vm/heap/freelist.h"
 #include "vm/heap/heap.h"
@@ -15,6 +16,16 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            sweeper_tasks,
+            2,
+            "The number of tasks used to sweep old space concurrently.");
+DECLARE_FLAG(int, old_gen_release_rate);
+
+// Smaller free blocks are likely to be allocated into again soon, so they are
+// not worth the system calls and page faults.
+static constexpr intptr_t kMinReleasedFreeBlockSize = 64 * KB;
+
 intptr_t GCSweeper::SweepNewPage(Page* page) {
   ASSERT(!page->is_image());
   ASSERT(!page->is_old());
@@ -57,7 +68,9 @@ intptr_t GCSweeper::SweepNewPage(Page* page) {
   return free;
 }
 
-bool GCSweeper::SweepPage(Page* page, FreeList* freelist) {
+bool GCSweeper::SweepPage(Page* page,
+                          FreeList* freelist,
+                          PageSpace* old_space) {
   ASSERT(!page->is_image());
   // Large executable pages are handled here. We never truncate Instructions
   // objects, so we never truncate executable pages.
@@ -72,6 +85,7 @@ bool GCSweeper::SweepPage(Page* page, FreeList* freelist) {
   uword end = page->object_end();
   uword current = start;
   const bool dontneed_on_sweep = FLAG_dontneed_on_sweep;
+  const bool release_free_blocks = FLAG_old_gen_release_rate > 0;
   const uword page_size = VirtualMemory::PageSize();
 
   while (current < end) {
@@ -120,11 +134,25 @@ bool GCSweeper::SweepPage(Page* page, FreeList* freelist) {
         if (UNLIKELY(page_aligned_start < page_aligned_end)) {
           VirtualMemory::DontNeed(reinterpret_cast<void*>(page_aligned_start),
                                   page_aligned_end - page_aligned_start);
+          old_space->AddReleased(page_aligned_end - page_aligned_start);
         }
       } else {
 #if defined(DEBUG)
         memset(reinterpret_cast<void*>(current), Heap::kZapByte, obj_size);
 #endif  // DEBUG
+        if (UNLIKELY(release_free_blocks)) {
+          uword page_aligned_start = Utils::RoundUp(
+              current + FreeListElement::kLargeHeaderSize, page_size);
+          uword page_aligned_end = Utils::RoundDown(free_end, page_size);
+          if ((page_aligned_start + kMinReleasedFreeBlockSize <=
+               page_aligned_end) &&
+              old_space->TryConsumeReleaseBudget(page_aligned_end -
+                                                 page_aligned_start)) {
+            VirtualMemory::DontNeed(
+                reinterpret_cast<void*>(page_aligned_start),
+                page_aligned_end - page_aligned_start);
+          }
+        }
       }
       freelist->FreeLocked(current, obj_size);
     }
@@ -164,17 +192,26 @@ intptr_t GCSweeper::SweepLargePage(Page* page) {
   return words_to_end;
 }
 
+// Shared by the tasks of one concurrent sweep. Owned by the last task to
+// finish; guarded by the old space's tasks_lock.
+struct ConcurrentSweepState {
+  explicit ConcurrentSweepState(intptr_t num_tasks)
+      : large_remaining(num_tasks), remaining(num_tasks) {}
+
+  intptr_t large_remaining;
+  intptr_t remaining;
+};
+
 class ConcurrentSweeperTask : public ThreadPool::Task {
  public:
-  explicit ConcurrentSweeperTask(IsolateGroup* isolate_group)
-      : isolate_group_(isolate_group) {
+  ConcurrentSweeperTask(IsolateGroup* isolate_group,
+                        ConcurrentSweepState* state)
+      : isolate_group_(isolate_group), state_(state) {
     ASSERT(isolate_group != nullptr);
-    PageSpace* old_space = isolate_group->heap()->old_space();
-    MonitorLocker ml(old_space->tasks_lock());
-    old_space->set_tasks(old_space->tasks() + 1);
-    old_space->set_phase(PageSpace::kSweepingLarge);
   }
 
+  virtual Priority priority() const { return kSweeperPriority; }
+
   virtual void Run() {
     bool result = Thread::EnterIsolateGroupAsNonMutator(isolate_group_,
                                                         Thread::kSweeperTask);
@@ -190,8 +227,13 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
       {
         MonitorLocker ml(old_space->tasks_lock());
         ASSERT(old_space->phase() == PageSpace::kSweepingLarge);
-        old_space->set_phase(PageSpace::kSweepingRegular);
-        ml.NotifyAll();
+        // Large pages are only done once every task has finished the ones it
+        // took. Nobody waits here: tasks that finish early move on to the
+        // regular pages.
+        if (--state_->large_remaining == 0) {
+          old_space->set_phase(PageSpace::kSweepingRegular);
+          ml.NotifyAll();
+        }
       }
 
       old_space->Sweep(/*exclusive*/ false);
@@ -199,22 +241,41 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
     // Exit isolate cleanly *before* notifying it, to avoid shutdown race.
     Thread::ExitIsolateGroupAsNonMutator();
     // This sweeper task is done. Notify the original isolate.
+    bool last;
     {
       MonitorLocker ml(old_space->tasks_lock());
       old_space->set_tasks(old_space->tasks() - 1);
-      ASSERT(old_space->phase() == PageSpace::kSweepingRegular);
-      old_space->set_phase(PageSpace::kDone);
+      last = --state_->remaining == 0;
+      if (last) {
+        ASSERT(old_space->phase() == PageSpace::kSweepingRegular);
+        old_space->set_phase(PageSpace::kDone);
+      }
       ml.NotifyAll();
     }
+    if (last) {
+      delete state_;
+    }
   }
 
  private:
   IsolateGroup* isolate_group_;
+  ConcurrentSweepState* state_;
 };
 
 void GCSweeper::SweepConcurrent(IsolateGroup* isolate_group) {
-  bool result = Dart::thread_pool()->Run<ConcurrentSweeperTask>(isolate_group);
-  ASSERT(result);
+  const intptr_t num_tasks = Utils::Maximum<intptr_t>(1, FLAG_sweeper_tasks);
+  PageSpace* old_space = isolate_group->heap()->old_space();
+  ConcurrentSweepState* state = new ConcurrentSweepState(num_tasks);
+  {
+    MonitorLocker ml(old_space->tasks_lock());
+    old_space->set_tasks(old_space->tasks() + num_tasks);
+    old_space->set_phase(PageSpace::kSweepingLarge);
+  }
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    bool result =
+        Dart::thread_pool()->Run<ConcurrentSweeperTask>(isolate_group, state);
+    ASSERT(result);
+  }
 }
 
 }  // namespace dart
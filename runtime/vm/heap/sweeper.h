@@ -27,8 +27,9 @@ class GCSweeper {
   // all the unmarked objects to the freelist. Whether the freelist is
   // pre-locked is indicated by the locked parameter.
   // Returns true if the page is in use. Freelist is untouched if page is not
-  // in use.
-  bool SweepPage(Page* page, FreeList* freelist);
+  // in use. Large free blocks may be returned to the OS within the budget of
+  // old_space.
+  bool SweepPage(Page* page, FreeList* freelist, PageSpace* old_space);
 
   // Returns the number of words from page->object_start() to the end of the
   // last marked object.
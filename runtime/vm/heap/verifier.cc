@@ -26,7 +26,8 @@ void VerifyObjectVisitor::VisitObject(ObjectPtr obj) {
   } else {
     switch (mark_expectation_) {
       case kForbidMarked:
-        if (obj->IsOldObject() && obj->untag()->IsMarked()) {
+        if (obj->IsOldObject() && obj->untag()->IsMarked() &&
+            !Page::Of(obj)->is_permanent()) {
           FATAL("Marked object encountered %#" Px "\n", addr);
         }
         break;
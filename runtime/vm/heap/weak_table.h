@@ -8,6 +8,7 @@
 #include "vm/globals.h"
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/lockers.h"
 #include "vm/raw_object.h"
 
@@ -200,7 +201,8 @@ class WeakTable {
     // Setting a value of 0 is equivalent to invalidating the entry.
     if (val == 0) {
       data_[ObjectIndex(i)] = kDeletedEntry;
-      set_count(count() - 1);
+      // The marker invalidates disjoint ranges of one table in parallel.
+      count_.fetch_sub(1);
     }
     data_[ValueIndex(i)] = val;
   }
@@ -220,7 +222,7 @@ class WeakTable {
   // number valid entries, and will determine the size_ after rehashing.
   intptr_t size_;
   intptr_t used_;
-  intptr_t count_;
+  RelaxedAtomic<intptr_t> count_;
 
   DISALLOW_COPY_AND_ASSIGN(WeakTable);
 };
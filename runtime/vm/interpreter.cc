@@ -711,12 +711,47 @@ DART_FORCE_INLINE bool Interpreter::Invoke(Thread* thread,
     // Reload objects after the call which may trigger GC.
     function = Function::RawCast(call_top[2]);
 
-    ASSERT(Function::HasCode(function));
+    ASSERT(Function::HasCode(function) || Function::HasBytecode(function));
   }
 }
 
+void Interpreter::UpdateCallSiteCache(const ObjectPool& pool,
+                                      intptr_t index,
+                                      const String& target_name,
+                                      intptr_t receiver_cid,
+                                      const Function& target) {
+  ASSERT(target_name.IsOld() && target.IsOld());
+  const Object& selector = Object::Handle(pool.ObjectAt(index));
+  intptr_t length = 1;
+  if (selector.IsArray()) {
+    const Array& cache = Array::Cast(selector);
+    length = cache.Length();
+    // Another isolate of the group may have added the class already.
+    for (intptr_t i = 1; i < length; i += 2) {
+      if (Smi::Value(Smi::RawCast(cache.At(i))) == receiver_cid) {
+        return;
+      }
+    }
+    if (length >= 1 + 2 * kCallSiteCacheMaxEntries) {
+      return;
+    }
+  }
+  // Readers do not synchronize with the miss handler, so the cache is never
+  // modified in place.
+  const Array& new_cache = Array::Handle(Array::New(length + 2, Heap::kOld));
+  new_cache.SetAt(0, target_name);
+  if (selector.IsArray()) {
+    for (intptr_t i = 1; i < length; i++) {
+      new_cache.SetAt(i, Object::Handle(Array::Cast(selector).At(i)));
+    }
+  }
+  new_cache.SetAt(length, Smi::Handle(Smi::New(receiver_cid)));
+  new_cache.SetAt(length + 1, target);
+  pool.SetObjectAt<std::memory_order_release>(index, new_cache);
+}
+
 DART_FORCE_INLINE bool Interpreter::InstanceCall(Thread* thread,
-                                                 StringPtr target_name,
+                                                 intptr_t selector_index,
                                                  ObjectPtr* call_base,
                                                  ObjectPtr* top,
                                                  const KBCInstr** pc,
@@ -729,31 +764,66 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall(Thread* thread,
 
   intptr_t receiver_cid = call_base[receiver_idx]->GetClassId();
 
-  FunctionPtr target;
-  if (UNLIKELY(!lookup_cache_.Lookup(receiver_cid, target_name, argdesc_,
-                                     &target))) {
-    // Table lookup miss.
+  // The selector is the interface target, the dynamic call name or, once
+  // the call site has been executed, its call site cache.
+  ObjectPtr selector = pp_->untag()->data()[selector_index].raw_obj_;
+  StringPtr target_name;
+  bool site_is_full = false;
+  FunctionPtr target = Function::null();
+  if (selector->GetClassId() == kArrayCid) {
+    ArrayPtr cache = Array::RawCast(selector);
+    target_name = String::RawCast(cache->untag()->element(0));
+    const intptr_t length = Smi::Value(cache->untag()->length());
+    const SmiPtr cid = Smi::New(receiver_cid);
+    for (intptr_t i = 1; i < length; i += 2) {
+      if (cache->untag()->element(i) == cid) {
+        target = Function::RawCast(cache->untag()->element(i + 1));
+        break;
+      }
+    }
+    site_is_full = length >= 1 + 2 * kCallSiteCacheMaxEntries;
+  } else if (selector->GetClassId() == kFunctionCid) {
+    target_name = Function::RawCast(selector)->untag()->name();
+  } else {
+    target_name = String::RawCast(selector);
+  }
+
+  if (LIKELY(target != Function::null())) {
+    top[0] = target;
+    return Invoke(thread, call_base, top, pc, FP, SP);
+  }
+
+  // Receiver classes of megamorphic call sites are looked up in the
+  // LookupCache, other call sites add the receiver class to their cache.
+  if (!site_is_full ||
+      !lookup_cache_.Lookup(receiver_cid, target_name, argdesc_, &target)) {
     top[0] = null_value;  // Clean up slot as it may be visited by GC.
     top[1] = call_base[receiver_idx];
     top[2] = target_name;
     top[3] = argdesc_;
-    top[4] = null_value;  // Result slot.
+    top[4] = site_is_full ? null_value : pp_;
+    top[5] = Smi::New(selector_index);
+    top[6] = null_value;  // Result slot.
 
-    Exit(thread, *FP, top + 5, *pc);
-    NativeArguments native_args(thread, 3, /* argv */ top + 1,
-                                /* result */ top + 4);
+    Exit(thread, *FP, top + 7, *pc);
+    NativeArguments native_args(thread, 5, /* argv */ top + 1,
+                                /* result */ top + 6);
     if (!InvokeRuntime(thread, this, DRT_InterpretedInstanceCallMissHandler,
                        native_args)) {
       return false;
     }
 
-    target = static_cast<FunctionPtr>(top[4]);
+    target = static_cast<FunctionPtr>(top[6]);
     target_name = static_cast<StringPtr>(top[2]);
     argdesc_ = static_cast<ArrayPtr>(top[3]);
+    top[4] = null_value;
+
+    if (site_is_full && (target != Function::null())) {
+      lookup_cache_.Insert(receiver_cid, target_name, argdesc_, target);
+    }
   }
 
   if (target != Function::null()) {
-    lookup_cache_.Insert(receiver_cid, target_name, argdesc_, target);
     top[0] = target;
     return Invoke(thread, call_base, top, pc, FP, SP);
   }
@@ -851,6 +921,37 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall(Thread* thread,
 // Load target of a jump instruction into PC.
 #define LOAD_JUMP_TARGET() pc = rT
 
+// Pushes the boolean result of a comparison. Most comparisons are the
+// condition of a JumpIfTrue or JumpIfFalse, so when one of them follows
+// it is executed right away as part of the comparison, without storing
+// the boolean and without dispatching through the jump table.
+#define BRANCH_OR_PUSH_CONDITION(condition)                                    \
+  do {                                                                         \
+    const bool condition_value = (condition);                                  \
+    bool jump_if;                                                              \
+    switch (*pc) {                                                             \
+      case KernelBytecode::kJumpIfTrue:                                        \
+      case KernelBytecode::kJumpIfTrue_Wide:                                   \
+        jump_if = true;                                                        \
+        break;                                                                 \
+      case KernelBytecode::kJumpIfFalse:                                       \
+      case KernelBytecode::kJumpIfFalse_Wide:                                  \
+        jump_if = false;                                                       \
+        break;                                                                 \
+      default:                                                                 \
+        SP[0] = condition_value ? true_value : false_value;                    \
+        DISPATCH();                                                            \
+    }                                                                          \
+    TRACE_INSTRUCTION                                                          \
+    SP -= 1;                                                                   \
+    if (condition_value == jump_if) {                                          \
+      pc += KernelBytecode::DecodeT(pc);                                       \
+    } else {                                                                   \
+      pc = KernelBytecode::Next(pc);                                           \
+    }                                                                          \
+    DISPATCH();                                                                \
+  } while (0)
+
 #define BYTECODE_ENTRY_LABEL(Name) bc##Name:
 #define BYTECODE_WIDE_ENTRY_LABEL(Name) bc##Name##_Wide:
 #define BYTECODE_IMPL_LABEL(Name) bc##Name##Impl:
@@ -1996,8 +2097,7 @@ SwitchDispatch:
 
   {
     BYTECODE(BooleanNegateTOS, 0);
-    SP[0] = (SP[0] == true_value) ? false_value : true_value;
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(SP[0] != true_value);
   }
 
   {
@@ -2053,11 +2153,8 @@ SwitchDispatch:
       ObjectPtr* call_top = SP + 1;
 
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
-      StringPtr target_name =
-          static_cast<FunctionPtr>(LOAD_CONSTANT(kidx))->untag()->name();
       argdesc_ = static_cast<ArrayPtr>(LOAD_CONSTANT(kidx + 1));
-      if (!InstanceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                        &SP)) {
+      if (!InstanceCall(thread, kidx, call_base, call_top, &pc, &FP, &SP)) {
         HANDLE_EXCEPTION;
       }
     }
@@ -2075,11 +2172,8 @@ SwitchDispatch:
       ObjectPtr* call_top = SP + 1;
 
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
-      StringPtr target_name =
-          static_cast<FunctionPtr>(LOAD_CONSTANT(kidx))->untag()->name();
       argdesc_ = static_cast<ArrayPtr>(LOAD_CONSTANT(kidx + 1));
-      if (!InstanceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                        &SP)) {
+      if (!InstanceCall(thread, kidx, call_base, call_top, &pc, &FP, &SP)) {
         HANDLE_EXCEPTION;
       }
     }
@@ -2125,11 +2219,8 @@ SwitchDispatch:
       ObjectPtr* call_top = SP + 1;
 
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
-      StringPtr target_name =
-          static_cast<FunctionPtr>(LOAD_CONSTANT(kidx))->untag()->name();
       argdesc_ = static_cast<ArrayPtr>(LOAD_CONSTANT(kidx + 1));
-      if (!InstanceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                        &SP)) {
+      if (!InstanceCall(thread, kidx, call_base, call_top, &pc, &FP, &SP)) {
         HANDLE_EXCEPTION;
       }
     }
@@ -2148,10 +2239,8 @@ SwitchDispatch:
       ObjectPtr* call_top = SP + 1;
 
       InterpreterHelpers::IncrementUsageCounter(FrameFunction(FP));
-      StringPtr target_name = String::RawCast(LOAD_CONSTANT(kidx));
       argdesc_ = Array::RawCast(LOAD_CONSTANT(kidx + 1));
-      if (!InstanceCall(thread, target_name, call_base, call_top, &pc, &FP,
-                        &SP)) {
+      if (!InstanceCall(thread, kidx, call_base, call_top, &pc, &FP, &SP)) {
         HANDLE_EXCEPTION;
       }
     }
@@ -2761,8 +2850,7 @@ SwitchDispatch:
   {
     BYTECODE(EqualsNull, 0);
 
-    SP[0] = (SP[0] == null_value) ? true_value : false_value;
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(SP[0] == null_value);
   }
 
   {
@@ -2932,17 +3020,18 @@ SwitchDispatch:
     BYTECODE(CompareIntEq, 0);
 
     SP -= 1;
+    bool result;
     if (SP[0] == SP[1]) {
-      SP[0] = true_value;
+      result = true;
     } else if (!SP[0]->IsHeapObject() || !SP[1]->IsHeapObject() ||
                (SP[0] == null_value) || (SP[1] == null_value)) {
-      SP[0] = false_value;
+      result = false;
     } else {
       int64_t a = Integer::Value(Integer::RawCast(SP[0]));
       int64_t b = Integer::Value(Integer::RawCast(SP[1]));
-      SP[0] = (a == b) ? true_value : false_value;
+      result = (a == b);
     }
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(result);
   }
 
   {
@@ -2951,8 +3040,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::RAngleBracket());
     UNBOX_INT64(b, SP[1], Symbols::RAngleBracket());
-    SP[0] = (a > b) ? true_value : false_value;
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(a > b);
   }
 
   {
@@ -2961,8 +3049,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::LAngleBracket());
     UNBOX_INT64(b, SP[1], Symbols::LAngleBracket());
-    SP[0] = (a < b) ? true_value : false_value;
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(a < b);
   }
 
   {
@@ -2971,8 +3058,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::GreaterEqualOperator());
     UNBOX_INT64(b, SP[1], Symbols::GreaterEqualOperator());
-    SP[0] = (a >= b) ? true_value : false_value;
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(a >= b);
   }
 
   {
@@ -2981,8 +3067,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::LessEqualOperator());
     UNBOX_INT64(b, SP[1], Symbols::LessEqualOperator());
-    SP[0] = (a <= b) ? true_value : false_value;
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(a <= b);
   }
 
   {
@@ -3042,14 +3127,15 @@ SwitchDispatch:
     BYTECODE(CompareDoubleEq, 0);
 
     SP -= 1;
+    bool result;
     if ((SP[0] == null_value) || (SP[1] == null_value)) {
-      SP[0] = (SP[0] == SP[1]) ? true_value : false_value;
+      result = (SP[0] == SP[1]);
     } else {
       double a = Double::RawCast(SP[0])->untag()->value_;
       double b = Double::RawCast(SP[1])->untag()->value_;
-      SP[0] = (a == b) ? true_value : false_value;
+      result = (a == b);
     }
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(result);
   }
 
   {
@@ -3058,8 +3144,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_DOUBLE(a, SP[0], Symbols::RAngleBracket());
     UNBOX_DOUBLE(b, SP[1], Symbols::RAngleBracket());
-    SP[0] = (a > b) ? true_value : false_value;
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(a > b);
   }
 
   {
@@ -3068,8 +3153,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_DOUBLE(a, SP[0], Symbols::LAngleBracket());
     UNBOX_DOUBLE(b, SP[1], Symbols::LAngleBracket());
-    SP[0] = (a < b) ? true_value : false_value;
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(a < b);
   }
 
   {
@@ -3078,8 +3162,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_DOUBLE(a, SP[0], Symbols::GreaterEqualOperator());
     UNBOX_DOUBLE(b, SP[1], Symbols::GreaterEqualOperator());
-    SP[0] = (a >= b) ? true_value : false_value;
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(a >= b);
   }
 
   {
@@ -3088,8 +3171,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_DOUBLE(a, SP[0], Symbols::LessEqualOperator());
     UNBOX_DOUBLE(b, SP[1], Symbols::LessEqualOperator());
-    SP[0] = (a <= b) ? true_value : false_value;
-    DISPATCH();
+    BRANCH_OR_PUSH_CONDITION(a <= b);
   }
 
   {
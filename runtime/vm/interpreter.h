@@ -119,6 +119,20 @@ class Interpreter {
   void VisitObjectPointers(ObjectPointerVisitor* visitor);
   void ClearLookupCache() { lookup_cache_.Clear(); }
 
+  // The constant pool entry holding the selector of an instance call is
+  // replaced by a call site cache: an Array holding the target name followed
+  // by pairs of receiver class id and target function. Call sites with more
+  // receiver classes than this use the LookupCache.
+  static constexpr intptr_t kCallSiteCacheMaxEntries = 4;
+
+  // Adds |target| for receivers with |receiver_cid| to the call site cache
+  // in |pool| at |index|. Called by the instance call miss handler.
+  static void UpdateCallSiteCache(const ObjectPool& pool,
+                                  intptr_t index,
+                                  const String& target_name,
+                                  intptr_t receiver_cid,
+                                  const Function& target);
+
 #ifndef PRODUCT
   void set_is_debugging(bool value) { is_debugging_ = value; }
   bool is_debugging() const { return is_debugging_; }
@@ -179,7 +193,7 @@ class Interpreter {
                       ObjectPtr** SP);
 
   bool InstanceCall(Thread* thread,
-                    StringPtr target_name,
+                    intptr_t selector_index,
                     ObjectPtr* call_base,
                     ObjectPtr* call_top,
                     const KBCInstr** pc,
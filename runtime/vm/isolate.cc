@@ -12,6 +12,7 @@
 #include "platform/atomic.h"
 #include "platform/growable_array.h"
 #include "platform/text_buffer.h"
+#include "vm/app_snapshot.h"
 #include "vm/canonical_tables.h"
 #include "vm/class_finalizer.h"
 #include "vm/code_observers.h"
@@ -54,9 +55,11 @@
 #include "vm/thread_interrupter.h"
 #include "vm/thread_registry.h"
 #include "vm/timeline.h"
+#include "vm/type_testing_stubs.h"
 #include "vm/visitor.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/stub_code_compiler.h"
 #endif
@@ -77,6 +80,10 @@ DECLARE_FLAG(bool, reload_every_back_off);
 DECLARE_FLAG(bool, trace_reload);
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+DECLARE_FLAG(charp, write_aot_profile_to);
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
 static void DeterministicModeHandler(bool value) {
   if (value) {
     FLAG_background_compilation = false;  // Timing dependent.
@@ -368,6 +375,8 @@ IsolateGroup::IsolateGroup(std::shared_ptr<IsolateGroupSource> source,
       kernel_data_lib_cache_mutex_(),
       kernel_data_class_cache_mutex_(),
       kernel_constants_mutex_(),
+      ffi_async_callback_batches_mutex_(),
+      ffi_async_callback_batches_(),
       field_list_mutex_(),
       boxed_field_list_(GrowableObjectArray::null()),
       program_lock_(new SafepointRwLock(SafepointLevel::kGCAndDeopt)),
@@ -439,6 +448,10 @@ IsolateGroup::~IsolateGroup() {
     delete[] obfuscation_map_;
   }
 
+  for (intptr_t i = 0; i < retained_snapshot_data_.length(); i++) {
+    free(retained_snapshot_data_[i]);
+  }
+
   class_table_allocator_.Free(class_table_);
   if (heap_walk_class_table_ != class_table_) {
     class_table_allocator_.Free(heap_walk_class_table_);
@@ -450,6 +463,20 @@ IsolateGroup::~IsolateGroup() {
 #endif
 }
 
+void IsolateGroup::set_snapshot_statistics(SnapshotStatistics* statistics) {
+  snapshot_statistics_.reset(statistics);
+}
+
+#if !defined(PRODUCT)
+SubtypeTestCacheStats* IsolateGroup::subtype_test_cache_stats() {
+  ASSERT(subtype_test_cache_mutex_.IsOwnedByCurrentThread());
+  if (subtype_test_cache_stats_ == nullptr) {
+    subtype_test_cache_stats_.reset(new SubtypeTestCacheStats());
+  }
+  return subtype_test_cache_stats_.get();
+}
+#endif  // !defined(PRODUCT)
+
 void IsolateGroup::RegisterIsolate(Isolate* isolate) {
   SafepointWriteRwLocker ml(Thread::Current(), isolates_lock_.get());
   ASSERT(isolates_lock_->IsCurrentThreadWriter());
@@ -927,6 +954,39 @@ void IsolateGroup::ExitTemporaryIsolate() {
   Dart::ShutdownIsolate(thread);
 }
 
+bool IsolateGroup::AddToFfiAsyncCallbackBatch(Dart_Port port,
+                                              const Array& args) {
+  Zone* zone = Thread::Current()->zone();
+  SafepointMutexLocker ml(&ffi_async_callback_batches_mutex_);
+  auto& batch = GrowableObjectArray::Handle(zone);
+  PersistentHandle* handle = ffi_async_callback_batches_.LookupValue(port);
+  if (handle != nullptr) {
+    batch ^= handle->ptr();
+    batch.Add(args);
+    return false;
+  }
+  batch = GrowableObjectArray::New();
+  batch.Add(args);
+  handle = api_state()->AllocatePersistentHandle();
+  handle->set_ptr(batch);
+  ffi_async_callback_batches_.Insert({port, handle});
+  return true;
+}
+
+GrowableObjectArrayPtr IsolateGroup::TakeFfiAsyncCallbackBatch(
+    Dart_Port port) {
+  SafepointMutexLocker ml(&ffi_async_callback_batches_mutex_);
+  PersistentHandle* handle = ffi_async_callback_batches_.LookupValue(port);
+  if (handle == nullptr) {
+    return GrowableObjectArray::null();
+  }
+  const GrowableObjectArrayPtr batch =
+      GrowableObjectArray::RawCast(handle->ptr());
+  ffi_async_callback_batches_.Remove(port);
+  api_state()->FreePersistentHandle(handle);
+  return batch;
+}
+
 void IsolateGroup::RehashConstants(Become* become) {
   // Even though no individual constant contains a cycle, there can be "cycles"
   // between the canonical tables if some const instances of A have fields that
@@ -2547,6 +2607,9 @@ void Isolate::LowLevelShutdown() {
   if (FLAG_dump_megamorphic_stats) {
     MegamorphicCacheTable::PrintSizes(thread);
   }
+  if (FLAG_dump_subtype_test_cache_stats) {
+    SubtypeTestCacheStats::Print(group());
+  }
   if (FLAG_dump_symbol_stats) {
     Symbols::DumpStats(group());
   }
@@ -2628,6 +2691,13 @@ void Isolate::Shutdown() {
   }
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  if ((FLAG_write_aot_profile_to != nullptr) && is_runnable() &&
+      !Isolate::IsSystemIsolate(this)) {
+    AotProfile::Write(thread, FLAG_write_aot_profile_to);
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
   // Then, proceed with low-level teardown.
   Isolate::UnMarkIsolateReady(this);
 
@@ -2862,7 +2932,7 @@ bool Isolate::SetOwnerThread(ThreadId expected_old_owner, ThreadId new_owner) {
   return owner_thread_.compare_exchange_strong(expected_old_owner, new_owner);
 }
 
-ThreadId Isolate::GetOwnerThread(PortMap::Locker* locker) {
+ThreadId Isolate::GetOwnerThread(PortMap::ShardLocker* locker) {
   ASSERT(Isolate::Current() == this || locker != nullptr);
   return owner_thread_.load();
 }
@@ -24,6 +24,7 @@
 #include "vm/field_table.h"
 #include "vm/fixed_cache.h"
 #include "vm/handles.h"
+#include "vm/hash_map.h"
 #include "vm/heap/verifier.h"
 #include "vm/intrusive_dlist.h"
 #include "vm/megamorphic_cache_table.h"
@@ -78,12 +79,14 @@ class SampleBlockBuffer;
 class SampleBuffer;
 class SendPort;
 class SerializedObjectBuffer;
+class SnapshotStatistics;
 class ServiceIdZone;
 class Simulator;
 class StackResource;
 class StackZone;
 class StoreBuffer;
 class StubCode;
+class SubtypeTestCacheStats;
 class ThreadRegistry;
 class UserTag;
 class WeakTable;
@@ -126,7 +129,7 @@ class LambdaCallable : public Callable {
 };
 
 // Fixed cache for exception handler lookup.
-typedef FixedCache<intptr_t, ExceptionHandlerInfo, 16> HandlerInfoCache;
+typedef FixedCache<intptr_t, CachedExceptionHandler, 32> HandlerInfoCache;
 // Fixed cache for catch entry state lookup.
 typedef FixedCache<intptr_t, CatchEntryMovesRefPtr, 16> CatchEntryMovesCache;
 
@@ -407,6 +410,17 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   void set_obfuscation_map(const char** map) { obfuscation_map_ = map; }
   const char** obfuscation_map() const { return obfuscation_map_; }
 
+  // Recorded while reading the program snapshot if
+  // --record_snapshot_statistics is set, otherwise null.
+  SnapshotStatistics* snapshot_statistics() const {
+    return snapshot_statistics_.get();
+  }
+  void set_snapshot_statistics(SnapshotStatistics* statistics);
+
+  // Takes ownership of malloc'ed snapshot data which deserialized objects
+  // point into, freeing it with the isolate group.
+  void RetainSnapshotData(uint8_t* data) { retained_snapshot_data_.Add(data); }
+
   Random* random() { return &random_; }
 
   bool is_system_isolate_group() const { return is_system_isolate_group_; }
@@ -513,7 +527,14 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
     return &type_arguments_canonicalization_mutex_;
   }
   Mutex* subtype_test_cache_mutex() { return &subtype_test_cache_mutex_; }
+#if !defined(PRODUCT)
+  // Must be accessed with [subtype_test_cache_mutex] held.
+  SubtypeTestCacheStats* subtype_test_cache_stats();
+  // Guards the code kept for the profiler, see CodeLookupTable.
+  Mutex* profiler_code_table_mutex() { return &profiler_code_table_mutex_; }
+#endif  // !defined(PRODUCT)
   Mutex* megamorphic_table_mutex() { return &megamorphic_table_mutex_; }
+  Mutex* regexp_compile_mutex() { return &regexp_compile_mutex_; }
   Mutex* type_feedback_mutex() { return &type_feedback_mutex_; }
   Mutex* patchable_call_mutex() { return &patchable_call_mutex_; }
   Mutex* constant_canonicalization_mutex() {
@@ -776,6 +797,14 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   Isolate* EnterTemporaryIsolate();
   static void ExitTemporaryIsolate();
 
+  // Appends the arguments of an async FFI callback invocation to the batch
+  // pending for [port]. Returns true if this started a new batch, in which
+  // case the caller has to notify [port] to drain it.
+  bool AddToFfiAsyncCallbackBatch(Dart_Port port, const Array& args);
+  // Removes and returns the batch pending for [port], or null if there is
+  // none.
+  GrowableObjectArrayPtr TakeFfiAsyncCallbackBatch(Dart_Port port);
+
   void SetNativeAssetsCallbacks(NativeAssetsApi* native_assets_api) {
     native_assets_api_ = *native_assets_api;
   }
@@ -826,6 +855,8 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   ClassTable* heap_walk_class_table_;
 
   const char** obfuscation_map_ = nullptr;
+  std::unique_ptr<SnapshotStatistics> snapshot_statistics_;
+  MallocGrowableArray<uint8_t*> retained_snapshot_data_;
 
   bool is_vm_isolate_ = false;
   void* embedder_data_ = nullptr;
@@ -895,7 +926,11 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   Mutex type_canonicalization_mutex_;
   Mutex type_arguments_canonicalization_mutex_;
   Mutex subtype_test_cache_mutex_;
+  NOT_IN_PRODUCT(std::unique_ptr<SubtypeTestCacheStats>
+                     subtype_test_cache_stats_);
+  NOT_IN_PRODUCT(Mutex profiler_code_table_mutex_);
   Mutex megamorphic_table_mutex_;
+  Mutex regexp_compile_mutex_;
   Mutex type_feedback_mutex_;
   Mutex patchable_call_mutex_;
   Mutex constant_canonicalization_mutex_;
@@ -911,6 +946,25 @@ class IsolateGroup : public IntrusiveDListEntry<IsolateGroup> {
   Mutex initializer_functions_mutex_;
 #endif  // !defined(DART_PRECOMPILED_RUNTIME) || defined(DART_DYNAMIC_MODULES)
 
+  class FfiAsyncCallbackBatchTrait {
+   public:
+    typedef Dart_Port Key;
+    typedef PersistentHandle* Value;
+    typedef std::pair<Dart_Port, PersistentHandle*> Pair;
+
+    static Key KeyOf(Pair kv) { return kv.first; }
+    static Value ValueOf(Pair kv) { return kv.second; }
+    static uword Hash(Key key) { return static_cast<uword>(key); }
+    static bool IsKeyEqual(Pair kv, Key key) { return kv.first == key; }
+  };
+
+  // Protects access to ffi_async_callback_batches_.
+  Mutex ffi_async_callback_batches_mutex_;
+  // Persistent handles of the GrowableObjectArrays of argument arrays of the
+  // async FFI callback invocations not yet delivered, by target port.
+  MallocDirectChainedHashMap<FfiAsyncCallbackBatchTrait>
+      ffi_async_callback_batches_;
+
   // Protect access to boxed_field_list_.
   Mutex field_list_mutex_;
   // List of fields that became boxed and that trigger deoptimization.
@@ -1482,9 +1536,10 @@ class Isolate : public IntrusiveDListEntry<Isolate> {
 
   bool SetOwnerThread(ThreadId expected_old_owner, ThreadId new_owner);
 
-  // Must be invoked with a valid PortMap::Locker, or while this isolate is the
-  // current isolate (in which case the locker may be null).
-  ThreadId GetOwnerThread(PortMap::Locker* locker);
+  // Must be invoked with a valid PortMap::ShardLocker for one of the ports of
+  // this isolate, or while this isolate is the current isolate (in which case
+  // the locker may be null).
+  ThreadId GetOwnerThread(PortMap::ShardLocker* locker);
 
  private:
   friend class Dart;                  // Init, InitOnce, Shutdown.
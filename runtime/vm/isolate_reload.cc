@@ -1999,6 +1999,12 @@ void ProgramReloadContext::ResetMegamorphicCaches() {
   // better to clear the table instead of clearing each of the caches, allow
   // the current megamorphic caches get GC'd and any new optimized code allocate
   // new ones.
+
+  // The functions found for reflective invocations may change as well.
+  IG->ForEachIsolate([&](Isolate* isolate) {
+    isolate->isolate_object_store()->set_reflective_lookup_cache(
+        Array::Handle());
+  });
 }
 
 class InvalidationCollector : public ObjectVisitor {
@@ -2129,6 +2135,20 @@ void ProgramReloadContext::InvalidateFunctions(
   Code& code = Code::Handle(zone);
   Field& field = Field::Handle(zone);
   SafepointWriteRwLocker ml(thread, thread->isolate_group()->program_lock());
+
+  // Classes of libraries which were not reloaded keep their members, so
+  // instance calls that only saw such receivers still have valid targets.
+  ClassTable* class_table = IG->class_table();
+  BitVector* clean_cids = new (zone) BitVector(zone, class_table->NumCids());
+  for (intptr_t cid = kInstanceCid; cid < class_table->NumCids(); cid++) {
+    if (!class_table->HasValidClassAt(cid)) continue;
+    owning_class = class_table->At(cid);
+    owning_lib = owning_class.library();
+    if (!owning_lib.IsNull() && !IsDirty(owning_lib)) {
+      clean_cids->Add(cid);
+    }
+  }
+
   for (intptr_t i = 0; i < functions.length(); i++) {
     const Function& func = *functions[i];
 
@@ -2173,9 +2193,10 @@ void ProgramReloadContext::InvalidateFunctions(
       func.SetWasCompiled(false);
     } else {
       // We are preserving the unoptimized code, reset instance calls and type
-      // test caches.
+      // test caches. Inline caches which only saw receivers of clean classes
+      // are kept, so code of unchanged libraries does not warm up again.
       resetter.ResetSwitchableCalls(code);
-      resetter.ResetCaches(code);
+      resetter.ResetCaches(code, clean_cids);
     }
 
     // Clear counters.
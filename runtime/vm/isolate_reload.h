@@ -410,12 +410,18 @@ class CallSiteResetter : public ValueObject {
   explicit CallSiteResetter(Zone* zone);
 
   void ZeroEdgeCounters(const Function& function);
-  void ResetCaches(const Code& code);
-  void ResetCaches(const ObjectPool& pool);
-  void Reset(const ICData& ic);
+  // Instance call ICData which only checked classes in |retained_cids| keep
+  // their entries, as their targets did not change.
+  void ResetCaches(const Code& code, const BitVector* retained_cids = nullptr);
+  void ResetCaches(const ObjectPool& pool,
+                   const BitVector* retained_cids = nullptr);
+  void Reset(const ICData& ic, const BitVector* retained_cids = nullptr);
   void ResetSwitchableCalls(const Code& code);
 
  private:
+  // Whether every class checked by |ic| is in |cids|.
+  static bool ChecksOnlyClassesIn(const ICData& ic, const BitVector& cids);
+
   Zone* zone_;
   Instructions& instrs_;
   ObjectPool& pool_;
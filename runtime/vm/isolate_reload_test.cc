@@ -412,6 +412,43 @@ TEST_CASE(IsolateReload_StaticValuePreserved) {
                SimpleInvokeStr(lib, "main"));
 }
 
+TEST_CASE(IsolateReload_InstanceCallInUnchangedLibrary) {
+  // Comparable.compare in dart:core calls compareTo on the elements. Its
+  // inline cache sees both int and A receivers.
+  const char* kScript =
+      "class A implements Comparable<A> {\n"
+      "  final int v;\n"
+      "  A(this.v);\n"
+      "  int compareTo(A other) => v - other.v;\n"
+      "}\n"
+      "main() {\n"
+      "  final ints = [2, 1]..sort();\n"
+      "  final list = [A(2), A(1)]..sort();\n"
+      "  return '${ints.join(',')} ${list.map((a) => a.v).join(',')}';\n"
+      "}\n";
+
+  Dart_Handle lib = TestCase::LoadTestScript(kScript, nullptr);
+  EXPECT_VALID(lib);
+  EXPECT_STREQ("1,2 1,2", SimpleInvokeStr(lib, "main"));
+
+  // The entry for A must not survive the reload, while the one for int can.
+  const char* kReloadScript =
+      "class A implements Comparable<A> {\n"
+      "  final int v;\n"
+      "  A(this.v);\n"
+      "  int compareTo(A other) => other.v - v;\n"
+      "}\n"
+      "main() {\n"
+      "  final ints = [2, 1]..sort();\n"
+      "  final list = [A(1), A(2)]..sort();\n"
+      "  return '${ints.join(',')} ${list.map((a) => a.v).join(',')}';\n"
+      "}\n";
+
+  lib = TestCase::ReloadTestScript(kReloadScript);
+  EXPECT_VALID(lib);
+  EXPECT_STREQ("1,2 2,1", SimpleInvokeStr(lib, "main"));
+}
+
 TEST_CASE(IsolateReload_SavedClosure) {
   // Create a closure in main which only exists in the original source.
   const char* kScript =
@@ -23,10 +23,17 @@ namespace dart {
 
 DECLARE_FLAG(bool, trace_service);
 
+DEFINE_FLAG(int,
+            service_response_chunk_size,
+            1 * MB,
+            "Post VM service responses larger than this many bytes to the "
+            "service isolate in chunks of about this size, 0 to disable.");
+
 JSONStream::JSONStream(intptr_t buf_size)
     : writer_(buf_size),
       id_zone_(nullptr),
       reply_port_(ILLEGAL_PORT),
+      chunk_port_(ILLEGAL_PORT),
       seq_(nullptr),
       parameter_keys_(nullptr),
       parameter_values_(nullptr),
@@ -88,9 +95,19 @@ void JSONStream::Setup(Zone* zone,
     include_private_members_ = ParamIs(kIncludePrivateMembersKey, "true");
   }
   buffer()->Printf("{\"jsonrpc\":\"2.0\", \"result\":");
+  // Requests with a null id get no reply, so there is nothing to stream.
+  if (FLAG_service_response_chunk_size > 0 && reply_port != ILLEGAL_PORT &&
+      !seq.IsNull()) {
+    chunk_port_ = reply_port;
+    writer_.SetChunkCallback(FLAG_service_response_chunk_size, PostChunk,
+                             this);
+  }
 }
 
 void JSONStream::SetupError() {
+  // Errors are reported before a response has grown large enough to be
+  // streamed.
+  ASSERT(!writer_.has_flushed_chunks());
   Clear();
   buffer()->Printf("{\"jsonrpc\":\"2.0\", \"error\":");
 }
@@ -189,6 +206,44 @@ static void Finalizer(void* isolate_callback_data, void* buffer) {
   free(buffer);
 }
 
+// Posts |length| bytes of JSON at |bytes| to |port|, passing ownership of
+// |bytes| to the message. All but the last chunk of a response are marked as
+// incomplete, which tells the service isolate to wait for more.
+static bool PostBytes(Dart_Port port,
+                      char* bytes,
+                      intptr_t length,
+                      bool incomplete) {
+  TransitionVMToNative transition(Thread::Current());
+  Dart_CObject data;
+  data.type = Dart_CObject_kExternalTypedData;
+  data.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+  data.value.as_external_typed_data.length = length;
+  data.value.as_external_typed_data.data = reinterpret_cast<uint8_t*>(bytes);
+  data.value.as_external_typed_data.peer = bytes;
+  data.value.as_external_typed_data.callback = Finalizer;
+  Dart_CObject more;
+  more.type = Dart_CObject_kBool;
+  more.value.as_bool = true;
+  Dart_CObject* elements[2];
+  elements[0] = &data;
+  elements[1] = &more;
+  Dart_CObject message;
+  message.type = Dart_CObject_kArray;
+  message.value.as_array.length = incomplete ? 2 : 1;
+  message.value.as_array.values = elements;
+  bool result = Dart_PostCObject(port, &message);
+  if (!result) {
+    free(bytes);
+  }
+  return result;
+}
+
+void JSONStream::PostChunk(void* data, char* chunk, intptr_t length) {
+  JSONStream* js = reinterpret_cast<JSONStream*>(data);
+  ASSERT(js->chunk_port_ != ILLEGAL_PORT);
+  PostBytes(js->chunk_port_, chunk, length, /*incomplete=*/true);
+}
+
 void JSONStream::PostReply() {
   ASSERT(seq_ != nullptr);
   Dart_Port port = reply_port();
@@ -223,28 +278,7 @@ void JSONStream::PostReply() {
   intptr_t length;
   Steal(&cstr, &length);
 
-  bool result;
-  {
-    TransitionVMToNative transition(Thread::Current());
-    Dart_CObject bytes;
-    bytes.type = Dart_CObject_kExternalTypedData;
-    bytes.value.as_external_typed_data.type = Dart_TypedData_kUint8;
-    bytes.value.as_external_typed_data.length = length;
-    bytes.value.as_external_typed_data.data = reinterpret_cast<uint8_t*>(cstr);
-    bytes.value.as_external_typed_data.peer = cstr;
-    bytes.value.as_external_typed_data.callback = Finalizer;
-    Dart_CObject* elements[1];
-    elements[0] = &bytes;
-    Dart_CObject message;
-    message.type = Dart_CObject_kArray;
-    message.value.as_array.length = 1;
-    message.value.as_array.values = elements;
-    result = Dart_PostCObject(port, &message);
-  }
-
-  if (!result) {
-    free(cstr);
-  }
+  bool result = PostBytes(port, cstr, length, /*incomplete=*/false);
 
   if (FLAG_trace_service) {
     Isolate* isolate = Isolate::Current();
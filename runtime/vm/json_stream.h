@@ -189,6 +189,7 @@ class JSONStream : ValueObject {
   ObjectPtr GetObjectParameterValue(intptr_t i) const;
 
   void PostNullReply(Dart_Port port);
+  static void PostChunk(void* data, char* chunk, intptr_t length);
 
   void OpenObject(const char* property_name = nullptr) {
     if (ignore_object_depth_ > 0 ||
@@ -357,6 +358,8 @@ class JSONStream : ValueObject {
   // associated with this |JSONStream|.
   RingServiceIdZone* id_zone_;
   Dart_Port reply_port_;
+  // The port that chunks of a streamed response are posted to.
+  Dart_Port chunk_port_;
   Instance* seq_;
   Array* parameter_keys_;
   Array* parameter_values_;
@@ -176,6 +176,36 @@ TEST_CASE(JSON_JSONStream_ObjectPrintf) {
   EXPECT_STREQ("{\"key\":\"2 hello\"}", js.ToCString());
 }
 
+static void CollectChunk(void* data, char* chunk, intptr_t length) {
+  TextBuffer* output = reinterpret_cast<TextBuffer*>(data);
+  output->AddRaw(reinterpret_cast<uint8_t*>(chunk), length);
+  free(chunk);
+}
+
+TEST_CASE(JSON_JSONWriter_Chunks) {
+  TextBuffer output(16);
+  JSONWriter writer;
+  writer.SetChunkCallback(8, CollectChunk, &output);
+  writer.OpenObject();
+  writer.PrintProperty("key", "value");
+  writer.OpenArray("list");
+  for (intptr_t i = 0; i < 10; i++) {
+    writer.PrintValue(i);
+  }
+  writer.CloseArray();
+  writer.CloseObject();
+  EXPECT(writer.has_flushed_chunks());
+  EXPECT_LT(writer.buffer()->length(), writer.length());
+
+  char* rest;
+  intptr_t rest_length;
+  writer.Steal(&rest, &rest_length);
+  output.AddRaw(reinterpret_cast<uint8_t*>(rest), rest_length);
+  free(rest);
+  EXPECT_STREQ("{\"key\":\"value\",\"list\":[0,1,2,3,4,5,6,7,8,9]}",
+               output.buffer());
+}
+
 ISOLATE_UNIT_TEST_CASE(JSON_JSONStream_DartObject) {
   JSONStream js;
   {
@@ -81,7 +81,27 @@ void JSONWriter::AppendSerializedObject(const char* property_name,
   buffer_.AddString(serialized_object);
 }
 
+void JSONWriter::SetChunkCallback(intptr_t chunk_size,
+                                  ChunkCallback callback,
+                                  void* data) {
+  ASSERT(chunk_size > 0);
+  ASSERT(callback != nullptr);
+  chunk_size_ = chunk_size;
+  chunk_callback_ = callback;
+  chunk_callback_data_ = data;
+}
+
+void JSONWriter::FlushChunk() {
+  intptr_t length = buffer_.length();
+  ASSERT(length > 0);
+  flushed_last_char_ = buffer_.buffer()[length - 1];
+  flushed_length_ += length;
+  char* chunk = buffer_.Steal();
+  chunk_callback_(chunk_callback_data_, chunk, length);
+}
+
 void JSONWriter::Clear() {
+  ASSERT(!has_flushed_chunks());
   buffer_.Clear();
   open_objects_ = 0;
 }
@@ -318,6 +338,9 @@ void JSONWriter::PrintNewline() {
 }
 
 void JSONWriter::PrintCommaIfNeeded() {
+  if (chunk_callback_ != nullptr && buffer_.length() >= chunk_size_) {
+    FlushChunk();
+  }
   if (NeedComma()) {
     buffer_.AddChar(',');
   }
@@ -326,10 +349,14 @@ void JSONWriter::PrintCommaIfNeeded() {
 bool JSONWriter::NeedComma() {
   const char* buffer = buffer_.buffer();
   intptr_t length = buffer_.length();
-  if (length == 0) {
+  char ch;
+  if (length > 0) {
+    ch = buffer[length - 1];
+  } else if (has_flushed_chunks()) {
+    ch = flushed_last_char_;
+  } else {
     return false;
   }
-  char ch = buffer[length - 1];
   return (ch != '[') && (ch != '{') && (ch != ':') && (ch != ',');
 }
 
@@ -21,6 +21,22 @@ class JSONWriter : ValueObject {
 
   void Steal(char** buffer, intptr_t* buffer_length);
 
+  // Receives the buffered output, which it takes ownership of, when the
+  // writer flushes a chunk.
+  typedef void (*ChunkCallback)(void* data, char* chunk, intptr_t length);
+
+  // Makes the writer hand its output to |callback| whenever it grows to
+  // |chunk_size| bytes, instead of keeping the whole document in memory.
+  // Chunks are only flushed between JSON values, so the output can no longer
+  // be cleared or inspected once a chunk has been flushed.
+  void SetChunkCallback(intptr_t chunk_size,
+                        ChunkCallback callback,
+                        void* data);
+  bool has_flushed_chunks() const { return flushed_length_ > 0; }
+
+  // The number of bytes written, including flushed chunks.
+  intptr_t length() const { return flushed_length_ + buffer_.length(); }
+
   void PrintCommaIfNeeded();
 
   // Append |buffer| to the stream.
@@ -95,8 +111,17 @@ class JSONWriter : ValueObject {
   // Debug only fatal assertion.
   static void EnsureIntegerIsRepresentableInJavaScript(int64_t i);
 
+  void FlushChunk();
+
   intptr_t open_objects_;
   TextBuffer buffer_;
+
+  intptr_t chunk_size_ = 0;
+  ChunkCallback chunk_callback_ = nullptr;
+  void* chunk_callback_data_ = nullptr;
+  intptr_t flushed_length_ = 0;
+  // Last character of the flushed output, used to decide on commas.
+  char flushed_last_char_ = '\0';
 };
 
 }  // namespace dart
@@ -7,16 +7,19 @@
 
 #include <string.h>
 
+#include <atomic>
 #include <memory>
 
 #include "vm/closure_functions_cache.h"
 #include "vm/compiler/backend/flow_graph_compiler.h"
 #include "vm/compiler/frontend/constant_reader.h"
 #include "vm/compiler/frontend/kernel_translation_helper.h"
+#include "vm/dart.h"
 #include "vm/dart_api_impl.h"
 #include "vm/flags.h"
 #include "vm/heap/heap.h"
 #include "vm/kernel_binary.h"
+#include "vm/lockers.h"
 #include "vm/longjump.h"
 #include "vm/object_store.h"
 #include "vm/parser.h"
@@ -24,6 +27,7 @@
 #include "vm/service_isolate.h"
 #include "vm/symbols.h"
 #include "vm/thread.h"
+#include "vm/thread_pool.h"
 #include "vm/version.h"
 
 namespace dart {
@@ -55,6 +59,12 @@ DEFINE_FLAG_HANDLER(EnableExperimentSharedData,
                     experimental_shared_data,
                     "Enable experiment to share data between isolates.");
 
+DEFINE_FLAG(int,
+            kernel_loader_tasks,
+            2,
+            "The number of helper tasks which read the source tables of "
+            "concatenated kernel programs in parallel with the mutator.");
+
 class SimpleExpressionConverter {
  public:
   SimpleExpressionConverter(TranslationHelper* translation_helper,
@@ -252,6 +262,92 @@ void KernelLoader::ReadLoadingUnits() {
   helper.ReadLoadingUnits();
 }
 
+ArrayPtr KernelLoader::ReadSourceTable(Thread* thread,
+                                       const TypedDataBase& component) {
+  Zone* zone = thread->zone();
+  TranslationHelper translation_helper(thread);
+  KernelReaderHelper helper(zone, &translation_helper, component, 0);
+  const intptr_t source_table_size = helper.SourceTableSize();
+  const auto& scripts = GrowableObjectArray::Handle(
+      zone, GrowableObjectArray::New(3 * source_table_size, Heap::kOld));
+  auto& line_starts = TypedData::Handle(zone);
+  for (intptr_t index = 0; index < source_table_size; ++index) {
+    const String& uri_string = helper.SourceTableUriFor(index);
+    line_starts = helper.GetLineStartsFor(index);
+    if (line_starts.Length() == 0) continue;
+    scripts.Add(uri_string, Heap::kOld);
+    scripts.Add(line_starts, Heap::kOld);
+    scripts.Add(helper.GetSourceFor(index), Heap::kOld);
+  }
+  return Array::MakeFixedLength(scripts);
+}
+
+// Reads source tables of the subprograms of [binary] into [tables] until
+// all of them are claimed. Runs on the mutator and on helper tasks.
+static void ReadSourceTables(Thread* thread,
+                             const TypedDataBase& binary,
+                             const GrowableArray<intptr_t>& subprogram_starts,
+                             std::atomic<intptr_t>* next_subprogram,
+                             const Array& tables) {
+  auto& component = TypedDataBase::Handle(thread->zone());
+  auto& table = Array::Handle(thread->zone());
+  for (intptr_t i = next_subprogram->fetch_add(1); i < tables.Length();
+       i = next_subprogram->fetch_add(1)) {
+    HANDLESCOPE(thread);
+    component = binary.ViewFromTo(subprogram_starts[i],
+                                  subprogram_starts[i + 1], Heap::kOld);
+    table = KernelLoader::ReadSourceTable(thread, component);
+    tables.SetAt(i, table);
+  }
+}
+
+class SourceTableReaderTask : public ThreadPool::Task {
+ public:
+  SourceTableReaderTask(IsolateGroup* isolate_group,
+                        const TypedDataBase& binary,
+                        const GrowableArray<intptr_t>& subprogram_starts,
+                        std::atomic<intptr_t>* next_subprogram,
+                        const Array& tables,
+                        Monitor* monitor,
+                        intptr_t* pending_tasks)
+      : isolate_group_(isolate_group),
+        binary_(binary),
+        subprogram_starts_(subprogram_starts),
+        next_subprogram_(next_subprogram),
+        tables_(tables),
+        monitor_(monitor),
+        pending_tasks_(pending_tasks) {}
+
+  virtual void Run() {
+    const bool kBypassSafepoint = false;
+    if (Thread::EnterIsolateGroupAsHelper(isolate_group_, Thread::kUnknownTask,
+                                          kBypassSafepoint)) {
+      Thread* thread = Thread::Current();
+      {
+        StackZone stack_zone(thread);
+        ReadSourceTables(thread, binary_, subprogram_starts_, next_subprogram_,
+                         tables_);
+      }
+      Thread::ExitIsolateGroupAsHelper(kBypassSafepoint);
+    }
+    MonitorLocker ml(monitor_);
+    --*pending_tasks_;
+    ml.Notify();
+  }
+
+ private:
+  IsolateGroup* isolate_group_;
+  // Handles of the mutator, which waits for the task to finish.
+  const TypedDataBase& binary_;
+  const GrowableArray<intptr_t>& subprogram_starts_;
+  std::atomic<intptr_t>* next_subprogram_;
+  const Array& tables_;
+  Monitor* monitor_;
+  intptr_t* pending_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(SourceTableReaderTask);
+};
+
 Object& KernelLoader::LoadEntireProgram(Program* program,
                                         bool process_pending_classes) {
   Thread* thread = Thread::Current();
@@ -273,26 +369,51 @@ Object& KernelLoader::LoadEntireProgram(Program* program,
   Library& library = Library::Handle(zone);
   intptr_t subprogram_count = subprogram_file_starts.length() - 1;
 
-  // First index all source tables.
+  // First index all source tables. Decoding the sources is independent for
+  // each subprogram and is shared with helper tasks, the tables are merged
+  // in order afterwards.
+  const auto& tables =
+      Array::Handle(zone, Array::New(subprogram_count, Heap::kOld));
+  {
+    std::atomic<intptr_t> next_subprogram = 0;
+    Monitor monitor;
+    intptr_t pending_tasks = 0;
+    const intptr_t num_tasks = Utils::Minimum<intptr_t>(
+        FLAG_kernel_loader_tasks, subprogram_count - 1);
+    for (intptr_t i = 0; i < num_tasks; ++i) {
+      {
+        MonitorLocker ml(&monitor);
+        ++pending_tasks;
+      }
+      if (!Dart::thread_pool()->Run<SourceTableReaderTask>(
+              thread->isolate_group(), program->binary(),
+              subprogram_file_starts, &next_subprogram, tables, &monitor,
+              &pending_tasks)) {
+        MonitorLocker ml(&monitor);
+        --pending_tasks;
+        break;
+      }
+    }
+    ReadSourceTables(thread, program->binary(), subprogram_file_starts,
+                     &next_subprogram, tables);
+    MonitorLocker ml(&monitor);
+    while (pending_tasks > 0) {
+      ml.WaitWithSafepointCheck(thread);
+    }
+  }
+
   UriToSourceTable uri_to_source_table;
   UriToSourceTableEntry wrapper;
   Thread* thread_ = Thread::Current();
   Zone* zone_ = thread_->zone();
+  auto& table = Array::Handle(Z);
   for (intptr_t i = subprogram_count - 1; i >= 0; --i) {
-    intptr_t subprogram_start = subprogram_file_starts.At(i);
-    intptr_t subprogram_end = subprogram_file_starts.At(i + 1);
-    const auto& component = TypedDataBase::Handle(
-        program->binary().ViewFromTo(subprogram_start, subprogram_end));
-    TranslationHelper translation_helper(thread);
-    KernelReaderHelper helper_(zone_, &translation_helper, component, 0);
-    const intptr_t source_table_size = helper_.SourceTableSize();
-    for (intptr_t index = 0; index < source_table_size; ++index) {
-      const String& uri_string = helper_.SourceTableUriFor(index);
-      wrapper.uri = &uri_string;
-      TypedData& line_starts =
-          TypedData::Handle(Z, helper_.GetLineStartsFor(index));
-      if (line_starts.Length() == 0) continue;
-      const String& script_source = helper_.GetSourceFor(index);
+    table ^= tables.At(i);
+    for (intptr_t j = 0; j < table.Length(); j += 3) {
+      const String& uri_string = String::CheckedHandle(Z, table.At(j));
+      TypedData& line_starts = TypedData::CheckedHandle(Z, table.At(j + 1));
+      const String& script_source =
+          String::CheckedHandle(Z, table.At(j + 2));
       wrapper.uri = &uri_string;
       UriToSourceTableEntry* pair = uri_to_source_table.LookupValue(&wrapper);
       if (pair != nullptr) {
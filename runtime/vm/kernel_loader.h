@@ -207,6 +207,12 @@ class KernelLoader : public ValueObject {
                                        intptr_t kernel_buffer_length,
                                        const String& url);
 
+  // Reads the source table of [component] into an array of (uri, line
+  // starts, source) triples. Scripts without line starts are skipped.
+  // Can be called from helper threads.
+  static ArrayPtr ReadSourceTable(Thread* thread,
+                                  const TypedDataBase& component);
+
   static void FinishLoading(const Class& klass);
 
   void ReadObfuscationProhibitions();
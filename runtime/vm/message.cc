@@ -139,6 +139,55 @@ void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
   }
 }
 
+void MessageQueue::EnqueueControl(std::unique_ptr<Message> msg0) {
+  Message* msg = msg0.release();
+  ASSERT(msg->next_ == nullptr);
+  ASSERT(msg->is_control());
+  auto is_ahead = [](Message* m) {
+    return m->dest_port() == Message::kIllegalPort || m->is_control();
+  };
+  if (head_ == nullptr || !is_ahead(head_)) {
+    msg->next_ = head_;
+    head_ = msg;
+    if (tail_ == nullptr) {
+      tail_ = msg;
+    }
+    return;
+  }
+  Message* cur = head_;
+  while (cur->next_ != nullptr && is_ahead(cur->next_)) {
+    cur = cur->next_;
+  }
+  msg->next_ = cur->next_;
+  cur->next_ = msg;
+  if (tail_ == cur) {
+    tail_ = msg;
+  }
+}
+
+void MessageQueue::RemoveMessagesTo(Dart_Port port) {
+  Message* prev = nullptr;
+  Message* cur = head_;
+  while (cur != nullptr) {
+    Message* next = cur->next_;
+    if (cur->dest_port() == port) {
+      if (prev == nullptr) {
+        head_ = next;
+      } else {
+        prev->next_ = next;
+      }
+      if (tail_ == cur) {
+        tail_ = prev;
+      }
+      cur->next_ = nullptr;
+      delete cur;
+    } else {
+      prev = cur;
+    }
+    cur = next;
+  }
+}
+
 std::unique_ptr<Message> MessageQueue::Dequeue() {
   Message* result = head_;
   if (result != nullptr) {
@@ -165,6 +214,39 @@ void MessageQueue::Clear() {
   }
 }
 
+ConcurrentMessageList::~ConcurrentMessageList() {
+  MessageQueue queue;
+  MoveTo(&queue);
+}
+
+void ConcurrentMessageList::Add(std::unique_ptr<Message> msg0) {
+  Message* msg = msg0.release();
+  // Make sure messages are not reused.
+  ASSERT(msg->next_ == nullptr);
+  Message* head = head_.load(std::memory_order_relaxed);
+  do {
+    msg->next_ = head;
+  } while (!head_.compare_exchange_weak(head, msg));
+}
+
+void ConcurrentMessageList::MoveTo(MessageQueue* queue) {
+  // Reverse the taken messages into the order they were added.
+  Message* msg = head_.exchange(nullptr);
+  Message* reversed = nullptr;
+  while (msg != nullptr) {
+    Message* next = msg->next_;
+    msg->next_ = reversed;
+    reversed = msg;
+    msg = next;
+  }
+  while (reversed != nullptr) {
+    Message* next = reversed->next_;
+    reversed->next_ = nullptr;
+    queue->Enqueue(std::unique_ptr<Message>(reversed), /*before_events=*/false);
+    reversed = next;
+  }
+}
+
 MessageQueue::Iterator::Iterator(const MessageQueue* queue) : next_(nullptr) {
   Reset(queue);
 }
@@ -198,6 +280,15 @@ intptr_t MessageQueue::Length() const {
   return length;
 }
 
+int64_t MessageQueue::OldestPostMicros() const {
+  MessageQueue::Iterator it(this);
+  int64_t oldest = kMaxInt64;
+  while (it.HasNext()) {
+    oldest = Utils::Minimum(oldest, it.Next()->post_micros());
+  }
+  return oldest;
+}
+
 Message* MessageQueue::FindMessageById(intptr_t id) {
   MessageQueue::Iterator it(this);
   while (it.HasNext()) {
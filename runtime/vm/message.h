@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_MESSAGE_H_
 #define RUNTIME_VM_MESSAGE_H_
 
+#include <atomic>
 #include <memory>
 #include <utility>
 
@@ -81,6 +82,10 @@ class Message {
   }
   intptr_t snapshot_length() const { return snapshot_length_; }
 
+  // Monotonic time at which the message was posted to its handler.
+  int64_t post_micros() const { return post_micros_; }
+  void set_post_micros(int64_t micros) { post_micros_ = micros; }
+
   MessageFinalizableData* finalizable_data() { return finalizable_data_; }
 
   intptr_t Size() const {
@@ -105,6 +110,18 @@ class Message {
   // of at the top of the message loop. Control messages from dart:isolate or
   // vm-service requests.
   bool IsOOB() const { return priority_ == Message::kOOBPriority; }
+
+  // A normal message to a port in the control lane, which is handled before
+  // the other normal messages queued for the handler. See PortMap::SetPortLane.
+  bool is_control() const { return is_control_; }
+  // A normal message to a coalescing port, which replaces the messages still
+  // queued for that port.
+  bool is_coalescing() const { return is_coalescing_; }
+  void set_lane(bool control, bool coalescing) {
+    ASSERT(!IsOOB());
+    is_control_ = control;
+    is_coalescing_ = coalescing;
+  }
   bool IsSnapshot() const {
     return !IsRaw() && !IsPersistentHandle() && !IsFinalizerInvocationRequest();
   }
@@ -134,6 +151,7 @@ class Message {
   static intptr_t const kPersistentHandleSnapshotLen = -1;
   static intptr_t const kFinalizerSnapshotLen = -2;
 
+  friend class ConcurrentMessageList;
   friend class MessageQueue;
 
   Message* next_ = nullptr;
@@ -151,6 +169,9 @@ class Message {
   intptr_t snapshot_length_ = 0;
   MessageFinalizableData* finalizable_data_ = nullptr;
   Priority priority_;
+  bool is_control_ = false;
+  bool is_coalescing_ = false;
+  int64_t post_micros_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(Message);
 };
@@ -163,6 +184,13 @@ class MessageQueue {
 
   void Enqueue(std::unique_ptr<Message> msg, bool before_events);
 
+  // Enqueues [msg] after the messages in front of the queue which have been
+  // enqueued before events or are control messages.
+  void EnqueueControl(std::unique_ptr<Message> msg);
+
+  // Removes the messages to [port] from the queue.
+  void RemoveMessagesTo(Dart_Port port);
+
   // Gets the next message from the message queue or nullptr if no
   // message is available.  This function will not block.
   std::unique_ptr<Message> Dequeue();
@@ -192,6 +220,10 @@ class MessageQueue {
 
   intptr_t Length() const;
 
+  // Returns the earliest post time of the queued messages, or kMaxInt64 if
+  // the queue is empty.
+  int64_t OldestPostMicros() const;
+
   // Returns the message with id or nullptr.
   Message* FindMessageById(intptr_t id);
 
@@ -204,6 +236,27 @@ class MessageQueue {
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
 
+// A list of messages which any number of threads can add to without locking
+// and which a single consumer moves to a MessageQueue in one step.
+class ConcurrentMessageList {
+ public:
+  ConcurrentMessageList() {}
+  ~ConcurrentMessageList();
+
+  void Add(std::unique_ptr<Message> msg);
+
+  bool IsEmpty() const { return head_.load() == nullptr; }
+
+  // Appends all added messages to [queue] in the order they were added.
+  void MoveTo(MessageQueue* queue);
+
+ private:
+  // The most recently added message, linked to the previously added ones.
+  std::atomic<Message*> head_ = {nullptr};
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentMessageList);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_MESSAGE_H_
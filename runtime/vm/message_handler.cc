@@ -20,6 +20,12 @@ namespace dart {
 
 DECLARE_FLAG(bool, trace_service_pause_events);
 
+DEFINE_FLAG(int,
+            message_handler_spin_micros,
+            0,
+            "Keep a message handler task on its thread for this amount of time "
+            "waiting for more messages once its queue is empty.");
+
 class MessageHandlerTask : public ThreadPool::Task {
  public:
   explicit MessageHandlerTask(MessageHandler* handler) : handler_(handler) {
@@ -121,7 +127,27 @@ bool MessageHandler::Run(ThreadPool* pool,
 
 void MessageHandler::PostMessage(std::unique_ptr<Message> message,
                                  bool before_events) {
-  Message::Priority saved_priority;
+  Message::Priority saved_priority = message->priority();
+  message->set_post_micros(OS::GetCurrentMonotonicMicros());
+
+  // While a task is running and not waiting for messages, normal messages can
+  // be added without taking the monitor: the task moves them to the queue_
+  // before it looks for the next message, and it checks for messages added
+  // concurrently with stopping in ClearTaskRunningLocked.
+  //
+  // Accesses to [incoming_], [task_running_] and [paused_for_messages_] are
+  // sequentially consistent, so either this thread sees the task stopping or
+  // waiting, or the task sees the message.
+  if (!message->IsOOB() && !message->is_control() &&
+      !message->is_coalescing() && !before_events && !FLAG_trace_isolates &&
+      task_running_ && !paused_for_messages_) {
+    incoming_.Add(std::move(message));
+    if (task_running_ && !paused_for_messages_) {
+      MessageNotify(saved_priority);
+      return;
+    }
+    // Fall back to waking the handler up with the monitor held.
+  }
 
   {
     MonitorLocker ml(&monitor_);
@@ -146,11 +172,21 @@ void MessageHandler::PostMessage(std::unique_ptr<Message> message,
       }
     }
 
-    saved_priority = message->priority();
-    if (message->IsOOB()) {
+    if (message == nullptr) {
+      // The message was added to incoming_ above.
+    } else if (message->IsOOB()) {
       oob_queue_->Enqueue(std::move(message), before_events);
     } else {
-      queue_->Enqueue(std::move(message), before_events);
+      // Keep the order of the messages added to incoming_ before.
+      MoveIncomingMessagesLocked();
+      if (message->is_coalescing()) {
+        queue_->RemoveMessagesTo(message->dest_port());
+      }
+      if (message->is_control() && !before_events) {
+        queue_->EnqueueControl(std::move(message));
+      } else {
+        queue_->Enqueue(std::move(message), before_events);
+      }
     }
     if (paused_for_messages_) {
       ml.Notify();
@@ -172,11 +208,48 @@ std::unique_ptr<Message> MessageHandler::DequeueMessage(
   ASSERT(monitor_.IsOwnedByCurrentThread());
   std::unique_ptr<Message> message = oob_queue_->Dequeue();
   if ((message == nullptr) && (min_priority < Message::kOOBPriority)) {
+    MoveIncomingMessagesLocked();
     message = queue_->Dequeue();
   }
   return message;
 }
 
+void MessageHandler::MoveIncomingMessagesLocked() {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  if (!incoming_.IsEmpty()) {
+    incoming_.MoveTo(queue_);
+  }
+}
+
+void MessageHandler::ClearTaskRunningLocked() {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  task_running_ = false;
+  // Messages may have been added to incoming_ by posters which saw this task
+  // still running. Start a task for them as PostMessage would have, once.
+  if (pool_ != nullptr && !incoming_.IsEmpty()) {
+    incoming_.MoveTo(queue_);
+    task_running_ = true;
+    const bool launched_successfully = pool_->Run<MessageHandlerTask>(this);
+    ASSERT(launched_successfully);
+  }
+}
+
+bool MessageHandler::SpinForMessagesLocked(MonitorLocker* ml) {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  if (FLAG_message_handler_spin_micros <= 0 || paused()) {
+    return false;
+  }
+  // Messages posted while this task is running are added to incoming_.
+  ml->Exit();
+  const int64_t deadline =
+      OS::GetCurrentMonotonicMicros() + FLAG_message_handler_spin_micros;
+  while (incoming_.IsEmpty() && OS::GetCurrentMonotonicMicros() < deadline) {
+  }
+  ml->Enter();
+  MoveIncomingMessagesLocked();
+  return !queue_->IsEmpty() || !oob_queue_->IsEmpty();
+}
+
 void MessageHandler::ClearOOBQueue() {
   oob_queue_->Clear();
 }
@@ -297,6 +370,7 @@ MessageHandler::MessageStatus MessageHandler::PauseAndHandleAllMessages(
   CheckAccess();
 #endif
   paused_for_messages_ = true;
+  MoveIncomingMessagesLocked();
   while (queue_->IsEmpty() && oob_queue_->IsEmpty()) {
     Monitor::WaitResult wr;
     {
@@ -309,6 +383,7 @@ MessageHandler::MessageStatus MessageHandler::PauseAndHandleAllMessages(
     if (wr == Monitor::kTimedOut) {
       break;
     }
+    MoveIncomingMessagesLocked();
     if (queue_->IsEmpty()) {
       // There are only OOB messages. Handle them and then continue waiting for
       // normal messages unless there is an error.
@@ -371,7 +446,14 @@ std::unique_ptr<Message> MessageHandler::StealOOBMessage() {
 
 bool MessageHandler::HasMessages() {
   MonitorLocker ml(&monitor_);
-  return !queue_->IsEmpty();
+  return !queue_->IsEmpty() || !incoming_.IsEmpty();
+}
+
+intptr_t MessageHandler::QueueLength(int64_t* oldest_post_micros) {
+  MonitorLocker ml(&monitor_);
+  MoveIncomingMessagesLocked();
+  *oldest_post_micros = queue_->OldestPostMicros();
+  return queue_->Length();
 }
 
 void MessageHandler::TaskCallback() {
@@ -402,7 +484,7 @@ void MessageHandler::TaskCallback() {
       if (ShouldPauseOnStart(status)) {
         // Still paused.
         ASSERT(oob_queue_->IsEmpty());
-        task_running_ = false;  // No task in queue.
+        ClearTaskRunningLocked();  // No task in queue.
         return;
       } else {
         PausedOnStartLocked(&ml, false);
@@ -413,7 +495,7 @@ void MessageHandler::TaskCallback() {
       if (ShouldPauseOnExit(status)) {
         // Still paused.
         ASSERT(oob_queue_->IsEmpty());
-        task_running_ = false;  // No task in queue.
+        ClearTaskRunningLocked();  // No task in queue.
         return;
       } else {
         PausedOnExitLocked(&ml, false);
@@ -441,6 +523,10 @@ void MessageHandler::TaskCallback() {
       // Handle any pending messages for this message handler.
       if (status != kShutdown) {
         status = HandleMessages(&ml, (status == kOK), true);
+        while (status == kOK && KeepAliveLocked() &&
+               SpinForMessagesLocked(&ml)) {
+          status = HandleMessages(&ml, true, true);
+        }
       }
     }
 
@@ -463,7 +549,7 @@ void MessageHandler::TaskCallback() {
         if (ShouldPauseOnExit(status)) {
           // Still paused.
           ASSERT(oob_queue_->IsEmpty());
-          task_running_ = false;  // No task in queue.
+          ClearTaskRunningLocked();  // No task in queue.
           return;
         } else {
           PausedOnExitLocked(&ml, false);
@@ -495,7 +581,7 @@ void MessageHandler::TaskCallback() {
     // Clear task_running_ last.  This allows other tasks to potentially start
     // for this message handler.
     ASSERT(oob_queue_->IsEmpty());
-    task_running_ = false;
+    ClearTaskRunningLocked();
   }
 
   // The handler may have been deleted by another thread here if it is a native
@@ -527,6 +613,7 @@ void MessageHandler::OnAllPortsClosed() {
         "\thandler:    %s\n",
         name());
   }
+  MoveIncomingMessagesLocked();
   queue_->Clear();
   oob_queue_->Clear();
 }
@@ -602,6 +689,7 @@ void MessageHandler::PausedOnExitLocked(MonitorLocker* ml, bool paused) {
 MessageHandler::AcquiredQueues::AcquiredQueues(MessageHandler* handler)
     : handler_(handler), ml_(&handler->monitor_) {
   ASSERT(handler != nullptr);
+  handler_->MoveIncomingMessagesLocked();
   handler_->oob_message_handling_allowed_ = false;
 }
 
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_MESSAGE_HANDLER_H_
 #define RUNTIME_VM_MESSAGE_HANDLER_H_
 
+#include <atomic>
 #include <memory>
 
 #include "vm/isolate.h"
@@ -82,6 +83,10 @@ class MessageHandler : public PortHandler {
   // handler.
   bool HasMessages();
 
+  // Returns the number of pending normal messages, and the earliest time one
+  // of them was posted in |oldest_post_micros| (kMaxInt64 if there are none).
+  intptr_t QueueLength(int64_t* oldest_post_micros);
+
   // Whether to keep this message handler alive or whether it should shutdown.
   virtual bool KeepAliveLocked() { return true; }
 
@@ -225,6 +230,17 @@ class MessageHandler : public PortHandler {
   // messages from the queue_.
   std::unique_ptr<Message> DequeueMessage(Message::Priority min_priority);
 
+  // Moves the messages posted without taking the monitor to the queue_.
+  void MoveIncomingMessagesLocked();
+
+  // Clears task_running_ and starts a new task if messages were posted
+  // without taking the monitor, relying on the current task to handle them.
+  void ClearTaskRunningLocked();
+
+  // Waits for up to --message_handler_spin_micros for messages without
+  // ending the current task. Returns whether there are messages to handle.
+  bool SpinForMessagesLocked(MonitorLocker* ml);
+
   void ClearOOBQueue();
 
   // Handles any pending messages.
@@ -235,10 +251,14 @@ class MessageHandler : public PortHandler {
   Monitor monitor_;  // Protects all fields in MessageHandler.
   MessageQueue* queue_;
   MessageQueue* oob_queue_;
+  // Normal messages posted while a task is running, which are added without
+  // taking the monitor. See PostMessage.
+  ConcurrentMessageList incoming_;
   // This flag is not thread safe and can only reliably be accessed on a single
   // thread.
   bool oob_message_handling_allowed_;
-  bool paused_for_messages_;
+  // Only modified with the monitor held, but read without it by PostMessage.
+  std::atomic<bool> paused_for_messages_;
 
   // Only accessed by [PortMap], protected by [PortMap]s lock. See ports()
   // getter.
@@ -255,7 +275,8 @@ class MessageHandler : public PortHandler {
   MessageStatus remembered_paused_on_exit_status_;
   int64_t paused_timestamp_;
 #endif
-  bool task_running_;
+  // Only modified with the monitor held, but read without it by PostMessage.
+  std::atomic<bool> task_running_;
   ThreadPool* pool_;
   StartCallback start_callback_;
   EndCallback end_callback_;
@@ -22,6 +22,7 @@
 #include "vm/object_graph_copy.h"
 #include "vm/object_store.h"
 #include "vm/symbols.h"
+#include "vm/timeline.h"
 #include "vm/type_testing_stubs.h"
 
 namespace dart {
@@ -3422,6 +3423,7 @@ std::unique_ptr<Message> WriteMessage(bool same_group,
   }
 
   Thread* thread = Thread::Current();
+  TIMELINE_DURATION(thread, Isolate, "WriteMessage");
   MessageSerializer serializer(thread);
   serializer.Serialize(obj);
   return serializer.Finish(dest_port, priority);
@@ -3431,6 +3433,7 @@ std::unique_ptr<Message> WriteApiMessage(Zone* zone,
                                          Dart_CObject* obj,
                                          Dart_Port dest_port,
                                          Message::Priority priority) {
+  TIMELINE_DURATION(Thread::Current(), API, "WriteApiMessage");
   ApiMessageSerializer serializer(zone);
   if (!serializer.Serialize(obj)) {
     return nullptr;
@@ -3482,6 +3485,7 @@ ObjectPtr ReadMessage(Thread* thread, Message* message) {
     return ReadObjectGraphCopyMessage(thread, message->persistent_handle());
   } else {
     RELEASE_ASSERT(message->IsSnapshot());
+    TIMELINE_DURATION(thread, Isolate, "ReadMessage");
     LongJumpScope jump(thread);
     if (DART_SETJMP(*jump.Set()) == 0) {
       MessageDeserializer deserializer(thread, message);
@@ -3499,6 +3503,7 @@ Dart_CObject* ReadApiMessage(Zone* zone, Message* message) {
     return result;
   } else {
     RELEASE_ASSERT(message->IsSnapshot());
+    TIMELINE_DURATION(Thread::Current(), API, "ReadApiMessage");
     ApiMessageDeserializer deserializer(zone, message);
     return deserializer.Deserialize();
   }
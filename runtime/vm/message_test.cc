@@ -140,4 +140,89 @@ TEST_CASE(MessageQueue_Clear) {
   EXPECT(queue.IsEmpty());
 }
 
+TEST_CASE(MessageQueue_Lanes) {
+  MessageQueue queue;
+  Dart_Port data_port = 1;
+  Dart_Port control_port = 2;
+
+  const char* str1 = "msg1";
+  const char* str2 = "msg2";
+  const char* str3 = "msg3";
+  const char* str4 = "msg4";
+
+  std::unique_ptr<Message> msg;
+  msg = Message::New(data_port, AllocMsg(str1), strlen(str1) + 1, nullptr,
+                     Message::kNormalPriority);
+  queue.Enqueue(std::move(msg), false);
+  msg = Message::New(data_port, AllocMsg(str2), strlen(str2) + 1, nullptr,
+                     Message::kNormalPriority);
+  queue.Enqueue(std::move(msg), false);
+
+  // Control messages go ahead of the data messages, in posting order.
+  msg = Message::New(control_port, AllocMsg(str3), strlen(str3) + 1, nullptr,
+                     Message::kNormalPriority);
+  msg->set_lane(/*control=*/true, /*coalescing=*/false);
+  queue.EnqueueControl(std::move(msg));
+  msg = Message::New(control_port, AllocMsg(str4), strlen(str4) + 1, nullptr,
+                     Message::kNormalPriority);
+  msg->set_lane(/*control=*/true, /*coalescing=*/false);
+  queue.EnqueueControl(std::move(msg));
+  EXPECT_EQ(4, queue.Length());
+
+  msg = queue.Dequeue();
+  EXPECT_STREQ(str3, reinterpret_cast<char*>(msg->snapshot()));
+  msg = queue.Dequeue();
+  EXPECT_STREQ(str4, reinterpret_cast<char*>(msg->snapshot()));
+
+  // Coalescing drops the messages still queued for a port.
+  queue.RemoveMessagesTo(data_port);
+  EXPECT(queue.IsEmpty());
+  msg = Message::New(data_port, AllocMsg(str1), strlen(str1) + 1, nullptr,
+                     Message::kNormalPriority);
+  queue.Enqueue(std::move(msg), false);
+  msg = queue.Dequeue();
+  EXPECT_STREQ(str1, reinterpret_cast<char*>(msg->snapshot()));
+  EXPECT(queue.IsEmpty());
+}
+
+TEST_CASE(ConcurrentMessageList_MoveTo) {
+  ConcurrentMessageList list;
+  MessageQueue queue;
+  Dart_Port port = 1;
+  EXPECT(list.IsEmpty());
+
+  const char* str1 = "msg1";
+  const char* str2 = "msg2";
+  const char* str3 = "msg3";
+
+  std::unique_ptr<Message> msg;
+  msg = Message::New(port, AllocMsg(str1), strlen(str1) + 1, nullptr,
+                     Message::kNormalPriority);
+  queue.Enqueue(std::move(msg), false);
+  msg = Message::New(port, AllocMsg(str2), strlen(str2) + 1, nullptr,
+                     Message::kNormalPriority);
+  list.Add(std::move(msg));
+  msg = Message::New(port, AllocMsg(str3), strlen(str3) + 1, nullptr,
+                     Message::kNormalPriority);
+  list.Add(std::move(msg));
+  EXPECT(!list.IsEmpty());
+
+  // Added messages are appended in the order they were added.
+  list.MoveTo(&queue);
+  EXPECT(list.IsEmpty());
+  EXPECT_EQ(3, queue.Length());
+  msg = queue.Dequeue();
+  EXPECT_STREQ(str1, reinterpret_cast<char*>(msg->snapshot()));
+  msg = queue.Dequeue();
+  EXPECT_STREQ(str2, reinterpret_cast<char*>(msg->snapshot()));
+  msg = queue.Dequeue();
+  EXPECT_STREQ(str3, reinterpret_cast<char*>(msg->snapshot()));
+  EXPECT(queue.IsEmpty());
+
+  // Messages left in the list are freed with it.
+  msg = Message::New(port, AllocMsg(str1), strlen(str1) + 1, nullptr,
+                     Message::kNormalPriority);
+  list.Add(std::move(msg));
+}
+
 }  // namespace dart
@@ -4,9 +4,11 @@
 
 #include "vm/metrics.h"
 
+#include "vm/compiler/jit/compiler.h"
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/log.h"
+#include "vm/message_handler.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/runtime_entry.h"
@@ -182,6 +184,78 @@ int64_t MetricHeapUsed::Value() const {
          isolate_group()->heap()->UsedInWords(Heap::kOld) * kWordSize;
 }
 
+int64_t MetricHeapOldReleased::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  return isolate_group()->heap()->old_space()->released_in_bytes();
+}
+
+int64_t MetricHeapOldResident::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  PageSpace* old_space = isolate_group()->heap()->old_space();
+  return Utils::Maximum<int64_t>(
+      0, old_space->CapacityInWords() * kWordSize -
+             old_space->released_in_bytes());
+}
+
+int64_t MetricHeapNewAllocated::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  return isolate_group()->heap()->AllocatedInWords(Heap::kNew) * kWordSize;
+}
+
+int64_t MetricHeapOldAllocated::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  return isolate_group()->heap()->AllocatedInWords(Heap::kOld) * kWordSize;
+}
+
+int64_t MetricHeapCodeCapacity::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  return isolate_group()->heap()->ExecutableCapacityInWords() * kWordSize;
+}
+
+int64_t MetricGCNewTime::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  return isolate_group()->heap()->GCTimeInMicros(Heap::kNew);
+}
+
+int64_t MetricGCOldTime::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  return isolate_group()->heap()->GCTimeInMicros(Heap::kOld);
+}
+
+int64_t MetricMessageQueueLength::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  int64_t length = 0;
+  isolate_group()->ForEachIsolate([&](Isolate* isolate) {
+    int64_t oldest_post_micros;
+    length += isolate->message_handler()->QueueLength(&oldest_post_micros);
+  });
+  return length;
+}
+
+int64_t MetricMessageQueueAge::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+  int64_t oldest = kMaxInt64;
+  isolate_group()->ForEachIsolate([&](Isolate* isolate) {
+    int64_t oldest_post_micros;
+    isolate->message_handler()->QueueLength(&oldest_post_micros);
+    oldest = Utils::Minimum(oldest, oldest_post_micros);
+  });
+  if (oldest == kMaxInt64) {
+    return 0;
+  }
+  return OS::GetCurrentMonotonicMicros() - oldest;
+}
+
+int64_t MetricCompilerQueueLength::Value() const {
+  ASSERT(isolate_group() == IsolateGroup::Current());
+#if defined(DART_PRECOMPILED_RUNTIME)
+  return 0;
+#else
+  BackgroundCompiler* compiler = isolate_group()->background_compiler();
+  return compiler == nullptr ? 0 : compiler->QueueLength();
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
 int64_t MetricIsolateCount::Value() const {
   return Isolate::IsolateListLength();
 }
@@ -206,6 +280,36 @@ void MaxMetric::SetValue(int64_t new_value) {
   }
 }
 
+PercentileMetric::PercentileMetric() : Metric(), count_(0) {
+  for (intptr_t i = 0; i < kNumBuckets; i++) {
+    buckets_[i] = 0;
+  }
+}
+
+void PercentileMetric::Record(int64_t value) {
+  // Bucket i holds the values in [2^(i-1), 2^i).
+  const intptr_t bucket = value <= 0 ? 0 : Utils::HighestBit(value) + 1;
+  buckets_[Utils::Minimum(bucket, kNumBuckets - 1)].fetch_add(1);
+  count_.fetch_add(1);
+}
+
+int64_t PercentileMetric::Value() const {
+  const int64_t count = count_.load();
+  if (count == 0) {
+    return 0;
+  }
+  // The number of values at or below the 99th percentile, rounded up.
+  const int64_t rank = count - count / 100;
+  int64_t seen = 0;
+  for (intptr_t i = 0; i < kNumBuckets - 1; i++) {
+    seen += buckets_[i].load();
+    if (seen >= rank) {
+      return (static_cast<int64_t>(1) << i) - 1;
+    }
+  }
+  return kMaxInt64;
+}
+
 MinMetric::MinMetric() : Metric() {
   set_value(kMaxInt64);
 }
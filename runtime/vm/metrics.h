@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_METRICS_H_
 #define RUNTIME_VM_METRICS_H_
 
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 
 namespace dart {
@@ -26,13 +27,29 @@ class JSONStream;
 //
 // All metrics are exposed via vm-service protocol.
 //
+// Allocation and GC time metrics are totals since the isolate group was
+// created, so that scrapers can compute rates over their own intervals. The
+// allocation totals are updated at the start of each GC.
+//
 #define DART_API_ISOLATE_GROUP_METRIC_LIST(V)                                  \
   V(MetricHeapOldUsed, HeapOldUsed, "heap.old.used", kByte)                    \
   V(MetricHeapOldCapacity, HeapOldCapacity, "heap.old.capacity", kByte)        \
   V(MetricHeapOldExternal, HeapOldExternal, "heap.old.external", kByte)        \
   V(MetricHeapNewUsed, HeapNewUsed, "heap.new.used", kByte)                    \
   V(MetricHeapNewCapacity, HeapNewCapacity, "heap.new.capacity", kByte)        \
-  V(MetricHeapNewExternal, HeapNewExternal, "heap.new.external", kByte)
+  V(MetricHeapNewExternal, HeapNewExternal, "heap.new.external", kByte)        \
+  V(MetricHeapNewAllocated, HeapNewAllocated, "heap.new.allocated", kByte)     \
+  V(MetricHeapOldAllocated, HeapOldAllocated, "heap.old.allocated", kByte)     \
+  V(MetricHeapCodeCapacity, HeapCodeCapacity, "heap.code.capacity", kByte)     \
+  V(MetricGCNewTime, GCNewTime, "gc.new.time", kMicrosecond)                   \
+  V(MetricGCOldTime, GCOldTime, "gc.old.time", kMicrosecond)                   \
+  V(PercentileMetric, SafepointTimeP99, "safepoint.time.p99", kMicrosecond)    \
+  V(MetricMessageQueueLength, MessageQueueLength, "isolate.messages.queued",   \
+    kCounter)                                                                  \
+  V(MetricMessageQueueAge, MessageQueueAge, "isolate.messages.age",            \
+    kMicrosecond)                                                              \
+  V(MetricCompilerQueueLength, CompilerQueueLength, "compiler.queue.length",   \
+    kCounter)
 
 #define ISOLATE_GROUP_METRIC_LIST(V)                                           \
   DART_API_ISOLATE_GROUP_METRIC_LIST(V)                                        \
@@ -40,6 +57,8 @@ class JSONStream;
   V(MaxMetric, HeapOldCapacityMax, "heap.old.capacity.max", kByte)             \
   V(MaxMetric, HeapNewUsedMax, "heap.new.used.max", kByte)                     \
   V(MaxMetric, HeapNewCapacityMax, "heap.new.capacity.max", kByte)             \
+  V(MetricHeapOldReleased, HeapOldReleased, "heap.old.released", kByte)        \
+  V(MetricHeapOldResident, HeapOldResident, "heap.old.resident", kByte)        \
   V(MetricHeapUsed, HeapGlobalUsed, "heap.global.used", kByte)                 \
   V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)
 
@@ -141,6 +160,23 @@ class MinMetric : public Metric {
   void SetValue(int64_t new_value);
 };
 
+// A Metric class that reports an estimate of the 99th percentile of the
+// recorded values. Values are counted in power-of-two buckets, and the upper
+// bound of the bucket holding the percentile is reported.
+class PercentileMetric : public Metric {
+ public:
+  PercentileMetric();
+
+  void Record(int64_t value);
+
+  virtual int64_t Value() const;
+
+ private:
+  static constexpr intptr_t kNumBuckets = 64;
+  RelaxedAtomic<int64_t> buckets_[kNumBuckets];
+  RelaxedAtomic<int64_t> count_;
+};
+
 class MetricHeapOldUsed : public Metric {
  public:
   virtual int64_t Value() const;
@@ -171,6 +207,49 @@ class MetricHeapNewExternal : public Metric {
   virtual int64_t Value() const;
 };
 
+class MetricHeapNewAllocated : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+class MetricHeapOldAllocated : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+class MetricHeapCodeCapacity : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+class MetricGCNewTime : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+class MetricGCOldTime : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+// Summed over the isolates of the group.
+class MetricMessageQueueLength : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+// The age of the oldest message waiting in any isolate of the group.
+class MetricMessageQueueAge : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+// The number of functions waiting for the background compiler.
+class MetricCompilerQueueLength : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
 class MetricIsolateCount : public Metric {
  public:
   virtual int64_t Value() const;
@@ -191,6 +270,19 @@ class MetricHeapUsed : public Metric {
   virtual int64_t Value() const;
 };
 
+// Old-space capacity returned to the OS by the last sweep while the pages
+// holding it stay committed.
+class MetricHeapOldReleased : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+// Old-space capacity minus the part returned to the OS.
+class MetricHeapOldResident : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_METRICS_H_
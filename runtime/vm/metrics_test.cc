@@ -111,7 +111,31 @@ ISOLATE_UNIT_TEST_CASE(Metric_EmbedderAPI) {
     EXPECT(Dart_IsolateGroupHeapOldCapacityMetric(isolate_group) > 0);
     EXPECT(Dart_IsolateGroupHeapNewUsedMetric(isolate_group) > 0);
     EXPECT(Dart_IsolateGroupHeapNewCapacityMetric(isolate_group) > 0);
+    EXPECT(Dart_IsolateGroupHeapNewAllocatedMetric(isolate_group) > 0);
+    EXPECT(Dart_IsolateGroupHeapOldAllocatedMetric(isolate_group) > 0);
+    EXPECT(Dart_IsolateGroupGCNewTimeMetric(isolate_group) >= 0);
+    EXPECT(Dart_IsolateGroupGCOldTimeMetric(isolate_group) >= 0);
+    EXPECT_EQ(0, Dart_IsolateGroupMessageQueueLengthMetric(isolate_group));
+    EXPECT_EQ(0, Dart_IsolateGroupMessageQueueAgeMetric(isolate_group));
+    EXPECT(Dart_IsolateGroupCompilerQueueLengthMetric(isolate_group) >= 0);
   }
 }
 
+VM_UNIT_TEST_CASE(Metric_Percentile) {
+  PercentileMetric metric;
+  EXPECT_EQ(0, metric.Value());
+  for (intptr_t i = 0; i < 99; i++) {
+    metric.Record(3);
+  }
+  // [2, 4)
+  EXPECT_EQ(3, metric.Value());
+  metric.Record(1000);
+  EXPECT_EQ(3, metric.Value());
+  metric.Record(1000);
+  // [512, 1024)
+  EXPECT_EQ(1023, metric.Value());
+  metric.Record(-1);
+  EXPECT_EQ(1023, metric.Value());
+}
+
 }  // namespace dart
@@ -64,6 +64,14 @@ class DartApiCallScope : public ValueObject {
   }
 
 static bool PostCObjectHelper(Dart_Port port_id, Dart_CObject* message) {
+  // Flat values are posted as raw objects, which need neither a snapshot
+  // buffer nor deserialization on the receiving side.
+  const ObjectPtr raw_obj = ApiObjectConverter::ConvertBack(message);
+  if (raw_obj != Object::sentinel().ptr()) {
+    return PortMap::PostMessage(
+        Message::New(port_id, raw_obj, Message::kNormalPriority));
+  }
+
   AllocOnlyStackZone zone;
   std::unique_ptr<Message> msg = WriteApiMessage(
       zone.GetZone(), message, port_id, Message::kNormalPriority);
@@ -91,6 +99,12 @@ DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message) {
   return PostCObjectHelper(port_id, &cobj);
 }
 
+DART_EXPORT bool Dart_SetPortLane(Dart_Port port_id,
+                                  bool control,
+                                  bool coalescing) {
+  return PortMap::SetPortLane(port_id, control, coalescing);
+}
+
 DART_EXPORT Dart_Port Dart_NewNativePort(const char* name,
                                          Dart_NativeMessageHandler handler,
                                          bool handle_concurrently) {
@@ -40,6 +40,7 @@
 #include "vm/exceptions.h"
 #include "vm/growable_array.h"
 #include "vm/hash.h"
+#include "vm/hash_map.h"
 #include "vm/hash_table.h"
 #include "vm/heap/become.h"
 #include "vm/heap/heap.h"
@@ -2877,6 +2878,10 @@ ObjectPtr Object::Allocate(intptr_t cls_id,
   ASSERT(thread->no_safepoint_scope_depth() == 0);
   ASSERT(thread->no_callback_scope_depth() == 0);
   Heap* heap = thread->heap();
+  if ((space == Heap::kNew) &&
+      UNLIKELY(heap->new_space()->ShouldPretenure(cls_id))) {
+    space = Heap::kOld;
+  }
 
   uword address = heap->Allocate(thread, size, space);
   if (UNLIKELY(address == 0)) {
@@ -2915,10 +2920,21 @@ ObjectPtr Object::Allocate(intptr_t cls_id,
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
   HeapProfileSampler& heap_sampler = thread->heap_sampler();
   if (heap_sampler.HasOutstandingSample()) {
+    const intptr_t sampled_bytes = heap_sampler.last_sample_size();
     thread->IncrementNoCallbackScopeDepth();
     void* data = heap_sampler.InvokeCallbackForLastSample(cls_id);
-    heap->SetHeapSamplingData(raw_obj, data);
+    if (data != nullptr) {
+      heap->SetHeapSamplingData(raw_obj, data);
+    }
     thread->DecrementNoCallbackScopeDepth();
+    if (HeapProfileSampler::allocation_profile_enabled()) {
+      heap->SetSampledAllocationBytes(raw_obj, sampled_bytes);
+#if !defined(PRODUCT)
+      uint32_t hash =
+          HeapSnapshotWriter::GetHeapSnapshotIdentityHash(thread, raw_obj);
+      Profiler::SampleAllocation(thread, cls_id, hash, sampled_bytes);
+#endif  // !defined(PRODUCT)
+    }
   }
 #endif  // !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
 
@@ -3870,54 +3886,75 @@ UnboxedFieldBitmap Class::CalculateFieldOffsets() const {
                                   target_type_args_field_offset);
   ASSERT(host_offset > 0);
   ASSERT(target_offset > 0);
-  Field& field = Field::Handle();
-  const intptr_t len = flds.Length();
-  for (intptr_t i = 0; i < len; i++) {
-    field ^= flds.At(i);
-    // Offset is computed only for instance fields.
-    if (!field.is_static()) {
-      ASSERT(field.HostOffset() == 0);
-      ASSERT(field.TargetOffset() == 0);
-      field.SetOffset(host_offset, target_offset);
-
-      if (field.is_unboxed()) {
-        const intptr_t field_size =
-            UnboxedFieldSizeInBytesByCid(field.guarded_cid());
-
-        const intptr_t host_num_words = field_size / kCompressedWordSize;
-        const intptr_t host_next_offset = host_offset + field_size;
-        const intptr_t host_next_position =
-            host_next_offset / kCompressedWordSize;
-
-        const intptr_t target_next_offset = target_offset + field_size;
-        const intptr_t target_next_position =
-            target_next_offset / compiler::target::kCompressedWordSize;
-
-        // The bitmap has fixed length. Checks if the offset position is smaller
-        // than its length. If it is not, than the field should be boxed
-        if (host_next_position <= UnboxedFieldBitmap::Length() &&
-            target_next_position <= UnboxedFieldBitmap::Length()) {
-          for (intptr_t j = 0; j < host_num_words; j++) {
-            // Activate the respective bit in the bitmap, indicating that the
-            // content is not a pointer
-            host_bitmap.Set(host_offset / kCompressedWordSize);
-            host_offset += kCompressedWordSize;
-          }
-
-          ASSERT(host_offset == host_next_offset);
-          target_offset = target_next_offset;
-        } else {
-          // Make the field boxed
-          field.set_is_unboxed(false);
+  auto assign_offset = [&](const Field& field) {
+    ASSERT(!field.is_static());
+    ASSERT(field.HostOffset() == 0);
+    ASSERT(field.TargetOffset() == 0);
+    field.SetOffset(host_offset, target_offset);
+
+    if (field.is_unboxed()) {
+      const intptr_t field_size =
+          UnboxedFieldSizeInBytesByCid(field.guarded_cid());
+
+      const intptr_t host_num_words = field_size / kCompressedWordSize;
+      const intptr_t host_next_offset = host_offset + field_size;
+      const intptr_t host_next_position =
+          host_next_offset / kCompressedWordSize;
+
+      const intptr_t target_next_offset = target_offset + field_size;
+      const intptr_t target_next_position =
+          target_next_offset / compiler::target::kCompressedWordSize;
+
+      // The bitmap has fixed length. Checks if the offset position is smaller
+      // than its length. If it is not, than the field should be boxed
+      if (host_next_position <= UnboxedFieldBitmap::Length() &&
+          target_next_position <= UnboxedFieldBitmap::Length()) {
+        for (intptr_t j = 0; j < host_num_words; j++) {
+          // Activate the respective bit in the bitmap, indicating that the
+          // content is not a pointer
+          host_bitmap.Set(host_offset / kCompressedWordSize);
           host_offset += kCompressedWordSize;
-          target_offset += compiler::target::kCompressedWordSize;
         }
+
+        ASSERT(host_offset == host_next_offset);
+        target_offset = target_next_offset;
       } else {
+        // Make the field boxed
+        field.set_is_unboxed(false);
         host_offset += kCompressedWordSize;
         target_offset += compiler::target::kCompressedWordSize;
       }
+    } else {
+      host_offset += kCompressedWordSize;
+      target_offset += compiler::target::kCompressedWordSize;
+    }
+  };
+
+  Field& field = Field::Handle();
+  const intptr_t len = flds.Length();
+  // In AOT, unboxed fields are laid out before the other fields of a class, so
+  // that as many of them as possible fit into the unboxed fields bitmap and do
+  // not need to be boxed. Classes of dart: libraries keep the declaration
+  // order, which the VM relies on for some of them.
+  const Library& lib = Library::Handle(library());
+  const bool unboxed_fields_first =
+      FLAG_precompiled_mode && !lib.IsNull() && !lib.is_dart_scheme();
+  if (unboxed_fields_first) {
+    for (intptr_t i = 0; i < len; i++) {
+      field ^= flds.At(i);
+      if (!field.is_static() && field.is_unboxed()) {
+        assign_offset(field);
+      }
     }
   }
+  for (intptr_t i = 0; i < len; i++) {
+    field ^= flds.At(i);
+    // Offset is computed only for instance fields.
+    if (field.is_static()) continue;
+    // Skip unboxed fields which were already laid out above.
+    if (unboxed_fields_first && field.HostOffset() != 0) continue;
+    assign_offset(field);
+  }
 
   const intptr_t host_instance_size = RoundedAllocationSize(host_offset);
   const intptr_t target_instance_size =
@@ -7499,6 +7536,21 @@ TypeArgumentsPtr TypeArguments::Cache::Retrieve(intptr_t entry) const {
   return table.At(entry).Get<kInstantiatedTypeArgsIndex>();
 }
 
+TypeArgumentsPtr TypeArguments::Cache::RetrieveInstantiatorTypeArguments(
+    intptr_t entry) const {
+  ASSERT(IsOccupied(entry));
+  InstantiationsCacheTable table(data_);
+  return TypeArguments::RawCast(
+      table.At(entry).Get<kInstantiatorTypeArgsIndex>());
+}
+
+TypeArgumentsPtr TypeArguments::Cache::RetrieveFunctionTypeArguments(
+    intptr_t entry) const {
+  ASSERT(IsOccupied(entry));
+  InstantiationsCacheTable table(data_);
+  return table.At(entry).Get<kFunctionTypeArgsIndex>();
+}
+
 intptr_t TypeArguments::Cache::NumEntries(const Array& array) {
   InstantiationsCacheTable table(array);
   return table.Length();
@@ -7545,6 +7597,42 @@ TypeArguments::Cache::KeyLocation TypeArguments::Cache::FindKeyOrUnused(
   return {probe, false};
 }
 
+bool TypeArguments::Cache::LookupUnlocked(const Array& array,
+                                          const TypeArguments& instantiator_tav,
+                                          const TypeArguments& function_tav,
+                                          TypeArguments* instantiated_tav) {
+  // Same probing as in FindKeyOrUnused, but the sentinel position of each
+  // entry is loaded with acquire semantics to pair with the store-release in
+  // AddEntry, like the InstantiateTypeArguments stub does.
+  const bool is_hash = IsHash(array);
+  InstantiationsCacheTable table(array);
+  const intptr_t num_entries = table.Length();
+  intptr_t probe = 0;
+  intptr_t probe_distance = 1;
+  if (is_hash) {
+    auto hash = FinalizeHash(
+        CombineHashes(instantiator_tav.Hash(), function_tav.Hash()));
+    probe = hash & (num_entries - 1);
+  }
+  while (true) {
+    const auto& tuple = table.At(probe);
+    const ObjectPtr key =
+        tuple.Get<kInstantiatorTypeArgsIndex, std::memory_order_acquire>();
+    if (key == Sentinel()) break;
+    if ((key == instantiator_tav.ptr()) &&
+        (tuple.Get<kFunctionTypeArgsIndex>() == function_tav.ptr())) {
+      *instantiated_tav = tuple.Get<kInstantiatedTypeArgsIndex>();
+      return true;
+    }
+    probe = probe + probe_distance;
+    if (is_hash) {
+      probe = probe & (num_entries - 1);
+      probe_distance++;
+    }
+  }
+  return false;
+}
+
 TypeArguments::Cache::KeyLocation TypeArguments::Cache::AddEntry(
     intptr_t entry,
     const TypeArguments& instantiator_tav,
@@ -8056,6 +8144,22 @@ TypeArgumentsPtr TypeArguments::InstantiateAndCanonicalizeFrom(
     const TypeArguments& function_type_arguments) const {
   auto thread = Thread::Current();
   auto zone = thread->zone();
+#if !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
+  const bool lookup_unlocked = !TESTING_runtime_fail_on_existing_cache_entry;
+#else
+  const bool lookup_unlocked = true;
+#endif
+  if (lookup_unlocked) {
+    // Most instantiations are found in the cache, which is shared by all
+    // isolates of the group. Look there first without contending for the
+    // mutex, which is only needed to add entries.
+    const Array& data = Array::Handle(zone, instantiations());
+    TypeArguments& result = TypeArguments::Handle(zone);
+    if (Cache::LookupUnlocked(data, instantiator_type_arguments,
+                              function_type_arguments, &result)) {
+      return result.ptr();
+    }
+  }
   SafepointMutexLocker ml(
       thread->isolate_group()->type_arguments_canonicalization_mutex());
 
@@ -14916,6 +15020,51 @@ static ObjectPtr InvokeInstanceFunction(
   return DartEntry::InvokeFunction(function, args, args_descriptor_array);
 }
 
+// The number of entries of the per-isolate cache used by
+// ResolveDynamicForReflection. Each entry is a (class, name, function) triple.
+static constexpr intptr_t kReflectiveLookupCacheEntries = 64;
+
+// Like Resolver::ResolveDynamicAnyArgs, but remembers the functions found for
+// the most recent classes and names in a direct mapped cache of the current
+// isolate. Reflective invocations through dart:mirrors and the embedding API
+// tend to look up the same few members over and over, and resolving them
+// walks the class hierarchy by name. The cache is dropped on reload, as the
+// results may change then.
+static FunctionPtr ResolveDynamicForReflection(Thread* thread,
+                                               const Class& klass,
+                                               const String& name) {
+  Zone* zone = thread->zone();
+  if (thread->isolate() == nullptr) {
+    return Resolver::ResolveDynamicAnyArgs(
+        zone, klass, name, /*allow_add=*/!FLAG_precompiled_mode);
+  }
+  auto object_store = thread->isolate()->isolate_object_store();
+  Array& cache = Array::Handle(zone, object_store->reflective_lookup_cache());
+  if (cache.IsNull()) {
+    cache = Array::New(kReflectiveLookupCacheEntries * 3, Heap::kOld);
+    object_store->set_reflective_lookup_cache(cache);
+  }
+  const intptr_t index =
+      3 * (FinalizeHash(CombineHashes(klass.id(), name.Hash())) &
+           (kReflectiveLookupCacheEntries - 1));
+  if (cache.At(index) == klass.ptr()) {
+    const String& cached_name =
+        String::Handle(zone, String::RawCast(cache.At(index + 1)));
+    if (cached_name.Equals(name)) {
+      return Function::RawCast(cache.At(index + 2));
+    }
+  }
+  // Failed lookups are cached as well, as Instance::Invoke looks for a getter
+  // returning a closure after failing to find a method.
+  const Function& function = Function::Handle(
+      zone, Resolver::ResolveDynamicAnyArgs(
+                zone, klass, name, /*allow_add=*/!FLAG_precompiled_mode));
+  cache.SetAt(index, klass);
+  cache.SetAt(index + 1, name);
+  cache.SetAt(index + 2, function);
+  return function.ptr();
+}
+
 static bool IsLookupOfMainFunctionInRootLibrary(const Library& lib,
                                                 const String& name) {
   return name.Equals(Symbols::main()) &&
@@ -16147,6 +16296,29 @@ intptr_t InstructionsTable::FindEntry(InstructionsTablePtr table,
   const auto entries = rodata->entries();
   intptr_t lo = start_index;
   intptr_t hi = rodata->length - 1;
+  if (rodata->lookup_index_offset != 0) {
+    // Narrow down the search to the entries overlapping the sub-page
+    // containing |pc_offset|.
+    using Table = UntaggedInstructionsTable;
+    const auto index = rodata->lookup_index();
+    const uword page = pc_offset >> Table::kLookupPageSizeLog2;
+    if (page < index->length) {
+      const auto& lookup = index->pages()[page];
+      const intptr_t sub_page = (pc_offset >> Table::kLookupSubPageSizeLog2) &
+                                (Table::kLookupSubPages - 1);
+      lo = Utils::Maximum<intptr_t>(
+          lo, lookup.first_entry + lookup.sub_page_delta[sub_page]);
+      if ((sub_page + 1 < Table::kLookupSubPages) &&
+          (lookup.sub_page_delta[sub_page + 1] != Table::kMaxLookupDelta)) {
+        hi = lookup.first_entry + lookup.sub_page_delta[sub_page + 1];
+      } else if (page + 1 < index->length) {
+        hi = index->pages()[page + 1].first_entry;
+      }
+    } else {
+      // Past the start of the last entry.
+      lo = Utils::Maximum<intptr_t>(lo, hi);
+    }
+  }
   while (lo <= hi) {
     intptr_t mid = (hi - lo + 1) / 2 + lo;
     ASSERT(mid >= lo);
@@ -18709,6 +18881,7 @@ CodePtr Code::FinalizeCode(FlowGraphCompiler* compiler,
     // pushed onto the stack.
     code.SetPrologueOffset(assembler->CodeSize());
   }
+  CodeLookupTable::CodeInstalled(thread, code);
 #endif
   return code.ptr();
 }
@@ -18752,7 +18925,7 @@ void Code::NotifyCodeObservers(const char* name,
     const auto& instrs = Instructions::Handle(code.instructions());
     CodeObservers::NotifyAll(name, instrs.PayloadStart(),
                              code.GetPrologueOffset(), instrs.Size(), optimized,
-                             &code.comments());
+                             &code.comments(), code);
   }
 #endif
 }
@@ -19615,21 +19788,40 @@ void MegamorphicCache::InsertLocked(const Smi& class_id,
   // load-acquire barriers on the reader, ...
   isolate_group->RunWithStoppedMutators(
       [&]() {
-        EnsureCapacityLocked();
+        EnsureCapacityLocked(class_id);
         InsertEntryLocked(class_id, target);
       },
       /*use_force_growth=*/true);
 }
 
-void MegamorphicCache::EnsureCapacityLocked() const {
+intptr_t MegamorphicCache::ProbeLengthLocked(const Smi& class_id) const {
+  const Array& backing_array = Array::Handle(buckets());
+  const intptr_t id_mask = mask();
+  intptr_t i = (class_id.Value() * kSpreadFactor) & id_mask;
+  intptr_t length = 1;
+  while (Smi::Value(Smi::RawCast(GetClassId(backing_array, i))) !=
+         kIllegalCid) {
+    i = (i + 1) & id_mask;
+    length++;
+  }
+  return length;
+}
+
+void MegamorphicCache::EnsureCapacityLocked(const Smi& class_id) const {
   auto thread = Thread::Current();
   auto zone = thread->zone();
   auto isolate_group = thread->isolate_group();
   ASSERT(isolate_group->type_feedback_mutex()->IsOwnedByCurrentThread());
 
   intptr_t old_capacity = mask() + 1;
-  double load_limit = kLoadFactor * static_cast<double>(old_capacity);
-  if (static_cast<double>(filled_entry_count() + 1) > load_limit) {
+  const double new_count = static_cast<double>(filled_entry_count() + 1);
+  const double capacity = static_cast<double>(old_capacity);
+  // Inserting [class_id] displaces entries at most up to the end of its probe
+  // sequence.
+  const bool needs_shorter_probes =
+      new_count > kMinLoadFactor * capacity &&
+      ProbeLengthLocked(class_id) > kMaxProbeLength;
+  if (new_count > kLoadFactor * capacity || needs_shorter_probes) {
     const Array& old_buckets = Array::Handle(zone, buckets());
     intptr_t new_capacity = old_capacity * 2;
     const Array& new_buckets =
@@ -19664,18 +19856,39 @@ void MegamorphicCache::InsertEntryLocked(const Smi& class_id,
   ASSERT(Thread::Current()->IsDartMutatorThread());
   ASSERT(static_cast<double>(filled_entry_count() + 1) <=
          (kLoadFactor * static_cast<double>(mask() + 1)));
-  const Array& backing_array = Array::Handle(buckets());
+  auto zone = thread->zone();
+  const Array& backing_array = Array::Handle(zone, buckets());
   intptr_t id_mask = mask();
-  intptr_t index = (class_id.Value() * kSpreadFactor) & id_mask;
-  intptr_t i = index;
-  do {
-    if (Smi::Value(Smi::RawCast(GetClassId(backing_array, i))) == kIllegalCid) {
-      SetEntry(backing_array, i, class_id, target);
+
+  // Robin Hood insertion: an entry takes over the place of an entry which is
+  // closer to its home entry, which is then moved further. This keeps the
+  // probe sequences of all entries similarly short. Entries are never moved
+  // across an empty entry, so lookups can still stop at the first one.
+  auto& current_cid = Smi::Handle(zone, class_id.ptr());
+  auto& current_target = Object::Handle(zone, target.ptr());
+  auto& resident_cid = Smi::Handle(zone);
+  auto& resident_target = Object::Handle(zone);
+  intptr_t distance = 0;
+  intptr_t i = (current_cid.Value() * kSpreadFactor) & id_mask;
+  for (intptr_t probes = 0; probes <= id_mask; probes++) {
+    resident_cid ^= GetClassId(backing_array, i);
+    if (resident_cid.Value() == kIllegalCid) {
+      SetEntry(backing_array, i, current_cid, current_target);
       set_filled_entry_count(filled_entry_count() + 1);
       return;
     }
+    const intptr_t resident_distance =
+        (i - ((resident_cid.Value() * kSpreadFactor) & id_mask)) & id_mask;
+    if (resident_distance < distance) {
+      resident_target = GetTargetFunction(backing_array, i);
+      SetEntry(backing_array, i, current_cid, current_target);
+      current_cid = resident_cid.ptr();
+      current_target = resident_target.ptr();
+      distance = resident_distance;
+    }
     i = (i + 1) & id_mask;
-  } while (i != index);
+    distance++;
+  }
   UNREACHABLE();
 }
 
@@ -20808,9 +21021,7 @@ ObjectPtr Instance::InvokeGetter(const String& getter_name,
   const String& internal_getter_name =
       String::Handle(zone, Field::GetterName(getter_name));
   Function& function = Function::Handle(
-      zone,
-      Resolver::ResolveDynamicAnyArgs(zone, klass, internal_getter_name,
-                                      /*allow_add=*/!FLAG_precompiled_mode));
+      zone, ResolveDynamicForReflection(thread, klass, internal_getter_name));
 
   // Check for method extraction when method extractors are not lazily created.
   if (function.IsNull() && FLAG_precompiled_mode) {
@@ -20858,9 +21069,7 @@ ObjectPtr Instance::InvokeSetter(const String& setter_name,
   const String& internal_setter_name =
       String::Handle(zone, Field::SetterName(setter_name));
   const Function& setter = Function::Handle(
-      zone,
-      Resolver::ResolveDynamicAnyArgs(zone, klass, internal_setter_name,
-                                      /*allow_add=*/!FLAG_precompiled_mode));
+      zone, ResolveDynamicForReflection(thread, klass, internal_setter_name));
 
   const int kTypeArgsLen = 0;
   const int kNumArgs = 2;
@@ -20888,9 +21097,7 @@ ObjectPtr Instance::Invoke(const String& function_name,
   CHECK_ERROR(klass.EnsureIsFinalized(thread));
 
   Function& function = Function::Handle(
-      zone,
-      Resolver::ResolveDynamicAnyArgs(zone, klass, function_name,
-                                      /*allow_add=*/!FLAG_precompiled_mode));
+      zone, ResolveDynamicForReflection(thread, klass, function_name));
 
   // We don't pass any explicit type arguments, which will be understood as
   // using dynamic for any function type arguments by lower layers.
@@ -20908,9 +21115,7 @@ ObjectPtr Instance::Invoke(const String& function_name,
     // Didn't find a method: try to find a getter and invoke call on its result.
     const String& getter_name =
         String::Handle(zone, Field::GetterName(function_name));
-    function =
-        Resolver::ResolveDynamicAnyArgs(zone, klass, getter_name,
-                                        /*allow_add=*/!FLAG_precompiled_mode);
+    function = ResolveDynamicForReflection(thread, klass, getter_name);
     if (!function.IsNull()) {
       ASSERT(function.kind() != UntaggedFunction::kMethodExtractor);
       // Invoke the getter.
@@ -24987,6 +25192,34 @@ OneByteStringPtr OneByteString::EscapeSpecialCharacters(const String& str) {
   return OneByteString::raw(Symbols::Empty());
 }
 
+intptr_t OneByteString::IndexOf(const String& str,
+                                const String& pattern,
+                                intptr_t start) {
+  ASSERT(str.IsOneByteString() && pattern.IsOneByteString());
+  ASSERT((start >= 0) && (start <= str.Length()));
+  const intptr_t pattern_length = pattern.Length();
+  ASSERT(pattern_length > 0);
+  if (str.Length() - start < pattern_length) {
+    return -1;
+  }
+  NoSafepointScope no_safepoint;
+  // memchr and memcmp are vectorized by the C library.
+  const uint8_t* const data = DataStart(str);
+  const uint8_t* const needle = DataStart(pattern);
+  const uint8_t* const last = data + str.Length() - pattern_length;
+  for (const uint8_t* current = data + start; current <= last; ++current) {
+    current = static_cast<const uint8_t*>(
+        memchr(current, needle[0], last - current + 1));
+    if (current == nullptr) {
+      return -1;
+    }
+    if (memcmp(current + 1, needle + 1, pattern_length - 1) == 0) {
+      return current - data;
+    }
+  }
+  return -1;
+}
+
 OneByteStringPtr OneByteString::New(intptr_t len, Heap::Space space) {
   ASSERT((IsolateGroup::Current() == Dart::vm_isolate_group()) ||
          ((IsolateGroup::Current()->object_store() != nullptr) &&
@@ -25457,6 +25690,35 @@ ArrayPtr Array::Slice(intptr_t start,
   return dest.ptr();
 }
 
+void Array::CopyFrom(intptr_t dst_start,
+                     const Array& src,
+                     intptr_t src_start,
+                     intptr_t count) const {
+  ASSERT(!IsImmutable());
+  ASSERT((dst_start >= 0) && (dst_start + count <= Length()));
+  ASSERT((src_start >= 0) && (src_start + count <= src.Length()));
+  Thread* thread = Thread::Current();
+  // Copy backwards if the ranges overlap and the destination comes later.
+  const bool backwards = (ptr() == src.ptr()) && (src_start < dst_start);
+  const intptr_t first = backwards ? count - 1 : 0;
+  const intptr_t step = backwards ? -1 : 1;
+  if (!UseCardMarkingForAllocation(Length())) {
+    NoSafepointScope no_safepoint(thread);
+    for (intptr_t n = 0, i = first; n < count; n++, i += step) {
+      untag()->set_element(dst_start + i, src.untag()->element(src_start + i),
+                           thread);
+    }
+  } else {
+    for (intptr_t n = 0, i = first; n < count; n++, i += step) {
+      untag()->set_element(dst_start + i, src.untag()->element(src_start + i),
+                           thread);
+      if (((n + 1) % kSlotsPerInterruptCheck) == 0) {
+        thread->CheckForSafepoint();
+      }
+    }
+  }
+}
+
 void Array::MakeImmutable() const {
   if (IsImmutable()) return;
   ASSERT(!IsCanonical());
@@ -26801,12 +27063,43 @@ static void PrintSymbolicStackFrameBody(BaseTextBuffer* buffer,
   buffer->Printf(")\n");
 }
 
+// Symbolic frames printed for a frame of a stack trace, so that repeated
+// frames, e.g. of recursive code, are only symbolized once per ToCString.
+class SymbolizedFrameKeyValueTrait {
+ public:
+  struct Key {
+    ObjectPtr code = nullptr;
+    uword pc_offset = 0;
+    bool expand_inlined = false;
+  };
+  struct Pair {
+    Key key;
+    // Range of the printed frame bodies.
+    intptr_t first_body = -1;
+    intptr_t num_bodies = 0;
+  };
+  typedef intptr_t Value;
+
+  static Key KeyOf(const Pair& kv) { return kv.key; }
+  static Value ValueOf(const Pair& kv) { return kv.first_body; }
+  static uword Hash(const Key& key) {
+    return CombineHashes(static_cast<uint32_t>(static_cast<uword>(key.code)),
+                         static_cast<uint32_t>(key.pc_offset));
+  }
+  static bool IsKeyEqual(const Pair& kv, const Key& key) {
+    return (kv.key.code == key.code) && (kv.key.pc_offset == key.pc_offset) &&
+           (kv.key.expand_inlined == key.expand_inlined);
+  }
+};
+
 static void PrintSymbolicStackFrame(Zone* zone,
                                     BaseTextBuffer* buffer,
                                     const Function& function,
                                     TokenPosition token_pos_or_line,
                                     intptr_t frame_index,
-                                    bool is_line = false) {
+                                    bool is_line = false,
+                                    GrowableArray<const char*>* bodies =
+                                        nullptr) {
   ASSERT(!function.IsNull());
   const auto& script = Script::Handle(zone, function.script());
   const char* function_name = function.QualifiedUserVisibleNameCString();
@@ -26832,7 +27125,12 @@ static void PrintSymbolicStackFrame(Zone* zone,
     script.GetTokenLocation(token_pos_or_line, &line, &column);
   }
   PrintSymbolicStackFrameIndex(buffer, frame_index);
+  const intptr_t body_start = buffer->length();
   PrintSymbolicStackFrameBody(buffer, function_name, url, line, column);
+  if (bodies != nullptr) {
+    bodies->Add(zone->MakeCopyOfStringN(buffer->buffer() + body_start,
+                                        buffer->length() - body_start));
+  }
 }
 
 static bool IsVisibleAsFutureListener(const Function& function) {
@@ -26903,6 +27201,8 @@ const char* StackTrace::ToCString() const {
 #endif
 
   ZoneTextBuffer buffer(zone, 1024);
+  DirectChainedHashMap<SymbolizedFrameKeyValueTrait> symbolized_frames;
+  GrowableArray<const char*> frame_bodies;
 
 #if defined(DART_PRECOMPILED_RUNTIME)
   auto const isolate_instructions = reinterpret_cast<uword>(
@@ -27067,6 +27367,18 @@ const char* StackTrace::ToCString() const {
       }
 #endif
 
+      const SymbolizedFrameKeyValueTrait::Key key = {
+          code.ptr(), pc_offset, stack_trace.expand_inlined()};
+      if (auto const symbolized = symbolized_frames.Lookup(key)) {
+        for (intptr_t j = 0; j < symbolized->num_bodies; j++) {
+          PrintSymbolicStackFrameIndex(&buffer, frame_index);
+          buffer.AddString(frame_bodies[symbolized->first_body + j]);
+          frame_index++;
+        }
+        continue;
+      }
+      const intptr_t first_body = frame_bodies.length();
+
       if (code.is_optimized() && stack_trace.expand_inlined() &&
           (FLAG_precompiled_mode || !is_future_listener)) {
         // Note: In AOT mode EmitFunctionEntrySourcePositionDescriptorIfNeeded
@@ -27084,20 +27396,21 @@ const char* StackTrace::ToCString() const {
           }
           if (FLAG_show_invisible_frames || function.is_visible()) {
             PrintSymbolicStackFrame(zone, &buffer, function, pos, frame_index,
-                                    /*is_line=*/FLAG_precompiled_mode);
+                                    /*is_line=*/FLAG_precompiled_mode,
+                                    &frame_bodies);
             frame_index++;
           }
         }
-        continue;
-      }
-
-      if (FLAG_show_invisible_frames || function.is_visible() ||
-          (is_future_listener && IsVisibleAsFutureListener(function))) {
+      } else if (FLAG_show_invisible_frames || function.is_visible() ||
+                 (is_future_listener && IsVisibleAsFutureListener(function))) {
         auto const pos = is_future_listener ? function.token_pos()
                                             : code.GetTokenIndexOfPC(pc);
-        PrintSymbolicStackFrame(zone, &buffer, function, pos, frame_index);
+        PrintSymbolicStackFrame(zone, &buffer, function, pos, frame_index,
+                                /*is_line=*/false, &frame_bodies);
         frame_index++;
       }
+      symbolized_frames.Insert(
+          {key, first_body, frame_bodies.length() - first_body});
     }
 
     // Follow the link.
@@ -27294,6 +27607,10 @@ void RegExp::set_capture_name_map(const Array& array) const {
   untag()->set_capture_name_map(array.ptr());
 }
 
+void RegExp::set_literal_prefix(const String& value) const {
+  untag()->set_literal_prefix(value.ptr());
+}
+
 RegExpPtr RegExp::New(Zone* zone, Heap::Space space) {
   const auto& result = RegExp::Handle(Object::Allocate<RegExp>(space));
   ASSERT_EQUAL(result.type(), kUninitialized);
@@ -2514,7 +2514,11 @@ class ICData : public CallSiteData {
     kHoisted = 1 << 0,
 
     // Deoptimization is caused by an optimistically generalized bounds check.
-    kGeneralized = 1 << 1
+    kGeneralized = 1 << 1,
+
+    // Deoptimization is caused by a guard on type arguments which were
+    // speculatively replaced with the ones observed in unoptimized code.
+    kSpeculativeTypeArguments = 1 << 2
   };
 
   bool HasDeoptReasons() const { return DeoptReasons() != 0; }
@@ -4122,14 +4126,20 @@ class Function : public Object {
 // a hoisted instruction.
 // 'ProhibitsBoundsCheckGeneralization' is true if this function deoptimized
 // before on a generalized bounds check.
+// 'ProhibitsTypeArgumentsSpeculation' is true if this function deoptimized
+// before on a guard of speculatively specialized type arguments.
 // IsDynamicallyOverridden: This function can be overridden in a dynamically
 //                          loaded class.
+// 'WasQuickOptimized' is true if this function was optimized by the quick
+// tier of the JIT, after which it is always optimized with the full pipeline.
 #define STATE_BITS_LIST(V)                                                     \
   V(WasCompiled)                                                               \
   V(WasExecutedBit)                                                            \
   V(ProhibitsInstructionHoisting)                                              \
   V(ProhibitsBoundsCheckGeneralization)                                        \
-  V(IsDynamicallyOverridden)
+  V(ProhibitsTypeArgumentsSpeculation)                                         \
+  V(IsDynamicallyOverridden)                                                   \
+  V(WasQuickOptimized)
 
   enum StateBits {
 #define DECLARE_FLAG_POS(Name) k##Name##Pos,
@@ -5646,6 +5656,12 @@ class ObjectPool : public Object {
     ASSERT((TypeAt(index) == EntryType::kTaggedObject) ||
            (TypeAt(index) == EntryType::kImmediate && obj.IsSmi()));
     StorePointer<ObjectPtr, order>(&EntryAddr(index)->raw_obj_, obj.ptr());
+#if defined(DART_PRECOMPILED_RUNTIME)
+    Page* page = Page::Of(ptr());
+    if (UNLIKELY(page->has_dirty_cards())) {
+      page->RememberDirtyCard(&EntryAddr(index)->raw_obj_);
+    }
+#endif
   }
 
   uword RawValueAt(intptr_t index) const {
@@ -6403,7 +6419,8 @@ class CompressedStackMaps : public Object {
           current_pc_offset_(it.current_pc_offset_),
           current_global_table_offset_(it.current_global_table_offset_),
           current_spill_slot_bit_count_(it.current_spill_slot_bit_count_),
-          current_non_spill_slot_bit_count_(it.current_spill_slot_bit_count_),
+          current_non_spill_slot_bit_count_(
+              it.current_non_spill_slot_bit_count_),
           current_bits_offset_(it.current_bits_offset_) {}
 
     // Loads the next entry from [maps_], if any. If [maps_] is the null value,
@@ -6502,6 +6519,13 @@ class CompressedStackMaps : public Object {
       return (bits_container_.data()[byte_offset] & byte_mask) != 0;
     }
 
+    // Returns the start of the bits of the loaded entry, which are only valid
+    // while the payload does not move.
+    const uint8_t* Bits() const {
+      EnsureFullyLoadedEntry();
+      return bits_container_.data() + current_bits_offset_;
+    }
+
    private:
     bool HasLoadedEntry() const { return next_offset_ > 0; }
 
@@ -7701,6 +7725,13 @@ class MegamorphicCache : public CallSiteData {
   static constexpr intptr_t kInitialCapacity = 16;
   static constexpr intptr_t kSpreadFactor = 7;
   static constexpr double kLoadFactor = 0.50;
+  // The cache also grows if inserting an entry would make the probe sequence
+  // of some entry longer than this, which keeps lookups of call sites with
+  // many receiver classes within one or two cache lines. To bound the size
+  // of caches with badly distributed class ids, this only applies while the
+  // load is above kMinLoadFactor.
+  static constexpr intptr_t kMaxProbeLength = 8;
+  static constexpr double kMinLoadFactor = 0.25;
 
   enum EntryType {
     kClassIdIndex,
@@ -7746,9 +7777,13 @@ class MegamorphicCache : public CallSiteData {
 
   // The caller must hold IsolateGroup::type_feedback_mutex().
   void InsertLocked(const Smi& class_id, const Object& target) const;
-  void EnsureCapacityLocked() const;
+  void EnsureCapacityLocked(const Smi& class_id) const;
   ObjectPtr LookupLocked(const Smi& class_id) const;
 
+  // Returns the length of the probe sequence which ends at the first empty
+  // entry after the home entry of [class_id].
+  intptr_t ProbeLengthLocked(const Smi& class_id) const;
+
   void InsertEntryLocked(const Smi& class_id, const Object& target) const;
 
   static inline void SetEntry(const Array& array,
@@ -8964,9 +8999,25 @@ class TypeArguments : public Instance {
     // Returns whether the entry at the given index in the cache is occupied.
     bool IsOccupied(intptr_t entry) const;
 
+    // If the cache backed by [array] has an entry for the given instantiator
+    // and function type arguments, sets [instantiated_tav] to its instantiated
+    // TypeArguments and returns true. Otherwise returns false.
+    //
+    // Does not require the type arguments canonicalization mutex, as entries
+    // are published with store-release barriers and never removed.
+    static bool LookupUnlocked(const Array& array,
+                               const TypeArguments& instantiator_tav,
+                               const TypeArguments& function_tav,
+                               TypeArguments* instantiated_tav);
+
     // Given an occupied entry index, returns the instantiated TypeArguments.
     TypeArgumentsPtr Retrieve(intptr_t entry) const;
 
+    // Given an occupied entry index, returns the instantiator and function
+    // type arguments the instantiation was computed from.
+    TypeArgumentsPtr RetrieveInstantiatorTypeArguments(intptr_t entry) const;
+    TypeArgumentsPtr RetrieveFunctionTypeArguments(intptr_t entry) const;
+
     // Adds a new instantiation mapping to the cache at index [entry]. Assumes
     // that the entry at index [entry] is unoccupied.
     //
@@ -10603,6 +10654,11 @@ class OneByteString : public AllStatic {
     *CharAddr(str, index) = code_unit;
   }
   static OneByteStringPtr EscapeSpecialCharacters(const String& str);
+  // Returns the index of the first occurrence of the non-empty one-byte
+  // [pattern] in [str] at or after [start], or -1 if there is none.
+  static intptr_t IndexOf(const String& str,
+                          const String& pattern,
+                          intptr_t start);
   // We use the same maximum elements for all strings.
   static constexpr intptr_t kBytesPerElement = 1;
   static constexpr intptr_t kMaxElements = String::kMaxElements;
@@ -10888,8 +10944,11 @@ class Array : public Instance {
   // WB invariant restoration code only applies to arrives which have at most
   // this many elements. Consequently WB elimination code should not eliminate
   // WB on arrays of larger lengths across instructions that can cause GC.
+  // The limit keeps the work added to the remembered set by a promoted array
+  // within a few cards, while still covering the arrays typically filled in a
+  // loop right after their allocation.
   // Note: we also can't restore WB invariant for arrays which use card marking.
-  static constexpr intptr_t kMaxLengthForWriteBarrierElimination = 8;
+  static constexpr intptr_t kMaxLengthForWriteBarrierElimination = 256;
 
   intptr_t Length() const { return LengthOf(ptr()); }
   static intptr_t LengthOf(const ArrayPtr array) {
@@ -11061,6 +11120,14 @@ class Array : public Instance {
                                   bool unique = false);
 
   ArrayPtr Slice(intptr_t start, intptr_t count, bool with_type_argument) const;
+
+  // Copies |count| elements of |src| starting at |src_start| into this array
+  // starting at |dst_start|. The ranges may overlap if |src| is this array.
+  // Element types are not checked.
+  void CopyFrom(intptr_t dst_start,
+                const Array& src,
+                intptr_t src_start,
+                intptr_t count) const;
   ArrayPtr Copy() const {
     return Slice(0, Length(), /*with_type_argument=*/true);
   }
@@ -12862,6 +12929,7 @@ class RegExp : public Instance {
     return untag()->num_bracket_expressions_;
   }
   ArrayPtr capture_name_map() const { return untag()->capture_name_map(); }
+  StringPtr literal_prefix() const { return untag()->literal_prefix(); }
 
   TypedDataPtr bytecode(bool is_one_byte, bool sticky) const {
     if (sticky) {
@@ -12927,6 +12995,7 @@ class RegExp : public Instance {
   void set_num_bracket_expressions(const Smi& value) const;
   void set_num_bracket_expressions(intptr_t value) const;
   void set_capture_name_map(const Array& array) const;
+  void set_literal_prefix(const String& value) const;
   void set_is_global() const {
     untag()->type_flags_.UpdateBool<GlobalBit>(true);
   }
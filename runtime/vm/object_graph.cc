@@ -1492,7 +1492,24 @@ void CallbackHeapSnapshotWriter::WriteChunk(uint8_t* buffer,
 
 void HeapSnapshotWriter::Write() {
   HeapIterationScope iteration(thread());
+  WriteLocked(&iteration);
+}
+
+intptr_t HeapSnapshotWriter::WriteInChildProcess() {
+  HeapIterationScope iteration(thread());
+  const intptr_t pid = OS::ForkProcess();
+  if (pid == 0) {
+    // Only this thread exists in the child, and the heap is frozen at the
+    // state it had when the parent entered the iteration scope. Mutators in
+    // the parent resume as soon as the scope is released; pages they write
+    // to from then on are copied by the kernel.
+    WriteLocked(&iteration);
+    OS::ExitImmediately(0);
+  }
+  return pid;
+}
 
+void HeapSnapshotWriter::WriteLocked(HeapIterationScope* iteration) {
   WriteBytes("dartheap", 8);  // Magic value.
   WriteUnsigned(0);           // Flags.
   WriteUtf8(isolate()->name());
@@ -1527,7 +1544,7 @@ void HeapSnapshotWriter::Write() {
     }
     {
       CollectStaticFieldNames visitor(field_table_size, field_table_names);
-      iteration.IterateObjects(&visitor);
+      iteration->IterateObjects(&visitor);
     }
 
     WriteUnsigned(class_count_ + kNumExtraCids);
@@ -1649,8 +1666,8 @@ void HeapSnapshotWriter::Write() {
     CountReferences(num_isolates);  // Root -> Isolate
 
     // Heap objects.
-    iteration.IterateVMIsolateObjects(&visitor);
-    iteration.IterateObjects(&visitor);
+    iteration->IterateVMIsolateObjects(&visitor);
+    iteration->IterateObjects(&visitor);
 
     // External properties.
     isolate()->group()->VisitWeakPersistentHandles(&visitor);
@@ -1714,9 +1731,9 @@ void HeapSnapshotWriter::Write() {
 
     // Heap objects.
     visitor.set_discount_sizes(true);
-    iteration.IterateVMIsolateObjects(&visitor);
+    iteration->IterateVMIsolateObjects(&visitor);
     visitor.set_discount_sizes(false);
-    iteration.IterateObjects(&visitor);
+    iteration->IterateObjects(&visitor);
 
     // Smis.
     for (SmiPtr smi : smis_) {
@@ -1746,8 +1763,8 @@ void HeapSnapshotWriter::Write() {
         /*at_safepoint=*/true);
 
     // Handle visit rest of the objects.
-    iteration.IterateVMIsolateObjects(&visitor);
-    iteration.IterateObjects(&visitor);
+    iteration->IterateVMIsolateObjects(&visitor);
+    iteration->IterateObjects(&visitor);
     for (SmiPtr smi : smis_) {
       USE(smi);
       WriteUnsigned(0);  // No identity hash.
@@ -239,6 +239,13 @@ class HeapSnapshotWriter : public ThreadStackResource {
 
   void Write();
 
+  // Forks a copy-on-write child process that writes the snapshot, so the
+  // isolate group only stays paused while the process is forked rather than
+  // for the whole heap walk. [writer_] is only invoked in the child, which
+  // exits once the last chunk is written. Returns the child's process id, or
+  // -1 if forking is not supported on this platform or failed.
+  intptr_t WriteInChildProcess();
+
   static uint32_t GetHeapSnapshotIdentityHash(Thread* thread, ObjectPtr obj);
 
  private:
@@ -251,6 +258,8 @@ class HeapSnapshotWriter : public ThreadStackResource {
   bool OnImagePage(ObjectPtr obj) const;
   CountingPage* FindCountingPage(ObjectPtr obj) const;
 
+  void WriteLocked(HeapIterationScope* iteration);
+
   void EnsureAvailable(intptr_t needed);
   void Flush(bool last = false);
 
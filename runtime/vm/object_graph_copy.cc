@@ -146,6 +146,8 @@ static ObjectPtr Marker() {
   return Object::unknown_constant().ptr();
 }
 
+static bool CanShareRecord(RecordPtr record);
+
 DART_FORCE_INLINE
 static bool CanShareObject(ObjectPtr obj, uword tags) {
   if ((tags & UntaggedObject::CanonicalBit::mask_in_place()) != 0) {
@@ -173,9 +175,34 @@ static bool CanShareObject(ObjectPtr obj, uword tags) {
     return Closure::RawCast(obj)->untag()->context() == Object::null();
   }
 
+  if (cid == kRecordCid) {
+    return CanShareRecord(Record::RawCast(obj));
+  }
+
   return false;
 }
 
+// Records are shallowly immutable, so they can be shared if all of their
+// fields can be shared. Records nested in records are not looked into, to
+// keep this check cheap: such records are copied.
+static bool CanShareRecord(RecordPtr record) {
+  const intptr_t num_fields =
+      RecordShape(record->untag()->shape()).num_fields();
+  for (intptr_t i = 0; i < num_fields; ++i) {
+    ObjectPtr field = record->untag()->field(i);
+    if (!field->IsHeapObject()) continue;
+    const uword tags = TagsFromUntaggedObject(field.untag());
+    if (UntaggedObject::ClassIdTag::decode(tags) == kRecordCid) {
+      if ((tags & UntaggedObject::CanonicalBit::mask_in_place()) == 0) {
+        return false;
+      }
+    } else if (!CanShareObject(field, tags)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool CanShareObjectAcrossIsolates(ObjectPtr obj) {
   if (!obj->IsHeapObject()) return true;
   const uword tags = TagsFromUntaggedObject(obj.untag());
@@ -412,23 +439,26 @@ class IdentityMap {
   explicit IdentityMap(Thread* thread) : thread_(thread) {
     hash_table_used_ = 0;
     hash_table_capacity_ = 32;
-    hash_table_ = reinterpret_cast<uint32_t*>(
-        malloc(hash_table_capacity_ * sizeof(uint32_t)));
-    memset(hash_table_, 0, hash_table_capacity_ * sizeof(uint32_t));
+    hash_table_ =
+        reinterpret_cast<Entry*>(malloc(hash_table_capacity_ * sizeof(Entry)));
+    memset(hash_table_, 0, hash_table_capacity_ * sizeof(Entry));
   }
   ~IdentityMap() { free(hash_table_); }
 
   template <typename S, typename T>
   DART_FORCE_INLINE ObjectPtr ForwardedObject(const S& object, T from_to) {
+    const uint32_t hash = GetHeaderHash(Ptr(object));
     intptr_t mask = hash_table_capacity_ - 1;
-    intptr_t probe = GetHeaderHash(Ptr(object)) & mask;
+    intptr_t probe = hash & mask;
     for (;;) {
-      intptr_t index = hash_table_[probe];
-      if (index == 0) {
+      const Entry entry = hash_table_[probe];
+      if (entry.id == 0) {
         return Marker();
       }
-      if (from_to.At(index) == Ptr(object)) {
-        return from_to.At(index + 1);
+      // Only look at the from object of entries which might match, which
+      // is likely to be a cache miss for large graphs.
+      if (entry.hash == hash && from_to.At(entry.id) == Ptr(object)) {
+        return from_to.At(entry.id + 1);
       }
       probe = (probe + 1) & mask;
     }
@@ -441,24 +471,34 @@ class IdentityMap {
                                 bool check_for_safepoint) {
     ASSERT(ForwardedObject(from, from_to) == Marker());
     const auto id = from_to.Length();
-    from_to.Add(from, to);  // Must occur before rehashing.
-    intptr_t mask = hash_table_capacity_ - 1;
-    intptr_t probe = GetHeaderHash(Ptr(from)) & mask;
-    for (;;) {
-      intptr_t index = hash_table_[probe];
-      if (index == 0) {
-        hash_table_[probe] = id;
-        break;
-      }
-      probe = (probe + 1) & mask;
-    }
+    from_to.Add(from, to);
+    InsertEntry(hash_table_, hash_table_capacity_,
+                {static_cast<uint32_t>(id), GetHeaderHash(Ptr(from))});
     hash_table_used_++;
     if (hash_table_used_ * 2 > hash_table_capacity_) {
-      Rehash(hash_table_capacity_ * 2, from_to, check_for_safepoint);
+      Rehash(hash_table_capacity_ * 2, check_for_safepoint);
     }
   }
 
  private:
+  // The hash is kept next to the index into the from/to list, so that
+  // neither the from objects nor the list have to be accessed to rehash the
+  // table, or to skip most colliding entries.
+  struct Entry {
+    uint32_t id;
+    uint32_t hash;
+  };
+
+  DART_FORCE_INLINE
+  static void InsertEntry(Entry* table, intptr_t capacity, Entry entry) {
+    intptr_t mask = capacity - 1;
+    intptr_t probe = entry.hash & mask;
+    while (table[probe].id != 0) {
+      probe = (probe + 1) & mask;
+    }
+    table[probe] = entry;
+  }
+
   DART_FORCE_INLINE
   uint32_t GetHeaderHash(ObjectPtr object) {
     uint32_t hash = Object::GetCachedHash(object);
@@ -489,39 +529,30 @@ class IdentityMap {
     return hash;
   }
 
-  template <typename T>
-  void Rehash(intptr_t new_capacity, T from_to, bool check_for_safepoint) {
-    hash_table_capacity_ = new_capacity;
-    hash_table_used_ = 0;
-    free(hash_table_);
-    hash_table_ = reinterpret_cast<uint32_t*>(
-        malloc(hash_table_capacity_ * sizeof(uint32_t)));
-    for (intptr_t i = 0; i < hash_table_capacity_; i++) {
-      hash_table_[i] = 0;
+  void Rehash(intptr_t new_capacity, bool check_for_safepoint) {
+    Entry* new_table =
+        reinterpret_cast<Entry*>(malloc(new_capacity * sizeof(Entry)));
+    for (intptr_t i = 0; i < new_capacity; i++) {
+      new_table[i] = {0, 0};
       if (check_for_safepoint && (((i + 1) % kSlotsPerInterruptCheck) == 0)) {
         thread_->CheckForSafepoint();
       }
     }
-    for (intptr_t id = 2; id < from_to.Length(); id += 2) {
-      ObjectPtr obj = from_to.At(id);
-      intptr_t mask = hash_table_capacity_ - 1;
-      intptr_t probe = GetHeaderHash(obj) & mask;
-      for (;;) {
-        if (hash_table_[probe] == 0) {
-          hash_table_[probe] = id;
-          hash_table_used_++;
-          break;
-        }
-        probe = (probe + 1) & mask;
+    for (intptr_t i = 0; i < hash_table_capacity_; i++) {
+      if (hash_table_[i].id != 0) {
+        InsertEntry(new_table, new_capacity, hash_table_[i]);
       }
-      if (check_for_safepoint && (((id + 2) % kSlotsPerInterruptCheck) == 0)) {
+      if (check_for_safepoint && (((i + 1) % kSlotsPerInterruptCheck) == 0)) {
         thread_->CheckForSafepoint();
       }
     }
+    free(hash_table_);
+    hash_table_ = new_table;
+    hash_table_capacity_ = new_capacity;
   }
 
   Thread* thread_;
-  uint32_t* hash_table_;
+  Entry* hash_table_;
   uint32_t hash_table_capacity_;
   uint32_t hash_table_used_;
 };
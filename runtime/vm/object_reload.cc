@@ -5,6 +5,7 @@
 #include "vm/object.h"
 
 #include "platform/unaligned.h"
+#include "vm/bit_vector.h"
 #include "vm/code_patcher.h"
 #include "vm/dart_entry.h"
 #include "vm/hash_table.h"
@@ -60,7 +61,8 @@ CallSiteResetter::CallSiteResetter(Zone* zone)
       descriptors_(PcDescriptors::Handle(zone)),
       ic_data_(ICData::Handle(zone)) {}
 
-void CallSiteResetter::ResetCaches(const Code& code) {
+void CallSiteResetter::ResetCaches(const Code& code,
+                                   const BitVector* retained_cids) {
   // Iterate over the Code's object pool and reset all ICDatas.
   // SubtypeTestCaches are reset during the same heap traversal as type
   // testing stub deoptimization.
@@ -84,13 +86,13 @@ void CallSiteResetter::ResetCaches(const Code& code) {
     }
     object_ = raw_object;
     if (object_.IsICData()) {
-      Reset(ICData::Cast(object_));
+      Reset(ICData::Cast(object_), retained_cids);
     }
   }
 #else
   pool_ = code.object_pool();
   ASSERT(!pool_.IsNull());
-  ResetCaches(pool_);
+  ResetCaches(pool_, retained_cids);
 #endif
 }
 
@@ -178,7 +180,8 @@ void CallSiteResetter::ResetSwitchableCalls(const Code& code) {
   }
 }
 
-void CallSiteResetter::ResetCaches(const ObjectPool& pool) {
+void CallSiteResetter::ResetCaches(const ObjectPool& pool,
+                                   const BitVector* retained_cids) {
   for (intptr_t i = 0; i < pool.Length(); i++) {
     ObjectPool::EntryType entry_type = pool.TypeAt(i);
     if (entry_type != ObjectPool::EntryType::kTaggedObject) {
@@ -186,7 +189,7 @@ void CallSiteResetter::ResetCaches(const ObjectPool& pool) {
     }
     object_ = pool.ObjectAt(i);
     if (object_.IsICData()) {
-      Reset(ICData::Cast(object_));
+      Reset(ICData::Cast(object_), retained_cids);
     }
   }
 }
@@ -763,9 +766,30 @@ void Library::CheckReload(const Library& replacement,
   }
 }
 
-void CallSiteResetter::Reset(const ICData& ic) {
+bool CallSiteResetter::ChecksOnlyClassesIn(const ICData& ic,
+                                           const BitVector& cids) {
+  if (ic.is_megamorphic()) {
+    return false;
+  }
+  const intptr_t num_args = ic.NumArgsTested();
+  const intptr_t num_checks = ic.NumberOfChecks();
+  for (intptr_t i = 0; i < num_checks; i++) {
+    for (intptr_t arg = 0; arg < num_args; arg++) {
+      const intptr_t cid = ic.GetClassIdAt(i, arg);
+      if ((cid >= cids.length()) || !cids.Contains(cid)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void CallSiteResetter::Reset(const ICData& ic, const BitVector* retained_cids) {
   ICData::RebindRule rule = ic.rebind_rule();
   if (rule == ICData::kInstance) {
+    if ((retained_cids != nullptr) && ChecksOnlyClassesIn(ic, *retained_cids)) {
+      return;
+    }
     const intptr_t num_args = ic.NumArgsTested();
     const intptr_t len = ic.Length();
     // We need at least one non-sentinel entry to require a check
@@ -10,6 +10,7 @@
 #include "vm/object_graph.h"
 #include "vm/object_store.h"
 #include "vm/resolver.h"
+#include "vm/runtime_entry.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
 
@@ -341,6 +342,20 @@ void Function::AddFunctionServiceId(const JSONObject& jsobj) const {
   jsobj.AddServiceId(*this);
 }
 
+// Adds the names of the deoptimization reasons set in [reasons], a bit mask of
+// ICData::DeoptReasonId, as an array property [name] of [jsobj].
+static void AddDeoptReasonsProperty(JSONObject* jsobj,
+                                    const char* name,
+                                    uint32_t reasons) {
+  JSONArray jsarr(jsobj, name);
+  for (intptr_t i = 0; i <= ICData::kLastRecordedDeoptReason; i++) {
+    if ((reasons & (1 << i)) != 0) {
+      jsarr.AddValue(
+          DeoptReasonToCString(static_cast<ICData::DeoptReasonId>(i)));
+    }
+  }
+}
+
 void Function::PrintJSONImpl(JSONStream* stream, bool ref) const {
   Class& cls = Class::Handle(Owner());
   ASSERT(!cls.IsNull());
@@ -412,6 +427,33 @@ void Function::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("_optimizedCallSiteCount", optimized_call_site_count());
   jsobj.AddProperty("_deoptimizations",
                     static_cast<intptr_t>(deoptimization_counter()));
+  // Speculations which deoptimized before and are no longer attempted when
+  // this function is optimized: per call site reasons recorded in its ICData
+  // and function wide speculations the optimizer stopped making.
+  uint32_t deopt_reasons = 0;
+  if (!ics.IsNull()) {
+    Object& ic_data = Object::Handle();
+    for (intptr_t i = ICDataArrayIndices::kFirstICData; i < ics.Length();
+         i++) {
+      ic_data = ics.At(i);
+      if (ic_data.IsICData()) {
+        deopt_reasons |= ICData::Cast(ic_data).DeoptReasons();
+      }
+    }
+  }
+  AddDeoptReasonsProperty(&jsobj, "_deoptReasons", deopt_reasons);
+  {
+    JSONArray prohibited(&jsobj, "_prohibitedSpeculations");
+    if (ProhibitsInstructionHoisting()) {
+      prohibited.AddValue("InstructionHoisting");
+    }
+    if (ProhibitsBoundsCheckGeneralization()) {
+      prohibited.AddValue("BoundsCheckGeneralization");
+    }
+    if (ProhibitsTypeArgumentsSpeculation()) {
+      prohibited.AddValue("TypeArgumentsSpeculation");
+    }
+  }
   if ((kind() == UntaggedFunction::kImplicitGetter) ||
       (kind() == UntaggedFunction::kImplicitSetter) ||
       (kind() == UntaggedFunction::kImplicitStaticGetter) ||
@@ -988,6 +1030,7 @@ void ICData::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("_argumentsDescriptor",
                     Object::Handle(arguments_descriptor()));
   jsobj.AddProperty("_entries", Object::Handle(entries()));
+  AddDeoptReasonsProperty(&jsobj, "_deoptReasons", DeoptReasons());
 }
 
 void ICData::PrintToJSONArray(const JSONArray& jsarray,
@@ -999,8 +1042,7 @@ void ICData::PrintToJSONArray(const JSONArray& jsarray,
   JSONObject jsobj(&jsarray);
   jsobj.AddProperty("name", String::Handle(target_name()).ToCString());
   jsobj.AddProperty("tokenPos", static_cast<intptr_t>(token_pos.Serialize()));
-  // TODO(rmacnak): Figure out how to stringify DeoptReasons().
-  // jsobj.AddProperty("deoptReasons", ...);
+  AddDeoptReasonsProperty(&jsobj, "deoptReasons", DeoptReasons());
 
   JSONArray cache_entries(&jsobj, "cacheEntries");
   for (intptr_t i = 0; i < NumberOfChecks(); i++) {
@@ -275,6 +275,14 @@ void ObjectStore::InitKnownObjects() {
   ASSERT(!function.IsNull());
   set_suspend_state_return_async_not_future(function);
 
+  function = cls.LookupFunctionAllowPrivate(Symbols::_canSkipAwait());
+  ASSERT(!function.IsNull());
+  set_suspend_state_can_skip_await(function);
+
+  function = cls.LookupFunctionAllowPrivate(Symbols::_completedValue());
+  ASSERT(!function.IsNull());
+  set_suspend_state_completed_value(function);
+
   function = cls.LookupFunctionAllowPrivate(Symbols::_initAsyncStar());
   ASSERT(!function.IsNull());
   set_suspend_state_init_async_star(function);
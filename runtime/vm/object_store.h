@@ -183,6 +183,8 @@ class ObjectPointerVisitor;
   RW(Function, suspend_state_await_with_type_check)                            \
   RW(Function, suspend_state_return_async)                                     \
   RW(Function, suspend_state_return_async_not_future)                          \
+  RW(Function, suspend_state_can_skip_await)                                   \
+  RW(Function, suspend_state_completed_value)                                  \
   RW(Function, suspend_state_init_async_star)                                  \
   RW(Function, suspend_state_yield_async_star)                                 \
   RW(Function, suspend_state_return_async_star)                                \
@@ -274,6 +276,8 @@ class ObjectPointerVisitor;
   RW(Code, type_parameter_tts_stub)                                            \
   RW(Code, unreachable_tts_stub)                                               \
   RW(Array, ffi_callback_functions)                                            \
+  RW(Array, precompiled_regexps)                                               \
+  RW(Array, code_coverage)                                                     \
   RW(Code, resume_stub)                                                        \
   RW(Code, slow_tts_stub)                                                      \
   /* Roots for JIT/AOT snapshots are up until here (see to_snapshot() below)*/ \
@@ -294,6 +298,10 @@ class ObjectPointerVisitor;
   RW(GrowableObjectArray, instructions_tables)                                 \
   RW(Array, obfuscation_map)                                                   \
   RW(Array, loading_unit_uris)                                                 \
+  RW(WeakArray, profiler_code_table)                                           \
+  RW(GrowableObjectArray, profiler_added_code)                                 \
+  RW(Array, retained_regexps)                                                  \
+  RW(GrowableObjectArray, lazy_bytecode_modules)                               \
   RW(Class, ffi_pointer_class)                                                 \
   RW(Class, ffi_native_type_class)                                             \
   // Please remember the last entry must be referred in the 'to' function below.
@@ -397,7 +405,8 @@ class ObjectPointerVisitor;
   R_(Array, dart_args_2)                                                       \
   R_(GrowableObjectArray, resume_capabilities)                                 \
   R_(GrowableObjectArray, exit_listeners)                                      \
-  R_(GrowableObjectArray, error_listeners)
+  R_(GrowableObjectArray, error_listeners)                                     \
+  RW(Array, reflective_lookup_cache)
 // Please remember the last entry must be referred in the 'to' function below.
 
 class IsolateObjectStore {
@@ -442,7 +451,9 @@ class IsolateObjectStore {
   ISOLATE_OBJECT_STORE_FIELD_LIST(DECLARE_OBJECT_STORE_FIELD,
                                   DECLARE_OBJECT_STORE_FIELD)
 #undef DECLARE_OBJECT_STORE_FIELD
-  ObjectPtr* to() { return reinterpret_cast<ObjectPtr*>(&error_listeners_); }
+  ObjectPtr* to() {
+    return reinterpret_cast<ObjectPtr*>(&reflective_lookup_cache_);
+  }
 
   friend class Serializer;
   friend class Deserializer;
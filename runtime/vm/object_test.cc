@@ -364,6 +364,50 @@ ISOLATE_UNIT_TEST_CASE(InstanceClass) {
   EXPECT(one_field_class.is_implemented());
 }
 
+// In AOT the unboxed fields of a class are laid out before its other fields.
+ISOLATE_UNIT_TEST_CASE(Class_UnboxedFieldsFirstInAot) {
+  const String& url = String::Handle(Symbols::New(thread, "test-lib"));
+  const Library& lib = Library::Handle(Library::New(url));
+  const String& class_name = String::Handle(Symbols::New(thread, "Fields"));
+  const Class& cls = Class::Handle(Class::New(lib, class_name, Script::Handle(),
+                                              TokenPosition::kNoSource));
+  cls.set_is_synthesized_class_unsafe();
+  cls.set_is_declaration_loaded_unsafe();
+  ClassFinalizer::FinalizeTypesInClass(cls);
+
+  const char* kNames[] = {"boxed0", "unboxed", "boxed1"};
+  const Array& fields = Array::Handle(Array::New(3));
+  Field& field = Field::Handle();
+  String& name = String::Handle();
+  for (intptr_t i = 0; i < 3; i++) {
+    name = Symbols::New(thread, kNames[i]);
+    field = Field::New(name, false, false, false, true, false, cls,
+                       Object::dynamic_type(), TokenPosition::kMinSource,
+                       TokenPosition::kMinSource);
+    fields.SetAt(i, field);
+  }
+  {
+    SafepointWriteRwLocker ml(thread, thread->isolate_group()->program_lock());
+    field ^= fields.At(1);
+    field.set_guarded_cid(kDoubleCid);
+    field.set_is_nullable(false);
+    field.set_is_unboxed(true);
+    cls.SetFields(fields);
+    SetFlagScope<bool> sfs(&FLAG_precompiled_mode, true);
+    cls.Finalize();
+  }
+
+  const intptr_t header_size = sizeof(UntaggedObject);
+  field ^= fields.At(1);
+  EXPECT(field.is_unboxed());
+  EXPECT_EQ(header_size, field.HostOffset());
+  const intptr_t boxed_offset = header_size + sizeof(double);
+  field ^= fields.At(0);
+  EXPECT_EQ(boxed_offset, field.HostOffset());
+  field ^= fields.At(2);
+  EXPECT_EQ(boxed_offset + kCompressedWordSize, field.HostOffset());
+}
+
 ISOLATE_UNIT_TEST_CASE(Smi) {
   const Smi& smi = Smi::Handle(Smi::New(5));
   Object& smi_object = Object::Handle(smi.ptr());
@@ -1394,6 +1438,24 @@ ISOLATE_UNIT_TEST_CASE(StringHashConcat) {
                         String::Handle(String::FromUTF16(clef_utf16 + 1, 1))));
 }
 
+ISOLATE_UNIT_TEST_CASE(OneByteStringIndexOf) {
+  const String& str =
+      String::Handle(String::New("abcabcabdabcabd, the quick brown fox"));
+  EXPECT(str.IsOneByteString());
+  const String& abd = String::Handle(String::New("abd"));
+  const String& fox = String::Handle(String::New("fox"));
+  const String& foxes = String::Handle(String::New("foxes"));
+  const String& x = String::Handle(String::New("x"));
+  EXPECT_EQ(6, OneByteString::IndexOf(str, abd, 0));
+  EXPECT_EQ(6, OneByteString::IndexOf(str, abd, 6));
+  EXPECT_EQ(12, OneByteString::IndexOf(str, abd, 7));
+  EXPECT_EQ(-1, OneByteString::IndexOf(str, abd, 13));
+  EXPECT_EQ(str.Length() - 3, OneByteString::IndexOf(str, fox, 0));
+  EXPECT_EQ(-1, OneByteString::IndexOf(str, foxes, 0));
+  EXPECT_EQ(str.Length() - 1, OneByteString::IndexOf(str, x, 0));
+  EXPECT_EQ(-1, OneByteString::IndexOf(str, x, str.Length()));
+}
+
 ISOLATE_UNIT_TEST_CASE(StringSubStringDifferentWidth) {
   // Create 1-byte substring from a 1-byte source string.
   const char* onechars = "\xC3\xB6\xC3\xB1\xC3\xA9";
@@ -3194,6 +3256,31 @@ ISOLATE_UNIT_TEST_CASE(MegamorphicCache) {
       EXPECT(Smi::Cast(value).Equals(Smi::Cast(expected)));
     }
   }
+
+  // Class ids which share few home entries make the cache grow beyond what
+  // the load factor requires, to keep probe sequences short.
+  {
+    const auto& cache =
+        MegamorphicCache::Handle(MegamorphicCache::New(name, args_descriptor));
+
+    const intptr_t kNumClasses = 40;
+    auto& cid = Smi::Handle();
+    auto& value = Object::Handle();
+    for (intptr_t i = 1; i <= kNumClasses; ++i) {
+      cid = Smi::New(64 * i);
+      value = Smi::New(i);
+      cache.EnsureContains(cid, value);
+    }
+    // The load factor alone only requires 128 entries.
+    EXPECT_EQ(256, cache.mask() + 1);
+    auto& expected = Object::Handle();
+    for (intptr_t i = 1; i <= kNumClasses; ++i) {
+      cid = Smi::New(64 * i);
+      expected = Smi::New(i);
+      value = cache.Lookup(cid);
+      EXPECT(Smi::Cast(value).Equals(Smi::Cast(expected)));
+    }
+  }
 }
 
 ISOLATE_UNIT_TEST_CASE(FieldTests) {
@@ -5633,6 +5720,62 @@ TEST_CASE(FunctionWithBreakpointNotInlined) {
   }
 }
 
+TEST_CASE(SettingBreakpointKeepsUnrelatedOptimizedCode) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  a() {\n"
+      "  }\n"
+      "  b() {\n"
+      "    a();\n"  // This is line 5.
+      "  }\n"
+      "}\n"
+      "c(x) => x + 1;\n"
+      "@pragma('vm:entry-point', 'call')\n"
+      "test() {\n"
+      "  new A().b();\n"
+      "  c(1);\n"
+      "}";
+  const int kBreakpointLine = 5;
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  EXPECT_VALID(lib);
+
+  Dart_Handle result = Dart_Invoke(lib, NewString("test"), 0, nullptr);
+  EXPECT_VALID(result);
+
+  {
+    TransitionNativeToVM transition(thread);
+    const String& name = String::Handle(String::New(TestCase::url()));
+    const Library& vmlib =
+        Library::Handle(Library::LookupLibrary(thread, name));
+    EXPECT(!vmlib.IsNull());
+    const Class& class_a = Class::Handle(
+        vmlib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+    const Function& func_b = Function::Handle(GetFunction(class_a, "b"));
+    const Function& func_c = Function::Handle(GetFunction(vmlib, "c"));
+    Compiler::CompileOptimizedFunction(thread, func_b);
+    Compiler::CompileOptimizedFunction(thread, func_c);
+    EXPECT(func_b.HasOptimizedCode());
+    EXPECT(func_c.HasOptimizedCode());
+  }
+
+  result = Dart_SetBreakpoint(NewString(TestCase::url()), kBreakpointLine);
+  EXPECT_VALID(result);
+
+  // Only the function with the breakpoint is deoptimized.
+  {
+    TransitionNativeToVM transition(thread);
+    const String& name = String::Handle(String::New(TestCase::url()));
+    const Library& vmlib =
+        Library::Handle(Library::LookupLibrary(thread, name));
+    const Class& class_a = Class::Handle(
+        vmlib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+    const Function& func_b = Function::Handle(GetFunction(class_a, "b"));
+    const Function& func_c = Function::Handle(GetFunction(vmlib, "c"));
+    EXPECT(!func_b.HasOptimizedCode());
+    EXPECT(func_c.HasOptimizedCode());
+  }
+}
+
 void SetBreakpoint(Dart_NativeArguments args) {
   // Refers to the DeoptimizeFramesWhenSettingBreakpoint function below.
   const int kBreakpointLine = 10;
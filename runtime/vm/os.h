@@ -119,6 +119,16 @@ class OS {
 
   DART_NORETURN static void Exit(int code);
 
+  // Forks a copy-on-write child process in which only the calling thread
+  // exists. Returns 0 in the child, the child's process id in the parent and
+  // -1 if forking failed or is not supported on this platform.
+  static intptr_t ForkProcess();
+
+  // Exits without running exit handlers or static destructors. Used to
+  // terminate children created with ForkProcess, which must not tear down
+  // the state they share with the parent.
+  DART_NORETURN static void ExitImmediately(int code);
+
   // Retrieves the DSO base for the given instructions image.
   static const uint8_t* GetAppDSOBase(const uint8_t* snapshot_instructions);
   static uword GetAppDSOBase(uword snapshot_instructions) {
@@ -75,7 +75,8 @@ class PerfCodeObserver : public CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) {
+                      const CodeComments* comments,
+                      const Code& code) {
     Dart_FileWriteCallback file_write = Dart::file_write_callback();
     if ((file_write == nullptr) || (out_file_ == nullptr)) {
       return;
@@ -354,6 +355,14 @@ void OS::Exit(int code) {
   exit(code);
 }
 
+intptr_t OS::ForkProcess() {
+  return fork();
+}
+
+void OS::ExitImmediately(int code) {
+  _exit(code);
+}
+
 // Used to choose between Elf32/Elf64 types based on host archotecture bitsize.
 #if defined(ARCH_IS_64_BIT)
 #define ElfW(Type) Elf64_##Type
@@ -637,6 +637,15 @@ void OS::Exit(int code) {
   exit(code);
 }
 
+intptr_t OS::ForkProcess() {
+  // Fuchsia has no fork().
+  return -1;
+}
+
+void OS::ExitImmediately(int code) {
+  _exit(code);
+}
+
 // Used to choose between Elf32/Elf64 types based on host archotecture bitsize.
 #if defined(ARCH_IS_64_BIT)
 #define ElfW(Type) Elf64_##Type
@@ -25,6 +25,7 @@
 #include "platform/memory_sanitizer.h"
 #include "platform/utils.h"
 #include "vm/code_comments.h"
+#include "vm/code_descriptors.h"
 #include "vm/code_observers.h"
 #include "vm/dart.h"
 #include "vm/flags.h"
@@ -63,6 +64,12 @@ DEFINE_FLAG(bool,
             "Generate jitdump file to use with perf-inject (disables dual code "
             "mapping)");
 
+DEFINE_FLAG(bool,
+            generate_perf_jitdump_source_positions,
+            false,
+            "Annotate code in the jitdump file with Dart source positions "
+            "instead of code comments");
+
 DECLARE_FLAG(bool, write_protect_code);
 DECLARE_FLAG(bool, write_protect_vm_isolate);
 #if !defined(DART_PRECOMPILED_RUNTIME)
@@ -107,7 +114,8 @@ class PerfCodeObserver : public CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) {
+                      const CodeComments* comments,
+                      const Code& code) {
     Dart_FileWriteCallback file_write = Dart::file_write_callback();
     if ((file_write == nullptr) || (out_file_ == nullptr)) {
       return;
@@ -185,7 +193,9 @@ class JitDumpCodeObserver : public CodeObserver {
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
     // Enable code comments.
-    FLAG_code_comments = true;
+    if (!FLAG_generate_perf_jitdump_source_positions) {
+      FLAG_code_comments = true;
+    }
 #endif
 
     // Write JITDUMP header.
@@ -213,14 +223,19 @@ class JitDumpCodeObserver : public CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) {
+                      const CodeComments* comments,
+                      const Code& code) {
     MutexLocker ml(CodeObservers::mutex());
 
     const char* marker = optimized ? "*" : "";
     char* buffer = OS::SCreate(Thread::Current()->zone(), "%s%s", marker, name);
     const size_t name_length = strlen(buffer);
 
-    WriteDebugInfo(base, comments);
+    if (FLAG_generate_perf_jitdump_source_positions) {
+      WriteSourcePositions(base, code);
+    } else {
+      WriteDebugInfo(base, comments);
+    }
 
     CodeLoadEvent ev;
     ev.event = BaseEvent::kLoad;
@@ -365,6 +380,81 @@ class JitDumpCodeObserver : public CodeObserver {
     free(comments_file_name);
   }
 
+  struct SourcePosition {
+    int32_t pc_offset;
+    int32_t line;
+    int32_t column;
+    const char* file_name;
+  };
+
+  // Emits a DebugInfoEvent mapping the instructions of |code| to the Dart
+  // source lines they were compiled from, including inlined functions.
+  void WriteSourcePositions(uword base, const Code& code) {
+    Zone* zone = Thread::Current()->zone();
+    const auto& map = CodeSourceMap::Handle(zone, code.code_source_map());
+    if (map.IsNull() || !code.IsFunctionCode()) {
+      return;
+    }
+    const auto& root = Function::Handle(zone, code.function());
+    if (root.IsNull()) {
+      return;
+    }
+    const auto& inlined_functions =
+        Array::Handle(zone, code.inlined_id_to_function());
+    GrowableArray<int32_t> pc_offsets;
+    GrowableArray<const Function*> functions;
+    GrowableArray<TokenPosition> token_positions;
+    CodeSourceMapReader reader(map, inlined_functions, root);
+    reader.GetSourcePositions(&pc_offsets, &functions, &token_positions);
+
+    // Resolve token positions to lines, dropping the ones without a line.
+    GrowableArray<SourcePosition> positions;
+    auto& script = Script::Handle(zone);
+    auto& last_script = Script::Handle(zone);
+    const char* file_name = nullptr;
+    intptr_t size = sizeof(DebugInfoEvent);
+    for (intptr_t i = 0; i < pc_offsets.length(); i++) {
+      script = functions[i]->script();
+      intptr_t line, column;
+      if (script.IsNull() || !token_positions[i].IsReal() ||
+          !script.GetTokenLocation(token_positions[i], &line, &column)) {
+        continue;
+      }
+      if (script.ptr() != last_script.ptr()) {
+        last_script = script.ptr();
+        file_name = String::Handle(zone, script.url()).ToCString();
+        if (strncmp(file_name, "file://", 7) == 0) {
+          file_name += 7;
+        }
+      }
+      positions.Add({pc_offsets[i], static_cast<int32_t>(line),
+                     static_cast<int32_t>(column), file_name});
+      size += sizeof(DebugInfoEntry) + strlen(file_name) + 1;
+    }
+    if (positions.is_empty()) {
+      return;
+    }
+
+    DebugInfoEvent info;
+    info.event = BaseEvent::kDebugInfo;
+    info.time_stamp = OS::GetCurrentMonotonicTicks();
+    info.address = base;
+    info.entry_count = positions.length();
+    const int32_t padding = Utils::RoundUp(size, 8) - size;
+    info.size = size + padding;
+    WriteFully(&info, sizeof(info));
+    for (const auto& position : positions) {
+      DebugInfoEntry entry;
+      entry.address = base + position.pc_offset + sizeof(ElfW(Ehdr));
+      entry.line_number = position.line;
+      entry.column = position.column;
+      WriteFully(&entry, sizeof(entry));
+      WriteFully(position.file_name, strlen(position.file_name) + 1);
+    }
+    const char padding_bytes[8] = {0};
+    WriteFully(padding_bytes, padding);
+  }
+
   void WriteHeader() {
     Header header;
     header.elf_mach_target = GetElfMachineArchitecture();
@@ -379,8 +469,9 @@ class JitDumpCodeObserver : public CodeObserver {
     fputc('\n', f);
 
     intptr_t line_count = 1;
-    while ((comment = strstr(comment, "\n")) != nullptr) {
+    while ((comment = strchr(comment, '\n')) != nullptr) {
       line_count++;
+      comment++;
     }
     return line_count;
   }
@@ -658,6 +749,14 @@ void OS::Exit(int code) {
   exit(code);
 }
 
+intptr_t OS::ForkProcess() {
+  return fork();
+}
+
+void OS::ExitImmediately(int code) {
+  _exit(code);
+}
+
 OS::BuildId OS::GetAppBuildId(const uint8_t* snapshot_instructions) {
   // First return the build ID information from the instructions image if
   // available.
@@ -282,6 +282,14 @@ void OS::Exit(int code) {
   exit(code);
 }
 
+intptr_t OS::ForkProcess() {
+  return fork();
+}
+
+void OS::ExitImmediately(int code) {
+  _exit(code);
+}
+
 OS::BuildId OS::GetAppBuildId(const uint8_t* snapshot_instructions) {
   // First return the build ID information from the instructions image if
   // available.
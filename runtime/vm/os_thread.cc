@@ -101,8 +101,8 @@ OSThread::~OSThread() {
   free(name_);
 #if !defined(PRODUCT)
   if (prepared_for_interrupts_) {
-    ThreadInterrupter::CleanupCurrentThreadState(thread_interrupter_state_);
-    thread_interrupter_state_ = nullptr;
+    void* state = thread_interrupter_state_.exchange(nullptr);
+    ThreadInterrupter::CleanupCurrentThreadState(state);
     prepared_for_interrupts_ = false;
   }
 #endif  // !defined(PRODUCT)
@@ -290,7 +290,8 @@ class OSThread : public BaseThread {
   // Thread interrupts disabled by default.
   RelaxedAtomic<uintptr_t> thread_interrupt_disabled_ = {1};
   bool prepared_for_interrupts_ = false;
-  void* thread_interrupter_state_ = nullptr;
+  // Read by the thread interrupter and the signal handler.
+  RelaxedAtomic<void*> thread_interrupter_state_ = {nullptr};
 #endif  // !defined(PRODUCT)
 
   Log* log_;
@@ -319,6 +320,7 @@ class OSThread : public BaseThread {
   friend class Thread;  // to access set_thread(Thread*).
   friend class OSThreadIterator;
   friend class ThreadInterrupterFuchsia;
+  friend class ThreadInterrupterLinux;
   friend class ThreadInterrupterMacOS;
   friend class ThreadInterrupterWin;
   friend class ThreadPool;  // to access owning_thread_pool_worker_
@@ -386,6 +386,15 @@ void OS::Exit(int code) {
   ::ExitProcess(code);
 }
 
+intptr_t OS::ForkProcess() {
+  return -1;
+}
+
+void OS::ExitImmediately(int code) {
+  ::TerminateProcess(::GetCurrentProcess(), code);
+  UNREACHABLE();
+}
+
 OS::BuildId OS::GetAppBuildId(const uint8_t* snapshot_instructions) {
   // Since we only use direct-to-ELF snapshots on Windows, the build ID
   // information must be available from the instructions image.
@@ -18,7 +18,7 @@
 namespace dart {
 
 Mutex* PortMap::mutex_ = nullptr;
-PortSet<PortMap::Entry>* PortMap::ports_ = nullptr;
+PortMap::Shard* PortMap::shards_ = nullptr;
 Random* PortMap::prng_ = nullptr;
 
 Dart_Port PortMap::AllocatePort() {
@@ -45,17 +45,17 @@ Dart_Port PortMap::AllocatePort() {
     }
 
     ASSERT(!static_cast<ObjectPtr>(static_cast<uword>(result))->IsWellFormed());
-  } while (ports_->Contains(result));
+  } while (ShardOf(result)->ports->Contains(result));
 
   ASSERT(result != 0);
-  ASSERT(!ports_->Contains(result));
+  ASSERT(!ShardOf(result)->ports->Contains(result));
   return result;
 }
 
 Dart_Port PortMap::CreatePort(PortHandler* handler) {
   ASSERT(handler != nullptr);
   PortMap::Locker ml;
-  if (ports_ == nullptr) {
+  if (prng_ == nullptr) {
     return ILLEGAL_PORT;
   }
 
@@ -63,7 +63,10 @@ Dart_Port PortMap::CreatePort(PortHandler* handler) {
   if (auto ports = handler->ports(ml)) {
     ports->Insert(PortHandler::PortSetEntry{port});
   }
-  ports_->Insert(Entry{port, handler});
+  {
+    ShardLocker sl(port);
+    ShardOf(port)->ports->Insert(Entry{port, handler});
+  }
 
   if (FLAG_trace_isolates) {
     OS::PrintErr(
@@ -82,11 +85,13 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
   PortHandler* handler = nullptr;
   {
     PortMap::Locker ml;
-    if (ports_ == nullptr) {
+    if (prng_ == nullptr) {
       return false;
     }
-    auto it = ports_->TryLookup(port);
-    if (it == ports_->end()) {
+    ShardLocker sl(port);
+    PortSet<Entry>* const shard_ports = ShardOf(port)->ports;
+    auto it = shard_ports->TryLookup(port);
+    if (it == shard_ports->end()) {
       return false;
     }
     Entry entry = *it;
@@ -98,7 +103,7 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
 #endif
 
     it.Delete();
-    ports_->Rebalance();
+    shard_ports->Rebalance();
 
     if (auto ports = handler->ports(ml)) {
       auto isolate_it = ports->TryLookup(port);
@@ -115,7 +120,7 @@ bool PortMap::ClosePort(Dart_Port port, PortHandler** port_handler) {
 void PortMap::ClosePorts(MessageHandler* handler) {
   {
     PortMap::Locker ml;
-    if (ports_ == nullptr) {
+    if (prng_ == nullptr) {
       return;
     }
 
@@ -124,60 +129,99 @@ void PortMap::ClosePorts(MessageHandler* handler) {
 
     for (auto isolate_it = ports->begin(); isolate_it != ports->end();
          ++isolate_it) {
-      auto it = ports_->TryLookup((*isolate_it).port);
-      ASSERT(it != ports_->end());
+      const Dart_Port port = (*isolate_it).port;
+      ShardLocker sl(port);
+      PortSet<Entry>* const shard_ports = ShardOf(port)->ports;
+      auto it = shard_ports->TryLookup(port);
+      ASSERT(it != shard_ports->end());
       Entry entry = *it;
-      ASSERT(entry.port == (*isolate_it).port);
+      ASSERT(entry.port == port);
       ASSERT(entry.handler == handler);
       it.Delete();
       isolate_it.Delete();
     }
     ASSERT(ports->IsEmpty());
-    ports_->Rebalance();
+    for (intptr_t i = 0; i < kNumShards; ++i) {
+      MutexLocker sl(&shards_[i].mutex);
+      shards_[i].ports->Rebalance();
+    }
   }
   handler->OnAllPortsClosed();
 }
 
 bool PortMap::PostMessage(std::unique_ptr<Message> message,
                           bool before_events) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  if (shards_ == nullptr) {
+    return false;
+  }
+  ShardLocker sl(message->dest_port());
+  PortSet<Entry>* const shard_ports = ShardOf(message->dest_port())->ports;
+  if (shard_ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(message->dest_port());
-  if (it == ports_->end()) {
+  auto it = shard_ports->TryLookup(message->dest_port());
+  if (it == shard_ports->end()) {
     // Ownership of external data remains with the poster.
     message->DropFinalizers();
     return false;
   }
   auto handler = (*it).handler;
   ASSERT(handler != nullptr);
+  if (((*it).control || (*it).coalescing) && !message->IsOOB()) {
+    message->set_lane((*it).control, (*it).coalescing);
+  }
   handler->PostMessage(std::move(message), before_events);
   return true;
 }
 
+bool PortMap::SetPortLane(Dart_Port id, bool control, bool coalescing) {
+  if (shards_ == nullptr) {
+    return false;
+  }
+  ShardLocker sl(id);
+  PortSet<Entry>* const shard_ports = ShardOf(id)->ports;
+  if (shard_ports == nullptr) {
+    return false;
+  }
+  auto it = shard_ports->TryLookup(id);
+  if (it == shard_ports->end()) {
+    return false;
+  }
+  (*it).control = control;
+  (*it).coalescing = coalescing;
+  return true;
+}
+
 #if defined(TESTING)
 bool PortMap::PortExists(Dart_Port id) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  if (shards_ == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(id);
-  return it != ports_->end();
+  ShardLocker sl(id);
+  PortSet<Entry>* const shard_ports = ShardOf(id)->ports;
+  if (shard_ports == nullptr) {
+    return false;
+  }
+  auto it = shard_ports->TryLookup(id);
+  return it != shard_ports->end();
 }
 
 Isolate* PortMap::GetIsolate(Dart_Port id) {
-  Locker ml;
-  return GetIsolateLocked(ml, id);
+  if (shards_ == nullptr) {
+    return nullptr;
+  }
+  ShardLocker sl(id);
+  return GetIsolateLocked(sl, id);
 }
 #endif  // defined(TESTING)
 
-Isolate* PortMap::GetIsolateLocked(const Locker& ml, Dart_Port id) {
-  if (ports_ == nullptr) {
+Isolate* PortMap::GetIsolateLocked(const ShardLocker& sl, Dart_Port id) {
+  PortSet<Entry>* const shard_ports = ShardOf(id)->ports;
+  if (shard_ports == nullptr) {
     return nullptr;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  auto it = shard_ports->TryLookup(id);
+  if (it == shard_ports->end()) {
     // Port does not exist.
     return nullptr;
   }
@@ -187,12 +231,16 @@ Isolate* PortMap::GetIsolateLocked(const Locker& ml, Dart_Port id) {
 }
 
 Dart_Port PortMap::GetOriginId(Dart_Port id) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  if (shards_ == nullptr) {
     return ILLEGAL_PORT;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  ShardLocker sl(id);
+  PortSet<Entry>* const shard_ports = ShardOf(id)->ports;
+  if (shard_ports == nullptr) {
+    return ILLEGAL_PORT;
+  }
+  auto it = shard_ports->TryLookup(id);
+  if (it == shard_ports->end()) {
     // Port does not exist.
     return ILLEGAL_PORT;
   }
@@ -207,19 +255,22 @@ Dart_Port PortMap::GetOriginId(Dart_Port id) {
 }
 
 bool PortMap::IsOwnedByCurrentThread(Dart_Port id) {
-  Locker ml;
-  Isolate* isolate = GetIsolateLocked(ml, id);
+  if (shards_ == nullptr) {
+    return false;
+  }
+  ShardLocker sl(id);
+  Isolate* isolate = GetIsolateLocked(sl, id);
   if (isolate == nullptr) {
     // Either the port is invalid, or the isolate has already shut down.
     return false;
   }
-  return isolate->GetOwnerThread(&ml) == OSThread::GetCurrentThreadId();
+  return isolate->GetOwnerThread(&sl) == OSThread::GetCurrentThreadId();
 }
 
 #if defined(TESTING)
 bool PortMap::HasPorts(MessageHandler* handler) {
   Locker ml;
-  if (ports_ == nullptr) {
+  if (prng_ == nullptr) {
     return false;
   }
   // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
@@ -230,13 +281,18 @@ bool PortMap::HasPorts(MessageHandler* handler) {
 
 bool PortMap::IsReceiverInThisIsolateGroupOrClosed(Dart_Port receiver,
                                                    IsolateGroup* group) {
-  Locker ml;
-  if (ports_ == nullptr) {
+  if (shards_ == nullptr) {
+    // Port was closed.
+    return true;
+  }
+  ShardLocker sl(receiver);
+  PortSet<Entry>* const shard_ports = ShardOf(receiver)->ports;
+  if (shard_ports == nullptr) {
     // Port was closed.
     return true;
   }
-  auto it = ports_->TryLookup(receiver);
-  if (it == ports_->end()) {
+  auto it = shard_ports->TryLookup(receiver);
+  if (it == shard_ports->end()) {
     // Port was closed.
     return true;
   }
@@ -253,38 +309,53 @@ void PortMap::Init() {
     mutex_ = new Mutex();
   }
   ASSERT(mutex_ != nullptr);
+  if (shards_ == nullptr) {
+    shards_ = new Shard[kNumShards];
+  }
+  Locker ml;
   if (prng_ == nullptr) {
     prng_ = new Random();
   }
-  if (ports_ == nullptr) {
-    ports_ = new PortSet<Entry>();
+  for (intptr_t i = 0; i < kNumShards; ++i) {
+    MutexLocker sl(&shards_[i].mutex);
+    if (shards_[i].ports == nullptr) {
+      shards_[i].ports = new PortSet<Entry>();
+    }
   }
 }
 
 void PortMap::Shutdown() {
   // Tell all handlers which are running their own thread pools to shutdown.
-  for (auto& entry : *ports_) {
-    entry.handler->Shutdown();
+  for (intptr_t i = 0; i < kNumShards; ++i) {
+    for (auto& entry : *shards_[i].ports) {
+      entry.handler->Shutdown();
+    }
   }
 }
 
 void PortMap::Cleanup() {
-  ASSERT(ports_ != nullptr);
   ASSERT(prng_ != nullptr);
-  for (auto it = ports_->begin(); it != ports_->end(); ++it) {
-    const auto& entry = *it;
-    ASSERT(entry.handler != nullptr);
-    delete entry.handler;
-    it.Delete();
+  for (intptr_t i = 0; i < kNumShards; ++i) {
+    PortSet<Entry>* const shard_ports = shards_[i].ports;
+    ASSERT(shard_ports != nullptr);
+    for (auto it = shard_ports->begin(); it != shard_ports->end(); ++it) {
+      const auto& entry = *it;
+      ASSERT(entry.handler != nullptr);
+      delete entry.handler;
+      it.Delete();
+    }
+    shard_ports->Rebalance();
   }
-  ports_->Rebalance();
 
-  // Grab the mutex and delete the port set.
+  // Grab the mutexes and delete the port sets.
   Locker ml;
   delete prng_;
   prng_ = nullptr;
-  delete ports_;
-  ports_ = nullptr;
+  for (intptr_t i = 0; i < kNumShards; ++i) {
+    MutexLocker sl(&shards_[i].mutex);
+    delete shards_[i].ports;
+    shards_[i].ports = nullptr;
+  }
 }
 
 void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
@@ -296,16 +367,18 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
   {
     JSONArray ports(&jsobj, "ports");
     SafepointMutexLocker ml(mutex_);
-    if (ports_ == nullptr) {
+    if (prng_ == nullptr) {
       return;
     }
-    for (auto& entry : *ports_) {
-      if (entry.handler == handler) {
-        JSONObject port(&ports);
-        port.AddProperty("type", "_Port");
-        port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", entry.port);
-        msg_handler = DartLibraryCalls::LookupHandler(entry.port);
-        port.AddProperty("handler", msg_handler);
+    for (intptr_t i = 0; i < kNumShards; ++i) {
+      for (auto& entry : *shards_[i].ports) {
+        if (entry.handler == handler) {
+          JSONObject port(&ports);
+          port.AddProperty("type", "_Port");
+          port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", entry.port);
+          msg_handler = DartLibraryCalls::LookupHandler(entry.port);
+          port.AddProperty("handler", msg_handler);
+        }
       }
     }
   }
@@ -314,15 +387,17 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
 
 void PortMap::DebugDumpForMessageHandler(MessageHandler* handler) {
   SafepointMutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  if (prng_ == nullptr) {
     return;
   }
   Object& msg_handler = Object::Handle();
-  for (auto& entry : *ports_) {
-    if (entry.handler == handler) {
-      OS::PrintErr("Port = %" Pd64 "\n", entry.port);
-      msg_handler = DartLibraryCalls::LookupHandler(entry.port);
-      OS::PrintErr("Handler = %s\n", msg_handler.ToCString());
+  for (intptr_t i = 0; i < kNumShards; ++i) {
+    for (auto& entry : *shards_[i].ports) {
+      if (entry.handler == handler) {
+        OS::PrintErr("Port = %" Pd64 "\n", entry.port);
+        msg_handler = DartLibraryCalls::LookupHandler(entry.port);
+        OS::PrintErr("Handler = %s\n", msg_handler.ToCString());
+      }
     }
   }
 }
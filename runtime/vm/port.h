@@ -43,6 +43,14 @@ class PortMap : public AllStatic {
   static bool PostMessage(std::unique_ptr<Message> message,
                           bool before_events = false);
 
+  // Sets how normal messages posted to the port with id are queued:
+  // messages to [control] ports are handled before other normal messages,
+  // and a message to a [coalescing] port replaces the messages still queued
+  // for it.
+  //
+  // Returns false if the port is not active any longer.
+  static bool SetPortLane(Dart_Port id, bool control, bool coalescing);
+
   // Returns the origin id for port 'id'.
   static Dart_Port GetOriginId(Dart_Port id);
 
@@ -69,11 +77,19 @@ class PortMap : public AllStatic {
 
   static void DebugDumpForMessageHandler(MessageHandler* handler);
 
+  // Guards adding and removing ports as well as the ports of each handler.
   class Locker : public MutexLocker {
    public:
     Locker() : MutexLocker(PortMap::mutex_) {}
   };
 
+  // Guards looking up the handler of [port] against the port being closed.
+  class ShardLocker : public MutexLocker {
+   public:
+    explicit ShardLocker(Dart_Port port)
+        : MutexLocker(&PortMap::ShardOf(port)->mutex) {}
+  };
+
  private:
   struct Entry : public PortSet<Entry>::Entry {
     Entry() : handler(nullptr) {}
@@ -81,17 +97,38 @@ class PortMap : public AllStatic {
         : PortSet<Entry>::Entry(port), handler(handler) {}
 
     PortHandler* handler;
+    // See SetPortLane, protected by the shard lock.
+    bool control = false;
+    bool coalescing = false;
   };
 
+  // The ports are distributed over shards by their id so that posting
+  // messages to different ports does not contend on a single lock.
+  //
+  // The ports of a shard are only modified while holding both [mutex_] and
+  // the lock of the shard, so either one suffices to look them up.
+  struct Shard {
+    Mutex mutex;
+    PortSet<Entry>* ports = nullptr;
+  };
+
+  static constexpr intptr_t kNumShardsLog2 = 4;
+  static constexpr intptr_t kNumShards = 1 << kNumShardsLog2;
+
+  static Shard* ShardOf(Dart_Port port) {
+    // The two lowest bits of ports are always set.
+    return &shards_[(port >> 2) & (kNumShards - 1)];
+  }
+
   // Allocate a new unique port.
   static Dart_Port AllocatePort();
 
-  static Isolate* GetIsolateLocked(const Locker& ml, Dart_Port id);
+  static Isolate* GetIsolateLocked(const ShardLocker& ml, Dart_Port id);
 
-  // Lock protecting access to the port map.
+  // Lock protecting modifications of the port map.
   static Mutex* mutex_;
 
-  static PortSet<Entry>* ports_;
+  static Shard* shards_;
 
   static Random* prng_;
 };
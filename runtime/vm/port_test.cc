@@ -74,6 +74,20 @@ TEST_CASE(PortMap_CreateManyPorts) {
   }
 }
 
+TEST_CASE(PortMap_ClosePortsOfManyShards) {
+  PortTestMessageHandler handler;
+  Dart_Port ports[64];
+  for (intptr_t i = 0; i < 64; i++) {
+    ports[i] = PortMap::CreatePort(&handler);
+    EXPECT(PortMap::PortExists(ports[i]));
+  }
+
+  PortMap::ClosePorts(&handler);
+  for (intptr_t i = 0; i < 64; i++) {
+    EXPECT(!PortMap::PortExists(ports[i]));
+  }
+}
+
 TEST_CASE(PortMap_PostMessage) {
   PortTestMessageHandler handler;
   Dart_Port port = PortMap::CreatePort(&handler);
@@ -21,7 +21,9 @@
 #include "vm/message_handler.h"
 #include "vm/native_symbol.h"
 #include "vm/object.h"
+#include "vm/object_store.h"
 #include "vm/os.h"
+#include "vm/profiler_export.h"
 #include "vm/profiler_service.h"
 #include "vm/reusable_handles.h"
 #include "vm/signal_handler.h"
@@ -576,6 +578,7 @@ Monitor* SampleBlockProcessor::monitor_ = nullptr;
 void Profiler::Init() {
   // Place some sane restrictions on user controlled flags.
   SetSampleDepth(FLAG_max_profile_depth);
+  CpuProfileExporter::Init();
   if (!FLAG_profiler) {
     return;
   }
@@ -612,6 +615,7 @@ void Profiler::Cleanup() {
   ASSERT(initialized_);
   ThreadInterrupter::Cleanup();
   SampleBlockProcessor::Cleanup();
+  CpuProfileExporter::Cleanup();
   SampleBlockCleanupVisitor visitor;
   Isolate::VisitIsolates(&visitor);
   initialized_ = false;
@@ -1273,7 +1277,8 @@ static bool CheckIsolate(Isolate* isolate) {
 
 void Profiler::SampleAllocation(Thread* thread,
                                 intptr_t cid,
-                                uint32_t identity_hash) {
+                                uint32_t identity_hash,
+                                intptr_t sampled_bytes) {
   ASSERT(thread != nullptr);
   OSThread* os_thread = thread->os_thread();
   ASSERT(os_thread != nullptr);
@@ -1314,6 +1319,7 @@ void Profiler::SampleAllocation(Thread* thread,
   }
   sample->SetAllocationCid(cid);
   sample->set_allocation_identity_hash(identity_hash);
+  sample->set_allocation_sampled_bytes(sampled_bytes);
 
   if (FLAG_profile_vm_allocation) {
     ProfilerNativeStackWalker native_stack_walker(
@@ -1506,14 +1512,10 @@ class CodeLookupTableBuilder : public ObjectVisitor {
   CodeLookupTable* table_;
 };
 
-void CodeLookupTable::Build(Thread* thread) {
-  ASSERT(thread != nullptr);
+void CodeLookupTable::BuildFromHeap(Thread* thread) {
   Isolate* vm_isolate = Dart::vm_isolate();
   ASSERT(vm_isolate != nullptr);
 
-  // Clear.
-  code_objects_.Clear();
-
   thread->CheckForSafepoint();
   // Add all found Code objects.
   {
@@ -1525,9 +1527,74 @@ void CodeLookupTable::Build(Thread* thread) {
     iteration.IterateOldObjects(&cltb);
   }
   thread->CheckForSafepoint();
+}
+
+void CodeLookupTable::Build(Thread* thread) {
+  ASSERT(thread != nullptr);
+  Zone* zone = thread->zone();
+  IsolateGroup* isolate_group = thread->isolate_group();
+  ObjectStore* object_store = isolate_group->object_store();
+
+  // Clear.
+  code_objects_.Clear();
+
+  // Start recording installed code before walking the heap, so that no code
+  // is missed by the next build. Code recorded while walking the heap is
+  // added twice.
+  auto& table = WeakArray::Handle(zone);
+  auto& added = GrowableObjectArray::Handle(zone);
+  const auto& next_added =
+      GrowableObjectArray::Handle(zone, GrowableObjectArray::New(Heap::kOld));
+  {
+    SafepointMutexLocker ml(isolate_group->profiler_code_table_mutex());
+    table = object_store->profiler_code_table();
+    added = object_store->profiler_added_code();
+    if (table.IsNull() || added.IsNull()) {
+      table = WeakArray::null();
+      added = GrowableObjectArray::null();
+    }
+    object_store->set_profiler_added_code(next_added);
+  }
+
+  if (table.IsNull()) {
+    BuildFromHeap(thread);
+  } else {
+    // Collected code was cleared from the weak table.
+    auto& code = Code::Handle(zone);
+    for (intptr_t i = 0; i < table.Length(); i++) {
+      code ^= table.At(i);
+      if (!code.IsNull()) {
+        Add(code);
+      }
+    }
+    for (intptr_t i = 0; i < added.Length(); i++) {
+      code ^= added.At(i);
+      Add(code);
+    }
+  }
 
-  // Sort by entry.
+  // Sort by entry and drop the code added twice.
   code_objects_.Sort(CodeDescriptor::Compare);
+  intptr_t unique = 0;
+  for (intptr_t i = 0; i < length(); i++) {
+    if ((unique == 0) ||
+        (code_objects_[unique - 1]->Start() != code_objects_[i]->Start())) {
+      code_objects_[unique++] = code_objects_[i];
+    }
+  }
+  code_objects_.TruncateTo(unique);
+
+  table = WeakArray::New(length(), Heap::kOld);
+  for (intptr_t i = 0; i < length(); i++) {
+    table.SetAt(i, Object::Handle(zone, At(i)->code().ptr()));
+  }
+  {
+    SafepointMutexLocker ml(isolate_group->profiler_code_table_mutex());
+    // Unless invalidated in the meantime.
+    if (object_store->profiler_added_code() != GrowableObjectArray::null()) {
+      object_store->set_profiler_code_table(table);
+    }
+  }
 
 #if defined(DEBUG)
   if (length() <= 1) {
@@ -1549,6 +1616,46 @@ void CodeLookupTable::Build(Thread* thread) {
 #endif
 }
 
+static void ClearCodeTable(Zone* zone, ObjectStore* object_store) {
+  object_store->set_profiler_code_table(WeakArray::Handle(zone));
+  object_store->set_profiler_added_code(GrowableObjectArray::Handle(zone));
+}
+
+void CodeLookupTable::CodeInstalled(Thread* thread, const Code& code) {
+  if (!FLAG_profiler) {
+    return;
+  }
+  IsolateGroup* isolate_group = thread->isolate_group();
+  ObjectStore* object_store = isolate_group->object_store();
+  if (object_store == nullptr) {
+    // The VM isolate group.
+    return;
+  }
+  SafepointMutexLocker ml(isolate_group->profiler_code_table_mutex());
+  const auto& added = GrowableObjectArray::Handle(
+      thread->zone(), object_store->profiler_added_code());
+  // Nothing is recorded until the first table is built.
+  if (added.IsNull()) {
+    return;
+  }
+  if (added.Length() >= kMaxAddedCode) {
+    ClearCodeTable(thread->zone(), object_store);
+    return;
+  }
+  added.Add(code, Heap::kOld);
+}
+
+void CodeLookupTable::Invalidate(Thread* thread) {
+  IsolateGroup* isolate_group = thread->isolate_group();
+  ObjectStore* object_store = isolate_group->object_store();
+  if (object_store == nullptr) {
+    // The VM isolate group.
+    return;
+  }
+  SafepointMutexLocker ml(isolate_group->profiler_code_table_mutex());
+  ClearCodeTable(thread->zone(), object_store);
+}
+
 void CodeLookupTable::Add(const Object& code) {
   ASSERT(!code.IsNull());
   ASSERT(code.IsCode());
@@ -1658,6 +1765,8 @@ ProcessedSample* SampleBuffer::BuildProcessedSample(
     processed_sample->set_allocation_cid(sample->allocation_cid());
     processed_sample->set_allocation_identity_hash(
         sample->allocation_identity_hash());
+    processed_sample->set_allocation_sampled_bytes(
+        sample->allocation_sampled_bytes());
   }
   processed_sample->set_first_frame_executing(!sample->exit_frame_sample());
 
@@ -1710,6 +1819,7 @@ ProcessedSample::ProcessedSample()
       user_tag_(0),
       allocation_cid_(-1),
       allocation_identity_hash_(0),
+      allocation_sampled_bytes_(0),
       truncated_(false) {}
 
 void ProcessedSample::FixupCaller(const CodeLookupTable& clt,
@@ -1844,7 +1954,9 @@ class StreamableSampleFilter : public SampleFilter {
 };
 
 void Profiler::ProcessCompletedBlocks(Isolate* isolate) {
-  if (!Service::profiler_stream.enabled()) return;
+  const bool stream = Service::profiler_stream.enabled();
+  const bool aggregate = CpuProfileExporter::enabled();
+  if (!stream && !aggregate) return;
   auto thread = Thread::Current();
   if (Isolate::IsSystemIsolate(isolate)) return;
 
@@ -1852,6 +1964,15 @@ void Profiler::ProcessCompletedBlocks(Isolate* isolate) {
   DisableThreadInterruptsScope dtis(thread);
   StackZone zone(thread);
   HandleScope handle_scope(thread);
+  if (aggregate) {
+    // The samples are left to the stream, if any.
+    SampleFilter filter(isolate->main_port(), SampleFilter::kNoTaskFilter, -1,
+                        -1, /*take_samples=*/!stream);
+    Profile profile;
+    profile.Build(thread, isolate, &filter, Profiler::sample_block_buffer());
+    CpuProfileExporter::AddSamples(&profile);
+    if (!stream) return;
+  }
   StreamableSampleFilter filter(isolate->main_port(), isolate);
   Profile profile;
   profile.Build(thread, isolate, &filter, Profiler::sample_block_buffer());
@@ -1899,6 +2020,7 @@ void SampleBlockProcessor::ThreadMain(uword parameters) {
       });
       Thread::ExitIsolateGroupAsHelper(kBypassSafepoint);
     });
+    CpuProfileExporter::MaybeExport();
   }
   // Signal to main thread we are exiting.
   thread_running_ = false;
@@ -75,9 +75,12 @@ class Profiler : public AllStatic {
   static void DumpStackTrace(void* context);
   static void DumpStackTrace(bool for_crash = true);
 
+  // |sampled_bytes| is non-zero when the allocation was picked by the heap
+  // sampling profiler, and is the number of bytes the sample accounts for.
   static void SampleAllocation(Thread* thread,
                                intptr_t cid,
-                               uint32_t identity_hash);
+                               uint32_t identity_hash,
+                               intptr_t sampled_bytes = 0);
 
   // SampleThread is called from inside the signal handler and hence it is very
   // critical that the implementation of SampleThread does not do any of the
@@ -225,6 +228,7 @@ class Sample {
     state_ = 0;
     next_ = nullptr;
     allocation_identity_hash_ = 0;
+    allocation_sampled_bytes_ = 0;
     set_head_sample(true);
   }
 
@@ -320,6 +324,14 @@ class Sample {
     allocation_identity_hash_ = hash;
   }
 
+  intptr_t allocation_sampled_bytes() const {
+    return allocation_sampled_bytes_;
+  }
+
+  void set_allocation_sampled_bytes(intptr_t bytes) {
+    allocation_sampled_bytes_ = bytes;
+  }
+
   Thread::TaskKind thread_task() const { return ThreadTaskBit::decode(state_); }
 
   void set_thread_task(Thread::TaskKind task) {
@@ -377,6 +389,7 @@ class Sample {
   uint32_t state_;
   Sample* next_;
   uint32_t allocation_identity_hash_;
+  intptr_t allocation_sampled_bytes_;
 
   using HeadSampleBit = BitField<decltype(state_), bool, 0, 1>;
   using LeafFrameIsDart =
@@ -538,6 +551,10 @@ class CodeDescriptor : public ZoneAllocated {
 };
 
 // Fast lookup of Dart code objects.
+//
+// The code objects of an isolate group are kept sorted in its object store
+// between builds, so that only code installed since the previous build is
+// added instead of walking the heap again.
 class CodeLookupTable : public ZoneAllocated {
  public:
   explicit CodeLookupTable(Thread* thread);
@@ -550,8 +567,21 @@ class CodeLookupTable : public ZoneAllocated {
 
   const CodeDescriptor* FindCode(uword pc) const;
 
+  // Records |code| for the next table built in the isolate group of
+  // |thread|. Called when code is installed.
+  static void CodeInstalled(Thread* thread, const Code& code);
+
+  // Makes the next table in the isolate group of |thread| walk the heap, for
+  // when code is installed without CodeInstalled, e.g. by loading units.
+  static void Invalidate(Thread* thread);
+
  private:
+  // Beyond this many installed code objects between builds it is cheaper to
+  // walk the heap again.
+  static constexpr intptr_t kMaxAddedCode = 16 * KB;
+
   void Build(Thread* thread);
+  void BuildFromHeap(Thread* thread);
 
   void Add(const Object& code);
 
@@ -844,6 +874,15 @@ class ProcessedSample : public ZoneAllocated {
     allocation_identity_hash_ = hash;
   }
 
+  // The number of bytes accounted for by this sample if the allocation was
+  // picked by the heap sampling profiler. 0 otherwise.
+  intptr_t allocation_sampled_bytes() const {
+    return allocation_sampled_bytes_;
+  }
+  void set_allocation_sampled_bytes(intptr_t bytes) {
+    allocation_sampled_bytes_ = bytes;
+  }
+
   bool IsAllocationSample() const { return allocation_cid_ > 0; }
 
   // Was the stack trace truncated?
@@ -873,6 +912,7 @@ class ProcessedSample : public ZoneAllocated {
   uword user_tag_;
   intptr_t allocation_cid_;
   uint32_t allocation_identity_hash_;
+  intptr_t allocation_sampled_bytes_;
   bool truncated_;
   bool first_frame_executing_;
 
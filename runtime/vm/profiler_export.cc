@@ -0,0 +1,397 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/profiler_export.h"
+
+#include "vm/datastream.h"
+#include "vm/flags.h"
+#include "vm/lockers.h"
+#include "vm/object.h"
+#include "vm/os.h"
+#include "vm/profiler_service.h"
+
+namespace dart {
+
+#if !defined(PRODUCT)
+
+DEFINE_FLAG(int,
+            profile_export_max_nodes,
+            64 * KB,
+            "Maximum number of call tree nodes aggregated between two exports "
+            "of the CPU profile. See Dart_SetCpuProfileExportCallback.");
+
+DECLARE_FLAG(int, profile_period);
+
+AggregatedCpuProfile::AggregatedCpuProfile(intptr_t max_nodes)
+    : max_nodes_(Utils::Maximum<intptr_t>(max_nodes, 1)) {
+  Clear();
+}
+
+AggregatedCpuProfile::~AggregatedCpuProfile() {
+  for (intptr_t i = 0; i < strings_.length(); i++) {
+    free(strings_[i]);
+  }
+}
+
+static const char* ScriptUrl(const Function& function) {
+  const Script& script = Script::Handle(function.script());
+  if (script.IsNull()) {
+    return "";
+  }
+  const String& uri = String::Handle(script.resolved_url());
+  return uri.IsNull() ? "" : uri.ToCString();
+}
+
+void AggregatedCpuProfile::Add(Profile* profile) {
+  Zone* zone = Thread::Current()->zone();
+
+  // Names are looked up before taking the lock, which must not be held while
+  // allocating. |frames| holds the name and script of each frame, from the
+  // top of the stack, and |ends| the end of the frames of each sample.
+  GrowableArray<const char*> frames(zone, 64);
+  GrowableArray<intptr_t> ends(zone, profile->sample_count());
+  auto* cache = new ProfileCodeInlinedFunctionsCache();
+  for (intptr_t sample_index = 0; sample_index < profile->sample_count();
+       sample_index++) {
+    ProcessedSample* sample = profile->SampleAt(sample_index);
+    if (sample->IsAllocationSample()) {
+      continue;
+    }
+    for (intptr_t frame_index = 0; frame_index < sample->length();
+         frame_index++) {
+      const uword pc = sample->At(frame_index);
+      ProfileCode* profile_code =
+          profile->GetCodeFromPC(pc, sample->timestamp());
+      ASSERT(profile_code != nullptr);
+      ProfileFunction* function = profile_code->function();
+      ASSERT(function != nullptr);
+      // Don't show stubs in stack traces.
+      if (!function->is_visible() ||
+          (function->kind() == ProfileFunction::kStubFunction)) {
+        continue;
+      }
+
+      GrowableArray<const Function*>* inlined_functions = nullptr;
+      GrowableArray<TokenPosition>* inlined_token_positions = nullptr;
+      TokenPosition token_position = TokenPosition::kNoSource;
+      if (profile_code->code().IsCode()) {
+        Code& code = Code::Handle(zone);
+        code ^= profile_code->code().ptr();
+        cache->Get(pc, code, sample, frame_index, &inlined_functions,
+                   &inlined_token_positions, &token_position);
+      }
+      if ((inlined_functions == nullptr) ||
+          (inlined_functions->length() <= 1)) {
+        const char* url = function->ResolvedScriptUrl();
+        frames.Add(function->Name());
+        frames.Add(url == nullptr ? "" : url);
+        continue;
+      }
+      for (intptr_t i = inlined_functions->length() - 1; i >= 0; i--) {
+        const Function* inlined_function = (*inlined_functions)[i];
+        frames.Add(String::Handle(zone,
+                                  inlined_function->QualifiedUserVisibleName())
+                       .ToCString());
+        frames.Add(ScriptUrl(*inlined_function));
+      }
+    }
+    ends.Add(frames.length());
+  }
+
+  MutexLocker ml(&mutex_);
+  intptr_t start = 0;
+  for (intptr_t i = 0; i < ends.length(); i++) {
+    intptr_t node = 0;
+    for (intptr_t j = ends[i] - 2; j >= start; j -= 2) {
+      const intptr_t child = ChildOf(node, frames[j], frames[j + 1]);
+      if (child < 0) {
+        truncated_sample_count_++;
+        break;
+      }
+      node = child;
+    }
+    nodes_[node].exclusive_count++;
+    sample_count_++;
+    start = ends[i];
+  }
+}
+
+intptr_t AggregatedCpuProfile::InternString(const char* str, bool lookup_only) {
+  auto pair = string_indices_.Lookup(str);
+  if (pair != nullptr) {
+    return pair->value;
+  }
+  if (lookup_only) {
+    return -1;
+  }
+  char* copy = Utils::StrDup(str);
+  const intptr_t index = strings_.length();
+  strings_.Add(copy);
+  string_indices_.Insert({copy, index});
+  return index;
+}
+
+intptr_t AggregatedCpuProfile::ChildOf(intptr_t parent,
+                                       const char* name,
+                                       const char* url) {
+  // Once the tree is full, samples are only added to existing nodes.
+  const bool full = nodes_.length() >= max_nodes_;
+  const intptr_t name_index = InternString(name, full);
+  const intptr_t url_index = InternString(url, full);
+  if ((name_index < 0) || (url_index < 0)) {
+    return -1;
+  }
+
+  const IndexPairTrait::Key function_key = {name_index, url_index};
+  intptr_t function;
+  if (auto pair = function_indices_.Lookup(function_key)) {
+    function = pair->value;
+  } else if (full) {
+    return -1;
+  } else {
+    function = functions_.length();
+    functions_.Add({name_index, url_index});
+    function_indices_.Insert({function_key, function});
+  }
+
+  const IndexPairTrait::Key child_key = {parent, function};
+  if (auto pair = children_.Lookup(child_key)) {
+    return pair->value;
+  }
+  if (full) {
+    return -1;
+  }
+  const intptr_t node = nodes_.length();
+  nodes_.Add({parent, function, 0});
+  children_.Insert({child_key, node});
+  return node;
+}
+
+void AggregatedCpuProfile::Clear() {
+  for (intptr_t i = 0; i < strings_.length(); i++) {
+    free(strings_[i]);
+  }
+  strings_.Clear();
+  string_indices_.Clear();
+  functions_.Clear();
+  function_indices_.Clear();
+  nodes_.Clear();
+  children_.Clear();
+  sample_count_ = 0;
+  truncated_sample_count_ = 0;
+  start_time_micros_ = OS::GetCurrentTimeMicros();
+
+  // The first entry of the string table of a pprof profile is empty.
+  InternString("", /*lookup_only=*/false);
+  nodes_.Add({-1, -1, 0});
+}
+
+// Field numbers and wire types of the messages of profile.proto.
+enum PprofField {
+  kProfileSampleType = 1,
+  kProfileSample = 2,
+  kProfileLocation = 4,
+  kProfileFunction = 5,
+  kProfileStringTable = 6,
+  kProfileTimeNanos = 9,
+  kProfileDurationNanos = 10,
+  kProfilePeriodType = 11,
+  kProfilePeriod = 12,
+  kValueTypeType = 1,
+  kValueTypeUnit = 2,
+  kSampleLocationId = 1,
+  kSampleValue = 2,
+  kLocationId = 1,
+  kLocationLine = 4,
+  kLineFunctionId = 1,
+  kFunctionId = 1,
+  kFunctionName = 2,
+  kFunctionSystemName = 3,
+  kFunctionFilename = 4,
+};
+
+static constexpr uint64_t kVarintWireType = 0;
+static constexpr uint64_t kLengthDelimitedWireType = 2;
+
+static void WriteVarint(MallocWriteStream* stream,
+                        PprofField field,
+                        uint64_t value) {
+  stream->WriteLEB128<uint64_t>((field << 3) | kVarintWireType);
+  stream->WriteLEB128<uint64_t>(value);
+}
+
+static void WriteBytes(MallocWriteStream* stream,
+                       PprofField field,
+                       const void* bytes,
+                       intptr_t length) {
+  stream->WriteLEB128<uint64_t>((field << 3) | kLengthDelimitedWireType);
+  stream->WriteLEB128<uint64_t>(length);
+  stream->WriteBytes(bytes, length);
+}
+
+// Writes the message in |message| as |field| of |stream| and resets
+// |message| for the next one.
+static void WriteMessage(MallocWriteStream* stream,
+                         PprofField field,
+                         MallocWriteStream* message) {
+  WriteBytes(stream, field, message->buffer(), message->bytes_written());
+  message->SetPosition(0);
+}
+
+uint8_t* AggregatedCpuProfile::TakePprof(intptr_t period_micros,
+                                         intptr_t* length) {
+  MutexLocker ml(&mutex_);
+  if (sample_count_ == 0) {
+    *length = 0;
+    return nullptr;
+  }
+  const intptr_t samples_index = InternString("samples", false);
+  const intptr_t count_index = InternString("count", false);
+  const intptr_t cpu_index = InternString("cpu", false);
+  const intptr_t nanoseconds_index = InternString("nanoseconds", false);
+  const int64_t period_nanos = period_micros * kNanosecondsPerMicrosecond;
+
+  MallocWriteStream stream(64 * KB);
+  MallocWriteStream message(KB);
+  MallocWriteStream inner(64);
+
+  WriteVarint(&message, kValueTypeType, samples_index);
+  WriteVarint(&message, kValueTypeUnit, count_index);
+  WriteMessage(&stream, kProfileSampleType, &message);
+  WriteVarint(&message, kValueTypeType, cpu_index);
+  WriteVarint(&message, kValueTypeUnit, nanoseconds_index);
+  WriteMessage(&stream, kProfileSampleType, &message);
+
+  for (intptr_t i = 0; i < nodes_.length(); i++) {
+    const int64_t count = nodes_[i].exclusive_count;
+    if (count == 0) {
+      continue;
+    }
+    // Locations are listed from the top of the stack. Each function has a
+    // single location with the same id.
+    for (intptr_t node = i; node > 0; node = nodes_[node].parent) {
+      inner.WriteLEB128<uint64_t>(nodes_[node].function + 1);
+    }
+    WriteMessage(&message, kSampleLocationId, &inner);
+    inner.WriteLEB128<uint64_t>(count);
+    inner.WriteLEB128<uint64_t>(count * period_nanos);
+    WriteMessage(&message, kSampleValue, &inner);
+    WriteMessage(&stream, kProfileSample, &message);
+  }
+
+  for (intptr_t i = 0; i < functions_.length(); i++) {
+    WriteVarint(&message, kLocationId, i + 1);
+    WriteVarint(&inner, kLineFunctionId, i + 1);
+    WriteMessage(&message, kLocationLine, &inner);
+    WriteMessage(&stream, kProfileLocation, &message);
+  }
+
+  for (intptr_t i = 0; i < functions_.length(); i++) {
+    WriteVarint(&message, kFunctionId, i + 1);
+    WriteVarint(&message, kFunctionName, functions_[i].name);
+    WriteVarint(&message, kFunctionSystemName, functions_[i].name);
+    WriteVarint(&message, kFunctionFilename, functions_[i].url);
+    WriteMessage(&stream, kProfileFunction, &message);
+  }
+
+  for (intptr_t i = 0; i < strings_.length(); i++) {
+    WriteBytes(&stream, kProfileStringTable, strings_[i], strlen(strings_[i]));
+  }
+
+  const int64_t now = OS::GetCurrentTimeMicros();
+  WriteVarint(&stream, kProfileTimeNanos,
+              start_time_micros_ * kNanosecondsPerMicrosecond);
+  WriteVarint(&stream, kProfileDurationNanos,
+              (now - start_time_micros_) * kNanosecondsPerMicrosecond);
+  WriteVarint(&message, kValueTypeType, cpu_index);
+  WriteVarint(&message, kValueTypeUnit, nanoseconds_index);
+  WriteMessage(&stream, kProfilePeriodType, &message);
+  WriteVarint(&stream, kProfilePeriod, period_nanos);
+
+  Clear();
+  return stream.Steal(length);
+}
+
+Mutex* CpuProfileExporter::mutex_ = nullptr;
+AggregatedCpuProfile* CpuProfileExporter::profile_ = nullptr;
+RelaxedAtomic<Dart_CpuProfileExportCallback> CpuProfileExporter::callback_ = {
+    nullptr};
+void* CpuProfileExporter::context_ = nullptr;
+int64_t CpuProfileExporter::period_micros_ = 0;
+int64_t CpuProfileExporter::last_export_micros_ = 0;
+
+void CpuProfileExporter::Init() {
+  if (mutex_ == nullptr) {
+    mutex_ = new Mutex();
+  }
+  if (profile_ == nullptr) {
+    profile_ = new AggregatedCpuProfile(FLAG_profile_export_max_nodes);
+  }
+}
+
+void CpuProfileExporter::Cleanup() {
+  if (enabled()) {
+    Export();
+  }
+}
+
+void CpuProfileExporter::SetCallback(Dart_CpuProfileExportCallback callback,
+                                     void* context,
+                                     int64_t period_micros) {
+  if (mutex_ == nullptr) {
+    // Called before Dart_Initialize.
+    return;
+  }
+  MutexLocker ml(mutex_);
+  callback_ = callback;
+  context_ = context;
+  period_micros_ = period_micros;
+  last_export_micros_ = OS::GetCurrentMonotonicMicros();
+  if (callback == nullptr) {
+    intptr_t length;
+    free(profile_->TakePprof(FLAG_profile_period, &length));
+  }
+}
+
+void CpuProfileExporter::AddSamples(Profile* profile) {
+  if (enabled()) {
+    profile_->Add(profile);
+  }
+}
+
+void CpuProfileExporter::MaybeExport() {
+  if (!enabled()) {
+    return;
+  }
+  {
+    MutexLocker ml(mutex_);
+    const int64_t now = OS::GetCurrentMonotonicMicros();
+    if ((now - last_export_micros_) < period_micros_) {
+      return;
+    }
+    last_export_micros_ = now;
+  }
+  Export();
+}
+
+void CpuProfileExporter::Export() {
+  intptr_t length;
+  uint8_t* buffer = profile_->TakePprof(FLAG_profile_period, &length);
+  if (buffer == nullptr) {
+    return;
+  }
+  {
+    // Holding the lock ensures that the callback is not invoked after it was
+    // replaced.
+    MutexLocker ml(mutex_);
+    if (callback_ != nullptr) {
+      callback_.load()(context_, buffer, length);
+    }
+  }
+  free(buffer);
+}
+
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
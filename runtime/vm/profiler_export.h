@@ -0,0 +1,141 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_PROFILER_EXPORT_H_
+#define RUNTIME_VM_PROFILER_EXPORT_H_
+
+#include "include/dart_tools_api.h"
+
+#include "platform/atomic.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/growable_array.h"
+#include "vm/hash.h"
+#include "vm/hash_map.h"
+#include "vm/os_thread.h"
+
+// Continuous CPU profiling: samples are aggregated into a call tree in the
+// background and periodically exported to the embedder in pprof format.
+// NOTE: For the profile model of the service protocol, see profiler_service.h.
+
+namespace dart {
+
+#if !defined(PRODUCT)
+
+class Profile;
+
+// A call tree of CPU samples which outlives the sample blocks it is built
+// from. Functions are interned by name and script, so samples keep their
+// place in the tree when code is recompiled or collected.
+class AggregatedCpuProfile {
+ public:
+  // At most |max_nodes| nodes, including the root, are allocated. Samples
+  // whose path does not fit are counted for the deepest caller in the tree.
+  explicit AggregatedCpuProfile(intptr_t max_nodes);
+  ~AggregatedCpuProfile();
+
+  // Adds the CPU samples of |profile|, allocation samples are ignored. Must
+  // be called with a current thread inside the isolate group of |profile|.
+  void Add(Profile* profile);
+
+  intptr_t sample_count() const { return sample_count_; }
+  intptr_t truncated_sample_count() const { return truncated_sample_count_; }
+  intptr_t num_nodes() const { return nodes_.length(); }
+
+  // Returns a pprof profile (profile.proto) of the samples added since the
+  // previous call and clears the tree, or nullptr if there are no samples.
+  // The caller owns the returned malloc'd buffer.
+  uint8_t* TakePprof(intptr_t period_micros, intptr_t* length);
+
+ private:
+  struct IndexPairTrait {
+    struct Key {
+      intptr_t first;
+      intptr_t second;
+    };
+    using Value = intptr_t;
+    struct Pair {
+      Key key = {-1, -1};
+      Value value = -1;
+      Pair() {}
+      Pair(const Key& key, Value value) : key(key), value(value) {}
+    };
+
+    static Key KeyOf(const Pair& pair) { return pair.key; }
+    static Value ValueOf(const Pair& pair) { return pair.value; }
+    static uword Hash(const Key& key) {
+      return FinalizeHash(CombineHashes(key.first, key.second));
+    }
+    static bool IsKeyEqual(const Pair& pair, const Key& key) {
+      return (pair.key.first == key.first) && (pair.key.second == key.second);
+    }
+  };
+
+  struct FunctionEntry {
+    intptr_t name;
+    intptr_t url;
+  };
+
+  struct Node {
+    intptr_t parent;
+    intptr_t function;
+    int64_t exclusive_count;
+  };
+
+  void Clear();
+  // Returns -1 if |lookup_only| and |str| is not interned yet.
+  intptr_t InternString(const char* str, bool lookup_only);
+  // Returns the child of |parent| for the function |name| in the script
+  // |url|, or -1 if the tree is full.
+  intptr_t ChildOf(intptr_t parent, const char* name, const char* url);
+
+  const intptr_t max_nodes_;
+  Mutex mutex_;
+  MallocGrowableArray<char*> strings_;
+  MallocDirectChainedHashMap<CStringIntMapKeyValueTrait> string_indices_;
+  MallocGrowableArray<FunctionEntry> functions_;
+  MallocDirectChainedHashMap<IndexPairTrait> function_indices_;
+  MallocGrowableArray<Node> nodes_;
+  MallocDirectChainedHashMap<IndexPairTrait> children_;
+  intptr_t sample_count_ = 0;
+  intptr_t truncated_sample_count_ = 0;
+  int64_t start_time_micros_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(AggregatedCpuProfile);
+};
+
+// Exports the samples of all isolates to the callback registered with
+// Dart_SetCpuProfileExportCallback.
+class CpuProfileExporter : public AllStatic {
+ public:
+  static void Init();
+  static void Cleanup();
+
+  static void SetCallback(Dart_CpuProfileExportCallback callback,
+                          void* context,
+                          int64_t period_micros);
+  static bool enabled() { return callback_ != nullptr; }
+
+  static void AddSamples(Profile* profile);
+
+  // Exports the aggregated profile if the export period has elapsed. Called
+  // periodically by the SampleBlockProcessor.
+  static void MaybeExport();
+
+ private:
+  static void Export();
+
+  static Mutex* mutex_;
+  static AggregatedCpuProfile* profile_;
+  static RelaxedAtomic<Dart_CpuProfileExportCallback> callback_;
+  static void* context_;
+  static int64_t period_micros_;
+  static int64_t last_export_micros_;
+};
+
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_PROFILER_EXPORT_H_
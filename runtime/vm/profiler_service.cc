@@ -10,6 +10,7 @@
 #include "vm/growable_array.h"
 #include "vm/hash_map.h"
 #include "vm/heap/safepoint.h"
+#include "vm/heap/sampler.h"
 #include "vm/json_stream.h"
 #include "vm/log.h"
 #include "vm/native_symbol.h"
@@ -1789,6 +1790,10 @@ void Profile::PrintSamplesJSON(JSONObject* obj, bool code_samples) {
       sample_obj.AddProperty64("classId", sample->allocation_cid());
       sample_obj.AddProperty64("identityHashCode",
                                sample->allocation_identity_hash());
+      if (sample->allocation_sampled_bytes() > 0) {
+        sample_obj.AddProperty64("_sampledBytes",
+                                 sample->allocation_sampled_bytes());
+      }
     }
   }
 }
@@ -1866,6 +1871,65 @@ ProfileFunction* Profile::FindFunction(const Function& function) {
   return (functions_ != nullptr) ? functions_->Lookup(function) : nullptr;
 }
 
+void Profile::PrintSampledAllocationSitesJSON(JSONObject* obj) {
+  // A function's exclusive bytes were sampled while it was the top visible
+  // frame; its inclusive bytes were sampled while it was anywhere on the
+  // stack. Inlined frames are attributed to the function they were inlined
+  // into.
+  const intptr_t num_functions = functions_->length();
+  intptr_t* exclusive = zone_->Alloc<intptr_t>(num_functions);
+  intptr_t* inclusive = zone_->Alloc<intptr_t>(num_functions);
+  intptr_t* last_sample = zone_->Alloc<intptr_t>(num_functions);
+  for (intptr_t i = 0; i < num_functions; i++) {
+    exclusive[i] = 0;
+    inclusive[i] = 0;
+    last_sample[i] = -1;
+  }
+
+  for (intptr_t sample_index = 0; sample_index < samples_->length();
+       sample_index++) {
+    ProcessedSample* sample = samples_->At(sample_index);
+    const intptr_t bytes = sample->allocation_sampled_bytes();
+    if (bytes == 0) {
+      continue;
+    }
+    bool is_leaf = true;
+    for (intptr_t frame_index = 0; frame_index < sample->length();
+         frame_index++) {
+      ProfileCode* code =
+          GetCodeFromPC(sample->At(frame_index), sample->timestamp());
+      ASSERT(code != nullptr);
+      ProfileFunction* function = code->function();
+      ASSERT(function != nullptr);
+      if (!function->is_visible() ||
+          (function->kind() == ProfileFunction::kStubFunction)) {
+        continue;
+      }
+      const intptr_t index = function->table_index();
+      if (is_leaf) {
+        exclusive[index] += bytes;
+        is_leaf = false;
+      }
+      // Count recursive frames only once per sample.
+      if (last_sample[index] != sample_index) {
+        inclusive[index] += bytes;
+        last_sample[index] = sample_index;
+      }
+    }
+  }
+
+  JSONArray sites(obj, "_allocationSites");
+  for (intptr_t i = 0; i < num_functions; i++) {
+    if (inclusive[i] == 0) {
+      continue;
+    }
+    JSONObject site(&sites);
+    site.AddProperty64("function", i);
+    site.AddProperty64("exclusiveBytes", exclusive[i]);
+    site.AddProperty64("inclusiveBytes", inclusive[i]);
+  }
+}
+
 void Profile::PrintProfileJSON(JSONStream* stream, bool include_code_samples) {
   JSONObject obj(stream);
   PrintProfileJSON(&obj, include_code_samples);
@@ -2103,7 +2167,12 @@ class AllocationSampleFilter : public SampleFilter {
                      time_origin_micros,
                      time_extent_micros) {}
 
-  bool FilterSample(Sample* sample) { return sample->is_allocation_sample(); }
+  // Samples recorded by the heap sampling profiler are reported through
+  // PrintSampledAllocationJSON instead.
+  bool FilterSample(Sample* sample) {
+    return sample->is_allocation_sample() &&
+           (sample->allocation_sampled_bytes() == 0);
+  }
 };
 
 void ProfilerService::PrintAllocationJSON(JSONStream* stream,
@@ -2134,6 +2203,7 @@ class ClassAllocationSampleFilter : public SampleFilter {
 
   bool FilterSample(Sample* sample) {
     return sample->is_allocation_sample() &&
+           (sample->allocation_sampled_bytes() == 0) &&
            (sample->allocation_cid() == cls_.id());
   }
 
@@ -2154,6 +2224,48 @@ void ProfilerService::PrintAllocationJSON(JSONStream* stream,
                   Profiler::sample_block_buffer(), true);
 }
 
+class SampledAllocationSampleFilter : public SampleFilter {
+ public:
+  SampledAllocationSampleFilter(Dart_Port port,
+                                intptr_t thread_task_mask,
+                                int64_t time_origin_micros,
+                                int64_t time_extent_micros)
+      : SampleFilter(port,
+                     thread_task_mask,
+                     time_origin_micros,
+                     time_extent_micros) {}
+
+  bool FilterSample(Sample* sample) {
+    return sample->is_allocation_sample() &&
+           (sample->allocation_sampled_bytes() > 0);
+  }
+};
+
+void ProfilerService::PrintSampledAllocationJSON(JSONStream* stream,
+                                                 int64_t time_origin_micros,
+                                                 int64_t time_extent_micros) {
+  Thread* thread = Thread::Current();
+  Isolate* isolate = thread->isolate();
+  SampledAllocationSampleFilter filter(isolate->main_port(),
+                                       Thread::kMutatorTask,
+                                       time_origin_micros, time_extent_micros);
+  ASSERT(Profiler::sample_block_buffer() != nullptr);
+
+  StackZone zone(thread);
+  Profile profile;
+  profile.Build(thread, isolate, &filter, Profiler::sample_block_buffer());
+
+  JSONObject obj(stream);
+  profile.PrintProfileJSON(&obj, /*include_code_samples=*/true);
+  profile.PrintSampledAllocationSitesJSON(&obj);
+  const intptr_t sampled = HeapProfileSampler::sampled_bytes();
+  const intptr_t freed = HeapProfileSampler::freed_sampled_bytes();
+  obj.AddProperty("_enabled", HeapProfileSampler::allocation_profile_enabled());
+  obj.AddProperty64("_sampledBytes", sampled);
+  obj.AddProperty64("_freedSampledBytes", freed);
+  obj.AddProperty64("_liveSampledBytes", sampled - freed);
+}
+
 void ProfilerService::ClearSamples() {
   SampleBlockBuffer* sample_block_buffer = Profiler::sample_block_buffer();
   if (sample_block_buffer == nullptr) {
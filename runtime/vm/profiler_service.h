@@ -400,6 +400,10 @@ class Profile : public ValueObject {
 
   ProfileFunction* FindFunction(const Function& function);
 
+  // Prints the sampled bytes of the profile's samples aggregated by function
+  // into |obj|. See HeapProfileSampler::EnableAllocationProfile.
+  void PrintSampledAllocationSitesJSON(JSONObject* obj);
+
  private:
   void PrintHeaderJSON(JSONObject* obj);
   void ProcessSampleFrameJSON(JSONArray* stack,
@@ -469,6 +473,15 @@ class ProfilerService : public AllStatic {
                                   int64_t time_origin_micros,
                                   int64_t time_extent_micros);
 
+  /*
+   * Prints the samples recorded by the heap sampling profiler's allocation
+   * profile mode, along with their sampled bytes aggregated by function and
+   * the live and freed sampled byte totals.
+   */
+  static void PrintSampledAllocationJSON(JSONStream* stream,
+                                         int64_t time_origin_micros,
+                                         int64_t time_extent_micros);
+
   static void ClearSamples();
 
  private:
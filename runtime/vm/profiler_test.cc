@@ -8,7 +8,9 @@
 #include "vm/dart_api_state.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/heap/sampler.h"
 #include "vm/profiler.h"
+#include "vm/profiler_export.h"
 #include "vm/profiler_service.h"
 #include "vm/source_report.h"
 #include "vm/symbols.h"
@@ -532,6 +534,63 @@ ISOLATE_UNIT_TEST_CASE(Profiler_TrivialRecordAllocation) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(Profiler_SampledAllocationProfile) {
+  EnableProfiler();
+  DisableNativeProfileScope dnps;
+  DisableBackgroundCompilationScope dbcs;
+  const char* kScript =
+      "class A {\n"
+      "  var a;\n"
+      "  var b;\n"
+      "}\n"
+      "main() {\n"
+      "  var list = [];\n"
+      "  for (int i = 0; i < 10000; i++) {\n"
+      "    list.add(new A());\n"
+      "  }\n"
+      "  return list.length;\n"
+      "}\n";
+
+  const Library& root_library = Library::Handle(LoadTestScript(kScript));
+  const Class& class_a = Class::Handle(GetClass(root_library, "A"));
+  EXPECT(!class_a.IsNull());
+
+  HeapProfileSampler::ResetAllocationProfileCounters();
+  HeapProfileSampler::SetSamplingInterval(1 * KB);
+  HeapProfileSampler::EnableAllocationProfile(true);
+  // Threads pick up sampler state changes when they handle interrupts.
+  thread->HandleInterrupts();
+
+  Invoke(root_library, "main");
+
+  HeapProfileSampler::EnableAllocationProfile(false);
+  HeapProfileSampler::SetSamplingInterval(512 * KB);
+  thread->HandleInterrupts();
+
+  {
+    Isolate* isolate = thread->isolate();
+    StackZone zone(thread);
+    Profile profile;
+    AllocationFilter filter(isolate->main_port(), class_a.id());
+    profile.Build(thread, isolate, &filter, Profiler::sample_block_buffer());
+    // A is not traced, so every sample comes from the heap sampler and
+    // carries the number of bytes it accounts for.
+    EXPECT(profile.sample_count() > 0);
+    EXPECT(profile.sample_count() < 10000);
+    for (intptr_t i = 0; i < profile.sample_count(); i++) {
+      EXPECT(profile.SampleAt(i)->allocation_sampled_bytes() > 0);
+    }
+  }
+  EXPECT(HeapProfileSampler::sampled_bytes() > 0);
+
+  // The list is garbage once main returns, so a full GC accounts all of the
+  // sampled bytes as freed.
+  GCTestHelper::CollectAllGarbage();
+  EXPECT(HeapProfileSampler::freed_sampled_bytes() > 0);
+  EXPECT(HeapProfileSampler::freed_sampled_bytes() <=
+         HeapProfileSampler::sampled_bytes());
+}
+
 ISOLATE_UNIT_TEST_CASE(Profiler_NullSampleBuffer) {
   Isolate* isolate = thread->isolate();
 
@@ -2329,6 +2388,123 @@ ISOLATE_UNIT_TEST_CASE(Profiler_GetSourceReport) {
   EXPECT_SUBSTRING("\"inclusiveTicks\":[2]", js.ToCString());
 }
 
+ISOLATE_UNIT_TEST_CASE(Profiler_AggregatedCpuProfile) {
+  EnableProfiler();
+  const char* kScript =
+      "int doWork(i) => i * i;\n"
+      "int main() {\n"
+      "  int sum = 0;\n"
+      "  for (int i = 0; i < 100; i++) {\n"
+      "     sum += doWork(i);\n"
+      "  }\n"
+      "  return sum;\n"
+      "}\n";
+
+  DisableNativeProfileScope dnps;
+  // Disable profiling for this thread.
+  DisableThreadInterruptsScope dtis(Thread::Current());
+
+  DisableBackgroundCompilationScope dbcs;
+
+  SampleBlockBuffer* sample_block_buffer = Profiler::sample_block_buffer();
+  ASSERT(sample_block_buffer != nullptr);
+
+  const Library& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+
+  {
+    // Clear the profile for this isolate.
+    ClearProfileVisitor cpv(Isolate::Current());
+    sample_block_buffer->VisitSamples(&cpv);
+  }
+
+  const Function& main = Function::Handle(GetFunction(root_library, "main"));
+  const Function& do_work =
+      Function::Handle(GetFunction(root_library, "doWork"));
+  const Code& main_code = Code::Handle(main.CurrentCode());
+  const Code& do_work_code = Code::Handle(do_work.CurrentCode());
+  const uword main_pc = main_code.PayloadStart() + 1;
+  const uword do_work_pc = do_work_code.PayloadStart() + 1;
+
+  uword sample1[] = {do_work_pc, main_pc, 0};
+  uword sample2[] = {do_work_pc, 0};
+  InsertFakeSample(&sample1[0]);
+  InsertFakeSample(&sample2[0]);
+  InsertFakeSample(&sample1[0]);
+
+  Isolate* isolate = Isolate::Current();
+  SampleFilter filter(isolate->main_port(), SampleFilter::kNoTaskFilter, -1,
+                      -1);
+  Profile profile;
+  profile.Build(Thread::Current(), isolate, &filter, sample_block_buffer);
+
+  {
+    AggregatedCpuProfile aggregate(/*max_nodes=*/100);
+    aggregate.Add(&profile);
+    aggregate.Add(&profile);
+    EXPECT_EQ(6, aggregate.sample_count());
+    EXPECT_EQ(0, aggregate.truncated_sample_count());
+    // The root, main, main -> doWork and doWork.
+    EXPECT_EQ(4, aggregate.num_nodes());
+
+    intptr_t length;
+    uint8_t* pprof = aggregate.TakePprof(1000, &length);
+    EXPECT(pprof != nullptr);
+    // Starts with the first sample type.
+    EXPECT_EQ(0x0a, pprof[0]);
+    // The string table holds the function names.
+    const char* name = "doWork";
+    const intptr_t name_length = strlen(name);
+    bool found = false;
+    for (intptr_t i = 0; i + name_length <= length; i++) {
+      found = found || (memcmp(pprof + i, name, name_length) == 0);
+    }
+    EXPECT(found);
+    free(pprof);
+
+    EXPECT_EQ(0, aggregate.sample_count());
+    EXPECT_EQ(1, aggregate.num_nodes());
+    EXPECT(aggregate.TakePprof(1000, &length) == nullptr);
+  }
+
+  {
+    // Only main fits, doWork is counted for its caller.
+    AggregatedCpuProfile aggregate(/*max_nodes=*/2);
+    aggregate.Add(&profile);
+    EXPECT_EQ(3, aggregate.sample_count());
+    EXPECT_EQ(3, aggregate.truncated_sample_count());
+    EXPECT_EQ(2, aggregate.num_nodes());
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(Profiler_CodeLookupTableIncremental) {
+  EnableProfiler();
+  DisableBackgroundCompilationScope dbcs;
+
+  CodeLookupTable* before = new CodeLookupTable(thread);
+
+  const char* kScript =
+      "int doWork(i) => i * i;\n"
+      "int main() => doWork(42);\n";
+  const Library& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+  const Function& main = Function::Handle(GetFunction(root_library, "main"));
+  const Code& main_code = Code::Handle(main.CurrentCode());
+  const uword main_pc = main_code.PayloadStart();
+
+  // The code installed since the previous table was recorded.
+  CodeLookupTable* after = new CodeLookupTable(thread);
+  EXPECT(before->FindCode(main_pc) == nullptr);
+  EXPECT(after->FindCode(main_pc) != nullptr);
+  EXPECT(after->length() > before->length());
+
+  // The same table is built from the heap.
+  CodeLookupTable::Invalidate(thread);
+  CodeLookupTable* from_heap = new CodeLookupTable(thread);
+  EXPECT_EQ(after->length(), from_heap->length());
+  EXPECT(from_heap->FindCode(main_pc) != nullptr);
+}
+
 ISOLATE_UNIT_TEST_CASE(Profiler_ProfileCodeTableTest) {
   Zone* Z = Thread::Current()->zone();
 
@@ -17,6 +17,12 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            print_dedup_statistics,
+            false,
+            "Print the number and size of the objects replaced by identical "
+            "ones while deduplicating the program.");
+
 class WorklistElement : public ZoneAllocated {
  public:
   WorklistElement(Zone* zone, const Object& object)
@@ -268,6 +274,25 @@ void ProgramVisitor::WalkProgram(Zone* zone,
       }
       set.Release();
     }
+
+    // Specializations of regexps compiled by the precompiler, which are only
+    // reachable from their RegExp.
+    const auto& regexps =
+        Array::Handle(zone, object_store->precompiled_regexps());
+    if (!regexps.IsNull()) {
+      auto& regexp = RegExp::Handle(zone);
+      auto& function = Function::Handle(zone);
+      for (intptr_t i = 0; i < regexps.Length(); i++) {
+        regexp ^= regexps.At(i);
+        for (intptr_t cid = kOneByteStringCid; cid <= kTwoByteStringCid;
+             cid++) {
+          for (const bool sticky : {false, true}) {
+            function = regexp.function(cid, sticky);
+            walker.AddToWorklist(function);
+          }
+        }
+      }
+    }
   }
 
   if (visitor->IsCodeVisitor()) {
@@ -331,6 +356,13 @@ class Deduper : public ValueObject {
   typename T::ObjectPtrType Dedup(const T& obj) {
     if (ShouldAdd(obj)) {
       if (auto const canonical = canonical_objects_.LookupValue(&obj)) {
+        if (canonical->ptr() != obj.ptr()) {
+          const intptr_t size = DuplicateSize(obj, *canonical);
+          if (size > 0) {
+            duplicate_count_++;
+            duplicate_bytes_ += size;
+          }
+        }
         return canonical->ptr();
       }
       AddCanonical(obj);
@@ -338,8 +370,27 @@ class Deduper : public ValueObject {
     return obj.ptr();
   }
 
+  // The number of bytes saved by replacing [obj] with [canonical]. Objects
+  // are visited once per reference, so this must return 0 for an object whose
+  // references have all been replaced already.
+  virtual intptr_t DuplicateSize(const T& obj, const T& canonical) const {
+    return obj.ptr()->untag()->HeapSize();
+  }
+
+ public:
+  // Prints the duplicates replaced so far, under [name], if requested with
+  // --print_dedup_statistics.
+  void PrintStatistics(const char* name) const {
+    if (!FLAG_print_dedup_statistics) return;
+    OS::Print("Dedup%s: %" Pd " duplicates, %" Pd " bytes\n", name,
+              duplicate_count_, duplicate_bytes_);
+  }
+
+ protected:
   Zone* const zone_;
   DirectChainedHashMap<S> canonical_objects_;
+  intptr_t duplicate_count_ = 0;
+  intptr_t duplicate_bytes_ = 0;
 };
 
 void ProgramVisitor::BindStaticCalls(Thread* thread) {
@@ -725,6 +776,7 @@ void ProgramVisitor::NormalizeAndDedupCompressedStackMaps(Thread* thread) {
   NormalizeAndDedupCompressedStackMapsVisitor visitor(thread->zone(),
                                                       thread->isolate_group());
   WalkProgram(thread->zone(), thread->isolate_group(), &visitor);
+  visitor.PrintStatistics("CompressedStackMaps");
 }
 
 class PcDescriptorsKeyValueTrait {
@@ -771,6 +823,93 @@ void ProgramVisitor::DedupPcDescriptors(Thread* thread) {
   StackZone stack_zone(thread);
   DedupPcDescriptorsVisitor visitor(thread->zone());
   WalkProgram(thread->zone(), thread->isolate_group(), &visitor);
+  visitor.PrintStatistics("PcDescriptors");
+}
+
+class ExceptionHandlersKeyValueTrait {
+ public:
+  // Typedefs needed for the DirectChainedHashMap template.
+  typedef const ExceptionHandlers* Key;
+  typedef const ExceptionHandlers* Value;
+  typedef const ExceptionHandlers* Pair;
+
+  static Key KeyOf(Pair kv) { return kv; }
+
+  static Value ValueOf(Pair kv) { return kv; }
+
+  static inline uword Hash(Key key) {
+    uint32_t hash = key->num_entries();
+    for (intptr_t i = 0; i < key->num_entries(); i++) {
+      hash = CombineHashes(hash, key->HandlerPCOffset(i));
+    }
+    return FinalizeHash(hash);
+  }
+
+  static inline bool IsKeyEqual(Pair pair, Key key) {
+    if (pair->num_entries() != key->num_entries() ||
+        pair->has_async_handler() != key->has_async_handler()) {
+      return false;
+    }
+    ExceptionHandlerInfo pair_info, key_info;
+    for (intptr_t i = 0; i < key->num_entries(); i++) {
+      pair->GetHandlerInfo(i, &pair_info);
+      key->GetHandlerInfo(i, &key_info);
+      if (pair_info.handler_pc_offset != key_info.handler_pc_offset ||
+          pair_info.outer_try_index != key_info.outer_try_index ||
+          pair_info.needs_stacktrace != key_info.needs_stacktrace ||
+          pair_info.has_catch_all != key_info.has_catch_all ||
+          pair_info.is_generated != key_info.is_generated) {
+        return false;
+      }
+      if (!HasSameTypes(pair->GetHandledTypes(i), key->GetHandledTypes(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  // The handled types are canonical, so they are compared by identity.
+  static bool HasSameTypes(ArrayPtr a, ArrayPtr b) {
+    if (a == b) return true;
+    if (a == Array::null() || b == Array::null()) return false;
+    const intptr_t length = Smi::Value(a->untag()->length());
+    if (length != Smi::Value(b->untag()->length())) return false;
+    for (intptr_t i = 0; i < length; i++) {
+      if (a->untag()->element(i) != b->untag()->element(i)) return false;
+    }
+    return true;
+  }
+};
+
+void ProgramVisitor::DedupExceptionHandlers(Thread* thread) {
+  class DedupExceptionHandlersVisitor
+      : public CodeVisitor,
+        public Deduper<ExceptionHandlers, ExceptionHandlersKeyValueTrait> {
+   public:
+    explicit DedupExceptionHandlersVisitor(Zone* zone)
+        : Deduper(zone), handlers_(ExceptionHandlers::Handle(zone)) {
+      AddCanonical(Object::empty_exception_handlers());
+      AddCanonical(Object::empty_async_exception_handlers());
+    }
+
+    void VisitCode(const Code& code) {
+      handlers_ = code.exception_handlers();
+      handlers_ = Dedup(handlers_);
+      code.set_exception_handlers(handlers_);
+    }
+
+   private:
+    ExceptionHandlers& handlers_;
+  };
+
+  StackZone stack_zone(thread);
+  // The handled types are compared by address, so make sure GC doesn't move
+  // them.
+  NoSafepointScope no_safepoint;
+  DedupExceptionHandlersVisitor visitor(thread->zone());
+  WalkProgram(thread->zone(), thread->isolate_group(), &visitor);
+  visitor.PrintStatistics("ExceptionHandlers");
 }
 
 class TypedDataKeyValueTrait {
@@ -836,6 +975,7 @@ void ProgramVisitor::DedupDeoptEntries(Thread* thread) {
   StackZone stack_zone(thread);
   DedupDeoptEntriesVisitor visitor(thread->zone());
   WalkProgram(thread->zone(), thread->isolate_group(), &visitor);
+  visitor.PrintStatistics("DeoptEntries");
 }
 
 #if defined(DART_PRECOMPILER)
@@ -862,6 +1002,7 @@ void ProgramVisitor::DedupCatchEntryMovesMaps(Thread* thread) {
   StackZone stack_zone(thread);
   DedupCatchEntryMovesMapsVisitor visitor(thread->zone());
   WalkProgram(thread->zone(), thread->isolate_group(), &visitor);
+  visitor.PrintStatistics("CatchEntryMovesMaps");
 }
 
 class UnlinkedCallKeyValueTrait {
@@ -928,6 +1069,7 @@ void ProgramVisitor::DedupUnlinkedCalls(Thread* thread) {
   // Deduplicate local object pools as they are used to trace
   // objects when writing snapshots.
   WalkProgram(thread->zone(), thread->isolate_group(), &visitor);
+  visitor.PrintStatistics("UnlinkedCalls");
 }
 
 void ProgramVisitor::PruneSubclasses(Thread* thread) {
@@ -1042,6 +1184,7 @@ void ProgramVisitor::DedupCodeSourceMaps(Thread* thread) {
   StackZone stack_zone(thread);
   DedupCodeSourceMapsVisitor visitor(thread->zone());
   WalkProgram(thread->zone(), thread->isolate_group(), &visitor);
+  visitor.PrintStatistics("CodeSourceMaps");
 }
 
 class ArrayKeyValueTrait {
@@ -1127,6 +1270,7 @@ void ProgramVisitor::DedupLists(Thread* thread) {
   NoSafepointScope no_safepoint;
   DedupListsVisitor visitor(thread->zone());
   WalkProgram(thread->zone(), thread->isolate_group(), &visitor);
+  visitor.PrintStatistics("Lists");
 }
 
 // Traits for comparing two [Instructions] objects for equality, which is
@@ -1376,6 +1520,14 @@ void ProgramVisitor::DedupInstructions(Thread* thread) {
    private:
     bool CanCanonicalize(const Code& code) const { return !code.IsDisabled(); }
 
+    // The duplicate Code objects are dropped once the graph is relinked, so
+    // count their instructions, once.
+    intptr_t DuplicateSize(const Code& code,
+                           const Code& canonical) const override {
+      if (code.instructions() == canonical.instructions()) return 0;
+      return code.instructions()->untag()->HeapSize();
+    }
+
     CodePtr Canonicalize(const Code& code) {
       canonical_ = Dedup(code);
       if (!code.is_discarded() && canonical_.is_discarded()) {
@@ -1397,6 +1549,7 @@ void ProgramVisitor::DedupInstructions(Thread* thread) {
     DedupInstructionsWithSameMetadataVisitor visitor(thread->zone());
     WalkProgram(thread->zone(), thread->isolate_group(), &visitor);
     visitor.PostProcess(thread->isolate_group());
+    visitor.PrintStatistics("Instructions");
     return;
   }
 #endif  // defined(DART_PRECOMPILER)
@@ -1404,6 +1557,7 @@ void ProgramVisitor::DedupInstructions(Thread* thread) {
   StackZone stack_zone(thread);
   DedupInstructionsVisitor visitor(thread->zone());
   WalkProgram(thread->zone(), thread->isolate_group(), &visitor);
+  visitor.PrintStatistics("Instructions");
 }
 
 void ProgramVisitor::Dedup(Thread* thread) {
@@ -1411,6 +1565,7 @@ void ProgramVisitor::Dedup(Thread* thread) {
   ShareMegamorphicBuckets(thread);
   NormalizeAndDedupCompressedStackMaps(thread);
   DedupPcDescriptors(thread);
+  DedupExceptionHandlers(thread);
   DedupDeoptEntries(thread);
 #if defined(DART_PRECOMPILER)
   DedupCatchEntryMovesMaps(thread);
@@ -110,6 +110,7 @@ class ProgramVisitor : public AllStatic {
   static void ShareMegamorphicBuckets(Thread* thread);
   static void NormalizeAndDedupCompressedStackMaps(Thread* thread);
   static void DedupPcDescriptors(Thread* thread);
+  static void DedupExceptionHandlers(Thread* thread);
   static void DedupDeoptEntries(Thread* thread);
 #if defined(DART_PRECOMPILER)
   static void DedupCatchEntryMovesMaps(Thread* thread);
@@ -2019,6 +2019,9 @@ class UntaggedObjectPool : public UntaggedObject {
   friend class Object;
   friend class CodeSerializationCluster;
   friend class Interpreter;
+  template <bool>
+  friend class MarkingVisitorBase;
+  friend class PageSpace;
   friend class UnitSerializationRoots;
   friend class UnitDeserializationRoots;
 };
@@ -2310,11 +2313,36 @@ class UntaggedInstructionsTable : public UntaggedObject {
   };
   static_assert(sizeof(DataEntry) == sizeof(uint32_t) * 2);
 
+  // Two-level index narrowing down the binary search over the entries.
+  // The instructions are split into pages of kLookupPageSize bytes, which
+  // are split into kLookupSubPages sub-pages. For each page, |first_entry|
+  // is the index of the entry containing its first instruction and
+  // |sub_page_delta| the distance from it to the entry containing the first
+  // instruction of each sub-page, saturated at kMaxLookupDelta.
+  static constexpr intptr_t kLookupPageSizeLog2 = 12;
+  static constexpr intptr_t kLookupSubPagesLog2 = 4;
+  static constexpr intptr_t kLookupSubPages = 1 << kLookupSubPagesLog2;
+  static constexpr intptr_t kLookupSubPageSizeLog2 =
+      kLookupPageSizeLog2 - kLookupSubPagesLog2;
+  static constexpr uint8_t kMaxLookupDelta = 0xFF;
+
+  struct LookupPage {
+    uint32_t first_entry;
+    uint8_t sub_page_delta[kLookupSubPages];
+  };
+  static_assert(sizeof(LookupPage) == sizeof(uint32_t) * 5);
+
+  struct LookupIndex {
+    uint32_t length;
+
+    const LookupPage* pages() const { OPEN_ARRAY_START(LookupPage, uint32_t); }
+  };
+
   struct Data {
     uint32_t canonical_stack_map_entries_offset;
     uint32_t length;
     uint32_t first_entry_with_code;
-    uint32_t padding;
+    uint32_t lookup_index_offset;
 
     const DataEntry* entries() const { OPEN_ARRAY_START(DataEntry, uint32_t); }
 
@@ -2323,6 +2351,11 @@ class UntaggedInstructionsTable : public UntaggedObject {
       return reinterpret_cast<UntaggedCompressedStackMaps::Payload*>(
           reinterpret_cast<uword>(this) + offset);
     }
+
+    const LookupIndex* lookup_index() const {
+      return reinterpret_cast<const LookupIndex*>(
+          reinterpret_cast<uword>(this) + lookup_index_offset);
+    }
   };
   static_assert(sizeof(Data) == sizeof(uint32_t) * 4);
 
@@ -3557,7 +3590,10 @@ class UntaggedRegExp : public UntaggedInstance {
   COMPRESSED_POINTER_FIELD(ObjectPtr, two_byte)
   COMPRESSED_POINTER_FIELD(ObjectPtr, one_byte_sticky)
   COMPRESSED_POINTER_FIELD(ObjectPtr, two_byte_sticky)
-  VISIT_TO(two_byte_sticky)
+  // Literal which every match starts with, or null. Set together with the
+  // bytecode.
+  COMPRESSED_POINTER_FIELD(StringPtr, literal_prefix)
+  VISIT_TO(literal_prefix)
   CompressedObjectPtr* to_snapshot(Snapshot::Kind kind) { return to(); }
 
   std::atomic<intptr_t> num_bracket_expressions_;
@@ -11,11 +11,14 @@
 
 #include "unicode/uniset.h"
 
+#include "vm/canonical_tables.h"
 #include "vm/dart_entry.h"
+#include "vm/object_store.h"
 #include "vm/regexp/regexp_assembler.h"
 #include "vm/regexp/regexp_assembler_bytecode.h"
 #include "vm/regexp/regexp_ast.h"
 #include "vm/regexp/unibrow-inl.h"
+#include "vm/reusable_handles.h"
 #include "vm/symbols.h"
 #include "vm/thread.h"
 
@@ -27,6 +30,13 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            retained_regexps,
+            256,
+            "Number of recently created regexps which the isolate group keeps "
+            "alive, with their compiled code, for the next isolate which "
+            "creates them.");
+
 // Default to generating optimized regexp code.
 static constexpr bool kRegexpOptimization = true;
 
@@ -5411,6 +5421,71 @@ RegExpEngine::CompilationResult RegExpEngine::CompileIR(
 }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
+// Appends the literal which every match of |tree| starts with to |prefix|.
+// Returns whether |tree| matches exactly this literal, in which case the
+// literal of the tree following it can be appended as well.
+static bool AppendLiteralPrefix(RegExpTree* tree,
+                                ZoneGrowableArray<uint16_t>* prefix) {
+  if (tree->max_match() == 0) {
+    // Assertions and lookarounds do not consume any input.
+    return true;
+  }
+  if (tree->IsAtom()) {
+    ZoneGrowableArray<uint16_t>* data = tree->AsAtom()->data();
+    for (intptr_t i = 0; i < data->length(); i++) {
+      prefix->Add(data->At(i));
+    }
+    return true;
+  }
+  if (tree->IsText()) {
+    GrowableArray<TextElement>* elements = tree->AsText()->elements();
+    for (intptr_t i = 0; i < elements->length(); i++) {
+      const TextElement& element = elements->At(i);
+      if (element.text_type() != TextElement::ATOM) {
+        return false;
+      }
+      AppendLiteralPrefix(element.atom(), prefix);
+    }
+    return true;
+  }
+  if (tree->IsAlternative()) {
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      if (!AppendLiteralPrefix(nodes->At(i), prefix)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsCapture()) {
+    return AppendLiteralPrefix(tree->AsCapture()->body(), prefix);
+  }
+  if (tree->IsQuantifier()) {
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    if (quantifier->min() > 0) {
+      AppendLiteralPrefix(quantifier->body(), prefix);
+    }
+    return false;
+  }
+  // Disjunctions, character classes and back references.
+  return false;
+}
+
+StringPtr RegExpEngine::LiteralPrefix(RegExpCompileData* data,
+                                      RegExpFlags flags,
+                                      Zone* zone) {
+  // Anchored patterns only attempt a match at the start of the subject.
+  if (flags.IgnoreCase() || data->tree->IsAnchoredAtStart()) {
+    return String::null();
+  }
+  auto prefix = new (zone) ZoneGrowableArray<uint16_t>(zone, 16);
+  AppendLiteralPrefix(data->tree, prefix);
+  if (prefix->is_empty()) {
+    return String::null();
+  }
+  return String::FromUTF16(prefix->data(), prefix->length(), Heap::kOld);
+}
+
 RegExpEngine::CompilationResult RegExpEngine::CompileBytecode(
     RegExpCompileData* data,
     const RegExp& regexp,
@@ -5600,4 +5675,46 @@ RegExpPtr RegExpEngine::CreateRegExp(Thread* thread,
   return regexp.ptr();
 }
 
+RegExpPtr RegExpEngine::LookupCanonical(Thread* thread,
+                                        const String& pattern,
+                                        RegExpFlags flags) {
+  RegExpKey lookup_key(pattern, flags);
+  REUSABLE_OBJECT_HANDLESCOPE(thread);
+  REUSABLE_SMI_HANDLESCOPE(thread);
+  REUSABLE_WEAK_ARRAY_HANDLESCOPE(thread);
+  Object& key = thread->ObjectHandle();
+  Smi& value = thread->SmiHandle();
+  WeakArray& data = thread->WeakArrayHandle();
+  data = thread->isolate_group()->object_store()->regexp_table();
+  CanonicalRegExpSet table(&key, &value, &data);
+  const RegExpPtr regexp = RegExp::RawCast(table.GetOrNull(lookup_key));
+  table.Release();
+  return regexp;
+}
+
+RegExpPtr RegExpEngine::InsertCanonical(Thread* thread,
+                                        const String& pattern,
+                                        RegExpFlags flags) {
+  RegExpKey lookup_symbol_key(String::Handle(Symbols::New(thread, pattern)),
+                              flags);
+  auto object_store = thread->isolate_group()->object_store();
+  SafepointMutexLocker ml(thread->isolate_group()->symbols_mutex());
+  CanonicalRegExpSet table(thread->zone(), object_store->regexp_table());
+  const RegExp& regexp =
+      RegExp::Handle(RegExp::RawCast(table.InsertNewOrGet(lookup_symbol_key)));
+  object_store->set_regexp_table(table.Release());
+
+  // The canonical table is weak. Isolates spawned after the regexps of an
+  // isolate became unreachable can still reuse the most recent ones.
+  if (FLAG_retained_regexps > 0) {
+    Array& retained = Array::Handle(object_store->retained_regexps());
+    if (retained.IsNull()) {
+      retained = Array::New(FLAG_retained_regexps, Heap::kOld);
+      object_store->set_retained_regexps(retained);
+    }
+    retained.SetAt(lookup_symbol_key.Hash() % retained.Length(), regexp);
+  }
+  return regexp.ptr();
+}
+
 }  // namespace dart
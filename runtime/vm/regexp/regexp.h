@@ -1511,10 +1511,29 @@ class RegExpEngine : public AllStatic {
                                            bool sticky,
                                            Zone* zone);
 
+  // Returns the literal which every match of the parsed pattern starts with,
+  // or null if there is none. Matching can skip to the occurrences of this
+  // literal in the subject.
+  static StringPtr LiteralPrefix(RegExpCompileData* data,
+                                 RegExpFlags flags,
+                                 Zone* zone);
+
   static RegExpPtr CreateRegExp(Thread* thread,
                                 const String& pattern,
                                 RegExpFlags flags);
 
+  // Returns the canonical RegExp for |pattern| and |flags| from the table of
+  // the current isolate group, or null if there is none yet.
+  static RegExpPtr LookupCanonical(Thread* thread,
+                                   const String& pattern,
+                                   RegExpFlags flags);
+
+  // Returns the canonical RegExp for |pattern| and |flags|, adding a new
+  // RegExp to the table if there is none yet. |pattern| must be valid.
+  static RegExpPtr InsertCanonical(Thread* thread,
+                                   const String& pattern,
+                                   RegExpFlags flags);
+
   static void DotPrint(const char* label, RegExpNode* node, bool ignore_case);
 };
 
@@ -5,17 +5,31 @@
 #include "vm/regexp/regexp_assembler_bytecode.h"
 
 #include "vm/exceptions.h"
+#include "vm/lockers.h"
 #include "vm/object_store.h"
 #include "vm/regexp/regexp.h"
 #include "vm/regexp/regexp_assembler.h"
 #include "vm/regexp/regexp_assembler_bytecode_inl.h"
 #include "vm/regexp/regexp_bytecodes.h"
 #include "vm/regexp/regexp_interpreter.h"
+#include "vm/regexp/regexp_linear.h"
 #include "vm/regexp/regexp_parser.h"
 #include "vm/timeline.h"
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            regexp_linear_engine,
+            false,
+            "Match regexps with the linear-time engine when it supports the "
+            "pattern, instead of with the backtracking interpreter.");
+DEFINE_FLAG(int,
+            regexp_backtracks_before_fallback,
+            0,
+            "Rerun a match with the linear-time engine, if it supports the "
+            "pattern, once the backtracking interpreter needed this many "
+            "backtracks. 0 disables the fallback.");
+
 BytecodeRegExpMacroAssembler::BytecodeRegExpMacroAssembler(
     ZoneGrowableArray<uint8_t>* buffer,
     Zone* zone)
@@ -419,12 +433,12 @@ void BytecodeRegExpMacroAssembler::Expand() {
     buffer_->Add(0);
 }
 
-static intptr_t Prepare(const RegExp& regexp,
-                        const String& subject,
-                        bool sticky,
-                        Zone* zone) {
-  bool is_one_byte = subject.IsOneByteString();
-
+// Returns the error message if the pattern is not supported.
+static const char* Compile(const RegExp& regexp,
+                           bool is_one_byte,
+                           bool sticky,
+                           Zone* zone) {
+  // Another isolate might have compiled it while we were waiting.
   if (regexp.bytecode(is_one_byte, sticky) == TypedData::null()) {
     const String& pattern = String::Handle(zone, regexp.pattern());
 #if defined(SUPPORT_TIMELINE)
@@ -440,6 +454,8 @@ static intptr_t Prepare(const RegExp& regexp,
 
     // Parsing failures are handled in the RegExp factory constructor.
     RegExpParser::ParseRegExp(pattern, regexp.flags(), compile_data);
+    const String& literal_prefix = String::Handle(
+        zone, RegExpEngine::LiteralPrefix(compile_data, regexp.flags(), zone));
 
     regexp.set_num_bracket_expressions(compile_data->capture_count);
     regexp.set_capture_name_map(compile_data->capture_name_map);
@@ -452,14 +468,37 @@ static intptr_t Prepare(const RegExp& regexp,
     RegExpEngine::CompilationResult result = RegExpEngine::CompileBytecode(
         compile_data, regexp, is_one_byte, sticky, zone);
     if (result.error_message != nullptr) {
-      Exceptions::ThrowUnsupportedError(result.error_message);
+      return result.error_message;
     }
     ASSERT(result.bytecode != nullptr);
     ASSERT(regexp.num_registers(is_one_byte) == -1 ||
            regexp.num_registers(is_one_byte) == result.num_registers);
     regexp.set_num_registers(is_one_byte, result.num_registers);
+    regexp.set_literal_prefix(literal_prefix);
     regexp.set_bytecode(is_one_byte, sticky, *(result.bytecode));
   }
+  return nullptr;
+}
+
+static intptr_t Prepare(const RegExp& regexp,
+                        const String& subject,
+                        bool sticky,
+                        Zone* zone) {
+  bool is_one_byte = subject.IsOneByteString();
+
+  if (regexp.bytecode(is_one_byte, sticky) == TypedData::null()) {
+    // The RegExp is shared by the isolates of the group, which compile it
+    // once.
+    const char* error_message = nullptr;
+    {
+      SafepointMutexLocker ml(
+          Thread::Current()->isolate_group()->regexp_compile_mutex());
+      error_message = Compile(regexp, is_one_byte, sticky, zone);
+    }
+    if (error_message != nullptr) {
+      Exceptions::ThrowUnsupportedError(error_message);
+    }
+  }
 
   ASSERT(regexp.num_registers(is_one_byte) != -1);
 
@@ -488,11 +527,32 @@ static ObjectPtr ExecRaw(const RegExp& regexp,
     raw_output[i] = -1;
   }
 
-  const TypedData& bytecode =
-      TypedData::Handle(zone, regexp.bytecode(is_one_byte, sticky));
-  ASSERT(!bytecode.IsNull());
-  const Object& result = Object::Handle(
-      zone, IrregexpInterpreter::Match(bytecode, subject, raw_output, index));
+  Object& result = Object::Handle(zone);
+  if (FLAG_regexp_linear_engine) {
+    result = LinearRegExpEngine::Match(regexp, subject, index, sticky,
+                                       raw_output, zone);
+  }
+  if (result.IsNull()) {
+    const TypedData& bytecode =
+        TypedData::Handle(zone, regexp.bytecode(is_one_byte, sticky));
+    ASSERT(!bytecode.IsNull());
+    result = IrregexpInterpreter::Match(
+        bytecode, subject, raw_output, index,
+        FLAG_regexp_backtracks_before_fallback);
+    if (result.ptr() == Object::sentinel().ptr()) {
+      // Catastrophic backtracking, finish the match in linear time if
+      // possible.
+      for (int i = number_of_capture_registers - 1; i >= 0; i--) {
+        raw_output[i] = -1;
+      }
+      result = LinearRegExpEngine::Match(regexp, subject, index, sticky,
+                                         raw_output, zone);
+      if (result.IsNull()) {
+        result = IrregexpInterpreter::Match(bytecode, subject, raw_output,
+                                            index);
+      }
+    }
+  }
 
   if (result.ptr() == Bool::True().ptr()) {
     // Copy capture results to the start of the registers array.
@@ -506,6 +566,36 @@ static ObjectPtr ExecRaw(const RegExp& regexp,
   return result.ptr();
 }
 
+// Returns the first index at or after |start| at which |prefix| occurs in
+// |subject|, or -1 if there is none.
+static intptr_t FindLiteralPrefix(const String& subject,
+                                  intptr_t start,
+                                  const String& prefix) {
+  if (subject.IsOneByteString()) {
+    if (!prefix.IsOneByteString()) {
+      // The prefix contains a character which is not Latin-1.
+      return -1;
+    }
+    return OneByteString::IndexOf(subject, prefix, start);
+  }
+  const intptr_t length = prefix.Length();
+  const intptr_t last = subject.Length() - length;
+  NoSafepointScope no_safepoint;
+  const uint16_t first = prefix.CharAt(0);
+  for (intptr_t i = start; i <= last; i++) {
+    if (TwoByteString::CharAt(subject, i) != first) continue;
+    intptr_t j = 1;
+    while ((j < length) &&
+           (TwoByteString::CharAt(subject, i + j) == prefix.CharAt(j))) {
+      j++;
+    }
+    if (j == length) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 ObjectPtr BytecodeRegExpMacroAssembler::Interpret(const RegExp& regexp,
                                                   const String& subject,
                                                   const Smi& start_index,
@@ -517,11 +607,24 @@ ObjectPtr BytecodeRegExpMacroAssembler::Interpret(const RegExp& regexp,
     UNREACHABLE();
   }
 
+  intptr_t index = start_index.Value();
+  if (!sticky) {
+    // No match can start before the first occurrence of the literal prefix,
+    // so skip the positions in between without entering the interpreter.
+    const String& prefix = String::Handle(zone, regexp.literal_prefix());
+    if (!prefix.IsNull()) {
+      index = FindLiteralPrefix(subject, index, prefix);
+      if (index < 0) {
+        return Instance::null();
+      }
+    }
+  }
+
   // V8 uses a shared copy on the isolate when smaller than some threshold.
   int32_t* output_registers = zone->Alloc<int32_t>(required_registers);
 
   const Object& result =
-      Object::Handle(zone, ExecRaw(regexp, subject, start_index.Value(), sticky,
+      Object::Handle(zone, ExecRaw(regexp, subject, index, sticky,
                                    output_registers, required_registers, zone));
   if (result.ptr() == Bool::True().ptr()) {
     intptr_t capture_count = regexp.num_bracket_expressions();
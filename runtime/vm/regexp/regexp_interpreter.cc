@@ -177,13 +177,15 @@ class BacktrackStack {
 };
 
 // Returns True if success, False if failure, Null if internal exception,
-// Error if VM error needs to be propagated up the callchain.
+// Error if VM error needs to be propagated up the callchain, Sentinel if
+// the backtrack limit was exceeded.
 template <typename Char>
 static ObjectPtr RawMatch(const TypedData& bytecode,
                           const String& subject,
                           int32_t* registers,
                           int32_t current,
-                          uint32_t current_char) {
+                          uint32_t current_char,
+                          intptr_t backtrack_limit) {
   // BacktrackStack ensures that the memory allocated for the backtracking stack
   // is returned to the system or cached if there is no stack being cached at
   // the moment.
@@ -195,6 +197,7 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
   int32_t* backtrack_stack_base = backtrack_stack.data();
   int32_t* backtrack_sp = backtrack_stack_base;
   intptr_t backtrack_stack_space = backtrack_stack.max_size();
+  intptr_t backtracks = 0;
 
   // TODO(zerny): Optimize as single instance. V8 has this as an
   // isolate member.
@@ -292,6 +295,9 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
         pc += BC_POP_CP_LENGTH;
         break;
         BYTECODE(POP_BT)
+        if ((backtrack_limit > 0) && (++backtracks > backtrack_limit)) {
+          return Object::sentinel().ptr();
+        }
         backtrack_stack_space++;
         --backtrack_sp;
         pc = code_base + *backtrack_sp;
@@ -687,12 +693,11 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
   }
 }
 
-// Returns True if success, False if failure, Null if internal exception,
-// Error if VM error needs to be propagated up the callchain.
 ObjectPtr IrregexpInterpreter::Match(const TypedData& bytecode,
                                      const String& subject,
                                      int32_t* registers,
-                                     int32_t start_position) {
+                                     int32_t start_position,
+                                     intptr_t backtrack_limit) {
   uint16_t previous_char = '\n';
   if (start_position != 0) {
     previous_char = subject.CharAt(start_position - 1);
@@ -700,10 +705,10 @@ ObjectPtr IrregexpInterpreter::Match(const TypedData& bytecode,
 
   if (subject.IsOneByteString()) {
     return RawMatch<uint8_t>(bytecode, subject, registers, start_position,
-                             previous_char);
+                             previous_char, backtrack_limit);
   } else if (subject.IsTwoByteString()) {
     return RawMatch<uint16_t>(bytecode, subject, registers, start_position,
-                              previous_char);
+                              previous_char, backtrack_limit);
   } else {
     UNREACHABLE();
     return Bool::False().ptr();
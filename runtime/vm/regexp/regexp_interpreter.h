@@ -17,11 +17,14 @@ class IrregexpInterpreter : public AllStatic {
  public:
   // Returns True in case of a success, False in case of a failure,
   // Null in case of internal exception,
-  // Error in case VM error has to propagated up to the caller.
+  // Error in case VM error has to propagated up to the caller,
+  // Sentinel if the match needed more than |backtrack_limit| backtracks.
+  // A |backtrack_limit| of 0 means no limit.
   static ObjectPtr Match(const TypedData& bytecode,
                          const String& subject,
                          int32_t* captures,
-                         int32_t start_position);
+                         int32_t start_position,
+                         intptr_t backtrack_limit = 0);
 };
 
 }  // namespace dart
@@ -0,0 +1,508 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/regexp/regexp_linear.h"
+
+#include "vm/regexp/regexp.h"
+#include "vm/regexp/regexp_ast.h"
+#include "vm/regexp/regexp_parser.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+// Patterns are compiled into a program for a Pike VM: the matcher runs all
+// paths through the program in lockstep, one code unit of the subject at a
+// time. Each thread of a step which reaches the same instruction as a thread
+// with higher priority is dropped, so a step is bounded by the length of the
+// program and the matcher never backtracks.
+//
+// Threads are kept in the order in which a backtracking engine would try
+// them, which makes the first accepting thread the match it would find.
+class LinearRegExpProgram : public ZoneAllocated {
+ public:
+  enum Opcode : uint8_t {
+    // Consumes a code unit in one of the ranges [first, first + count).
+    kConsume,
+    // Checks the zero-width RegExpAssertion::AssertionType |first|.
+    kAssertion,
+    // Continues at the next instruction and, with lower priority, at |first|.
+    kFork,
+    kJump,
+    kSetRegisterToCp,
+    kClearRegister,
+    kAccept,
+  };
+
+  struct Instruction {
+    Opcode opcode;
+    int32_t first;
+    int32_t count;
+  };
+
+  // Longer programs make each step of the matcher too slow.
+  static constexpr intptr_t kMaxLength = 10000;
+
+  explicit LinearRegExpProgram(Zone* zone)
+      : instructions_(zone, 16), ranges_(zone, 16) {}
+
+  // Returns nullptr if the pattern uses features this engine does not
+  // support or if the program would be too long.
+  static LinearRegExpProgram* Compile(RegExpTree* tree,
+                                      RegExpFlags flags,
+                                      Zone* zone);
+
+  intptr_t length() const { return instructions_.length(); }
+  const Instruction& At(intptr_t pc) const { return instructions_[pc]; }
+
+  bool Consumes(const Instruction& instruction, uint16_t c) const {
+    ASSERT(instruction.opcode == kConsume);
+    for (intptr_t i = 0; i < instruction.count; i++) {
+      if (ranges_[instruction.first + i].Contains(c)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  bool CompileTree(RegExpTree* tree);
+  bool CompileQuantifier(RegExpQuantifier* quantifier);
+  void CompileAtom(RegExpAtom* atom);
+  void CompileCharacterClass(RegExpCharacterClass* char_class);
+  void CompileClearCaptures(Interval captures);
+
+  intptr_t pc() const { return instructions_.length(); }
+  intptr_t Emit(Opcode opcode, int32_t first = 0, int32_t count = 0) {
+    instructions_.Add({opcode, first, count});
+    return pc() - 1;
+  }
+  void Bind(intptr_t pc_to_patch) {
+    instructions_[pc_to_patch].first = pc();
+  }
+  bool too_long() const { return pc() > kMaxLength; }
+
+  GrowableArray<Instruction> instructions_;
+  GrowableArray<CharacterRange> ranges_;
+
+  DISALLOW_COPY_AND_ASSIGN(LinearRegExpProgram);
+};
+
+LinearRegExpProgram* LinearRegExpProgram::Compile(RegExpTree* tree,
+                                                  RegExpFlags flags,
+                                                  Zone* zone) {
+  // Case folding and code points outside the BMP are not implemented.
+  if (flags.IgnoreCase() || flags.IsUnicode()) {
+    return nullptr;
+  }
+  auto program = new (zone) LinearRegExpProgram(zone);
+  program->Emit(kSetRegisterToCp, RegExpCapture::StartRegister(0));
+  if (!program->CompileTree(tree)) {
+    return nullptr;
+  }
+  program->Emit(kSetRegisterToCp, RegExpCapture::EndRegister(0));
+  program->Emit(kAccept);
+  return program->too_long() ? nullptr : program;
+}
+
+bool LinearRegExpProgram::CompileTree(RegExpTree* tree) {
+  if (too_long()) {
+    return false;
+  }
+  if (tree->IsAtom()) {
+    CompileAtom(tree->AsAtom());
+    return true;
+  }
+  if (tree->IsCharacterClass()) {
+    CompileCharacterClass(tree->AsCharacterClass());
+    return true;
+  }
+  if (tree->IsText()) {
+    GrowableArray<TextElement>* elements = tree->AsText()->elements();
+    for (intptr_t i = 0; i < elements->length(); i++) {
+      const TextElement& element = elements->At(i);
+      if (element.text_type() == TextElement::ATOM) {
+        CompileAtom(element.atom());
+      } else {
+        CompileCharacterClass(element.char_class());
+      }
+    }
+    return true;
+  }
+  if (tree->IsAssertion()) {
+    Emit(kAssertion, tree->AsAssertion()->assertion_type());
+    return true;
+  }
+  if (tree->IsEmpty()) {
+    return true;
+  }
+  if (tree->IsAlternative()) {
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      if (!CompileTree(nodes->At(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsDisjunction()) {
+    ZoneGrowableArray<RegExpTree*>* alternatives =
+        tree->AsDisjunction()->alternatives();
+    GrowableArray<intptr_t> exits;
+    for (intptr_t i = 0; i < alternatives->length(); i++) {
+      const bool is_last = (i == alternatives->length() - 1);
+      const intptr_t fork = is_last ? -1 : Emit(kFork);
+      if (!CompileTree(alternatives->At(i))) {
+        return false;
+      }
+      if (!is_last) {
+        exits.Add(Emit(kJump));
+        Bind(fork);
+      }
+    }
+    for (intptr_t exit : exits) {
+      Bind(exit);
+    }
+    return true;
+  }
+  if (tree->IsCapture()) {
+    RegExpCapture* capture = tree->AsCapture();
+    Emit(kSetRegisterToCp, RegExpCapture::StartRegister(capture->index()));
+    if (!CompileTree(capture->body())) {
+      return false;
+    }
+    Emit(kSetRegisterToCp, RegExpCapture::EndRegister(capture->index()));
+    return true;
+  }
+  if (tree->IsQuantifier()) {
+    return CompileQuantifier(tree->AsQuantifier());
+  }
+  // Back references and lookarounds need backtracking.
+  return false;
+}
+
+bool LinearRegExpProgram::CompileQuantifier(RegExpQuantifier* quantifier) {
+  RegExpTree* body = quantifier->body();
+  const intptr_t min = quantifier->min();
+  const intptr_t max = quantifier->max();
+  // Optional iterations must not match the empty string, which needs the
+  // empty check of the backtracking engines.
+  if (quantifier->is_possessive() ||
+      ((max > min) && (body->min_match() == 0))) {
+    return false;
+  }
+  const bool is_greedy = quantifier->is_greedy();
+  // Each iteration starts with the captures of the body cleared.
+  const Interval captures = body->CaptureRegisters();
+  for (intptr_t i = 0; i < min; i++) {
+    CompileClearCaptures(captures);
+    if (!CompileTree(body)) {
+      return false;
+    }
+  }
+  if (max == RegExpTree::kInfinity) {
+    const intptr_t loop = pc();
+    const intptr_t fork = Emit(kFork);
+    intptr_t exit = -1;
+    if (!is_greedy) {
+      // Prefer leaving the loop.
+      exit = Emit(kJump);
+      Bind(fork);
+    }
+    CompileClearCaptures(captures);
+    if (!CompileTree(body)) {
+      return false;
+    }
+    Emit(kJump, loop);
+    Bind(is_greedy ? fork : exit);
+    return true;
+  }
+  GrowableArray<intptr_t> exits;
+  for (intptr_t i = min; i < max; i++) {
+    const intptr_t fork = Emit(kFork);
+    if (is_greedy) {
+      exits.Add(fork);
+    } else {
+      exits.Add(Emit(kJump));
+      Bind(fork);
+    }
+    CompileClearCaptures(captures);
+    if (!CompileTree(body)) {
+      return false;
+    }
+  }
+  for (intptr_t exit : exits) {
+    Bind(exit);
+  }
+  return true;
+}
+
+void LinearRegExpProgram::CompileAtom(RegExpAtom* atom) {
+  ZoneGrowableArray<uint16_t>* data = atom->data();
+  for (intptr_t i = 0; i < data->length(); i++) {
+    Emit(kConsume, ranges_.length(), 1);
+    ranges_.Add(CharacterRange::Singleton(data->At(i)));
+  }
+}
+
+void LinearRegExpProgram::CompileCharacterClass(
+    RegExpCharacterClass* char_class) {
+  Zone* zone = Thread::Current()->zone();
+  auto ranges = new (zone) ZoneGrowableArray<CharacterRange>(2);
+  ranges->AddArray(*char_class->ranges());
+  CharacterRange::Canonicalize(ranges);
+  if (char_class->is_negated()) {
+    auto negated = new (zone) ZoneGrowableArray<CharacterRange>(2);
+    CharacterRange::Negate(ranges, negated);
+    ranges = negated;
+  }
+  const intptr_t first = ranges_.length();
+  for (intptr_t i = 0; i < ranges->length(); i++) {
+    const CharacterRange& range = ranges->At(i);
+    if (range.from() <= Utf16::kMaxCodeUnit) {
+      ranges_.Add(CharacterRange::Range(
+          range.from(), Utils::Minimum<int32_t>(range.to(),
+                                                Utf16::kMaxCodeUnit)));
+    }
+  }
+  Emit(kConsume, first, ranges_.length() - first);
+}
+
+void LinearRegExpProgram::CompileClearCaptures(Interval captures) {
+  if (captures.is_empty()) return;
+  for (intptr_t i = captures.from(); i <= captures.to(); i++) {
+    Emit(kClearRegister, i);
+  }
+}
+
+static bool IsLineTerminator(uint16_t c) {
+  return (c == '\n') || (c == '\r') || (c == 0x2028) || (c == 0x2029);
+}
+
+static bool IsWordCharacter(uint16_t c) {
+  return ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+         ((c >= '0') && (c <= '9')) || (c == '_');
+}
+
+class LinearRegExpInterpreter : public ValueObject {
+ public:
+  LinearRegExpInterpreter(const LinearRegExpProgram* program,
+                          const String& subject,
+                          intptr_t register_count,
+                          Zone* zone)
+      : program_(program),
+        subject_(subject),
+        length_(subject.Length()),
+        register_count_(register_count),
+        visited_(zone->Alloc<intptr_t>(program->length())),
+        jobs_(zone->Alloc<Job>(program->length() + 1)),
+        scratch_(zone->Alloc<int32_t>(register_count)),
+        initial_registers_(zone->Alloc<int32_t>(register_count)) {
+    for (intptr_t i = 0; i < program->length(); i++) {
+      visited_[i] = -1;
+    }
+    for (intptr_t i = 0; i < register_count; i++) {
+      initial_registers_[i] = -1;
+    }
+    for (ThreadList& list : lists_) {
+      list.length = 0;
+      list.pcs = zone->Alloc<intptr_t>(program->length());
+      list.registers =
+          zone->Alloc<int32_t>(program->length() * register_count);
+    }
+  }
+
+  ObjectPtr Match(int32_t start_position, bool sticky, int32_t* captures);
+
+ private:
+  struct ThreadList {
+    intptr_t length;
+    intptr_t* pcs;
+    int32_t* registers;
+  };
+
+  // Restores |reg| to |value| if |pc| is negative.
+  struct Job {
+    intptr_t pc;
+    intptr_t reg;
+    int32_t value;
+  };
+
+  void Clear(ThreadList* list) {
+    list->length = 0;
+    generation_++;
+  }
+
+  int32_t* RegistersOf(ThreadList* list, intptr_t index) {
+    return &list->registers[index * register_count_];
+  }
+
+  bool CheckAssertion(intptr_t type, intptr_t position) const;
+
+  // Adds the threads for |pc| and all instructions reachable from it without
+  // consuming a code unit at |position| to |list|, in priority order.
+  void AddThreads(ThreadList* list,
+                  intptr_t pc,
+                  const int32_t* registers,
+                  intptr_t position);
+
+  const LinearRegExpProgram* const program_;
+  const String& subject_;
+  const intptr_t length_;
+  const intptr_t register_count_;
+  // The generation of the thread list in which an instruction was reached.
+  intptr_t* const visited_;
+  intptr_t generation_ = 0;
+  Job* const jobs_;
+  int32_t* const scratch_;
+  int32_t* const initial_registers_;
+  ThreadList lists_[2];
+
+  DISALLOW_COPY_AND_ASSIGN(LinearRegExpInterpreter);
+};
+
+bool LinearRegExpInterpreter::CheckAssertion(intptr_t type,
+                                             intptr_t position) const {
+  switch (type) {
+    case RegExpAssertion::START_OF_INPUT:
+      return position == 0;
+    case RegExpAssertion::END_OF_INPUT:
+      return position == length_;
+    case RegExpAssertion::START_OF_LINE:
+      return (position == 0) ||
+             IsLineTerminator(subject_.CharAt(position - 1));
+    case RegExpAssertion::END_OF_LINE:
+      return (position == length_) ||
+             IsLineTerminator(subject_.CharAt(position));
+    case RegExpAssertion::BOUNDARY:
+    case RegExpAssertion::NON_BOUNDARY: {
+      const bool before =
+          (position > 0) && IsWordCharacter(subject_.CharAt(position - 1));
+      const bool after =
+          (position < length_) && IsWordCharacter(subject_.CharAt(position));
+      return (before != after) == (type == RegExpAssertion::BOUNDARY);
+    }
+  }
+  UNREACHABLE();
+  return false;
+}
+
+void LinearRegExpInterpreter::AddThreads(ThreadList* list,
+                                         intptr_t pc,
+                                         const int32_t* registers,
+                                         intptr_t position) {
+  memmove(scratch_, registers, register_count_ * sizeof(int32_t));
+  // Each instruction is visited at most once and pushes at most one job.
+  intptr_t num_jobs = 0;
+  jobs_[num_jobs++] = {pc, -1, 0};
+  while (num_jobs > 0) {
+    const Job job = jobs_[--num_jobs];
+    if (job.pc < 0) {
+      scratch_[job.reg] = job.value;
+      continue;
+    }
+    pc = job.pc;
+    while (visited_[pc] != generation_) {
+      visited_[pc] = generation_;
+      const LinearRegExpProgram::Instruction& instruction = program_->At(pc);
+      if ((instruction.opcode == LinearRegExpProgram::kConsume) ||
+          (instruction.opcode == LinearRegExpProgram::kAccept)) {
+        list->pcs[list->length] = pc;
+        memmove(RegistersOf(list, list->length), scratch_,
+                register_count_ * sizeof(int32_t));
+        list->length++;
+        break;
+      }
+      if (instruction.opcode == LinearRegExpProgram::kAssertion) {
+        if (!CheckAssertion(instruction.first, position)) break;
+        pc++;
+      } else if (instruction.opcode == LinearRegExpProgram::kFork) {
+        jobs_[num_jobs++] = {instruction.first, -1, 0};
+        pc++;
+      } else if (instruction.opcode == LinearRegExpProgram::kJump) {
+        pc = instruction.first;
+      } else {
+        ASSERT((instruction.opcode == LinearRegExpProgram::kSetRegisterToCp) ||
+               (instruction.opcode == LinearRegExpProgram::kClearRegister));
+        const intptr_t reg = instruction.first;
+        jobs_[num_jobs++] = {-1, reg, scratch_[reg]};
+        scratch_[reg] =
+            (instruction.opcode == LinearRegExpProgram::kSetRegisterToCp)
+                ? position
+                : -1;
+        pc++;
+      }
+    }
+  }
+}
+
+ObjectPtr LinearRegExpInterpreter::Match(int32_t start_position,
+                                         bool sticky,
+                                         int32_t* captures) {
+  Thread* thread = Thread::Current();
+  ThreadList* current = &lists_[0];
+  ThreadList* next = &lists_[1];
+  Clear(current);
+  bool matched = false;
+  for (intptr_t position = start_position;; position++) {
+    if (!matched && (!sticky || (position == start_position))) {
+      // Starting a match later has the lowest priority.
+      AddThreads(current, 0, initial_registers_, position);
+    }
+    if ((current->length == 0) && (matched || sticky)) {
+      break;
+    }
+    if (UNLIKELY(thread->HasScheduledInterrupts())) {
+      ErrorPtr error = thread->HandleInterrupts();
+      if (error != Object::null()) {
+        return error;
+      }
+    }
+    Clear(next);
+    const bool at_end = (position == length_);
+    const uint16_t c = at_end ? 0 : subject_.CharAt(position);
+    for (intptr_t i = 0; i < current->length; i++) {
+      const LinearRegExpProgram::Instruction& instruction =
+          program_->At(current->pcs[i]);
+      int32_t* registers = RegistersOf(current, i);
+      if (instruction.opcode == LinearRegExpProgram::kAccept) {
+        // Threads with lower priority can not produce the match anymore.
+        matched = true;
+        memmove(captures, registers, register_count_ * sizeof(int32_t));
+        break;
+      }
+      if (!at_end && program_->Consumes(instruction, c)) {
+        AddThreads(next, current->pcs[i] + 1, registers, position + 1);
+      }
+    }
+    if (at_end) {
+      break;
+    }
+    ThreadList* swap = current;
+    current = next;
+    next = swap;
+  }
+  return Bool::Get(matched).ptr();
+}
+
+ObjectPtr LinearRegExpEngine::Match(const RegExp& regexp,
+                                    const String& subject,
+                                    int32_t start_position,
+                                    bool sticky,
+                                    int32_t* captures,
+                                    Zone* zone) {
+  RegExpCompileData* compile_data = new (zone) RegExpCompileData();
+  // Parsing failures are handled in the RegExp factory constructor.
+  RegExpParser::ParseRegExp(String::Handle(zone, regexp.pattern()),
+                            regexp.flags(), compile_data);
+  LinearRegExpProgram* program = LinearRegExpProgram::Compile(
+      compile_data->tree, regexp.flags(), zone);
+  if (program == nullptr) {
+    return Object::null();
+  }
+  const intptr_t register_count = (compile_data->capture_count + 1) * 2;
+  LinearRegExpInterpreter interpreter(program, subject, register_count, zone);
+  return interpreter.Match(start_position, sticky, captures);
+}
+
+}  // namespace dart
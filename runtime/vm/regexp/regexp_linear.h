@@ -0,0 +1,36 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// A non-backtracking regexp engine which matches in time linear in the length
+// of the subject, for patterns without back references and lookarounds.
+
+#ifndef RUNTIME_VM_REGEXP_REGEXP_LINEAR_H_
+#define RUNTIME_VM_REGEXP_REGEXP_LINEAR_H_
+
+#include "vm/allocation.h"
+#include "vm/object.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+class LinearRegExpEngine : public AllStatic {
+ public:
+  // Matches |subject| against |regexp| starting at |start_position| and
+  // stores the capture registers in |captures|, like the bytecode
+  // interpreter. Finds the same match as the backtracking engines.
+  //
+  // Returns True in case of a success, False in case of a failure,
+  // Null if the pattern is not supported by this engine,
+  // Error in case VM error has to propagated up to the caller.
+  static ObjectPtr Match(const RegExp& regexp,
+                         const String& subject,
+                         int32_t start_position,
+                         bool sticky,
+                         int32_t* captures,
+                         Zone* zone);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_REGEXP_REGEXP_LINEAR_H_
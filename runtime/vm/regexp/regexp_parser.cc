@@ -11,6 +11,7 @@
 
 #include "vm/longjump.h"
 #include "vm/object_store.h"
+#include "vm/report.h"
 #include "vm/symbols.h"
 
 namespace dart {
@@ -441,6 +442,9 @@ void RegExpParser::ReportError(const char* message) {
   args.SetAt(1, Symbols::Blank());
   args.SetAt(2, in());
   str ^= String::ConcatAll(args);
+  if (long_jump_on_error_) {
+    Report::LongJump(LanguageError::Handle(LanguageError::New(str)));
+  }
   args ^= Array::New(1);
   args.SetAt(0, str);
   Exceptions::ThrowByType(Exceptions::kFormat, args);
@@ -1986,4 +1990,26 @@ void RegExpParser::ParseRegExp(const String& input,
   result->capture_count = capture_count;
 }
 
+bool RegExpParser::TryParseRegExp(const String& input,
+                                  RegExpFlags flags,
+                                  RegExpCompileData* result) {
+  ASSERT(result != nullptr);
+  LongJumpScope jump;
+  if (DART_SETJMP(*jump.Set()) != 0) {
+    Thread::Current()->ClearStickyError();
+    return false;
+  }
+  RegExpParser parser(input, &result->error, flags);
+  parser.long_jump_on_error_ = true;
+  RegExpTree* tree = parser.ParsePattern();
+  ASSERT(tree != nullptr);
+  result->tree = tree;
+  intptr_t capture_count = parser.captures_started();
+  result->simple = tree->IsAtom() && parser.simple() && capture_count == 0;
+  result->contains_anchor = parser.contains_anchor();
+  result->capture_name_map = parser.CreateCaptureNameMap();
+  result->capture_count = capture_count;
+  return true;
+}
+
 }  // namespace dart
@@ -80,6 +80,13 @@ class RegExpParser : public ValueObject {
                           RegExpFlags regexp_flags,
                           RegExpCompileData* result);
 
+  // Like ParseRegExp, but returns false instead of throwing a
+  // FormatException if |input| is not a valid pattern. Used by the
+  // precompiler, which cannot throw Dart exceptions.
+  static bool TryParseRegExp(const String& input,
+                             RegExpFlags regexp_flags,
+                             RegExpCompileData* result);
+
   RegExpTree* ParsePattern();
   RegExpTree* ParseDisjunction();
   RegExpTree* ParseGroup();
@@ -260,6 +267,9 @@ class RegExpParser : public ValueObject {
   bool contains_anchor_;
   bool is_scanned_for_captures_;
   bool has_named_captures_;
+  // Whether errors are reported with a long jump instead of a
+  // FormatException, see TryParseRegExp.
+  bool long_jump_on_error_ = false;
 };
 
 }  // namespace dart
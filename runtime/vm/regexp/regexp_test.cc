@@ -7,11 +7,17 @@
 #include "vm/isolate.h"
 #include "vm/object.h"
 #include "vm/regexp/regexp.h"
+#include "vm/regexp/regexp_assembler_bytecode.h"
 #include "vm/regexp/regexp_assembler_ir.h"
+#include "vm/regexp/regexp_linear.h"
+#include "vm/regexp/regexp_parser.h"
 #include "vm/unit_test.h"
 
 namespace dart {
 
+DECLARE_FLAG(bool, regexp_linear_engine);
+DECLARE_FLAG(int, regexp_backtracks_before_fallback);
+
 static ArrayPtr Match(const String& pat, const String& str) {
   Thread* thread = Thread::Current();
   Zone* zone = thread->zone();
@@ -66,4 +72,187 @@ ISOLATE_UNIT_TEST_CASE(RegExp_TwoByteString) {
   EXPECT_EQ(3, smi_2.Value());
 }
 
+ISOLATE_UNIT_TEST_CASE(RegExp_TryParseRegExp) {
+  RegExpCompileData valid;
+  EXPECT(RegExpParser::TryParseRegExp(String::Handle(String::New("(a)|b")),
+                                      RegExpFlags(), &valid));
+  EXPECT_EQ(1, valid.capture_count);
+
+  RegExpCompileData invalid;
+  EXPECT(!RegExpParser::TryParseRegExp(String::Handle(String::New("(a|b")),
+                                       RegExpFlags(), &invalid));
+  EXPECT(thread->sticky_error() == Error::null());
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_Canonical) {
+  const String& pattern = String::Handle(String::New("a+b"));
+  RegExpFlags flags;
+  flags.SetGlobal();
+  EXPECT(RegExpEngine::LookupCanonical(thread, pattern, flags) ==
+         RegExp::null());
+
+  const RegExp& regexp = RegExp::Handle(
+      RegExpEngine::InsertCanonical(thread, pattern, flags));
+  EXPECT(!regexp.IsNull());
+  EXPECT(regexp.flags() == flags);
+  EXPECT(RegExpEngine::LookupCanonical(thread, pattern, flags) ==
+         regexp.ptr());
+  EXPECT(RegExpEngine::InsertCanonical(thread, pattern, flags) ==
+         regexp.ptr());
+
+  flags.SetIgnoreCase();
+  EXPECT(RegExpEngine::LookupCanonical(thread, pattern, flags) ==
+         RegExp::null());
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_Retained) {
+  const RegExp& regexp = RegExp::Handle(RegExpEngine::InsertCanonical(
+      thread, String::Handle(String::New("[a-z]+\\d")), RegExpFlags()));
+  const Array& retained = Array::Handle(
+      thread->isolate_group()->object_store()->retained_regexps());
+  EXPECT(!retained.IsNull());
+  bool found = false;
+  for (intptr_t i = 0; !retained.IsNull() && (i < retained.Length()); i++) {
+    found = found || (retained.At(i) == regexp.ptr());
+  }
+  EXPECT(found);
+}
+
+static const char* LiteralPrefix(const char* pattern,
+                                 RegExpFlags flags = RegExpFlags()) {
+  Zone* zone = Thread::Current()->zone();
+  RegExpCompileData* data = new (zone) RegExpCompileData();
+  RegExpParser::ParseRegExp(String::Handle(String::New(pattern)), flags, data);
+  const String& prefix =
+      String::Handle(RegExpEngine::LiteralPrefix(data, flags, zone));
+  return prefix.IsNull() ? nullptr : prefix.ToCString();
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LiteralPrefix) {
+  EXPECT_STREQ("ERROR: ", LiteralPrefix("ERROR: (\\w+)"));
+  EXPECT_STREQ("abc", LiteralPrefix("(a(b))c[de]"));
+  EXPECT_STREQ("ab", LiteralPrefix("\\bab(?=c)d?"));
+  EXPECT_STREQ("xy", LiteralPrefix("(?:xy)+z"));
+  EXPECT_STREQ("a", LiteralPrefix("a(bc|bd)"));
+  EXPECT(LiteralPrefix("ab|ac") == nullptr);
+  EXPECT(LiteralPrefix("a*b") == nullptr);
+  EXPECT(LiteralPrefix("[ab]c") == nullptr);
+  EXPECT(LiteralPrefix("^abc") == nullptr);
+  RegExpFlags ignore_case;
+  ignore_case.SetIgnoreCase();
+  EXPECT(LiteralPrefix("abc", ignore_case) == nullptr);
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_InterpretWithLiteralPrefix) {
+  SetFlagScope<bool> sfs(&FLAG_interpret_irregexp, true);
+  const RegExp& regexp = RegExp::Handle(RegExpEngine::CreateRegExp(
+      thread, String::Handle(String::New("ERROR: (\\w+)")), RegExpFlags()));
+  auto interpret = [&](const char* subject, intptr_t start) -> intptr_t {
+    const auto& result = TypedData::Handle(
+        TypedData::RawCast(BytecodeRegExpMacroAssembler::Interpret(
+            regexp, String::Handle(String::New(subject)),
+            Smi::Handle(Smi::New(start)), /*sticky=*/false, thread->zone())));
+    return result.IsNull() ? -1 : result.GetInt32(0);
+  };
+
+  EXPECT_EQ(3, interpret("ok\nERROR: disk full", 0));
+  EXPECT_EQ(15, interpret("ERROR: a ERROR ERROR: b", 1));
+  EXPECT_EQ(-1, interpret("ERROR: ", 0));
+  EXPECT_EQ(-1, interpret("ERROR: a", 1));
+  EXPECT_EQ(-1, interpret("", 0));
+  EXPECT_STREQ("ERROR: ", String::Handle(regexp.literal_prefix()).ToCString());
+
+  // Two-byte subjects.
+  EXPECT_EQ(4, interpret("\u20ac \u20ac ERROR: x", 0));
+}
+
+// Returns the capture registers of the match as a string, or "null".
+static const char* Interpret(const char* pattern,
+                             const char* subject,
+                             intptr_t start = 0,
+                             bool sticky = false) {
+  Thread* thread = Thread::Current();
+  SetFlagScope<bool> sfs(&FLAG_interpret_irregexp, true);
+  const RegExp& regexp = RegExp::Handle(RegExpEngine::CreateRegExp(
+      thread, String::Handle(String::New(pattern)), RegExpFlags()));
+  const auto& result = TypedData::Handle(
+      TypedData::RawCast(BytecodeRegExpMacroAssembler::Interpret(
+          regexp, String::Handle(String::New(subject)),
+          Smi::Handle(Smi::New(start)), sticky, thread->zone())));
+  if (result.IsNull()) {
+    return "null";
+  }
+  TextBuffer buffer(64);
+  for (intptr_t i = 0; i < result.Length(); i++) {
+    buffer.Printf("%s%d", i == 0 ? "" : ",",
+                  result.GetInt32(i * sizeof(int32_t)));
+  }
+  return thread->zone()->MakeCopyOfString(buffer.buffer());
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LinearEngine) {
+  struct {
+    const char* pattern;
+    const char* subject;
+    intptr_t start;
+    bool sticky;
+  } cases[] = {
+      {"abc", "xxabcx", 0, false},
+      {"abc", "xxabcx", 3, false},
+      {"abc", "xxabcx", 0, true},
+      {"abc", "xxabcx", 2, true},
+      {"a|ab", "ab", 0, false},
+      {"(a|ab)(c|bcd)", "abcd", 0, false},
+      {"(a+)(a+)", "aaaa", 0, false},
+      {"(a+?)(a+)", "aaaa", 0, false},
+      {"(a*?)b", "aaab", 0, false},
+      {"x(a{2,3})", "xaaaa", 0, false},
+      {"x(a{2,3}?)", "xaaaa", 0, false},
+      {"(?:(a)|b)+", "ab", 0, false},
+      {"(\\w+)\\s(\\d*)", "hello 42 world", 0, false},
+      {"[^a-c]+", "abcdefa", 0, false},
+      {"\\bfoo\\B", "a foox foo", 0, false},
+      {"^b", "ab", 0, false},
+      {"a$", "aa", 0, false},
+      {"(x)?y", "y", 0, false},
+      {"(?<name>b)c", "abc", 0, false},
+      {"[]", "abc", 0, false},
+      {"", "abc", 1, false},
+  };
+  for (const auto& test : cases) {
+    const char* expected;
+    {
+      SetFlagScope<bool> sfs(&FLAG_regexp_linear_engine, false);
+      expected = Interpret(test.pattern, test.subject, test.start, test.sticky);
+    }
+    SetFlagScope<bool> sfs(&FLAG_regexp_linear_engine, true);
+    EXPECT_STREQ(expected, Interpret(test.pattern, test.subject, test.start,
+                                     test.sticky));
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LinearEngineUnsupported) {
+  const char* patterns[] = {"(a)\\1", "a(?=b)", "(?<=a)b", "(a*)*b",
+                            "(a?){2,3}"};
+  const String& subject = String::Handle(String::New("aab"));
+  int32_t captures[4];
+  for (const char* pattern : patterns) {
+    const RegExp& regexp = RegExp::Handle(RegExpEngine::CreateRegExp(
+        thread, String::Handle(String::New(pattern)), RegExpFlags()));
+    EXPECT(LinearRegExpEngine::Match(regexp, subject, 0, /*sticky=*/false,
+                                     captures, thread->zone()) ==
+           Object::null());
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_BacktrackFallback) {
+  SetFlagScope<int> sfs(&FLAG_regexp_backtracks_before_fallback, 10000);
+  // Takes exponential time with backtracking.
+  EXPECT_STREQ("null",
+               Interpret("(a+)+b", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+  EXPECT_STREQ("0,3,0,2", Interpret("(a+)+b", "aab"));
+  // Not supported by the linear-time engine.
+  EXPECT_STREQ("0,3,0,1", Interpret("(a)\\1b", "aab"));
+}
+
 }  // namespace dart
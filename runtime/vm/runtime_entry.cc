@@ -68,6 +68,11 @@ DEFINE_FLAG(bool,
             false,
             "Ensure results of allocation via runtime calls are not in an "
             "active TLAB.");
+DEFINE_FLAG(bool,
+            batch_ffi_async_callbacks,
+            false,
+            "Deliver the invocations of NativeCallable.listener callbacks "
+            "made before the listener runs in one message.");
 DEFINE_FLAG(bool, trace_deoptimization, false, "Trace deoptimization");
 DEFINE_FLAG(bool,
             trace_deoptimization_verbose,
@@ -1117,6 +1122,51 @@ static BoolPtr CheckHashBasedSubtypeTestCache(
 }
 #endif  // defined(TARGET_ARCH_IA32) || defined(DART_DYNAMIC_MODULES)
 
+#if !defined(PRODUCT)
+static void CountRuntimeTypeCheck(Thread* thread, const AbstractType& type) {
+  if (FLAG_dump_subtype_test_cache_stats) {
+    SafepointMutexLocker ml(
+        thread->isolate_group()->subtype_test_cache_mutex());
+    SubtypeTestCacheStats::Increment(thread, type,
+                                     SubtypeTestCacheStats::kRuntimeCheck);
+  }
+}
+#endif  // !defined(PRODUCT)
+
+// Tests whether [instance] is an instance of [type] like
+// Instance::IsInstanceOf, but instantiates uninstantiated class types through
+// the instantiations cache of their type arguments. The cache remembers the
+// instantiations for previously seen instantiator and function type
+// arguments, so checks against the same type from generic code which miss the
+// subtype test cache of the call site do not instantiate and allocate the
+// type arguments again.
+static bool IsInstanceOfForTypeTest(
+    Zone* zone,
+    const Instance& instance,
+    const AbstractType& type,
+    const TypeArguments& instantiator_type_arguments,
+    const TypeArguments& function_type_arguments) {
+  if (type.IsInstantiated() || !type.IsType()) {
+    return instance.IsInstanceOf(type, instantiator_type_arguments,
+                                 function_type_arguments);
+  }
+  const auto& type_class = Class::Handle(zone, type.type_class());
+  auto& type_arguments =
+      TypeArguments::Handle(zone, Type::Cast(type).arguments());
+  type_arguments = type_arguments.InstantiateAndCanonicalizeFrom(
+      instantiator_type_arguments, function_type_arguments);
+  auto& instantiated_type = AbstractType::Handle(
+      zone,
+      Type::New(type_class, type_arguments, type.nullability(), Heap::kNew));
+  instantiated_type.SetIsFinalized();
+  instantiated_type = instantiated_type.NormalizeFutureOrType(Heap::kNew);
+  if (instantiated_type.IsTopTypeForSubtyping()) {
+    return true;
+  }
+  return instance.IsInstanceOf(instantiated_type, Object::null_type_arguments(),
+                               Object::null_type_arguments());
+}
+
 // This updates the type test cache, an array containing 8 elements:
 // - instance class (or function if the instance is a closure)
 // - instance type arguments (null if the instance class is not generic)
@@ -1218,6 +1268,12 @@ static void UpdateTypeTestCache(
         THR_Print("Not updating subtype test cache as its length reached %d\n",
                   FLAG_max_subtype_cache_entries);
       }
+#if !defined(PRODUCT)
+      if (FLAG_dump_subtype_test_cache_stats) {
+        SubtypeTestCacheStats::Increment(thread, destination_type,
+                                         SubtypeTestCacheStats::kCacheFull);
+      }
+#endif  // !defined(PRODUCT)
       return;
     }
     intptr_t colliding_index = -1;
@@ -1248,6 +1304,12 @@ static void UpdateTypeTestCache(
         instance_type_arguments, instantiator_type_arguments,
         function_type_arguments, instance_parent_function_type_arguments,
         instance_delayed_type_arguments, result);
+#if !defined(PRODUCT)
+    if (FLAG_dump_subtype_test_cache_stats) {
+      SubtypeTestCacheStats::Increment(thread, destination_type,
+                                       SubtypeTestCacheStats::kCacheAdd);
+    }
+#endif  // !defined(PRODUCT)
     if (FLAG_trace_type_checks) {
       TextBuffer buffer(256);
       buffer.Printf("  Added new entry to test cache %#" Px " at index %" Pd
@@ -1296,8 +1358,12 @@ DEFINE_RUNTIME_ENTRY(Instanceof, 5) {
     }
   }
 #endif  // defined(TARGET_ARCH_IA32)
-  const Bool& result = Bool::Get(instance.IsInstanceOf(
-      type, instantiator_type_arguments, function_type_arguments));
+#if !defined(PRODUCT)
+  CountRuntimeTypeCheck(thread, type);
+#endif  // !defined(PRODUCT)
+  const Bool& result = Bool::Get(
+      IsInstanceOfForTypeTest(zone, instance, type, instantiator_type_arguments,
+                              function_type_arguments));
   if (FLAG_trace_type_checks) {
     PrintTypeCheck("InstanceOf", instance, type, instantiator_type_arguments,
                    function_type_arguments, result);
@@ -1371,8 +1437,13 @@ DEFINE_RUNTIME_ENTRY(TypeCheck, 7) {
   // This is guaranteed on the calling side.
   ASSERT(!dst_type.IsDynamicType());
 
-  const bool is_instance_of = src_instance.IsInstanceOf(
-      dst_type, instantiator_type_arguments, function_type_arguments);
+#if !defined(PRODUCT)
+  CountRuntimeTypeCheck(thread, dst_type);
+#endif  // !defined(PRODUCT)
+
+  const bool is_instance_of = IsInstanceOfForTypeTest(
+      zone, src_instance, dst_type, instantiator_type_arguments,
+      function_type_arguments);
 
   if (FLAG_trace_type_checks) {
     PrintTypeCheck("TypeCheck", src_instance, dst_type,
@@ -2897,13 +2968,16 @@ DEFINE_RUNTIME_ENTRY(SwitchableCallMiss, 2) {
 //   Arg0: receiver
 //   Arg1: target name
 //   Arg2: arguments descriptor
+//   Arg3: object pool holding the call site cache, or null
+//   Arg4: index of the call site cache in the object pool
 //   Returns: target function (can only be null in AOT runtime)
-// Modifies the instance call table in current interpreter.
-DEFINE_RUNTIME_ENTRY(InterpretedInstanceCallMissHandler, 3) {
+// Adds the target to the call site cache, if given.
+DEFINE_RUNTIME_ENTRY(InterpretedInstanceCallMissHandler, 5) {
 #if defined(DART_DYNAMIC_MODULES)
   const Instance& receiver = Instance::CheckedHandle(zone, arguments.ArgAt(0));
   const String& target_name = String::CheckedHandle(zone, arguments.ArgAt(1));
   const Array& arg_desc = Array::CheckedHandle(zone, arguments.ArgAt(2));
+  const Object& pool = Object::Handle(zone, arguments.ArgAt(3));
 
   ArgumentsDescriptor arguments_descriptor(arg_desc);
   const Class& receiver_class = Class::Handle(zone, receiver.clazz());
@@ -2925,6 +2999,11 @@ DEFINE_RUNTIME_ENTRY(InterpretedInstanceCallMissHandler, 3) {
 #if !defined(DART_PRECOMPILED_RUNTIME)
   ASSERT(!target_function.IsNull());
 #endif
+  if (!pool.IsNull() && !target_function.IsNull()) {
+    const intptr_t index = Smi::CheckedHandle(zone, arguments.ArgAt(4)).Value();
+    Interpreter::UpdateCallSiteCache(ObjectPool::Cast(pool), index, target_name,
+                                     receiver.GetClassId(), target_function);
+  }
   arguments.SetReturn(target_function);
 #else
   UNREACHABLE();
@@ -3707,6 +3786,11 @@ void DeoptimizeAt(Thread* mutator_thread,
 // Currently checks only that all optimized frames have kDeoptIndex
 // and unoptimized code has the kDeoptAfter.
 void DeoptimizeFunctionsOnStack() {
+  DeoptimizeFunctionsOnStack([](const Code& code) { return true; });
+}
+
+void DeoptimizeFunctionsOnStack(
+    const std::function<bool(const Code&)>& predicate) {
   auto thread = Thread::Current();
   // Have to grab program_lock before stopping everybody else.
   SafepointWriteRwLocker ml(thread, thread->isolate_group()->program_lock());
@@ -3727,7 +3811,8 @@ void DeoptimizeFunctionsOnStack() {
             if (!frame->is_interpreted()) {
               optimized_code = frame->LookupDartCode();
               if (optimized_code.is_optimized() &&
-                  !optimized_code.is_force_optimized()) {
+                  !optimized_code.is_force_optimized() &&
+                  predicate(optimized_code)) {
                 DeoptimizeAt(mutator_thread, optimized_code, frame);
               }
             }
@@ -4121,6 +4206,18 @@ DEFINE_RUNTIME_ENTRY(FfiAsyncCallbackSend, 1) {
   Dart_Port target_port = Thread::Current()->unboxed_int64_runtime_arg();
   TRACE_RUNTIME_CALL("FfiAsyncCallbackSend %p", (void*)target_port);
   const Object& message = Object::Handle(zone, arguments.ArgAt(0));
+  if (FLAG_batch_ffi_async_callbacks) {
+    // Only the invocation starting a batch posts a message, which makes the
+    // receiver drain all invocations added until then in one turn.
+    if (isolate->group()->AddToFfiAsyncCallbackBatch(target_port,
+                                                     Array::Cast(message)) &&
+        !PortMap::PostMessage(Message::New(target_port, Object::null(),
+                                           Message::kNormalPriority))) {
+      // The port is closed, drop the batch.
+      isolate->group()->TakeFfiAsyncCallbackBatch(target_port);
+    }
+    return;
+  }
   const Array& msg_array = Array::Handle(zone, Array::New(3));
   msg_array.SetAt(0, message);
   PersistentHandle* handle =
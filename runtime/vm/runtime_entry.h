@@ -5,6 +5,8 @@
 #ifndef RUNTIME_VM_RUNTIME_ENTRY_H_
 #define RUNTIME_VM_RUNTIME_ENTRY_H_
 
+#include <functional>
+
 #include "vm/allocation.h"
 #if !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/compiler/runtime_api.h"
@@ -184,6 +186,9 @@ void DeoptimizeAt(Thread* mutator_thread,
                   const Code& optimized_code,
                   StackFrame* frame);
 void DeoptimizeFunctionsOnStack();
+// Only deoptimizes the frames whose optimized code satisfies |predicate|.
+void DeoptimizeFunctionsOnStack(
+    const std::function<bool(const Code&)>& predicate);
 
 double DartModulo(double a, double b);
 
@@ -25,6 +25,7 @@
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
 #include "vm/heap/safepoint.h"
+#include "vm/heap/sampler.h"
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/kernel.h"
@@ -93,7 +94,7 @@ void Service::LogResponseSize(const char* method, JSONStream* js) {
   }
   Dart_FileWriteCallback file_write = Dart::file_write_callback();
   char* entry =
-      OS::SCreate(nullptr, "%s, %" Pd "\n", method, js->buffer()->length());
+      OS::SCreate(nullptr, "%s, %" Pd "\n", method, js->writer()->length());
   (*file_write)(entry, strlen(entry), service_response_size_log_file_);
   free(entry);
 }
@@ -4729,6 +4730,43 @@ static void GetAllocationTraces(Thread* thread, JSONStream* js) {
   }
 }
 
+static const MethodParameter* const set_sampled_allocation_profile_params[] =
+    {
+        RUNNABLE_ISOLATE_PARAMETER,
+        new BoolParameter("enabled", true),
+        new BoolParameter("reset", false),
+        nullptr,
+};
+
+static void SetSampledAllocationProfile(Thread* thread, JSONStream* js) {
+  const bool enabled = BoolParameter::Parse(js->LookupParam("enabled"), false);
+  if (BoolParameter::Parse(js->LookupParam("reset"), false)) {
+    HeapProfileSampler::ResetAllocationProfileCounters();
+  }
+  HeapProfileSampler::EnableAllocationProfile(enabled);
+  PrintSuccess(js);
+}
+
+static const MethodParameter* const get_sampled_allocation_profile_params[] =
+    {
+        RUNNABLE_ISOLATE_PARAMETER,
+        new Int64Parameter("timeOriginMicros", false),
+        new Int64Parameter("timeExtentMicros", false),
+        nullptr,
+};
+
+static void GetSampledAllocationProfile(Thread* thread, JSONStream* js) {
+  int64_t time_origin_micros =
+      Int64Parameter::Parse(js->LookupParam("timeOriginMicros"));
+  int64_t time_extent_micros =
+      Int64Parameter::Parse(js->LookupParam("timeExtentMicros"));
+  if (CheckProfilerDisabled(thread, js)) {
+    return;
+  }
+  ProfilerService::PrintSampledAllocationJSON(js, time_origin_micros,
+                                              time_extent_micros);
+}
+
 static const MethodParameter* const clear_cpu_samples_params[] = {
     RUNNABLE_ISOLATE_PARAMETER,
     nullptr,
@@ -5943,22 +5981,26 @@ static void SetFlag(Thread* thread, JSONStream* js) {
   // behavior generated code and the runtime out of sync.
   const uintptr_t kProfilePeriodIndex = 3;
   const uintptr_t kProfilerIndex = 4;
+  const uintptr_t kTimelineStreamFiltersIndex = 5;
   const char* kAllowedFlags[] = {
       "pause_isolates_on_start",
       "pause_isolates_on_exit",
       "pause_isolates_on_unhandled_exceptions",
       "profile_period",
       "profiler",
+      "timeline_stream_filters",
   };
 
   bool allowed = false;
   bool profile_period = false;
   bool profiler = false;
+  bool timeline_stream_filters = false;
   for (size_t i = 0; i < ARRAY_SIZE(kAllowedFlags); i++) {
     if (strcmp(flag_name, kAllowedFlags[i]) == 0) {
       allowed = true;
       profile_period = (i == kProfilePeriodIndex);
       profiler = (i == kProfilerIndex);
+      timeline_stream_filters = (i == kTimelineStreamFiltersIndex);
       break;
     }
   }
@@ -5980,6 +6022,10 @@ static void SetFlag(Thread* thread, JSONStream* js) {
     } else if (profiler) {
       // FLAG_profiler has already been set to the new value.
       Profiler::UpdateRunningState();
+    } else if (timeline_stream_filters) {
+#if defined(SUPPORT_TIMELINE)
+      Timeline::UpdateStreamFilters();
+#endif
     }
     if (Service::vm_stream.enabled()) {
       ServiceEvent event(ServiceEvent::kVMFlagUpdate);
@@ -6202,6 +6248,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_allocation_profile_params },
   { "getAllocationTraces", GetAllocationTraces,
       get_allocation_traces_params },
+  { "_getSampledAllocationProfile", GetSampledAllocationProfile,
+    get_sampled_allocation_profile_params },
   { "getClassList", GetClassList,
     get_class_list_params },
   { "getCpuSamples", GetCpuSamples,
@@ -6314,6 +6362,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     set_library_debuggable_params },
   { "setName", SetName,
     set_name_params },
+  { "_setSampledAllocationProfile", SetSampledAllocationProfile,
+    set_sampled_allocation_profile_params },
   { "_setStreamIncludePrivateMembers", SetStreamIncludePrivateMembers,
     set_stream_include_private_members_params },
   { "setTraceClassAllocation", SetTraceClassAllocation,
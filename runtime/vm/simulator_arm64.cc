@@ -799,6 +799,9 @@ Simulator::Simulator() : memory_(FLAG_sim_buffer_memory) {
 
   pc_modified_ = false;
   icount_ = 0;
+  for (intptr_t i = 0; i < kDecodeCacheSize; i++) {
+    decode_cache_[i] = {0, nullptr};
+  }
   break_pc_ = nullptr;
   break_instr_ = 0;
   last_setjmp_buffer_ = nullptr;
@@ -1521,22 +1524,26 @@ void Simulator::DecodePCRel(Instr* instr) {
   }
 }
 
-void Simulator::DecodeDPImmediate(Instr* instr) {
+Simulator::InstructionHandler Simulator::ClassifyDPImmediate(Instr* instr) {
   if (instr->IsMoveWideOp()) {
-    DecodeMoveWide(instr);
+    return &Simulator::DecodeMoveWide;
   } else if (instr->IsAddSubImmOp()) {
-    DecodeAddSubImm(instr);
+    return &Simulator::DecodeAddSubImm;
   } else if (instr->IsBitfieldOp()) {
-    DecodeBitfield(instr);
+    return &Simulator::DecodeBitfield;
   } else if (instr->IsLogicalImmOp()) {
-    DecodeLogicalImm(instr);
+    return &Simulator::DecodeLogicalImm;
   } else if (instr->IsPCRelOp()) {
-    DecodePCRel(instr);
+    return &Simulator::DecodePCRel;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
+void Simulator::DecodeDPImmediate(Instr* instr) {
+  (this->*ClassifyDPImmediate(instr))(instr);
+}
+
 void Simulator::DecodeCompareAndBranch(Instr* instr) {
   const int op = instr->Bit(24);
   const Register rt = instr->RtField();
@@ -2066,26 +2073,30 @@ void Simulator::DecodeUnconditionalBranchReg(Instr* instr) {
 }
 
 DART_FORCE_INLINE
-void Simulator::DecodeCompareBranch(Instr* instr) {
+Simulator::InstructionHandler Simulator::ClassifyCompareBranch(Instr* instr) {
   if (instr->IsCompareAndBranchOp()) {
-    DecodeCompareAndBranch(instr);
+    return &Simulator::DecodeCompareAndBranch;
   } else if (instr->IsConditionalBranchOp()) {
-    DecodeConditionalBranch(instr);
+    return &Simulator::DecodeConditionalBranch;
   } else if (instr->IsExceptionGenOp()) {
-    DecodeExceptionGen(instr);
+    return &Simulator::DecodeExceptionGen;
   } else if (instr->IsSystemOp()) {
-    DecodeSystem(instr);
+    return &Simulator::DecodeSystem;
   } else if (instr->IsTestAndBranchOp()) {
-    DecodeTestAndBranch(instr);
+    return &Simulator::DecodeTestAndBranch;
   } else if (instr->IsUnconditionalBranchOp()) {
-    DecodeUnconditionalBranch(instr);
+    return &Simulator::DecodeUnconditionalBranch;
   } else if (instr->IsUnconditionalBranchRegOp()) {
-    DecodeUnconditionalBranchReg(instr);
+    return &Simulator::DecodeUnconditionalBranchReg;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
+void Simulator::DecodeCompareBranch(Instr* instr) {
+  (this->*ClassifyCompareBranch(instr))(instr);
+}
+
 void Simulator::DecodeLoadStoreReg(Instr* instr) {
   // Calculate the address.
   const Register rn = instr->RnField();
@@ -2573,22 +2584,26 @@ void Simulator::DecodeAtomicMemory(Instr* instr) {
 }
 
 DART_FORCE_INLINE
-void Simulator::DecodeLoadStore(Instr* instr) {
+Simulator::InstructionHandler Simulator::ClassifyLoadStore(Instr* instr) {
   if (instr->IsAtomicMemoryOp()) {
-    DecodeAtomicMemory(instr);
+    return &Simulator::DecodeAtomicMemory;
   } else if (instr->IsLoadStoreRegOp()) {
-    DecodeLoadStoreReg(instr);
+    return &Simulator::DecodeLoadStoreReg;
   } else if (instr->IsLoadStoreRegPairOp()) {
-    DecodeLoadStoreRegPair(instr);
+    return &Simulator::DecodeLoadStoreRegPair;
   } else if (instr->IsLoadRegLiteralOp()) {
-    DecodeLoadRegLiteral(instr);
+    return &Simulator::DecodeLoadRegLiteral;
   } else if (instr->IsLoadStoreExclusiveOp()) {
-    DecodeLoadStoreExclusive(instr);
+    return &Simulator::DecodeLoadStoreExclusive;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
+void Simulator::DecodeLoadStore(Instr* instr) {
+  (this->*ClassifyLoadStore(instr))(instr);
+}
+
 int64_t Simulator::ShiftOperand(uint8_t reg_size,
                                 int64_t value,
                                 Shift shift_type,
@@ -3110,26 +3125,30 @@ void Simulator::DecodeConditionalSelect(Instr* instr) {
   }
 }
 
-void Simulator::DecodeDPRegister(Instr* instr) {
+Simulator::InstructionHandler Simulator::ClassifyDPRegister(Instr* instr) {
   if (instr->IsAddSubShiftExtOp()) {
-    DecodeAddSubShiftExt(instr);
+    return &Simulator::DecodeAddSubShiftExt;
   } else if (instr->IsAddSubWithCarryOp()) {
-    DecodeAddSubWithCarry(instr);
+    return &Simulator::DecodeAddSubWithCarry;
   } else if (instr->IsLogicalShiftOp()) {
-    DecodeLogicalShift(instr);
+    return &Simulator::DecodeLogicalShift;
   } else if (instr->IsMiscDP1SourceOp()) {
-    DecodeMiscDP1Source(instr);
+    return &Simulator::DecodeMiscDP1Source;
   } else if (instr->IsMiscDP2SourceOp()) {
-    DecodeMiscDP2Source(instr);
+    return &Simulator::DecodeMiscDP2Source;
   } else if (instr->IsMiscDP3SourceOp()) {
-    DecodeMiscDP3Source(instr);
+    return &Simulator::DecodeMiscDP3Source;
   } else if (instr->IsConditionalSelectOp()) {
-    DecodeConditionalSelect(instr);
+    return &Simulator::DecodeConditionalSelect;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
+void Simulator::DecodeDPRegister(Instr* instr) {
+  (this->*ClassifyDPRegister(instr))(instr);
+}
+
 void Simulator::DecodeSIMDCopy(Instr* instr) {
   const int32_t Q = instr->Bit(30);
   const int32_t op = instr->Bit(29);
@@ -3615,18 +3634,22 @@ void Simulator::DecodeSIMDTwoReg(Instr* instr) {
   }
 }
 
-void Simulator::DecodeDPSimd1(Instr* instr) {
+Simulator::InstructionHandler Simulator::ClassifyDPSimd1(Instr* instr) {
   if (instr->IsSIMDCopyOp()) {
-    DecodeSIMDCopy(instr);
+    return &Simulator::DecodeSIMDCopy;
   } else if (instr->IsSIMDThreeSameOp()) {
-    DecodeSIMDThreeSame(instr);
+    return &Simulator::DecodeSIMDThreeSame;
   } else if (instr->IsSIMDTwoRegOp()) {
-    DecodeSIMDTwoReg(instr);
+    return &Simulator::DecodeSIMDTwoReg;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
+void Simulator::DecodeDPSimd1(Instr* instr) {
+  (this->*ClassifyDPSimd1(instr))(instr);
+}
+
 void Simulator::DecodeFPImm(Instr* instr) {
   if ((instr->Bit(31) != 0) || (instr->Bit(29) != 0) || (instr->Bit(23) != 0) ||
       (instr->Bits(5, 5) != 0)) {
@@ -3863,50 +3886,81 @@ void Simulator::DecodeFPCompare(Instr* instr) {
   }
 }
 
-void Simulator::DecodeFP(Instr* instr) {
+Simulator::InstructionHandler Simulator::ClassifyFP(Instr* instr) {
   if (instr->IsFPImmOp()) {
-    DecodeFPImm(instr);
+    return &Simulator::DecodeFPImm;
   } else if (instr->IsFPIntCvtOp()) {
-    DecodeFPIntCvt(instr);
+    return &Simulator::DecodeFPIntCvt;
   } else if (instr->IsFPOneSourceOp()) {
-    DecodeFPOneSource(instr);
+    return &Simulator::DecodeFPOneSource;
   } else if (instr->IsFPTwoSourceOp()) {
-    DecodeFPTwoSource(instr);
+    return &Simulator::DecodeFPTwoSource;
   } else if (instr->IsFPCompareOp()) {
-    DecodeFPCompare(instr);
+    return &Simulator::DecodeFPCompare;
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
-void Simulator::DecodeDPSimd2(Instr* instr) {
+void Simulator::DecodeFP(Instr* instr) {
+  (this->*ClassifyFP(instr))(instr);
+}
+
+Simulator::InstructionHandler Simulator::ClassifyDPSimd2(Instr* instr) {
   if (instr->IsFPOp()) {
-    DecodeFP(instr);
+    return ClassifyFP(instr);
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
   }
 }
 
-// Executes the current instruction.
-DART_FORCE_INLINE
-void Simulator::InstructionDecodeImpl(Instr* instr) {
-  pc_modified_ = false;
+void Simulator::DecodeDPSimd2(Instr* instr) {
+  (this->*ClassifyDPSimd2(instr))(instr);
+}
 
+Simulator::InstructionHandler Simulator::ClassifyInstruction(Instr* instr) {
   if (instr->IsLoadStoreOp()) {
-    DecodeLoadStore(instr);
+    return ClassifyLoadStore(instr);
   } else if (instr->IsDPImmediateOp()) {
-    DecodeDPImmediate(instr);
+    return ClassifyDPImmediate(instr);
   } else if (instr->IsCompareBranchOp()) {
-    DecodeCompareBranch(instr);
+    return ClassifyCompareBranch(instr);
   } else if (instr->IsDPRegisterOp()) {
-    DecodeDPRegister(instr);
+    return ClassifyDPRegister(instr);
   } else if (instr->IsDPSimd1Op()) {
-    DecodeDPSimd1(instr);
+    return ClassifyDPSimd1(instr);
   } else if (instr->IsDPSimd2Op()) {
-    DecodeDPSimd2(instr);
+    return ClassifyDPSimd2(instr);
   } else {
-    UnimplementedInstruction(instr);
+    return &Simulator::UnimplementedInstruction;
+  }
+}
+
+// The handler only depends on the instruction bits, so an entry whose bits
+// match is valid even if the code at its PC was patched or freed and reused,
+// and the cache never needs to be invalidated.
+DART_FORCE_INLINE
+Simulator::InstructionHandler Simulator::LookupInstructionHandler(
+    Instr* instr) {
+  const int32_t bits = instr->InstructionBits();
+  DecodeCacheEntry* entry =
+      &decode_cache_[(reinterpret_cast<uword>(instr) / Instr::kInstrSize) &
+                     (kDecodeCacheSize - 1)];
+  if (LIKELY(entry->handler != nullptr && entry->bits == bits)) {
+    return entry->handler;
   }
+  entry->bits = bits;
+  entry->handler = ClassifyInstruction(instr);
+  return entry->handler;
+}
+
+// Executes the current instruction.
+DART_FORCE_INLINE
+void Simulator::InstructionDecodeImpl(Instr* instr,
+                                      InstructionHandler handler) {
+  pc_modified_ = false;
+
+  (this->*handler)(instr);
 
   if (!pc_modified_) {
     set_pc(reinterpret_cast<int64_t>(instr) + Instr::kInstrSize);
@@ -3924,7 +3978,7 @@ void Simulator::InstructionDecode(Instr* instr) {
       THR_Print("Disassembler not supported in this mode.\n");
     }
   }
-  InstructionDecodeImpl(instr);
+  InstructionDecodeImpl(instr, ClassifyInstruction(instr));
 }
 
 void Simulator::Execute() {
@@ -3949,7 +4003,7 @@ void Simulator::ExecuteNoTrace() {
   while (program_counter != kEndSimulatingPC) {
     Instr* instr = reinterpret_cast<Instr*>(program_counter);
     icount_++;
-    InstructionDecodeImpl(instr);
+    InstructionDecodeImpl(instr, LookupInstructionHandler(instr));
     program_counter = get_pc();
   }
 }
@@ -153,6 +153,16 @@ class Simulator {
   SimulatorSetjmpBuffer* last_setjmp_buffer_;
   SimulatorMemory memory_;
 
+  // Direct mapped cache of the handlers of recently executed instructions,
+  // indexed by their PC, to skip classifying them when run again.
+  using InstructionHandler = void (Simulator::*)(Instr* instr);
+  struct DecodeCacheEntry {
+    int32_t bits;
+    InstructionHandler handler;
+  };
+  static constexpr intptr_t kDecodeCacheSize = 4 * KB;
+  DecodeCacheEntry decode_cache_[kDecodeCacheSize];
+
   // Registered breakpoints.
   Instr* break_pc_;
   int64_t break_instr_;
@@ -243,11 +253,24 @@ class Simulator {
 
   // Decode instructions.
   void InstructionDecode(Instr* instr);
-  void InstructionDecodeImpl(Instr* instr);
+  void InstructionDecodeImpl(Instr* instr, InstructionHandler handler);
 #define DECODE_OP(op) void Decode##op(Instr* instr);
   APPLY_OP_LIST(DECODE_OP)
 #undef DECODE_OP
 
+  // Returns the Decode function executing the given instruction.
+  static InstructionHandler ClassifyInstruction(Instr* instr);
+  static InstructionHandler ClassifyLoadStore(Instr* instr);
+  static InstructionHandler ClassifyDPImmediate(Instr* instr);
+  static InstructionHandler ClassifyCompareBranch(Instr* instr);
+  static InstructionHandler ClassifyDPRegister(Instr* instr);
+  static InstructionHandler ClassifyDPSimd1(Instr* instr);
+  static InstructionHandler ClassifyDPSimd2(Instr* instr);
+  static InstructionHandler ClassifyFP(Instr* instr);
+
+  // Like ClassifyInstruction, but remembers the result in decode_cache_.
+  InstructionHandler LookupInstructionHandler(Instr* instr);
+
   // Executes ARM64 instructions until the PC reaches kEndSimulatingPC.
   void Execute();
   void ExecuteNoTrace();
@@ -22,6 +22,9 @@
 
 namespace dart {
 
+DECLARE_FLAG(bool, compress_snapshot_data);
+DECLARE_FLAG(int, snapshot_fill_tasks);
+
 // Check if serialized and deserialized objects are equal.
 static bool Equals(const Object& expected, const Object& actual) {
   if (expected.IsNull()) {
@@ -706,7 +709,9 @@ ISOLATE_UNIT_TEST_CASE(SerializeEmptyByteArray) {
   CheckEncodeDecodeMessage(scope.zone(), root);
 }
 
-VM_UNIT_TEST_CASE(FullSnapshot) {
+// Writes a full snapshot of a test script, creates an isolate from it and runs
+// the script. Returns the length of the snapshot.
+static intptr_t TestFullSnapshot() {
   // clang-format off
   const char* kScriptChars =
           "class Fields  {\n"
@@ -737,6 +742,7 @@ VM_UNIT_TEST_CASE(FullSnapshot) {
   Dart_Handle result;
 
   uint8_t* isolate_snapshot_data_buffer;
+  intptr_t length;
 
   // Start an Isolate, load a script and create a full snapshot.
   Timer timer1;
@@ -767,8 +773,7 @@ VM_UNIT_TEST_CASE(FullSnapshot) {
         /*vm_image_writer=*/nullptr, /*iso_image_writer=*/nullptr);
     writer.WriteFullSnapshot();
     // Take ownership so it doesn't get freed by the stream destructor.
-    intptr_t unused;
-    isolate_snapshot_data_buffer = isolate_snapshot_data.Steal(&unused);
+    isolate_snapshot_data_buffer = isolate_snapshot_data.Steal(&length);
   }
 
   // Now Create another isolate using the snapshot and execute a method
@@ -789,6 +794,192 @@ VM_UNIT_TEST_CASE(FullSnapshot) {
   }
   Dart_ShutdownIsolate();
   free(isolate_snapshot_data_buffer);
+  return length;
+}
+
+VM_UNIT_TEST_CASE(FullSnapshot) {
+  TestFullSnapshot();
+}
+
+VM_UNIT_TEST_CASE(FullSnapshotCompressed) {
+  const intptr_t length = TestFullSnapshot();
+  SetFlagScope<bool> sfs(&FLAG_compress_snapshot_data, true);
+  const intptr_t compressed_length = TestFullSnapshot();
+  EXPECT_LT(compressed_length, length);
+}
+
+// Writes a full snapshot holding an ExternalTypedData in a static field, whose
+// data is not copied out of the snapshot when it is read, and checks the data
+// from an isolate created from it.
+static void TestFullSnapshotExternalTypedData() {
+  // clang-format off
+  const char* kScriptChars =
+          "@pragma('vm:entry-point')\n"
+          "var data;\n"
+          "@pragma('vm:entry-point')\n"
+          "int sum() {\n"
+          "  int result = 0;\n"
+          "  for (int i = 0; i < data.length; i++) result += data[i];\n"
+          "  return result;\n"
+          "}\n";
+  // clang-format on
+  const intptr_t kDataLength = 1000;
+  static uint8_t external_data[kDataLength];
+  int64_t expected_sum = 0;
+  for (intptr_t i = 0; i < kDataLength; i++) {
+    external_data[i] = i * 7;
+    expected_sum += external_data[i];
+  }
+
+  uint8_t* isolate_snapshot_data_buffer;
+  intptr_t length;
+  {
+    TestIsolateScope __test_isolate__;
+    Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+    Dart_Handle data = Dart_NewExternalTypedData(Dart_TypedData_kUint8,
+                                                 external_data, kDataLength);
+    EXPECT_VALID(data);
+    EXPECT_VALID(Dart_SetField(lib, NewString("data"), data));
+
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    HandleScope scope(thread);
+
+    Dart_Handle result = Api::CheckAndFinalizePendingClasses(thread);
+    {
+      TransitionVMToNative to_native(thread);
+      EXPECT_VALID(result);
+    }
+
+    MallocWriteStream isolate_snapshot_data(FullSnapshotWriter::kInitialSize);
+    FullSnapshotWriter writer(
+        Snapshot::kFull, /*vm_snapshot_data=*/nullptr, &isolate_snapshot_data,
+        /*vm_image_writer=*/nullptr, /*iso_image_writer=*/nullptr);
+    writer.WriteFullSnapshot();
+    isolate_snapshot_data_buffer = isolate_snapshot_data.Steal(&length);
+  }
+
+  TestCase::CreateTestIsolateFromSnapshot(isolate_snapshot_data_buffer);
+  {
+    Dart_EnterScope();
+    Dart_Handle data = Dart_GetField(TestCase::lib(), NewString("data"));
+    EXPECT_VALID(data);
+    EXPECT_EQ(Dart_TypedData_kUint8, Dart_GetTypeOfExternalTypedData(data));
+    Dart_Handle result =
+        Dart_Invoke(TestCase::lib(), NewString("sum"), 0, nullptr);
+    EXPECT_VALID(result);
+    int64_t sum = 0;
+    EXPECT_VALID(Dart_IntegerToInt64(result, &sum));
+    EXPECT_EQ(expected_sum, sum);
+    Dart_ExitScope();
+  }
+  Dart_ShutdownIsolate();
+  free(isolate_snapshot_data_buffer);
+}
+
+VM_UNIT_TEST_CASE(FullSnapshotExternalTypedData) {
+  TestFullSnapshotExternalTypedData();
+}
+
+VM_UNIT_TEST_CASE(FullSnapshotCompressedExternalTypedData) {
+  SetFlagScope<bool> sfs(&FLAG_compress_snapshot_data, true);
+  TestFullSnapshotExternalTypedData();
+}
+
+// Writes a full snapshot holding enough instances, arrays, records and typed
+// data for --snapshot_fill_tasks to fill them on helper tasks, and checks
+// them from an isolate created from it.
+static void TestFullSnapshotFill() {
+  // clang-format off
+  const char* kScriptChars =
+          "import 'dart:typed_data';\n"
+          "class Point {\n"
+          "  Point(this.x, this.y);\n"
+          "  final int x;\n"
+          "  final String y;\n"
+          "}\n"
+          "const kLength = 20000;\n"
+          "double half(int i) => i / 2;\n"
+          "@pragma('vm:entry-point')\n"
+          "var data;\n"
+          "@pragma('vm:entry-point')\n"
+          "void init() {\n"
+          "  data = [\n"
+          "    List<Point>.generate(kLength, (i) => Point(i, 'p$i')),\n"
+          "    List<int?>.generate(kLength, (i) => i.isEven ? i : null),\n"
+          "    List<(int, String)>.generate(kLength, (i) => (i, 'r$i')),\n"
+          "    Uint8List.fromList(List<int>.generate(5 * kLength, (i) => i)),\n"
+          "    Float64List.fromList(List<double>.generate(kLength, half)),\n"
+          "  ];\n"
+          "}\n"
+          "void expect(bool condition, int i) {\n"
+          "  if (!condition) throw 'Unexpected element $i';\n"
+          "}\n"
+          "@pragma('vm:entry-point')\n"
+          "void check() {\n"
+          "  final points = data[0] as List<Point>;\n"
+          "  final ints = data[1] as List<int?>;\n"
+          "  final records = data[2] as List<(int, String)>;\n"
+          "  final bytes = data[3] as Uint8List;\n"
+          "  final doubles = data[4] as Float64List;\n"
+          "  for (var i = 0; i < kLength; i++) {\n"
+          "    expect(points[i].x == i && points[i].y == 'p$i', i);\n"
+          "    expect(ints[i] == (i.isEven ? i : null), i);\n"
+          "    expect(records[i].$1 == i && records[i].$2 == 'r$i', i);\n"
+          "    expect(doubles[i] == half(i), i);\n"
+          "  }\n"
+          "  for (var i = 0; i < 5 * kLength; i++) {\n"
+          "    expect(bytes[i] == (i & 0xff), i);\n"
+          "  }\n"
+          "}\n";
+  // clang-format on
+
+  uint8_t* isolate_snapshot_data_buffer;
+  intptr_t length;
+  {
+    TestIsolateScope __test_isolate__;
+    Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+    EXPECT_VALID(Dart_Invoke(lib, NewString("init"), 0, nullptr));
+
+    Thread* thread = Thread::Current();
+    TransitionNativeToVM transition(thread);
+    StackZone zone(thread);
+    HandleScope scope(thread);
+
+    Dart_Handle result = Api::CheckAndFinalizePendingClasses(thread);
+    {
+      TransitionVMToNative to_native(thread);
+      EXPECT_VALID(result);
+    }
+
+    MallocWriteStream isolate_snapshot_data(FullSnapshotWriter::kInitialSize);
+    FullSnapshotWriter writer(
+        Snapshot::kFull, /*vm_snapshot_data=*/nullptr, &isolate_snapshot_data,
+        /*vm_image_writer=*/nullptr, /*iso_image_writer=*/nullptr);
+    writer.WriteFullSnapshot();
+    isolate_snapshot_data_buffer = isolate_snapshot_data.Steal(&length);
+  }
+
+  TestCase::CreateTestIsolateFromSnapshot(isolate_snapshot_data_buffer);
+  {
+    Dart_EnterScope();
+    EXPECT_VALID(Dart_Invoke(TestCase::lib(), NewString("check"), 0, nullptr));
+    Dart_ExitScope();
+  }
+  Dart_ShutdownIsolate();
+  free(isolate_snapshot_data_buffer);
+}
+
+VM_UNIT_TEST_CASE(FullSnapshotConcurrentFill) {
+  SetFlagScope<int> tasks(&FLAG_snapshot_fill_tasks, 4);
+  TestFullSnapshotFill();
+}
+
+VM_UNIT_TEST_CASE(FullSnapshotConcurrentFillCompressed) {
+  SetFlagScope<int> tasks(&FLAG_snapshot_fill_tasks, 4);
+  SetFlagScope<bool> compress(&FLAG_compress_snapshot_data, true);
+  TestFullSnapshotFill();
 }
 
 // Helper function to call a top level Dart function and serialize the result.
@@ -224,6 +224,81 @@ void EntryFrame::VisitObjectPointers(ObjectPointerVisitor* visitor) {
   visitor->VisitPointers(first, last);
 }
 
+void StackFrame::FindStackMapEntry(StackMapCache::Entry* entry) const {
+  ASSERT(FLAG_precompiled_mode);
+  NoSafepointScope no_safepoint;
+  entry->pc = pc();
+  entry->bits = nullptr;
+
+  uword code_start;
+  const UntaggedCompressedStackMaps::Payload* global_table_payload;
+  CompressedStackMaps::RawPayloadHandle maps;
+  CompressedStackMaps::RawPayloadHandle global_table;
+  maps = ReversePc::FindStackMap(isolate_group(), pc(),
+                                 /*is_return_address=*/true, &code_start,
+                                 &global_table_payload);
+  if (maps.IsNull()) {
+    return;
+  }
+  global_table = global_table_payload;
+  CompressedStackMaps::Iterator<CompressedStackMaps::RawPayloadHandle> it(
+      maps, global_table);
+  if (it.Find(pc() - code_start)) {
+    entry->bits = it.Bits();
+    entry->spill_slot_bit_count = it.SpillSlotBitCount();
+    entry->length = it.Length();
+  }
+}
+
+void StackFrame::VisitObjectPointersWithStackMap(
+    ObjectPointerVisitor* visitor,
+    const StackMapCache::Entry& entry) {
+  ObjectPtr* first = reinterpret_cast<ObjectPtr*>(sp());
+  ObjectPtr* last = reinterpret_cast<ObjectPtr*>(
+      fp() + (runtime_frame_layout.first_local_from_fp * kWordSize));
+
+  // A stack map is present in the code object, use the stack map to
+  // visit frame slots which are marked as having objects.
+  //
+  // The layout of the frame is (lower addresses to the right):
+  // | spill slots | outgoing arguments | saved registers | slow-path args |
+  // |XXXXXXXXXXXXX|--------------------|XXXXXXXXXXXXXXXXX|XXXXXXXXXXXXXXXX|
+  //
+  // The spill slots and any saved registers are described in the stack
+  // map.  The outgoing arguments are assumed to be tagged; the number
+  // of outgoing arguments is not explicitly tracked.
+
+  // Spill slots are at the 'bottom' of the frame.
+  intptr_t spill_slot_count = entry.spill_slot_bit_count;
+  for (intptr_t bit = 0; bit < spill_slot_count; ++bit) {
+    if (entry.IsObject(bit)) {
+      visitor->VisitPointer(last);
+    }
+    --last;
+  }
+
+  // The live registers at the 'top' of the frame comprise the rest of the
+  // stack map.
+  for (intptr_t bit = entry.length - 1; bit >= spill_slot_count; --bit) {
+    if (entry.IsObject(bit)) {
+      visitor->VisitPointer(first);
+    }
+    ++first;
+  }
+
+  // The last slot can be one slot (but not more) past the last slot
+  // in the case that all slots were covered by the stack map.
+  ASSERT((last + 1) >= first);
+  visitor->VisitPointers(first, last);
+
+  // Now visit other slots which might be part of the calling convention.
+  first = reinterpret_cast<ObjectPtr*>(
+      fp() + ((runtime_frame_layout.first_local_from_fp + 1) * kWordSize));
+  last = reinterpret_cast<ObjectPtr*>(
+      fp() + (runtime_frame_layout.first_object_from_fp * kWordSize));
+  visitor->VisitPointers(first, last);
+}
+
 void StackFrame::VisitObjectPointers(ObjectPointerVisitor* visitor) {
   ASSERT(visitor != nullptr);
   // NOTE: This code runs while GC is in progress and runs within
@@ -241,11 +316,20 @@ void StackFrame::VisitObjectPointers(ObjectPointerVisitor* visitor) {
   uword code_start;
 
   if (FLAG_precompiled_mode) {
-    const UntaggedCompressedStackMaps::Payload* global_table_payload;
-    maps = ReversePc::FindStackMap(isolate_group(), pc(),
-                                   /*is_return_address=*/true, &code_start,
-                                   &global_table_payload);
-    global_table = global_table_payload;
+    StackMapCache::Entry uncached_entry = {};
+    StackMapCache* const cache = visitor->stack_map_cache();
+    StackMapCache::Entry* const entry =
+        (cache != nullptr) ? cache->EntryFor(pc()) : &uncached_entry;
+    if (entry->pc != pc()) {
+      FindStackMapEntry(entry);
+    }
+    if (entry->bits != nullptr) {
+      VisitObjectPointersWithStackMap(visitor, *entry);
+      return;
+    }
+    // If we are missing a stack map for a given PC offset, this must be a
+    // stub frame, in which all stack slots contain tagged pointers.
+    ASSERT(IsStubFrame());
   } else {
     ObjectPtr pc_marker = *(reinterpret_cast<ObjectPtr*>(
         fp() + ((is_interpreted() ? kKBCPcMarkerSlotFromFp
@@ -280,50 +364,9 @@ void StackFrame::VisitObjectPointers(ObjectPointerVisitor* visitor) {
       if (is_interpreted()) {
         UNIMPLEMENTED();
       }
-      ObjectPtr* first = reinterpret_cast<ObjectPtr*>(sp());
-      ObjectPtr* last = reinterpret_cast<ObjectPtr*>(
-          fp() + (runtime_frame_layout.first_local_from_fp * kWordSize));
-
-      // A stack map is present in the code object, use the stack map to
-      // visit frame slots which are marked as having objects.
-      //
-      // The layout of the frame is (lower addresses to the right):
-      // | spill slots | outgoing arguments | saved registers | slow-path args |
-      // |XXXXXXXXXXXXX|--------------------|XXXXXXXXXXXXXXXXX|XXXXXXXXXXXXXXXX|
-      //
-      // The spill slots and any saved registers are described in the stack
-      // map.  The outgoing arguments are assumed to be tagged; the number
-      // of outgoing arguments is not explicitly tracked.
-
-      // Spill slots are at the 'bottom' of the frame.
-      intptr_t spill_slot_count = it.SpillSlotBitCount();
-      for (intptr_t bit = 0; bit < spill_slot_count; ++bit) {
-        if (it.IsObject(bit)) {
-          visitor->VisitPointer(last);
-        }
-        --last;
-      }
-
-      // The live registers at the 'top' of the frame comprise the rest of the
-      // stack map.
-      for (intptr_t bit = it.Length() - 1; bit >= spill_slot_count; --bit) {
-        if (it.IsObject(bit)) {
-          visitor->VisitPointer(first);
-        }
-        ++first;
-      }
-
-      // The last slot can be one slot (but not more) past the last slot
-      // in the case that all slots were covered by the stack map.
-      ASSERT((last + 1) >= first);
-      visitor->VisitPointers(first, last);
-
-      // Now visit other slots which might be part of the calling convention.
-      first = reinterpret_cast<ObjectPtr*>(
-          fp() + ((runtime_frame_layout.first_local_from_fp + 1) * kWordSize));
-      last = reinterpret_cast<ObjectPtr*>(
-          fp() + (runtime_frame_layout.first_object_from_fp * kWordSize));
-      visitor->VisitPointers(first, last);
+      const StackMapCache::Entry entry = {pc(), it.Bits(),
+                                          it.SpillSlotBitCount(), it.Length()};
+      VisitObjectPointersWithStackMap(visitor, entry);
       return;
     }
 
@@ -331,14 +374,8 @@ void StackFrame::VisitObjectPointers(ObjectPointerVisitor* visitor) {
     // unoptimized code, code with no stack map information at all, or the entry
     // to an osr function. In each of these cases, all stack slots contain
     // tagged pointers, so fall through.
-#if defined(DEBUG)
-    if (FLAG_precompiled_mode) {
-      ASSERT(IsStubFrame());
-    } else {
-      ASSERT(!code.is_optimized() ||
-             (pc_offset == code.EntryPoint() - code.PayloadStart()));
-    }
-#endif  // defined(DEBUG)
+    ASSERT(!code.is_optimized() ||
+           (pc_offset == code.EntryPoint() - code.PayloadStart()));
   }
 
   // For normal unoptimized Dart frames and Stub frames each slot
@@ -445,6 +482,21 @@ bool StackFrame::FindExceptionHandler(Thread* thread,
                                       bool* needs_stacktrace,
                                       bool* has_catch_all,
                                       bool* is_optimized) const {
+  // Frames which are thrown through repeatedly are cached, whether or not
+  // they have a handler, so that they do not need to look up their code and
+  // decode its descriptors again.
+  HandlerInfoCache* cache = thread->isolate()->handler_info_cache();
+  if (CachedExceptionHandler* cached = cache->Lookup(pc())) {
+    if (cached->handler_pc == 0) {
+      return false;
+    }
+    *handler_pc = cached->handler_pc;
+    *needs_stacktrace = cached->needs_stacktrace;
+    *has_catch_all = cached->has_catch_all;
+    *is_optimized = cached->is_optimized;
+    return true;
+  }
+
   REUSABLE_CODE_HANDLESCOPE(thread);
   Code& code = reused_code_handle.Handle();
   REUSABLE_BYTECODE_HANDLESCOPE(thread);
@@ -459,6 +511,7 @@ bool StackFrame::FindExceptionHandler(Thread* thread,
     ASSERT(!bytecode.IsNull());
     start = bytecode.PayloadStart();
     handlers = bytecode.exception_handlers();
+    *is_optimized = false;
   } else {
     code = LookupDartCode();
     if (code.IsNull()) {
@@ -469,14 +522,6 @@ bool StackFrame::FindExceptionHandler(Thread* thread,
     descriptors = code.pc_descriptors();
     *is_optimized = code.is_optimized();
   }
-  HandlerInfoCache* cache = thread->isolate()->handler_info_cache();
-  ExceptionHandlerInfo* info = cache->Lookup(pc());
-  if (info != nullptr) {
-    *handler_pc = start + info->handler_pc_offset;
-    *needs_stacktrace = (info->needs_stacktrace != 0);
-    *has_catch_all = (info->has_catch_all != 0);
-    return true;
-  }
 
   intptr_t try_index = -1;
   if (handlers.num_entries() != 0) {
@@ -500,16 +545,19 @@ bool StackFrame::FindExceptionHandler(Thread* thread,
       *handler_pc = StubCode::AsyncExceptionHandler().EntryPoint();
       *needs_stacktrace = true;
       *has_catch_all = true;
-      return true;
+    } else {
+      cache->Insert(pc(), {0, false, false, *is_optimized});
+      return false;
     }
-    return false;
-  }
-  ExceptionHandlerInfo handler_info;
-  handlers.GetHandlerInfo(try_index, &handler_info);
-  *handler_pc = start + handler_info.handler_pc_offset;
-  *needs_stacktrace = (handler_info.needs_stacktrace != 0);
-  *has_catch_all = (handler_info.has_catch_all != 0);
-  cache->Insert(pc(), handler_info);
+  } else {
+    ExceptionHandlerInfo handler_info;
+    handlers.GetHandlerInfo(try_index, &handler_info);
+    *handler_pc = start + handler_info.handler_pc_offset;
+    *needs_stacktrace = (handler_info.needs_stacktrace != 0);
+    *has_catch_all = (handler_info.has_catch_all != 0);
+  }
+  cache->Insert(pc(), {*handler_pc, *needs_stacktrace, *has_catch_all,
+                       *is_optimized});
   return true;
 }
 
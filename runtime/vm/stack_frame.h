@@ -34,6 +34,48 @@ class LocalVariable;
 
 extern FrameLayout runtime_frame_layout;
 
+// Caches the stack map entries found for return addresses in AOT code, where
+// they are immortal, so that visiting many frames with the same return
+// address, e.g. of recursive calls or of isolates running the same code,
+// does not require finding and decoding the stack map again.
+class StackMapCache {
+ public:
+  struct Entry {
+    // The return address, or 0 for an empty entry.
+    uword pc;
+    // The bits of the stack map entry, or nullptr if there is none for |pc|.
+    const uint8_t* bits;
+    intptr_t spill_slot_bit_count;
+    intptr_t length;
+
+    bool IsObject(intptr_t bit_index) const {
+      ASSERT(bit_index >= 0 && bit_index < length);
+      return (bits[bit_index >> kBitsPerByteLog2] &
+              (1U << (bit_index & (kBitsPerByte - 1)))) != 0;
+    }
+  };
+
+  StackMapCache() {}
+  ~StackMapCache() { free(entries_); }
+
+  // Returns the entry to use for |pc|, which might hold another return
+  // address.
+  Entry* EntryFor(uword pc) {
+    if (entries_ == nullptr) {
+      entries_ = reinterpret_cast<Entry*>(calloc(kNumEntries, sizeof(Entry)));
+    }
+    return &entries_[(pc ^ (pc >> kLog2NumEntries)) & (kNumEntries - 1)];
+  }
+
+ private:
+  static constexpr intptr_t kLog2NumEntries = 9;
+  static constexpr intptr_t kNumEntries = 1 << kLog2NumEntries;
+
+  Entry* entries_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(StackMapCache);
+};
+
 // Generic stack frame.
 class StackFrame : public ValueObject {
  public:
@@ -157,6 +199,14 @@ class StackFrame : public ValueObject {
   CodePtr GetCodeObject() const;
   BytecodePtr GetBytecodeObject() const;
 
+  // Fills |entry| with the stack map entry for the return address of this
+  // frame of AOT code.
+  void FindStackMapEntry(StackMapCache::Entry* entry) const;
+
+  // Visits the slots of this frame described by the stack map |entry|.
+  void VisitObjectPointersWithStackMap(ObjectPointerVisitor* visitor,
+                                       const StackMapCache::Entry& entry);
+
   uword GetCallerFp() const {
     return *(reinterpret_cast<uword*>(
         fp() + ((is_interpreted() ? kKBCSavedCallerFpSlotFromFp
@@ -364,10 +364,22 @@ StringPtr Symbols::NewSymbol(Thread* thread, const StringType& str) {
         symbol ^= table.InsertNewOrGet(str);
         object_store->set_symbol_table(table.Release());
       } else {
+        // Allocate the new symbol before taking the lock, so that threads
+        // creating different symbols only serialize on the table update. If
+        // another thread inserts an equal symbol first, ours is garbage.
+        // Symbols which canonicalize the original string in place can only
+        // be created under the lock.
+        if (!str.ToSymbolReusesString()) {
+          symbol = str.ToSymbol();
+        }
         SafepointMutexLocker ml(group->symbols_mutex());
         data = object_store->symbol_table();
         CanonicalStringSet table(&key, &value, &data);
-        symbol ^= table.InsertNewOrGet(str);
+        if (symbol.IsNull()) {
+          symbol ^= table.InsertNewOrGet(str);
+        } else {
+          symbol ^= table.InsertOrGet(symbol);
+        }
         object_store->set_symbol_table(table.Release());
       }
     }
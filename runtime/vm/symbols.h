@@ -159,6 +159,7 @@ class ObjectPointerVisitor;
   V(FutureOr, "FutureOr")                                                      \
   V(FutureValue, "Future.value")                                               \
   V(GetCall, "get:call")                                                       \
+  V(GetHashCode, "get:hashCode")                                               \
   V(GetLength, "get:length")                                                   \
   V(GetRuntimeType, "get:runtimeType")                                         \
   V(GetterPrefix, "get:")                                                      \
@@ -183,6 +184,8 @@ class ObjectPointerVisitor;
   V(Int8List, "Int8List")                                                      \
   V(IntegerDivisionByZeroException, "IntegerDivisionByZeroException")          \
   V(Interpolate, "_interpolate")                                               \
+  V(Interpolate2, "_interpolate2")                                             \
+  V(Interpolate3, "_interpolate3")                                             \
   V(InterpolateSingle, "_interpolateSingle")                                   \
   V(InvocationMirror, "_InvocationMirror")                                     \
   V(IsolateSpawnException, "IsolateSpawnException")                            \
@@ -249,6 +252,7 @@ class ObjectPointerVisitor;
   V(SubtypeTestCache, "SubtypeTestCache")                                      \
   V(SuspendStateVar, ":suspend_state_var")                                     \
   V(SwitchExpr, ":switch_expr")                                                \
+  V(SwitchHash, ":switch_hash")                                                \
   V(Symbol, "Symbol")                                                          \
   V(ThrowNew, "_throwNew")                                                     \
   V(ThrowNewSource, "_throwNewSource")                                         \
@@ -435,7 +439,9 @@ class ObjectPointerVisitor;
   V(_await, "_await")                                                          \
   V(_awaitWithTypeCheck, "_awaitWithTypeCheck")                                \
   V(_backtrackingStack, "_backtrackingStack")                                  \
+  V(_canSkipAwait, "_canSkipAwait")                                            \
   V(_checkSetRangeArguments, "_checkSetRangeArguments")                        \
+  V(_completedValue, "_completedValue")                                        \
   V(_current, "_current")                                                      \
   V(_ensureScheduleImmediate, "_ensureScheduleImmediate")                      \
   V(_ffi_resolver_function, "_ffi_resolver_function")                          \
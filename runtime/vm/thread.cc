@@ -47,11 +47,13 @@ Thread::~Thread() {
 #endif
   // There should be no top api scopes at this point.
   ASSERT(api_top_scope() == nullptr);
-  // Delete the reusable api scope if there is one.
-  if (api_reusable_scope_ != nullptr) {
-    delete api_reusable_scope_;
-    api_reusable_scope_ = nullptr;
+  // Delete the reusable api scopes.
+  while (api_reusable_scope_ != nullptr) {
+    ApiLocalScope* scope = api_reusable_scope_;
+    api_reusable_scope_ = scope->previous();
+    delete scope;
   }
+  api_reusable_scope_count_ = 0;
 
   DO_IF_TSAN(delete tsan_utils_);
 }
@@ -326,6 +328,7 @@ void Thread::AssertEmptyThreadInvariants() {
   ASSERT(task_kind_ == kUnknownTask);
   ASSERT(execution_state_ == Thread::kThreadInNative);
   ASSERT(scheduled_dart_mutator_isolate_ == nullptr);
+  ASSERT(handshake_operation_ == nullptr);
 
   ASSERT(write_barrier_mask_ == UntaggedObject::kGenerationalBarrierMask);
   ASSERT(store_buffer_block_ == nullptr);
@@ -675,6 +678,11 @@ void Thread::FreeActiveThread(Thread* thread,
     thread->EnterSafepoint();
   }
 
+  // Drop a handshake this thread never got to; its requester notices and
+  // gives up (see SafepointHandler::Handshake).
+  thread->handshake_operation_ = nullptr;
+  thread->handshake_claimed_ = false;
+
   thread->isolate_ = nullptr;
   thread->isolate_group_ = nullptr;
   thread->scheduled_dart_mutator_isolate_ = nullptr;
@@ -1335,13 +1343,14 @@ int Thread::ZoneSizeInBytes() const {
 
 void Thread::EnterApiScope() {
   ASSERT(MayAllocateHandles());
-  ApiLocalScope* new_scope = api_reusable_scope();
+  ApiLocalScope* new_scope = api_reusable_scope_;
   if (new_scope == nullptr) {
     new_scope = new ApiLocalScope(api_top_scope(), top_exit_frame_info());
     ASSERT(new_scope != nullptr);
   } else {
+    api_reusable_scope_ = new_scope->previous();
+    api_reusable_scope_count_--;
     new_scope->Reinit(this, api_top_scope(), top_exit_frame_info());
-    set_api_reusable_scope(nullptr);
   }
   set_api_top_scope(new_scope);  // New scope is now the top scope.
 }
@@ -1349,13 +1358,13 @@ void Thread::EnterApiScope() {
 void Thread::ExitApiScope() {
   ASSERT(MayAllocateHandles());
   ApiLocalScope* scope = api_top_scope();
-  ApiLocalScope* reusable_scope = api_reusable_scope();
   set_api_top_scope(scope->previous());  // Reset top scope to previous.
-  if (reusable_scope == nullptr) {
+  if (api_reusable_scope_count_ < kMaxReusableApiScopes) {
     scope->Reset(this);  // Reset the old scope which we just exited.
-    set_api_reusable_scope(scope);
+    scope->set_previous(api_reusable_scope_);
+    api_reusable_scope_ = scope;
+    api_reusable_scope_count_++;
   } else {
-    ASSERT(reusable_scope != scope);
     delete scope;
   }
 }
@@ -47,6 +47,7 @@ class FieldTable;
 class Function;
 class GrowableObjectArray;
 class HandleScope;
+class HandshakeOperation;
 class Heap;
 class HierarchyInfo;
 class Instance;
@@ -517,12 +518,11 @@ class Thread : public ThreadState {
   // Monitor corresponding to this thread.
   Monitor* thread_lock() const { return &thread_lock_; }
 
-  // The reusable api local scope for this thread.
+  // The reusable api local scopes for this thread, linked through their
+  // previous() scopes. Natives which enter nested scopes reuse one for each
+  // level of nesting instead of allocating it.
+  static constexpr intptr_t kMaxReusableApiScopes = 4;
   ApiLocalScope* api_reusable_scope() const { return api_reusable_scope_; }
-  void set_api_reusable_scope(ApiLocalScope* value) {
-    ASSERT(value == nullptr || api_reusable_scope_ == nullptr);
-    api_reusable_scope_ = value;
-  }
 
   // The api local scope for this thread, this where all local handles
   // are allocated.
@@ -1051,6 +1051,18 @@ class Thread : public ThreadState {
       safepoint_state_.fetch_and(~mask);
     }
   }
+  bool IsHandshakeRequested() const {
+    return HandshakeRequestedField::decode(safepoint_state_);
+  }
+  uword SetHandshakeRequested(bool value) {
+    ASSERT(thread_lock()->IsOwnedByCurrentThread());
+    const uword mask = HandshakeRequestedField::mask_in_place();
+    if (value) {
+      return safepoint_state_.fetch_or(mask, std::memory_order_acquire);
+    } else {
+      return safepoint_state_.fetch_and(~mask, std::memory_order_release);
+    }
+  }
 
   bool OwnsGCSafepoint() const;
   bool OwnsReloadSafepoint() const;
@@ -1200,7 +1212,7 @@ class Thread : public ThreadState {
     // If we are in a runtime call that doesn't support lazy deopt, we will only
     // respond to gc safepointing requests.
     ASSERT(no_safepoint_scope_depth() == 0);
-    if (IsSafepointRequested()) {
+    if (IsSafepointRequested() || IsHandshakeRequested()) {
       bool stolen = ActiveMutatorStolenField::decode(safepoint_state_.load());
       ASSERT(!stolen);
 
@@ -1403,8 +1415,18 @@ class Thread : public ThreadState {
    *     causes transitions to native/FFI to take the slow path instead of
    *     entering a reload safepoint
    *     [NoReloadScopeField]
+   *
+   *   - whether another thread wants to run a handshake operation on this
+   *     thread (other thread sets this, see [SafepointHandler::Handshake]).
+   *     Like the requests above, it forces safepoint transitions onto the slow
+   *     path.
+   *     [HandshakeRequestedField]
    */
   std::atomic<uword> safepoint_state_;
+  // The pending handshake operation, if any, and whether its requester is
+  // running it while this thread is parked. Guarded by [thread_lock_].
+  HandshakeOperation* handshake_operation_ = nullptr;
+  bool handshake_claimed_ = false;
   uword exit_through_ffi_ = 0;
   ApiLocalScope* api_top_scope_;
   uint8_t double_truncate_round_supported_;
@@ -1426,6 +1448,7 @@ class Thread : public ThreadState {
   StreamInfo* const service_extension_stream_;
   mutable Monitor thread_lock_;
   ApiLocalScope* api_reusable_scope_;
+  intptr_t api_reusable_scope_count_ = 0;
   int32_t no_callback_scope_depth_;
   int32_t force_growth_scope_depth_ = 0;
   intptr_t no_reload_scope_depth_ = 0;
@@ -1493,6 +1516,8 @@ class Thread : public ThreadState {
       BitField<uword, bool, BypassSafepointsField::kNextBit>;
   using NoReloadScopeField =
       BitField<uword, bool, UnwindErrorInProgressField::kNextBit>;
+  using HandshakeRequestedField =
+      BitField<uword, bool, NoReloadScopeField::kNextBit>;
 
   static uword AtSafepointBits(SafepointLevel level) {
     switch (level) {
@@ -1615,6 +1640,7 @@ class Thread : public ThreadState {
   friend class compiler::target::Thread;
   friend class FieldTable;
   friend class RuntimeCallDeoptScope;
+  friend class SafepointHandler;
   friend class Dart;  // Calls SetupCachedEntryPoints after snapshot reading
   friend class
       TransitionGeneratedToVM;  // IsSafepointRequested/BlockForSafepoint
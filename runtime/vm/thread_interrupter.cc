@@ -40,6 +40,12 @@ namespace dart {
 //
 
 DEFINE_FLAG(bool, trace_thread_interrupter, false, "Trace thread interrupter");
+DEFINE_FLAG(bool,
+            profiler_cpu_timers,
+            false,
+            "On Linux, sample each thread with a timer measuring its CPU time "
+            "instead of interrupting all threads from the interrupter thread. "
+            "Threads are only sampled while they run.");
 
 bool ThreadInterrupter::initialized_ = false;
 bool ThreadInterrupter::shutdown_ = false;
@@ -48,7 +54,7 @@ bool ThreadInterrupter::woken_up_ = false;
 ThreadJoinId ThreadInterrupter::interrupter_thread_id_ =
     OSThread::kInvalidThreadJoinId;
 Monitor* ThreadInterrupter::monitor_ = nullptr;
-intptr_t ThreadInterrupter::interrupt_period_ = 1000;
+RelaxedAtomic<intptr_t> ThreadInterrupter::interrupt_period_ = {1000};
 intptr_t ThreadInterrupter::current_wait_time_ = Monitor::kNoTimeout;
 
 void ThreadInterrupter::Init(intptr_t period) {
@@ -194,9 +200,8 @@ void ThreadInterrupter::ThreadMain(uword parameters) {
         OSThreadIterator it;
         while (it.HasNext()) {
           OSThread* thread = it.Next();
-          if (thread->ThreadInterruptsEnabled()) {
+          if (thread->ThreadInterruptsEnabled() && InterruptThread(thread)) {
             interrupted_thread_count++;
-            InterruptThread(thread);
           }
         }
       }
@@ -231,7 +236,7 @@ void ThreadInterrupter::ThreadMain(uword parameters) {
   }
 }
 
-#if !defined(DART_HOST_OS_ANDROID)
+#if !defined(DART_HOST_OS_ANDROID) && !defined(DART_HOST_OS_LINUX)
 void* ThreadInterrupter::PrepareCurrentThread() {
   return nullptr;
 }
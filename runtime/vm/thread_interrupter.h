@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_THREAD_INTERRUPTER_H_
 #define RUNTIME_VM_THREAD_INTERRUPTER_H_
 
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 #include "vm/os_thread.h"
 #include "vm/signal_handler.h"
@@ -36,8 +37,9 @@ class ThreadInterrupter : public AllStatic {
   // Wake up the thread interrupter thread.
   static void WakeUp();
 
-  // Interrupt a thread.
-  static void InterruptThread(OSThread* thread);
+  // Interrupt a thread. Returns false if the thread does not need to be
+  // interrupted because it is sampled by a timer of its own.
+  static bool InterruptThread(OSThread* thread);
 
   // Prepare current thread for handling interrupts. Returns
   // opaque pointer to the allocated state (if any).
@@ -54,7 +56,8 @@ class ThreadInterrupter : public AllStatic {
   static bool woken_up_;
   static ThreadJoinId interrupter_thread_id_;
   static Monitor* monitor_;
-  static intptr_t interrupt_period_;
+  // Also read by the timers of threads, see --profiler_cpu_timers.
+  static RelaxedAtomic<intptr_t> interrupt_period_;
   static intptr_t current_wait_time_;
 
   static bool InDeepSleep() {
@@ -67,6 +70,7 @@ class ThreadInterrupter : public AllStatic {
 
   static void RemoveSignalHandler();
 
+  friend class ThreadInterrupterLinux;
   friend class ThreadInterrupterVisitIsolates;
 };
 
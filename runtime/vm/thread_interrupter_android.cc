@@ -58,7 +58,7 @@ void ThreadInterruptSignalHandler(int signal, siginfo_t* info, void* context_) {
 #endif
 }  // namespace
 
-void ThreadInterrupter::InterruptThread(OSThread* thread) {
+bool ThreadInterrupter::InterruptThread(OSThread* thread) {
   if (FLAG_trace_thread_interrupter) {
     OS::PrintErr("ThreadInterrupter interrupting %p\n",
                  reinterpret_cast<void*>(thread->id()));
@@ -66,6 +66,7 @@ void ThreadInterrupter::InterruptThread(OSThread* thread) {
 
   int result = pthread_kill(thread->id(), SIGPROF);
   ASSERT((result == 0) || (result == ESRCH));
+  return true;
 }
 
 #if defined(USE_SIGNAL_HANDLER_TRAMPOLINE)
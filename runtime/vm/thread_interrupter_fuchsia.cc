@@ -222,7 +222,7 @@ class ThreadInterrupterFuchsia : public AllStatic {
   }
 };
 
-void ThreadInterrupter::InterruptThread(OSThread* thread) {
+bool ThreadInterrupter::InterruptThread(OSThread* thread) {
   if (FLAG_trace_thread_interrupter) {
     OS::PrintErr("ThreadInterrupter suspending %p\n",
                  reinterpret_cast<void*>(thread->id()));
@@ -232,6 +232,7 @@ void ThreadInterrupter::InterruptThread(OSThread* thread) {
     OS::PrintErr("ThreadInterrupter resuming %p\n",
                  reinterpret_cast<void*>(thread->id()));
   }
+  return true;
 }
 
 void ThreadInterrupter::InstallSignalHandler() {
@@ -5,7 +5,11 @@
 #include "platform/globals.h"
 #if defined(DART_HOST_OS_LINUX)
 
-#include <errno.h>  // NOLINT
+#include <errno.h>        // NOLINT
+#include <signal.h>       // NOLINT
+#include <sys/syscall.h>  // NOLINT
+#include <time.h>         // NOLINT
+#include <unistd.h>       // NOLINT
 
 #include "vm/flags.h"
 #include "vm/os.h"
@@ -17,16 +21,75 @@ namespace dart {
 
 #ifndef PRODUCT
 
+DECLARE_FLAG(bool, profiler_cpu_timers);
 DECLARE_FLAG(bool, trace_thread_interrupter);
 
+// A timer delivering SIGPROF to its thread after each period of CPU time the
+// thread consumed.
+struct ThreadCpuTimer {
+  timer_t timer;
+  intptr_t period;
+};
+
 class ThreadInterrupterLinux : public AllStatic {
  public:
+  static void ArmTimer(ThreadCpuTimer* cpu_timer, intptr_t period) {
+    struct itimerspec spec = {};
+    spec.it_interval.tv_sec = period / kMicrosecondsPerSecond;
+    spec.it_interval.tv_nsec =
+        (period % kMicrosecondsPerSecond) * kNanosecondsPerMicrosecond;
+    spec.it_value = spec.it_interval;
+    timer_settime(cpu_timer->timer, 0, &spec, nullptr);
+    cpu_timer->period = period;
+  }
+
+  static ThreadCpuTimer* CreateTimer() {
+    struct sigevent event = {};
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+#if defined(sigev_notify_thread_id)
+    event.sigev_notify_thread_id = syscall(__NR_gettid);
+#else
+    event._sigev_un._tid = syscall(__NR_gettid);
+#endif
+    timer_t timer;
+    if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer) != 0) {
+      return nullptr;
+    }
+    ThreadCpuTimer* cpu_timer = new ThreadCpuTimer();
+    cpu_timer->timer = timer;
+    ArmTimer(cpu_timer, ThreadInterrupter::interrupt_period_);
+    return cpu_timer;
+  }
+
+  static bool HasTimer(OSThread* os_thread) {
+    return os_thread->thread_interrupter_state_.load() != nullptr;
+  }
+
+  // Follows changes of the interrupt period from within the signal handler,
+  // timer_settime is async-signal-safe.
+  static void UpdateTimer() {
+    OSThread* os_thread = OSThread::Current();
+    if (os_thread == nullptr) {
+      return;
+    }
+    auto cpu_timer = reinterpret_cast<ThreadCpuTimer*>(
+        os_thread->thread_interrupter_state_.load());
+    const intptr_t period = ThreadInterrupter::interrupt_period_;
+    if ((cpu_timer != nullptr) && (cpu_timer->period != period)) {
+      ArmTimer(cpu_timer, period);
+    }
+  }
+
   static void ThreadInterruptSignalHandler(int signal,
                                            siginfo_t* info,
                                            void* context_) {
     if (signal != SIGPROF) {
       return;
     }
+    if (info->si_code == SI_TIMER) {
+      UpdateTimer();
+    }
     Thread* thread = Thread::Current();
     if (thread == nullptr) {
       return;
@@ -45,13 +108,18 @@ class ThreadInterrupterLinux : public AllStatic {
   }
 };
 
-void ThreadInterrupter::InterruptThread(OSThread* thread) {
+bool ThreadInterrupter::InterruptThread(OSThread* thread) {
+  if (ThreadInterrupterLinux::HasTimer(thread)) {
+    // Sampled by its own CPU time timer.
+    return false;
+  }
   if (FLAG_trace_thread_interrupter) {
     OS::PrintErr("ThreadInterrupter interrupting %p\n",
                  reinterpret_cast<void*>(thread->id()));
   }
   int result = pthread_kill(thread->id(), SIGPROF);
   ASSERT((result == 0) || (result == ESRCH));
+  return true;
 }
 
 void ThreadInterrupter::InstallSignalHandler() {
@@ -62,6 +130,23 @@ void ThreadInterrupter::RemoveSignalHandler() {
   SignalHandler::Remove();
 }
 
+void* ThreadInterrupter::PrepareCurrentThread() {
+  // SIGPROF terminates the process until the interrupter thread installed
+  // the signal handler. Threads prepared earlier are interrupted instead.
+  if (!FLAG_profiler_cpu_timers || !thread_running_) {
+    return nullptr;
+  }
+  return ThreadInterrupterLinux::CreateTimer();
+}
+
+void ThreadInterrupter::CleanupCurrentThreadState(void* state) {
+  auto cpu_timer = reinterpret_cast<ThreadCpuTimer*>(state);
+  if (cpu_timer != nullptr) {
+    timer_delete(cpu_timer->timer);
+    delete cpu_timer;
+  }
+}
+
 #endif  // !PRODUCT
 
 }  // namespace dart
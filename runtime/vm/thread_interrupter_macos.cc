@@ -112,7 +112,7 @@ class ThreadInterrupterMacOS {
   mach_port_t mach_thread_;
 };
 
-void ThreadInterrupter::InterruptThread(OSThread* os_thread) {
+bool ThreadInterrupter::InterruptThread(OSThread* os_thread) {
   ASSERT(!OSThread::Compare(OSThread::GetCurrentThreadId(), os_thread->id()));
   if (FLAG_trace_thread_interrupter) {
     OS::PrintErr("ThreadInterrupter interrupting %p\n", os_thread->id());
@@ -120,6 +120,7 @@ void ThreadInterrupter::InterruptThread(OSThread* os_thread) {
 
   ThreadInterrupterMacOS interrupter(os_thread);
   interrupter.CollectSample();
+  return true;
 }
 
 void ThreadInterrupter::InstallSignalHandler() {
@@ -106,7 +106,7 @@ class ThreadInterrupterWin : public AllStatic {
   }
 };
 
-void ThreadInterrupter::InterruptThread(OSThread* thread) {
+bool ThreadInterrupter::InterruptThread(OSThread* thread) {
   if (FLAG_trace_thread_interrupter) {
     OS::PrintErr("ThreadInterrupter suspending %p\n",
                  reinterpret_cast<void*>(thread->id()));
@@ -116,6 +116,7 @@ void ThreadInterrupter::InterruptThread(OSThread* thread) {
     OS::PrintErr("ThreadInterrupter resuming %p\n",
                  reinterpret_cast<void*>(thread->id()));
   }
+  return true;
 }
 
 void ThreadInterrupter::InstallSignalHandler() {
@@ -14,6 +14,11 @@ DEFINE_FLAG(int,
             worker_timeout_millis,
             5000,
             "Free workers when they have been idle for this amount of time.");
+DEFINE_FLAG(int,
+            worker_spin_micros,
+            0,
+            "Poll for new tasks for this amount of time before putting an idle "
+            "worker to sleep.");
 
 static int64_t ComputeTimeout(int64_t idle_start) {
   int64_t worker_timeout_micros =
@@ -184,7 +189,13 @@ void ThreadPool::MarkCurrentWorkerAsUnBlocked() {
 }
 
 std::unique_ptr<ThreadPool::Task> ThreadPool::TakeNextAvailableTaskLocked() {
-  std::unique_ptr<Task> task(tasks_.RemoveFirst());
+  ASSERT(pending_tasks_ > 0);
+  intptr_t priority = 0;
+  while (tasks_[priority].IsEmpty()) {
+    priority++;
+    ASSERT(priority < Task::kNumPriorities);
+  }
+  std::unique_ptr<Task> task(tasks_[priority].RemoveFirst());
   pending_tasks_--;
   if (pending_tasks_ > 0 && !idle_workers_.IsEmpty()) {
     // Wake up one more worker if more tasks are left.
@@ -199,9 +210,9 @@ void ThreadPool::WorkerLoop(Worker* worker) {
   while (true) {
     MutexLocker ml(&pool_mutex_);
 
-    if (!tasks_.IsEmpty()) {
+    if (TasksWaitingToRunLocked()) {
       IdleToRunningLocked(worker);
-      while (!tasks_.IsEmpty()) {
+      while (TasksWaitingToRunLocked()) {
         auto task = TakeNextAvailableTaskLocked();
         MutexUnlocker mls(&ml);
         task->Run();
@@ -212,13 +223,21 @@ void ThreadPool::WorkerLoop(Worker* worker) {
     }
 
     if (running_workers_.IsEmpty()) {
-      ASSERT(tasks_.IsEmpty());
+      ASSERT(!TasksWaitingToRunLocked());
       OnEnterIdleLocked(&ml, worker);
-      if (!tasks_.IsEmpty()) {
+      if (TasksWaitingToRunLocked()) {
         continue;
       }
     }
 
+    // Tasks scheduled in quick succession, e.g. by isolates exchanging
+    // messages, are picked up without the latency of waking a sleeping
+    // worker.
+    if (FLAG_worker_spin_micros > 0 && !shutting_down_ &&
+        SpinForTasksLocked(&ml)) {
+      continue;
+    }
+
     if (shutting_down_) {
       previous_dead_worker = IdleToDeadLocked(worker);
       break;
@@ -231,7 +250,7 @@ void ThreadPool::WorkerLoop(Worker* worker) {
       const auto result = worker->Sleep(ComputeTimeout(idle_start));
 
       // We have to drain all pending tasks.
-      if (!tasks_.IsEmpty()) break;
+      if (TasksWaitingToRunLocked()) break;
 
       if (shutting_down_ || result == ConditionVariable::kTimedOut) {
         done = true;
@@ -251,6 +270,17 @@ void ThreadPool::WorkerLoop(Worker* worker) {
   JoinDeadWorker(previous_dead_worker);
 }
 
+bool ThreadPool::SpinForTasksLocked(MutexLocker* ml) {
+  {
+    MutexUnlocker mu(ml);
+    const int64_t deadline =
+        OS::GetCurrentMonotonicMicros() + FLAG_worker_spin_micros;
+    while (pending_tasks_ == 0 && OS::GetCurrentMonotonicMicros() < deadline) {
+    }
+  }
+  return TasksWaitingToRunLocked();
+}
+
 void ThreadPool::IdleToRunningLocked(Worker* worker) {
   ASSERT(idle_workers_.ContainsForDebugging(worker));
   idle_workers_.Remove(worker);
@@ -260,7 +290,7 @@ void ThreadPool::IdleToRunningLocked(Worker* worker) {
 }
 
 void ThreadPool::RunningToIdleLocked(Worker* worker) {
-  ASSERT(tasks_.IsEmpty());
+  ASSERT(!TasksWaitingToRunLocked());
 
   ASSERT(running_workers_.ContainsForDebugging(worker));
   running_workers_.Remove(worker);
@@ -270,7 +300,7 @@ void ThreadPool::RunningToIdleLocked(Worker* worker) {
 }
 
 ThreadPool::Worker* ThreadPool::IdleToDeadLocked(Worker* worker) {
-  ASSERT(tasks_.IsEmpty());
+  ASSERT(!TasksWaitingToRunLocked());
   Worker* previous_dead = last_dead_worker_;
 
   ASSERT(idle_workers_.ContainsForDebugging(worker));
@@ -299,7 +329,9 @@ void ThreadPool::JoinDeadWorker(Worker* worker) {
 
 ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(std::unique_ptr<Task> task) {
   // Enqueue the new task.
-  tasks_.Append(task.release());
+  const Task::Priority priority = task->priority();
+  ASSERT(0 <= priority && priority < Task::kNumPriorities);
+  tasks_[priority].Append(task.release());
   pending_tasks_++;
   ASSERT(pending_tasks_ >= 1);
 
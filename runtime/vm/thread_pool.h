@@ -9,6 +9,7 @@
 #include <memory>
 #include <utility>
 
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 #include "vm/globals.h"
 #include "vm/intrusive_dlist.h"
@@ -26,11 +27,23 @@ class ThreadPool {
     Task() {}
 
    public:
+    // Waiting tasks are run in the order of their priority, and in the order
+    // they were scheduled within a priority.
+    enum Priority {
+      kGCPriority,
+      kMutatorPriority,
+      kCompilerPriority,
+      kSweeperPriority,
+      kNumPriorities,
+    };
+
     virtual ~Task() {}
 
     // Override this to provide task-specific behavior.
     virtual void Run() = 0;
 
+    virtual Priority priority() const { return kMutatorPriority; }
+
    private:
     DISALLOW_COPY_AND_ASSIGN(Task);
   };
@@ -123,7 +136,7 @@ class ThreadPool {
   bool ShuttingDownLocked() { return shutting_down_; }
 
   // Whether new tasks are ready to be run.
-  bool TasksWaitingToRunLocked() { return !tasks_.IsEmpty(); }
+  bool TasksWaitingToRunLocked() { return pending_tasks_ > 0; }
 
  private:
   static void WorkerThreadExit(ThreadPool* pool, ThreadPool::Worker* worker);
@@ -134,6 +147,10 @@ class ThreadPool {
   bool RunImpl(std::unique_ptr<Task> task);
   void WorkerLoop(Worker* worker);
 
+  // Polls for new tasks with the pool lock released for up to
+  // --worker_spin_micros. Returns whether there are tasks to run.
+  bool SpinForTasksLocked(MutexLocker* ml);
+
   Worker* ScheduleTaskLocked(std::unique_ptr<Task> task);
 
   std::unique_ptr<Task> TakeNextAvailableTaskLocked();
@@ -159,8 +176,9 @@ class ThreadPool {
 
   Worker* last_dead_worker_ = nullptr;
 
-  uint64_t pending_tasks_ = 0;
-  TaskList tasks_;
+  // Modified with the pool lock held, but read without it by spinning workers.
+  RelaxedAtomic<uint64_t> pending_tasks_ = 0;
+  TaskList tasks_[Task::kNumPriorities];
 
   Monitor exit_monitor_;
   std::atomic<bool> all_workers_dead_;
@@ -10,6 +10,7 @@
 namespace dart {
 
 DECLARE_FLAG(int, worker_timeout_millis);
+DECLARE_FLAG(int, worker_spin_micros);
 
 // Some of these tests change VM flags, so they should run without a full VM
 // startup to prevent races on the flag changes. None of the tests require full
@@ -98,6 +99,23 @@ THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RunMany) {
   }
 }
 
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RunWhileSpinning) {
+  SetFlagScope<int> sfs(&FLAG_worker_spin_micros, 100 * 1000);
+  ThreadPool thread_pool;
+  Monitor sync;
+  for (int i = 0; i < 10; i++) {
+    bool done = true;
+    thread_pool.Run<TestTask>(&sync, &done);
+    MonitorLocker ml(&sync);
+    done = false;
+    ml.Notify();
+    while (!done) {
+      ml.Wait();
+    }
+    EXPECT(done);
+  }
+}
+
 class SleepTask : public ThreadPool::Task {
  public:
   SleepTask(Monitor* sync, int* started_count, int* slept_count, int millis)
@@ -257,4 +275,53 @@ THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RecursiveSpawn) {
   EXPECT_EQ(kTotalTasks, done);
 }
 
+class PriorityTask : public ThreadPool::Task {
+ public:
+  PriorityTask(Monitor* sync,
+               Priority priority,
+               MallocGrowableArray<Priority>* order)
+      : sync_(sync), priority_(priority), order_(order) {}
+
+  virtual Priority priority() const { return priority_; }
+
+  virtual void Run() {
+    MonitorLocker ml(sync_);
+    order_->Add(priority_);
+    ml.Notify();
+  }
+
+ private:
+  Monitor* sync_;
+  Priority priority_;
+  MallocGrowableArray<Priority>* order_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RunsTasksByPriority) {
+  ThreadPool thread_pool(/*max_pool_size=*/1);
+  Monitor sync;
+  bool done = true;
+  MallocGrowableArray<ThreadPool::Task::Priority> order;
+  // Occupies the only worker until all other tasks are waiting.
+  thread_pool.Run<TestTask>(&sync, &done);
+  thread_pool.Run<PriorityTask>(&sync, ThreadPool::Task::kSweeperPriority,
+                                &order);
+  thread_pool.Run<PriorityTask>(&sync, ThreadPool::Task::kCompilerPriority,
+                                &order);
+  thread_pool.Run<PriorityTask>(&sync, ThreadPool::Task::kGCPriority, &order);
+  thread_pool.Run<PriorityTask>(&sync, ThreadPool::Task::kMutatorPriority,
+                                &order);
+  {
+    MonitorLocker ml(&sync);
+    done = false;
+    ml.Notify();
+    while (order.length() < 4) {
+      ml.Wait();
+    }
+  }
+  EXPECT_EQ(ThreadPool::Task::kGCPriority, order[0]);
+  EXPECT_EQ(ThreadPool::Task::kMutatorPriority, order[1]);
+  EXPECT_EQ(ThreadPool::Task::kCompilerPriority, order[2]);
+  EXPECT_EQ(ThreadPool::Task::kSweeperPriority, order[3]);
+}
+
 }  // namespace dart
@@ -66,6 +66,14 @@ DEFINE_FLAG(
     false,
     "Record the timeline to the platform's tracing service if there is one");
 DEFINE_FLAG(bool, trace_timeline, false, "Trace timeline backend");
+DEFINE_FLAG(charp,
+            timeline_stream_filters,
+            nullptr,
+            "Comma separated list of <stream>:<sample period>[:<min duration>] "
+            "filters. Only the events of one in <sample period> tasks of the "
+            "stream are recorded, and durations of the VM shorter than "
+            "<min duration> microseconds are dropped. Can be changed at "
+            "runtime with the setFlag service RPC.");
 DEFINE_FLAG(charp,
             timeline_dir,
             nullptr,
@@ -87,6 +95,18 @@ DEFINE_FLAG(bool,
             intern_strings_when_writing_perfetto_timeline,
             false,
             "Intern strings when writing timeline in perfetto format.")
+DEFINE_FLAG(int,
+            timeline_file_segment_size,
+            0,
+            "If positive, the perfettofile recorder writes the timeline into "
+            "--timeline_file_segments files of about this many MB, named "
+            "<file>.0, <file>.1, ..., and overwrites the oldest file when all "
+            "of them are full. The newest segment is the one written last.")
+DEFINE_FLAG(int,
+            timeline_file_segments,
+            4,
+            "The number of files written by the perfettofile recorder if "
+            "--timeline_file_segment_size is set.")
 
 // Implementation notes:
 //
@@ -313,6 +333,60 @@ void Timeline::Init() {
   stream_##name##_.set_enabled(HasStream(enabled_streams_, #name));
   TIMELINE_STREAM_LIST(TIMELINE_STREAM_FLAG_DEFAULT)
 #undef TIMELINE_STREAM_FLAG_DEFAULT
+  UpdateStreamFilters();
+}
+
+static TimelineStream* LookupStream(const char* name) {
+#define TIMELINE_STREAM_LOOKUP(name_, ...)                                     \
+  if (strcmp(name, #name_) == 0) {                                             \
+    return Timeline::Get##name_##Stream();                                     \
+  }
+  TIMELINE_STREAM_LIST(TIMELINE_STREAM_LOOKUP)
+#undef TIMELINE_STREAM_LOOKUP
+  return nullptr;
+}
+
+// Parses a <stream>:<sample period>[:<min duration>] filter.
+static void ApplyStreamFilter(char* filter) {
+  char* period = strchr(filter, ':');
+  TimelineStream* stream = nullptr;
+  if (period != nullptr) {
+    *period++ = '\0';
+    stream = LookupStream(filter);
+  }
+  if (stream == nullptr) {
+    OS::PrintErr("warning: Ignoring timeline stream filter for %s\n", filter);
+    return;
+  }
+  char* end = nullptr;
+  const intptr_t sample_period = strtol(period, &end, 10);
+  int64_t min_duration_micros = 0;
+  if (*end == ':') {
+    min_duration_micros = strtoll(end + 1, &end, 10);
+  }
+  if (end == period || *end != '\0' || sample_period < 1 ||
+      min_duration_micros < 0) {
+    OS::PrintErr("warning: Ignoring timeline stream filter for %s\n", filter);
+    return;
+  }
+  stream->SetFilter(sample_period, min_duration_micros);
+}
+
+void Timeline::UpdateStreamFilters() {
+#define TIMELINE_STREAM_RESET_FILTER(name, ...)                                \
+  stream_##name##_.SetFilter(1, 0);
+  TIMELINE_STREAM_LIST(TIMELINE_STREAM_RESET_FILTER)
+#undef TIMELINE_STREAM_RESET_FILTER
+  const char* filters = FLAG_timeline_stream_filters;
+  while (filters != nullptr && *filters != '\0') {
+    const char* next = strchr(filters, ',');
+    const intptr_t length =
+        (next == nullptr) ? strlen(filters) : (next - filters);
+    char* filter = Utils::StrNDup(filters, length);
+    ApplyStreamFilter(filter);
+    free(filter);
+    filters = (next == nullptr) ? nullptr : next + 1;
+  }
 }
 
 void Timeline::Cleanup() {
@@ -1345,7 +1419,6 @@ void TimelineEventScope::Init() {
     // Stream is not enabled, do nothing.
     return;
   }
-  enabled_ = true;
   Thread* thread = static_cast<Thread*>(this->thread());
   if (thread != nullptr) {
     id_ = thread->GetNextTaskId();
@@ -1353,6 +1426,7 @@ void TimelineEventScope::Init() {
     static RelaxedAtomic<int64_t> next_bootstrap_task_id = {0};
     id_ = next_bootstrap_task_id.fetch_add(1);
   }
+  enabled_ = stream_->Sample(id_);
 }
 
 void TimelineEventScope::SetNumArguments(intptr_t length) {
@@ -1423,6 +1497,11 @@ void TimelineBeginEndScope::EmitBegin() {
   if (!ShouldEmitEvent()) {
     return;
   }
+  if (stream()->min_duration_micros() > 0) {
+    // Emit a duration event at the end instead, if it is long enough.
+    start_micros_ = OS::GetCurrentMonotonicMicros();
+    return;
+  }
   TimelineEvent* event = stream()->StartEvent();
   if (event == nullptr) {
     // Stream is now disabled.
@@ -1439,6 +1518,13 @@ void TimelineBeginEndScope::EmitEnd() {
   if (!ShouldEmitEvent()) {
     return;
   }
+  int64_t end_micros = 0;
+  if (start_micros_ >= 0) {
+    end_micros = OS::GetCurrentMonotonicMicros();
+    if (end_micros - start_micros_ < stream()->min_duration_micros()) {
+      return;
+    }
+  }
   TimelineEvent* event = stream()->StartEvent();
   if (event == nullptr) {
     // Stream is now disabled.
@@ -1446,8 +1532,12 @@ void TimelineBeginEndScope::EmitEnd() {
     return;
   }
   ASSERT(event != nullptr);
-  // Emit an end event.
-  event->End(label(), id());
+  if (start_micros_ >= 0) {
+    event->Duration(label(), start_micros_, end_micros);
+  } else {
+    // Emit an end event.
+    event->End(label(), id());
+  }
   StealArguments(event);
   event->Complete();
 }
@@ -1573,11 +1663,6 @@ TimelineEvent* TimelineEventRecorder::ThreadBlockStartEvent() {
   // Grab the current thread.
   OSThread* thread = OSThread::Current();
   ASSERT(thread != nullptr);
-  // Acquire the recorder lock in case we need to call |GetNewBlockLocked|. We
-  // acquire the lock here and not directly before calls to |GetNewBlockLocked|
-  // due to locking order restrictions.
-  Mutex& recorder_lock = lock_;
-  recorder_lock.Lock();
   Mutex* thread_block_lock = thread->timeline_block_lock();
   ASSERT(thread_block_lock != nullptr);
   // We are accessing the thread's timeline block- so take the lock here.
@@ -1592,28 +1677,34 @@ TimelineEvent* TimelineEventRecorder::ThreadBlockStartEvent() {
 
   TimelineEventBlock* thread_block = thread->TimelineBlockLocked();
 
-  if ((thread_block != nullptr) && thread_block->IsFull()) {
-    // Thread has a block and it is full:
-    // 1) Mark it as finished.
-    thread->SetTimelineBlockLocked(nullptr);
-    FinishBlock(thread_block);
-    // 2) Allocate a new block.
-    // We release |thread_block_lock| before calling |GetNewBlockLocked| to
-    // avoid TSAN warnings about lock order inversion.
-    thread_block_lock->Unlock();
-    thread_block = GetNewBlockLocked();
-    thread_block_lock->Lock();
-    thread->SetTimelineBlockLocked(thread_block);
-  } else if (thread_block == nullptr) {
-    // Thread has no block. Attempt to allocate one.
-    // We release |thread_block_lock| before calling |GetNewBlockLocked| to
-    // avoid TSAN warnings about lock order inversion.
+  if ((thread_block == nullptr) || thread_block->IsFull()) {
+    // Most events are added to the block the thread already has, without
+    // contending for the recorder lock, which is only needed to replace the
+    // block. The recorder lock must be acquired before the thread's block
+    // lock, so the block is looked up again once both are held. It can be
+    // reclaimed in between.
     thread_block_lock->Unlock();
-    thread_block = GetNewBlockLocked();
+    Mutex& recorder_lock = lock_;
+    recorder_lock.Lock();
     thread_block_lock->Lock();
-    thread->SetTimelineBlockLocked(thread_block);
+    thread_block = thread->TimelineBlockLocked();
+    if ((thread_block != nullptr) && thread_block->IsFull()) {
+      // Thread has a block and it is full, so mark it as finished.
+      thread->SetTimelineBlockLocked(nullptr);
+      FinishBlock(thread_block);
+      thread_block = nullptr;
+    }
+    if (thread_block == nullptr) {
+      // Thread has no block. Attempt to allocate one.
+      // We release |thread_block_lock| before calling |GetNewBlockLocked| to
+      // avoid TSAN warnings about lock order inversion.
+      thread_block_lock->Unlock();
+      thread_block = GetNewBlockLocked();
+      thread_block_lock->Lock();
+      thread->SetTimelineBlockLocked(thread_block);
+    }
+    recorder_lock.Unlock();
   }
-  recorder_lock.Unlock();
   if (thread_block != nullptr) {
     // NOTE: We are exiting this function with the thread's block lock held.
     ASSERT(!thread_block->IsFull());
@@ -2150,7 +2241,9 @@ static void TimelineEventFileRecorderBaseStart(uword parameter) {
   reinterpret_cast<TimelineEventFileRecorderBase*>(parameter)->Drain();
 }
 
-TimelineEventFileRecorderBase::TimelineEventFileRecorderBase(const char* path)
+TimelineEventFileRecorderBase::TimelineEventFileRecorderBase(
+    const char* path,
+    intptr_t num_segments)
     : TimelineEventPlatformRecorder(),
       monitor_(),
       head_(nullptr),
@@ -2158,7 +2251,12 @@ TimelineEventFileRecorderBase::TimelineEventFileRecorderBase(const char* path)
       file_(nullptr),
       shutting_down_(false),
       drained_(false),
-      thread_id_(OSThread::kInvalidThreadJoinId) {
+      thread_id_(OSThread::kInvalidThreadJoinId),
+      segments_path_(nullptr),
+      num_segments_(num_segments),
+      segment_index_(0),
+      segment_size_(0),
+      write_buffer_length_(0) {
   Dart_FileOpenCallback file_open = Dart::file_open_callback();
   Dart_FileWriteCallback file_write = Dart::file_write_callback();
   Dart_FileCloseCallback file_close = Dart::file_close_callback();
@@ -2167,9 +2265,17 @@ TimelineEventFileRecorderBase::TimelineEventFileRecorderBase(const char* path)
     OS::PrintErr("warning: Could not access file callbacks.");
     return;
   }
-  void* file = (*file_open)(path, true);
+  void* file;
+  if (num_segments > 0) {
+    segments_path_ = Utils::StrDup(path);
+    file = OpenSegment(0);
+  } else {
+    file = (*file_open)(path, true);
+    if (file == nullptr) {
+      OS::PrintErr("warning: Failed to open timeline file: %s\n", path);
+    }
+  }
   if (file == nullptr) {
-    OS::PrintErr("warning: Failed to open timeline file: %s\n", path);
     return;
   }
 
@@ -2183,6 +2289,8 @@ TimelineEventFileRecorderBase::~TimelineEventFileRecorderBase() {
   // |shutting_down_| is set to true, causing possible use-after-free errors.
   ASSERT(shutting_down_);
 
+  free(segments_path_);
+  segments_path_ = nullptr;
   if (file_ == nullptr) return;
 
   ASSERT(thread_id_ != OSThread::kInvalidThreadJoinId);
@@ -2192,11 +2300,42 @@ TimelineEventFileRecorderBase::~TimelineEventFileRecorderBase() {
   ASSERT(head_ == nullptr);
   ASSERT(tail_ == nullptr);
 
+  Flush();
   Dart_FileCloseCallback file_close = Dart::file_close_callback();
   (*file_close)(file_);
   file_ = nullptr;
 }
 
+void* TimelineEventFileRecorderBase::OpenSegment(intptr_t index) const {
+  ASSERT(segmented());
+  char* path =
+      OS::SCreate(nullptr, "%s.%" Pd, segments_path_, index % num_segments_);
+  void* file = (*Dart::file_open_callback())(path, true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to open timeline file: %s\n", path);
+  }
+  free(path);
+  return file;
+}
+
+bool TimelineEventFileRecorderBase::NextSegment() {
+  ASSERT(segmented());
+  void* file = OpenSegment(segment_index_ + 1);
+  if (file == nullptr) {
+    // Try again once another segment has been written.
+    segment_size_ = 0;
+    return false;
+  }
+  Flush();
+  (*Dart::file_close_callback())(file_);
+  segment_index_++;
+  segment_size_ = 0;
+  // |CompleteEvent| checks whether there is a file under the monitor.
+  MonitorLocker ml(&monitor_);
+  file_ = file;
+  return true;
+}
+
 void TimelineEventFileRecorderBase::Drain() {
   MonitorLocker ml(&monitor_);
   thread_id_ = OSThread::GetCurrentThreadJoinId(OSThread::Current());
@@ -2206,6 +2345,13 @@ void TimelineEventFileRecorderBase::Drain() {
       if (shutting_down_) {
         break;
       }
+      if (write_buffer_length_ > 0) {
+        // Write out buffered events while waiting for more of them.
+        ml.Exit();
+        Flush();
+        ml.Enter();
+        continue;  // Recheck empty.
+      }
       ml.Wait();
       continue;  // Recheck empty.
     }
@@ -2226,22 +2372,41 @@ void TimelineEventFileRecorderBase::Drain() {
   ml.Notify();
 }
 
-void TimelineEventFileRecorderBase::Write(const char* buffer,
-                                          intptr_t len) const {
-  Dart_FileWriteCallback file_write = Dart::file_write_callback();
-  (*file_write)(buffer, len, file_);
+void TimelineEventFileRecorderBase::Write(const char* buffer, intptr_t len) {
+  segment_size_ += len;
+  if (write_buffer_length_ + len > kWriteBufferSize) {
+    Flush();
+    if (len > kWriteBufferSize) {
+      if (file_ != nullptr) {
+        (*Dart::file_write_callback())(buffer, len, file_);
+      }
+      return;
+    }
+  }
+  memmove(&write_buffer_[write_buffer_length_], buffer, len);
+  write_buffer_length_ += len;
+}
+
+void TimelineEventFileRecorderBase::Flush() {
+  if (write_buffer_length_ == 0) {
+    return;
+  }
+  if (file_ != nullptr) {
+    (*Dart::file_write_callback())(write_buffer_, write_buffer_length_, file_);
+  }
+  write_buffer_length_ = 0;
 }
 
 void TimelineEventFileRecorderBase::CompleteEvent(TimelineEvent* event) {
   if (event == nullptr) {
     return;
   }
+
+  MonitorLocker ml(&monitor_);
   if (file_ == nullptr) {
     delete event;
     return;
   }
-
-  MonitorLocker ml(&monitor_);
   ASSERT(!shutting_down_);
   event->set_next(nullptr);
   if (tail_ == nullptr) {
@@ -2327,11 +2492,14 @@ class TimelineEventPerfettoFileRecorder : public TimelineEventFileRecorderBase {
 
  private:
   void WritePacket(
-      protozero::HeapBuffered<perfetto::protos::pbzero::TracePacket>* packet)
-      const;
+      protozero::HeapBuffered<perfetto::protos::pbzero::TracePacket>* packet);
+  // Writes the packets every segment starts with. Interned strings are
+  // written again into each segment, so that it can be read by itself.
+  void StartSegment();
+  void WriteTrackMetadata();
   void DrainImpl(const TimelineEvent& event) final;
 
-  TracePacketWriter writer_;
+  std::unique_ptr<TracePacketWriter> writer_;
 };
 
 static TimelineEventRecorder* CreateTimelineEventPerfettoFileRecorder(
@@ -2341,11 +2509,21 @@ static TimelineEventRecorder* CreateTimelineEventPerfettoFileRecorder(
 
 TimelineEventPerfettoFileRecorder::TimelineEventPerfettoFileRecorder(
     const char* path)
-    : TimelineEventFileRecorderBase(path),
-      writer_(
-          packet(),
-          [this](auto& packet) { this->WritePacket(&packet); },
-          FLAG_intern_strings_when_writing_perfetto_timeline) {
+    : TimelineEventFileRecorderBase(path,
+                                    FLAG_timeline_file_segment_size > 0
+                                        ? Utils::Maximum(
+                                              FLAG_timeline_file_segments, 1)
+                                        : 0) {
+  StartSegment();
+  StartUp("TimelineEventPerfettoFileRecorder");
+}
+
+TimelineEventPerfettoFileRecorder::~TimelineEventPerfettoFileRecorder() {
+  ShutDown();
+  WriteTrackMetadata();
+}
+
+void TimelineEventPerfettoFileRecorder::StartSegment() {
   protozero::HeapBuffered<perfetto::protos::pbzero::TracePacket>& packet =
       this->packet();
 
@@ -2357,39 +2535,42 @@ TimelineEventPerfettoFileRecorder::TimelineEventPerfettoFileRecorder(
   WritePacket(&packet);
   packet.Reset();
 
-  StartUp("TimelineEventPerfettoFileRecorder");
+  writer_.reset(new TracePacketWriter(
+      packet, [this](auto& event_packet) { this->WritePacket(&event_packet); },
+      FLAG_intern_strings_when_writing_perfetto_timeline));
 }
 
-TimelineEventPerfettoFileRecorder::~TimelineEventPerfettoFileRecorder() {
+void TimelineEventPerfettoFileRecorder::WriteTrackMetadata() {
   protozero::HeapBuffered<perfetto::protos::pbzero::TracePacket>& packet =
       this->packet();
-  ShutDown();
-  // We do not need to lock the following section, because at this point
-  // |RecorderSynchronizationLock| must have been put in a state that prevents
-  // the metadata maps from being modified.
-  for (SimpleHashMap::Entry* entry = track_uuid_to_track_metadata().Start();
-       entry != nullptr; entry = track_uuid_to_track_metadata().Next(entry)) {
-    TimelineTrackMetadata* value =
-        static_cast<TimelineTrackMetadata*>(entry->value);
-    value->PopulateTracePacket(packet.get());
-    WritePacket(&packet);
-    packet.Reset();
+  {
+    MutexLocker ml(&track_uuid_to_track_metadata_lock());
+    for (SimpleHashMap::Entry* entry = track_uuid_to_track_metadata().Start();
+         entry != nullptr; entry = track_uuid_to_track_metadata().Next(entry)) {
+      TimelineTrackMetadata* value =
+          static_cast<TimelineTrackMetadata*>(entry->value);
+      value->PopulateTracePacket(packet.get());
+      WritePacket(&packet);
+      packet.Reset();
+    }
   }
-  for (SimpleHashMap::Entry* entry =
-           async_track_uuid_to_track_metadata().Start();
-       entry != nullptr;
-       entry = async_track_uuid_to_track_metadata().Next(entry)) {
-    AsyncTimelineTrackMetadata* value =
-        static_cast<AsyncTimelineTrackMetadata*>(entry->value);
-    value->PopulateTracePacket(packet.get());
-    WritePacket(&packet);
-    packet.Reset();
+  {
+    MutexLocker ml(&async_track_uuid_to_track_metadata_lock());
+    for (SimpleHashMap::Entry* entry =
+             async_track_uuid_to_track_metadata().Start();
+         entry != nullptr;
+         entry = async_track_uuid_to_track_metadata().Next(entry)) {
+      AsyncTimelineTrackMetadata* value =
+          static_cast<AsyncTimelineTrackMetadata*>(entry->value);
+      value->PopulateTracePacket(packet.get());
+      WritePacket(&packet);
+      packet.Reset();
+    }
   }
 }
 
 void TimelineEventPerfettoFileRecorder::WritePacket(
-    protozero::HeapBuffered<perfetto::protos::pbzero::TracePacket>* packet)
-    const {
+    protozero::HeapBuffered<perfetto::protos::pbzero::TracePacket>* packet) {
   const std::tuple<std::unique_ptr<const uint8_t[]>, intptr_t>& response =
       perfetto_utils::GetProtoPreamble(packet);
   Write(reinterpret_cast<const char*>(std::get<0>(response).get()),
@@ -2402,7 +2583,18 @@ void TimelineEventPerfettoFileRecorder::WritePacket(
 }
 
 void TimelineEventPerfettoFileRecorder::DrainImpl(const TimelineEvent& event) {
-  writer_.WriteEvent(event);
+  const intptr_t max_segment_size =
+      static_cast<intptr_t>(FLAG_timeline_file_segment_size) * MB;
+  if (segmented() && segment_size() >= max_segment_size) {
+    // Tracks are described at both ends of each segment, since new tracks
+    // can be added while it is written.
+    WriteTrackMetadata();
+    if (NextSegment()) {
+      StartSegment();
+      WriteTrackMetadata();
+    }
+  }
+  writer_->WriteEvent(event);
   if (event.event_type() == TimelineEvent::kAsyncBegin ||
       event.event_type() == TimelineEvent::kAsyncInstant) {
     AddAsyncTrackMetadataBasedOnEvent(event);
@@ -107,6 +107,24 @@ class TimelineStream {
 
   void set_enabled(bool enabled) { enabled_ = enabled ? 1 : 0; }
 
+  // Only the events of one in |sample_period| ids are recorded, and only
+  // durations of at least |min_duration_micros| are recorded by
+  // |TimelineBeginEndScope|.
+  void SetFilter(intptr_t sample_period, int64_t min_duration_micros) {
+    sample_period_ = sample_period;
+    min_duration_micros_ = min_duration_micros;
+  }
+
+  int64_t min_duration_micros() const { return min_duration_micros_; }
+
+  // Whether the events with the task, async or flow |id| are recorded. The
+  // decision only depends on |id|, so related events are recorded together.
+  bool Sample(int64_t id) const {
+    const intptr_t sample_period = sample_period_;
+    return (sample_period <= 1) ||
+           ((static_cast<uword>(Utils::WordHash(id)) % sample_period) == 0);
+  }
+
   // Records an event. Will return |nullptr| if not enabled. The returned
   // |TimelineEvent| is in an undefined state and must be initialized.
   TimelineEvent* StartEvent();
@@ -130,6 +148,9 @@ class TimelineStream {
   // 0 or 1. If this becomes a BitField, the generated code must be updated.
   uintptr_t enabled_;
 
+  RelaxedAtomic<intptr_t> sample_period_ = {1};
+  RelaxedAtomic<int64_t> min_duration_micros_ = {0};
+
 #if defined(DART_HOST_OS_FUCHSIA)
   trace_site_t trace_site_ = {};
 #elif defined(DART_HOST_OS_MACOS)
@@ -238,6 +259,9 @@ class Timeline : public AllStatic {
 
   static void Clear();
 
+  // Applies --timeline_stream_filters to the streams.
+  static void UpdateStreamFilters();
+
 #ifndef PRODUCT
   // Print information about streams to JSON.
   static void PrintFlagsToJSON(JSONStream* json);
@@ -756,6 +780,10 @@ class TimelineBeginEndScope : public TimelineEventScope {
   void EmitBegin();
   void EmitEnd();
 
+  // The start of the duration if the begin event was not emitted because
+  // short durations are not recorded, or -1.
+  int64_t start_micros_ = -1;
+
   DISALLOW_COPY_AND_ASSIGN(TimelineBeginEndScope);
 };
 
@@ -911,6 +939,12 @@ class TimelineEventRecorder : public MallocAllocated {
   SimpleHashMap& async_track_uuid_to_track_metadata() {
     return async_track_uuid_to_track_metadata_;
   }
+  Mutex& track_uuid_to_track_metadata_lock() {
+    return track_uuid_to_track_metadata_lock_;
+  }
+  Mutex& async_track_uuid_to_track_metadata_lock() {
+    return async_track_uuid_to_track_metadata_lock_;
+  }
 #if defined(SUPPORT_PERFETTO) && !defined(PRODUCT)
   protozero::HeapBuffered<perfetto::protos::pbzero::TracePacket>& packet() {
     return packet_;
@@ -1232,7 +1266,10 @@ class TimelineEventMacosRecorder : public TimelineEventPlatformRecorder {
 
 class TimelineEventFileRecorderBase : public TimelineEventPlatformRecorder {
  public:
-  explicit TimelineEventFileRecorderBase(const char* path);
+  // If |num_segments| is positive, the trace is written into the files
+  // "|path|.0" to "|path|.<num_segments - 1>" in turn, see |NextSegment()|.
+  explicit TimelineEventFileRecorderBase(const char* path,
+                                         intptr_t num_segments = 0);
   virtual ~TimelineEventFileRecorderBase();
 
   intptr_t Size() final { return 0; }
@@ -1240,15 +1277,31 @@ class TimelineEventFileRecorderBase : public TimelineEventPlatformRecorder {
   void Drain();
 
  protected:
-  void Write(const char* buffer, intptr_t len) const;
-  void Write(const char* buffer) const { Write(buffer, strlen(buffer)); }
+  // Writes are buffered until the buffer is full, or until there are no more
+  // events to drain.
+  void Write(const char* buffer, intptr_t len);
+  void Write(const char* buffer) { Write(buffer, strlen(buffer)); }
   void CompleteEvent(TimelineEvent* event) final;
   void StartUp(const char* name);
   void ShutDown();
 
+  bool segmented() const { return segments_path_ != nullptr; }
+  // The number of bytes written into the current segment.
+  intptr_t segment_size() const { return segment_size_; }
+  // Continues the trace in the next segment, overwriting the oldest segment
+  // once all of them have been written. Returns false if the next segment
+  // could not be opened, in which case the trace continues in the current one.
+  // Either way, |segment_size()| is reset.
+  bool NextSegment();
+
  private:
+  static constexpr intptr_t kWriteBufferSize = 64 * KB;
+
   virtual void DrainImpl(const TimelineEvent& event) = 0;
 
+  void* OpenSegment(intptr_t index) const;
+  void Flush();
+
   Monitor monitor_;
   TimelineEvent* head_;
   TimelineEvent* tail_;
@@ -1256,6 +1309,12 @@ class TimelineEventFileRecorderBase : public TimelineEventPlatformRecorder {
   bool shutting_down_;
   bool drained_;
   ThreadJoinId thread_id_;
+  char* segments_path_;
+  intptr_t num_segments_;
+  intptr_t segment_index_;
+  intptr_t segment_size_;
+  intptr_t write_buffer_length_;
+  char write_buffer_[kWriteBufferSize];
 };
 
 class TimelineEventFileRecorder : public TimelineEventFileRecorderBase {
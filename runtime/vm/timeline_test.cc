@@ -341,6 +341,40 @@ TEST_CASE(TimelineEventCallbackRecorderBasic) {
   EXPECT_EQ(1, override.recorder()->CountFor(TimelineEvent::kAsyncEnd));
 }
 
+TEST_CASE(TimelineBeginEndScopeFilters) {
+  TimelineRecorderOverride<EventCounterRecorder> override;
+  TimelineStream stream("testStream", "testStream", false, true);
+
+  { TimelineBeginEndScope tbes(thread, &stream, "unfiltered"); }
+  EXPECT_EQ(1, override.recorder()->CountFor(TimelineEvent::kBegin));
+  EXPECT_EQ(1, override.recorder()->CountFor(TimelineEvent::kEnd));
+
+  // Durations are only recorded once they are long enough.
+  stream.SetFilter(1, kMaxInt64);
+  { TimelineBeginEndScope tbes(thread, &stream, "short"); }
+  EXPECT_EQ(1, override.recorder()->CountFor(TimelineEvent::kBegin));
+  EXPECT_EQ(0, override.recorder()->CountFor(TimelineEvent::kDuration));
+  stream.SetFilter(1, 1);
+  {
+    TimelineBeginEndScope tbes(thread, &stream, "long");
+    OS::Sleep(2);
+  }
+  EXPECT_EQ(1, override.recorder()->CountFor(TimelineEvent::kBegin));
+  EXPECT_EQ(1, override.recorder()->CountFor(TimelineEvent::kDuration));
+
+  // Begin and end events are sampled together.
+  stream.SetFilter(4, 0);
+  const intptr_t kScopes = 1000;
+  for (intptr_t i = 0; i < kScopes; i++) {
+    TimelineBeginEndScope tbes(thread, &stream, "sampled");
+  }
+  const intptr_t begins =
+      override.recorder()->CountFor(TimelineEvent::kBegin) - 1;
+  EXPECT_LT(0, begins);
+  EXPECT_GT(kScopes / 2, begins);
+  EXPECT_EQ(begins + 1, override.recorder()->CountFor(TimelineEvent::kEnd));
+}
+
 TEST_CASE(TimelineRingRecorderJSONOrder) {
   TimelineStream stream("testStream", "testStream", false, true);
 
@@ -1568,4 +1568,70 @@ void DeoptimizeTypeTestingStubs() {
 
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
+#if !defined(PRODUCT)
+
+SubtypeTestCacheStats::~SubtypeTestCacheStats() {
+  for (intptr_t i = 0; i < entries_.length(); i++) {
+    free(entries_[i].type_name);
+  }
+}
+
+void SubtypeTestCacheStats::Increment(Thread* thread,
+                                      const AbstractType& type,
+                                      Counter counter) {
+  ASSERT(FLAG_dump_subtype_test_cache_stats);
+  const char* type_name = type.ScrubbedNameCString();
+  auto isolate_group = thread->isolate_group();
+  SubtypeTestCacheStats* stats = isolate_group->subtype_test_cache_stats();
+  intptr_t index = stats->index_.LookupValue(type_name);
+  if (index == CStringIntMapKeyValueTrait::kNoValue) {
+    index = stats->entries_.length();
+    Entry entry = {Utils::StrDup(type_name), {}};
+    stats->entries_.Add(entry);
+    stats->index_.Insert({entry.type_name, index});
+  }
+  stats->entries_[index].counts[counter]++;
+}
+
+void SubtypeTestCacheStats::Print(IsolateGroup* isolate_group) {
+  SafepointMutexLocker ml(isolate_group->subtype_test_cache_mutex());
+  SubtypeTestCacheStats* stats = isolate_group->subtype_test_cache_stats();
+  MallocGrowableArray<Entry>& entries = stats->entries_;
+
+  struct RuntimeCheckSorter {
+    static int Compare(const Entry* a, const Entry* b) {
+      const intptr_t a_count = a->counts[kRuntimeCheck];
+      const intptr_t b_count = b->counts[kRuntimeCheck];
+      return a_count == b_count ? 0 : (a_count < b_count ? 1 : -1);
+    }
+  };
+  entries.Sort(RuntimeCheckSorter::Compare);
+  // Sorting invalidates the indices in the map.
+  stats->index_.Clear();
+  for (intptr_t i = 0; i < entries.length(); i++) {
+    stats->index_.Insert({entries[i].type_name, i});
+  }
+
+  intptr_t total[kNumCounters] = {};
+  for (intptr_t i = 0; i < entries.length(); i++) {
+    for (intptr_t j = 0; j < kNumCounters; j++) {
+      total[j] += entries[i].counts[j];
+    }
+  }
+  OS::PrintErr("Subtype test cache misses for %" Pd " types: %" Pd
+               " runtime checks, %" Pd " entries added, %" Pd
+               " not added to full caches.\n",
+               entries.length(), total[kRuntimeCheck], total[kCacheAdd],
+               total[kCacheFull]);
+  OS::PrintErr("%10s %10s %10s  %s\n", "checks", "added", "full", "type");
+  for (intptr_t i = 0; i < entries.length(); i++) {
+    const Entry& entry = entries[i];
+    OS::PrintErr("%10" Pd " %10" Pd " %10" Pd "  %s\n",
+                 entry.counts[kRuntimeCheck], entry.counts[kCacheAdd],
+                 entry.counts[kCacheFull], entry.type_name);
+  }
+}
+
+#endif  // !defined(PRODUCT)
+
 }  // namespace dart
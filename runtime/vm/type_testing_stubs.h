@@ -273,6 +273,49 @@ void DeoptimizeTypeTestingStubs();
 
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
+#if !defined(PRODUCT)
+
+// Per destination type counts of type tests which neither the type testing
+// stub nor the subtype test cache of the call site could decide, collected
+// for --dump_subtype_test_cache_stats. Each such test is a miss of the
+// subtype test cache of its call site.
+class SubtypeTestCacheStats : public MallocAllocated {
+ public:
+  enum Counter {
+    // Type tests decided in the runtime.
+    kRuntimeCheck,
+    // Results added to the subtype test cache of the call site.
+    kCacheAdd,
+    // Results not added because the subtype test cache was full.
+    kCacheFull,
+    kNumCounters,
+  };
+
+  SubtypeTestCacheStats() : entries_(), index_() {}
+  ~SubtypeTestCacheStats();
+
+  // Must be called with the subtype test cache mutex of the isolate group
+  // held.
+  static void Increment(Thread* thread,
+                        const AbstractType& type,
+                        Counter counter);
+
+  static void Print(IsolateGroup* isolate_group);
+
+ private:
+  struct Entry {
+    char* type_name;
+    intptr_t counts[kNumCounters];
+  };
+
+  MallocGrowableArray<Entry> entries_;
+  MallocDirectChainedHashMap<CStringIntMapKeyValueTrait> index_;
+
+  DISALLOW_COPY_AND_ASSIGN(SubtypeTestCacheStats);
+};
+
+#endif  // !defined(PRODUCT)
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_TYPE_TESTING_STUBS_H_
@@ -2654,6 +2654,44 @@ TEST_CASE(TTS_STC_Capped) {
   EXPECT(results.cache_capped);
 }
 
+// Type tests against types with uninstantiated type arguments which reach
+// the runtime instantiate these through the instantiations cache.
+ISOLATE_UNIT_TEST_CASE(TTS_UninstantiatedTypesInRuntime) {
+  const char* kScript = R"(
+      import 'dart:async';
+
+      class A<T> {
+        bool isList(Object o) => o is List<T>;
+        List<T> asList(Object o) => o as List<T>;
+        bool isFutureOr(Object? o) => o is FutureOr<T>;
+      }
+
+      bool test() {
+        // Repeat the checks to hit the cached instantiations.
+        for (int i = 0; i < 3; i++) {
+          if (!A<num>().isList(<int>[])) return false;
+          if (A<int>().isList(<num>[])) return false;
+          if (!A<dynamic>().isFutureOr(null)) return false;
+          if (!A<int>().isFutureOr(Future<int>.value(1))) return false;
+          if (A<int>().isFutureOr('a')) return false;
+          if (A<int>().isFutureOr(null)) return false;
+          if (!A<int?>().isFutureOr(null)) return false;
+          A<num>().asList(<int>[]);
+        }
+        try {
+          A<int>().asList(<num>[]);
+          return false;
+        } on TypeError {
+          return true;
+        }
+      }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& result = Object::Handle(Invoke(root_library, "test"));
+  EXPECT(result.ptr() == Bool::True().ptr());
+}
+
 }  // namespace dart
 
 #endif  // !defined(TARGET_ARCH_IA32)
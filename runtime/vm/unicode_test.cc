@@ -1090,4 +1090,35 @@ ISOLATE_UNIT_TEST_CASE(Utf8Decode) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(Utf8LongAsciiPrefix) {
+  // Longer than a word of ASCII before and after a non-ASCII character, so
+  // the prefix is scanned a word at a time.
+  const char* src =
+      "abcdefghijklmnopqrstuvwxyz"
+      "\xC3\xA6"
+      "abcdefghijklmnopqrstuvwxyz";
+  const uint8_t* utf8 = reinterpret_cast<const uint8_t*>(src);
+  const intptr_t utf8_len = strlen(src);
+  Utf8::Type type;
+  const intptr_t len = Utf8::CodeUnitCount(utf8, utf8_len, &type);
+  EXPECT_EQ(53, len);
+  EXPECT_EQ(Utf8::kLatin1, type);
+  EXPECT(Utf8::IsValid(utf8, utf8_len));
+  EXPECT(!Utf8::IsValid(utf8, 27));
+
+  uint8_t latin1[53];
+  EXPECT(Utf8::DecodeToLatin1(utf8, utf8_len, latin1, len));
+  EXPECT_EQ('z', latin1[25]);
+  EXPECT_EQ(0xE6, latin1[26]);
+  EXPECT_EQ('a', latin1[27]);
+  // The output is too short for the ASCII prefix.
+  EXPECT(!Utf8::DecodeToLatin1(utf8, utf8_len, latin1, 10));
+
+  uint16_t utf16[53];
+  EXPECT(Utf8::DecodeToUTF16(utf8, utf8_len, utf16, len));
+  EXPECT_EQ('z', utf16[25]);
+  EXPECT_EQ(0xE6, utf16[26]);
+  EXPECT_EQ('z', utf16[52]);
+}
+
 }  // namespace dart
@@ -6,6 +6,7 @@
 
 #include "platform/assert.h"
 #include "platform/utils.h"
+#include "vm/flags.h"
 
 #if defined(DART_HOST_OS_MACOS)
 #include <mach/mach.h>
@@ -13,6 +14,11 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            huge_pages,
+            false,
+            "Back heap pages with transparent huge pages where available.");
+
 bool VirtualMemory::InSamePage(uword address0, uword address1) {
   return (Utils::RoundDown(address0, PageSize()) ==
           Utils::RoundDown(address1, PageSize()));
@@ -49,6 +49,15 @@ class VirtualMemory {
 
   static void DontNeed(void* address, intptr_t size);
 
+  // Spreads the physical pages later faulted into this range round-robin
+  // across the machine's NUMA nodes. No-op on single-node machines and on
+  // platforms without a memory policy interface.
+  static void Interleave(void* address, intptr_t size);
+
+  // Returns how many bytes of the heap's memory the OS currently backs with
+  // huge pages, or -1 if this is unknown on this platform.
+  static intptr_t HugePageBackedBytes();
+
   // Reserves and commits a virtual memory segment with size. If a segment of
   // the requested size cannot be allocated, nullptr is returned.
   static VirtualMemory* Allocate(intptr_t size,
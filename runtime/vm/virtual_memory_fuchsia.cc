@@ -281,6 +281,12 @@ void VirtualMemory::DontNeed(void* address, intptr_t size) {
   }
 }
 
+void VirtualMemory::Interleave(void* address, intptr_t size) {}
+
+intptr_t VirtualMemory::HugePageBackedBytes() {
+  return -1;
+}
+
 }  // namespace dart
 
 #endif  // defined(DART_HOST_OS_FUCHSIA)
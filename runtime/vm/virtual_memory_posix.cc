@@ -17,12 +17,22 @@
 
 #if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
 #include <sys/prctl.h>
+
+// PR_SET_VMA was only added to mainline Linux in 5.17, and some versions of
+// the Android NDK have incorrect headers, so we manually define it if absent.
+#if !defined(PR_SET_VMA)
+#define PR_SET_VMA 0x53564d41
+#endif
+#if !defined(PR_SET_VMA_ANON_NAME)
+#define PR_SET_VMA_ANON_NAME 0
+#endif
 #endif
 
 #include "platform/assert.h"
 #include "platform/utils.h"
 #include "vm/heap/pages.h"
 #include "vm/isolate.h"
+#include "vm/lockers.h"
 #include "vm/virtual_memory_compressed.h"
 
 // #define VIRTUAL_MEMORY_LOGGING 1
@@ -44,6 +54,7 @@ namespace dart {
 #endif
 
 DECLARE_FLAG(bool, write_protect_code);
+DECLARE_FLAG(bool, huge_pages);
 
 #if defined(DART_TARGET_OS_LINUX)
 DECLARE_FLAG(bool, generate_perf_events_symbols);
@@ -51,6 +62,21 @@ DECLARE_FLAG(bool, generate_perf_jitdump);
 #endif
 
 uword VirtualMemory::page_size_ = 0;
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+// Bit i is set if NUMA node i is online. Zero or a single bit means memory
+// placement is not worth influencing.
+static uint64_t numa_online_nodes_ = 0;
+
+// Transparent huge pages are 2MB on the architectures we support.
+static constexpr intptr_t kHugePageSize = 2 * MB;
+
+// With --huge_pages, heap pages smaller than a huge page are carved out of a
+// shared 2MB-aligned chunk so that neighbouring heap pages form one mapping
+// that the kernel can back with a single huge page.
+static Mutex* huge_chunk_mutex_ = nullptr;
+static uword huge_chunk_top_ = 0;
+static uword huge_chunk_end_ = 0;
+#endif
 VirtualMemory* VirtualMemory::compressed_heap_ = nullptr;
 #if defined(DART_HOST_OS_IOS) && !defined(DART_PRECOMPILED_RUNTIME)
 bool VirtualMemory::notify_debugger_about_rx_pages_ = false;
@@ -109,6 +135,68 @@ static void* GenericMapAligned(void* hint,
   return reinterpret_cast<void*>(aligned_base);
 }
 
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+static void AdviseHugePages(void* address, intptr_t size) {
+  // Failure (e.g., THP disabled in the kernel) is harmless: the range just
+  // stays on base pages.
+  if (madvise(address, size, MADV_HUGEPAGE) != 0) {
+    LOG_INFO("madvise(0x%" Px ", 0x%" Px ", HUGEPAGE) failed: %d\n",
+             reinterpret_cast<uword>(address), size, errno);
+  }
+}
+
+static void* AllocateFromHugeChunk(intptr_t size,
+                                   intptr_t alignment,
+                                   const char* name) {
+  ASSERT(size < kHugePageSize);
+  ASSERT(alignment <= kHugePageSize);
+  MutexLocker ml(huge_chunk_mutex_);
+  uword start = Utils::RoundUp(huge_chunk_top_, alignment);
+  if ((huge_chunk_top_ == 0) || (start + size > huge_chunk_end_)) {
+    // Return the unused tail of the old chunk.
+    Unmap(huge_chunk_top_, huge_chunk_end_);
+    huge_chunk_top_ = huge_chunk_end_ = 0;
+    void* chunk = GenericMapAligned(
+        nullptr, PROT_READ | PROT_WRITE, kHugePageSize, kHugePageSize,
+        2 * kHugePageSize, MAP_PRIVATE | MAP_ANONYMOUS);
+    if (chunk == nullptr) {
+      return nullptr;
+    }
+    AdviseHugePages(chunk, kHugePageSize);
+    prctl(PR_SET_VMA, PR_SET_VMA_ANON_NAME, chunk, kHugePageSize, name);
+    huge_chunk_top_ = start = reinterpret_cast<uword>(chunk);
+    huge_chunk_end_ = huge_chunk_top_ + kHugePageSize;
+  }
+  Unmap(huge_chunk_top_, start);
+  huge_chunk_top_ = start + size;
+  return reinterpret_cast<void*>(start);
+}
+
+// Parses a node list such as "0-3,5" from sysfs into a bit mask.
+static uint64_t ReadOnlineNumaNodes() {
+  FILE* fp = fopen("/sys/devices/system/node/online", "r");
+  if (fp == nullptr) return 0;
+  uint64_t mask = 0;
+  unsigned first, last;
+  while (true) {
+    int count = fscanf(fp, "%u", &first);
+    if (count != 1) break;
+    last = first;
+    int c = fgetc(fp);
+    if (c == '-') {
+      if (fscanf(fp, "%u", &last) != 1) break;
+      c = fgetc(fp);
+    }
+    for (unsigned i = first; i <= last && i < 64; i++) {
+      mask |= static_cast<uint64_t>(1) << i;
+    }
+    if (c != ',') break;
+  }
+  fclose(fp);
+  return mask;
+}
+#endif
+
 intptr_t VirtualMemory::CalculatePageSize() {
   const intptr_t page_size = getpagesize();
   ASSERT(page_size != 0);
@@ -330,6 +418,9 @@ void VirtualMemory::Init() {
       }
     }
   }
+  numa_online_nodes_ = ReadOnlineNumaNodes();
+  ASSERT(huge_chunk_mutex_ == nullptr);
+  huge_chunk_mutex_ = new Mutex();
 #endif
 }
 
@@ -338,6 +429,13 @@ void VirtualMemory::Cleanup() {
   delete compressed_heap_;
 #endif  // defined(DART_COMPRESSED_POINTERS)
   page_size_ = 0;
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  numa_online_nodes_ = 0;
+  Unmap(huge_chunk_top_, huge_chunk_end_);
+  huge_chunk_top_ = huge_chunk_end_ = 0;
+  delete huge_chunk_mutex_;
+  huge_chunk_mutex_ = nullptr;
+#endif
 #if defined(DART_COMPRESSED_POINTERS)
   compressed_heap_ = nullptr;
   VirtualMemoryCompressedHeap::Cleanup();
@@ -385,10 +483,32 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
       return nullptr;
     }
     Commit(region.pointer(), region.size());
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+    // The compressed heap hands out neighbouring regions, so advising each
+    // one lets the kernel merge them back into huge-page eligible mappings.
+    if (FLAG_huge_pages) {
+      AdviseHugePages(region.pointer(), region.size());
+    }
+#endif
     return new VirtualMemory(region, region);
   }
 #endif  // defined(DART_COMPRESSED_POINTERS)
 
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  const bool huge = FLAG_huge_pages && !is_executable;
+  if (huge) {
+    if ((size < kHugePageSize) && (alignment <= kHugePageSize)) {
+      void* address = AllocateFromHugeChunk(size, alignment, name);
+      if (address != nullptr) {
+        MemoryRegion region(address, size);
+        return new VirtualMemory(region, region);
+      }
+    } else {
+      alignment = Utils::Maximum(alignment, kHugePageSize);
+    }
+  }
+#endif
+
   const intptr_t allocated_size = size + alignment - PageSize();
 
 #if defined(DART_HOST_OS_IOS) && !defined(DART_PRECOMPILED_RUNTIME)
@@ -445,14 +565,9 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
 #endif
 
 #if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
-  // PR_SET_VMA was only added to mainline Linux in 5.17, and some versions of
-  // the Android NDK have incorrect headers, so we manually define it if absent.
-#if !defined(PR_SET_VMA)
-#define PR_SET_VMA 0x53564d41
-#endif
-#if !defined(PR_SET_VMA_ANON_NAME)
-#define PR_SET_VMA_ANON_NAME 0
-#endif
+  if (huge) {
+    AdviseHugePages(address, size);
+  }
   prctl(PR_SET_VMA, PR_SET_VMA_ANON_NAME, address, size, name);
 #endif
 
@@ -591,6 +706,57 @@ void VirtualMemory::DontNeed(void* address, intptr_t size) {
   }
 }
 
+void VirtualMemory::Interleave(void* address, intptr_t size) {
+#if (defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)) &&         \
+    defined(SYS_mbind)
+  if (Utils::CountOneBits64(numa_online_nodes_) < 2) return;
+  uword start_address = reinterpret_cast<uword>(address);
+  uword end_address = start_address + size;
+  uword page_address = Utils::RoundDown(start_address, PageSize());
+  const int kMpolInterleave = 3;  // MPOL_INTERLEAVE from <linux/mempolicy.h>.
+  unsigned long nodemask = static_cast<unsigned long>(numa_online_nodes_);
+  // The policy only affects pages faulted in after this call, so it must be
+  // applied before the range is first touched. Failure is not fatal: the
+  // memory is just placed by the default first-touch policy.
+  if (syscall(SYS_mbind, page_address, end_address - page_address,
+              kMpolInterleave, &nodemask, sizeof(nodemask) * kBitsPerByte,
+              0) != 0) {
+    LOG_INFO("mbind(0x%" Px ", 0x%" Px ", INTERLEAVE) failed: %d\n",
+             page_address, end_address - page_address, errno);
+  }
+#endif
+}
+
+intptr_t VirtualMemory::HugePageBackedBytes() {
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  FILE* fp = fopen("/proc/self/smaps", "r");
+  if (fp == nullptr) {
+    return -1;
+  }
+  intptr_t total_kb = 0;
+  bool in_heap = false;
+  char line[512];
+  while (fgets(line, sizeof(line), fp) != nullptr) {
+    unsigned long start, end;  // NOLINT
+    long kb;                   // NOLINT
+    if (sscanf(line, "%lx-%lx", &start, &end) == 2) {
+      // A new mapping. Heap pages outside the compressed heap are named.
+      in_heap = strstr(line, "[anon:dart-heap]") != nullptr;
+#if defined(DART_COMPRESSED_POINTERS)
+      in_heap = in_heap || ((compressed_heap_ != nullptr) &&
+                            compressed_heap_->Contains(start));
+#endif
+    } else if (in_heap && (sscanf(line, "AnonHugePages: %ld kB", &kb) == 1)) {
+      total_kb += kb;
+    }
+  }
+  fclose(fp);
+  return total_kb * KB;
+#else
+  return -1;
+#endif
+}
+
 }  // namespace dart
 
 #endif  // defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX) ||     \
@@ -65,6 +65,43 @@ VM_UNIT_TEST_CASE(AllocateAlignedVirtualMemory) {
   }
 }
 
+DECLARE_FLAG(bool, huge_pages);
+
+VM_UNIT_TEST_CASE(AllocateHugePageVirtualMemory) {
+  const bool saved_huge_pages = FLAG_huge_pages;
+  FLAG_huge_pages = true;
+
+  // Enough heap pages to span more than one 2MB chunk.
+  const intptr_t kNumPages = 3 * (2 * MB) / kPageSize;
+  VirtualMemory* pages[kNumPages];
+  for (intptr_t i = 0; i < kNumPages; i++) {
+    pages[i] = VirtualMemory::AllocateAligned(kPageSize, kPageSize, false,
+                                              false, "dart-heap");
+    EXPECT(pages[i] != nullptr);
+    EXPECT(Utils::IsAligned(pages[i]->start(), kPageSize));
+    EXPECT_EQ(kPageSize, pages[i]->size());
+    memset(pages[i]->address(), 0xAB, pages[i]->size());
+  }
+  for (intptr_t i = 0; i < kNumPages; i++) {
+    for (intptr_t j = i + 1; j < kNumPages; j++) {
+      EXPECT(!pages[i]->Contains(pages[j]->start()));
+    }
+  }
+  EXPECT(VirtualMemory::HugePageBackedBytes() >= -1);
+  for (intptr_t i = 0; i < kNumPages; i++) {
+    delete pages[i];
+  }
+
+  VirtualMemory* large = VirtualMemory::AllocateAligned(
+      4 * MB, kPageSize, false, false, "dart-heap");
+  EXPECT(large != nullptr);
+  EXPECT(Utils::IsAligned(large->start(), kPageSize));
+  EXPECT_EQ(4 * MB, large->size());
+  delete large;
+
+  FLAG_huge_pages = saved_huge_pages;
+}
+
 VM_UNIT_TEST_CASE(FreeVirtualMemory) {
   // Reservations should always be handed back to OS upon destruction.
   const intptr_t kVirtualMemoryBlockSize = 10 * MB;
@@ -243,6 +243,12 @@ void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 
 void VirtualMemory::DontNeed(void* address, intptr_t size) {}
 
+void VirtualMemory::Interleave(void* address, intptr_t size) {}
+
+intptr_t VirtualMemory::HugePageBackedBytes() {
+  return -1;
+}
+
 }  // namespace dart
 
 #endif  // defined(DART_HOST_OS_WINDOWS)
@@ -15,6 +15,7 @@ namespace dart {
 // Forward declarations.
 class Isolate;
 class IsolateGroup;
+class StackMapCache;
 
 // An object pointer visitor interface.
 class ObjectPointerVisitor {
@@ -70,6 +71,11 @@ class ObjectPointerVisitor {
 
   const ClassTable* class_table() const { return class_table_; }
 
+  // Cache of stack map entries used when visiting frames of AOT code, or
+  // nullptr. The cache must not outlive the code it describes.
+  StackMapCache* stack_map_cache() const { return stack_map_cache_; }
+  void set_stack_map_cache(StackMapCache* cache) { stack_map_cache_ = cache; }
+
   // Returns true if pointers of the given SuspendState object can be visited.
   // Compactor overrides this method in order to postpone visiting SuspendState
   // objects with evacuated frames, as visiting them may touch other Dart
@@ -83,6 +89,7 @@ class ObjectPointerVisitor {
   IsolateGroup* isolate_group_;
   const char* gc_root_type_;
   ClassTable* class_table_;
+  StackMapCache* stack_map_cache_ = nullptr;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(ObjectPointerVisitor);
 };
@@ -55,12 +55,50 @@ static Mutex* segment_cache_mutex = nullptr;
 static VirtualMemory* segment_cache[kSegmentCacheCapacity] = {nullptr};
 static intptr_t segment_cache_size = 0;
 
+// Larger segments, from large allocations and from the geometric growth of
+// big zones, are also cached up to a total size, and reused for requests of
+// up to their size.
+static constexpr intptr_t kLargeSegmentCacheCapacity = 4;
+static constexpr intptr_t kLargeSegmentCacheMaxSize = 8 * MB;
+static VirtualMemory* large_segment_cache[kLargeSegmentCacheCapacity] = {
+    nullptr};
+static intptr_t large_segment_cache_size = 0;
+static intptr_t large_segment_cache_bytes = 0;
+
+static RelaxedAtomic<intptr_t> reused_segments = {0};
+static RelaxedAtomic<intptr_t> allocated_segments = {0};
+
+// Returns the smallest cached large segment of at least |size| bytes which
+// does not waste more than half of it. Requires segment_cache_mutex.
+static VirtualMemory* TakeLargeSegment(intptr_t size) {
+  intptr_t best = -1;
+  for (intptr_t i = 0; i < large_segment_cache_size; i++) {
+    const intptr_t cached_size = large_segment_cache[i]->size();
+    if ((cached_size >= size) && (cached_size <= 2 * size) &&
+        ((best == -1) ||
+         (cached_size < large_segment_cache[best]->size()))) {
+      best = i;
+    }
+  }
+  if (best == -1) {
+    return nullptr;
+  }
+  VirtualMemory* memory = large_segment_cache[best];
+  large_segment_cache[best] = large_segment_cache[--large_segment_cache_size];
+  large_segment_cache_bytes -= memory->size();
+  return memory;
+}
+
 void Zone::Init() {
   ASSERT(segment_cache_mutex == nullptr);
   segment_cache_mutex = new Mutex();
 }
 
 void Zone::Cleanup() {
+  if (FLAG_trace_zones) {
+    OS::PrintErr("Zone segments: %" Pd " reused, %" Pd " allocated\n",
+                 reused_segments.load(), allocated_segments.load());
+  }
   ClearCache();
   delete segment_cache_mutex;
   segment_cache_mutex = nullptr;
@@ -73,6 +111,12 @@ void Zone::ClearCache() {
   while (segment_cache_size > 0) {
     delete segment_cache[--segment_cache_size];
   }
+  while (large_segment_cache_size > 0) {
+    VirtualMemory* memory = large_segment_cache[--large_segment_cache_size];
+    total_size_.fetch_sub(memory->size());
+    delete memory;
+  }
+  large_segment_cache_bytes = 0;
 }
 
 Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
@@ -85,15 +129,24 @@ Zone::Segment* Zone::Segment::New(intptr_t size, Zone::Segment* next) {
     if (segment_cache_size > 0) {
       memory = segment_cache[--segment_cache_size];
     }
+  } else {
+    MutexLocker ml(segment_cache_mutex);
+    memory = TakeLargeSegment(size);
+    if (memory != nullptr) {
+      size = memory->size();
+    }
   }
   if (memory == nullptr) {
     bool executable = false;
     bool compressed = false;
     memory = VirtualMemory::Allocate(size, executable, compressed, "dart-zone");
+    if (memory == nullptr) {
+      OUT_OF_MEMORY();
+    }
     total_size_.fetch_add(size);
-  }
-  if (memory == nullptr) {
-    OUT_OF_MEMORY();
+    allocated_segments.fetch_add(1);
+  } else {
+    reused_segments.fetch_add(1);
   }
   Segment* result = reinterpret_cast<Segment*>(memory->start());
 #ifdef DEBUG
@@ -132,6 +185,14 @@ void Zone::Segment::DeleteSegmentList(Segment* head) {
         segment_cache[segment_cache_size++] = memory;
         memory = nullptr;
       }
+    } else {
+      MutexLocker ml(segment_cache_mutex);
+      if ((large_segment_cache_size < kLargeSegmentCacheCapacity) &&
+          (large_segment_cache_bytes + size <= kLargeSegmentCacheMaxSize)) {
+        large_segment_cache[large_segment_cache_size++] = memory;
+        large_segment_cache_bytes += size;
+        memory = nullptr;
+      }
     }
     if (memory != nullptr) {
       total_size_.fetch_sub(size);
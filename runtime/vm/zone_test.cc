@@ -255,6 +255,24 @@ ISOLATE_UNIT_TEST_CASE(StressMallocThroughZones) {
 #endif
 }
 
+ISOLATE_UNIT_TEST_CASE(LargeZoneSegmentsAreReused) {
+  const intptr_t kSize = 1 * MB;
+  Zone::ClearCache();
+  uword first;
+  {
+    StackZone stack_zone(thread);
+    first =
+        reinterpret_cast<uword>(stack_zone.GetZone()->Alloc<uint8_t>(kSize));
+  }
+  {
+    // A smaller large allocation reuses the cached segment.
+    StackZone stack_zone(thread);
+    uword second = reinterpret_cast<uword>(
+        stack_zone.GetZone()->Alloc<uint8_t>(kSize - 64 * KB));
+    EXPECT_EQ(first, second);
+  }
+}
+
 #if defined(DART_COMPRESSED_POINTERS)
 ISOLATE_UNIT_TEST_CASE(ZonesNotLimitedByCompressedHeap) {
   StackZone stack_zone(Thread::Current());
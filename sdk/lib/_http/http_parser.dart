@@ -662,6 +662,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
             // Start of new header field.
             _addWithValidation(_headerField, _toLowerCaseByte(byte));
             _state = _State.HEADER_FIELD;
+            _addHeaderFieldRun();
           }
           break;
 
@@ -673,6 +674,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
               throw HttpException("Invalid header field name, with $byte");
             }
             _addWithValidation(_headerField, _toLowerCaseByte(byte));
+            _addHeaderFieldRun();
           }
           break;
 
@@ -685,6 +687,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
             // Start of new header value.
             _addToHeaderValueWithValidation(_headerValue, byte);
             _state = _State.HEADER_VALUE;
+            _addHeaderValueRun();
           }
           break;
 
@@ -695,6 +698,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
             _state = _State.HEADER_VALUE_FOLD_OR_END;
           } else {
             _addToHeaderValueWithValidation(_headerValue, byte);
+            _addHeaderValueRun();
           }
           break;
 
@@ -778,6 +782,7 @@ class _HttpParser extends Stream<_HttpIncoming> {
               // Start of new header field.
               _state = _State.HEADER_FIELD;
               _addWithValidation(_headerField, _toLowerCaseByte(byte));
+              _addHeaderFieldRun();
             }
           }
           break;
@@ -1127,6 +1132,51 @@ class _HttpParser extends Stream<_HttpIncoming> {
     _addWithValidation(list, byte);
   }
 
+  // Adds the token characters following the current byte of a header field
+  // name in the buffer, without going through the state machine for each of
+  // them. Stops at the first byte which is not a token character, e.g. the
+  // colon, and leaves it to the state machine.
+  void _addHeaderFieldRun() {
+    final buffer = _buffer!;
+    final headerField = _headerField;
+    final length = buffer.length;
+    int index = _index;
+    while (index < length) {
+      final int byte = buffer[index];
+      if (!_isTokenChar(byte)) break;
+      if (++_headersReceivedSize >= _headerTotalSizeLimit) {
+        _index = index;
+        _reportSizeLimitError();
+      }
+      headerField.add(_toLowerCaseByte(byte));
+      index++;
+    }
+    _index = index;
+  }
+
+  // Like [_addHeaderFieldRun] for the bytes of a header value, up to the end
+  // of the line or of the buffer.
+  void _addHeaderValueRun() {
+    final buffer = _buffer!;
+    final headerValue = _headerValue;
+    final length = buffer.length;
+    int index = _index;
+    while (index < length) {
+      final int byte = buffer[index];
+      if (byte == _CharCode.CR || byte == _CharCode.LF) break;
+      if (byte == 0) {
+        throw HttpException("Illegal value $byte in HTTP header");
+      }
+      if (++_headersReceivedSize >= _headerTotalSizeLimit) {
+        _index = index;
+        _reportSizeLimitError();
+      }
+      headerValue.add(byte);
+      index++;
+    }
+    _index = index;
+  }
+
   void _addWithValidation(List<int> list, int byte) {
     _headersReceivedSize++;
     if (_headersReceivedSize < _headerTotalSizeLimit) {
@@ -116,10 +116,14 @@ base class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   external read(int bytes);
   @pragma("vm:external-name", "File_ReadInto")
   external readInto(List<int> buffer, int start, int? end);
+  @pragma("vm:external-name", "File_ReadIntoAt")
+  external readIntoAt(int position, List<int> buffer, int start, int? end);
   @pragma("vm:external-name", "File_WriteByte")
   external writeByte(int value);
   @pragma("vm:external-name", "File_WriteFrom")
   external writeFrom(List<int> buffer, int start, int? end);
+  @pragma("vm:external-name", "File_WriteFromAt")
+  external writeFromAt(int position, List<int> buffer, int start, int? end);
   @pragma("vm:external-name", "File_Position")
   external position();
   @pragma("vm:external-name", "File_SetPosition")
@@ -132,6 +136,8 @@ base class _RandomAccessFileOpsImpl extends NativeFieldWrapperClass1
   external flush();
   @pragma("vm:external-name", "File_Lock")
   external lock(int lock, int start, int end);
+  @pragma("vm:external-name", "File_Map")
+  external map(int start, int end, int advice);
 }
 
 class _WatcherPath {
@@ -5,11 +5,49 @@
 part of "common_patch.dart";
 
 @pragma("vm:external-name", "IOService_NewServicePort")
-external SendPort _newServicePort();
+external SendPort _newServicePort(int lane);
 
 @patch
 class _IOService {
-  static final SendPort _port = _newServicePort();
+  // Requests are served by a separate native port per lane, so that slow
+  // requests of one kind cannot delay the others. Keep in sync with
+  // IOServiceLane in dart_io_api.h.
+  static const int _fileLane = 0;
+  static const int _lookupLane = 1;
+  static const int _secureSocketLane = 2;
+  static const int _fileDataLane = 3;
+
+  static final SendPort _filePort = _newServicePort(_fileLane);
+  static final SendPort _lookupPort = _newServicePort(_lookupLane);
+  static final SendPort _secureSocketPort = _newServicePort(
+    _secureSocketLane,
+  );
+  static final SendPort _fileDataPort = _newServicePort(_fileDataLane);
+
+  static SendPort _portFor(int request) {
+    switch (request) {
+      case _IOService.socketLookup:
+      case _IOService.socketListInterfaces:
+      case _IOService.socketReverseLookup:
+        return _lookupPort;
+      case _IOService.sslProcessFilter:
+        return _secureSocketPort;
+      // Transfers which may block on slow storage for a long time do not
+      // hold up opening, closing and inspecting other files.
+      case _IOService.fileCopy:
+      case _IOService.fileFlush:
+      case _IOService.fileReadByte:
+      case _IOService.fileWriteByte:
+      case _IOService.fileRead:
+      case _IOService.fileReadInto:
+      case _IOService.fileWriteFrom:
+      case _IOService.fileReadIntoAt:
+      case _IOService.fileWriteFromAt:
+        return _fileDataPort;
+      default:
+        return _filePort;
+    }
+  }
 
   static final RawReceivePort _receivePort = RawReceivePort((
     List<Object?> data,
@@ -34,7 +72,9 @@ class _IOService {
         _receivePort.keepIsolateAlive = true;
       }
       _messageMap[id] = completer;
-      _port.send(<dynamic>[id, _receivePort.sendPort, request, data]);
+      _portFor(
+        request,
+      ).send(<dynamic>[id, _receivePort.sendPort, request, data]);
     } catch (error) {
       _forwardResponse(id, error);
     }
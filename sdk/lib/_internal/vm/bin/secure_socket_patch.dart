@@ -162,6 +162,9 @@ base class _SecureFilterImpl extends NativeFieldWrapperClass1
 
   int processBuffer(int bufferIndex) => throw new UnimplementedError();
 
+  @pragma("vm:external-name", "SecureSocket_ProcessAllBuffers")
+  external List<Object?> processAllBuffers(List<int> positions);
+
   @pragma("vm:external-name", "SecureSocket_GetSelectedProtocol")
   external String? selectedProtocol();
 
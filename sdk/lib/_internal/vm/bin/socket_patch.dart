@@ -1443,11 +1443,15 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     if (isClosing || isClosed) return 0;
     if (bytes == 0) return 0;
     try {
-      _BufferAndStart bufferAndStart = _ensureFastAndSerializableByteData(
-        buffer,
-        offset,
-        offset + bytes,
-      );
+      // The data is not sent in a message, so views into large buffers can
+      // be written directly instead of being copied first.
+      _BufferAndStart bufferAndStart = (buffer is Uint8List)
+          ? new _BufferAndStart(buffer, offset)
+          : _ensureFastAndSerializableByteData(
+              buffer,
+              offset,
+              offset + bytes,
+            );
       if (!const bool.fromEnvironment("dart.vm.product")) {
         _SocketProfile.collectStatistic(
           nativeGetSocketId(),
@@ -1483,6 +1487,73 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
     }
   }
 
+  // Writes [buffers] in order, starting at [offset] in the first one, using
+  // as few system calls as possible. Returns the number of bytes written. See
+  // [write] for the handling of partial writes.
+  int writeVector(List<Uint8List> buffers, int offset) {
+    offset = _fixOffset(offset);
+    if (buffers.isEmpty) return 0;
+    if (offset < 0 || offset > buffers[0].length) {
+      throw new RangeError.value(offset);
+    }
+    if (isClosing || isClosed) return 0;
+    int bytes = -offset;
+    for (final buffer in buffers) {
+      bytes += buffer.length;
+    }
+    if (bytes == 0) return 0;
+    try {
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        _SocketProfile.collectStatistic(
+          nativeGetSocketId(),
+          _SocketProfileType.writeBytes,
+          bytes,
+        );
+      }
+      int result = nativeWriteVector(buffers, offset);
+      if (result >= 0) {
+        writeAvailable = (result == bytes) && !hasPendingWrite();
+      } else {
+        // Forced short write for testing, see [write].
+        result = -result;
+        writeAvailable = !hasPendingWrite();
+      }
+      return result;
+    } catch (e) {
+      StackTrace st = StackTrace.current;
+      scheduleMicrotask(() => reportError(e, st, "Write failed"));
+      return 0;
+    }
+  }
+
+  // Sends [count] bytes of the file [fileFd] starting at [position] without
+  // copying them through the Dart heap. Returns the number of bytes sent, or
+  // null if the file cannot be sent this way and must be read and written
+  // instead. See [write] for the handling of partial writes.
+  int? sendFile(int fileFd, int position, int count) {
+    if (position < 0) throw new RangeError.value(position);
+    if (count < 0) throw new RangeError.value(count);
+    if (isClosing || isClosed) return 0;
+    if (count == 0) return 0;
+    try {
+      int? result = nativeSendFile(fileFd, position, count);
+      if (result == null) return null;
+      if (!const bool.fromEnvironment("dart.vm.product")) {
+        _SocketProfile.collectStatistic(
+          nativeGetSocketId(),
+          _SocketProfileType.writeBytes,
+          result,
+        );
+      }
+      writeAvailable = (result == count) && !hasPendingWrite();
+      return result;
+    } catch (e) {
+      StackTrace st = StackTrace.current;
+      scheduleMicrotask(() => reportError(e, st, "Write failed"));
+      return 0;
+    }
+  }
+
   int send(
     List<int> buffer,
     int offset,
@@ -2041,6 +2112,10 @@ base class _NativeSocket extends _NativeSocketNativeWrapper
   external List<dynamic> nativeReceiveMessage(int len);
   @pragma("vm:external-name", "Socket_WriteList")
   external int nativeWrite(List<int> buffer, int offset, int bytes);
+  @pragma("vm:external-name", "Socket_SendFile")
+  external int? nativeSendFile(int fileFd, int position, int count);
+  @pragma("vm:external-name", "Socket_WriteVector")
+  external int nativeWriteVector(List<Uint8List> buffers, int offset);
   @pragma("vm:external-name", "Socket_HasPendingWrite")
   external bool nativeHasPendingWrite();
   @pragma("vm:external-name", "Socket_SendTo")
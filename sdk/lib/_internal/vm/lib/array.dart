@@ -18,7 +18,7 @@ abstract class _Array<E> extends FixedLengthListBase<E> {
 
   @pragma("vm:prefer-inline")
   _List _slice(int start, int count, bool needsTypeArgument) {
-    if (count <= 64) {
+    if (count <= _List._copyLoopLimit) {
       final result = needsTypeArgument ? new _List<E>(count) : new _List(count);
       for (int i = 0; i < result.length; i++) {
         result[i] = this[start + i];
@@ -139,8 +139,10 @@ class _List<E> extends _Array<E> {
   factory _List._ofGrowableList(_GrowableList<E> elements) {
     final int length = elements.length;
     final list = _List<E>(length);
-    // TODO(30102): Remove this loop zero-trip guard.
-    if (length > 0) {
+    if (length > _copyLoopLimit) {
+      _copyRange(elements, 0, list, 0, length);
+    } else if (length > 0) {
+      // TODO(30102): Remove this loop zero-trip guard.
       for (int i = 0; i < length; i++) {
         list[i] = elements[i];
       }
@@ -151,8 +153,10 @@ class _List<E> extends _Array<E> {
   factory _List._ofArray(_Array<E> elements) {
     final int length = elements.length;
     final list = _List<E>(length);
-    // TODO(30102): Remove this loop zero-trip guard.
-    if (length > 0) {
+    if (length > _copyLoopLimit) {
+      _copyRange(elements, 0, list, 0, length);
+    } else if (length > 0) {
+      // TODO(30102): Remove this loop zero-trip guard.
       for (int i = 0; i < length; i++) {
         list[i] = elements[i];
       }
@@ -192,6 +196,22 @@ class _List<E> extends _Array<E> {
   @pragma("vm:external-name", "List_setIndexed")
   external void _setIndexed(int index, E value);
 
+  // Number of elements above which copies between VM lists are done by
+  // the runtime instead of a loop over the elements.
+  static const int _copyLoopLimit = 64;
+
+  // Copies [count] elements of the VM list [src] starting at [srcStart] into
+  // the VM list [dst] starting at [dstStart]. The elements are not type
+  // checked, so the caller must ensure that they are valid for [dst].
+  @pragma("vm:external-name", "List_copyRange")
+  external static void _copyRange(
+    List src,
+    int srcStart,
+    List dst,
+    int dstStart,
+    int count,
+  );
+
   // List interface.
   void setRange(int start, int end, Iterable<E> iterable, [int skipCount = 0]) {
     if (start < 0 || start > this.length) {
@@ -277,11 +297,13 @@ class _ArrayIterator<E> implements Iterator<E> {
   int _index;
   E? _current;
 
+  @pragma("vm:prefer-inline")
   _ArrayIterator(_Array<E> array)
     : _array = array,
       _length = array.length,
       _index = 0 {}
 
+  @pragma("vm:prefer-inline")
   E get current => _current as E;
 
   @pragma("vm:prefer-inline")
@@ -332,6 +332,28 @@ class _SuspendState {
     return _functionData;
   }
 
+  // Used instead of [_await] if the VM is run with
+  // --skip_await_of_completed_futures: returns true if [object] is a future
+  // which completed with a value in the root zone, so the value can be taken
+  // without suspending.
+  @pragma("vm:entry-point", "call")
+  @pragma("vm:invisible")
+  @pragma("vm:prefer-inline")
+  static bool _canSkipAwait(Object? object) {
+    return object is _Future &&
+        object._isComplete &&
+        !object._hasError &&
+        identical(Zone._current, _rootZone) &&
+        identical(object._zone, _rootZone);
+  }
+
+  @pragma("vm:entry-point", "call")
+  @pragma("vm:invisible")
+  @pragma("vm:prefer-inline")
+  static Object? _completedValue(Object? object) {
+    return unsafeCast<_Future>(object)._resultOrListeners;
+  }
+
   @pragma("vm:entry-point", "call")
   @pragma("vm:invisible")
   Object? _awaitWithTypeCheck<T>(Object? object) {
@@ -3,7 +3,9 @@
 // BSD-style license that can be found in the LICENSE file.
 
 import "dart:_internal" show patch;
-import "dart:ffi" show Handle, Void, Native;
+import "dart:ffi"
+    show Bool, Handle, Int64, Int64ListAddress, IntPtr, Native, Pointer, Void;
+import "dart:typed_data" show Int64List;
 import "dart:nativewrappers" show NativeFieldWrapperClass1;
 
 @patch
@@ -22,11 +24,38 @@ base class _MutexImpl extends NativeFieldWrapperClass1 implements Mutex {
   @Native<Void Function(Handle)>(symbol: "Mutex_Initialize")
   external void _initialize();
 
-  @Native<Handle Function(Handle, Handle)>(symbol: "Mutex_RunLocked")
-  external Object _runLocked(Object action);
+  // Number of times to try taking a contended mutex before blocking.
+  static const int _spinCount = 100;
 
+  @Native<Bool Function(Pointer<Void>)>(symbol: "Mutex_TryLock", isLeaf: true)
+  external bool _tryLock();
+
+  @Native<Void Function(Pointer<Void>)>(symbol: "Mutex_Lock")
+  external void _lock();
+
+  @Native<Void Function(Pointer<Void>)>(symbol: "Mutex_Unlock", isLeaf: true)
+  external void _unlock();
+
+  Object _runLocked(Object action) => runLocked(action as Object Function());
+
+  @pragma("vm:prefer-inline")
   R runLocked<R>(R Function() action) {
-    return _runLocked(action) as R;
+    if (!_tryLock()) {
+      _lockSlow();
+    }
+    try {
+      return action();
+    } finally {
+      _unlock();
+    }
+  }
+
+  @pragma("vm:never-inline")
+  void _lockSlow() {
+    for (int i = 0; i < _spinCount; i++) {
+      if (_tryLock()) return;
+    }
+    _lock();
   }
 }
 
@@ -56,3 +85,72 @@ base class _ConditionVariableImpl extends NativeFieldWrapperClass1
   @Native<Void Function(Handle)>(symbol: "ConditionVariable_NotifyAll")
   external void notifyAll();
 }
+
+@patch
+abstract final class Int64ListAtomics {
+  @patch
+  @pragma("vm:prefer-inline")
+  static int compareExchange(
+    Int64List list,
+    int index,
+    int expected,
+    int desired,
+  ) {
+    IndexError.check(index, list.length, indexable: list, name: "index");
+    return _compareExchange(list.address, index, expected, desired);
+  }
+
+  @patch
+  @pragma("vm:prefer-inline")
+  static int fetchAdd(Int64List list, int index, int delta) {
+    IndexError.check(index, list.length, indexable: list, name: "index");
+    return _fetchAdd(list.address, index, delta);
+  }
+
+  @patch
+  @pragma("vm:prefer-inline")
+  static int loadAcquire(Int64List list, int index) {
+    IndexError.check(index, list.length, indexable: list, name: "index");
+    return _loadAcquire(list.address, index);
+  }
+
+  @patch
+  @pragma("vm:prefer-inline")
+  static void storeRelease(Int64List list, int index, int value) {
+    IndexError.check(index, list.length, indexable: list, name: "index");
+    _storeRelease(list.address, index, value);
+  }
+
+  @Native<Int64 Function(Pointer<Int64>, IntPtr, Int64, Int64)>(
+    symbol: "Int64ListAtomics_CompareExchange",
+    isLeaf: true,
+  )
+  external static int _compareExchange(
+    Pointer<Int64> data,
+    int index,
+    int expected,
+    int desired,
+  );
+
+  @Native<Int64 Function(Pointer<Int64>, IntPtr, Int64)>(
+    symbol: "Int64ListAtomics_FetchAdd",
+    isLeaf: true,
+  )
+  external static int _fetchAdd(Pointer<Int64> data, int index, int delta);
+
+  @Native<Int64 Function(Pointer<Int64>, IntPtr)>(
+    symbol: "Int64ListAtomics_LoadAcquire",
+    isLeaf: true,
+  )
+  external static int _loadAcquire(Pointer<Int64> data, int index);
+
+  @Native<Void Function(Pointer<Int64>, IntPtr, Int64)>(
+    symbol: "Int64ListAtomics_StoreRelease",
+    isLeaf: true,
+  )
+  external static void _storeRelease(
+    Pointer<Int64> data,
+    int index,
+    int value,
+  );
+}
@@ -591,6 +591,12 @@ mixin _ChunkedJsonParser<T> on _JsonParserWithListener {
    */
   String getString(int start, int end, int bits);
 
+  /**
+   * Like [getString], for the name of a property of an object.
+   */
+  String getKeyString(int start, int end, int bits) =>
+      getString(start, end, bits);
+
   /**
    * Parse a slice of the current chunk as a number.
    *
@@ -850,8 +856,9 @@ mixin _ChunkedJsonParser<T> on _JsonParserWithListener {
       switch (char) {
         case QUOTE:
           if ((state & ALLOW_STRING_MASK) != 0) fail(position);
+          final isKey = (state & NO_VALUES) == STRING_ONLY;
           state |= VALUE_READ_BITS;
-          position = parseString(position + 1);
+          position = parseString(position + 1, isKey);
           break;
         case LBRACKET:
           if ((state & ALLOW_VALUE_MASK) != 0) fail(position);
@@ -1045,7 +1052,7 @@ mixin _ChunkedJsonParser<T> on _JsonParserWithListener {
    * Returned position right after the final quote.
    */
   @pragma('vm:unsafe:no-interrupts')
-  int parseString(int position) {
+  int parseString(int position, bool isKey) {
     final charAttributes = _characterAttributes;
 
     // Format: '"'([^\x00-\x1f\\\"]|'\\'[bfnrt/\\"])*'"'
@@ -1071,7 +1078,11 @@ mixin _ChunkedJsonParser<T> on _JsonParserWithListener {
       } while (position < end);
       if (char == QUOTE) {
         int sliceEnd = position - 1;
-        listener.handleString(getString(start, sliceEnd, bits));
+        listener.handleString(
+          isKey
+              ? getKeyString(start, sliceEnd, bits)
+              : getString(start, sliceEnd, bits),
+        );
         return sliceEnd + 1;
       }
       if (char == BACKSLASH) {
@@ -1608,6 +1619,39 @@ class _JsonUtf8Parser extends _JsonParserWithListener
   @pragma('vm:unsafe:no-bounds-checks')
   int _getCharUnsafe(int position) => chunk[position];
 
+  // Property names repeat in most documents, e.g. in a list of objects of
+  // the same shape, so short ASCII names are shared instead of allocating a
+  // string for every occurrence.
+  static const int _keyCacheSize = 64;
+  static const int _maxCachedKeyLength = 32;
+  final List<String?> _keyCache = List<String?>.filled(_keyCacheSize, null);
+
+  String getKeyString(int start, int end, int bits) {
+    const int maxAsciiChar = 0x7f;
+    final int length = end - start;
+    if (bits > maxAsciiChar || length > _maxCachedKeyLength) {
+      return getString(start, end, bits);
+    }
+    int hash = length;
+    for (int i = start; i < end; i++) {
+      hash = (hash * 31 + _getCharUnsafe(i)) & 0x3fffffff;
+    }
+    final int index = hash & (_keyCacheSize - 1);
+    final String? cached = _keyCache[index];
+    if (cached != null && cached.length == length) {
+      int i = 0;
+      while (i < length && cached.codeUnitAt(i) == _getCharUnsafe(start + i)) {
+        i++;
+      }
+      if (i == length) return cached;
+    }
+    return _keyCache[index] = createOneByteStringFromCharacters(
+      chunk,
+      start,
+      end,
+    );
+  }
+
   String getString(int start, int end, int bits) {
     const int maxAsciiChar = 0x7f;
     if (bits <= maxAsciiChar) {
@@ -3,7 +3,12 @@
 // BSD-style license that can be found in the LICENSE file.
 
 import "dart:_internal"
-    show patch, has63BitSmis, UnmodifiableListMixin, FixedLengthListMixin;
+    show
+        patch,
+        has63BitSmis,
+        unsafeCast,
+        UnmodifiableListMixin,
+        FixedLengthListMixin;
 import 'dart:async';
 import 'dart:collection';
 import 'dart:isolate';
@@ -189,6 +194,9 @@ external Pointer<NS> _createNativeCallableListener<NS extends NativeFunction>(
   RawReceivePort port,
 );
 
+@pragma("vm:external-name", "Ffi_takeNativeCallableListenerBatch")
+external List? _takeNativeCallableListenerBatch(RawReceivePort port);
+
 @pragma("vm:external-name", "Ffi_createNativeCallableIsolateLocal")
 external Pointer<NS> _createNativeCallableIsolateLocal<
   NS extends NativeFunction
@@ -310,15 +318,29 @@ final class _NativeCallableListener<T extends Function>
   final RawReceivePort _port;
 
   _NativeCallableListener(void Function(List) handler, String portDebugName)
-    : _port = RawReceivePort(
-        Zone.current.bindUnaryCallbackGuarded(handler),
-        portDebugName,
-      ),
-      super(nullptr);
+    : _port = RawReceivePort(null, portDebugName),
+      super(nullptr) {
+    final guardedHandler = Zone.current.bindUnaryCallbackGuarded(handler);
+    _port.handler = (List? args) {
+      if (args != null) {
+        guardedHandler(args);
+        return;
+      }
+      // With --batch-ffi-async-callbacks, the invocations are delivered as
+      // a batch and only the first one notifies the port.
+      final batch = _takeNativeCallableListenerBatch(_port);
+      if (batch == null) return;
+      for (int i = 0; i < batch.length; i++) {
+        guardedHandler(unsafeCast<List>(batch[i]));
+      }
+    };
+  }
 
   @override
   void _close() {
     _port.close();
+    // Drop the invocations which will no longer be delivered.
+    _takeNativeCallableListenerBatch(_port);
   }
 
   @override
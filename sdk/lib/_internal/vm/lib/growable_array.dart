@@ -160,8 +160,12 @@ class _GrowableList<T> extends ListBase<T> {
     final int length = elements.length;
     if (length > 0) {
       final data = _List(_adjustedCapacity(length));
-      for (int i = 0; i < length; i++) {
-        data[i] = elements[i];
+      if (length > _List._copyLoopLimit) {
+        _List._copyRange(elements, 0, data, 0, length);
+      } else {
+        for (int i = 0; i < length; i++) {
+          data[i] = elements[i];
+        }
       }
       final list = _GrowableList<T>._withData(data);
       list._setLength(length);
@@ -174,8 +178,12 @@ class _GrowableList<T> extends ListBase<T> {
     final int length = elements.length;
     if (length > 0) {
       final data = _List(_adjustedCapacity(length));
-      for (int i = 0; i < length; i++) {
-        data[i] = elements[i];
+      if (length > _List._copyLoopLimit) {
+        _List._copyRange(elements, 0, data, 0, length);
+      } else {
+        for (int i = 0; i < length; i++) {
+          data[i] = elements[i];
+        }
       }
       final list = _GrowableList<T>._withData(data);
       list._setLength(length);
@@ -317,6 +325,10 @@ class _GrowableList<T> extends ListBase<T> {
           throw new ConcurrentModificationError(this);
         }
         this._setLength(newLen);
+        if (iterLen > _List._copyLoopLimit) {
+          _List._copyRange(iterable, 0, this, len, iterLen);
+          return;
+        }
         final ListBase<T> iterableAsList = iterable as ListBase<T>;
         for (int i = 0; i < iterLen; i++) {
           this[len++] = iterableAsList[i];
@@ -389,7 +401,9 @@ class _GrowableList<T> extends ListBase<T> {
     // into CheckArrayBound(length - 1, ...). Which deoptimizes
     // if length == 0. However the loop itself does not execute
     // if length == 0.
-    if (length > 0) {
+    if (length > _List._copyLoopLimit) {
+      _List._copyRange(this, 0, newData, 0, length);
+    } else if (length > 0) {
       for (int i = 0; i < length; i++) {
         newData[i] = this[i];
       }
@@ -408,7 +422,9 @@ class _GrowableList<T> extends ListBase<T> {
   void _shrink(int new_capacity, int new_length) {
     var newData = _allocateData(new_capacity);
     // This is a workaround for dartbug.com/30090. See the comment in _grow.
-    if (new_length > 0) {
+    if (new_length > _List._copyLoopLimit) {
+      _List._copyRange(this, 0, newData, 0, new_length);
+    } else if (new_length > 0) {
       for (int i = 0; i < new_length; i++) {
         newData[i] = this[i];
       }
@@ -512,7 +528,7 @@ class _GrowableList<T> extends ListBase<T> {
 
   @pragma("vm:prefer-inline")
   Iterator<T> get iterator {
-    return new ListIterator<T>(this);
+    return new _GrowableListIterator<T>(this);
   }
 
   List<T> toList({bool growable = true}) {
@@ -528,8 +544,12 @@ class _GrowableList<T> extends ListBase<T> {
     if (growable) {
       if (length > 0) {
         final data = new _List(_adjustedCapacity(length));
-        for (int i = 0; i < length; i++) {
-          data[i] = this[i];
+        if (length > _List._copyLoopLimit) {
+          _List._copyRange(this, 0, data, 0, length);
+        } else {
+          for (int i = 0; i < length; i++) {
+            data[i] = this[i];
+          }
         }
         final result = new _GrowableList<T>._withData(data);
         result._setLength(length);
@@ -539,8 +559,12 @@ class _GrowableList<T> extends ListBase<T> {
     } else {
       if (length > 0) {
         final list = new _List<T>(length);
-        for (int i = 0; i < length; i++) {
-          list[i] = this[i];
+        if (length > _List._copyLoopLimit) {
+          _List._copyRange(this, 0, list, 0, length);
+        } else {
+          for (int i = 0; i < length; i++) {
+            list[i] = this[i];
+          }
         }
         return list;
       }
@@ -672,3 +696,37 @@ class _GrowableList<T> extends ListBase<T> {
     return result;
   }
 }
+
+// Iterator for growable lists. Unlike [ListIterator] it knows the exact class
+// of the list, so once inlined into a for-in loop the length and element
+// accesses are direct loads and the iterator itself can be eliminated.
+final class _GrowableListIterator<E> implements Iterator<E> {
+  final _GrowableList<E> _list;
+  final int _length; // Length at creation, to detect concurrent modification.
+  int _index;
+  E? _current;
+
+  @pragma("vm:prefer-inline")
+  _GrowableListIterator(_GrowableList<E> list)
+    : _list = list,
+      _length = list.length,
+      _index = 0;
+
+  @pragma("vm:prefer-inline")
+  E get current => _current as E;
+
+  @pragma("vm:prefer-inline")
+  bool moveNext() {
+    final length = _list.length;
+    if (_length != length) {
+      throw ConcurrentModificationError(_list);
+    }
+    if (_index >= length) {
+      _current = null;
+      return false;
+    }
+    _current = _list[_index];
+    _index++;
+    return true;
+  }
+}
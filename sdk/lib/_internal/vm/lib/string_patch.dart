@@ -930,6 +930,56 @@ abstract final class _StringBase implements String {
     return _OneByteString._concatAll(values, totalLength);
   }
 
+  /**
+   * Converts two objects to strings and concatenates them, without the
+   * temporary list used by [_interpolate].
+   */
+  @pragma("vm:entry-point", "call")
+  @pragma("vm:never-inline")
+  static String _interpolate2(Object? a, Object? b) {
+    final sa = _interpolateSingle(a);
+    final sb = _interpolateSingle(b);
+    if (ClassID.getID(sa) == ClassID.cidOneByteString &&
+        ClassID.getID(sb) == ClassID.cidOneByteString) {
+      final totalLength = sa.length + sb.length;
+      if (totalLength <= _OneByteString._maxShortConcatLength) {
+        return _OneByteString._concatShort(
+          unsafeCast<_OneByteString>(sa),
+          unsafeCast<_OneByteString>(sb),
+          unsafeCast<_OneByteString>(""),
+          totalLength,
+        );
+      }
+    }
+    return sa + sb;
+  }
+
+  /**
+   * Converts three objects to strings and concatenates them, without the
+   * temporary list used by [_interpolate] for short one-byte results.
+   */
+  @pragma("vm:entry-point", "call")
+  @pragma("vm:never-inline")
+  static String _interpolate3(Object? a, Object? b, Object? c) {
+    final sa = _interpolateSingle(a);
+    final sb = _interpolateSingle(b);
+    final sc = _interpolateSingle(c);
+    if (ClassID.getID(sa) == ClassID.cidOneByteString &&
+        ClassID.getID(sb) == ClassID.cidOneByteString &&
+        ClassID.getID(sc) == ClassID.cidOneByteString) {
+      final totalLength = sa.length + sb.length + sc.length;
+      if (totalLength <= _OneByteString._maxShortConcatLength) {
+        return _OneByteString._concatShort(
+          unsafeCast<_OneByteString>(sa),
+          unsafeCast<_OneByteString>(sb),
+          unsafeCast<_OneByteString>(sc),
+          totalLength,
+        );
+      }
+    }
+    return _concatRangeNative(<String>[sa, sb, sc], 0, 3);
+  }
+
   static ArgumentError _interpolationError(Object? o, Object? result) {
     // Since Dart 2.0, [result] can only be null.
     return new ArgumentError.value(
@@ -1073,6 +1123,12 @@ final class _OneByteString extends _StringBase {
   @pragma("vm:external-name", "OneByteString_substringUnchecked")
   external String _substringUncheckedNative(int startIndex, int endIndex);
 
+  // Searching natively pays off once the native call is amortized.
+  static const int _nativeIndexOfThreshold = 64;
+
+  @pragma("vm:external-name", "OneByteString_indexOf")
+  external int _indexOfNative(_OneByteString pattern, int start);
+
   List<String> _splitWithCharCode(int charCode) {
     final parts = <String>[];
     int i = 0;
@@ -1100,9 +1156,12 @@ final class _OneByteString extends _StringBase {
     return super.split(pattern);
   }
 
+  // Above this length concatenating in native code is quicker.
+  static const int _maxShortConcatLength = 128;
+
   // All element of 'strings' must be OneByteStrings.
   static _concatAll(List strings, int totalLength) {
-    if (totalLength > 128) {
+    if (totalLength > _maxShortConcatLength) {
       // Native is quicker.
       return _StringBase._concatRangeNative(strings, 0, strings.length);
     }
@@ -1119,9 +1178,39 @@ final class _OneByteString extends _StringBase {
     return res;
   }
 
+  // Concatenates three one-byte strings of [totalLength] code units in total
+  // into a result allocated up front.
+  static _OneByteString _concatShort(
+    _OneByteString a,
+    _OneByteString b,
+    _OneByteString c,
+    int totalLength,
+  ) {
+    final res = _OneByteString._allocate(totalLength);
+    int rIx = 0;
+    for (int s = 0; s < a.length; s++) {
+      res._setAt(rIx++, a.codeUnitAt(s));
+    }
+    for (int s = 0; s < b.length; s++) {
+      res._setAt(rIx++, b.codeUnitAt(s));
+    }
+    for (int s = 0; s < c.length; s++) {
+      res._setAt(rIx++, c.codeUnitAt(s));
+    }
+    return res;
+  }
+
   int indexOf(Pattern pattern, [int start = 0]) {
-    // Specialize for single character pattern.
     final pCid = ClassID.getID(pattern);
+    if ((pCid == ClassID.cidOneByteString) &&
+        (start >= 0) &&
+        (this.length - start >= _nativeIndexOfThreshold)) {
+      final patternAsString = unsafeCast<_OneByteString>(pattern);
+      if (patternAsString.length > 0) {
+        return _indexOfNative(patternAsString, start);
+      }
+    }
+    // Specialize for single character pattern.
     if ((pCid == ClassID.cidOneByteString) ||
         (pCid == ClassID.cidTwoByteString)) {
       final String patternAsString = unsafeCast<String>(pattern);
@@ -1144,6 +1233,14 @@ final class _OneByteString extends _StringBase {
 
   bool contains(Pattern pattern, [int start = 0]) {
     final pCid = ClassID.getID(pattern);
+    if ((pCid == ClassID.cidOneByteString) &&
+        (start >= 0) &&
+        (this.length - start >= _nativeIndexOfThreshold)) {
+      final patternAsString = unsafeCast<_OneByteString>(pattern);
+      if (patternAsString.length > 0) {
+        return _indexOfNative(patternAsString, start) >= 0;
+      }
+    }
     if ((pCid == ClassID.cidOneByteString) ||
         (pCid == ClassID.cidTwoByteString)) {
       final String patternAsString = unsafeCast<String>(pattern);
@@ -8,6 +8,11 @@ part of "isolate_patch.dart";
 // This allows for O(1) `first`, O(log(n)) `remove`/`removeFirst` and O(log(n))
 // `add`.
 //
+// Canceled timers other than the first one are left in the heap and dropped
+// once they become first, or when they make up half of the heap. This makes
+// `cancel` O(1) amortized, which matters when most timers are timeouts that
+// get canceled. The first timer is never canceled.
+//
 // To ensure the timers are ordered by insertion time, the _Timer class has a
 // `_id` field set when added to the heap.
 //
@@ -15,6 +20,7 @@ part of "isolate_patch.dart";
 class _TimerHeap {
   List<_Timer> _list;
   int _used = 0;
+  int _canceled = 0; // Canceled timers still in the heap.
 
   _TimerHeap([int initSize = 7])
     : _list = List<_Timer>.filled(initSize, _Timer._sentinelTimer);
@@ -33,14 +39,62 @@ class _TimerHeap {
     timer._indexOrNext = index;
     _list[index] = timer;
     _bubbleUp(timer);
+    if (!timer.isActive) {
+      _canceled++;
+      _removeCanceledFirst();
+    }
   }
 
   _Timer removeFirst() {
     var f = first;
     remove(f);
+    _removeCanceledFirst();
     return f;
   }
 
+  // Called after [timer] was canceled. Returns whether it was the first timer.
+  bool cancel(_Timer timer) {
+    if (isFirst(timer)) {
+      removeFirst();
+      return true;
+    }
+    _canceled++;
+    if (_canceled > _used ~/ 2) {
+      _removeCanceled();
+    }
+    return false;
+  }
+
+  void _removeCanceledFirst() {
+    while (!isEmpty && !first.isActive) {
+      _canceled--;
+      remove(first);
+    }
+  }
+
+  // Rebuilds the heap from the timers which are not canceled. Does not change
+  // the first timer, as it is never canceled.
+  void _removeCanceled() {
+    var live = 0;
+    for (var i = 0; i < _used; i++) {
+      var timer = _list[i];
+      if (timer.isActive) {
+        timer._indexOrNext = live;
+        _list[live++] = timer;
+      } else {
+        timer._indexOrNext = null;
+      }
+    }
+    for (var i = live; i < _used; i++) {
+      _list[i] = _Timer._sentinelTimer;
+    }
+    _used = live;
+    _canceled = 0;
+    for (var i = _parentIndex(live - 1); i >= 0; i--) {
+      _bubbleDown(_list[i]);
+    }
+  }
+
   void remove(_Timer timer) {
     _used--;
     if (isEmpty) {
@@ -234,13 +288,16 @@ class _Timer implements Timer {
   // non-zero timer. Zero timers are kept in the list as they need to consume
   // the corresponding pending message.
   void cancel() {
+    if (_callback == null) return;
     _callback = null;
     // Only heap timers are really removed. Zero timers need to consume their
     // corresponding wakeup message so they are left in the queue.
     if (!_isInHeap) return;
-    bool update = _heap.isFirst(this);
-    _heap.remove(this);
-    if (update) {
+    // When other timers are left, the wakeup scheduled for this timer is kept
+    // instead of asking the event handler for a later one. If it comes too
+    // early, the next wakeup is scheduled then. This saves messages to the
+    // event handler for timeouts which are canceled in order.
+    if (_heap.cancel(this) && _heap.isEmpty) {
       _notifyEventHandler();
     }
   }
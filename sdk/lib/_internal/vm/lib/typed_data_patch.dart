@@ -438,6 +438,10 @@ base mixin _IntListMixin on _TypedListBase implements TypedDataList<int> {
     } else if (start < 0) {
       start = 0;
     }
+    if (elementSizeInBytes == 1 &&
+        this.length - start >= _nativeByteRangeThreshold) {
+      return _indexOfByte(element, start);
+    }
     for (int i = start; i < this.length; i++) {
       if (this[i] == element) return i;
     }
@@ -496,11 +500,31 @@ base mixin _IntListMixin on _TypedListBase implements TypedDataList<int> {
     if (fillValue == null) {
       throw ArgumentError.notNull("fillValue");
     }
+    if (elementSizeInBytes == 1 &&
+        end - start >= _nativeByteRangeThreshold &&
+        _fillBytes(start, end - start, fillValue)) {
+      return;
+    }
     for (var i = start; i < end; ++i) {
       this[i] = fillValue;
     }
   }
 
+  // Stores [value], truncated or clamped like the element setter, into the
+  // [count] elements starting at [start].
+  //
+  // The element size of [this] must be 1 (test at caller). Returns false
+  // without storing anything if [this] is unmodifiable.
+  @pragma("vm:external-name", "TypedDataBase_fillBytes")
+  external bool _fillBytes(int start, int count, int value);
+
+  // Returns the index of the first element equal to [element] at or after
+  // [start], or -1.
+  //
+  // The element size of [this] must be 1 (test at caller).
+  @pragma("vm:external-name", "TypedDataBase_indexOfByte")
+  external int _indexOfByte(int element, int start);
+
   @pragma("vm:prefer-inline")
   void setRange(int start, int end, Iterable<int> from, [int skipCount = 0]) =>
       _setRange(start, end, from, skipCount);
@@ -4252,6 +4276,7 @@ final class _TypedListIterator<E> implements Iterator<E> {
   int _position;
   E? _current;
 
+  @pragma("vm:prefer-inline")
   _TypedListIterator(List<E> array)
     : _array = array,
       _length = array.length,
@@ -4259,6 +4284,7 @@ final class _TypedListIterator<E> implements Iterator<E> {
     assert(array is _TypedList || array is _TypedListView);
   }
 
+  @pragma("vm:prefer-inline")
   bool moveNext() {
     int nextPosition = _position + 1;
     if (nextPosition < _length) {
@@ -4271,6 +4297,7 @@ final class _TypedListIterator<E> implements Iterator<E> {
     return false;
   }
 
+  @pragma("vm:prefer-inline")
   E get current => _current as E;
 }
 
@@ -5448,6 +5475,10 @@ void _rangeCheck(int listLength, int start, int length) {
   }
 }
 
+// The number of elements from which byte lists are filled and searched by
+// natives using memset and memchr, rather than element by element.
+const int _nativeByteRangeThreshold = 64;
+
 void _offsetAlignmentCheck(int offset, int alignment) {
   if ((offset % alignment) != 0) {
     throw new RangeError(
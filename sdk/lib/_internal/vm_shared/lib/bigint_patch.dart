@@ -1270,6 +1270,25 @@ class _BigIntImpl implements BigInt {
   /// Multiplication operator.
   _BigIntImpl operator *(BigInt bigInt) {
     final other = _ensureSystemBigInt(bigInt, 'bigInt');
+    if (_used == 0 || other._used == 0) {
+      return zero;
+    }
+    final isNegative = _isNegative != other._isNegative;
+    if (_used >= _karatsubaThreshold && other._used >= _karatsubaThreshold) {
+      final result = _karatsubaMul(abs(), other.abs());
+      return isNegative ? -result : result;
+    }
+    return _absMulSetSign(other, isNegative);
+  }
+
+  /// Factors with at least this many digits are multiplied with the
+  /// Karatsuba algorithm, which needs less than quadratic time but allocates
+  /// intermediate results.
+  static const int _karatsubaThreshold = 64;
+
+  /// Returns `abs(this) * abs(other)` with sign set according to [isNegative],
+  /// computed with the schoolbook method.
+  _BigIntImpl _absMulSetSign(_BigIntImpl other, bool isNegative) {
     var used = _used;
     var otherUsed = other._used;
     if (used == 0 || otherUsed == 0) {
@@ -1283,11 +1302,51 @@ class _BigIntImpl implements BigInt {
     while (i < otherUsed) {
       i += _mulAdd(otherDigits, i, digits, 0, resultDigits, i, used);
     }
-    return new _BigIntImpl._(
-      _isNegative != other._isNegative,
-      resultUsed,
-      resultDigits,
-    );
+    return new _BigIntImpl._(isNegative, resultUsed, resultDigits);
+  }
+
+  /// Returns the non-negative value of the [n] least significant digits of
+  /// `abs(this)`.
+  _BigIntImpl _absLowDigits(int n) {
+    final used = n < _used ? n : _used;
+    final digits = _cloneDigits(_digits, 0, used, used);
+    return new _BigIntImpl._(false, used, digits);
+  }
+
+  /// Returns `x * y` for non-negative [x] and [y].
+  ///
+  /// With `x = x1*B^m + x0` and `y = y1*B^m + y0`, where `B` is the digit
+  /// base, computes `x*y = z2*B^2m + z1*B^m + z0` with three recursive
+  /// multiplications: `z0 = x0*y0`, `z2 = x1*y1` and
+  /// `z1 = (x0 + x1)*(y0 + y1) - z0 - z2`.
+  static _BigIntImpl _karatsubaMul(_BigIntImpl x, _BigIntImpl y) {
+    assert(!x._isNegative && !y._isNegative);
+    final xUsed = x._used;
+    final yUsed = y._used;
+    // Split at an even number of digits, so that the halves keep the digit
+    // pairs of the intrinsics aligned.
+    final m = ((_max(xUsed, yUsed) + 2) >> 2) << 1;
+    if (xUsed < _karatsubaThreshold ||
+        yUsed < _karatsubaThreshold ||
+        xUsed <= m ||
+        yUsed <= m) {
+      // Small or unbalanced factors.
+      return x._absMulSetSign(y, false);
+    }
+    final x0 = x._absLowDigits(m);
+    final x1 = x._drShift(m);
+    final y0 = y._absLowDigits(m);
+    final y1 = y._drShift(m);
+    final z0 = _karatsubaMul(x0, y0);
+    final z2 = _karatsubaMul(x1, y1);
+    final z1 = _karatsubaMul(
+      x0._absAddSetSign(x1, false),
+      y0._absAddSetSign(y1, false),
+    )._absSubSetSign(z0, false)._absSubSetSign(z2, false);
+    return z2
+        ._dlShift(2 * m)
+        ._absAddSetSign(z1._dlShift(m), false)
+        ._absAddSetSign(z0, false);
   }
 
   // resultDigits[0..resultUsed-1] =
@@ -326,9 +326,18 @@ abstract class _EqualsAndHashCode {
   bool _equals(Object? e1, Object? e2);
 }
 
+// Like `e1 == e2`, but compares the most common keys without a dynamic call
+// of `==`: integers are compared inline and identical strings are equal.
+@pragma("vm:prefer-inline")
+bool _operatorEquals(Object? e1, Object? e2) {
+  if (e1 is int && e2 is int) return e1 == e2;
+  if (identical(e1, e2) && e1 is String) return true;
+  return e1 == e2;
+}
+
 mixin _OperatorEqualsAndHashCode implements _EqualsAndHashCode {
   int _hashCode(Object? e) => e.hashCode;
-  bool _equals(Object? e1, Object? e2) => e1 == e2;
+  bool _equals(Object? e1, Object? e2) => _operatorEquals(e1, e2);
 }
 
 mixin _IdenticalAndIdentityHashCode implements _EqualsAndHashCode {
@@ -347,7 +356,7 @@ mixin _OperatorEqualsAndCanonicalHashCode implements _EqualsAndHashCode {
     return identityHashCode(e);
   }
 
-  bool _equals(Object? e1, Object? e2) => e1 == e2;
+  bool _equals(Object? e1, Object? e2) => _operatorEquals(e1, e2);
 }
 
 mixin _CustomEqualsAndHashCode<K> implements _EqualsAndHashCode {
@@ -819,6 +828,7 @@ class _CompactKeysIterable<E> extends Iterable<E>
 
   _CompactKeysIterable(this._table);
 
+  @pragma("vm:prefer-inline")
   Iterator<E> get iterator =>
       _CompactIterator<E>(_table, _table._data, _table._usedData, -2, 2);
 
@@ -835,6 +845,7 @@ class _CompactValuesIterable<E> extends Iterable<E>
 
   _CompactValuesIterable(this._table);
 
+  @pragma("vm:prefer-inline")
   Iterator<E> get iterator =>
       _CompactIterator<E>(_table, _table._data, _table._usedData, -1, 2);
 
@@ -855,9 +866,11 @@ class _CompactIterator<E> implements Iterator<E> {
   final int _checkSum;
   E? _current;
 
+  @pragma("vm:prefer-inline")
   _CompactIterator(this._table, this._data, this._len, this._offset, this._step)
     : _checkSum = _table._checkSum;
 
+  @pragma("vm:prefer-inline")
   bool moveNext() {
     if (_table._isModifiedSince(_data, _checkSum)) {
       throw ConcurrentModificationError(_table);
@@ -874,6 +887,7 @@ class _CompactIterator<E> implements Iterator<E> {
     }
   }
 
+  @pragma("vm:prefer-inline")
   E get current => _current as E;
 }
 
@@ -1147,6 +1161,7 @@ mixin _LinkedHashSetMixin<E> on _HashBase, _EqualsAndHashCode {
     return false;
   }
 
+  @pragma("vm:prefer-inline")
   Iterator<E> get iterator =>
       _CompactIterator<E>(this, _data, _usedData, -1, 1);
 
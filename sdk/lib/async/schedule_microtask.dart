@@ -6,24 +6,24 @@ part of dart.async;
 
 typedef void _AsyncCallback();
 
-class _AsyncCallbackEntry {
-  final _AsyncCallback callback;
-  _AsyncCallbackEntry? next;
-  _AsyncCallbackEntry(this.callback);
-}
+/// Pending callbacks, in a circular buffer whose length is a power of two.
+///
+/// Unlike a linked list, the buffer does not allocate for each scheduled
+/// callback.
+List<_AsyncCallback?> _callbacks = List<_AsyncCallback?>.filled(8, null);
 
-/// Head of single linked list of pending callbacks.
-_AsyncCallbackEntry? _nextCallback;
+/// Index of the next callback to run in [_callbacks].
+int _callbacksHead = 0;
 
-/// Tail of single linked list of pending callbacks.
-_AsyncCallbackEntry? _lastCallback;
+/// Number of pending callbacks.
+int _callbacksLength = 0;
 
-/// Tail of priority callbacks added by the currently executing callback.
+/// Number of priority callbacks added by the currently executing callback.
 ///
 /// Priority callbacks are put at the beginning of the
 /// callback queue, so that if one callback schedules more than one
 /// priority callback, they are still enqueued in scheduling order.
-_AsyncCallbackEntry? _lastPriorityCallback;
+int _priorityCallbacks = 0;
 
 /// Whether we are currently inside the callback loop.
 ///
@@ -32,12 +32,15 @@ _AsyncCallbackEntry? _lastPriorityCallback;
 bool _isInCallbackLoop = false;
 
 void _microtaskLoop() {
-  for (var entry = _nextCallback; entry != null; entry = _nextCallback) {
-    _lastPriorityCallback = null;
-    var next = entry.next;
-    _nextCallback = next;
-    if (next == null) _lastCallback = null;
-    (entry.callback)();
+  while (_callbacksLength > 0) {
+    _priorityCallbacks = 0;
+    final callbacks = _callbacks;
+    final head = _callbacksHead;
+    final callback = callbacks[head]!;
+    callbacks[head] = null;
+    _callbacksHead = (head + 1) & (callbacks.length - 1);
+    _callbacksLength--;
+    callback();
   }
 }
 
@@ -48,29 +51,37 @@ void _startMicrotaskLoop() {
     // good optimization.
     _microtaskLoop();
   } finally {
-    _lastPriorityCallback = null;
+    _priorityCallbacks = 0;
     _isInCallbackLoop = false;
-    if (_nextCallback != null) {
+    if (_callbacksLength > 0) {
       _AsyncRun._scheduleImmediate(_startMicrotaskLoop);
     }
   }
 }
 
+/// Doubles the capacity of [_callbacks], moving the head to index 0.
+void _growCallbacks() {
+  final callbacks = _callbacks;
+  final mask = callbacks.length - 1;
+  final newCallbacks = List<_AsyncCallback?>.filled(callbacks.length * 2, null);
+  for (var i = 0; i < _callbacksLength; i++) {
+    newCallbacks[i] = callbacks[(_callbacksHead + i) & mask];
+  }
+  _callbacks = newCallbacks;
+  _callbacksHead = 0;
+}
+
 /// Schedules a callback to be called as a microtask.
 ///
 /// The microtask is called after all other currently scheduled
 /// microtasks, but as part of the current system event.
 void _scheduleAsyncCallback(_AsyncCallback callback) {
-  _AsyncCallbackEntry newEntry = new _AsyncCallbackEntry(callback);
-  _AsyncCallbackEntry? lastCallback = _lastCallback;
-  if (lastCallback == null) {
-    _nextCallback = _lastCallback = newEntry;
-    if (!_isInCallbackLoop) {
-      _AsyncRun._scheduleImmediate(_startMicrotaskLoop);
-    }
-  } else {
-    lastCallback.next = newEntry;
-    _lastCallback = newEntry;
+  if (_callbacksLength == _callbacks.length) _growCallbacks();
+  final callbacks = _callbacks;
+  final tail = (_callbacksHead + _callbacksLength) & (callbacks.length - 1);
+  callbacks[tail] = callback;
+  if (_callbacksLength++ == 0 && !_isInCallbackLoop) {
+    _AsyncRun._scheduleImmediate(_startMicrotaskLoop);
   }
 }
 
@@ -81,25 +92,24 @@ void _scheduleAsyncCallback(_AsyncCallback callback) {
 ///
 /// Is always run in the root zone.
 void _schedulePriorityAsyncCallback(_AsyncCallback callback) {
-  if (_nextCallback == null) {
+  if (_callbacksLength == 0) {
     _scheduleAsyncCallback(callback);
-    _lastPriorityCallback = _lastCallback;
+    _priorityCallbacks = 1;
     return;
   }
-  _AsyncCallbackEntry entry = new _AsyncCallbackEntry(callback);
-  _AsyncCallbackEntry? lastPriorityCallback = _lastPriorityCallback;
-  if (lastPriorityCallback == null) {
-    entry.next = _nextCallback;
-    _nextCallback = _lastPriorityCallback = entry;
-  } else {
-    var next = lastPriorityCallback.next;
-    entry.next = next;
-    lastPriorityCallback.next = entry;
-    _lastPriorityCallback = entry;
-    if (next == null) {
-      _lastCallback = entry;
-    }
+  if (_callbacksLength == _callbacks.length) _growCallbacks();
+  // Moves the earlier priority callbacks one slot towards the front, to make
+  // room for this one after them.
+  final callbacks = _callbacks;
+  final mask = callbacks.length - 1;
+  final head = (_callbacksHead - 1) & mask;
+  for (var i = 0; i < _priorityCallbacks; i++) {
+    callbacks[(head + i) & mask] = callbacks[(head + i + 1) & mask];
   }
+  callbacks[(head + _priorityCallbacks) & mask] = callback;
+  _callbacksHead = head;
+  _callbacksLength++;
+  _priorityCallbacks++;
 }
 
 /// Runs a function asynchronously.
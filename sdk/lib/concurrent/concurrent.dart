@@ -8,6 +8,8 @@
 /// {@nodoc}
 library dart.concurrent;
 
+import "dart:typed_data" show Int64List;
+
 /// A *mutex* synchronization primitive.
 ///
 /// Mutex can be used to synchronize access to a native resource shared between
@@ -54,3 +56,33 @@ abstract interface class ConditionVariable {
   /// Wake up all threads waiting on this condition variable.
   external void notifyAll();
 }
+
+/// Atomic operations on the elements of an [Int64List].
+///
+/// These operations can be used to build lock-free counters and queues on
+/// lists shared between isolates of a group. The operations are sequentially
+/// consistent unless documented otherwise.
+abstract final class Int64ListAtomics {
+  /// Stores [desired] at [index] of [list] if the element is [expected].
+  ///
+  /// Returns the previous value of the element, which is [expected] if and
+  /// only if [desired] was stored.
+  external static int compareExchange(
+    Int64List list,
+    int index,
+    int expected,
+    int desired,
+  );
+
+  /// Adds [delta] to the element at [index] of [list].
+  ///
+  /// Returns the previous value of the element.
+  external static int fetchAdd(Int64List list, int index, int delta);
+
+  /// Reads the element at [index] of [list] with acquire semantics.
+  external static int loadAcquire(Int64List list, int index);
+
+  /// Writes [value] to the element at [index] of [list] with release
+  /// semantics.
+  external static void storeRelease(Int64List list, int index, int value);
+}
@@ -51,6 +51,28 @@ class FileLock {
   const FileLock._internal(this._type);
 }
 
+/// Expected access to the bytes of a file mapped by [RandomAccessFile.mapSync].
+///
+/// The operating system may use it to read ahead, prefetch or evict the
+/// underlying pages.
+class FileMapAdvice {
+  /// No particular access pattern.
+  static const normal = const FileMapAdvice._internal(0);
+
+  /// The bytes are accessed in increasing order.
+  static const sequential = const FileMapAdvice._internal(1);
+
+  /// The bytes are accessed in no predictable order.
+  static const random = const FileMapAdvice._internal(2);
+
+  /// The bytes will all be accessed soon, and should be read in advance.
+  static const willNeed = const FileMapAdvice._internal(3);
+
+  final int _advice;
+
+  const FileMapAdvice._internal(this._advice);
+}
+
 /// A reference to a file on the file system.
 ///
 /// A `File` holds a [path] on which operations can be performed.
@@ -802,6 +824,38 @@ abstract interface class RandomAccessFile {
   /// Throws a [FileSystemException] if the operation fails.
   int readIntoSync(List<int> buffer, [int start = 0, int? end]);
 
+  /// Reads bytes at [position] in the file into an existing [buffer].
+  ///
+  /// Like [readInto], but reads from [position] instead of the current
+  /// position of the file, which is not used or changed on all platforms but
+  /// Windows.
+  ///
+  /// Any number of [readIntoAt] and [writeFromAt] operations can be pending at
+  /// the same time, and may be served concurrently. Other operations are not
+  /// possible until they complete.
+  ///
+  /// Returns the number of bytes read. This may be less than `end - start`
+  /// if the file doesn't have that many bytes after [position].
+  Future<int> readIntoAt(
+    int position,
+    List<int> buffer, [
+    int start = 0,
+    int? end,
+  ]);
+
+  /// Synchronously reads bytes at [position] in the file into an existing
+  /// [buffer].
+  ///
+  /// Like [readIntoSync], but reads from [position] instead of the current
+  /// position of the file, which is not used or changed on all platforms but
+  /// Windows.
+  ///
+  /// Returns the number of bytes read. This may be less than `end - start`
+  /// if the file doesn't have that many bytes after [position].
+  ///
+  /// Throws a [FileSystemException] if the operation fails.
+  int readIntoAtSync(int position, List<int> buffer, [int start = 0, int? end]);
+
   /// Writes a single byte to the file.
   ///
   /// Returns a `Future<RandomAccessFile>` that completes with this
@@ -842,6 +896,39 @@ abstract interface class RandomAccessFile {
   /// Throws a [FileSystemException] if the operation fails.
   void writeFromSync(List<int> buffer, [int start = 0, int? end]);
 
+  /// Writes from a [buffer] at [position] in the file.
+  ///
+  /// Like [writeFrom], but writes at [position] instead of the current
+  /// position of the file, which is not used or changed on all platforms but
+  /// Windows. The file is extended if [position] is past its end.
+  ///
+  /// Any number of [readIntoAt] and [writeFromAt] operations can be pending at
+  /// the same time, and may be served concurrently. Other operations are not
+  /// possible until they complete.
+  ///
+  /// Returns a `Future<RandomAccessFile>` that completes with this
+  /// [RandomAccessFile] when the write completes.
+  Future<RandomAccessFile> writeFromAt(
+    int position,
+    List<int> buffer, [
+    int start = 0,
+    int? end,
+  ]);
+
+  /// Synchronously writes from a [buffer] at [position] in the file.
+  ///
+  /// Like [writeFromSync], but writes at [position] instead of the current
+  /// position of the file, which is not used or changed on all platforms but
+  /// Windows. The file is extended if [position] is past its end.
+  ///
+  /// Throws a [FileSystemException] if the operation fails.
+  void writeFromAtSync(
+    int position,
+    List<int> buffer, [
+    int start = 0,
+    int? end,
+  ]);
+
   /// Writes a string to the file using the given [Encoding].
   ///
   /// Returns a `Future<RandomAccessFile>` that completes with this
@@ -1030,6 +1117,28 @@ abstract interface class RandomAccessFile {
   /// See [lockSync] for more details.
   void unlockSync([int start = 0, int end = -1]);
 
+  /// Synchronously maps the bytes from [start] to [end] of the file into
+  /// memory.
+  ///
+  /// Returns an unmodifiable list of the bytes, which the operating system
+  /// reads from the file when they are first accessed, instead of copying
+  /// them into the Dart heap up front. If [end] is omitted, the file is mapped
+  /// up to its current length. The [advice] describes how the bytes will be
+  /// accessed.
+  ///
+  /// The mapping is removed when the returned list is garbage collected,
+  /// which may be after this file is closed. Changes to the file may or may
+  /// not be visible in the list, and shortening the file below [end] while
+  /// the list is in use may crash the program. On Windows the bytes are
+  /// copied into memory when mapping them.
+  ///
+  /// Throws a [FileSystemException] if the operation fails.
+  Uint8List mapSync([
+    int start = 0,
+    int? end,
+    FileMapAdvice advice = FileMapAdvice.normal,
+  ]);
+
   /// Returns a human-readable string for this random access file.
   String toString();
 
@@ -799,14 +799,17 @@ abstract class _RandomAccessFileOps {
   readByte();
   read(int bytes);
   readInto(List<int> buffer, int start, int? end);
+  readIntoAt(int position, List<int> buffer, int start, int? end);
   writeByte(int value);
   writeFrom(List<int> buffer, int start, int? end);
+  writeFromAt(int position, List<int> buffer, int start, int? end);
   position();
   setPosition(int position);
   truncate(int length);
   length();
   flush();
   lock(int lock, int start, int end);
+  map(int start, int end, int advice);
 }
 
 @pragma("vm:entry-point")
@@ -816,6 +819,7 @@ class _RandomAccessFile implements RandomAccessFile {
   final String path;
 
   bool _asyncDispatched = false;
+  int _pendingPositional = 0;
 
   late _FileResourceInfo _resourceInfo;
   _RandomAccessFileOps _ops;
@@ -950,6 +954,53 @@ class _RandomAccessFile implements RandomAccessFile {
     return result;
   }
 
+  Future<int> readIntoAt(
+    int position,
+    List<int> buffer, [
+    int start = 0,
+    int? end,
+  ]) {
+    RangeError.checkNotNegative(position, "position");
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (end == start) {
+      return new Future.value(0);
+    }
+    int length = end - start;
+    return _dispatchPositional(_IOService.fileReadIntoAt, [
+      null,
+      position,
+      length,
+    ]).then((response) {
+      _checkForErrorResponse(response, "readIntoAt failed", path);
+      var responseList = response as List<Object?>;
+      var read = responseList[1] as int;
+      var data = responseList[2] as List<int>;
+      buffer.setRange(start, start + read, data);
+      _resourceInfo.addRead(read);
+      return read;
+    });
+  }
+
+  int readIntoAtSync(
+    int position,
+    List<int> buffer, [
+    int start = 0,
+    int? end,
+  ]) {
+    _checkAvailable();
+    RangeError.checkNotNegative(position, "position");
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (end == start) {
+      return 0;
+    }
+    var result = _ops.readIntoAt(position, buffer, start, end);
+    if (result is OSError) {
+      throw new FileSystemException("readIntoAt failed", path, result);
+    }
+    _resourceInfo.addRead(result);
+    return result;
+  }
+
   Future<RandomAccessFile> writeByte(int value) {
     // TODO(40614): Remove once non-nullability is sound.
     ArgumentError.checkNotNull(value, "value");
@@ -1028,6 +1079,67 @@ class _RandomAccessFile implements RandomAccessFile {
     _resourceInfo.addWrite(end - (start - bufferAndStart.start));
   }
 
+  Future<RandomAccessFile> writeFromAt(
+    int position,
+    List<int> buffer, [
+    int start = 0,
+    int? end,
+  ]) {
+    RangeError.checkNotNegative(position, "position");
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (end == start) {
+      return new Future.value(this);
+    }
+    _BufferAndStart result;
+    try {
+      result = _ensureFastAndSerializableByteData(buffer, start, end);
+    } catch (e) {
+      return new Future.error(e);
+    }
+
+    List request = new List<dynamic>.filled(5, null);
+    request[1] = position;
+    request[2] = result.buffer;
+    request[3] = result.start;
+    request[4] = end - (start - result.start);
+    return _dispatchPositional(_IOService.fileWriteFromAt, request).then((
+      response,
+    ) {
+      _checkForErrorResponse(response, "writeFromAt failed", path);
+      _resourceInfo.addWrite(end! - start);
+      return this;
+    });
+  }
+
+  void writeFromAtSync(
+    int position,
+    List<int> buffer, [
+    int start = 0,
+    int? end,
+  ]) {
+    _checkAvailable();
+    RangeError.checkNotNegative(position, "position");
+    end = RangeError.checkValidRange(start, end, buffer.length);
+    if (end == start) {
+      return;
+    }
+    _BufferAndStart bufferAndStart = _ensureFastAndSerializableByteData(
+      buffer,
+      start,
+      end,
+    );
+    var result = _ops.writeFromAt(
+      position,
+      bufferAndStart.buffer,
+      bufferAndStart.start,
+      end - (start - bufferAndStart.start),
+    );
+    if (result is OSError) {
+      throw new FileSystemException("writeFromAt failed", path, result);
+    }
+    _resourceInfo.addWrite(end - start);
+  }
+
   Future<RandomAccessFile> writeString(
     String string, {
     Encoding encoding = utf8,
@@ -1202,6 +1314,20 @@ class _RandomAccessFile implements RandomAccessFile {
     }
   }
 
+  Uint8List mapSync([
+    int start = 0,
+    int? end,
+    FileMapAdvice advice = FileMapAdvice.normal,
+  ]) {
+    _checkAvailable();
+    end = RangeError.checkValidRange(start, end, lengthSync());
+    var result = _ops.map(start, end, advice._advice);
+    if (result is OSError) {
+      throw new FileSystemException('map failed', path, result);
+    }
+    return (result as Uint8List).asUnmodifiableView();
+  }
+
   bool closed = false;
 
   int get fd => _ops.fd;
@@ -1217,7 +1343,7 @@ class _RandomAccessFile implements RandomAccessFile {
     if (closed) {
       return new Future.error(new FileSystemException("File closed", path));
     }
-    if (_asyncDispatched) {
+    if (_asyncDispatched || (_pendingPositional > 0)) {
       var msg = "An async operation is currently pending";
       return new Future.error(new FileSystemException(msg, path));
     }
@@ -1233,8 +1359,26 @@ class _RandomAccessFile implements RandomAccessFile {
     });
   }
 
-  void _checkAvailable() {
+  // Positional requests neither use nor move the position of the file, so
+  // any number of them may be pending at the same time. Other operations,
+  // which may move the position or close the file, wait for them to finish.
+  Future<Object?> _dispatchPositional(int request, List data) {
+    if (closed) {
+      return new Future.error(new FileSystemException("File closed", path));
+    }
     if (_asyncDispatched) {
+      var msg = "An async operation is currently pending";
+      return new Future.error(new FileSystemException(msg, path));
+    }
+    _pendingPositional++;
+    data[0] = _pointer();
+    return _IOService._dispatch(request, data).whenComplete(() {
+      _pendingPositional--;
+    });
+  }
+
+  void _checkAvailable() {
+    if (_asyncDispatched || (_pendingPositional > 0)) {
       throw new FileSystemException(
         "An async operation is currently pending",
         path,
@@ -50,6 +50,8 @@ class _IOService {
   static const int directoryListStop = 41;
   static const int directoryRename = 42;
   static const int sslProcessFilter = 43;
+  static const int fileReadIntoAt = 44;
+  static const int fileWriteFromAt = 45;
 
   external static Future<Object?> _dispatch(int request, List data);
 }
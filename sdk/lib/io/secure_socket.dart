@@ -1226,18 +1226,29 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
 
   Future<_FilterStatus> _pushAllFilterStages() async {
     bool wasInHandshake = _status != connectedStatus;
-    List args = new List<dynamic>.filled(2 + bufferCount * 2, null);
-    args[0] = _secureFilter!._pointer();
-    args[1] = wasInHandshake;
     var bufs = _secureFilter!.buffers!;
-    for (var i = 0; i < bufferCount; ++i) {
-      args[2 * i + 2] = bufs[i].start;
-      args[2 * i + 3] = bufs[i].end;
+    List<Object?> response;
+    if (wasInHandshake) {
+      List args = new List<dynamic>.filled(2 + bufferCount * 2, null);
+      args[0] = _secureFilter!._pointer();
+      args[1] = wasInHandshake;
+      for (var i = 0; i < bufferCount; ++i) {
+        args[2 * i + 2] = bufs[i].start;
+        args[2 * i + 3] = bufs[i].end;
+      }
+      response =
+          (await _IOService._dispatch(_IOService.sslProcessFilter, args))
+              as List<Object?>;
+    } else {
+      // Once connected, records are processed on this isolate's thread,
+      // which saves a round trip through the IO service per read and write.
+      List<int> positions = new List<int>.filled(bufferCount * 2, 0);
+      for (var i = 0; i < bufferCount; ++i) {
+        positions[2 * i] = bufs[i].start;
+        positions[2 * i + 1] = bufs[i].end;
+      }
+      response = _secureFilter!.processAllBuffers(positions);
     }
-
-    var response =
-        (await _IOService._dispatch(_IOService.sslProcessFilter, args))
-            as List<Object?>;
     if (response.length == 2) {
       if (wasInHandshake) {
         // If we're in handshake, throw a handshake error.
@@ -1450,6 +1461,7 @@ abstract class _SecureFilter {
   void init();
   X509Certificate? get peerCertificate;
   int processBuffer(int bufferIndex);
+  List<Object?> processAllBuffers(List<int> positions);
   void registerBadCertificateCallback(bool Function(X509Certificate) callback);
   void registerHandshakeCompleteCallback(Function handshakeCompleteHandler);
   void registerKeyLogPort(SendPort port);
@@ -164,6 +164,7 @@ class Message {
     // it if isolate exits before sending a response.
     ports.add(receivePort);
     receivePort.handler = (value) {
+      if (_addResponseChunk(value)) return;
       receivePort.close();
       ports.remove(receivePort);
       _setResponseFromPort(value);
@@ -215,6 +216,7 @@ class Message {
   Future<Response> sendToVM() {
     final receivePort = RawReceivePort(null, 'VM Message');
     receivePort.handler = (value) {
+      if (_addResponseChunk(value)) return;
       receivePort.close();
       _setResponseFromPort(value);
     };
@@ -244,12 +246,33 @@ class Message {
     return _completer.future;
   }
 
+  // Large responses are posted by the VM in chunks of UTF8 encoded JSON, see
+  // `--service_response_chunk_size`. All but the last chunk are sent as a
+  // two element list.
+  BytesBuilder? _responseChunks;
+
+  bool _addResponseChunk(Object? value) {
+    if (value is List && value.length == 2) {
+      (_responseChunks ??= BytesBuilder(copy: false)).add(
+        value[0] as Uint8List,
+      );
+      return true;
+    }
+    return false;
+  }
+
   void _setResponseFromPort(Object? response) {
     if (response == null) {
       // We should only have a null response for Notifications.
       assert(type == MessageType.Notification);
       return null;
     }
+    final chunks = _responseChunks;
+    if (chunks != null) {
+      _responseChunks = null;
+      chunks.add((response as List)[0] as Uint8List);
+      response = [chunks.takeBytes()];
+    }
     _completer.complete(Response.from(response));
   }
 
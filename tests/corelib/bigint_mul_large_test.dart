@@ -0,0 +1,72 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Testing multiplication of Bigints large enough for subquadratic
+// multiplication algorithms, with and without intrinsics.
+// VMOptions=--intrinsify --no-enable-asserts
+// VMOptions=--intrinsify --enable-asserts
+// VMOptions=--no-intrinsify --enable-asserts
+// VMOptions=--no-intrinsify --no-enable-asserts
+
+import "package:expect/expect.dart";
+
+int seed = 0x12345678;
+
+// Returns a deterministic pseudo-random big integer with [bits] bits.
+BigInt randomBigInt(int bits) {
+  var result = BigInt.one;
+  for (var i = 1; i < bits; i += 16) {
+    seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+    result = (result << 16) | BigInt.from(seed >> 8 & 0xffff);
+  }
+  return result;
+}
+
+// Computes a * b by multiplying a with 512 bit chunks of b, which are too
+// small for anything but schoolbook multiplication.
+BigInt referenceProduct(BigInt a, BigInt b) {
+  const chunkBits = 512;
+  final mask = (BigInt.one << chunkBits) - BigInt.one;
+  var result = BigInt.zero;
+  var shift = 0;
+  for (var rest = b.abs(); rest != BigInt.zero; rest >>= chunkBits) {
+    result += (a.abs() * (rest & mask)) << shift;
+    shift += chunkBits;
+  }
+  return a.isNegative != b.isNegative ? -result : result;
+}
+
+void expectProduct(BigInt a, BigInt b) {
+  final expected = referenceProduct(a, b);
+  Expect.equals(expected, a * b);
+  Expect.equals(expected, b * a);
+  if (b != BigInt.zero) {
+    Expect.equals(a, (a * b) ~/ b);
+  }
+}
+
+main() {
+  const sizes = [2048, 2080, 4096, 4127, 6400, 9600, 16384];
+  for (final aBits in sizes) {
+    for (final bBits in sizes) {
+      final a = randomBigInt(aBits);
+      final b = randomBigInt(bBits);
+      expectProduct(a, b);
+      expectProduct(-a, b);
+      expectProduct(a, -b);
+      expectProduct(-a, -b);
+    }
+  }
+
+  // Operands with all bits set produce carries through every digit.
+  final ones = (BigInt.one << 8192) - BigInt.one;
+  expectProduct(ones, ones);
+  expectProduct(ones, ones >> 3000);
+
+  // Operands whose halves are zero.
+  final sparse = (BigInt.one << 8000) + BigInt.one;
+  expectProduct(sparse, sparse);
+  expectProduct(BigInt.one << 8000, BigInt.one << 4500);
+  expectProduct(sparse, BigInt.zero);
+}
@@ -11,6 +11,7 @@
 // VMOptions=--test_il_serialization
 // VMOptions=--profiler --profile_vm=true
 // VMOptions=--profiler --profile_vm=false
+// VMOptions=--batch_ffi_async_callbacks
 // SharedObjects=ffi_test_functions
 
 import 'dart:async';
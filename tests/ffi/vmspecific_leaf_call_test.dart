@@ -3,6 +3,8 @@
 // BSD-style license that can be found in the LICENSE file.
 //
 // SharedObjects=ffi_test_functions
+// VMOptions=
+// VMOptions=--no-profile_ffi_leaf_calls
 
 // Formatting can break multitests, so don't format them.
 // dart format off
@@ -0,0 +1,73 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests that repeatedly invoking the same members through mirrors, on
+// instances of classes which override or inherit them, keeps finding the
+// right member. The VM remembers the members it found for recent lookups.
+
+library test.invoke_repeated;
+
+import 'dart:mirrors';
+
+import 'package:expect/expect.dart';
+
+class A {
+  var field = 'A.field';
+  method(x) => 'A.method $x';
+  get getter => 'A.getter';
+  set setter(value) => field = 'A.setter $value';
+  get closure => (x) => 'A.closure $x';
+  noSuchMethod(invocation) => 'A.noSuchMethod';
+}
+
+class B extends A {
+  method(x) => 'B.method $x';
+  get getter => 'B.getter';
+}
+
+class C extends B {
+  method(x, [y]) => 'C.method $x $y';
+  set setter(value) => field = 'C.setter $value';
+}
+
+main() {
+  final instances = <String, Object>{'A': A(), 'B': B(), 'C': C()};
+  for (var i = 0; i < 100; i++) {
+    instances.forEach((name, o) {
+      final mirror = reflect(o);
+      Expect.equals(
+        name == 'C' ? 'C.method $i null' : '$name.method $i',
+        mirror.invoke(#method, [i]).reflectee,
+      );
+      Expect.equals(
+        name == 'A' ? 'A.getter' : 'B.getter',
+        mirror.getField(#getter).reflectee,
+      );
+      Expect.equals('A.closure $i', mirror.invoke(#closure, [i]).reflectee);
+      mirror.setField(#setter, i);
+      Expect.equals(
+        name == 'C' ? 'C.setter $i' : 'A.setter $i',
+        mirror.getField(#field).reflectee,
+      );
+      // Failed lookups keep going to noSuchMethod.
+      Expect.equals('A.noSuchMethod', mirror.invoke(#missing, [i]).reflectee);
+      Expect.equals('A.noSuchMethod', mirror.getField(#missing).reflectee);
+      // As do lookups of members found before, if the arguments do not match.
+      Expect.equals('A.noSuchMethod', mirror.invoke(#method, []).reflectee);
+    });
+  }
+
+  // Many different lookups, more than the VM remembers.
+  final mirror = reflect(C());
+  for (var i = 0; i < 3; i++) {
+    for (var j = 0; j < 200; j++) {
+      Expect.equals(
+        'A.noSuchMethod',
+        mirror.invoke(MirrorSystem.getSymbol('missing$j'), []).reflectee,
+      );
+    }
+    Expect.equals('C.method 1 2', mirror.invoke(#method, [1, 2]).reflectee);
+    Expect.equals('[1]', reflect([1]).invoke(#toString, []).reflectee);
+  }
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Tests fillRange and indexOf on byte lists, short and long enough to be
+// handled by the VM without a loop over the elements.
+
+import 'dart:typed_data';
+import "package:expect/expect.dart";
+
+const lengths = [0, 1, 63, 64, 65, 1000];
+
+void testFill(List<int> list, int value, int expected) {
+  final length = list.length;
+  list.fillRange(0, length, 7);
+  if (length < 2) return;
+  list.fillRange(1, length - 1, value);
+  Expect.equals(7, list[0]);
+  for (var i = 1; i < length - 1; i++) {
+    Expect.equals(expected, list[i]);
+  }
+  Expect.equals(7, list[length - 1]);
+}
+
+void testIndexOf(List<int> list, int value, int stored) {
+  final length = list.length;
+  list.fillRange(0, length, 0);
+  Expect.equals(-1, list.indexOf(value));
+  if (length == 0) return;
+  list[length - 1] = stored;
+  Expect.equals(length - 1, list.indexOf(value));
+  Expect.equals(length - 1, list.indexOf(value, length - 1));
+  Expect.equals(length - 1, list.indexOf(value, -5));
+  Expect.equals(-1, list.indexOf(value, length));
+  list[0] = stored;
+  Expect.equals(0, list.indexOf(value));
+  Expect.equals(length == 1 ? -1 : length - 1, list.indexOf(value, 1));
+}
+
+main() {
+  for (final length in lengths) {
+    testFill(Uint8List(length), 0x1ff, 0xff);
+    testFill(Uint8List(length), -1, 0xff);
+    testFill(Int8List(length), 0xff, -1);
+    testFill(Int8List(length), 0x1234, 0x34);
+    testFill(Uint8ClampedList(length), 0x1ff, 0xff);
+    testFill(Uint8ClampedList(length), -1, 0);
+    testFill(Uint8List.view(Uint8List(length + 16).buffer, 8, length), 3, 3);
+
+    testIndexOf(Uint8List(length), 200, 200);
+    testIndexOf(Int8List(length), -56, -56);
+    testIndexOf(Uint8ClampedList(length), 255, 255);
+    testIndexOf(Uint8List.view(Uint8List(length + 16).buffer, 8, length), 9, 9);
+
+    // Elements which cannot be stored are never found.
+    final bytes = Uint8List(length)..fillRange(0, length, 0xff);
+    Expect.equals(-1, bytes.indexOf(-1));
+    Expect.equals(-1, bytes.indexOf(0x1ff));
+    final signedBytes = Int8List(length)..fillRange(0, length, -1);
+    Expect.equals(-1, signedBytes.indexOf(0xff));
+    Expect.equals(length == 0 ? -1 : 0, signedBytes.indexOf(-1));
+
+    final unmodifiable = Uint8List(length).asUnmodifiableView();
+    if (length > 0) {
+      Expect.throwsUnsupportedError(
+        () => unmodifiable.fillRange(0, length, 1),
+      );
+    }
+    Expect.equals(length == 0 ? -1 : 0, unmodifiable.indexOf(0));
+  }
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies that host name lookups give the same results with and without the
+// embedder caching them, and that failed lookups are not cached.
+
+// VMOptions=
+// VMOptions=--dns_cache_millis=60000
+
+import "dart:io";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+Future<void> testLookup(InternetAddressType type) async {
+  final first = await InternetAddress.lookup("localhost", type: type);
+  Expect.isTrue(first.isNotEmpty);
+  for (var i = 0; i < 10; i++) {
+    final again = await InternetAddress.lookup("localhost", type: type);
+    Expect.listEquals(first, again);
+  }
+  for (final address in first) {
+    Expect.isTrue(address.isLoopback);
+    Expect.equals("localhost", address.host);
+  }
+}
+
+Future<void> testFailedLookup() async {
+  for (var i = 0; i < 2; i++) {
+    await asyncExpectThrows<SocketException>(
+      InternetAddress.lookup("some.bad.host.name.7654321"),
+    );
+  }
+}
+
+void main() async {
+  asyncStart();
+  await testLookup(InternetAddressType.any);
+  await testLookup(InternetAddressType.IPv4);
+  await testFailedLookup();
+  asyncEnd();
+}
@@ -0,0 +1,30 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// OtherResources=process_set_exit_code_script.dart
+
+// Tests that the output and exit code of a script are kept when the VM exits
+// without a full shutdown.
+
+import "dart:io";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+main() async {
+  asyncStart();
+  final exitCodeScript = Platform.script
+      .resolve('process_set_exit_code_script.dart')
+      .toFilePath();
+  final result = await Process.run(Platform.executable, [
+    ...Platform.executableArguments,
+    '--verbosity=warning',
+    '--fast-exit',
+    exitCodeScript,
+  ]);
+  Expect.equals("standard out", result.stdout);
+  Expect.equals("standard error", result.stderr);
+  Expect.equals(25, result.exitCode);
+  asyncEnd();
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for testing RandomAccessFile.mapSync.
+
+import 'dart:io';
+
+import "package:expect/expect.dart";
+
+// Larger than the alignment of mapped offsets, so that unaligned ranges are
+// mapped from the middle of the file.
+const int fileLength = 200 * 1024 + 17;
+
+int byteAt(int i) => (i * 31) & 0xff;
+
+void testMap(File file) {
+  var raf = file.openSync();
+  try {
+    var bytes = raf.mapSync();
+    Expect.equals(fileLength, bytes.length);
+    for (int i = 0; i < fileLength; i++) {
+      Expect.equals(byteAt(i), bytes[i]);
+    }
+    Expect.throws<UnsupportedError>(() => bytes[0] = 1);
+
+    for (var start in [0, 1, 4095, 65536, 100000, fileLength]) {
+      var range = raf.mapSync(start, fileLength, FileMapAdvice.sequential);
+      Expect.equals(fileLength - start, range.length);
+      for (int i = 0; i < range.length; i++) {
+        Expect.equals(byteAt(start + i), range[i]);
+      }
+    }
+
+    var prefix = raf.mapSync(10, 20, FileMapAdvice.willNeed);
+    Expect.listEquals([for (int i = 10; i < 20; i++) byteAt(i)], prefix);
+    Expect.equals(0, raf.mapSync(5, 5, FileMapAdvice.random).length);
+
+    // Mapping does not move the file position.
+    Expect.equals(0, raf.positionSync());
+
+    Expect.throws<RangeError>(() => raf.mapSync(0, fileLength + 1));
+    Expect.throws<RangeError>(() => raf.mapSync(20, 10));
+    Expect.throws<RangeError>(() => raf.mapSync(-1));
+  } finally {
+    raf.closeSync();
+  }
+}
+
+void testMapOutlivesFile(File file) {
+  var raf = file.openSync();
+  var bytes = raf.mapSync(1, 3);
+  raf.closeSync();
+  Expect.listEquals([byteAt(1), byteAt(2)], bytes);
+  Expect.throws<FileSystemException>(() => raf.mapSync());
+}
+
+void main() {
+  var temp = Directory.systemTemp.createTempSync('dart_file_map');
+  try {
+    var file = new File("${temp.path}/test");
+    file.writeAsBytesSync([for (int i = 0; i < fileLength; i++) byteAt(i)]);
+    testMap(file);
+    testMapOutlivesFile(file);
+  } finally {
+    temp.deleteSync(recursive: true);
+  }
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Dart test program for testing RandomAccessFile.readIntoAt and writeFromAt.
+
+import 'dart:io';
+import 'dart:typed_data';
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int pageSize = 4096;
+const int numPages = 16;
+
+List<int> page(int index) => List<int>.filled(pageSize, index + 1);
+
+void testSync(File file) {
+  var raf = file.openSync(mode: FileMode.write);
+  try {
+    for (int i = numPages - 1; i >= 0; i--) {
+      raf.writeFromAtSync(i * pageSize, page(i));
+    }
+    Expect.equals(numPages * pageSize, raf.lengthSync());
+    // Positional writes leave the position alone, except on Windows.
+    if (!Platform.isWindows) {
+      Expect.equals(0, raf.positionSync());
+    }
+
+    var buffer = Uint8List(pageSize + 2);
+    Expect.equals(
+      pageSize,
+      raf.readIntoAtSync(3 * pageSize, buffer, 1, pageSize + 1),
+    );
+    Expect.equals(0, buffer[0]);
+    Expect.listEquals(page(3), buffer.sublist(1, pageSize + 1));
+    Expect.equals(0, buffer[pageSize + 1]);
+
+    // Reads past the end are short.
+    var list = List<int>.filled(10, 0);
+    Expect.equals(4, raf.readIntoAtSync(numPages * pageSize - 4, list));
+    Expect.listEquals([16, 16, 16, 16, 0, 0, 0, 0, 0, 0], list);
+    Expect.equals(0, raf.readIntoAtSync(numPages * pageSize, list));
+
+    Expect.throws<RangeError>(() => raf.readIntoAtSync(-1, list));
+    Expect.throws<RangeError>(() => raf.writeFromAtSync(-1, list));
+  } finally {
+    raf.closeSync();
+  }
+}
+
+Future<void> testAsync(File file) async {
+  var raf = await file.open(mode: FileMode.write);
+  await Future.wait([
+    for (int i = 0; i < numPages; i++) raf.writeFromAt(i * pageSize, page(i)),
+  ]);
+  Expect.equals(numPages * pageSize, await raf.length());
+
+  // All reads are pending at the same time.
+  var buffers = [for (int i = 0; i < numPages; i++) Uint8List(pageSize)];
+  var reads = [
+    for (int i = numPages - 1; i >= 0; i--)
+      raf.readIntoAt(i * pageSize, buffers[i]),
+  ];
+  // Other operations wait for the positional ones.
+  Expect.throws<FileSystemException>(() => raf.positionSync());
+  await asyncExpectThrows<FileSystemException>(raf.position());
+
+  for (var read in await Future.wait(reads)) {
+    Expect.equals(pageSize, read);
+  }
+  for (int i = 0; i < numPages; i++) {
+    Expect.listEquals(page(i), buffers[i]);
+  }
+  await raf.close();
+  await asyncExpectThrows<FileSystemException>(raf.readIntoAt(0, buffers[0]));
+}
+
+void main() {
+  asyncTest(() async {
+    var temp = await Directory.systemTemp.createTemp('dart_file_positional');
+    try {
+      testSync(File("${temp.path}/sync"));
+      await testAsync(File("${temp.path}/async"));
+    } finally {
+      await temp.delete(recursive: true);
+    }
+  });
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests starting attached processes, which Linux does with posix_spawn where
+// possible and with fork otherwise.
+
+import "dart:io";
+
+import "package:expect/async_helper.dart";
+import "package:expect/expect.dart";
+
+late Directory tempDir;
+
+String writeScript(String name, String contents, {bool executable = true}) {
+  final path = "${tempDir.path}/$name";
+  File(path).writeAsStringSync(contents);
+  if (executable) {
+    final result = Process.runSync("chmod", ["+x", path]);
+    Expect.equals(0, result.exitCode, result.stderr);
+  }
+  return path;
+}
+
+Future<void> testWorkingDirectory() async {
+  final result = await Process.run("pwd", [], workingDirectory: tempDir.path);
+  Expect.equals(0, result.exitCode);
+  Expect.equals(
+    tempDir.resolveSymbolicLinksSync(),
+    Directory(result.stdout.trim()).resolveSymbolicLinksSync(),
+  );
+}
+
+Future<void> testEnvironment() async {
+  writeScript("spawn_test_echo", "#!/bin/sh\necho \"\$VALUE\"\n");
+  // The same PATH as this process, so it can be searched before the start.
+  final environment = Map<String, String>.from(Platform.environment);
+  environment["PATH"] = "${tempDir.path}:${environment["PATH"] ?? ""}";
+  environment["VALUE"] = "inherited";
+  var result = await Process.run(
+    "spawn_test_echo",
+    [],
+    environment: environment,
+  );
+  Expect.equals(0, result.exitCode, result.stderr);
+  Expect.equals("inherited\n", result.stdout);
+
+  // A PATH only the new environment has.
+  result = await Process.run(
+    "spawn_test_echo",
+    [],
+    environment: {"PATH": tempDir.path, "VALUE": "own"},
+    includeParentEnvironment: false,
+  );
+  Expect.equals(0, result.exitCode, result.stderr);
+  Expect.equals("own\n", result.stdout);
+}
+
+Future<void> testScriptWithoutInterpreter() async {
+  // Run with /bin/sh, as execvp does.
+  final path = writeScript("spawn_test_plain", "echo plain\nexit 7\n");
+  final result = await Process.run(path, []);
+  Expect.equals(7, result.exitCode, result.stderr);
+  Expect.equals("plain\n", result.stdout);
+}
+
+Future<void> testBadExecutable() async {
+  final notExecutable = writeScript(
+    "spawn_test_not_executable",
+    "#!/bin/sh\nexit 0\n",
+    executable: false,
+  );
+  await asyncExpectThrows<ProcessException>(Process.start(notExecutable, []));
+  await asyncExpectThrows<ProcessException>(
+    Process.start("${tempDir.path}/spawn_test_missing", []),
+  );
+  await asyncExpectThrows<ProcessException>(
+    Process.start(
+      "spawn_test_missing",
+      [],
+      environment: {"PATH": tempDir.path},
+    ),
+  );
+}
+
+Future<void> testExitCode() async {
+  // Processes which may exit before their start has been recorded.
+  final processes = [
+    for (var i = 0; i < 20; i++) await Process.start("sh", ["-c", "exit $i"]),
+  ];
+  for (var i = 0; i < processes.length; i++) {
+    Expect.equals(i, await processes[i].exitCode);
+  }
+}
+
+void main() async {
+  if (Platform.isWindows) return;
+  asyncStart();
+  tempDir = Directory.systemTemp.createTempSync("process_spawn_test");
+  try {
+    await testWorkingDirectory();
+    await testEnvironment();
+    await testScriptWithoutInterpreter();
+    await testBadExecutable();
+    await testExitCode();
+  } finally {
+    tempDir.deleteSync(recursive: true);
+  }
+  asyncEnd();
+}